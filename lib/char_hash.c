@@ -31,6 +31,7 @@
 #include <limits.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 
 #include "mem.h"
 
@@ -48,6 +49,16 @@ enum { HASH_LENGTH = 76003 };
 static string_link_t *hash_table[HASH_LENGTH];
 static unsigned long long int bytes_used = 0;
 
+// Even a lookup modifies the table (found strings are moved to the front of
+// their bucket), so concurrent callers must be serialized
+static char thread_safe_enabled = 0;
+static pthread_mutex_t hash_table_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void uniquestr_set_thread_safe(char thread_safe)
+{
+    thread_safe_enabled = thread_safe;
+}
+
 unsigned long long int char_trie_used_memory(void)
 {
     return bytes_used;
@@ -64,11 +75,8 @@ static unsigned int hash_string(const char *string)
     return hash;
 }
 
-const char *uniquestr(const char *string)
+static const char *uniquestr_unlocked(const char *string)
 {
-    if (string == NULL)
-        return NULL;
-
     unsigned int hash = hash_string(string);
     unsigned int hash_index = hash % (sizeof(hash_table) / sizeof(hash_table[0]));
     string_link_t *p, *p_prev = 0, *new_link;
@@ -99,6 +107,21 @@ const char *uniquestr(const char *string)
     return new_link->string;
 }
 
+const char *uniquestr(const char *string)
+{
+    if (string == NULL)
+        return NULL;
+
+    if (!thread_safe_enabled)
+        return uniquestr_unlocked(string);
+
+    pthread_mutex_lock(&hash_table_lock);
+    const char *result = uniquestr_unlocked(string);
+    pthread_mutex_unlock(&hash_table_lock);
+
+    return result;
+}
+
 void uniquestr_stats(void)
 {
     unsigned long long bucket_length[HASH_LENGTH];
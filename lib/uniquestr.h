@@ -49,6 +49,9 @@ LIBUTILS_EXTERN unsigned long long int char_trie_used_memory(void);
 
 LIBUTILS_EXTERN void uniquestr_stats(void);
 
+// Makes uniquestr safe to be called from several threads. Disabled by default
+LIBUTILS_EXTERN void uniquestr_set_thread_safe(char thread_safe);
+
 #ifdef __cplusplus
 }
 #endif
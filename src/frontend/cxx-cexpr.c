@@ -56,6 +56,7 @@
 #include "cxx-typeenviron.h"
 #include "cxx-limits.h"
 #include "cxx-nodecl-output.h"
+#include "cxx-thread-safety.h"
 
 /*
 IMPORTANT: incompatible changes to enum const_value_kind_tag requires
@@ -391,6 +392,8 @@ static rb_red_blk_tree* _const_value_pool = NULL;
 
 static const_value_t* const_value_return_unique(const_value_t* v)
 {
+    FRONTEND_CACHES_LOCK;
+
     if (_const_value_pool == NULL)
     {
         _const_value_pool = rb_tree_create(const_value_compare_, NULL, NULL); \
@@ -411,6 +414,8 @@ static const_value_t* const_value_return_unique(const_value_t* v)
             const_value_free(v);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return result;
 }
 
@@ -1742,7 +1747,10 @@ nodecl_t const_value_to_nodecl_with_basic_type(const_value_t* v,
 nodecl_t const_value_to_nodecl_with_basic_type_cached(const_value_t* v, 
         type_t* basic_type)
 {
-    return const_value_to_nodecl_(v, basic_type, /* cached */ 1);
+    FRONTEND_CACHES_LOCK;
+    nodecl_t result = const_value_to_nodecl_(v, basic_type, /* cached */ 1);
+    FRONTEND_CACHES_UNLOCK;
+    return result;
 }
 
 nodecl_t const_value_to_nodecl(const_value_t* v)
@@ -1752,7 +1760,10 @@ nodecl_t const_value_to_nodecl(const_value_t* v)
 
 nodecl_t const_value_to_nodecl_cached(const_value_t* v)
 {
-    return const_value_to_nodecl_(v, /* basic_type */ NULL, /* cached */ 1);
+    FRONTEND_CACHES_LOCK;
+    nodecl_t result = const_value_to_nodecl_(v, /* basic_type */ NULL, /* cached */ 1);
+    FRONTEND_CACHES_UNLOCK;
+    return result;
 }
 
 char const_value_is_integer(const_value_t* v)
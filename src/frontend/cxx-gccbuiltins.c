@@ -2538,6 +2538,9 @@ DEF_GCC_BUILTIN        (BUILT_IN_CLZL, "clzl", BT_FN_INT_ULONG, ATTR_CONST_NOTHR
 DEF_GCC_BUILTIN        (BUILT_IN_CLZLL, "clzll", BT_FN_INT_ULONGLONG, ATTR_CONST_NOTHROW_LEAF_LIST, simplify_clzll)
 DEF_GCC_BUILTIN        (BUILT_IN_CLZS, "clzs", BT_FN_INT_UINT16, ATTR_CONST_NOTHROW_LEAF_LIST, NO_EXPAND_FUN)
 DEF_GCC_BUILTIN        (BUILT_IN_CONSTANT_P, "constant_p", BT_FN_INT_VAR, ATTR_CONST_NOTHROW_LEAF_LIST, NO_EXPAND_FUN)
+DEF_GCC_BUILTIN        (BUILT_IN_CPU_INIT, "cpu_init", BT_FN_VOID, ATTR_NOTHROW_LEAF_LIST, NO_EXPAND_FUN)
+DEF_GCC_BUILTIN        (BUILT_IN_CPU_IS, "cpu_is", BT_FN_INT_CONST_STRING, ATTR_NOTHROW_LEAF_LIST, NO_EXPAND_FUN)
+DEF_GCC_BUILTIN        (BUILT_IN_CPU_SUPPORTS, "cpu_supports", BT_FN_INT_CONST_STRING, ATTR_NOTHROW_LEAF_LIST, NO_EXPAND_FUN)
 DEF_GCC_BUILTIN        (BUILT_IN_CTZ, "ctz", BT_FN_INT_UINT, ATTR_CONST_NOTHROW_LEAF_LIST, simplify_ctz)
 DEF_GCC_BUILTIN        (BUILT_IN_CTZIMAX, "ctzimax", BT_FN_INT_UINTMAX, ATTR_CONST_NOTHROW_LEAF_LIST, NO_EXPAND_FUN)
 DEF_GCC_BUILTIN        (BUILT_IN_CTZL, "ctzl", BT_FN_INT_ULONG, ATTR_CONST_NOTHROW_LEAF_LIST, simplify_ctzl)
@@ -29,6 +29,7 @@
 #include <string.h>
 #include "uniquestr.h"
 #include "string_utils.h"
+#include "cxx-thread-safety.h"
 
 // Heavily inspired in lib/char_hash.c contributed by Jan Hoogerbrugge
 
@@ -95,7 +96,7 @@ static locus_t* pool_locus_alloc(void)
     return result;
 }
 
-const locus_t* make_locus(const char* filename, unsigned int line, unsigned int col)
+static const locus_t* make_locus_unlocked(const char* filename, unsigned int line, unsigned int col)
 {
     if (filename == NULL)
         filename = "";
@@ -148,3 +149,11 @@ const locus_t* make_locus(const char* filename, unsigned int line, unsigned int
     return items[n].locus;
 }
 
+const locus_t* make_locus(const char* filename, unsigned int line, unsigned int col)
+{
+    FRONTEND_CACHES_LOCK;
+    const locus_t* result = make_locus_unlocked(filename, line, col);
+    FRONTEND_CACHES_UNLOCK;
+
+    return result;
+}
@@ -35,6 +35,7 @@
 #include "cxx-driver.h"
 #include "cxx-typeutils.h"
 #include "cxx-utils.h"
+#include "cxx-thread-safety.h"
 #include "cxx-solvetemplate.h"
 #include "cxx-instantiation.h"
 #include "cxx-prettyprint.h"
@@ -439,6 +440,7 @@ void insert_alias(scope_t* sc, scope_entry_t* entry, const char* name)
 
     const char* symbol_name = uniquestr(name);
 
+    FRONTEND_CACHES_LOCK;
     scope_entry_list_t* result_set = (scope_entry_list_t*)dhash_ptr_query(sc->dhash, symbol_name);
 
     if (result_set != NULL)
@@ -451,6 +453,7 @@ void insert_alias(scope_t* sc, scope_entry_t* entry, const char* name)
     }
 
     dhash_ptr_insert(sc->dhash, symbol_name, result_set);
+    FRONTEND_CACHES_UNLOCK;
 }
 
 static const char* scope_names[] =
@@ -506,6 +509,7 @@ static scope_entry_list_t* query_name_in_scope(scope_t* sc, const char* name)
         }
     }
 
+    FRONTEND_CACHES_LOCK;
     scope_entry_list_t *result = (scope_entry_list_t*)dhash_ptr_query(sc->dhash, name);
 
     // ERROR_CONDITION(name != uniquestr(name), "Invalid name", 0);
@@ -522,7 +526,10 @@ static scope_entry_list_t* query_name_in_scope(scope_t* sc, const char* name)
         }
     }
 
-    return entry_list_copy(result);
+    result = entry_list_copy(result);
+    FRONTEND_CACHES_UNLOCK;
+
+    return result;
 }
 
 /*
@@ -533,6 +540,7 @@ void insert_entry(scope_t* sc, scope_entry_t* entry)
     ERROR_CONDITION((entry->symbol_name == NULL), "Inserting a symbol entry without name!", 0);
     // ERROR_CONDITION(entry->symbol_name != uniquestr(entry->symbol_name), "Name of symbol not canonical", 0);
 
+    FRONTEND_CACHES_LOCK;
     scope_entry_list_t* result_set = (scope_entry_list_t*)dhash_ptr_query(sc->dhash, entry->symbol_name);
 
     if (result_set != NULL)
@@ -561,24 +569,27 @@ void insert_entry(scope_t* sc, scope_entry_t* entry)
         result_set = entry_list_new(entry);
         dhash_ptr_insert(sc->dhash, entry->symbol_name, result_set);
     }
+    FRONTEND_CACHES_UNLOCK;
 }
 
 void remove_entry(scope_t* sc, scope_entry_t* entry)
 {
+    FRONTEND_CACHES_LOCK;
     scope_entry_list_t* entry_list = dhash_ptr_query(sc->dhash, entry->symbol_name);
-    if (entry_list == NULL)
-        return;
-
-    entry_list = entry_list_remove(entry_list, entry);
-
-    if (entry_list_size(entry_list) >= 1)
-    {
-        dhash_ptr_insert(sc->dhash, entry->symbol_name, entry_list);
-    }
-    else
+    if (entry_list != NULL)
     {
-        dhash_ptr_remove(sc->dhash, entry->symbol_name);
+        entry_list = entry_list_remove(entry_list, entry);
+
+        if (entry_list_size(entry_list) >= 1)
+        {
+            dhash_ptr_insert(sc->dhash, entry->symbol_name, entry_list);
+        }
+        else
+        {
+            dhash_ptr_remove(sc->dhash, entry->symbol_name);
+        }
     }
+    FRONTEND_CACHES_UNLOCK;
 }
 
 scope_entry_list_t* filter_symbol_kind_set(scope_entry_list_t* entry_list, int num_kinds, enum cxx_symbol_kind* symbol_kind_set)
@@ -6294,7 +6305,9 @@ void scope_for_each_entity(scope_t* sc, void *data, void (*fun)(scope_entry_list
 {
     struct fun_adaptor_data_tag fun_adaptor_data = { .data = data, .fun = fun };
 
+    FRONTEND_CACHES_LOCK;
     dhash_ptr_walk(sc->dhash, (dhash_ptr_walk_fn*)for_each_fun_adaptor, &fun_adaptor_data);
+    FRONTEND_CACHES_UNLOCK;
 }
 
 int get_template_nesting_of_context(const decl_context_t* decl_context)
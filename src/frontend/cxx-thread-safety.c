@@ -0,0 +1,71 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2015 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#include <pthread.h>
+
+#include "cxx-thread-safety.h"
+#include "uniquestr.h"
+#include "cxx-typeutils.h"
+
+static char _frontend_thread_safe = 0;
+static pthread_mutex_t _frontend_caches_lock;
+
+void frontend_set_thread_safe(char thread_safe)
+{
+    // Must not be called while several threads are using the frontend
+    static char _lock_initialized = 0;
+    if (!_lock_initialized)
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&_frontend_caches_lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+        _lock_initialized = 1;
+    }
+
+    // Lazily created builtin types are not protected
+    if (thread_safe)
+        initialize_builtin_types();
+
+    _frontend_thread_safe = thread_safe;
+    uniquestr_set_thread_safe(thread_safe);
+}
+
+char frontend_is_thread_safe(void)
+{
+    return _frontend_thread_safe;
+}
+
+void frontend_caches_lock(void)
+{
+    pthread_mutex_lock(&_frontend_caches_lock);
+}
+
+void frontend_caches_unlock(void)
+{
+    pthread_mutex_unlock(&_frontend_caches_lock);
+}
@@ -0,0 +1,62 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2015 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#ifndef CXX_THREAD_SAFETY_H
+#define CXX_THREAD_SAFETY_H
+
+#include "libmcxx-common.h"
+#include "cxx-macros.h"
+
+MCXX_BEGIN_DECLS
+
+// The frontend is not reentrant. Some of its state, though, is also used
+// once the translation unit has been parsed and can be protected so several
+// threads can use it at the same time. This is disabled by default.
+//
+// While enabled, only the following can be used concurrently:
+//  - unique strings, loci and constant values
+//  - builtin types (created when enabling) and derived types (qualified,
+//    pointer, reference, pointer-to-member, array, vector, complex, mask,
+//    zero and atomic variants)
+//  - symbol creation, lookup and removal in scopes
+//  - nodecl creation and modification of nodes not shared with other threads
+// Parsing and codegen are not allowed (the C/C++ scanner asserts it).
+LIBMCXX_EXTERN void frontend_set_thread_safe(char thread_safe);
+LIBMCXX_EXTERN char frontend_is_thread_safe(void);
+
+// Lock shared by all the protected caches of the frontend. It is recursive
+// because filling one cache may require filling another one
+LIBMCXX_EXTERN void frontend_caches_lock(void);
+LIBMCXX_EXTERN void frontend_caches_unlock(void);
+
+#define FRONTEND_CACHES_LOCK \
+    do { if (frontend_is_thread_safe()) frontend_caches_lock(); } while (0)
+#define FRONTEND_CACHES_UNLOCK \
+    do { if (frontend_is_thread_safe()) frontend_caches_unlock(); } while (0)
+
+MCXX_END_DECLS
+
+#endif // CXX_THREAD_SAFETY_H
@@ -48,6 +48,7 @@
 #include "cxx-typededuc.h"
 #include "cxx-diagnostic.h"
 #include "cxx-intelsupport.h"
+#include "cxx-thread-safety.h"
 
 #include "cxx-symbol-deep-copy.h"
 
@@ -851,6 +852,8 @@ extern inline type_t* get_bool_of_integer_type(type_t* t)
 
     ERROR_CONDITION(s > MCXX_MAX_BYTES_INTEGER, "Integer of size %d too big for bool", s);
 
+    // Not pre-initialized: the first integer type of each size is kept
+    FRONTEND_CACHES_LOCK;
     if (_bool_types[s] == NULL)
     {
         _bool_types[s] = get_simple_type();
@@ -864,6 +867,7 @@ extern inline type_t* get_bool_of_integer_type(type_t* t)
         _bool_types[s]->info->alignment = type_get_alignment(t);
         _bool_types[s]->info->valid_size = 1;
     }
+    FRONTEND_CACHES_UNLOCK;
 
     return _bool_types[s];
 }
@@ -1105,7 +1109,18 @@ static char same_floating_info(floating_type_info_t* info1, floating_type_info_t
 }
 #endif
 
+static type_t* get_floating_type_from_descriptor_unlocked(floating_type_info_t* info);
+
 extern inline type_t* get_floating_type_from_descriptor(floating_type_info_t* info)
+{
+    FRONTEND_CACHES_LOCK;
+    type_t* result = get_floating_type_from_descriptor_unlocked(info);
+    FRONTEND_CACHES_UNLOCK;
+
+    return result;
+}
+
+static type_t* get_floating_type_from_descriptor_unlocked(floating_type_info_t* info)
 {
     int i;
     for (i = 0; i < num_float_types; i++)
@@ -4127,6 +4142,8 @@ extern inline type_t* get_complex_type(type_t* t)
 {
     ERROR_CONDITION(t == NULL, "Invalid base type for complex type", 0);
 
+    FRONTEND_CACHES_LOCK;
+
     static dhash_ptr_t *_complex_hash = NULL;
 
     if (_complex_hash == NULL)
@@ -4152,6 +4169,8 @@ extern inline type_t* get_complex_type(type_t* t)
         dhash_ptr_insert(_complex_hash, (const char*)t, result);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return result;
 }
 
@@ -4268,9 +4287,9 @@ extern inline type_t* get_unqualified_type(type_t* t)
     }
 }
 
-static inline type_t *get_qualified_type(type_t *original,
-                                         cv_qualifier_t cv_qualification,
-                                         char qualify_arrays)
+static inline type_t *get_qualified_type_unlocked(type_t *original,
+                                                  cv_qualifier_t cv_qualification,
+                                                  char qualify_arrays)
 {
     // Ensure it is initialized
     init_qualification_hash();
@@ -4298,9 +4317,9 @@ static inline type_t *get_qualified_type(type_t *original,
     {
         // Now clone the type
         type_t *qualif_element_type
-            = get_qualified_type(original->array->element_type,
-                                 cv_qualification,
-                                 /* qualify_arrays */ 0);
+            = get_qualified_type_unlocked(original->array->element_type,
+                                          cv_qualification,
+                                          /* qualify_arrays */ 0);
         return _clone_array_type(original, qualif_element_type);
     }
 
@@ -4332,6 +4351,17 @@ static inline type_t *get_qualified_type(type_t *original,
     return qualified_type;
 }
 
+static inline type_t *get_qualified_type(type_t *original,
+                                         cv_qualifier_t cv_qualification,
+                                         char qualify_arrays)
+{
+    FRONTEND_CACHES_LOCK;
+    type_t* result = get_qualified_type_unlocked(original, cv_qualification, qualify_arrays);
+    FRONTEND_CACHES_UNLOCK;
+
+    return result;
+}
+
 type_t *get_cv_qualified_array_type(type_t *array_type,
                                     cv_qualifier_t cv_qualifier)
 {
@@ -4367,6 +4397,8 @@ extern inline type_t* get_pointer_type(type_t* t)
 {
     ERROR_CONDITION(t == NULL, "Invalid NULL type", 0);
 
+    FRONTEND_CACHES_LOCK;
+
     static dhash_ptr_t *_pointer_types = NULL;
 
     if (_pointer_types == NULL)
@@ -4413,6 +4445,8 @@ extern inline type_t* get_pointer_type(type_t* t)
         dhash_ptr_insert(_pointer_types, (const char*)t, pointed_type);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return pointed_type;
 }
 
@@ -4457,6 +4491,8 @@ static type_t* get_internal_reference_type(type_t* t, enum type_kind reference_k
             }
     }
 
+    FRONTEND_CACHES_LOCK;
+
     if ((*reference_types) == NULL)
     {
         (*reference_types) = dhash_ptr_new(5);
@@ -4479,6 +4515,8 @@ static type_t* get_internal_reference_type(type_t* t, enum type_kind reference_k
         dhash_ptr_insert(reference_hash, (const char*)t, referenced_type);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return referenced_type;
 }
 
@@ -4501,6 +4539,8 @@ extern inline type_t* get_pointer_to_member_type(type_t* t, type_t* class_type)
 {
     ERROR_CONDITION(t == NULL, "Invalid NULL type", 0);
 
+    FRONTEND_CACHES_LOCK;
+
     static dhash_ptr_t *_class_types = NULL;
 
     if (_class_types == NULL)
@@ -4552,6 +4592,8 @@ extern inline type_t* get_pointer_to_member_type(type_t* t, type_t* class_type)
         dhash_ptr_insert(class_type_hash, (const char*)t, pointer_to_member);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return pointer_to_member;
 }
 
@@ -4790,6 +4832,8 @@ static type_t* _get_array_type(
         }
     }
 
+    FRONTEND_CACHES_LOCK;
+
     type_t* result = NULL;
 
     if (nodecl_is_null(whole_size))
@@ -4962,6 +5006,8 @@ static type_t* _get_array_type(
         }
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return result;
 }
 
@@ -5267,6 +5313,8 @@ extern inline type_t* get_vector_type_by_bytes(type_t* element_type, unsigned in
 {
     ERROR_CONDITION(element_type == NULL, "Invalid type", 0);
 
+    FRONTEND_CACHES_LOCK;
+
     dhash_ptr_t *_vector_hash = get_vector_sized_hash(vector_size);
 
     type_t* result = dhash_ptr_query(_vector_hash, (const char*)element_type);
@@ -5288,6 +5336,8 @@ extern inline type_t* get_vector_type_by_bytes(type_t* element_type, unsigned in
         dhash_ptr_insert(_vector_hash, (const char*)element_type, result);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return result;
 }
 
@@ -10302,6 +10352,44 @@ extern inline const char* print_neon_vector_type(
     return c;
 }
 
+// SVE vectors are sizeless in the ACLE, so any vector whose size is the
+// configured vector length (-msve-vector-bits) is printed as the SVE type
+extern inline const char* print_sve_vector_type(
+        const decl_context_t* decl_context,
+        type_t* t,
+        print_symbol_callback_t print_symbol_fun,
+        void* print_symbol_data)
+{
+    type_t* element_type = vector_type_get_element_type(t);
+
+    const char *c = NULL;
+    if (is_integral_type(element_type)
+            && !is_bool_type(element_type))
+    {
+        uniquestr_sprintf(&c, "sv%sint%d_t",
+                is_unsigned_integral_type(element_type) ? "u" : "",
+                (int)type_get_size(element_type) * 8);
+        return c;
+    }
+    else if (is_float_type(element_type))
+    {
+        return "svfloat32_t";
+    }
+    else if (is_double_type(element_type))
+    {
+        return "svfloat64_t";
+    }
+
+    const char* typename = get_simple_type_name_string_internal_impl(decl_context,
+            vector_type_get_element_type(t),
+            print_symbol_fun,
+            print_symbol_data);
+    uniquestr_sprintf(&c, "<<sve-vector-%s-%d>>",
+            typename,
+            vector_type_get_vector_size_in_bytes(t));
+    return c;
+}
+
 // Improve this
 enum { ROMOL_VECTOR_LENGTH = 64 };
 
@@ -10332,9 +10420,11 @@ extern inline const char* print_romol_vector_type(
 #define VECTOR_FLAVORS \
     VECTOR_FLAVOR(gnu, print_gnu_vector_type, NULL) \
     VECTOR_FLAVOR(intel, print_intel_sse_avx_vector_type, print_intel_mask_type) \
+    VECTOR_FLAVOR(avx512, print_intel_sse_avx_vector_type, print_avx512_mask_type) \
     VECTOR_FLAVOR(altivec, print_altivec_vector_type, NULL) \
     VECTOR_FLAVOR(opencl, print_opencl_vector_type, NULL) \
     VECTOR_FLAVOR(neon, print_neon_vector_type, NULL) \
+    VECTOR_FLAVOR(sve, print_sve_vector_type, print_sve_mask_type) \
     VECTOR_FLAVOR(romol, print_romol_vector_type, print_romol_mask_type)
 
 #define VECTOR_FLAVOR(name, _, __) #name,
@@ -10384,6 +10474,44 @@ extern inline const char* print_intel_mask_type(
     return result;
 }
 
+// AVX-512BW masks may have up to 64 bits. Masks of less
+// than 8 elements (e.g. 128-bit vectors) are stored in __mmask8
+extern inline const char* print_avx512_mask_type(
+        const decl_context_t* decl_context UNUSED_PARAMETER,
+        type_t* t,
+        print_symbol_callback_t print_symbol_fun UNUSED_PARAMETER,
+        void* print_symbol_data UNUSED_PARAMETER)
+{
+    unsigned int num_bits = mask_type_get_num_bits(t);
+
+    const char* result = NULL;
+
+    if (num_bits <= 8)
+    {
+        result = "__mmask8";
+    }
+    else if (num_bits == 16 || num_bits == 32 || num_bits == 64)
+    {
+        uniquestr_sprintf(&result, "__mmask%d", num_bits);
+    }
+    else
+    {
+        uniquestr_sprintf(&result, "<<avx512-vector-mask-%d>>", num_bits);
+    }
+
+    return result;
+}
+
+// Every SVE predicate is a svbool_t, regardless of its number of elements
+extern inline const char* print_sve_mask_type(
+        const decl_context_t* decl_context UNUSED_PARAMETER,
+        type_t* t UNUSED_PARAMETER,
+        print_symbol_callback_t print_symbol_fun UNUSED_PARAMETER,
+        void* print_symbol_data UNUSED_PARAMETER)
+{
+    return "svbool_t";
+}
+
 extern inline const char* print_romol_mask_type(
         const decl_context_t* decl_context UNUSED_PARAMETER,
         type_t* t,
@@ -10661,7 +10789,7 @@ static const char* get_simple_type_name_string_internal_impl(const decl_context_
                 if (CURRENT_CONFIGURATION->print_mask_type == NULL)
                 {
                     // FIXME: Devise a better fallback
-                    print_intel_mask_type(decl_context, t, print_symbol_fun, print_symbol_data);
+                    result = print_intel_mask_type(decl_context, t, print_symbol_fun, print_symbol_data);
                 }
                 else
                 {
@@ -13815,6 +13943,8 @@ extern inline type_t* get_variant_type_zero(type_t* t)
     cv_qualifier_t cv_qualif = get_cv_qualifier(t);
     t = get_cv_qualified_type(advance_over_typedefs(t), CV_NONE);
 
+    FRONTEND_CACHES_LOCK;
+
     if (_zero_types_hash == NULL)
     {
         _zero_types_hash = dhash_ptr_new(5);
@@ -13830,6 +13960,8 @@ extern inline type_t* get_variant_type_zero(type_t* t)
         dhash_ptr_insert(_zero_types_hash, (const char*)t, result);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return get_cv_qualified_type(result, cv_qualif);
 }
 
@@ -16121,6 +16253,8 @@ static void mask_type_compute_underlying_type(type_t* t)
 
 extern inline type_t* get_mask_type(unsigned int mask_size_bits)
 {
+    FRONTEND_CACHES_LOCK;
+
     static rb_red_blk_tree *_mask_hash = NULL;
 
     if (_mask_hash == NULL)
@@ -16144,6 +16278,8 @@ extern inline type_t* get_mask_type(unsigned int mask_size_bits)
         rb_tree_insert(_mask_hash, k, result);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return result;
 }
 
@@ -16756,15 +16892,17 @@ static dhash_ptr_t *_atomic_types_hash = NULL;
 
 extern inline type_t* get_variant_type_atomic(type_t* t)
 {
+    cv_qualifier_t cv_qualif = get_cv_qualifier(t);
+    // We do not use get_unqualified_type because it preserves restrict
+    t = get_cv_qualified_type(t, CV_NONE);
+
+    FRONTEND_CACHES_LOCK;
+
     if (_atomic_types_hash == NULL)
     {
         _atomic_types_hash = dhash_ptr_new(5);
     }
 
-    cv_qualifier_t cv_qualif = get_cv_qualifier(t);
-    // We do not use get_unqualified_type because it preserves restrict
-    t = get_cv_qualified_type(t, CV_NONE);
-
     type_t* result = dhash_ptr_query(_atomic_types_hash, (const char*)t);
 
     if (result == NULL)
@@ -16775,6 +16913,8 @@ extern inline type_t* get_variant_type_atomic(type_t* t)
         dhash_ptr_insert(_atomic_types_hash, (const char*)t, result);
     }
 
+    FRONTEND_CACHES_UNLOCK;
+
     return get_cv_qualified_type(result, cv_qualif);
 }
 
@@ -17280,4 +17420,44 @@ static type_t* rewrite_redundant_typedefs(type_t* orig)
     return result;
 }
 
-
+void initialize_builtin_types(void)
+{
+    get_unsigned_byte_type();
+    get_signed_byte_type();
+    get_char_type();
+    get_char16_t_type();
+    get_char32_t_type();
+    get_signed_char_type();
+    get_unsigned_char_type();
+    get_wchar_t_type();
+    get_bool_type();
+    get_signed_int_type();
+    get_signed_short_int_type();
+    get_signed_long_int_type();
+    get_signed_long_long_int_type();
+    get_unsigned_int_type();
+    get_unsigned_short_int_type();
+    get_unsigned_long_int_type();
+    get_unsigned_long_long_int_type();
+#ifdef HAVE_INT128
+    get_signed_int128_type();
+    get_unsigned_int128_type();
+#endif
+    get_void_type();
+    get_float_type();
+    get_double_type();
+    get_long_double_type();
+    get_gcc_builtin_va_list_type();
+    get_unknown_dependent_type();
+    get_nullptr_type();
+    get_error_type();
+    get_ellipsis_type();
+    get_throw_expr_type();
+    get_pseudo_destructor_call_type();
+    get_implicit_none_type();
+    get_hollerith_type();
+    get_auto_type();
+    get_decltype_auto_type();
+    get_braced_list_type(0, NULL);
+    get_sequence_of_types(0, NULL);
+}
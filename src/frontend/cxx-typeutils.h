@@ -60,6 +60,10 @@ LIBMCXX_EXTERN _size_t type_get_size(type_t*);
 LIBMCXX_EXTERN _size_t type_get_alignment(type_t*);
 LIBMCXX_EXTERN char type_depends_on_nonconstant_values(type_t* t);
 
+// Creates the builtin types that are lazily initialized, so they can be
+// used by several threads afterwards (see frontend_set_thread_safe)
+LIBMCXX_EXTERN void initialize_builtin_types(void);
+
 /* Type constructors: Builtins */
 LIBMCXX_EXTERN type_t* get_signed_byte_type(void);
 LIBMCXX_EXTERN type_t* get_unsigned_byte_type(void);
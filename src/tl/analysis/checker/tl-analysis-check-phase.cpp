@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <limits.h>
+#include <set>
 
 namespace TL {
 namespace Analysis {
@@ -734,6 +735,34 @@ namespace {
             check_assertions_rec(*it);
         }
     }
+
+    std::set<std::string> get_names_from_string(const std::string& str)
+    {
+        std::set<std::string> result;
+        size_t ini = 0;
+        while (ini < str.size())
+        {
+            size_t fin = str.find(',', ini);
+            if (fin == std::string::npos)
+                fin = str.size();
+            if (fin > ini)
+                result.insert(str.substr(ini, fin-ini));
+            ini = fin+1;
+        }
+        return result;
+    }
+
+    //! Appends an empty statement to the body of \p func_code, without marking the function as modified
+    void append_empty_statement(const Nodecl::FunctionCode& func_code)
+    {
+        Nodecl::List in_context = func_code.get_statements().as<Nodecl::Context>().get_in_context().as<Nodecl::List>();
+        ERROR_CONDITION(in_context.empty() || !in_context.front().is<Nodecl::CompoundStatement>(),
+                        "Unexpected body of function '%s'\n", func_code.get_symbol().get_name().c_str());
+        Nodecl::List stmts = in_context.front().as<Nodecl::CompoundStatement>().get_statements().as<Nodecl::List>();
+        ERROR_CONDITION(stmts.empty(), "Cannot modify the empty function '%s'\n", func_code.get_symbol().get_name().c_str());
+        // In-place append: the modification stamp of the function does not change
+        stmts.append(Nodecl::EmptyStatement::make(func_code.get_locus()));
+    }
 }
 
 
@@ -764,6 +793,25 @@ namespace {
                            "Enables OmpSs semantics instead of OpenMP semantics",
                            _ompss_mode_str,
                            "0").connect(std::bind(&AnalysisCheckPhase::set_ompss_mode, this, std::placeholders::_1));
+
+        register_parameter("range_solver",
+                           "Selects the solver of Range Analysis: 'constraint_graph' (default), "
+                           "'sparse' (intervals widened to the constants of the code) or "
+                           "'sparse_infinity' (intervals widened to infinity)",
+                           _range_solver_str,
+                           "constraint_graph").connect(std::bind(&AnalysisCheckPhase::set_range_solver, this, std::placeholders::_1));
+
+        register_parameter("cache_check_modify",
+                           "Comma-separated list of functions modified between two analyses sharing a PCFG cache. "
+                           "Used to test that the cache detects the modifications",
+                           _cache_check_modify_str,
+                           "");
+
+        register_parameter("cache_check_rebuilt",
+                           "Comma-separated list of functions whose PCFG must be rebuilt after modifying the functions "
+                           "in 'cache_check_modify'. The PCFGs of any other function must be reused",
+                           _cache_check_rebuilt_str,
+                           "");
     }
 
     void AnalysisCheckPhase::check_pragma_clauses(
@@ -1055,9 +1103,14 @@ namespace {
 
         NBase ast = *std::static_pointer_cast<NBase>(dto["nodecl"]);
 
+        // 0.- Check the reuse of PCFGs, if requested
+        if (!_cache_check_modify_str.empty())
+            check_pcfg_cache(ast);
+
         // 1.- Execute analyses
         // 1.1.- Compute all data-flow analysis
         AnalysisBase analysis(_ompss_mode_enabled);
+        analysis.set_range_solver_options(_range_solver_options);
         analysis.parallel_control_flow_graph(ast);    // At least, we compute the PCFG
         if (_analysis_mask._which_analysis & WhichAnalysis::RANGE_ANALYSIS)
         {
@@ -1116,6 +1169,68 @@ namespace {
         v.walk(ast);
     }
 
+    /*!Analyzes \p ast twice sharing a PCFG cache, modifying the functions in 'cache_check_modify' in between
+     * The modification is an in-place list append, which does not go through Nodecl::Utils,
+     * so the cache must detect it by itself
+     */
+    void AnalysisCheckPhase::check_pcfg_cache(const NBase& ast)
+    {
+        const std::set<std::string> modified = get_names_from_string(_cache_check_modify_str);
+        const std::set<std::string> rebuilt = get_names_from_string(_cache_check_rebuilt_str);
+        std::shared_ptr<AnalysisCache> cache(new AnalysisCache());
+
+        // 1.- Build the PCFGs and compute Use-Definition, which includes the IPA summary of the callees
+        std::map<Symbol, ExtensibleGraph*> first_pcfgs;
+        {
+            AnalysisBase analysis(_ompss_mode_enabled);
+            analysis.set_cache(cache);
+            analysis.use_def(ast, /*propagate_graph_nodes*/ true);
+            const ObjectList<ExtensibleGraph*> pcfgs = analysis.get_pcfgs();
+            for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+                first_pcfgs[(*it)->get_function_symbol()] = *it;
+        }
+
+        // 2.- Modify the requested functions
+        Nodecl::List top_level = ast.as<Nodecl::TopLevel>().get_top_level().as<Nodecl::List>();
+        std::set<std::string> not_found = modified;
+        for (Nodecl::List::iterator it = top_level.begin(); it != top_level.end(); ++it)
+        {
+            if (!it->is<Nodecl::FunctionCode>())
+                continue;
+            const std::string name = it->get_symbol().get_name();
+            if (modified.find(name) == modified.end())
+                continue;
+            append_empty_statement(it->as<Nodecl::FunctionCode>());
+            not_found.erase(name);
+        }
+        for (std::set<std::string>::iterator it = not_found.begin(); it != not_found.end(); ++it)
+            internal_error("Function '%s' in 'cache_check_modify' not found\n", it->c_str());
+
+        // 3.- Analyze again and check which PCFGs have been reused
+        AnalysisBase analysis(_ompss_mode_enabled);
+        analysis.set_cache(cache);
+        analysis.use_def(ast, /*propagate_graph_nodes*/ true);
+        const ObjectList<ExtensibleGraph*> pcfgs = analysis.get_pcfgs();
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            const Symbol func_sym = (*it)->get_function_symbol();
+            const std::map<Symbol, ExtensibleGraph*>::iterator first = first_pcfgs.find(func_sym);
+            ERROR_CONDITION(first == first_pcfgs.end(),
+                            "PCFG '%s' not built in the first analysis\n", (*it)->get_name().c_str());
+            const bool reused = (first->second == *it);
+            const bool must_be_rebuilt = (rebuilt.find(func_sym.get_name()) != rebuilt.end());
+            if (VERBOSE)
+                printf("Check PCFG '%s' has been %s\n", (*it)->get_name().c_str(), (reused ? "reused" : "rebuilt"));
+            if (reused == must_be_rebuilt)
+            {
+                internal_error("PCFG '%s' has been %s, but it should have been %s\n",
+                               (*it)->get_name().c_str(),
+                               (reused ? "reused" : "rebuilt"),
+                               (must_be_rebuilt ? "rebuilt" : "reused"));
+            }
+        }
+    }
+
     void AnalysisCheckPhase::check_pcfg_consistency(ExtensibleGraph* graph)
     {
         Node* graph_node = graph->get_graph();
@@ -1135,6 +1250,21 @@ namespace {
         if (ompss_mode_str == "1")
             _ompss_mode_enabled = true;
     }
+
+    void AnalysisCheckPhase::set_range_solver(const std::string& range_solver_str)
+    {
+        if (range_solver_str == "sparse" || range_solver_str == "sparse_infinity")
+        {
+            _range_solver_options._solver = __SparseSolver;
+            _range_solver_options._widening = (range_solver_str == "sparse" ? __WidenToThresholds
+                                                                             : __WidenToInfinity);
+        }
+        else if (range_solver_str != "constraint_graph")
+        {
+            WARNING_MESSAGE("Unknown range solver '%s'. Using the Constraint Graph solver.",
+                            range_solver_str.c_str());
+        }
+    }
     
     void AnalysisCheckVisitor::visit(const Nodecl::Analysis::Assert& n)
     {
@@ -65,6 +65,16 @@ namespace Analysis {
         std::string _ompss_mode_str;
         bool _ompss_mode_enabled;
         void set_ompss_mode( const std::string& ompss_mode_str);
+
+        //! Members to select the solver of Range Analysis
+        std::string _range_solver_str;
+        RangeSolverOptions _range_solver_options;
+        void set_range_solver( const std::string& range_solver_str);
+
+        //! Members to check the reuse of PCFGs across analyses (see check_pcfg_cache)
+        std::string _cache_check_modify_str;
+        std::string _cache_check_rebuilt_str;
+        void check_pcfg_cache( const NBase& ast );
         
         //!Entry point of the phase
         virtual void run( TL::DTO& dto );
@@ -30,6 +30,7 @@
 #include "cxx-process.h"
 
 #include "tl-analysis-base.hpp"
+#include "tl-analysis-parallel.hpp"
 #include "tl-analysis-utils.hpp"
 #include "tl-auto-scope.hpp"
 #include "tl-cyclomatic-complexity.hpp"
@@ -46,15 +47,258 @@
 namespace TL {
 namespace Analysis {
 
+    static void print_pcfg_computation_time(const char* analysis, ExtensibleGraph* pcfg, double init)
+    {
+        fprintf(stderr, "ANALYSIS:     %s of PCFG '%s' computation time: %lf\n",
+                analysis, pcfg->get_name().c_str(), (time_nsec() - init)*1E-9);
+    }
+
+    // ************************************************************************************ //
+    // ************* Function-local analyses, run concurrently for each PCFG ************** //
+
+    static ExtensibleGraph* build_pcfg(
+            const NBase& ast,
+            const std::string& pcfg_name,
+            const std::map<Symbol, NBase>& asserted_funcs,
+            bool is_ompss_enabled)
+    {
+        double init = 0.0;
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            init = time_nsec();
+
+        // Create the PCFG
+        if (VERBOSE)
+            std::cerr << "Parallel Control Flow Graph (PCFG) '" << pcfg_name << "'" << std::endl;
+        PCFGVisitor v(pcfg_name, ast);
+        ExtensibleGraph* pcfg = v.parallel_control_flow_graph(ast, asserted_funcs);
+
+        // Synchronize the tasks, if applies
+        if (VERBOSE)
+            std::cerr << "Task Synchronization of PCFG '" << pcfg_name << "'" << std::endl;
+        TaskAnalysis::TaskSynchronizations task_sync_analysis(pcfg, is_ompss_enabled);
+        task_sync_analysis.compute_task_synchronizations();
+
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            print_pcfg_computation_time("PCFG", pcfg, init);
+
+        return pcfg;
+    }
+
+    namespace {
+        class PCFGConstructionWork : public ParallelWork
+        {
+        private:
+            const ObjectList<NBase>& _asts;
+            const std::vector<std::string>& _names;
+            const std::map<Symbol, NBase>& _asserted_funcs;
+            bool _is_ompss_enabled;
+            std::vector<ExtensibleGraph*>& _result;
+
+        public:
+            PCFGConstructionWork(
+                    const ObjectList<NBase>& asts,
+                    const std::vector<std::string>& names,
+                    const std::map<Symbol, NBase>& asserted_funcs,
+                    bool is_ompss_enabled,
+                    std::vector<ExtensibleGraph*>& result)
+                : _asts(asts), _names(names), _asserted_funcs(asserted_funcs),
+                  _is_ompss_enabled(is_ompss_enabled), _result(result)
+            {}
+
+            void run(unsigned int i)
+            {
+                _result[i] = build_pcfg(_asts[i], _names[i], _asserted_funcs, _is_ompss_enabled);
+            }
+        };
+    }
+
+    static void compute_pointer_size(ExtensibleGraph* pcfg, bool /*propagate_graph_nodes*/)
+    {
+        if (pcfg->usage_is_computed())
+            return;
+        PointerSize ps(pcfg);
+        ps.compute_pointer_vars_size();
+    }
+
+    static void compute_liveness(ExtensibleGraph* pcfg, bool propagate_graph_nodes)
+    {
+        if (VERBOSE)
+            std::cerr << "Liveness of PCFG '" << pcfg->get_name() << "'" << std::endl;
+        double init = 0.0;
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            init = time_nsec();
+
+        Liveness l(pcfg, propagate_graph_nodes);
+        l.compute_liveness();
+
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            print_pcfg_computation_time("LIVENESS", pcfg, init);
+    }
+
+    static void compute_reaching_definitions(ExtensibleGraph* pcfg, bool /*propagate_graph_nodes*/)
+    {
+        if (VERBOSE)
+            std::cerr << "Reaching Definitions of PCFG '" << pcfg->get_name() << "'" << std::endl;
+        double init = 0.0;
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            init = time_nsec();
+
+        ReachingDefinitions rd(pcfg);
+        rd.compute_reaching_definitions();
+
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            print_pcfg_computation_time("REACHING_DEFINITIONS", pcfg, init);
+    }
+
+    static void compute_induction_variables(ExtensibleGraph* pcfg, bool /*propagate_graph_nodes*/)
+    {
+        if (VERBOSE)
+            std::cerr << "Induction Variables of PCFG '" << pcfg->get_name() << "'" << std::endl;
+
+        double init = 0.0;
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            init = time_nsec();
+
+        // Compute the induction variables of all loops of each PCFG
+        InductionVariableAnalysis iva(pcfg);
+        iva.compute_induction_variables();
+
+        // Compute the limits of the induction variables
+        Utils::InductionVarsPerNode ivs = iva.get_all_induction_vars();
+        LoopAnalysis la(pcfg, ivs);
+        la.compute_loop_ranges();
+
+        if (VERBOSE)
+            Utils::print_induction_vars(ivs);
+
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            print_pcfg_computation_time("INDUCTION_VARIABLES", pcfg, init);
+    }
+
+    static void compute_cyclomatic_complexity(ExtensibleGraph* pcfg, bool /*propagate_graph_nodes*/)
+    {
+        if (VERBOSE)
+            std::cerr << "Cyclomatic Complexity of PCFG '" << pcfg->get_name() << "'" << std::endl;
+
+        double init = 0.0;
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            init = time_nsec();
+
+        // Compute the cyclomatic complexity of each PCFG
+        CyclomaticComplexity cc(pcfg);
+        unsigned int res = cc.compute_cyclomatic_complexity();
+
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            print_pcfg_computation_time("CYCLOMATIC_COMPLEXITY", pcfg, init);
+
+        if (VERBOSE)
+            printf(" = %d\n", res);
+    }
+
+    static void compute_auto_scoping(ExtensibleGraph* pcfg, bool /*propagate_graph_nodes*/)
+    {
+        if (VERBOSE)
+            std::cerr << "Auto-Scoping of PCFG '" << pcfg->get_name() << "'" << std::endl;
+
+        double init = 0.0;
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            init = time_nsec();
+
+        AutoScoping as(pcfg);
+        as.compute_auto_scoping();
+
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            print_pcfg_computation_time("AUTO_SCOPING", pcfg, init);
+    }
+
+    // *********** END function-local analyses, run concurrently for each PCFG ************ //
+    // ************************************************************************************ //
+
     AnalysisBase::AnalysisBase(bool is_ompss_enabled)
-            : _pcfgs(), _tdgs(), _all_functions(), _is_ompss_enabled(is_ompss_enabled),
+            : _pcfgs(), _tdgs(), _all_functions(), _asserted_funcs(),
+              _is_ompss_enabled(is_ompss_enabled), _analysis_cache(), _cache(NULL),
+              _n_threads(1), _range_solver_options(),
               _pcfg(false), /*_constants_propagation(false),*/ _canonical(false),
-              _use_def(false), _liveness(false), _loops(false),
+              _use_def(false), _use_def_propagate_graph_nodes(false), _liveness(false), _loops(false),
               _reaching_definitions(false), _induction_variables(false),
               _range(false), _cyclomatic_complexity(false),
               _auto_scoping(false), _auto_deps(false), _tdg(false)
     {}
 
+    void AnalysisBase::set_n_threads(unsigned int n_threads)
+    {
+        _n_threads = (n_threads == 0 ? 1 : n_threads);
+    }
+
+    void AnalysisBase::set_range_solver_options(const RangeSolverOptions& options)
+    {
+        _range_solver_options = options;
+    }
+
+    void AnalysisBase::set_cache(std::shared_ptr<AnalysisCache> cache)
+    {
+        ERROR_CONDITION(_pcfg, "The analysis cache must be set before computing any analysis", 0);
+        _analysis_cache = cache;
+        _cache = (cache ? &cache->get_pcfg_cache(_is_ompss_enabled) : NULL);
+    }
+
+    unsigned int AnalysisBase::get_n_threads() const
+    {
+        // Verbose messages prettyprint nodecls and the codegen is not reentrant
+        return (VERBOSE ? 1 : _n_threads);
+    }
+
+    ObjectList<ExtensibleGraph*> AnalysisBase::get_pcfgs_to_compute(unsigned int analysis) const
+    {
+        ObjectList<ExtensibleGraph*> pcfgs = get_pcfgs();
+        if (_cache == NULL || analysis == WhichAnalysis::NONE)
+            return pcfgs;
+
+        ObjectList<ExtensibleGraph*> result;
+        for (ObjectList<ExtensibleGraph*>::iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            if (!_cache->is_computed(*it, analysis))
+                result.append(*it);
+        }
+        return result;
+    }
+
+    void AnalysisBase::set_computed(const ObjectList<ExtensibleGraph*>& pcfgs, unsigned int analysis)
+    {
+        if (_cache == NULL || analysis == WhichAnalysis::NONE)
+            return;
+
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+            _cache->set_computed(*it, analysis);
+    }
+
+    void AnalysisBase::run_on_pcfgs(
+            PCFGWork::pcfg_analysis_t analysis,
+            bool propagate_graph_nodes,
+            unsigned int which)
+    {
+        const ObjectList<ExtensibleGraph*> pcfgs = get_pcfgs_to_compute(which);
+        PCFGWork work(pcfgs, analysis, propagate_graph_nodes);
+        parallel_for(pcfgs.size(), work, get_n_threads());
+        set_computed(pcfgs, which);
+    }
+
+    void AnalysisBase::rebuild_incompatible_pcfgs(bool propagate_graph_nodes)
+    {
+        if (_cache == NULL)
+            return;
+
+        for (Name_to_pcfg_map::iterator it = _pcfgs.begin(); it != _pcfgs.end(); ++it)
+        {
+            if (_cache->is_compatible(it->second, propagate_graph_nodes))
+                continue;
+
+            NBase ast = it->second->get_nodecl();
+            it->second = build_pcfg(ast, it->first, _asserted_funcs, _is_ompss_enabled);
+            _cache->set_pcfg(ast, it->second);
+        }
+    }
+
     ExtensibleGraph* AnalysisBase::get_pcfg(std::string name) const
     {
         ExtensibleGraph* pcfg = NULL;
@@ -94,21 +338,29 @@ namespace Analysis {
             const std::map<Symbol, NBase>& asserted_funcs,
             std::set<Symbol>& visited_funcs)
     {
+        ExtensibleGraph* pcfg = (_cache != NULL ? _cache->get_pcfg(ast) : NULL);
+        if (pcfg != NULL)
+        {
+            register_pcfg(pcfg->get_name(), pcfg, visited_funcs);
+            return pcfg;
+        }
+
         // Generate the hashed name corresponding to the AST of the function
         std::string pcfg_name = Utils::generate_hashed_name(ast);
 
-        // Create the PCFG
-        if (VERBOSE)
-            std::cerr << "Parallel Control Flow Graph (PCFG) '" << pcfg_name << "'" << std::endl;
-        PCFGVisitor v(pcfg_name, ast);
-        ExtensibleGraph* pcfg = v.parallel_control_flow_graph(ast, asserted_funcs);
+        pcfg = build_pcfg(ast, pcfg_name, asserted_funcs, _is_ompss_enabled);
+        if (_cache != NULL)
+            _cache->set_pcfg(ast, pcfg);
+        register_pcfg(pcfg_name, pcfg, visited_funcs);
 
-        // Synchronize the tasks, if applies
-        if (VERBOSE)
-            std::cerr << "Task Synchronization of PCFG '" << pcfg_name << "'" << std::endl;
-        TaskAnalysis::TaskSynchronizations task_sync_analysis(pcfg, _is_ompss_enabled);
-        task_sync_analysis.compute_task_synchronizations();
+        return pcfg;
+    }
 
+    void AnalysisBase::register_pcfg(
+            const std::string& pcfg_name,
+            ExtensibleGraph* pcfg,
+            std::set<Symbol>& visited_funcs)
+    {
         // Store the pcfg
         _pcfgs[pcfg_name] = pcfg;
 
@@ -116,8 +368,6 @@ namespace Analysis {
         Symbol func_sym = pcfg->get_function_symbol();
         if (func_sym.is_valid())
             visited_funcs.insert(func_sym);
-
-        return pcfg;
     }
 
     void AnalysisBase::parallel_control_flow_graph_rec(
@@ -162,7 +412,7 @@ namespace Analysis {
         _pcfg = true;
 
         ObjectList<NBase> unique_asts;
-        std::map<Symbol, NBase> asserted_funcs;
+        std::map<Symbol, NBase>& asserted_funcs = _asserted_funcs;
 
         // Get all unique ASTs embedded in 'ast'
         if (!ast.is<Nodecl::TopLevel>())
@@ -190,11 +440,40 @@ namespace Analysis {
             asserted_funcs = tlv.get_asserted_funcs();
         }
 
-        // Compute the PCFG corresponding to each AST
+        // Reuse the cached PCFGs whose functions have not been modified
         std::set<Symbol> visited_funcs;
-        for (ObjectList<NBase>::iterator it = unique_asts.begin(); it != unique_asts.end(); ++it)
+        ObjectList<NBase> asts_to_build;
+        if (_cache != NULL)
         {
-            create_pcfg(*it, asserted_funcs, visited_funcs);
+            _cache->invalidate_modified_functions();
+            for (ObjectList<NBase>::iterator it = unique_asts.begin(); it != unique_asts.end(); ++it)
+            {
+                ExtensibleGraph* pcfg = _cache->get_pcfg(*it);
+                if (pcfg != NULL)
+                    register_pcfg(pcfg->get_name(), pcfg, visited_funcs);
+                else
+                    asts_to_build.append(*it);
+            }
+        }
+        else
+        {
+            asts_to_build = unique_asts;
+        }
+
+        // Compute the PCFG corresponding to each remaining AST
+        // The names are generated beforehand because they are built with non-reentrant functions
+        std::vector<std::string> pcfg_names;
+        for (ObjectList<NBase>::iterator it = asts_to_build.begin(); it != asts_to_build.end(); ++it)
+            pcfg_names.push_back(Utils::generate_hashed_name(*it));
+        std::vector<ExtensibleGraph*> new_pcfgs(asts_to_build.size(), NULL);
+        PCFGConstructionWork work(asts_to_build, pcfg_names, asserted_funcs, _is_ompss_enabled, new_pcfgs);
+        parallel_for(asts_to_build.size(), work, get_n_threads());
+
+        for (unsigned int i = 0; i < new_pcfgs.size(); ++i)
+        {
+            if (_cache != NULL)
+                _cache->set_pcfg(asts_to_build[i], new_pcfgs[i]);
+            register_pcfg(pcfg_names[i], new_pcfgs[i], visited_funcs);
         }
 
         // Make sure all called functions whose code is reachable, have been computed
@@ -231,39 +510,73 @@ namespace Analysis {
 //         }
 //     }
 
-    static void use_def_rec(
-            Symbol func_sym,
-            bool propagate_graph_nodes,
-            std::set<Symbol>& visited_funcs,
-            ObjectList<ExtensibleGraph*>& pcfgs)
+    //! State of Tarjan's algorithm computing the strongly connected components of the call graph
+    struct CallGraphSCCs
     {
-        // Nothing to do if we are analyzing something that:
-        // - is not a function
-        // - has already been analyzed
-        if (!func_sym.is_valid() || (visited_funcs.find(func_sym) != visited_funcs.end()))
-            return;
-
-        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        std::map<Symbol, ExtensibleGraph*> _func_to_pcfg;
+        std::map<Symbol, unsigned int> _index;
+        std::map<Symbol, unsigned int> _lowlink;
+        ObjectList<Symbol> _stack;
+        std::set<Symbol> _on_stack;
+        //! Components in reverse topological order: the functions called from a component appear before it
+        ObjectList<ObjectList<ExtensibleGraph*> > _sccs;
+    };
+
+    static void compute_call_graph_sccs_rec(Symbol func_sym, CallGraphSCCs& state)
+    {
+        unsigned int index = state._index.size();
+        state._index[func_sym] = index;
+        state._lowlink[func_sym] = index;
+        state._stack.append(func_sym);
+        state._on_stack.insert(func_sym);
+
+        // Only the functions with a PCFG take part in the call graph
+        ObjectList<Symbol> called_funcs = state._func_to_pcfg[func_sym]->get_function_calls();
+        for (ObjectList<Symbol>::iterator it = called_funcs.begin(); it != called_funcs.end(); ++it)
         {
-            Symbol it_func_sym((*it)->get_function_symbol());
-            if (it_func_sym.is_valid() && it_func_sym == func_sym)
+            if (state._func_to_pcfg.find(*it) == state._func_to_pcfg.end())
+                continue;
+            if (state._index.find(*it) == state._index.end())
             {
-                visited_funcs.insert(func_sym);
-                if (!(*it)->usage_is_computed())
-                {
-                    // Recursively analyze the functions called from the current graph
-                    ObjectList<Symbol> called_funcs = (*it)->get_function_calls();
-                    for (ObjectList<Symbol>::iterator itf = called_funcs.begin(); itf != called_funcs.end(); ++itf)
-                        use_def_rec(*itf, propagate_graph_nodes, visited_funcs, pcfgs);
-
-                    // Analyze the current graph
-                    if (VERBOSE)
-                        std::cerr << "Use-Definition of PCFG '" << (*it)->get_name() << "'" << std::endl;
-                    UseDef ud(*it, propagate_graph_nodes, pcfgs);
-                    ud.compute_usage();
-                }
+                compute_call_graph_sccs_rec(*it, state);
+                state._lowlink[func_sym] = std::min(state._lowlink[func_sym], state._lowlink[*it]);
+            }
+            else if (state._on_stack.find(*it) != state._on_stack.end())
+            {
+                state._lowlink[func_sym] = std::min(state._lowlink[func_sym], state._index[*it]);
             }
         }
+
+        if (state._lowlink[func_sym] == index)
+        {   // func_sym is the root of a component
+            ObjectList<ExtensibleGraph*> scc;
+            Symbol s;
+            do {
+                s = state._stack.back();
+                state._stack.pop_back();
+                state._on_stack.erase(s);
+                scc.append(state._func_to_pcfg[s]);
+            } while (s != func_sym);
+            state._sccs.append(scc);
+        }
+    }
+
+    static ObjectList<ObjectList<ExtensibleGraph*> > compute_call_graph_sccs(const ObjectList<ExtensibleGraph*>& pcfgs)
+    {
+        CallGraphSCCs state;
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            Symbol func_sym((*it)->get_function_symbol());
+            if (func_sym.is_valid())
+                state._func_to_pcfg[func_sym] = *it;
+        }
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            Symbol func_sym((*it)->get_function_symbol());
+            if (func_sym.is_valid() && state._index.find(func_sym) == state._index.end())
+                compute_call_graph_sccs_rec(func_sym, state);
+        }
+        return state._sccs;
     }
 
     void AnalysisBase::use_def(
@@ -283,23 +596,63 @@ namespace Analysis {
             init = time_nsec();
 
         _use_def = true;
+        _use_def_propagate_graph_nodes = propagate_graph_nodes;
 
-        std::set<Symbol> visited_funcs;
+        // Cached PCFGs computed with a different propagation of the graph nodes cannot be reused
+        rebuild_incompatible_pcfgs(propagate_graph_nodes);
+
+        // The size of the pointers only depends on the code of each function
+        // Both pointer sizes and Use-Definition are skipped for the PCFGs whose usage is already computed
+        run_on_pcfgs(compute_pointer_size, propagate_graph_nodes, WhichAnalysis::NONE);
+
+        // Use-Definition runs sequentially, in call graph SCC order, so the usage summaries of the callees
+        // are available when their callers are analyzed (calls within a component are treated conservatively).
+        // PCFGs not related to a function are not analyzed
         ObjectList<ExtensibleGraph*> pcfgs = get_pcfgs();
+        ObjectList<ExtensibleGraph*> new_usage_pcfgs;
         for (ObjectList<ExtensibleGraph*>::iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
         {
             if (!(*it)->usage_is_computed())
+                new_usage_pcfgs.append(*it);
+        }
+        const ObjectList<ObjectList<ExtensibleGraph*> >& sccs = compute_call_graph_sccs(pcfgs);
+        for (ObjectList<ObjectList<ExtensibleGraph*> >::const_iterator its = sccs.begin(); its != sccs.end(); ++its)
+        {
+            for (ObjectList<ExtensibleGraph*>::const_iterator it = its->begin(); it != its->end(); ++it)
             {
-                PointerSize ps(*it);
-                ps.compute_pointer_vars_size();
-                use_def_rec((*it)->get_function_symbol(), propagate_graph_nodes, visited_funcs, pcfgs);
+                if ((*it)->usage_is_computed())
+                    continue;
+
+                if (VERBOSE)
+                    std::cerr << "Use-Definition of PCFG '" << (*it)->get_name() << "'" << std::endl;
+                double init_pcfg = 0.0;
+                if (ANALYSIS_PERFORMANCE_MEASURE)
+                    init_pcfg = time_nsec();
+
+                UseDef ud(*it, propagate_graph_nodes, pcfgs);
+                ud.compute_usage();
+
+                if (ANALYSIS_PERFORMANCE_MEASURE)
+                    print_pcfg_computation_time("USE_DEF", *it, init_pcfg);
             }
         }
+        if (_cache != NULL)
+        {
+            for (ObjectList<ExtensibleGraph*>::iterator it = new_usage_pcfgs.begin(); it != new_usage_pcfgs.end(); ++it)
+                _cache->set_propagate_graph_nodes(*it, propagate_graph_nodes);
+            set_computed(new_usage_pcfgs, WhichAnalysis::USAGE_ANALYSIS);
+        }
 
         if (ANALYSIS_PERFORMANCE_MEASURE)
             fprintf(stderr, "ANALYSIS: USE_DEF computation time: %lf\n", (time_nsec() - init)*1E-9);
     }
 
+    void AnalysisBase::write_usage_summaries(const std::string& file_name)
+    {
+        ERROR_CONDITION(!_use_def, "Usage summaries cannot be written before computing Use-Definition", 0);
+        TL::Analysis::write_usage_summaries(get_pcfgs(), _use_def_propagate_graph_nodes, file_name);
+    }
+
     void AnalysisBase::liveness(
             const NBase& ast,
             bool propagate_graph_nodes,
@@ -319,14 +672,7 @@ namespace Analysis {
 
         _liveness = true;
 
-        const ObjectList<ExtensibleGraph*>& pcfgs = get_pcfgs();
-        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
-        {
-            if (VERBOSE)
-                std::cerr << "Liveness of PCFG '" << (*it)->get_name() << "'" << std::endl;
-            Liveness l(*it, propagate_graph_nodes);
-            l.compute_liveness();
-        }
+        run_on_pcfgs(compute_liveness, propagate_graph_nodes, WhichAnalysis::LIVENESS_ANALYSIS);
 
         if (ANALYSIS_PERFORMANCE_MEASURE)
             fprintf(stderr, "ANALYSIS: LIVENESS computation time: %lf\n", (time_nsec() - init)*1E-9);
@@ -350,14 +696,7 @@ namespace Analysis {
 
         _reaching_definitions = true;
 
-        const ObjectList<ExtensibleGraph*>& pcfgs = get_pcfgs();
-        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
-        {
-            if (VERBOSE)
-                std::cerr << "Reaching Definitions of PCFG '" << (*it)->get_name() << "'" << std::endl;
-            ReachingDefinitions rd(*it);
-            rd.compute_reaching_definitions();
-        }
+        run_on_pcfgs(compute_reaching_definitions, propagate_graph_nodes, WhichAnalysis::REACHING_DEFS_ANALYSIS);
 
         if (ANALYSIS_PERFORMANCE_MEASURE)
             fprintf(stderr, "ANALYSIS: REACHING_DEFINITIONS computation time: %lf\n", (time_nsec() - init)*1E-9);
@@ -381,27 +720,10 @@ namespace Analysis {
 
         _induction_variables = true;
 
-        const ObjectList<ExtensibleGraph*>& pcfgs = get_pcfgs();
-        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
-        {
-            if (VERBOSE)
-                std::cerr << "Induction Variables of PCFG '" << (*it)->get_name() << "'" << std::endl;
-
-            // Compute the induction variables of all loops of each PCFG
-            InductionVariableAnalysis iva(*it);
-            iva.compute_induction_variables();
+        run_on_pcfgs(compute_induction_variables, propagate_graph_nodes, WhichAnalysis::INDUCTION_VARS_ANALYSIS);
 
-            // Compute the limits of the induction variables
-            Utils::InductionVarsPerNode ivs = iva.get_all_induction_vars();
-            LoopAnalysis la(*it, ivs);
-            la.compute_loop_ranges();
-
-            if (VERBOSE)
-                Utils::print_induction_vars(ivs);
-
-            if (ANALYSIS_PERFORMANCE_MEASURE)
-                fprintf(stderr, "ANALYSIS: INDUCTION_VARIABLES computation time: %lf\n", (time_nsec() - init)*1E-9);
-        }
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            fprintf(stderr, "ANALYSIS: INDUCTION_VARIABLES computation time: %lf\n", (time_nsec() - init)*1E-9);
     }
 
     void AnalysisBase::range_analysis(
@@ -421,16 +743,26 @@ namespace Analysis {
 
         _range = true;
 
-        const ObjectList<ExtensibleGraph*>& pcfgs = get_pcfgs();
+        // Range analysis runs sequentially: it creates new symbols in the scopes of the functions
+        // and numbers its constraints with translation unit wide counters
+        const ObjectList<ExtensibleGraph*> pcfgs = get_pcfgs_to_compute(WhichAnalysis::RANGE_ANALYSIS);
         for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
         {
             if (VERBOSE)
                 std::cerr << "Range Analysis of PCFG '" << (*it)->get_name() << "'" << std::endl;
 
-            // Compute the induction variables of all loops of each PCFG
-            RangeAnalysis ra(*it);
+            double pcfg_init = 0.0;
+            if (ANALYSIS_PERFORMANCE_MEASURE)
+                pcfg_init = time_nsec();
+
+            // Compute the ranges of the variables of each PCFG
+            RangeAnalysis ra(*it, _range_solver_options);
             ra.compute_range_analysis();
+
+            if (ANALYSIS_PERFORMANCE_MEASURE)
+                print_pcfg_computation_time("RANGE_ANALYSIS", *it, pcfg_init);
         }
+        set_computed(pcfgs, WhichAnalysis::RANGE_ANALYSIS);
 
         if (ANALYSIS_PERFORMANCE_MEASURE)
             fprintf(stderr, "ANALYSIS: RANGE_ANALYSIS computation time: %lf\n", (time_nsec() - init)*1E-9);
@@ -452,19 +784,8 @@ namespace Analysis {
             init = time_nsec();
 
         _cyclomatic_complexity = true;
-        
-        const ObjectList<ExtensibleGraph*>& pcfgs = get_pcfgs();
-        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
-        {
-            if (VERBOSE)
-                std::cerr << "Cyclomatic Complexity of PCFG '" << (*it)->get_name() << "'" << std::endl;
-            
-            // Compute the cyclomatic complexity of each PCFG
-            CyclomaticComplexity cc(*it);
-            unsigned int res = cc.compute_cyclomatic_complexity();
-            if (VERBOSE)
-                printf(" = %d\n", res);
-        }
+
+        run_on_pcfgs(compute_cyclomatic_complexity, /*propagate_graph_nodes*/ false, WhichAnalysis::NONE);
 
         if (ANALYSIS_PERFORMANCE_MEASURE)
             fprintf(stderr, "ANALYSIS: CYCLOMATIC_COMPLEXITY computation time: %lf\n", (time_nsec() - init)*1E-9);
@@ -487,15 +808,7 @@ namespace Analysis {
 
         _auto_scoping = true;
 
-        const ObjectList<ExtensibleGraph*>& pcfgs = get_pcfgs();
-        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
-        {
-            if (VERBOSE)
-                std::cerr << "Auto-Scoping of PCFG '" << (*it)->get_name() << "'" << std::endl;
-
-            AutoScoping as(*it);
-            as.compute_auto_scoping();
-        }
+        run_on_pcfgs(compute_auto_scoping, /*propagate_graph_nodes*/ true, WhichAnalysis::AUTO_SCOPING);
 
         if (ANALYSIS_PERFORMANCE_MEASURE)
             fprintf(stderr, "ANALYSIS: AUTO_SCOPING computation time: %lf\n", (time_nsec() - init)*1E-9);
@@ -29,8 +29,11 @@
 
 #include <map>
 
+#include "tl-analysis-cache.hpp"
+#include "tl-analysis-parallel.hpp"
 #include "tl-extensible-graph.hpp"
 #include "tl-induction-variables-data.hpp"
+#include "tl-range-solver.hpp"
 #include "tl-task-dependency-graph.hpp"
 
 // Set of classes implementing the Memento Pattern with Analysis purposes.
@@ -94,13 +97,25 @@ namespace Analysis {
         Name_to_pcfg_map _pcfgs;
         Name_to_tdg_map _tdgs;
         ObjectList<NBase> _all_functions;
+        std::map<Symbol, NBase> _asserted_funcs;
 
         bool _is_ompss_enabled;
+
+        //! Cache shared with other AnalysisBase objects (possibly from other phases), or NULL
+        std::shared_ptr<AnalysisCache> _analysis_cache;
+        PCFGCache* _cache;
+
+        //! Maximum number of threads used to analyze different functions concurrently
+        unsigned int _n_threads;
+
+        //! Configuration of the solver used by Range Analysis
+        RangeSolverOptions _range_solver_options;
         
         bool _pcfg;                 //!<True when parallel control flow graph have bee build
 //         bool _constants_propagation;//!<True when constant propagation and constant folding have been applied
         bool _canonical;            //!<True when expressions canonicalization has been applied
         bool _use_def;              //!<True when use-definition chains have been calculated
+        bool _use_def_propagate_graph_nodes;    //!<Propagation of the graph nodes used to compute use-definition
         bool _liveness;             //!<True when liveness analysis has been applied
         bool _loops;                //!<True when loops analysis has been applied
         bool _reaching_definitions; //!<True when reaching definitions has been calculated
@@ -128,6 +143,10 @@ namespace Analysis {
                 const NBase& ast,
                 const std::map<Symbol, NBase>& asserted_funcs,
                 std::set<Symbol>& visited_funcs);
+        void register_pcfg(
+                const std::string& pcfg_name,
+                ExtensibleGraph* pcfg,
+                std::set<Symbol>& visited_funcs);
         void parallel_control_flow_graph_rec(
                 ExtensibleGraph* pcfg,
                 const std::map<Symbol, NBase>& asserted_funcs,
@@ -135,6 +154,27 @@ namespace Analysis {
 
         // *************** Private methods **************** //
 
+        //! Number of threads actually used: verbose mode forces a sequential execution
+        unsigned int get_n_threads() const;
+
+        //! Returns the PCFGs where \p analysis (a WhichAnalysis tag) has not been computed yet
+        //! Without a cache, all PCFGs are new, so all of them are returned
+        ObjectList<ExtensibleGraph*> get_pcfgs_to_compute(unsigned int analysis) const;
+
+        //! Records that \p analysis (a WhichAnalysis tag) has been computed on \p pcfgs
+        void set_computed(const ObjectList<ExtensibleGraph*>& pcfgs, unsigned int analysis);
+
+        /*!Applies a function-local \p analysis to all PCFGs, concurrently when more than one thread is allowed
+         * PCFGs taken from the cache where \p which (a WhichAnalysis tag) has been already computed are skipped
+         */
+        void run_on_pcfgs(
+                PCFGWork::pcfg_analysis_t analysis,
+                bool propagate_graph_nodes,
+                unsigned int which);
+
+        //! Rebuilds the cached PCFGs whose data-flow analyses were computed with a different \p propagate_graph_nodes
+        void rebuild_incompatible_pcfgs(bool propagate_graph_nodes);
+
         //!Prevents copy construction.
         AnalysisBase(const AnalysisBase& analysis){};
 
@@ -146,6 +186,28 @@ namespace Analysis {
         // *** Constructor *** //
         AnalysisBase(bool is_ompss_enabled);
 
+        /*!Sets the maximum number of threads used to build and analyze the PCFGs of different functions
+         * By default, 1 (everything is computed sequentially)
+         * The PCFG construction and the function-local analyses (liveness, reaching definitions,
+         * induction variables, cyclomatic complexity and auto-scoping) are computed concurrently.
+         * Use-Definition and Range Analysis are always computed sequentially.
+         */
+        void set_n_threads(unsigned int n_threads);
+
+        /*!Sets the cache where the PCFGs are searched before building them, and stored afterwards
+         * The PCFGs of the functions not modified since they were cached (and not calling modified functions)
+         * are reused, together with the analyses already computed on them.
+         * Modifications are tracked through Nodecl::Utils::mark_enclosing_function_code_as_modified
+         * and a fingerprint of the function tree, so any change to the nodes of a function is detected.
+         * Changes to symbols that are not reflected in the tree (e.g. TL::Symbol::set_type) must be marked explicitly.
+         */
+        void set_cache(std::shared_ptr<AnalysisCache> cache);
+
+        /*!Sets the solver used by Range Analysis and its widening/narrowing strategy
+         * By default, the constraints are solved over the Constraint Graph
+         */
+        void set_range_solver_options(const RangeSolverOptions& options);
+
         // *** Getters *** //
         ObjectList<ExtensibleGraph*> get_pcfgs() const;
         ObjectList<TaskDependencyGraph*> get_tdgs() const;
@@ -178,6 +240,12 @@ namespace Analysis {
                 std::set<std::string> functions = std::set<std::string>(),
                 bool call_graph = true);
 
+        /*!Writes the usage summaries of the functions analyzed to \p file_name (Use-Definition must be computed)
+         * The file can be loaded with UseDef::add_usage_summaries_file when analyzing other translation units,
+         * so calls to these functions are not treated as calls to unknown code
+         */
+        void write_usage_summaries(const std::string& file_name);
+
         void liveness(
                 const NBase& ast,
                 bool propagate_graph_nodes,
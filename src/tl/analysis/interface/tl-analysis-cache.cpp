@@ -0,0 +1,237 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#include "tl-analysis-cache.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "cxx-nodecl.h"
+
+#include <stack>
+
+namespace TL {
+namespace Analysis {
+
+    // **************************************************************************************************** //
+    // ***************************** Cache of PCFGs alive across compiler phases ************************** //
+
+    namespace {
+        void combine(size_t& h, size_t v)
+        {
+            h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+        }
+    }
+
+    // Identity of every node and of its symbol, type, constant and text.
+    // Any change done to the tree after the PCFG was built, including those that do not go
+    // through the Nodecl::Utils modifiers (e.g. generated setters), changes the fingerprint
+    size_t PCFGCache::get_fingerprint(const NBase& ast)
+    {
+        size_t h = 0;
+
+        // Lists are deeply nested, so the tree is walked without recursion
+        std::stack<nodecl_t> pending;
+        pending.push(ast.get_internal_nodecl());
+        while (!pending.empty())
+        {
+            nodecl_t n = pending.top();
+            pending.pop();
+
+            if (nodecl_is_null(n))
+            {
+                combine(h, 0);
+                continue;
+            }
+
+            combine(h, (size_t)nodecl_get_ast(n));
+            combine(h, (size_t)nodecl_get_kind(n));
+            combine(h, (size_t)nodecl_get_symbol(n));
+            combine(h, (size_t)nodecl_get_type(n));
+            combine(h, (size_t)nodecl_get_constant(n));
+            // Texts are unique strings
+            combine(h, (size_t)nodecl_get_text(n));
+
+            for (int i = MCXX_MAX_AST_CHILDREN - 1; i >= 0; --i)
+                pending.push(nodecl_get_child(n, i));
+        }
+
+        return h;
+    }
+
+    bool PCFGCache::is_up_to_date(const Symbol& func_sym, const CachedPCFG& entry)
+    {
+        return entry._stamp == Nodecl::Utils::get_function_code_modification_stamp(func_sym)
+            && entry._fingerprint == get_fingerprint(entry._function_code);
+    }
+
+    PCFGCache::PCFGCache()
+        : _cached_pcfgs()
+    {}
+
+    Symbol PCFGCache::get_function_symbol(const NBase& ast)
+    {
+        if (ast.is<Nodecl::FunctionCode>())
+            return ast.get_symbol();
+        if (ast.is<Nodecl::OpenMP::SimdFunction>())
+            return ast.as<Nodecl::OpenMP::SimdFunction>().get_statement().get_symbol();
+        return Symbol();
+    }
+
+    PCFGCache::CachedPCFG* PCFGCache::get_entry(ExtensibleGraph* pcfg)
+    {
+        Function_to_cached_pcfg_map::iterator it = _cached_pcfgs.find(pcfg->get_function_symbol());
+        if (it == _cached_pcfgs.end() || it->second._pcfg != pcfg)
+            return NULL;
+        return &it->second;
+    }
+
+    void PCFGCache::invalidate_modified_functions()
+    {
+        // 1.- Collect the functions modified since their PCFG was built
+        std::set<Symbol> stale_funcs;
+        for (Function_to_cached_pcfg_map::iterator it = _cached_pcfgs.begin(); it != _cached_pcfgs.end(); ++it)
+        {
+            if (!is_up_to_date(it->first, it->second))
+                stale_funcs.insert(it->first);
+        }
+
+        // 2.- The IPA summaries of the callers of a stale function are stale too
+        bool changed = !stale_funcs.empty();
+        while (changed)
+        {
+            changed = false;
+            for (Function_to_cached_pcfg_map::iterator it = _cached_pcfgs.begin(); it != _cached_pcfgs.end(); ++it)
+            {
+                if (stale_funcs.find(it->first) != stale_funcs.end())
+                    continue;
+
+                ObjectList<Symbol> called_funcs = it->second._pcfg->get_function_calls();
+                for (ObjectList<Symbol>::iterator itf = called_funcs.begin(); itf != called_funcs.end(); ++itf)
+                {
+                    if (stale_funcs.find(*itf) != stale_funcs.end())
+                    {
+                        stale_funcs.insert(it->first);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // 3.- Forget the stale PCFGs
+        //     They are not deleted because previous analysis clients may still hold them
+        for (std::set<Symbol>::iterator it = stale_funcs.begin(); it != stale_funcs.end(); ++it)
+        {
+            if (VERBOSE)
+                std::cerr << "PCFG of function '" << it->get_qualified_name() << "' is out of date" << std::endl;
+            _cached_pcfgs.erase(*it);
+        }
+    }
+
+    ExtensibleGraph* PCFGCache::get_pcfg(const NBase& ast)
+    {
+        Symbol func_sym = get_function_symbol(ast);
+        if (!func_sym.is_valid())
+            return NULL;
+
+        Function_to_cached_pcfg_map::iterator it = _cached_pcfgs.find(func_sym);
+        if (it == _cached_pcfgs.end()
+                || it->second._function_code != ast
+                || !is_up_to_date(func_sym, it->second))
+            return NULL;
+
+        return it->second._pcfg;
+    }
+
+    void PCFGCache::set_pcfg(const NBase& ast, ExtensibleGraph* pcfg)
+    {
+        Symbol func_sym = get_function_symbol(ast);
+        if (!func_sym.is_valid())
+            return;
+
+        CachedPCFG& entry = _cached_pcfgs[func_sym];
+        entry = CachedPCFG();
+        entry._function_code = ast;
+        entry._stamp = Nodecl::Utils::get_function_code_modification_stamp(func_sym);
+        entry._fingerprint = get_fingerprint(ast);
+        entry._pcfg = pcfg;
+    }
+
+    bool PCFGCache::is_computed(ExtensibleGraph* pcfg, unsigned int analyses)
+    {
+        CachedPCFG* entry = get_entry(pcfg);
+        return (entry != NULL) && ((entry->_computed & analyses) == analyses);
+    }
+
+    void PCFGCache::set_computed(ExtensibleGraph* pcfg, unsigned int analyses)
+    {
+        CachedPCFG* entry = get_entry(pcfg);
+        if (entry != NULL)
+            entry->_computed |= analyses;
+    }
+
+    bool PCFGCache::is_compatible(ExtensibleGraph* pcfg, bool propagate_graph_nodes)
+    {
+        CachedPCFG* entry = get_entry(pcfg);
+        return (entry == NULL)
+            || !pcfg->usage_is_computed()
+            || (entry->_propagate_graph_nodes == propagate_graph_nodes);
+    }
+
+    void PCFGCache::set_propagate_graph_nodes(ExtensibleGraph* pcfg, bool propagate_graph_nodes)
+    {
+        CachedPCFG* entry = get_entry(pcfg);
+        if (entry != NULL)
+            entry->_propagate_graph_nodes = propagate_graph_nodes;
+    }
+
+    AnalysisCache::AnalysisCache()
+        : _pcfg_caches()
+    {}
+
+    PCFGCache& AnalysisCache::get_pcfg_cache(bool is_ompss_enabled)
+    {
+        return _pcfg_caches[is_ompss_enabled];
+    }
+
+    std::shared_ptr<AnalysisCache> AnalysisCache::get_analysis_cache(TL::DTO& dto)
+    {
+        std::shared_ptr<AnalysisCache> cache;
+        if (!dto.get_keys().contains("analysis_cache"))
+        {
+            cache = std::shared_ptr<AnalysisCache>(new AnalysisCache());
+            dto.set_object("analysis_cache", cache);
+        }
+        else
+        {
+            cache = std::static_pointer_cast<AnalysisCache>(dto["analysis_cache"]);
+        }
+        return cache;
+    }
+
+    // *************************** END cache of PCFGs alive across compiler phases ************************ //
+    // **************************************************************************************************** //
+
+}
+}
@@ -0,0 +1,125 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#ifndef TL_ANALYSIS_CACHE_HPP
+#define TL_ANALYSIS_CACHE_HPP
+
+#include <map>
+
+#include "tl-dto.hpp"
+#include "tl-extensible-graph.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    // **************************************************************************************************** //
+    // ***************************** Cache of PCFGs alive across compiler phases ************************** //
+
+    /*! PCFGs of the functions of a translation unit, all of them built with the same configuration
+     *  Each PCFG is stored together with the modification stamp of its function at the moment it was built
+     *  (see Nodecl::Utils::get_function_code_modification_stamp), a fingerprint of the function tree
+     *  (which also catches modifications not done through Nodecl::Utils) and the set of analyses already computed on it.
+     *  A PCFG becomes stale when its function is modified, and so do the PCFGs of its callers,
+     *  since their Use-Definition information includes the IPA summary of the modified function.
+     */
+    class LIBTL_CLASS PCFGCache
+    {
+    private:
+        struct CachedPCFG
+        {
+            NBase _function_code;
+            unsigned int _stamp;
+            size_t _fingerprint;
+            ExtensibleGraph* _pcfg;
+            unsigned int _computed;         //!< Mask of WhichAnalysis tags computed on #_pcfg
+            bool _propagate_graph_nodes;    //!< Valid only if Use-Definition has been computed
+
+            CachedPCFG()
+                : _function_code(), _stamp(0), _fingerprint(0), _pcfg(NULL), _computed(0), _propagate_graph_nodes(false)
+            {}
+        };
+
+        typedef std::map<Symbol, CachedPCFG> Function_to_cached_pcfg_map;
+        Function_to_cached_pcfg_map _cached_pcfgs;
+
+        CachedPCFG* get_entry(ExtensibleGraph* pcfg);
+
+        static size_t get_fingerprint(const NBase& ast);
+        static bool is_up_to_date(const Symbol& func_sym, const CachedPCFG& entry);
+
+    public:
+        PCFGCache();
+
+        //! Returns the symbol used to cache the PCFG of \p ast, or an invalid symbol if \p ast is not a function
+        static Symbol get_function_symbol(const NBase& ast);
+
+        //! Removes the PCFGs of the functions modified since they were built, and the PCFGs of their callers
+        void invalidate_modified_functions();
+
+        //! Returns the cached PCFG of the function \p ast, or NULL if there is no up to date PCFG for it
+        ExtensibleGraph* get_pcfg(const NBase& ast);
+
+        //! Stores \p pcfg, just built for the function \p ast
+        void set_pcfg(const NBase& ast, ExtensibleGraph* pcfg);
+
+        //! Returns whether all \p analyses (mask of WhichAnalysis tags) have been computed on \p pcfg
+        bool is_computed(ExtensibleGraph* pcfg, unsigned int analyses);
+
+        //! Records that \p analyses (mask of WhichAnalysis tags) have been computed on \p pcfg
+        void set_computed(ExtensibleGraph* pcfg, unsigned int analyses);
+
+        //! Returns false when the data-flow analyses of \p pcfg have been computed
+        //! with a value of \p propagate_graph_nodes different from the one given
+        bool is_compatible(ExtensibleGraph* pcfg, bool propagate_graph_nodes);
+
+        //! Records the value of \p propagate_graph_nodes used to compute the data-flow analyses of \p pcfg
+        void set_propagate_graph_nodes(ExtensibleGraph* pcfg, bool propagate_graph_nodes);
+    };
+
+    /*! Object stored in the DTO to keep the PCFGs alive across the phases of the compilation pipeline
+     *  There is one PCFGCache for each OmpSs mode, since the task synchronizations depend on it
+     */
+    class LIBTL_CLASS AnalysisCache : public TL::Object
+    {
+    private:
+        std::map<bool, PCFGCache> _pcfg_caches;
+
+    public:
+        AnalysisCache();
+
+        PCFGCache& get_pcfg_cache(bool is_ompss_enabled);
+
+        //! Returns the cache registered in \p dto, creating it the first time
+        static std::shared_ptr<AnalysisCache> get_analysis_cache(TL::DTO& dto);
+    };
+
+    // *************************** END cache of PCFGs alive across compiler phases ************************ //
+    // **************************************************************************************************** //
+
+}
+}
+
+#endif      // TL_ANALYSIS_CACHE_HPP
@@ -70,6 +70,10 @@ namespace Analysis {
 
         // Compute "dynamic" analysis
         // Do it in such an order that the first is the most complete analysis and the last is the simplest one
+        if( analysis_mask._which_analysis & WhichAnalysis::RANGE_ANALYSIS )
+        {
+            analysis.range_analysis(n);
+        }
         if( analysis_mask._which_analysis & WhichAnalysis::AUTO_SCOPING )
         {
             analysis.auto_scoping(n);
@@ -0,0 +1,117 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#include <pthread.h>
+
+#include "cxx-thread-safety.h"
+#include "cxx-utils.h"
+
+#include "tl-analysis-parallel.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    // **************************************************************************************************** //
+    // ************************** Concurrent execution of per-function analyses *************************** //
+
+    namespace {
+        struct ParallelForData
+        {
+            ParallelWork* _work;
+            unsigned int _n;
+            unsigned int _next;
+            pthread_mutex_t _lock;
+        };
+
+        void* parallel_for_worker(void* arg)
+        {
+            ParallelForData* data = (ParallelForData*)arg;
+            while (true)
+            {
+                pthread_mutex_lock(&data->_lock);
+                unsigned int i = data->_next++;
+                pthread_mutex_unlock(&data->_lock);
+
+                if (i >= data->_n)
+                    break;
+                data->_work->run(i);
+            }
+            return NULL;
+        }
+    }
+
+    void parallel_for(unsigned int n, ParallelWork& work, unsigned int n_threads)
+    {
+        if (n_threads > n)
+            n_threads = n;
+
+        if (n_threads <= 1)
+        {
+            for (unsigned int i = 0; i < n; ++i)
+                work.run(i);
+            return;
+        }
+
+        ParallelForData data;
+        data._work = &work;
+        data._n = n;
+        data._next = 0;
+        pthread_mutex_init(&data._lock, NULL);
+
+        frontend_set_thread_safe(1);
+
+        // The current thread is also a worker
+        std::vector<pthread_t> threads(n_threads - 1);
+        for (unsigned int t = 0; t < n_threads - 1; ++t)
+        {
+            if (pthread_create(&threads[t], NULL, parallel_for_worker, &data) != 0)
+                internal_error("Cannot create analysis thread %d\n", t);
+        }
+        parallel_for_worker(&data);
+        for (unsigned int t = 0; t < n_threads - 1; ++t)
+            pthread_join(threads[t], NULL);
+
+        frontend_set_thread_safe(0);
+
+        pthread_mutex_destroy(&data._lock);
+    }
+
+    PCFGWork::PCFGWork(const ObjectList<ExtensibleGraph*>& pcfgs,
+                       pcfg_analysis_t analysis,
+                       bool propagate_graph_nodes)
+        : _pcfgs(pcfgs), _analysis(analysis), _propagate_graph_nodes(propagate_graph_nodes)
+    {}
+
+    void PCFGWork::run(unsigned int i)
+    {
+        _analysis(_pcfgs[i], _propagate_graph_nodes);
+    }
+
+    // ************************ END concurrent execution of per-function analyses ************************* //
+    // **************************************************************************************************** //
+
+}
+}
@@ -0,0 +1,81 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#ifndef TL_ANALYSIS_PARALLEL_HPP
+#define TL_ANALYSIS_PARALLEL_HPP
+
+#include "tl-extensible-graph.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    // **************************************************************************************************** //
+    // ************************** Concurrent execution of per-function analyses *************************** //
+
+    //! Work to be done for each element of an iteration space by #parallel_for
+    class LIBTL_CLASS ParallelWork
+    {
+    public:
+        virtual ~ParallelWork() {}
+
+        //! Computes the iteration \p i. Different iterations may be computed concurrently
+        virtual void run(unsigned int i) = 0;
+    };
+
+    /*! Computes the iterations [0, \p n) of \p work using at most \p n_threads threads
+     *  The calling thread is one of the workers and iterations are dispatched one at a time,
+     *  so unbalanced iterations (i.e., functions of very different sizes) are well distributed.
+     *  While more than one thread is running, the frontend caches are protected (see cxx-thread-safety.h).
+     *  With one thread, or one iteration, the work is done sequentially, in order.
+     */
+    void parallel_for(unsigned int n, ParallelWork& work, unsigned int n_threads);
+
+    //! Runs a function-local analysis over each PCFG of a list
+    class LIBTL_CLASS PCFGWork : public ParallelWork
+    {
+    public:
+        typedef void (*pcfg_analysis_t)(ExtensibleGraph* pcfg, bool propagate_graph_nodes);
+
+    private:
+        const ObjectList<ExtensibleGraph*>& _pcfgs;
+        pcfg_analysis_t _analysis;
+        bool _propagate_graph_nodes;
+
+    public:
+        PCFGWork(const ObjectList<ExtensibleGraph*>& pcfgs,
+                 pcfg_analysis_t analysis,
+                 bool propagate_graph_nodes);
+
+        void run(unsigned int i);
+    };
+
+    // ************************ END concurrent execution of per-function analyses ************************* //
+    // **************************************************************************************************** //
+
+}
+}
+
+#endif      // TL_ANALYSIS_PARALLEL_HPP
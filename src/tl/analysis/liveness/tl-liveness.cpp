@@ -45,126 +45,124 @@ namespace Analysis {
         // properly propagate liveness information over the graph
         TaskAnalysis::TaskConcurrency tc(_graph);
         tc.compute_tasks_concurrency();
-        
-        Node* graph = _graph->get_graph();
-        Node* exit = graph->get_graph_exit_node();
-
-        // Compute initial info (liveness only regarding the current node => UE vars)
-        initialize_live_sets(graph);
-        Node* post_sync = _graph->get_post_sync();
-        if (post_sync != NULL)
-            initialize_live_sets(post_sync);
-        // Note: 'n', which is the most outer node of the graph, must be cleaned up separatedly
-        //       because clear_visits_backwards_in_level skips entering the first node it is called with
-        //       in case it is a graph node
-        ExtensibleGraph::clear_visits_backwards_in_level(exit, graph);
-        if (post_sync != NULL)
-            ExtensibleGraph::clear_visits_backwards_in_level(post_sync, graph);
-        graph->set_visited(false);
-
-        // Common Liveness analysis
-        bool changed = true;
-        while(changed)
-        {
-            changed = false;
-            solve_live_equations_rec(graph, changed);
-            if (post_sync != NULL)
-                solve_live_equations_rec(post_sync, changed);
-            ExtensibleGraph::clear_visits_backwards_in_level(exit, graph);
-            if (post_sync != NULL)
-                ExtensibleGraph::clear_visits_backwards_in_level(post_sync, graph);
-            graph->set_visited(false);
-        }
-    }
 
-    void Liveness::initialize_live_sets(Node* n)
-    {
-        if (n->is_visited())
-            return;
+        DataFlowSolver solver(_graph, this);
+        solver.solve();
 
-        n->set_visited(true);
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            fprintf(stderr, "ANALYSIS:     LIVENESS of PCFG '%s': %u nodes, %u evaluations, %u changes\n",
+                    _graph->get_name().c_str(), solver.get_n_nodes(),
+                    solver.get_n_evaluations(), solver.get_n_changes());
+    }
 
-        if (n->is_entry_node())
-            return;
+    DataFlowDirection Liveness::get_direction() const
+    {
+        return __DF_Backward;
+    }
 
+    void Liveness::initialize(Node* n)
+    {
         if (n->is_graph_node())
         {
-            initialize_live_sets(n->get_graph_exit_node());
             if (_propagate_graph_nodes)
                 set_graph_node_liveness(n);
         }
-        else if (!n->is_exit_node())
+        else
         {
             n->set_live_in(n->get_ue_vars());
         }
-
-        const ObjectList<Node*>& parents = n->get_parents();
-        for (ObjectList<Node*>::const_iterator it = parents.begin(); it != parents.end(); ++it)
-            initialize_live_sets(*it);
     }
 
-    void Liveness::solve_live_equations_rec(Node* n, bool& changed)
+    void Liveness::get_inputs(Node* n, ObjectList<Node*>& inputs)
     {
-        if (n->is_visited())
-            return;
-
-        n->set_visited(true);
-
-        if (n->is_entry_node())
-            return;
-
         if (n->is_graph_node())
         {
-            Node* exit = n->get_graph_exit_node();
-            if (n->is_omp_task_node()
-                || n->is_omp_async_target_node())
-                solve_task_live_equations_rec(exit, changed, n);
-            else
-                solve_live_equations_rec(exit, changed);
-            if (_propagate_graph_nodes)
-                set_graph_node_liveness(n);
+            if (!_propagate_graph_nodes)
+                return;
+            inputs.append(n->get_graph_exit_node()->get_parents());
+            inputs.append(n->get_graph_entry_node()->get_children());
+            return;
         }
-        else if (!n->is_exit_node())
+
+        get_successors_with_live_in(n, inputs);
+
+        // The exit of a task also depends on the flow successors of the task creation node
+        Node* task = get_task_of_exit_flush(n);
+        if (task != NULL)
         {
-            // 1.- Gather old liveness sets
-            const NodeclSet& old_live_out = n->get_live_out_vars();
-            const NodeclSet& old_live_in = n->get_live_in_vars();
-
-            // 2.- Compute new liveness sets
-            // 2.1.- Compute Live Out: LO(x) = U LI(y), forall y ∈ Succ(x)
-            const NodeclSet& live_out = compute_successors_live_in(n);
-            // 2.2.-Compute Live In: LI(x) = UE(x) U ( LO(x) - KILL(x) )
-            const NodeclSet& live_in = Utils::nodecl_set_union(n->get_ue_vars(),
-                    Utils::nodecl_set_difference(live_out, n->get_killed_vars()));
-
-            // 3.- Compare the two sets to see whether something has changed and, if yes, set the new values
-            if (!Utils::nodecl_set_equivalence(old_live_in, live_in)
-                    || !Utils::nodecl_set_equivalence(old_live_out, live_out))
+            Node* task_creation = ExtensibleGraph::get_task_creation_from_task(task);
+            const ObjectList<Node*>& tc_children = task_creation->get_children();
+            for (ObjectList<Node*>::const_iterator it = tc_children.begin(); it != tc_children.end(); ++it)
             {
-                n->set_live_in(live_in);
-                n->set_live_out(live_out);
-                changed = true;
+                if (*it != task)
+                    inputs.append(*it);
             }
         }
+    }
 
-        const ObjectList<Node*>& parents = n->get_parents();
-        for (ObjectList<Node*>::const_iterator it = parents.begin(); it != parents.end(); ++it)
-            solve_live_equations_rec(*it, changed);
+    bool Liveness::transfer(Node* n)
+    {
+        Node* task = get_task_of_exit_flush(n);
+        if (task != NULL)
+            return solve_task_live_equations(n, task);
+        return solve_live_equations(n);
     }
 
-    void Liveness::solve_task_live_equations_rec(Node* n, bool& changed, Node* task)
+    bool Liveness::summarize(Node* graph_node)
     {
-        if (!n->is_exit_node())
-            return;
+        if (!_propagate_graph_nodes)
+            return false;
+        return set_graph_node_liveness(graph_node);
+    }
+
+    Node* Liveness::get_task_of_exit_flush(Node* n)
+    {
+        const ObjectList<Node*>& children = n->get_children();
+        for (ObjectList<Node*>::const_iterator it = children.begin(); it != children.end(); ++it)
+        {
+            if (!(*it)->is_exit_node())
+                continue;
+            Node* outer = (*it)->get_outer_node();
+            if (outer->is_omp_task_node()
+                || outer->is_omp_async_target_node())
+            {
+                const ObjectList<Node*>& parents = (*it)->get_parents();
+                ERROR_CONDITION(parents.size()!=1,
+                                "The number of parents of a task exit node must be 1 (a flush node), but %d found.\n",
+                                parents.size());
+                return outer;
+            }
+        }
+        return NULL;
+    }
 
-        n->set_visited(true);
+    bool Liveness::solve_live_equations(Node* n)
+    {
+        // 1.- Gather old liveness sets
+        const NodeclSet& old_live_out = n->get_live_out_vars();
+        const NodeclSet& old_live_in = n->get_live_in_vars();
+
+        // 2.- Compute new liveness sets
+        // 2.1.- Compute Live Out: LO(x) = U LI(y), forall y ∈ Succ(x)
+        const NodeclSet& live_out = compute_successors_live_in(n);
+        // 2.2.-Compute Live In: LI(x) = UE(x) U ( LO(x) - KILL(x) )
+        const NodeclSet& live_in = Utils::nodecl_set_union(n->get_ue_vars(),
+                Utils::nodecl_set_difference(live_out, n->get_killed_vars()));
+
+        // 3.- Compare the two sets to see whether something has changed and, if yes, set the new values
+        if (!Utils::nodecl_set_equivalence(old_live_in, live_in)
+                || !Utils::nodecl_set_equivalence(old_live_out, live_out))
+        {
+            n->set_live_in(live_in);
+            n->set_live_out(live_out);
+            return true;
+        }
+        return false;
+    }
 
+    bool Liveness::solve_task_live_equations(Node* exit_flush, Node* task)
+    {
         // 1.- Compute the task successors LI set
-        const ObjectList<Node*>& parents = n->get_parents();
-        ERROR_CONDITION(parents.size()!=1,
-                        "The number of parents of a task exit node must be 1 (a flush node), but %d found.\n",
-                        parents.size());
-        Node* exit_flush = parents[0];
         NodeclSet succ_live_in = compute_successors_live_in(exit_flush);
         // 1.2.- If the task has a post_sync successor, then all shared variables must be alive at the exit of the task
         if (ExtensibleGraph::task_synchronizes_in_post_sync(task))
@@ -201,14 +199,40 @@ namespace Analysis {
         {
             exit_flush->set_live_out(succ_live_in);
             exit_flush->set_live_in(succ_live_in);
-            changed = true;
+            return true;
         }
+        return false;
+    }
 
-        // 6.- Keep iterating normally within the task
-        exit_flush->set_visited(true);
-        const ObjectList<Node*>& flush_parents = exit_flush->get_parents();
-        for (ObjectList<Node*>::const_iterator it = flush_parents.begin(); it != flush_parents.end(); ++it)
-            solve_live_equations_rec(*it, changed);
+    void Liveness::get_successors_with_live_in(Node* n, ObjectList<Node*>& succ)
+    {
+        const ObjectList<Node*>& children = n->get_children();
+        for (ObjectList<Node*>::const_iterator it = children.begin(); it != children.end(); ++it)
+        {
+            Node* c = *it;
+            if (c->is_exit_node())
+            {
+                // Iterate over outer children while we found an EXIT node
+                Node* exit_outer_node = c->get_outer_node();
+                ObjectList<Node*> outer_children;
+                bool child_is_exit = true;
+                while (child_is_exit)
+                {
+                    outer_children = exit_outer_node->get_children();
+                    child_is_exit = (outer_children.size() == 1) && outer_children[0]->is_exit_node();
+                    exit_outer_node = (child_is_exit ? outer_children[0]->get_outer_node() : NULL);
+                }
+                succ.append(outer_children);
+            }
+            else if (!_propagate_graph_nodes && c->is_graph_node())
+            {
+                succ.append(c->get_graph_entry_node()->get_children());
+            }
+            else
+            {
+                succ.append(c);
+            }
+        }
     }
 
     NodeclSet Liveness::compute_successors_live_in(Node* n)
@@ -288,10 +312,10 @@ namespace Analysis {
         return succ_live_in;
     }
 
-    void Liveness::set_graph_node_liveness(Node* n)
+    bool Liveness::set_graph_node_liveness(Node* n)
     {
         if (!n->is_graph_node())
-            return;
+            return false;
 
         // 1.- LO(graph) = U L0(inner exits)
         NodeclSet live_out;
@@ -301,7 +325,6 @@ namespace Analysis {
             const NodeclSet& lo = (*it)->get_live_out_vars();
             live_out.insert(lo.begin(), lo.end());
         }
-        n->set_live_out(live_out);
 
         // 2.- LI(graph) = U LI(inner entries)
         NodeclSet all_live_in;
@@ -338,7 +361,14 @@ namespace Analysis {
         {
             live_in = all_live_in;
         }
+
+        // 3.- Set the new values, if something has changed
+        if (Utils::nodecl_set_equivalence(n->get_live_in_vars(), live_in)
+                && Utils::nodecl_set_equivalence(n->get_live_out_vars(), live_out))
+            return false;
         n->set_live_in(live_in);
+        n->set_live_out(live_out);
+        return true;
     }
 
     // ***************************** END class implementing liveness analysis ***************************** //
@@ -27,6 +27,7 @@
 #ifndef TL_LIVENESS_HPP
 #define TL_LIVENESS_HPP
 
+#include "tl-dataflow-solver.hpp"
 #include "tl-extensible-graph.hpp"
 
 namespace TL {
@@ -45,29 +46,32 @@ namespace Analysis {
      *                                      where y = all successors of x
      *      - x is a task:                  L0(x) = UE(x) U ( LO(x) - (KILL(x) - Private|Firstprivate(x)) ), 
      */
-    class LIBTL_CLASS Liveness
+    class LIBTL_CLASS Liveness : public DataFlowProblem
     {
     private:
         ExtensibleGraph* _graph;
         bool _propagate_graph_nodes;
 
-        //! Computes the liveness information of each node regarding only its inner statements
-        //! Live In (X) = Upper exposed (X)
-        void initialize_live_sets(Node* current);
+        //! Returns the task whose exit is reached from \p n, if \p n is the flush node at the end of a task
+        //! Returns NULL otherwise
+        Node* get_task_of_exit_flush(Node* n);
 
-        //! Computes liveness equations for a given node and calls recursively to its children
-        void solve_live_equations_rec(Node* current, bool& changed);
-        void solve_task_live_equations_rec(Node* n, bool& changed, Node* task);
+        //! Computes liveness equations for a given node
+        //! LI(x) = UE(x) U ( LO(x) - KILL(x) )
+        bool solve_live_equations(Node* n);
 
-        //! Initiates computation of a task liveness sets
+        //! Computes liveness equations for the flush node at the exit of a task
         //! Excludes from the exit node LiveOut those variables private to the task
-        void solve_specific_live_in_tasks(Node* current);
+        bool solve_task_live_equations(Node* exit_flush, Node* task);
 
         //! U(Live In(Y)), for all Y successors of X
         NodeclSet compute_successors_live_in(Node* n);
 
+        //! Nodes whose Live In is used in #compute_successors_live_in
+        void get_successors_with_live_in(Node* n, ObjectList<Node*>& succ);
+
         //! Propagates liveness information from inner to outer nodes
-        void set_graph_node_liveness(Node* current);
+        bool set_graph_node_liveness(Node* current);
 
     public:
         //! Constructor
@@ -75,6 +79,14 @@ namespace Analysis {
 
         //! Method computing the Liveness information on the member #graph
         void compute_liveness();
+
+        // *** DataFlowProblem interface *** //
+        DataFlowDirection get_direction() const;
+        //! Live In (X) = Upper exposed (X)
+        void initialize(Node* n);
+        void get_inputs(Node* n, ObjectList<Node*>& inputs);
+        bool transfer(Node* n);
+        bool summarize(Node* graph_node);
     };
 
     // ***************************** End class implementing liveness analysis ***************************** //
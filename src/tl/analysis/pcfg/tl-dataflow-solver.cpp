@@ -0,0 +1,260 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#include <algorithm>
+
+#include "tl-dataflow-solver.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    // **************************************************************************************************** //
+    // ********************************* Monotone data-flow framework ************************************* //
+
+    namespace {
+        bool compare_inner_first(const std::pair<unsigned int, Node*>& a,
+                                 const std::pair<unsigned int, Node*>& b)
+        {
+            return a.first > b.first;
+        }
+    }
+
+    DataFlowSolver::DataFlowSolver(ExtensibleGraph* pcfg, DataFlowProblem* problem)
+        : _pcfg(pcfg), _problem(problem), _order(), _position(), _dependents(),
+          _n_evaluations(0), _n_changes(0)
+    {}
+
+    // In the flattened graph:
+    // - an edge reaching a graph node reaches its entry node instead
+    // - the exit node of a graph node flows into the graph node itself,
+    //   which then flows into the children of the graph node
+    void DataFlowSolver::compute_flattened_successors(Node* n, ObjectList<Node*>& succ)
+    {
+        if (n->is_exit_node())
+        {
+            Node* outer = n->get_outer_node();
+            if (outer != NULL)
+                succ.append(outer);
+            return;
+        }
+
+        const ObjectList<Node*>& children = n->get_children();
+        for (ObjectList<Node*>::const_iterator it = children.begin(); it != children.end(); ++it)
+        {
+            if ((*it)->is_graph_node())
+                succ.append((*it)->get_graph_entry_node());
+            else
+                succ.append(*it);
+        }
+    }
+
+    void DataFlowSolver::compute_order()
+    {
+        // Iterative DFS, so deep graphs do not exhaust the stack
+        std::vector<Node*> post_order;
+        std::set<Node*> visited;
+        std::stack<std::pair<Node*, ObjectList<Node*> > > dfs;
+
+        ObjectList<Node*> roots(1, _pcfg->get_graph()->get_graph_entry_node());
+        Node* post_sync = _pcfg->get_post_sync();
+        if (post_sync != NULL)
+            roots.append(post_sync);
+
+        for (ObjectList<Node*>::iterator itr = roots.begin(); itr != roots.end(); ++itr)
+        {
+            if (visited.find(*itr) != visited.end())
+                continue;
+            visited.insert(*itr);
+            ObjectList<Node*> succ;
+            compute_flattened_successors(*itr, succ);
+            dfs.push(std::make_pair(*itr, succ));
+            while (!dfs.empty())
+            {
+                ObjectList<Node*>& pending = dfs.top().second;
+                if (pending.empty())
+                {
+                    post_order.push_back(dfs.top().first);
+                    dfs.pop();
+                    continue;
+                }
+
+                Node* next = pending.back();
+                pending.pop_back();
+                if (visited.find(next) != visited.end())
+                    continue;
+                visited.insert(next);
+                ObjectList<Node*> next_succ;
+                compute_flattened_successors(next, next_succ);
+                // Reverse the successors so they are visited in their original order
+                std::reverse(next_succ.begin(), next_succ.end());
+                dfs.push(std::make_pair(next, next_succ));
+            }
+        }
+
+        // Forward problems are processed in reverse post-order,
+        // backward problems in post-order
+        if (_problem->get_direction() == __DF_Forward)
+            _order.assign(post_order.rbegin(), post_order.rend());
+        else
+            _order.assign(post_order.begin(), post_order.end());
+
+        // Graph nodes do not belong to the flattened flow when their exit is unreachable
+        // (i.e., infinite loops), but their summaries still have to be computed.
+        // They are found walking up from the visited nodes and are processed
+        // from the most inner one to the most outer one
+        std::map<Node*, unsigned int> unreachable_graphs;
+        for (std::set<Node*>::iterator it = visited.begin(); it != visited.end(); ++it)
+        {
+            for (Node* outer = (*it)->get_outer_node(); outer != NULL; outer = outer->get_outer_node())
+            {
+                if (visited.find(outer) != visited.end()
+                        || unreachable_graphs.find(outer) != unreachable_graphs.end())
+                    continue;
+
+                unsigned int depth = 0;
+                for (Node* o = outer->get_outer_node(); o != NULL; o = o->get_outer_node())
+                    ++depth;
+                unreachable_graphs[outer] = depth;
+            }
+        }
+
+        std::vector<std::pair<unsigned int, Node*> > sorted_graphs;
+        for (std::map<Node*, unsigned int>::iterator it = unreachable_graphs.begin();
+             it != unreachable_graphs.end(); ++it)
+            sorted_graphs.push_back(std::make_pair(it->second, it->first));
+        std::stable_sort(sorted_graphs.begin(), sorted_graphs.end(), compare_inner_first);
+        for (std::vector<std::pair<unsigned int, Node*> >::iterator it = sorted_graphs.begin();
+             it != sorted_graphs.end(); ++it)
+            _order.push_back(it->second);
+
+        // The top level graph is unreachable only if it has no visited node
+        Node* graph = _pcfg->get_graph();
+        if (visited.find(graph) == visited.end()
+                && unreachable_graphs.find(graph) == unreachable_graphs.end())
+            _order.push_back(graph);
+
+        for (unsigned int i = 0; i < _order.size(); ++i)
+            _position[_order[i]] = i;
+    }
+
+    void DataFlowSolver::compute_dependents()
+    {
+        _dependents.assign(_order.size(), std::vector<unsigned int>());
+        for (unsigned int i = 0; i < _order.size(); ++i)
+        {
+            Node* n = _order[i];
+            if (n->is_entry_node() || n->is_exit_node())
+                continue;
+
+            ObjectList<Node*> inputs;
+            _problem->get_inputs(n, inputs);
+            for (ObjectList<Node*>::iterator it = inputs.begin(); it != inputs.end(); ++it)
+            {
+                std::map<Node*, unsigned int>::iterator itp = _position.find(*it);
+                if (itp != _position.end() && itp->second != i)
+                    _dependents[itp->second].push_back(i);
+            }
+        }
+
+        for (std::vector<std::vector<unsigned int> >::iterator it = _dependents.begin();
+             it != _dependents.end(); ++it)
+        {
+            std::sort(it->begin(), it->end());
+            it->erase(std::unique(it->begin(), it->end()), it->end());
+        }
+    }
+
+    bool DataFlowSolver::evaluate(Node* n)
+    {
+        ++_n_evaluations;
+        bool changed = (n->is_graph_node() ? _problem->summarize(n)
+                                           : _problem->transfer(n));
+        if (changed)
+            ++_n_changes;
+        return changed;
+    }
+
+    void DataFlowSolver::solve()
+    {
+        _n_evaluations = 0;
+        _n_changes = 0;
+
+        if (_order.empty())
+        {
+            compute_order();
+            compute_dependents();
+        }
+
+        // 1.- Compute the local information of each node
+        for (std::vector<Node*>::iterator it = _order.begin(); it != _order.end(); ++it)
+        {
+            if (!(*it)->is_entry_node() && !(*it)->is_exit_node())
+                _problem->initialize(*it);
+        }
+
+        // 2.- Iterate until no fact changes
+        //     The worklist is kept sorted by position, so the most outer loops
+        //     are not revisited until the inner ones have stabilized
+        std::set<unsigned int> worklist;
+        for (unsigned int i = 0; i < _order.size(); ++i)
+        {
+            if (!_order[i]->is_entry_node() && !_order[i]->is_exit_node())
+                worklist.insert(worklist.end(), i);
+        }
+
+        while (!worklist.empty())
+        {
+            unsigned int current = *worklist.begin();
+            worklist.erase(worklist.begin());
+
+            if (evaluate(_order[current]))
+            {
+                const std::vector<unsigned int>& deps = _dependents[current];
+                worklist.insert(deps.begin(), deps.end());
+            }
+        }
+    }
+
+    unsigned int DataFlowSolver::get_n_nodes() const
+    {
+        return _order.size();
+    }
+
+    unsigned int DataFlowSolver::get_n_evaluations() const
+    {
+        return _n_evaluations;
+    }
+
+    unsigned int DataFlowSolver::get_n_changes() const
+    {
+        return _n_changes;
+    }
+
+    // ******************************* End monotone data-flow framework *********************************** //
+    // **************************************************************************************************** //
+
+}
+}
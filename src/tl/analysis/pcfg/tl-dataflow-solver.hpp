@@ -0,0 +1,128 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#ifndef TL_DATAFLOW_SOLVER_HPP
+#define TL_DATAFLOW_SOLVER_HPP
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "tl-extensible-graph.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    // **************************************************************************************************** //
+    // ********************************* Monotone data-flow framework ************************************* //
+
+    enum DataFlowDirection
+    {
+        __DF_Forward,
+        __DF_Backward
+    };
+
+    /*! Interface of a monotone data-flow problem defined over a PCFG
+     *  The facts of the problem are stored in the nodes of the PCFG (as LinkData attributes),
+     *  so the problem only needs to define:
+     *  - which nodes are read when the facts of a node are recomputed (#get_inputs)
+     *  - the transfer function of a simple node (#transfer)
+     *  - how the facts of a graph node are summarized from its inner nodes (#summarize)
+     *  Entry and Exit nodes never hold facts, so they are neither transferred nor summarized.
+     */
+    class LIBTL_CLASS DataFlowProblem
+    {
+    public:
+        virtual ~DataFlowProblem() {}
+
+        //! Returns the direction of the propagation
+        //! It is only used to decide the order in which nodes are processed
+        virtual DataFlowDirection get_direction() const = 0;
+
+        //! Computes the local information of a node before the iteration starts
+        virtual void initialize(Node* n) = 0;
+
+        //! Appends to \p inputs the nodes whose facts are read when the facts of \p n are computed
+        virtual void get_inputs(Node* n, ObjectList<Node*>& inputs) = 0;
+
+        //! Recomputes the facts of a simple node. Returns true when they have changed
+        virtual bool transfer(Node* n) = 0;
+
+        //! Recomputes the summary of a graph node from its inner nodes. Returns true when it has changed
+        virtual bool summarize(Node* graph_node) = 0;
+    };
+
+    /*! Worklist solver for monotone data-flow problems over the hierarchical PCFG
+     *  The PCFG is flattened so each graph node is placed right after its exit node.
+     *  Nodes are ordered in reverse post-order of the flattened graph (post-order for backward problems)
+     *  and the worklist always processes the first node in that order,
+     *  so each node is visited once per iteration of the most inner loop containing it.
+     *  When the facts of a node change, only the nodes reading them are pushed back to the worklist.
+     */
+    class LIBTL_CLASS DataFlowSolver
+    {
+    private:
+        ExtensibleGraph* _pcfg;
+        DataFlowProblem* _problem;
+
+        //! Nodes of the flattened graph in processing order
+        std::vector<Node*> _order;
+        //! Position of each node in #_order
+        std::map<Node*, unsigned int> _position;
+        //! For each position, positions of the nodes that read the facts of that node
+        std::vector<std::vector<unsigned int> > _dependents;
+
+        unsigned int _n_evaluations;
+        unsigned int _n_changes;
+
+        void compute_flattened_successors(Node* n, ObjectList<Node*>& succ);
+        void compute_order();
+        void compute_dependents();
+
+        bool evaluate(Node* n);
+
+    public:
+        //! Constructor
+        DataFlowSolver(ExtensibleGraph* pcfg, DataFlowProblem* problem);
+
+        //! Iterates the problem until a fixed point is reached
+        void solve();
+
+        //! Number of nodes in the flattened graph
+        unsigned int get_n_nodes() const;
+        //! Number of transfer/summary evaluations performed by the last call to #solve
+        unsigned int get_n_evaluations() const;
+        //! Number of evaluations that modified the facts of a node
+        unsigned int get_n_changes() const;
+    };
+
+    // ******************************* End monotone data-flow framework *********************************** //
+    // **************************************************************************************************** //
+
+}
+}
+
+#endif      // TL_DATAFLOW_SOLVER_HPP
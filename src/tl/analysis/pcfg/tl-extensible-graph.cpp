@@ -38,7 +38,7 @@ namespace Analysis {
           _global_vars(), _function_sym(NULL), _post_sync(NULL), _pointer_to_size_map(), nodes_m(),
           _task_nodes_l(), _func_calls(),
           _concurrent_tasks(), _last_sync_tasks(), _last_sync_sequential(), _next_sync_tasks(), _next_sync_sequential(),
-          _cluster_to_entry_map(), _usage_computed(false)
+          _cluster_to_entry_map(), _usage_computed(false), _usage_summary(NULL)
     {
 
         _graph = create_graph_node(NULL, nodecl, __ExtensibleGraph);
@@ -1603,6 +1603,16 @@ namespace Analysis {
         _usage_computed = true;
     }
 
+    UsageSummary* ExtensibleGraph::get_usage_summary() const
+    {
+        return _usage_summary;
+    }
+
+    void ExtensibleGraph::set_usage_summary(UsageSummary* summary)
+    {
+        _usage_summary = summary;
+    }
+
     // ***** END Getters and setters for analyses built on top of the PCFG ***** //
 
 }
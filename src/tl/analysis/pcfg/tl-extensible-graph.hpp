@@ -43,6 +43,8 @@
 
 namespace TL {
 namespace Analysis {
+
+    class UsageSummary;
     
     typedef std::map<NBase, NBase, Nodecl::Utils::Nodecl_structural_less> SizeMap;
     
@@ -113,6 +115,7 @@ namespace Analysis {
 
         // *** Variables storing info about analyses built on top of the PCFG *** //
         bool _usage_computed;
+        UsageSummary* _usage_summary;
 
     private:
         //! We don't want to allow this kind of constructions
@@ -455,6 +458,9 @@ namespace Analysis {
         // *** Getters and setters for analyses built on top of the PCFG *** //
         bool usage_is_computed() const;
         void set_usage_computed();
+        //! Summary of the usage of the function observable from its callers (NULL until it is built)
+        UsageSummary* get_usage_summary() const;
+        void set_usage_summary(UsageSummary* summary);
 
     friend class PCFGVisitor;
     };
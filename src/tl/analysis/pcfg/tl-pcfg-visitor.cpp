@@ -2152,6 +2152,12 @@ next_it:    ;
 
     }
 
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::CriticalHint& n)
+    {
+        _utils->_pragma_nodes.top()._clauses.append(n);
+        return ObjectList<Node*>();
+    }
+
     ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::CriticalName& n)
     {
         _utils->_pragma_nodes.top()._clauses.append(n);
@@ -2375,6 +2381,24 @@ next_it:    ;
 
     }
 
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::MemoryOrder& n)
+    {
+        // The implicit flushes of the atomic already model its synchronization
+        return ObjectList<Node*>();
+    }
+
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::AtomicKind& n)
+    {
+        // The statement of the atomic already models its accesses
+        return ObjectList<Node*>();
+    }
+
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::NativeFloatingAtomicAdd& n)
+    {
+        // Only relevant for the lowering
+        return ObjectList<Node*>();
+    }
+
     ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::NoMask& n)
     {
         _utils->_pragma_nodes.top()._clauses.append(n);
@@ -2482,6 +2506,12 @@ next_it:    ;
         _utils->_pragma_nodes.top()._clauses.append(n);
         return ObjectList<Node*>();
     }
+
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::ReductionStrategy& n)
+    {
+        // Only relevant for the lowering
+        return ObjectList<Node*>();
+    }
     
     ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::Schedule& n)
     {
@@ -2489,6 +2519,12 @@ next_it:    ;
         return ObjectList<Node*>();
     }
 
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::ScheduleModifier& n)
+    {
+        _utils->_pragma_nodes.top()._clauses.append(n);
+        return ObjectList<Node*>();
+    }
+
     ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::Section& n)
     {
         ObjectList<Node*> section_last_nodes = _utils->_last_nodes;
@@ -2801,6 +2837,12 @@ next_it:    ;
         return ObjectList<Node*>(1, task_creation);
     }
 
+    // Whether the tasks are recorded or replayed, they are the ones created by the statements
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::Taskgraph& n)
+    {
+        return walk(n.get_statements());
+    }
+
     ObjectList<Node*> PCFGVisitor::visit(const Nodecl::OpenMP::Taskwait& n)
     {
         struct DependencesVisitor : Nodecl::ExhaustiveVisitor<void>
@@ -3563,6 +3605,15 @@ next_it:    ;
         return visit_vector_memory_func(n, /*mem_access_type = scatter*/ '4');
     }
 
+    ObjectList<Node*> PCFGVisitor::visit(const Nodecl::VectorShuffle& n)
+    {
+        ObjectList<Node*> all_nodes;
+        _utils->_is_vector = true;
+        all_nodes.insert(walk(n.get_sources()));
+        _utils->_is_vector = false;
+        return ObjectList<Node*>(1, merge_nodes(n, all_nodes));
+    }
+
     ObjectList<Node*> PCFGVisitor::visit(const Nodecl::VectorSincos& n)
     {
         ObjectList<Node*> all_nodes;
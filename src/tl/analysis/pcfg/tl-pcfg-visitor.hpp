@@ -365,6 +365,7 @@ namespace Analysis {
         Ret visit(const Nodecl::OpenMP::Overlap& n);
         Ret visit(const Nodecl::OpenMP::CombinedWithParallel& n);
         Ret visit(const Nodecl::OpenMP::Critical& n);
+        Ret visit(const Nodecl::OpenMP::CriticalHint& n);
         Ret visit(const Nodecl::OpenMP::CriticalName& n);
         Ret visit(const Nodecl::OpenMP::DepIn& n);
         Ret visit(const Nodecl::OpenMP::DepInout& n);
@@ -386,6 +387,9 @@ namespace Analysis {
         Ret visit(const Nodecl::OpenMP::MapToFrom& n);
         Ret visit(const Nodecl::OpenMP::Mask& n);
         Ret visit(const Nodecl::OpenMP::Master& n);
+        Ret visit(const Nodecl::OpenMP::MemoryOrder& n);
+        Ret visit(const Nodecl::OpenMP::AtomicKind& n);
+        Ret visit(const Nodecl::OpenMP::NativeFloatingAtomicAdd& n);
         Ret visit(const Nodecl::OpenMP::NoMask& n);
         Ret visit(const Nodecl::OpenMP::Nontemporal& n);
         Ret visit(const Nodecl::OpenMP::Parallel& n);
@@ -396,7 +400,9 @@ namespace Analysis {
         Ret visit(const Nodecl::OpenMP::PrivateInit& n);
         Ret visit(const Nodecl::OpenMP::Reduction& n);
         Ret visit(const Nodecl::OpenMP::ReductionItem& n);
+        Ret visit(const Nodecl::OpenMP::ReductionStrategy& n);
         Ret visit(const Nodecl::OpenMP::Schedule& n);
+        Ret visit(const Nodecl::OpenMP::ScheduleModifier& n);
         Ret visit(const Nodecl::OpenMP::Section& n);
         Ret visit(const Nodecl::OpenMP::Sections& n);
         Ret visit(const Nodecl::OpenMP::Shared& n);
@@ -409,6 +415,7 @@ namespace Analysis {
         Ret visit(const Nodecl::OpenMP::Target& n);
         Ret visit(const Nodecl::OpenMP::TargetTaskUndeferred& n);
         Ret visit(const Nodecl::OpenMP::Task& n);
+        Ret visit(const Nodecl::OpenMP::Taskgraph& n);
         Ret visit(const Nodecl::OpenMP::Taskwait& n);
         Ret visit(const Nodecl::OpenMP::Uniform& n);
         Ret visit(const Nodecl::OpenMP::Unroll& n);
@@ -494,6 +501,7 @@ namespace Analysis {
         Ret visit(const Nodecl::VectorReductionMul& n);
         Ret visit(const Nodecl::VectorRsqrt& n);
         Ret visit(const Nodecl::VectorScatter& n);
+        Ret visit(const Nodecl::VectorShuffle& n);
         Ret visit(const Nodecl::VectorSincos& n);
         Ret visit(const Nodecl::VectorSqrt& n);
         Ret visit(const Nodecl::VectorStore& n);
@@ -1555,8 +1555,9 @@ namespace {
     Scope ssa_scope;
     std::map<Symbol, NBase> ssa_to_original_var;
 
-    RangeAnalysis::RangeAnalysis(ExtensibleGraph* pcfg)
+    RangeAnalysis::RangeAnalysis(ExtensibleGraph* pcfg, const RangeSolverOptions& options)
         : _pcfg(pcfg), _cg(new ConstraintGraph(pcfg->get_name())), 
+          _options(options), _sparse_solver(NULL),
           _constraints(), _ordered_constraints()
     {
         const NBase& pcfg_ast = pcfg->get_graph()->get_graph_related_ast();
@@ -1573,24 +1574,69 @@ namespace {
         reset_ids();
     }
     
+    RangeAnalysis::~RangeAnalysis()
+    {
+        delete _sparse_solver;
+    }
+
     void RangeAnalysis::compute_range_analysis()
     {   
+        double init;
+        if (RANGES_DEBUG)
+            init = time_nsec();
+
         // 1.- Compute the constraints of the current PCFG
         std::map<Node*, VarToConstraintMap> pcfg_constraints;
         compute_constraints(pcfg_constraints);
 
-        // 2.- Build the Constraint Graph (CG) from the computed constraints
-        build_constraint_graph();
+        double constraints_time;
+        if (RANGES_DEBUG)
+            constraints_time = time_nsec();
+
+        // 2.- Try to solve the constraints with intervals over the SSA constraints, if requested
+        if (_options._solver == __SparseSolver)
+        {
+            _sparse_solver = new SparseRangeSolver(_options);
+            if (_sparse_solver->build(_constraints, _ordered_constraints))
+            {
+                _sparse_solver->solve();
+                if (RANGES_DEBUG)
+                    _sparse_solver->print_statistics();
+            }
+            else
+            {
+                if (RANGES_DEBUG)
+                    std::cerr << "Sparse range solver not applicable to function " << _pcfg->get_name()
+                              << ". Falling back to the Constraint Graph" << std::endl;
+                delete _sparse_solver;
+                _sparse_solver = NULL;
+            }
+        }
+
+        if (_sparse_solver == NULL)
+        {
+            // 3.- Build the Constraint Graph (CG) from the computed constraints
+            build_constraint_graph();
 
-        // 3.- Extract the Strongly Connected Components (SCC) of the graph
-        //     And get the root of each topologically ordered subgraph
-        std::vector<SCC*> roots = _cg->topologically_compose_strongly_connected_components();
+            // 4.- Extract the Strongly Connected Components (SCC) of the graph
+            //     And get the root of each topologically ordered subgraph
+            std::vector<SCC*> roots = _cg->topologically_compose_strongly_connected_components();
 
-        // 4.- Constraints evaluation
-        _cg->solve_constraints(roots);
-        _cg->print_graph();
+            // 5.- Constraints evaluation
+            _cg->solve_constraints(roots);
+            _cg->print_graph();
+        }
+
+        if (RANGES_DEBUG)
+        {
+            double end = time_nsec();
+            std::cerr << "RANGE ANALYSIS of " << _pcfg->get_name() << ": constraints "
+                      << (constraints_time - init) / 1e6 << " ms, solver ("
+                      << (_sparse_solver == NULL ? "constraint graph" : "sparse") << ") "
+                      << (end - constraints_time) / 1e6 << " ms" << std::endl;
+        }
 
-        // 5.- Insert computed ranges in the PCFG
+        // 6.- Insert computed ranges in the PCFG
         set_ranges_to_pcfg(pcfg_constraints);
     }
     
@@ -2267,8 +2313,15 @@ ssa_sym_found:
                     ERROR_CONDITION (ssa_to_var_it == ssa_to_original_var.end(), 
                                      "SSA symbol '%s' is not related to any variable of the original code\n", 
                                      s.get_name().c_str());
-                    CGNode* n = _cg->get_node_from_ssa_var(itt->second.get_symbol().make_nodecl(/*set_ref_type*/false));
-                    it->first->set_range(ssa_to_var_it->second, n->get_valuation());
+                    if (_sparse_solver != NULL)
+                    {
+                        it->first->set_range(ssa_to_var_it->second, _sparse_solver->get_valuation(s));
+                    }
+                    else
+                    {
+                        CGNode* n = _cg->get_node_from_ssa_var(itt->second.get_symbol().make_nodecl(/*set_ref_type*/false));
+                        it->first->set_range(ssa_to_var_it->second, n->get_valuation());
+                    }
                 }
             }
         }
@@ -30,13 +30,13 @@
 #include <queue>
 
 #include "tl-extensible-graph.hpp"
+#include "tl-range-solver.hpp"
 #include "tl-range-utils.hpp"
 #include "tl-ssa.hpp"
 
 namespace TL {
 namespace Analysis {
 
-    typedef std::map<Symbol, NBase> Constraints;
     /* This must be a multimap, so constant values may be repeated */
     typedef std::multimap<NBase, CGNode*, Nodecl::Utils::Nodecl_structural_less> CGValueToCGNode_map;
 
@@ -270,6 +270,9 @@ namespace Analysis {
     private:
         ExtensibleGraph* _pcfg;
         ConstraintGraph* _cg;
+        RangeSolverOptions _options;
+        //! Only built when #_options selects the sparse solver and it supports all the constraints
+        SparseRangeSolver* _sparse_solver;
 
         Constraints _constraints;
         std::vector<Symbol> _ordered_constraints;
@@ -313,7 +316,10 @@ namespace Analysis {
 
     public:
         //! Constructor
-        RangeAnalysis(ExtensibleGraph* pcfg);
+        RangeAnalysis(ExtensibleGraph* pcfg, const RangeSolverOptions& options = RangeSolverOptions());
+
+        //! Destructor
+        ~RangeAnalysis();
 
         //! Method computing the Ranges information on the #pcfg
         void compute_range_analysis();
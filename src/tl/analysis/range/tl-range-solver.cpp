@@ -0,0 +1,696 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <limits.h>
+
+#include "tl-range-solver.hpp"
+
+namespace TL {
+namespace Analysis {
+
+namespace {
+    const_value_t* zero = const_value_get_zero(/*num_bytes*/ 4, /*signed*/ 1);
+    const_value_t* long_max = const_value_get_integer(LONG_MAX, /*num_bytes*/sizeof(long), /*sign*/1);
+    NBase plus_inf = Nodecl::Analysis::PlusInfinity::make(Type::get_long_int_type(), long_max);
+    const_value_t* long_min = const_value_get_integer(LONG_MIN, /*num_bytes*/sizeof(long), /*sign*/1);
+    NBase minus_inf = Nodecl::Analysis::MinusInfinity::make(Type::get_long_int_type(), long_min);
+
+    // ************************************************************************************** //
+    // ************** Saturated arithmetic, where LONG_MIN/LONG_MAX mean -inf/+inf ************** //
+
+    long bound_neg(long a)
+    {
+        if (a == LONG_MIN) return LONG_MAX;
+        if (a == LONG_MAX) return LONG_MIN;
+        return -a;
+    }
+
+    long bound_add(long a, long b)
+    {
+        if (a == LONG_MIN || b == LONG_MIN) return LONG_MIN;
+        if (a == LONG_MAX || b == LONG_MAX) return LONG_MAX;
+        if (b > 0 && a >= LONG_MAX - b) return LONG_MAX;
+        if (b < 0 && a <= LONG_MIN - b) return LONG_MIN;
+        return a + b;
+    }
+
+    long bound_mul(long a, long b)
+    {
+        if (a == 0 || b == 0)
+            return 0;
+        bool negative = ((a < 0) != (b < 0));
+        if (a == LONG_MIN || a == LONG_MAX || b == LONG_MIN || b == LONG_MAX)
+            return (negative ? LONG_MIN : LONG_MAX);
+        unsigned long abs_a = (a < 0 ? -(unsigned long)a : a);
+        unsigned long abs_b = (b < 0 ? -(unsigned long)b : b);
+        if (abs_a >= (unsigned long)LONG_MAX / abs_b)
+            return (negative ? LONG_MIN : LONG_MAX);
+        return a * b;
+    }
+
+    // \p b is never 0
+    long bound_div(long a, long b)
+    {
+        if (b == LONG_MIN || b == LONG_MAX)
+            return 0;
+        if (a == LONG_MIN || a == LONG_MAX)
+            return (((a < 0) != (b < 0)) ? LONG_MIN : LONG_MAX);
+        return a / b;
+    }
+
+    NBase bound_to_nodecl(long b)
+    {
+        if (b == LONG_MIN)
+            return minus_inf.shallow_copy();
+        if (b == LONG_MAX)
+            return plus_inf.shallow_copy();
+        if (b >= INT_MIN && b <= INT_MAX)
+            return const_value_to_nodecl(const_value_get_signed_int(b));
+        return const_value_to_nodecl(const_value_get_integer(b, /*num_bytes*/sizeof(long), /*sign*/1));
+    }
+}
+
+    // ****************************************************************************** //
+    // ***************************** Solver configuration *************************** //
+
+    RangeSolverOptions::RangeSolverOptions()
+        : _solver(__ConstraintGraphSolver), _widening(__WidenToThresholds),
+          _widening_delay(0), _narrowing_iterations(2), _max_iterations(64)
+    {}
+
+    // *************************** END solver configuration ************************* //
+    // ****************************************************************************** //
+
+
+
+    // ****************************************************************************** //
+    // ************************** Sparse interval range solver ********************** //
+
+    SparseRangeSolver::Interval::Interval()
+        : _lb(LONG_MAX), _ub(LONG_MIN), _empty(true)
+    {}
+
+    SparseRangeSolver::Interval::Interval(long lb, long ub)
+        : _lb(lb), _ub(ub), _empty(lb > ub)
+    {}
+
+    bool SparseRangeSolver::Interval::operator==(const Interval& i) const
+    {
+        return (_empty && i._empty)
+            || (!_empty && !i._empty && _lb == i._lb && _ub == i._ub);
+    }
+
+    bool SparseRangeSolver::Interval::operator!=(const Interval& i) const
+    {
+        return !(*this == i);
+    }
+
+    SparseRangeSolver::SparseRangeSolver(const RangeSolverOptions& options)
+        : _options(options), _syms(), _sym_to_node(), _nodes(), _exprs(), _thresholds(),
+          _n_evaluations(0), _n_cycles(0), _n_given_up(0)
+    {}
+
+    // Returns the index of the expression in #_exprs, or -1 if it cannot be represented
+    int SparseRangeSolver::parse_expr(const NBase& n_, std::vector<unsigned int>& inputs)
+    {
+        NBase n = n_.no_conv();
+        Expr e;
+        e._var = 0;
+        e._lhs = e._rhs = -1;
+        if (n.is<Nodecl::Analysis::MinusInfinity>())
+        {
+            e._kind = __ExprConst;
+            e._value = Interval(LONG_MIN, LONG_MIN);
+        }
+        else if (n.is<Nodecl::Analysis::PlusInfinity>())
+        {
+            e._kind = __ExprConst;
+            e._value = Interval(LONG_MAX, LONG_MAX);
+        }
+        else if (n.is_constant())
+        {
+            const_value_t* c = n.get_constant();
+            if (!const_value_is_integer(c))
+                return -1;
+            long v;
+            if (!const_value_is_signed(c)
+                    && const_value_cast_to_unsigned_long_int(c) >= (unsigned long)LONG_MAX)
+                v = LONG_MAX;
+            else
+                v = const_value_cast_to_signed_long_int(c);
+            e._kind = __ExprConst;
+            e._value = Interval(v, v);
+            if (v != LONG_MIN && v != LONG_MAX)
+                _thresholds.push_back(v);
+        }
+        else if (n.is<Nodecl::Symbol>())
+        {
+            std::map<Symbol, unsigned int>::iterator it = _sym_to_node.find(n.get_symbol());
+            if (it == _sym_to_node.end())
+                return -1;
+            e._kind = __ExprVar;
+            e._var = it->second;
+            inputs.push_back(it->second);
+        }
+        else if (n.is<Nodecl::Neg>())
+        {
+            Expr zero_e;
+            zero_e._kind = __ExprConst;
+            zero_e._value = Interval(0, 0);
+            zero_e._var = 0;
+            zero_e._lhs = zero_e._rhs = -1;
+            _exprs.push_back(zero_e);
+            e._kind = __ExprSub;
+            e._lhs = _exprs.size() - 1;
+            e._rhs = parse_expr(n.as<Nodecl::Neg>().get_rhs(), inputs);
+            if (e._rhs < 0)
+                return -1;
+        }
+        else if (n.is<Nodecl::Add>() || n.is<Nodecl::Minus>()
+                    || n.is<Nodecl::Mul>() || n.is<Nodecl::Div>())
+        {
+            e._kind = (n.is<Nodecl::Add>() ? __ExprAdd
+                    : n.is<Nodecl::Minus>() ? __ExprSub
+                    : n.is<Nodecl::Mul>() ? __ExprMul
+                    : __ExprDiv);
+            // All binary operations structurally have the same tree
+            e._lhs = parse_expr(n.as<Nodecl::Add>().get_lhs(), inputs);
+            if (e._lhs < 0)
+                return -1;
+            e._rhs = parse_expr(n.as<Nodecl::Add>().get_rhs(), inputs);
+            if (e._rhs < 0)
+                return -1;
+        }
+        else
+        {
+            return -1;
+        }
+
+        _exprs.push_back(e);
+        return _exprs.size() - 1;
+    }
+
+    bool SparseRangeSolver::parse_range(
+            const NBase& n,
+            int& lb, int& ub,
+            std::vector<unsigned int>& inputs)
+    {
+        if (!n.is<Nodecl::Range>())
+            return false;
+        const Nodecl::Range& r = n.as<Nodecl::Range>();
+        lb = parse_expr(r.get_lower(), inputs);
+        ub = parse_expr(r.get_upper(), inputs);
+        return (lb >= 0 && ub >= 0);
+    }
+
+    bool SparseRangeSolver::parse_constraint(unsigned int i, const NBase& val_)
+    {
+        CNode& node = _nodes[i];
+        NBase val = val_.no_conv();
+        if (val.is<Nodecl::Analysis::Phi>())
+        {
+            node._kind = __NodePhi;
+            const Nodecl::List& exprs = val.as<Nodecl::Analysis::Phi>().get_expressions().as<Nodecl::List>();
+            for (Nodecl::List::const_iterator it = exprs.begin(); it != exprs.end(); ++it)
+            {
+                NBase e = it->no_conv();
+                if (!e.is<Nodecl::Symbol>())
+                    return false;
+                std::map<Symbol, unsigned int>::iterator its = _sym_to_node.find(e.get_symbol());
+                if (its == _sym_to_node.end())
+                    return false;
+                node._phi_args.push_back(its->second);
+                node._inputs.push_back(its->second);
+            }
+        }
+        else if (val.is<Nodecl::Analysis::RangeIntersection>())
+        {
+            node._kind = __NodeIntersection;
+            NBase lhs = val.as<Nodecl::Analysis::RangeIntersection>().get_lhs().no_conv();
+            NBase rhs = val.as<Nodecl::Analysis::RangeIntersection>().get_rhs().no_conv();
+            if (!lhs.is<Nodecl::Symbol>())
+                return false;
+            std::map<Symbol, unsigned int>::iterator its = _sym_to_node.find(lhs.get_symbol());
+            if (its == _sym_to_node.end())
+                return false;
+            node._var = its->second;
+            node._inputs.push_back(its->second);
+
+            // The intersected value is a range or a union of ranges
+            ObjectList<NBase> parts;
+            parts.append(rhs);
+            while (!parts.empty())
+            {
+                NBase p = parts.back().no_conv();
+                parts.pop_back();
+                if (p.is<Nodecl::Analysis::RangeUnion>())
+                {
+                    parts.append(p.as<Nodecl::Analysis::RangeUnion>().get_lhs());
+                    parts.append(p.as<Nodecl::Analysis::RangeUnion>().get_rhs());
+                    continue;
+                }
+                int lb, ub;
+                if (!parse_range(p, lb, ub, node._inputs))
+                    return false;
+                node._parts.push_back(std::make_pair(lb, ub));
+            }
+        }
+        else if (val.is<Nodecl::Range>())
+        {
+            node._kind = __NodeRange;
+            if (!parse_range(val, node._lb, node._ub, node._inputs))
+                return false;
+        }
+        else
+        {
+            node._kind = __NodeExpr;
+            node._expr = parse_expr(val, node._inputs);
+            if (node._expr < 0)
+                return false;
+        }
+
+        std::sort(node._inputs.begin(), node._inputs.end());
+        node._inputs.erase(std::unique(node._inputs.begin(), node._inputs.end()), node._inputs.end());
+        return true;
+    }
+
+    bool SparseRangeSolver::build(const Constraints& constraints, const std::vector<Symbol>& ordered_constraints)
+    {
+        // 1.- Number the SSA symbols
+        for (std::vector<Symbol>::const_iterator it = ordered_constraints.begin();
+             it != ordered_constraints.end(); ++it)
+        {
+            if (_sym_to_node.find(*it) != _sym_to_node.end())
+                continue;
+            _sym_to_node[*it] = _syms.size();
+            _syms.push_back(*it);
+        }
+
+        CNode empty_node;
+        empty_node._kind = __NodeExpr;
+        empty_node._expr = empty_node._lb = empty_node._ub = -1;
+        empty_node._var = 0;
+        empty_node._n_updates = 0;
+        empty_node._solved = false;
+        _nodes.assign(_syms.size(), empty_node);
+
+        // 2.- Translate the constraints
+        for (unsigned int i = 0; i < _syms.size(); ++i)
+        {
+            Constraints::const_iterator it = constraints.find(_syms[i]);
+            ERROR_CONDITION(it == constraints.end(),
+                            "SSA constraint symbol %s not found in the constraints' container.\n",
+                            _syms[i].get_name().c_str());
+            if (!parse_constraint(i, it->second))
+            {
+                if (RANGES_DEBUG)
+                    std::cerr << "    Constraint " << _syms[i].get_name() << " = " << it->second.prettyprint()
+                              << " cannot be solved with intervals" << std::endl;
+                return false;
+            }
+        }
+
+        // 3.- Connect each node with the nodes reading it
+        for (unsigned int i = 0; i < _nodes.size(); ++i)
+        {
+            const std::vector<unsigned int>& inputs = _nodes[i]._inputs;
+            for (std::vector<unsigned int>::const_iterator it = inputs.begin(); it != inputs.end(); ++it)
+                _nodes[*it]._dependents.push_back(i);
+        }
+
+        std::sort(_thresholds.begin(), _thresholds.end());
+        _thresholds.erase(std::unique(_thresholds.begin(), _thresholds.end()), _thresholds.end());
+
+        // 4.- Fast path: constraints with purely constant bounds are solved right away
+        for (unsigned int i = 0; i < _nodes.size(); ++i)
+        {
+            if (_nodes[i]._inputs.empty())
+            {
+                _nodes[i]._value = evaluate(i);
+                _nodes[i]._solved = true;
+            }
+        }
+
+        return true;
+    }
+
+    SparseRangeSolver::Interval SparseRangeSolver::evaluate_expr(int e) const
+    {
+        const Expr& expr = _exprs[e];
+        switch (expr._kind)
+        {
+            case __ExprConst:
+                return expr._value;
+            case __ExprVar:
+                return _nodes[expr._var]._value;
+            default:
+                break;
+        }
+
+        Interval a = evaluate_expr(expr._lhs);
+        Interval b = evaluate_expr(expr._rhs);
+        if (a._empty || b._empty)
+            return Interval();
+
+        switch (expr._kind)
+        {
+            case __ExprAdd:
+                return Interval(bound_add(a._lb, b._lb), bound_add(a._ub, b._ub));
+            case __ExprSub:
+                return Interval(bound_add(a._lb, bound_neg(b._ub)), bound_add(a._ub, bound_neg(b._lb)));
+            case __ExprMul:
+            case __ExprDiv:
+            {
+                if (expr._kind == __ExprDiv && b._lb <= 0 && b._ub >= 0)
+                    return Interval(LONG_MIN, LONG_MAX);     // The divisor may be 0
+                long (*op)(long, long) = (expr._kind == __ExprMul ? bound_mul : bound_div);
+                long c[4] = { op(a._lb, b._lb), op(a._lb, b._ub), op(a._ub, b._lb), op(a._ub, b._ub) };
+                return Interval(*std::min_element(c, c + 4), *std::max_element(c, c + 4));
+            }
+            default:
+                internal_error("Unexpected expression kind %d in sparse range solver.\n", expr._kind);
+        }
+    }
+
+    // Bounds that depend on symbols not yet evaluated do not constrain the value
+    long SparseRangeSolver::evaluate_lower(int e) const
+    {
+        Interval i = evaluate_expr(e);
+        return (i._empty ? LONG_MIN : i._lb);
+    }
+
+    long SparseRangeSolver::evaluate_upper(int e) const
+    {
+        Interval i = evaluate_expr(e);
+        return (i._empty ? LONG_MAX : i._ub);
+    }
+
+    SparseRangeSolver::Interval SparseRangeSolver::evaluate(unsigned int i) const
+    {
+        ++const_cast<SparseRangeSolver*>(this)->_n_evaluations;
+        const CNode& node = _nodes[i];
+        switch (node._kind)
+        {
+            case __NodeExpr:
+                return evaluate_expr(node._expr);
+            case __NodeRange:
+                return Interval(evaluate_lower(node._lb), evaluate_upper(node._ub));
+            case __NodePhi:
+            {
+                Interval result;
+                for (std::vector<unsigned int>::const_iterator it = node._phi_args.begin();
+                     it != node._phi_args.end(); ++it)
+                {
+                    const Interval& v = _nodes[*it]._value;
+                    if (v._empty)
+                        continue;
+                    result = (result._empty ? v : Interval(std::min(result._lb, v._lb),
+                                                           std::max(result._ub, v._ub)));
+                }
+                return result;
+            }
+            case __NodeIntersection:
+            {
+                const Interval& v = _nodes[node._var]._value;
+                Interval result;
+                if (v._empty)
+                    return result;
+                for (std::vector<std::pair<int, int> >::const_iterator it = node._parts.begin();
+                     it != node._parts.end(); ++it)
+                {
+                    Interval r(std::max(v._lb, evaluate_lower(it->first)),
+                               std::min(v._ub, evaluate_upper(it->second)));
+                    if (r._empty)
+                        continue;
+                    result = (result._empty ? r : Interval(std::min(result._lb, r._lb),
+                                                           std::max(result._ub, r._ub)));
+                }
+                return result;
+            }
+            default:
+                internal_error("Unexpected node kind %d in sparse range solver.\n", node._kind);
+        }
+    }
+
+    SparseRangeSolver::Interval SparseRangeSolver::widen(const Interval& old_val, const Interval& new_val) const
+    {
+        if (old_val._empty || new_val._empty)
+            return new_val;
+
+        long lb = old_val._lb;
+        long ub = old_val._ub;
+        if (new_val._lb < old_val._lb)
+        {
+            lb = LONG_MIN;
+            if (_options._widening == __WidenToThresholds)
+            {   // The greatest constant lower or equal than the new bound
+                std::vector<long>::const_iterator it =
+                        std::upper_bound(_thresholds.begin(), _thresholds.end(), new_val._lb);
+                if (it != _thresholds.begin())
+                    lb = *(--it);
+            }
+        }
+        if (new_val._ub > old_val._ub)
+        {
+            ub = LONG_MAX;
+            if (_options._widening == __WidenToThresholds)
+            {   // The smallest constant greater or equal than the new bound
+                std::vector<long>::const_iterator it =
+                        std::lower_bound(_thresholds.begin(), _thresholds.end(), new_val._ub);
+                if (it != _thresholds.end())
+                    ub = *it;
+            }
+        }
+        return Interval(lb, ub);
+    }
+
+    // Narrowing only refines the bounds that widening sent to infinity
+    SparseRangeSolver::Interval SparseRangeSolver::narrow(const Interval& old_val, const Interval& new_val) const
+    {
+        if (old_val._empty || new_val._empty)
+            return new_val;
+        return Interval((old_val._lb == LONG_MIN ? new_val._lb : old_val._lb),
+                        (old_val._ub == LONG_MAX ? new_val._ub : old_val._ub));
+    }
+
+    // Tarjan's algorithm, iterative so large functions do not exhaust the stack
+    // Edges go from each node to its inputs, so the components are produced in topological order
+    void SparseRangeSolver::compute_sccs(std::vector<std::vector<unsigned int> >& sccs) const
+    {
+        const unsigned int n_nodes = _nodes.size();
+        std::vector<int> index(n_nodes, -1);
+        std::vector<int> lowlink(n_nodes, -1);
+        std::vector<bool> on_stack(n_nodes, false);
+        std::vector<unsigned int> stack;
+        std::vector<std::pair<unsigned int, unsigned int> > frames;
+        int next_index = 0;
+
+        for (unsigned int v = 0; v < n_nodes; ++v)
+        {
+            if (index[v] != -1)
+                continue;
+
+            index[v] = lowlink[v] = next_index++;
+            stack.push_back(v);
+            on_stack[v] = true;
+            frames.push_back(std::make_pair(v, 0u));
+            while (!frames.empty())
+            {
+                unsigned int u = frames.back().first;
+                const std::vector<unsigned int>& inputs = _nodes[u]._inputs;
+                if (frames.back().second < inputs.size())
+                {
+                    unsigned int w = inputs[frames.back().second++];
+                    if (index[w] == -1)
+                    {
+                        index[w] = lowlink[w] = next_index++;
+                        stack.push_back(w);
+                        on_stack[w] = true;
+                        frames.push_back(std::make_pair(w, 0u));
+                    }
+                    else if (on_stack[w])
+                    {
+                        lowlink[u] = std::min(lowlink[u], index[w]);
+                    }
+                    continue;
+                }
+
+                if (lowlink[u] == index[u])
+                {   // u is the root of a component
+                    std::vector<unsigned int> scc;
+                    unsigned int w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        on_stack[w] = false;
+                        scc.push_back(w);
+                    } while (w != u);
+                    // Evaluate the nodes of the component in the order of the constraints
+                    std::sort(scc.begin(), scc.end());
+                    sccs.push_back(scc);
+                }
+                frames.pop_back();
+                if (!frames.empty())
+                {
+                    unsigned int p = frames.back().first;
+                    lowlink[p] = std::min(lowlink[p], lowlink[u]);
+                }
+            }
+        }
+    }
+
+    void SparseRangeSolver::solve_cycle(
+            const std::vector<unsigned int>& scc,
+            const std::vector<unsigned int>& scc_id)
+    {
+        ++_n_cycles;
+        const unsigned int current = scc_id[scc[0]];
+        const unsigned int max_evaluations = _options._max_iterations * scc.size();
+
+        // 1.- Ascending iteration, widening the Phi nodes
+        std::vector<unsigned int> worklist(scc.begin(), scc.end());
+        std::vector<bool> in_worklist(_nodes.size(), false);
+        for (std::vector<unsigned int>::const_iterator it = scc.begin(); it != scc.end(); ++it)
+            in_worklist[*it] = true;
+        unsigned int n_evaluations = 0;
+        for (unsigned int head = 0; head < worklist.size(); ++head)
+        {
+            if (++n_evaluations > max_evaluations)
+            {   // The cycle does not stabilize: give up on it
+                ++_n_given_up;
+                if (RANGES_DEBUG)
+                    std::cerr << "    Sparse solver gave up on a cycle of " << scc.size() << " nodes" << std::endl;
+                for (std::vector<unsigned int>::const_iterator it = scc.begin(); it != scc.end(); ++it)
+                    _nodes[*it]._value = Interval(LONG_MIN, LONG_MAX);
+                return;
+            }
+
+            unsigned int n = worklist[head];
+            in_worklist[n] = false;
+            CNode& node = _nodes[n];
+            Interval new_val = evaluate(n);
+            if (node._kind == __NodePhi && ++node._n_updates > _options._widening_delay)
+                new_val = widen(node._value, new_val);
+            if (new_val == node._value)
+                continue;
+
+            if (RANGES_DEBUG)
+                std::cerr << "        WIDEN " << _syms[n].get_name() << " = "
+                          << bound_to_nodecl(new_val._lb).prettyprint() << ":"
+                          << bound_to_nodecl(new_val._ub).prettyprint() << std::endl;
+            node._value = new_val;
+            for (std::vector<unsigned int>::const_iterator it = node._dependents.begin();
+                 it != node._dependents.end(); ++it)
+            {
+                if (scc_id[*it] == current && !in_worklist[*it])
+                {
+                    worklist.push_back(*it);
+                    in_worklist[*it] = true;
+                }
+            }
+        }
+
+        // 2.- Descending iteration
+        for (unsigned int i = 0; i < _options._narrowing_iterations; ++i)
+        {
+            bool changed = false;
+            for (std::vector<unsigned int>::const_iterator it = scc.begin(); it != scc.end(); ++it)
+            {
+                CNode& node = _nodes[*it];
+                Interval new_val = evaluate(*it);
+                if (node._kind == __NodePhi)
+                    new_val = narrow(node._value, new_val);
+                if (new_val != node._value)
+                {
+                    node._value = new_val;
+                    changed = true;
+                }
+            }
+            if (!changed)
+                break;
+        }
+    }
+
+    void SparseRangeSolver::solve()
+    {
+        _n_evaluations = 0;
+        _n_cycles = 0;
+        _n_given_up = 0;
+
+        std::vector<std::vector<unsigned int> > sccs;
+        compute_sccs(sccs);
+
+        std::vector<unsigned int> scc_id(_nodes.size(), 0);
+        for (unsigned int i = 0; i < sccs.size(); ++i)
+        {
+            for (std::vector<unsigned int>::const_iterator it = sccs[i].begin(); it != sccs[i].end(); ++it)
+                scc_id[*it] = i;
+        }
+
+        for (std::vector<std::vector<unsigned int> >::const_iterator it = sccs.begin(); it != sccs.end(); ++it)
+        {
+            unsigned int n = (*it)[0];
+            bool is_cycle = (it->size() > 1)
+                    || std::binary_search(_nodes[n]._inputs.begin(), _nodes[n]._inputs.end(), n);
+            if (is_cycle)
+            {
+                solve_cycle(*it, scc_id);
+            }
+            else if (!_nodes[n]._solved)
+            {
+                _nodes[n]._value = evaluate(n);
+            }
+        }
+    }
+
+    NBase SparseRangeSolver::get_valuation(const Symbol& ssa_sym) const
+    {
+        std::map<Symbol, unsigned int>::const_iterator it = _sym_to_node.find(ssa_sym);
+        ERROR_CONDITION(it == _sym_to_node.end(),
+                        "No SSA variable '%s' found in the sparse range solver",
+                        ssa_sym.get_name().c_str());
+        const Interval& v = _nodes[it->second]._value;
+        if (v._empty)
+            return Nodecl::Analysis::EmptyRange::make();
+
+        NBase lb = bound_to_nodecl(v._lb);
+        NBase ub = bound_to_nodecl(v._ub);
+        return Nodecl::Range::make(lb, ub, const_value_to_nodecl(zero),
+                                   Utils::get_range_type(lb.get_type(), ub.get_type()));
+    }
+
+    void SparseRangeSolver::print_statistics() const
+    {
+        std::cerr << "    Sparse solver: " << _nodes.size() << " nodes, " << _n_cycles << " cycles ("
+                  << _n_given_up << " given up), " << _n_evaluations << " evaluations" << std::endl;
+    }
+
+    // ************************ END sparse interval range solver ******************** //
+    // ****************************************************************************** //
+
+}
+}
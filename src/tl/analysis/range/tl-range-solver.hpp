@@ -0,0 +1,187 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+#ifndef TL_RANGE_SOLVER_HPP
+#define TL_RANGE_SOLVER_HPP
+
+#include <vector>
+
+#include "tl-ssa.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    typedef std::map<Symbol, NBase> Constraints;
+
+    // **************************************************************************************************** //
+    // ************************************ Solver configuration ****************************************** //
+
+    enum RangeSolverKind
+    {
+        __ConstraintGraphSolver,    //!< Symbolic solver over the Constraint Graph (default)
+        __SparseSolver              //!< Interval solver over the SSA constraints (see SparseRangeSolver)
+    };
+
+    enum RangeWideningKind
+    {
+        __WidenToInfinity,          //!< Unstable bounds jump to -inf/+inf
+        __WidenToThresholds         //!< Unstable bounds jump to the next constant appearing in the constraints
+    };
+
+    struct LIBTL_CLASS RangeSolverOptions
+    {
+        RangeSolverKind _solver;
+        RangeWideningKind _widening;
+        //! Number of times a widening point is updated before widening is applied
+        unsigned int _widening_delay;
+        //! Number of decreasing passes over a cycle after its widening has stabilized
+        unsigned int _narrowing_iterations;
+        //! Maximum number of evaluations per node of a cycle. When reached, all the nodes of the cycle
+        //! are set to [-inf, +inf]
+        unsigned int _max_iterations;
+
+        RangeSolverOptions();
+    };
+
+    // ********************************** END solver configuration **************************************** //
+    // **************************************************************************************************** //
+
+
+
+    // **************************************************************************************************** //
+    // ********************************** Sparse interval range solver ************************************ //
+
+    /*! Solver computing integer intervals for the SSA symbols created by the ConstraintBuilder
+     *  Each SSA symbol becomes a node identified by an integer, so the solver works on plain vectors.
+     *  The constraints are solved by strongly connected components, in topological order:
+     *  - nodes not depending on other nodes (purely constant bounds) are evaluated once, when they are built
+     *  - trivial components are evaluated once
+     *  - cycles are iterated with a worklist, widening their Phi nodes, and then narrowed
+     *  Intervals are over-approximated: unions are joined into a unique interval
+     *  and symbolic bounds are replaced by the bounds of the symbols they contain.
+     */
+    class LIBTL_CLASS SparseRangeSolver
+    {
+    private:
+        //! Integer interval where LONG_MIN and LONG_MAX represent -inf and +inf
+        struct Interval
+        {
+            long _lb;
+            long _ub;
+            bool _empty;
+
+            Interval();
+            Interval(long lb, long ub);
+            bool operator==(const Interval& i) const;
+            bool operator!=(const Interval& i) const;
+        };
+
+        enum ExprKind { __ExprConst, __ExprVar, __ExprAdd, __ExprSub, __ExprMul, __ExprDiv };
+
+        //! Arithmetic expression appearing in a constraint
+        struct Expr
+        {
+            ExprKind _kind;
+            Interval _value;        // __ExprConst
+            unsigned int _var;      // __ExprVar
+            int _lhs, _rhs;         // Binary operations
+        };
+
+        enum NodeKind { __NodeExpr, __NodeRange, __NodePhi, __NodeIntersection };
+
+        //! Constraint of one SSA symbol
+        struct CNode
+        {
+            NodeKind _kind;
+            int _expr;                      // __NodeExpr
+            int _lb, _ub;                   // __NodeRange
+            std::vector<unsigned int> _phi_args;    // __NodePhi
+            unsigned int _var;              // __NodeIntersection
+            std::vector<std::pair<int, int> > _parts;   // __NodeIntersection: bounds of each range in the union
+            std::vector<unsigned int> _inputs;
+            std::vector<unsigned int> _dependents;
+            Interval _value;
+            unsigned int _n_updates;
+            bool _solved;
+        };
+
+        RangeSolverOptions _options;
+
+        std::vector<Symbol> _syms;
+        std::map<Symbol, unsigned int> _sym_to_node;
+        std::vector<CNode> _nodes;
+        std::vector<Expr> _exprs;
+        //! Sorted constants appearing in the constraints (thresholds of the widening)
+        std::vector<long> _thresholds;
+
+        unsigned int _n_evaluations;
+        unsigned int _n_cycles;
+        unsigned int _n_given_up;
+
+        // *** Construction *** //
+        int parse_expr(const NBase& n, std::vector<unsigned int>& inputs);
+        bool parse_range(const NBase& n, int& lb, int& ub, std::vector<unsigned int>& inputs);
+        bool parse_constraint(unsigned int i, const NBase& val);
+
+        // *** Evaluation *** //
+        Interval evaluate_expr(int e) const;
+        long evaluate_lower(int e) const;
+        long evaluate_upper(int e) const;
+        Interval evaluate(unsigned int i) const;
+        Interval widen(const Interval& old_val, const Interval& new_val) const;
+        Interval narrow(const Interval& old_val, const Interval& new_val) const;
+
+        // *** Solving *** //
+        void compute_sccs(std::vector<std::vector<unsigned int> >& sccs) const;
+        void solve_cycle(const std::vector<unsigned int>& scc, const std::vector<unsigned int>& scc_id);
+
+    public:
+        //! Constructor
+        SparseRangeSolver(const RangeSolverOptions& options);
+
+        /*! Builds the nodes of the solver from the constraints of a function
+         *  Returns false when some constraint cannot be represented with intervals,
+         *  so the Constraint Graph must be used instead
+         */
+        bool build(const Constraints& constraints, const std::vector<Symbol>& ordered_constraints);
+
+        //! Computes the interval of each SSA symbol
+        void solve();
+
+        //! Returns the range computed for the SSA symbol \p ssa_sym
+        NBase get_valuation(const Symbol& ssa_sym) const;
+
+        //! Prints statistics of the last call to #solve
+        void print_statistics() const;
+    };
+
+    // ******************************** END sparse interval range solver ********************************** //
+    // **************************************************************************************************** //
+
+}
+}
+
+#endif      // TL_RANGE_SOLVER_HPP
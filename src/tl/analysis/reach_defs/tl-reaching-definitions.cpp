@@ -38,18 +38,46 @@ namespace Analysis {
 
     void ReachingDefinitions::compute_reaching_definitions()
     {
-        Node* graph = _graph->get_graph();
-
         // Set a fictitious reaching definition for each parameter 
         generate_unknown_reaching_definitions();
         
-        // Compute initial info (liveness only regarding the current node)
-        gather_reaching_definitions_initial_information(graph);
-        ExtensibleGraph::clear_visits(graph);
+        // Compute initial info (reaching definitions only regarding the current node)
+        // and solve the Reaching Definitions equations
+        DataFlowSolver solver(_graph, this);
+        solver.solve();
+
+        if (ANALYSIS_PERFORMANCE_MEASURE)
+            fprintf(stderr, "ANALYSIS:     REACHING_DEFINITIONS of PCFG '%s': %u nodes, %u evaluations, %u changes\n",
+                    _graph->get_name().c_str(), solver.get_n_nodes(),
+                    solver.get_n_evaluations(), solver.get_n_changes());
+    }
+
+    DataFlowDirection ReachingDefinitions::get_direction() const
+    {
+        return __DF_Forward;
+    }
+
+    void ReachingDefinitions::get_inputs(Node* n, ObjectList<Node*>& inputs)
+    {
+        if (n->is_graph_node())
+        {
+            inputs.append(n->get_graph_entry_node()->get_children());
+            inputs.append(n->get_graph_exit_node()->get_parents());
+        }
+        else
+        {
+            get_predecessors_with_reaching_definitions(n, inputs);
+        }
+    }
+
+    bool ReachingDefinitions::transfer(Node* n)
+    {
+        return solve_reaching_definition_equations(n);
+    }
 
-        // Common Reaching Definitions analysis
-        solve_reaching_definition_equations(graph);
-        ExtensibleGraph::clear_visits(graph);
+    bool ReachingDefinitions::summarize(Node* graph_node)
+    {
+        return set_graph_node_reaching_definitions(graph_node);
     }
 
     // Each parameter generates an unknow definition
@@ -97,168 +125,119 @@ namespace Analysis {
         }
     }
     
-    void ReachingDefinitions::gather_reaching_definitions_initial_information(Node* current)
+    void ReachingDefinitions::initialize(Node* n)
     {
-        if (current->is_visited())
-            return;
-
-        current->set_visited(true);
-
-        if (current->is_exit_node())
-            return;
-
-        if (current->is_graph_node())
+        if (n->is_graph_node())
         {
-            Node* entry = current->get_graph_entry_node();
-            gather_reaching_definitions_initial_information(entry);
-            set_graph_node_reaching_definitions(current);
+            set_graph_node_reaching_definitions(n);
         }
-        else if (!current->is_entry_node())
+        else
         {
             GeneratedStatementsVisitor rdv;
-            NodeclList stmts = current->get_statements();
+            NodeclList stmts = n->get_statements();
             for(NodeclList::iterator it = stmts.begin(); it != stmts.end(); ++it)
             {
                 rdv.walk(*it);
             }
-            current->set_generated_stmts(rdv.get_gen());
-        }
-
-        ObjectList<Node*> exits = current->get_children();
-        for (ObjectList<Node*>::iterator it = exits.begin(); it != exits.end(); ++it)
-        {
-            gather_reaching_definitions_initial_information(*it);
-        }
-    }
-
-    void ReachingDefinitions::solve_reaching_definition_equations(Node* current)
-    {
-        bool changed = true;
-        while (changed)
-        {
-            changed = false;
-            solve_reaching_definition_equations_rec(current, changed);
-            ExtensibleGraph::clear_visits(current);
+            n->set_generated_stmts(rdv.get_gen());
         }
     }
 
-    void ReachingDefinitions::solve_reaching_definition_equations_rec(Node* current, bool& changed)
+    void ReachingDefinitions::get_predecessors_with_reaching_definitions(Node* current, ObjectList<Node*>& preds)
     {
-        if (current->is_visited())
-            return;
-
-        current->set_visited(true);
-
-        if (current->is_exit_node())
-            return;
-
-        if (current->is_graph_node())
-        {
-            solve_reaching_definition_equations_rec(current->get_graph_entry_node(), changed);
-            set_graph_node_reaching_definitions(current);
-        }
-        else if (!current->is_entry_node())
+        const ObjectList<Node*>& parents = current->get_parents();
+        for (ObjectList<Node*>::const_iterator it = parents.begin(); it != parents.end(); ++it)
         {
-            const NodeclMap& old_rd_in = current->get_reaching_definitions_in();
-            const NodeclMap& old_rd_out = current->get_reaching_definitions_out();
-            NodeclMap rd_out, rd_in, pred_rd_out;
-
-            // Computing Reach Defs In
-            // First node with statements may have RDI comming from the parameters
-            if (current == _first_stmt_node)
-                rd_in = current->get_reaching_definitions_in();
-            const ObjectList<Node*>& parents = current->get_parents();
-            for (ObjectList<Node*>::const_iterator it = parents.begin(); it != parents.end(); ++it)
+            if ((*it)->is_entry_node())
             {
-                if ((*it)->is_entry_node())
+                // Iterate over outer parents while we found an ENTRY node
+                // Gather all parents which are not entry nodes
+                std::stack<Node*> entries;
+                entries.push(*it);
+                while (!entries.empty())
                 {
-                    // Iterate over outer parents while we found an ENTRY node
-                    // Gather all parents which are not entry nodes
-                    ObjectList<Node*> non_entry_outer_parents;
-                    std::stack<Node*> entries;
-                    entries.push(*it);
-                    while (!entries.empty())
+                    Node* current_entry = entries.top();
+                    entries.pop();
+                    bool parent_is_entry = current_entry->is_entry_node();
+                    Node* entry_outer_node = current_entry->get_outer_node();
+                    ObjectList<Node*> outer_parents;
+                    while (parent_is_entry)
                     {
-                        Node* current_entry = entries.top();
-                        entries.pop();
-                        bool parent_is_entry = current_entry->is_entry_node();
-                        Node* entry_outer_node = current_entry->get_outer_node();
-                        ObjectList<Node*> outer_parents;
-                        while (parent_is_entry)
+                        outer_parents = entry_outer_node->get_parents();
+                        if (outer_parents.empty())
+                            break;
+                        // Operate with the first parent of the list
+                        parent_is_entry = outer_parents[0]->is_entry_node();
+                        // Push the other parents to the stack, so they will be traversed later
+                        if (outer_parents.size() > 1)
                         {
-                            outer_parents = entry_outer_node->get_parents();
-                            if (outer_parents.empty())
-                                break;
-                            // Operate with the first parent of the list
-                            parent_is_entry = outer_parents[0]->is_entry_node();
-                            // Push the other parents to the stack, so they will be traversed later
-                            if (outer_parents.size() > 1)
-                            {
-                                for (unsigned int i = 1; i < outer_parents.size(); ++i)
-                                    entries.push(outer_parents[i]);
-                            }
-                            entry_outer_node = (parent_is_entry ? outer_parents[0]->get_outer_node() : NULL);
+                            for (unsigned int i = 1; i < outer_parents.size(); ++i)
+                                entries.push(outer_parents[i]);
                         }
-                        if (!outer_parents.empty())
-                            non_entry_outer_parents.append(outer_parents[0]);
-                    }
-                    // Get the Reach Def Out of the current predecessors
-                    for (ObjectList<Node*>::iterator itop = non_entry_outer_parents.begin();
-                         itop != non_entry_outer_parents.end(); ++itop)
-                    {
-                        const NodeclMap& outer_rd_out = (*itop)->get_reaching_definitions_out();
-                        pred_rd_out.insert(outer_rd_out.begin(), outer_rd_out.end());
+                        entry_outer_node = (parent_is_entry ? outer_parents[0]->get_outer_node() : NULL);
                     }
-                }
-                else
-                {
-                    pred_rd_out = (*it)->get_reaching_definitions_out();
-                }
-                rd_in = Utils::nodecl_map_union(rd_in, pred_rd_out);
-            }
-
-            // Computing Reach Defs Out
-            NodeclSet killed;
-            if (current->is_omp_task_creation_node())
-            {   // Variables from non-task children nodes do not count here
-                Node* created_task = ExtensibleGraph::get_task_from_task_creation(current);
-                ERROR_CONDITION(created_task==NULL,
-                                "Task created by task creation node %d not found.\n",
-                                current->get_id());
-                const NodeclSet& task_killed = created_task->get_killed_vars();
-                const NodeclSet& shared_vars = created_task->get_all_shared_accesses();
-                for (NodeclSet::const_iterator it = task_killed.begin(); it != task_killed.end(); ++it)
-                {
-                    if (shared_vars.find(*it) != shared_vars.end())
-                        killed.insert(*it);
+                    if (!outer_parents.empty())
+                        preds.append(outer_parents[0]);
                 }
             }
             else
             {
-                killed = current->get_killed_vars();
+                preds.append(*it);
             }
-            NodeclMap diff = Utils::nodecl_map_minus_nodecl_set(rd_in, killed);
-
-            const NodeclMap& gen = current->get_generated_stmts();
-            rd_out = Utils::nodecl_map_union(gen, diff);
+        }
+    }
 
-            if (!Utils::nodecl_map_equivalence(old_rd_in, rd_in) ||
-                !Utils::nodecl_map_equivalence(old_rd_out, rd_out))
+    bool ReachingDefinitions::solve_reaching_definition_equations(Node* current)
+    {
+        const NodeclMap& old_rd_in = current->get_reaching_definitions_in();
+        const NodeclMap& old_rd_out = current->get_reaching_definitions_out();
+        NodeclMap rd_out, rd_in;
+
+        // Computing Reach Defs In
+        // First node with statements may have RDI comming from the parameters
+        if (current == _first_stmt_node)
+            rd_in = current->get_reaching_definitions_in();
+        ObjectList<Node*> preds;
+        get_predecessors_with_reaching_definitions(current, preds);
+        for (ObjectList<Node*>::iterator it = preds.begin(); it != preds.end(); ++it)
+            rd_in = Utils::nodecl_map_union(rd_in, (*it)->get_reaching_definitions_out());
+
+        // Computing Reach Defs Out
+        NodeclSet killed;
+        if (current->is_omp_task_creation_node())
+        {   // Variables from non-task children nodes do not count here
+            Node* created_task = ExtensibleGraph::get_task_from_task_creation(current);
+            ERROR_CONDITION(created_task==NULL,
+                            "Task created by task creation node %d not found.\n",
+                            current->get_id());
+            const NodeclSet& task_killed = created_task->get_killed_vars();
+            const NodeclSet& shared_vars = created_task->get_all_shared_accesses();
+            for (NodeclSet::const_iterator it = task_killed.begin(); it != task_killed.end(); ++it)
             {
-                current->set_reaching_definitions_in(rd_in);
-                current->set_reaching_definitions_out(rd_out);
-                changed = true;
+                if (shared_vars.find(*it) != shared_vars.end())
+                    killed.insert(*it);
             }
         }
+        else
+        {
+            killed = current->get_killed_vars();
+        }
+        NodeclMap diff = Utils::nodecl_map_minus_nodecl_set(rd_in, killed);
 
-        ObjectList<Node*> children = current->get_children();
-        for (ObjectList<Node*>::iterator it = children.begin(); it != children.end(); ++it)
+        const NodeclMap& gen = current->get_generated_stmts();
+        rd_out = Utils::nodecl_map_union(gen, diff);
+
+        if (!Utils::nodecl_map_equivalence(old_rd_in, rd_in) ||
+            !Utils::nodecl_map_equivalence(old_rd_out, rd_out))
         {
-            solve_reaching_definition_equations_rec(*it, changed);
+            current->set_reaching_definitions_in(rd_in);
+            current->set_reaching_definitions_out(rd_out);
+            return true;
         }
+        return false;
     }
 
-    void ReachingDefinitions::set_graph_node_reaching_definitions(Node* current)
+    bool ReachingDefinitions::set_graph_node_reaching_definitions(Node* current)
     {
         if(current->is_graph_node())
         {
@@ -283,8 +262,7 @@ namespace Analysis {
                     }
                 }
             }
-            
-            current->set_reaching_definitions_in(graph_rdi);
+
 
             // RDO(graph) = U RDO(inner exits)
             NodeclMap graph_rdo;
@@ -300,8 +278,16 @@ namespace Analysis {
                 // In this case, we propagate the Reaching Definition Out from the parents
                 graph_rdo = graph_rdi;
             }
-            current->set_reaching_definitions_out(graph_rdo);
+
+            if (!Utils::nodecl_map_equivalence(current->get_reaching_definitions_in(), graph_rdi) ||
+                !Utils::nodecl_map_equivalence(current->get_reaching_definitions_out(), graph_rdo))
+            {
+                current->set_reaching_definitions_in(graph_rdi);
+                current->set_reaching_definitions_out(graph_rdo);
+                return true;
+            }
         }
+        return false;
     }
 
     // *********************** End class implementing reaching definitions analysis *********************** //
@@ -27,6 +27,7 @@
 #ifndef TL_REACHING_DEFINITIONS_HPP
 #define TL_REACHING_DEFINITIONS_HPP
 
+#include "tl-dataflow-solver.hpp"
 #include "tl-extensible-graph.hpp"
 #include "tl-nodecl-visitor.hpp"
 
@@ -37,7 +38,7 @@ namespace Analysis {
     // ************************** Class implementing reaching definition analysis ************************* //
 
     //! Class implementing Reaching Definitions Analysis
-    class LIBTL_CLASS ReachingDefinitions
+    class LIBTL_CLASS ReachingDefinitions : public DataFlowProblem
     {
     private:
         ExtensibleGraph* _graph;
@@ -45,20 +46,18 @@ namespace Analysis {
 
         void generate_unknown_reaching_definitions( );
         
-        //!Computes the reaching definitions of each node regarding only its inner statements
-        //!Reach Out (X) = Gen (X)
-        void gather_reaching_definitions_initial_information( Node* current );
-
-        //!Computes reaching definition equations for a given node and calls recursively to its children
+        //!Computes reaching definition equations for a given node
         /*!
          * Reach in (X) = Union of all Reach Out (Y), for all Y predecessors of X
          * Reach out (X) = Gen (X) + ( Reach In (X) - Killed (X) )
          */
-        void solve_reaching_definition_equations( Node* current );
-        void solve_reaching_definition_equations_rec( Node* current, bool& changed );
+        bool solve_reaching_definition_equations( Node* current );
+
+        //! Nodes whose Reach Out is used to compute the Reach In of \p current
+        void get_predecessors_with_reaching_definitions( Node* current, ObjectList<Node*>& preds );
 
         //! Propagates reaching definitions information from inner to outer nodes
-        void set_graph_node_reaching_definitions( Node* current );
+        bool set_graph_node_reaching_definitions( Node* current );
 
         NodeclMap combine_generated_statements(Node* current);
 
@@ -68,6 +67,15 @@ namespace Analysis {
 
         //! Method computing the Reaching Definitions on the member #graph
         void compute_reaching_definitions( );
+
+        // *** DataFlowProblem interface *** //
+        DataFlowDirection get_direction() const;
+        //!Computes the reaching definitions of each node regarding only its inner statements
+        //!Reach Out (X) = Gen (X)
+        void initialize(Node* n);
+        void get_inputs(Node* n, ObjectList<Node*>& inputs);
+        bool transfer(Node* n);
+        bool summarize(Node* graph_node);
     };
 
     // *********************** End class implementing reaching definitions analysis *********************** //
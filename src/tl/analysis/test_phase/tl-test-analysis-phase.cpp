@@ -28,6 +28,7 @@
 #include "tl-analysis-base.hpp"
 #include "tl-analysis-utils.hpp"
 #include "tl-pcfg-visitor.hpp"
+#include "tl-use-def.hpp"
 
 namespace TL {
 namespace Analysis {
@@ -71,7 +72,10 @@ namespace {
               _range_analysis_enabled_str(""), _range_analysis_enabled(false),
               _cyclomatic_complexity_enabled_str(""), _cyclomatic_complexity_enabled(false),
               _ompss_mode_str(""), _ompss_mode_enabled(false),
-              _function_str(""), _call_graph_str(""), _call_graph_enabled(true)
+              _function_str(""), _call_graph_str(""), _call_graph_enabled(true),
+              _analysis_threads_str(""), _analysis_threads(1),
+              _write_usage_summaries_str(""), _write_usage_summaries(false),
+              _usage_summaries_files_str("")
     {
         set_phase_name("Experimental phase for testing compiler analysis");
         set_phase_description("This is a temporal phase called with code testing purposes.");
@@ -135,17 +139,38 @@ namespace {
                            "If set to '1' enbles analyzing the call graph of all functions specified in parameter 'functions'",
                            _call_graph_str,
                            "1").connect(std::bind(&TestAnalysisPhase::set_call_graph, this, std::placeholders::_1));
+
+        register_parameter("analysis_threads",
+                           "Maximum number of threads used to analyze different functions concurrently",
+                           _analysis_threads_str,
+                           "1").connect(std::bind(&TestAnalysisPhase::set_analysis_threads, this, std::placeholders::_1));
+
+        register_parameter("write_usage_summaries",
+                           "If set to '1' writes the usage summaries of the functions to '<output file>.usage' after Use-Definition analysis",
+                           _write_usage_summaries_str,
+                           "0").connect(std::bind(&TestAnalysisPhase::set_write_usage_summaries, this, std::placeholders::_1));
+
+        register_parameter("usage_summaries_files",
+                           "Comma-separated list of usage summaries files of other translation units",
+                           _usage_summaries_files_str,
+                           "");
     }
 
     void TestAnalysisPhase::run(TL::DTO& dto)
     {
         AnalysisBase analysis(_ompss_mode_enabled);
+        analysis.set_n_threads(_analysis_threads);
 
         Nodecl::NodeclBase ast = *std::static_pointer_cast<Nodecl::NodeclBase>(dto["nodecl"]);
 
         std::set<std::string> functions;
         tokenizer(_function_str, functions);
 
+        std::set<std::string> usage_summaries_files;
+        tokenizer(_usage_summaries_files_str, usage_summaries_files);
+        for (std::set<std::string>::iterator it = usage_summaries_files.begin(); it != usage_summaries_files.end(); ++it)
+            UseDef::add_usage_summaries_file(*it);
+
         // Test PCFG creation
         if (_pcfg_enabled)
         {
@@ -161,6 +186,8 @@ namespace {
             if (VERBOSE)
                 std::cerr << "==============  Testing Use-Definition analysis  ==============" << std::endl;
             analysis.use_def(ast, /*propagate_graph_nodes*/ true, functions, _call_graph_enabled);
+            if (_write_usage_summaries)
+                analysis.write_usage_summaries(std::string(CURRENT_COMPILED_FILE->output_filename) + ".usage");
             if (VERBOSE)
                 std::cerr << "============  Testing Use-Definition analysis done  ===========" << std::endl;
         }
@@ -335,6 +362,25 @@ namespace {
         if (call_graph_enabled_str == "0")
             _call_graph_enabled = false;
     }
+
+    void TestAnalysisPhase::set_analysis_threads(const std::string& analysis_threads_str)
+    {
+        int n_threads = 0;
+        std::stringstream ss(analysis_threads_str);
+        if (!(ss >> n_threads) || n_threads < 1)
+        {
+            WARNING_MESSAGE("Invalid value '%s' for parameter 'analysis_threads'. Using 1 thread.\n",
+                            analysis_threads_str.c_str());
+            n_threads = 1;
+        }
+        _analysis_threads = n_threads;
+    }
+
+    void TestAnalysisPhase::set_write_usage_summaries(const std::string& write_usage_summaries_str)
+    {
+        if (write_usage_summaries_str == "1")
+            _write_usage_summaries = true;
+    }
 }
 }
 
@@ -86,6 +86,16 @@ namespace Analysis {
         bool _call_graph_enabled;
         void set_call_graph(const std::string& call_graph_str);
 
+        std::string _analysis_threads_str;
+        unsigned int _analysis_threads;
+        void set_analysis_threads(const std::string& analysis_threads_str);
+
+        std::string _write_usage_summaries_str;
+        bool _write_usage_summaries;
+        void set_write_usage_summaries(const std::string& write_usage_summaries_str);
+
+        std::string _usage_summaries_files_str;
+
     public:
         //! Constructor of this phase
         TestAnalysisPhase();
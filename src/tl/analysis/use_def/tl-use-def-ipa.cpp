@@ -39,7 +39,6 @@ namespace Analysis {
         NodeclSet _def_vars;
         NodeclSet _undef_vars;
     };
-    std::set<Symbol> _known_called_funcs_usage;
 
     //! This method computes on the fly the usage information of a graph node
     //! Necessary for IPA analysis
@@ -76,30 +75,44 @@ namespace Analysis {
         graph->set_usage_computed();
     }
 
+    const UsageSummary& UsageSummary::get_usage_summary(ExtensibleGraph* pcfg, bool propagate_graph_nodes)
+    {
+        UsageSummary* summary = pcfg->get_usage_summary();
+        if (summary == NULL)
+        {
+            // When graph nodes are not propagated, the usage of the whole function is computed on demand
+            if (!propagate_graph_nodes)
+                gather_graph_usage(pcfg);
+
+            summary = new UsageSummary(pcfg);
+            pcfg->set_usage_summary(summary);
+        }
+        return *summary;
+    }
+
     // ******************************************************************************************** //
     // ********************* Known function code IP usage propagation methods ********************* //
     
     // This method only accepts #called_func_usage sets of KILLED and UNDEFINED variables (specified by #usage_kind)
     // The UE variables are treated in a different way
     void UsageVisitor::propagate_called_func_pointed_values_usage_to_func_call(
-            const NodeclSet& called_func_usage, 
+            const UsageSummary& called_func_summary,
             const SymToNodeclMap& ptr_param_to_arg_map,
             Utils::UsageKind usage_kind)
     {
-        for (NodeclSet::const_iterator it = called_func_usage.begin();
-            it != called_func_usage.end(); ++it)
+        for (unsigned int i = 0; i < called_func_summary.get_n_references(); ++i)
         {
-            NBase n = it->no_conv();
             // If current variable is not a dereference nor an array,
             // then there is no pointed variable usage to propagate
-            if (!n.is<Nodecl::Dereference>() && !n.is<Nodecl::ArraySubscript>())
+            const ObjectList<Symbol>& pointed_params = called_func_summary.get_pointed_params(i);
+            if (pointed_params.empty() || !called_func_summary.has_usage(i, usage_kind))
                 continue;
+            NBase n = called_func_summary.get_reference(i).no_conv();
 
             // Store all the symbols that are parameters of the function
             std::set<Symbol> params;
-            const ObjectList<Symbol>& all_syms = Nodecl::Utils::get_all_symbols(n);
-            for (ObjectList<Symbol>::const_iterator itt = all_syms.begin();
-                 itt != all_syms.end(); ++itt)
+            for (ObjectList<Symbol>::const_iterator itt = pointed_params.begin();
+                 itt != pointed_params.end(); ++itt)
             {
                 if (ptr_param_to_arg_map.find(*itt) != ptr_param_to_arg_map.end())
                     params.insert(*itt);
@@ -133,19 +146,17 @@ namespace Analysis {
     // This method only accepts #called_func_usage sets of KILLED and UNDEFINED variables (specified by #usage_kind)
     // The UE variables are treated in a different way
     void UsageVisitor::propagate_called_func_params_usage_to_func_call(
-            const NodeclSet& called_func_usage,
+            const UsageSummary& called_func_summary,
             const SymToNodeclMap& param_to_arg_map,
             Utils::UsageKind usage_kind)
     {
-        for (NodeclSet::iterator it = called_func_usage.begin(); it != called_func_usage.end(); ++it)
+        for (unsigned int i = 0; i < called_func_summary.get_n_references(); ++i)
         {
-            NBase n = it->no_conv();
-            NBase n_base = Utils::get_nodecl_base(n);
-            ERROR_CONDITION(n_base.is_null(), 
-                            "The nodecl base of a nodecl appearing in a usage set must not be null, but base of '%s' is.\n", 
-                            n.prettyprint().c_str());
-            Symbol s(n_base.get_symbol());
-            if (!n.is<Nodecl::Dereference>()
+            if (!called_func_summary.has_usage(i, usage_kind))
+                continue;
+            NBase n = called_func_summary.get_reference(i).no_conv();
+            Symbol s(called_func_summary.get_referenced_param(i));
+            if (s.is_valid()
                     && (param_to_arg_map.find(s) != param_to_arg_map.end()))
             {   // The usage is of the variable, and not any possible value pointed by the variable
                 NBase replacement = param_to_arg_map.find(s)->second.shallow_copy();
@@ -168,19 +179,16 @@ namespace Analysis {
     
     // This method accepts #called_func_usage sets of UE, KILLED and UNDEFINED variables (specified by #usage_kind)
     void UsageVisitor::propagate_global_variables_usage(
-            const NodeclSet& called_func_usage, 
-            const NodeclSet& ipa_global_vars,
+            const UsageSummary& called_func_summary,
             const SymToNodeclMap& param_to_arg_map,
             Utils::UsageKind usage_kind)
     {
-        for(NodeclSet::iterator it = called_func_usage.begin(); it != called_func_usage.end(); ++it)
+        for (unsigned int i = 0; i < called_func_summary.get_n_references(); ++i)
         {
-            NBase n = it->no_conv();
-            NBase n_base = Utils::get_nodecl_base(n);
-            ERROR_CONDITION(n_base.is_null(), 
-                            "The nodecl base of a nodecl appearing in a usage set must not be null, but base of '%s' is.\n", 
-                            n.prettyprint().c_str());
-            if(ipa_global_vars.find(n_base) != ipa_global_vars.end())
+            if (!called_func_summary.has_usage(i, usage_kind))
+                continue;
+            NBase n = called_func_summary.get_reference(i).no_conv();
+            if (called_func_summary.is_global(i))
             {
                 // Rename any possible occurrence of a parameter in the current usage by its corresponding argument
                 NodeclReplacer nr(param_to_arg_map);
@@ -202,8 +210,6 @@ namespace Analysis {
             ExtensibleGraph* called_pcfg,
             const Nodecl::List& args)
     {
-        Node* pcfg_node = called_pcfg->get_graph();
-
         // 1.- Check the usage of the parameters
         //     They all will be UE, but additionally we may have KILLED and UNDEF 
         //     if assignments or function calls appear in the arguments
@@ -231,40 +237,29 @@ namespace Analysis {
         const ObjectList<Symbol>& called_params = func_sym.get_function_parameters();
         const SymToNodeclMap& param_to_arg_map = get_parameters_to_arguments_map(called_params, args);
 
-        // 2.2.- Get the usage computed for the called function
-        if (!_propagate_graph_nodes
-                && _known_called_funcs_usage.find(func_sym) == _known_called_funcs_usage.end())
-        {   // The function usage has already been computed, retrieve it
-            // Compute the graph usage
-            gather_graph_usage(called_pcfg);
-
-            // Insert the usage in the cache
-            _known_called_funcs_usage.insert(func_sym);
-        }
-        const NodeclSet& called_ue_vars = pcfg_node->get_ue_vars();
-        const NodeclSet& called_killed_vars = pcfg_node->get_killed_vars();
-        const NodeclSet& called_undef_vars = pcfg_node->get_undefined_behaviour_vars();
+        // 2.2.- Get the usage summary of the called function, built once per function
+        const UsageSummary& called_summary = UsageSummary::get_usage_summary(called_pcfg, _propagate_graph_nodes);
 
         // 2.3.- Propagate pointer parameters usage to the current node
         if (any_parameter_is_pointer(called_params))
         {
             propagate_called_func_pointed_values_usage_to_func_call(
-                    called_ue_vars, param_to_arg_map, Utils::UsageKind::USED);
+                    called_summary, param_to_arg_map, Utils::UsageKind::USED);
             propagate_called_func_pointed_values_usage_to_func_call(
-                    called_killed_vars, param_to_arg_map, Utils::UsageKind::DEFINED);
+                    called_summary, param_to_arg_map, Utils::UsageKind::DEFINED);
             propagate_called_func_pointed_values_usage_to_func_call(
-                    called_undef_vars, param_to_arg_map, Utils::UsageKind::UNDEFINED);
+                    called_summary, param_to_arg_map, Utils::UsageKind::UNDEFINED);
         }
         // 2.4.- Treat parameters by reference
         //       Do not take into account pointed values here, we already did it in step
         if (any_parameter_is_reference(called_params))
         {
             propagate_called_func_params_usage_to_func_call(
-                    called_ue_vars, param_to_arg_map, Utils::UsageKind::USED);
+                    called_summary, param_to_arg_map, Utils::UsageKind::USED);
             propagate_called_func_params_usage_to_func_call(
-                    called_killed_vars, param_to_arg_map, Utils::UsageKind::DEFINED);
+                    called_summary, param_to_arg_map, Utils::UsageKind::DEFINED);
             propagate_called_func_params_usage_to_func_call(
-                    called_undef_vars, param_to_arg_map, Utils::UsageKind::UNDEFINED);
+                    called_summary, param_to_arg_map, Utils::UsageKind::UNDEFINED);
         }
 
         // 3. Usage of the global variables must be propagated too
@@ -272,12 +267,9 @@ namespace Analysis {
         const NodeclSet& ipa_global_vars = called_pcfg->get_global_variables();
         _pcfg->set_global_vars(ipa_global_vars);
         // 3.2 Propagate the usage of the global variables
-        propagate_global_variables_usage(called_ue_vars, ipa_global_vars,
-                                         param_to_arg_map, Utils::UsageKind::USED);
-        propagate_global_variables_usage(called_killed_vars, ipa_global_vars,
-                                         param_to_arg_map, Utils::UsageKind::DEFINED);
-        propagate_global_variables_usage(called_undef_vars, ipa_global_vars,
-                                         param_to_arg_map, Utils::UsageKind::UNDEFINED);
+        propagate_global_variables_usage(called_summary, param_to_arg_map, Utils::UsageKind::USED);
+        propagate_global_variables_usage(called_summary, param_to_arg_map, Utils::UsageKind::DEFINED);
+        propagate_global_variables_usage(called_summary, param_to_arg_map, Utils::UsageKind::UNDEFINED);
     }
     
     // ******************* END Known function code IP usage propagation methods ******************* //
@@ -433,6 +425,43 @@ namespace Analysis {
         return side_effects;
     }
 
+    // The usage attributes of each library function are parsed the first time the function is called
+    std::map<Symbol, UsageSummary> _lib_funcs_usage;
+
+    static const UsageSummary& get_lib_function_usage_summary(Symbol lib_sym, Scope param_sc)
+    {
+        std::map<Symbol, UsageSummary>::iterator it = _lib_funcs_usage.find(lib_sym);
+        if (it != _lib_funcs_usage.end())
+            return it->second;
+
+        UsageSummary& summary = _lib_funcs_usage[lib_sym];
+        const ObjectList<GCCAttribute>& gcc_attrs = lib_sym.get_gcc_attributes();
+        for (ObjectList<GCCAttribute>::const_iterator it = gcc_attrs.begin();
+             it != gcc_attrs.end(); ++it)
+        {
+            std::string attr_name = it->get_attribute_name();
+            Utils::UsageKind usage_kind = Utils::UsageKind::NONE;
+            if (attr_name == "analysis_ue")
+                usage_kind = Utils::UsageKind::USED;
+            else if (attr_name == "analysis_def")
+                usage_kind = Utils::UsageKind::DEFINED;
+            else if (attr_name == "analysis_undef")
+                usage_kind = Utils::UsageKind::UNDEFINED;
+            else
+                continue;       // analysis_void: there is no usage in this function
+
+            const Nodecl::List& exprs = it->get_expression_list();
+            for (Nodecl::List::const_iterator ite = exprs.begin(); ite != exprs.end(); ++ite)
+            {
+                // Parse the expression of the attribute, which is a String and does not contain any symbol
+                Source ss; ss << ite->prettyprint();
+                NBase e = ss.parse_expression(param_sc);
+                summary.add_usage(e, usage_kind);
+            }
+        }
+        return summary;
+    }
+
     bool UsageVisitor::check_c_lib_functions(Symbol func_sym, const Nodecl::List& args)
     {
         bool side_effects = true;
@@ -447,58 +476,37 @@ namespace Analysis {
             ObjectList<Symbol> params = s.get_function_parameters();
             if (params.size() < 1)
                 return false;
-            Scope param_sc = params[0].get_scope();
+            const UsageSummary& lib_summary = get_lib_function_usage_summary(s, params[0].get_scope());
             // Map arguments with parameters
             SymToNodeclMap param_to_arg_map = get_parameters_to_arguments_map(params, args);
-            // Parse the attributes looking for usage information
-            const ObjectList<GCCAttribute>& gcc_attrs = s.get_gcc_attributes();
-            for (ObjectList<GCCAttribute>::const_iterator it = gcc_attrs.begin();
-                 it != gcc_attrs.end(); ++it)
+            // Traverse all the expressions in the usage attributes
+            for (unsigned int i = 0; i < lib_summary.get_n_references(); ++i)
             {
-                std::string attr_name = it->get_attribute_name();
-                if (attr_name == "analysis_void")
-                    continue;       // There is no usage in this function
-                if ((attr_name == "analysis_ue") || (attr_name == "analysis_def"))
+                NBase e = lib_summary.get_reference(i).shallow_copy();
+                // Replace the occurrences of each parameter in the expression with the corresponding argument
+                for (SymToNodeclMap::iterator itm = param_to_arg_map.begin();
+                     itm != param_to_arg_map.end(); ++itm)
                 {
-                    const Nodecl::List& exprs = it->get_expression_list();
-                    // Traverse all the expression in the attribute
-                    for (Nodecl::List::const_iterator ite = exprs.begin(); ite != exprs.end(); ++ite)
-                    {
-                        // Parse the expression of the attribute, which is a String and does not contain any symbol
-                        Source ss; ss << ite->prettyprint();
-                        NBase e = ss.parse_expression(param_sc);
-                        // Replace the occurrences of each parameter in the expression with the corresponding argument
-                        for (SymToNodeclMap::iterator itm = param_to_arg_map.begin();
-                             itm != param_to_arg_map.end(); ++itm)
-                        {
-                            NBase n = itm->first.make_nodecl(/*set_ref_type*/false);
-                            Nodecl::Utils::nodecl_replace_nodecl_by_structure(e, n, itm->second);
-                        }
-                        // Only arguments with some memory can have some usage
-                        const ObjectList<Symbol>& syms = Nodecl::Utils::get_all_symbols(e);
-                        if (syms.empty())
-                            continue;
-                        // Set the usage information to the current node
-                        const ObjectList<NBase>& mem_accesses = Nodecl::Utils::get_all_memory_accesses(e);
-                        if (attr_name == "analysis_ue")
-                        {
-                            for (ObjectList<NBase>::const_iterator itm = mem_accesses.begin();
-                                 itm != mem_accesses.end(); ++itm)
-                            {
-                                _node->add_ue_var(*itm);
-                            }
-                        }
-                        else            // analysis_def
-                        {
-                            for (ObjectList<NBase>::const_iterator itm = mem_accesses.begin();
-                                 itm != mem_accesses.end(); ++itm)
-                            {
-                                _node->add_killed_var(*itm);
-                            }
-                        }
-                        side_effects = false;
-                    }
+                    NBase n = itm->first.make_nodecl(/*set_ref_type*/false);
+                    Nodecl::Utils::nodecl_replace_nodecl_by_structure(e, n, itm->second);
+                }
+                // Only arguments with some memory can have some usage
+                const ObjectList<Symbol>& syms = Nodecl::Utils::get_all_symbols(e);
+                if (syms.empty())
+                    continue;
+                // Set the usage information to the current node
+                const ObjectList<NBase>& mem_accesses = Nodecl::Utils::get_all_memory_accesses(e);
+                for (ObjectList<NBase>::const_iterator itm = mem_accesses.begin();
+                     itm != mem_accesses.end(); ++itm)
+                {
+                    if (lib_summary.has_usage(i, Utils::UsageKind::USED))
+                        _node->add_ue_var(*itm);
+                    if (lib_summary.has_usage(i, Utils::UsageKind::DEFINED))
+                        _node->add_killed_var(*itm);
+                    if (lib_summary.has_usage(i, Utils::UsageKind::UNDEFINED))
+                        _node->add_undefined_behaviour_var(*itm);
                 }
+                side_effects = false;
             }
         }
         else
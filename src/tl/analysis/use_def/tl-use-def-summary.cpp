@@ -0,0 +1,267 @@
+/*--------------------------------------------------------------------
+(C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+Centro Nacional de Supercomputacion
+
+This file is part of Mercurium C/C++ source-to-source compiler.
+
+See AUTHORS file in the top level directory for information
+regarding developers and contributors.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+Mercurium C/C++ source-to-source compiler is distributed in the hope
+that it will be useful, but WITHOUT ANY WARRANTY; without even the
+implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the GNU Lesser General Public License for more
+details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with Mercurium C/C++ source-to-source compiler; if
+not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#include <fstream>
+
+#include "cxx-process.h"
+#include "tl-use-def.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    // **************************************************************************************************** //
+    // ********************************** Function usage summaries for IPA ******************************** //
+
+    UsageSummary::UsageSummary()
+        : _refs(), _ref_index(), _ue(), _killed(), _undef(),
+          _pointed_params(), _referenced_param(), _global()
+    {}
+
+    UsageSummary::UsageSummary(ExtensibleGraph* pcfg)
+        : _refs(), _ref_index(), _ue(), _killed(), _undef(),
+          _pointed_params(), _referenced_param(), _global()
+    {
+        Node* graph = pcfg->get_graph();
+        const NodeclSet& ue_vars = graph->get_ue_vars();
+        for (NodeclSet::const_iterator it = ue_vars.begin(); it != ue_vars.end(); ++it)
+            add_usage(*it, Utils::UsageKind::USED);
+        const NodeclSet& killed_vars = graph->get_killed_vars();
+        for (NodeclSet::const_iterator it = killed_vars.begin(); it != killed_vars.end(); ++it)
+            add_usage(*it, Utils::UsageKind::DEFINED);
+        const NodeclSet& undef_vars = graph->get_undefined_behaviour_vars();
+        for (NodeclSet::const_iterator it = undef_vars.begin(); it != undef_vars.end(); ++it)
+            add_usage(*it, Utils::UsageKind::UNDEFINED);
+
+        ObjectList<Symbol> params;
+        Symbol func_sym = pcfg->get_function_symbol();
+        if (func_sym.is_valid())
+            params = func_sym.get_function_parameters();
+        const NodeclSet& global_vars = pcfg->get_global_variables();
+        for (unsigned int i = 0; i < _refs.size(); ++i)
+            classify_reference(i, params, global_vars);
+    }
+
+    unsigned int UsageSummary::add_reference(const NBase& n)
+    {
+        Reference_index_map::iterator it = _ref_index.find(n);
+        if (it != _ref_index.end())
+            return it->second;
+
+        _ref_index[n] = _refs.size();
+        _refs.append(n);
+        _ue.push_back(false);
+        _killed.push_back(false);
+        _undef.push_back(false);
+        _pointed_params.append(ObjectList<Symbol>());
+        _referenced_param.append(Symbol());
+        _global.push_back(false);
+        return _refs.size() - 1;
+    }
+
+    void UsageSummary::classify_reference(
+            unsigned int i,
+            const ObjectList<Symbol>& params,
+            const NodeclSet& global_vars)
+    {
+        NBase n = _refs[i].no_conv();
+
+        // The value pointed by some parameters
+        if (n.is<Nodecl::Dereference>() || n.is<Nodecl::ArraySubscript>())
+        {
+            const ObjectList<Symbol>& syms = Nodecl::Utils::get_all_symbols(n);
+            for (ObjectList<Symbol>::const_iterator it = syms.begin(); it != syms.end(); ++it)
+            {
+                if (params.contains(*it))
+                    _pointed_params[i].insert(*it);
+            }
+        }
+
+        NBase n_base = Utils::get_nodecl_base(n);
+        if (n_base.is_null())
+            return;
+
+        // The parameter itself (only relevant for reference parameters)
+        Symbol s(n_base.get_symbol());
+        if (!n.is<Nodecl::Dereference>() && params.contains(s))
+            _referenced_param[i] = s;
+
+        // A global variable
+        _global[i] = (global_vars.find(n_base) != global_vars.end());
+    }
+
+    void UsageSummary::add_usage(const NBase& n, Utils::UsageKind usage_kind)
+    {
+        unsigned int i = add_reference(n);
+        if (usage_kind._usage_type & Utils::UsageKind::USED)
+            _ue[i] = true;
+        if (usage_kind._usage_type & Utils::UsageKind::DEFINED)
+            _killed[i] = true;
+        if (usage_kind._usage_type & Utils::UsageKind::UNDEFINED)
+            _undef[i] = true;
+    }
+
+    unsigned int UsageSummary::get_n_references() const
+    {
+        return _refs.size();
+    }
+
+    const NBase& UsageSummary::get_reference(unsigned int i) const
+    {
+        return _refs[i];
+    }
+
+    bool UsageSummary::has_usage(unsigned int i, Utils::UsageKind usage_kind) const
+    {
+        return ((usage_kind._usage_type & Utils::UsageKind::USED) && _ue[i])
+            || ((usage_kind._usage_type & Utils::UsageKind::DEFINED) && _killed[i])
+            || ((usage_kind._usage_type & Utils::UsageKind::UNDEFINED) && _undef[i]);
+    }
+
+    const ObjectList<Symbol>& UsageSummary::get_pointed_params(unsigned int i) const
+    {
+        return _pointed_params[i];
+    }
+
+    Symbol UsageSummary::get_referenced_param(unsigned int i) const
+    {
+        return _referenced_param[i];
+    }
+
+    bool UsageSummary::is_global(unsigned int i) const
+    {
+        return _global[i];
+    }
+
+    bool UsageSummary::uses_global_variables() const
+    {
+        for (Bitset::const_iterator it = _global.begin(); it != _global.end(); ++it)
+        {
+            if (*it)
+                return true;
+        }
+        return false;
+    }
+
+    //! Only builtin types can be declared in other translation units without their definitions
+    static bool type_is_portable(Type t)
+    {
+        t = t.no_ref();
+        while (t.is_pointer() || t.is_array())
+            t = (t.is_pointer() ? t.points_to() : t.array_element());
+        return t.is_void() || (!t.is_named() && t.is_builtin());
+    }
+
+    static std::string join_list(const ObjectList<std::string>& items)
+    {
+        std::string result;
+        for (ObjectList<std::string>::const_iterator it = items.begin(); it != items.end(); ++it)
+            result += (it == items.begin() ? "" : ", ") + *it;
+        return result;
+    }
+
+    void write_usage_summaries(
+            const ObjectList<ExtensibleGraph*>& pcfgs,
+            bool propagate_graph_nodes,
+            const std::string& file_name)
+    {
+        std::ofstream file(file_name.c_str());
+        if (!file.is_open())
+        {
+            WARNING_MESSAGE("File '%s' for the usage summaries cannot be opened\n", file_name.c_str());
+            return;
+        }
+
+        file << "// Usage summaries of the functions defined in '" << CURRENT_COMPILED_FILE->input_filename << "'" << std::endl
+             << "// (see " << (IS_C_LANGUAGE ? "cLibraryFunctionList" : "cppLibraryFunctionList") << " for the syntax)" << std::endl;
+
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            // Only functions visible from other translation units, and with a declaration that can be parsed there
+            Symbol func_sym = (*it)->get_function_symbol();
+            if (!func_sym.is_valid() || !(*it)->usage_is_computed()
+                    || func_sym.is_static() || func_sym.is_member()
+                    || func_sym.get_qualified_name() != func_sym.get_name()
+                    || func_sym.get_type().lacks_prototype()
+                    || !type_is_portable(func_sym.get_type().returns()))
+                continue;
+
+            const ObjectList<Symbol>& params = func_sym.get_function_parameters();
+            bool portable = true;
+            ObjectList<std::string> param_names, param_attrs, ue_exprs, def_exprs, undef_exprs;
+            for (ObjectList<Symbol>::const_iterator itp = params.begin(); itp != params.end(); ++itp)
+            {
+                portable = portable && type_is_portable(itp->get_type());
+                param_names.append(itp->get_name());
+                param_attrs.append("");
+                // Arguments are always evaluated at the call site
+                ue_exprs.append(itp->get_name());
+            }
+            if (!portable)
+                continue;
+
+            const UsageSummary& summary = UsageSummary::get_usage_summary(*it, propagate_graph_nodes);
+            if (summary.uses_global_variables())
+                continue;
+
+            for (unsigned int i = 0; i < summary.get_n_references(); ++i)
+            {
+                // Usage of local variables is not observable by the callers
+                if (summary.get_pointed_params(i).empty() && !summary.get_referenced_param(i).is_valid())
+                    continue;
+
+                std::string ref = summary.get_reference(i).prettyprint();
+                if (summary.has_usage(i, Utils::UsageKind::USED))
+                    ue_exprs.insert(ref);
+                if (summary.has_usage(i, Utils::UsageKind::DEFINED))
+                    def_exprs.insert(ref);
+                if (summary.has_usage(i, Utils::UsageKind::UNDEFINED))
+                    undef_exprs.insert(ref);
+            }
+
+            ObjectList<std::string> attrs;
+            if (ue_exprs.empty() && def_exprs.empty() && undef_exprs.empty())
+                attrs.append("analysis_void()");
+            if (!ue_exprs.empty())
+                attrs.append("analysis_ue(" + join_list(ue_exprs) + ")");
+            if (!def_exprs.empty())
+                attrs.append("analysis_def(" + join_list(def_exprs) + ")");
+            if (!undef_exprs.empty())
+                attrs.append("analysis_undef(" + join_list(undef_exprs) + ")");
+
+            file << "__attribute__((" << join_list(attrs) << "))" << std::endl
+                 << func_sym.get_type().get_declaration_with_parameters(
+                         Scope::get_global_scope(), func_sym.get_name(), param_names, param_attrs)
+                 << ";" << std::endl;
+        }
+
+        file.close();
+    }
+
+    // ******************************** END function usage summaries for IPA ****************************** //
+    // **************************************************************************************************** //
+
+}
+}
@@ -93,6 +93,12 @@ namespace {
     std::map<Symbol, ExtensibleGraph*> _pcfgs;
     SizeMap _pointer_to_size_map;
 
+    // The files with usage attributes are parsed only once per translation unit,
+    // so all UseDef objects of the translation unit share the same scope
+    std::map<const decl_context_t*, Scope> _c_lib_scopes;
+    std::map<const decl_context_t*, unsigned int> _n_loaded_summaries_files;
+    ObjectList<std::string> _usage_summaries_files;
+
     // **************************************************************************************************** //
     // **************************** Class implementing use-definition analysis **************************** //
 
@@ -120,44 +126,78 @@ namespace {
         }
     }
 
+    //! Parses a file with the syntax of the C library functions list, registering its functions in \p sc
+    static bool parse_usage_attributes_file(const std::string& file_name, Scope sc)
+    {
+        std::ifstream file(file_name.c_str());
+        if (!file.is_open())
+            return false;
+
+        std::string line1, line2;
+        while (file.good())
+        {
+            getline(file, line1);
+            // Skip comented lines
+            if (line1.substr(0, 13) == "__attribute__")
+            {
+                getline(file, line2);
+                Source s; s << line1 << line2;
+                // Returned nodecl is null because declarations do not return any tree in C
+                s.parse_statement(sc);
+            }
+        }
+        file.close();
+        return true;
+    }
+
     void UseDef::load_c_lib_functions()
     {
         std::string lib_file_name = IS_C_LANGUAGE ? "cLibraryFunctionList" : "cppLibraryFunctionList";
         _c_lib_file = std::string(MCXX_ANALYSIS_DATA_PATH) + "/" + lib_file_name;
-        std::ifstream file(_c_lib_file.c_str());
-        if (file.is_open())
+
+        const decl_context_t* global_ctx = Scope::get_global_scope().get_decl_context();
+        std::map<const decl_context_t*, Scope>::iterator it = _c_lib_scopes.find(global_ctx);
+        if (it != _c_lib_scopes.end())
+        {
+            _c_lib_sc = it->second;
+        }
+        else
         {
             // Create the scope where the C lib functions will be registered
             Symbol sym(Scope::get_global_scope().new_symbol("__CLIB_USAGE__"));
             sym.get_internal_symbol()->kind = SK_NAMESPACE;
-            const decl_context_t* ctx = new_namespace_context(Scope::get_global_scope().get_decl_context(), sym.get_internal_symbol());
+            const decl_context_t* ctx = new_namespace_context(global_ctx, sym.get_internal_symbol());
             sym.get_internal_symbol()->related_decl_context = ctx;
             _c_lib_sc = Scope(ctx);
+            _c_lib_scopes[global_ctx] = _c_lib_sc;
 
             // Parse the file
-            std::string line1, line2;
-            while (file.good())
+            if (!parse_usage_attributes_file(_c_lib_file, _c_lib_sc))
             {
-                getline(file, line1);
-                // Skip comented lines
-                if (line1.substr(0, 13) == "__attribute__")
-                {
-                    getline(file, line2);
-                    Source s; s << line1 << line2;
-                    std::string source = s.get_source();
-                    // Returned nodecl is null because declarations do not return any tree in C
-                    /*const Nodecl::NodeclBase& func = */s.parse_statement(_c_lib_sc);
-                }
+                WARNING_MESSAGE("File containing C library calls Usage info cannot be opened. \n"\
+                                "Path tried: '%s'", _c_lib_file.c_str());
             }
-            file.close();
         }
-        else
+
+        // Load the summaries files registered since the last UseDef of this translation unit
+        unsigned int& n_loaded = _n_loaded_summaries_files[global_ctx];
+        for (; n_loaded < _usage_summaries_files.size(); ++n_loaded)
         {
-            WARNING_MESSAGE("File containing C library calls Usage info cannot be opened. \n"\
-                            "Path tried: '%s'", _c_lib_file.c_str());
+            const std::string& summaries_file = _usage_summaries_files[n_loaded];
+            if (!parse_usage_attributes_file(summaries_file, _c_lib_sc))
+            {
+                WARNING_MESSAGE("File containing usage summaries cannot be opened. \n"\
+                                "Path tried: '%s'", summaries_file.c_str());
+            }
         }
     }
 
+    void UseDef::add_usage_summaries_file(const std::string& file_name)
+    {
+        if (!_usage_summaries_files.contains(file_name))
+            _usage_summaries_files.append(file_name);
+    }
+
     void UseDef::initialize_ipa_var_usage()
     {
         // Initialized Reference|Pointer parameters usage to NONE
@@ -519,17 +559,21 @@ namespace {
         {   // The called function is not a pointer to function
             const ObjectList<TL::Symbol>& params = func_sym.get_function_parameters();
             if (_pcfgs.find(func_sym) != _pcfgs.end())
-            {   // Due to the way we call the UseDef analysis, if the usage of the called function is not yet computed,
+            {   // Functions are analyzed in call graph SCC order, so if the usage of the called function is not yet computed,
                 // this means that it is a recursive call
                 ExtensibleGraph* called_pcfg = _pcfgs[func_sym];
                 if (called_pcfg->usage_is_computed())
                 {   // Called function code is reachable and UseDef Analysis of the function has been calculated
                     ipa_propagate_known_function_usage(called_pcfg, simplified_arguments);
                 }
-                else
+                else if (func_sym == _pcfg->get_function_symbol())
                 {   // Recursive call
                     ipa_propagate_recursive_call_usage(params, simplified_arguments);
                 }
+                else
+                {   // Mutually recursive call: the usage of the called function is unknown yet
+                    ipa_propagate_pointer_to_function_usage(simplified_arguments);
+                }
             }
             else
             {   // Called function code's is not reachable
@@ -36,6 +36,84 @@
 namespace TL {
 namespace Analysis {
 
+    // **************************************************************************************************** //
+    // ********************************** Function usage summaries for IPA ******************************** //
+
+    /*! Summary of the usage of a function that is observable from its call sites
+     *  The summary is a table of canonical references, expressed in the scope of the function,
+     *  and one bitset per kind of usage (upwards exposed, killed and undefined) over that table.
+     *  - For functions with reachable code, the references are the usage of the whole function
+     *    and the parameters and global variables involved in each reference are classified
+     *    when the summary is built, so each call site only renames the parameters of the references.
+     *    The summary is built once, after the Use-Def of the function, and stored in its PCFG.
+     *  - For C library functions, the references are the expressions of the usage attributes,
+     *    parsed once per function instead of once per call.
+     */
+    class LIBTL_CLASS UsageSummary
+    {
+    public:
+        typedef std::vector<bool> Bitset;
+
+    private:
+        typedef std::map<NBase, unsigned int, Nodecl::Utils::Nodecl_structural_less> Reference_index_map;
+
+        NodeclList _refs;
+        Reference_index_map _ref_index;
+        Bitset _ue;
+        Bitset _killed;
+        Bitset _undef;
+
+        //! For each reference to a pointed value (dereference or array subscript), the parameters it contains
+        ObjectList<ObjectList<Symbol> > _pointed_params;
+        //! For each reference to a parameter itself, the parameter (an invalid symbol otherwise)
+        ObjectList<Symbol> _referenced_param;
+        //! References whose base is a global variable of the function
+        Bitset _global;
+
+        unsigned int add_reference(const NBase& n);
+        void classify_reference(unsigned int i, const ObjectList<Symbol>& params, const NodeclSet& global_vars);
+
+    public:
+        //! Builds an empty summary, to be filled with #add_usage
+        UsageSummary();
+
+        //! Builds the summary of the function of \p pcfg, whose graph node must have the Use-Def computed
+        UsageSummary(ExtensibleGraph* pcfg);
+
+        //! Adds the usage \p usage_kind of the reference \p n
+        void add_usage(const NBase& n, Utils::UsageKind usage_kind);
+
+        unsigned int get_n_references() const;
+        const NBase& get_reference(unsigned int i) const;
+        //! Returns whether the reference \p i has any of the usages in \p usage_kind
+        bool has_usage(unsigned int i, Utils::UsageKind usage_kind) const;
+
+        const ObjectList<Symbol>& get_pointed_params(unsigned int i) const;
+        Symbol get_referenced_param(unsigned int i) const;
+        bool is_global(unsigned int i) const;
+        //! Returns whether any reference involves a global variable
+        bool uses_global_variables() const;
+
+        //! Returns the summary of \p pcfg, building it the first time
+        static const UsageSummary& get_usage_summary(ExtensibleGraph* pcfg, bool propagate_graph_nodes);
+    };
+
+    /*!Writes the summaries of the functions in \p pcfgs that can be called from other translation units
+     * The file has the syntax of the C library functions list, so it can be loaded with
+     * UseDef::add_usage_summaries_file when analyzing other translation units.
+     * Functions using global variables are not written, since their usage cannot be expressed
+     * in the scope of another translation unit: calls to them are treated conservatively.
+     */
+    void write_usage_summaries(
+            const ObjectList<ExtensibleGraph*>& pcfgs,
+            bool propagate_graph_nodes,
+            const std::string& file_name);
+
+    // ******************************** END function usage summaries for IPA ****************************** //
+    // **************************************************************************************************** //
+
+
+
     // **************************************************************************************************** //
     // **************************** Class implementing use-definition analysis **************************** //
     
@@ -88,6 +166,12 @@ namespace Analysis {
 
         //! Method computing the Use-Definition information on the member #graph
         void compute_usage();
+
+        /*! Registers a file with usage summaries (see #write_usage_summaries)
+         *  The functions described in these files are treated as C library functions
+         *  when their code is not reachable in the current translation unit
+         */
+        static void add_usage_summaries_file(const std::string& file_name);
     };
 
     // ************************** End class implementing use-definition analysis ************************** //
@@ -180,18 +264,17 @@ namespace Analysis {
         
         // *** Known called function code use-def analysis *** //
         void propagate_called_func_pointed_values_usage_to_func_call(
-                const NodeclSet& called_func_usage, 
+                const UsageSummary& called_func_summary,
                 const SymToNodeclMap& ptr_param_to_arg_map,
                 Utils::UsageKind usage_kind);
         
         void propagate_called_func_params_usage_to_func_call(
-                const NodeclSet& called_func_usage,
+                const UsageSummary& called_func_summary,
                 const SymToNodeclMap& ref_param_to_arg_map,
                 Utils::UsageKind usage_kind);
         
         void propagate_global_variables_usage(
-                const NodeclSet& called_func_usage,
-                const NodeclSet& called_global_vars,
+                const UsageSummary& called_func_summary,
                 const SymToNodeclMap& param_to_arg_map,
                 Utils::UsageKind usage_kind);
         
@@ -113,6 +113,7 @@ namespace OpenMP {
             
             // Automatically set the scope of the variables involved in the task, if possible
             TL::Analysis::AnalysisBase analysis(IsOmpssEnabled);
+            analysis.set_cache(TL::Analysis::AnalysisCache::get_analysis_cache(dto));
             analysis.auto_scoping(ast);
             
             // Print the results if any and modify the environment for later lowering
@@ -0,0 +1,632 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#include "tl-omp-base.hpp"
+#include "tl-pragmasupport.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-datareference.hpp"
+#include "tl-counters.hpp"
+
+#include "cxx-diagnostic.h"
+#include "cxx-cexpr.h"
+
+namespace TL { namespace OpenMP {
+
+    namespace {
+
+    // Loops are aggregated from the innermost to the outermost
+    struct TaskLoopCandidates : public Nodecl::ExhaustiveVisitor<void>
+    {
+        TL::ObjectList<Nodecl::ForStatement> loops;
+
+        virtual void visit(const Nodecl::ForStatement& n)
+        {
+            walk(n.get_statement());
+            loops.append(n);
+        }
+    };
+
+    // Returns the only statement of 'n' looking through lists, contexts and
+    // compound statements or a null node if there is more than one
+    Nodecl::NodeclBase get_single_statement(Nodecl::NodeclBase n)
+    {
+        while (!n.is_null())
+        {
+            if (n.is<Nodecl::List>())
+            {
+                Nodecl::List l = n.as<Nodecl::List>();
+                if (l.size() != 1)
+                    return Nodecl::NodeclBase::null();
+                n = l.front();
+            }
+            else if (n.is<Nodecl::Context>())
+            {
+                n = n.as<Nodecl::Context>().get_in_context();
+            }
+            else if (n.is<Nodecl::CompoundStatement>())
+            {
+                n = n.as<Nodecl::CompoundStatement>().get_statements();
+            }
+            else
+            {
+                return n;
+            }
+        }
+        return n;
+    }
+
+    bool is_dependence_clause(const std::string& name)
+    {
+        return name == "in" || name == "input"
+            || name == "out" || name == "output"
+            || name == "inout"
+            || name == "weakin" || name == "weakout" || name == "weakinout"
+            || name == "concurrent" || name == "commutative";
+    }
+
+    bool is_data_sharing_clause(const std::string& name)
+    {
+        return name == "shared"
+            || name == "private"
+            || name == "firstprivate"
+            || name == "default";
+    }
+
+    bool contains_symbol(Nodecl::NodeclBase n, TL::Symbol sym)
+    {
+        return Nodecl::Utils::get_all_symbols(n).contains(sym);
+    }
+
+    Nodecl::NodeclBase strip_conversions(Nodecl::NodeclBase n)
+    {
+        while (n.is<Nodecl::Conversion>())
+            n = n.as<Nodecl::Conversion>().get_nest();
+        return n;
+    }
+
+    // States whether 'n' has the form 'i', 'i + c', 'c + i' or 'i - c'
+    // where 'c' does not depend on 'i'. These subscripts grow with 'i'
+    // so a block of iterations [lo, hi] accesses the section [n(lo) : n(hi)]
+    bool is_increasing_affine(Nodecl::NodeclBase n, TL::Symbol induction_var)
+    {
+        n = strip_conversions(n);
+        if (n.is<Nodecl::Symbol>())
+        {
+            return n.get_symbol() == induction_var;
+        }
+        else if (n.is<Nodecl::Add>())
+        {
+            Nodecl::NodeclBase lhs = n.as<Nodecl::Add>().get_lhs();
+            Nodecl::NodeclBase rhs = n.as<Nodecl::Add>().get_rhs();
+            if (contains_symbol(lhs, induction_var))
+                return !contains_symbol(rhs, induction_var) && is_increasing_affine(lhs, induction_var);
+            return is_increasing_affine(rhs, induction_var);
+        }
+        else if (n.is<Nodecl::Minus>())
+        {
+            Nodecl::NodeclBase lhs = n.as<Nodecl::Minus>().get_lhs();
+            Nodecl::NodeclBase rhs = n.as<Nodecl::Minus>().get_rhs();
+            return !contains_symbol(rhs, induction_var) && is_increasing_affine(lhs, induction_var);
+        }
+        return false;
+    }
+
+    struct ReplaceSymbol : public Nodecl::ExhaustiveVisitor<void>
+    {
+        TL::Symbol _orig, _new;
+
+        ReplaceSymbol(TL::Symbol orig, TL::Symbol new_)
+            : _orig(orig), _new(new_) { }
+
+        virtual void visit(const Nodecl::Symbol& n)
+        {
+            if (n.get_symbol() == _orig)
+                n.replace(_new.make_nodecl(/* set_ref_type */ true, n.get_locus()));
+        }
+    };
+
+    std::string replace_symbol_and_print(Nodecl::NodeclBase n, TL::Symbol orig, TL::Symbol new_)
+    {
+        Nodecl::NodeclBase copy = n.shallow_copy();
+        ReplaceSymbol replace(orig, new_);
+        replace.walk(copy);
+        return copy.prettyprint();
+    }
+
+    // Computes in 'result' the dependence of a block of iterations
+    // [block_lower, block_upper] from the dependence 'n' of a single
+    // iteration. When the block symbols are not valid it only checks whether
+    // the dependence can be aggregated
+    bool aggregate_dependence(
+            Nodecl::NodeclBase n,
+            TL::Symbol induction_var,
+            TL::Symbol block_lower,
+            TL::Symbol block_upper,
+            std::string& result)
+    {
+        if (!contains_symbol(n, induction_var))
+        {
+            result = n.prettyprint();
+            return true;
+        }
+
+        n = strip_conversions(n);
+        if (!n.is<Nodecl::ArraySubscript>())
+            return false;
+
+        Nodecl::ArraySubscript array_subscript = n.as<Nodecl::ArraySubscript>();
+
+        // Subscripting through a pointer does not yield a section: widening
+        // 'p[i][k]' to 'p[lo:hi][k]' does not cover the rows pointed by 'p[i]'
+        Nodecl::NodeclBase subscripted = array_subscript.get_subscripted();
+        if (strip_conversions(subscripted).is<Nodecl::ArraySubscript>()
+                && !subscripted.get_type().no_ref().is_array()
+                && contains_symbol(subscripted, induction_var))
+            return false;
+
+        if (!aggregate_dependence(subscripted,
+                    induction_var, block_lower, block_upper, result))
+            return false;
+
+        Nodecl::List subscripts = array_subscript.get_subscripts().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = subscripts.begin(); it != subscripts.end(); it++)
+        {
+            if (!contains_symbol(*it, induction_var))
+            {
+                result += "[" + it->prettyprint() + "]";
+            }
+            else if (!it->is<Nodecl::Range>()
+                    && is_increasing_affine(*it, induction_var))
+            {
+                if (block_lower.is_valid())
+                {
+                    result += "[" + replace_symbol_and_print(*it, induction_var, block_lower)
+                        + " : " + replace_symbol_and_print(*it, induction_var, block_upper) + "]";
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns the variable modified when writing to 'n', if any. Writes
+    // through pointers modify the pointed data, not the pointer
+    TL::Symbol get_written_variable(Nodecl::NodeclBase n)
+    {
+        n = strip_conversions(n);
+        if (n.is<Nodecl::Symbol>())
+        {
+            return n.get_symbol();
+        }
+        else if (n.is<Nodecl::ClassMemberAccess>())
+        {
+            return get_written_variable(n.as<Nodecl::ClassMemberAccess>().get_lhs());
+        }
+        else if (n.is<Nodecl::ArraySubscript>())
+        {
+            Nodecl::NodeclBase subscripted = n.as<Nodecl::ArraySubscript>().get_subscripted();
+            if (subscripted.get_type().no_ref().is_array())
+                return get_written_variable(subscripted);
+        }
+        return TL::Symbol();
+    }
+
+    // Collects the variables written in 'n' and those declared in it. Taking
+    // the address of a variable is considered a write
+    void get_written_variables(Nodecl::NodeclBase n,
+            TL::ObjectList<TL::Symbol>& written,
+            TL::ObjectList<TL::Symbol>& declared)
+    {
+        if (n.is_null())
+            return;
+
+        if (Nodecl::Utils::nodecl_is_assignment_op(n)
+                || n.is<Nodecl::Preincrement>()
+                || n.is<Nodecl::Postincrement>()
+                || n.is<Nodecl::Predecrement>()
+                || n.is<Nodecl::Postdecrement>()
+                || n.is<Nodecl::Reference>())
+        {
+            // The modified operand is the first child of all of them
+            TL::Symbol sym = get_written_variable(n.children()[0]);
+            if (sym.is_valid())
+                written.insert(sym);
+        }
+        else if (n.is<Nodecl::ObjectInit>())
+        {
+            declared.insert(n.get_symbol());
+        }
+
+        Nodecl::NodeclBase::Children children = n.children();
+        for (Nodecl::NodeclBase::Children::iterator it = children.begin();
+                it != children.end();
+                it++)
+        {
+            get_written_variables(*it, written, declared);
+        }
+    }
+
+    const decl_context_t* decl_context_map_id(const decl_context_t* d)
+    {
+        return d;
+    }
+
+    Nodecl::NodeclBase parse_dependence(const std::string& str, Nodecl::NodeclBase context)
+    {
+        Source src;
+        src << str;
+        return src.parse_generic(context,
+                /* ParseFlags */ Source::DEFAULT,
+                "@OMPSS-DEPENDENCY-EXPR@",
+                Source::c_cxx_check_expression_adapter,
+                decl_context_map_id);
+    }
+
+    class TaskAggregation
+    {
+        private:
+            int _block_size;
+            std::string _reason;
+
+        public:
+            TaskAggregation(int block_size)
+                : _block_size(block_size) { }
+
+            // Returns the task of the loop if it is the only statement of its body
+            TL::PragmaCustomStatement get_loop_task(const Nodecl::ForStatement& loop)
+            {
+                Nodecl::NodeclBase stmt = get_single_statement(loop.get_statement());
+                if (stmt.is_null()
+                        || !stmt.is<Nodecl::PragmaCustomStatement>())
+                    return TL::PragmaCustomStatement(Nodecl::PragmaCustomStatement());
+
+                TL::PragmaCustomStatement task = stmt.as<Nodecl::PragmaCustomStatement>();
+                if ((task.get_text() != "oss" && task.get_text() != "omp")
+                        || task.get_pragma_line().get_text() != "task")
+                    return TL::PragmaCustomStatement(Nodecl::PragmaCustomStatement());
+
+                return task;
+            }
+
+            bool can_be_aggregated(const Nodecl::ForStatement& loop, TL::PragmaCustomStatement task)
+            {
+                TL::ForStatement for_stmt(loop);
+                if (!for_stmt.is_omp_valid_loop())
+                {
+                    _reason = "the loop is not in canonical form";
+                    return false;
+                }
+
+                TL::Symbol induction_var = for_stmt.get_induction_variable();
+                Nodecl::NodeclBase step = for_stmt.get_step();
+                if (!step.is_constant()
+                        || !const_value_is_positive(step.get_constant()))
+                {
+                    _reason = "the step of the loop is not a positive constant";
+                    return false;
+                }
+                if (!induction_var.get_type().no_ref().is_integral_type()
+                        || induction_var.get_type().is_dependent())
+                {
+                    _reason = "the induction variable is not an integer";
+                    return false;
+                }
+                if (contains_symbol(for_stmt.get_lower_bound(), induction_var)
+                        || contains_symbol(for_stmt.get_upper_bound(), induction_var))
+                {
+                    _reason = "the bounds of the loop depend on the induction variable";
+                    return false;
+                }
+
+                Nodecl::NodeclBase parameters = task.get_pragma_line().get_parameters();
+                if (!parameters.is_null()
+                        && !parameters.as<Nodecl::List>().empty())
+                {
+                    _reason = "the task has parameters";
+                    return false;
+                }
+
+                TL::ObjectList<std::string> shared_names;
+                bool default_shared = false;
+
+                Nodecl::List clauses = task.get_pragma_line().get_clauses().as<Nodecl::List>();
+                for (Nodecl::List::iterator it = clauses.begin(); it != clauses.end(); it++)
+                {
+                    TL::PragmaCustomSingleClause clause = it->as<Nodecl::PragmaCustomClause>();
+                    std::string clause_name = clause.get_text();
+
+                    if (is_data_sharing_clause(clause_name))
+                    {
+                        // Private variables are not initialized so they can be
+                        // reused by all the iterations of a block
+                        if (clause_name == "shared" || clause_name == "private")
+                            shared_names.insert(clause.get_tokenized_arguments());
+                        else if (clause_name == "default")
+                            default_shared = (clause.get_tokenized_arguments() == TL::ObjectList<std::string>(1, "shared"));
+                        continue;
+                    }
+
+                    if (!is_dependence_clause(clause_name))
+                    {
+                        _reason = "clause '" + clause_name + "' is not supported";
+                        return false;
+                    }
+
+                    TL::ObjectList<std::string> arguments = clause.get_tokenized_arguments();
+                    for (TL::ObjectList<std::string>::iterator it2 = arguments.begin();
+                            it2 != arguments.end();
+                            it2++)
+                    {
+                        Nodecl::NodeclBase dep = parse_dependence(*it2, task);
+                        TL::DataReference data_ref(dep);
+                        std::string unused;
+                        if (!data_ref.is_valid()
+                                || !aggregate_dependence(dep, induction_var,
+                                    TL::Symbol(), TL::Symbol(), unused))
+                        {
+                            _reason = "dependence '" + *it2 + "' cannot be extended to a block of iterations";
+                            return false;
+                        }
+
+                        // Variables of the dependences are implicitly shared
+                        shared_names.insert(data_ref.get_base_symbol().get_name());
+                    }
+                }
+
+                // The iterations of a block share a single copy of each
+                // firstprivate, so the body must not modify them
+                TL::ObjectList<std::string> firstprivate_names;
+                for (Nodecl::List::iterator it = clauses.begin(); it != clauses.end(); it++)
+                {
+                    TL::PragmaCustomSingleClause clause = it->as<Nodecl::PragmaCustomClause>();
+                    if (clause.get_text() == "firstprivate")
+                        firstprivate_names.insert(clause.get_tokenized_arguments());
+                }
+
+                TL::ObjectList<TL::Symbol> written, declared;
+                get_written_variables(task.get_statements(), written, declared);
+                for (TL::ObjectList<TL::Symbol>::iterator it = written.begin(); it != written.end(); it++)
+                {
+                    TL::Symbol sym = *it;
+                    if (sym == induction_var
+                            || declared.contains(sym)
+                            || !sym.is_variable()
+                            || sym.is_member()
+                            || sym.is_static()
+                            || sym.get_scope().is_namespace_scope())
+                        continue;
+
+                    if (!firstprivate_names.contains(sym.get_name())
+                            && (default_shared || shared_names.contains(sym.get_name())))
+                        continue;
+
+                    _reason = "firstprivate '" + sym.get_name() + "' is modified by the task";
+                    return false;
+                }
+
+                return true;
+            }
+
+            void aggregate(const Nodecl::ForStatement& loop, TL::PragmaCustomStatement task);
+
+            const std::string& get_reason() const { return _reason; }
+    };
+
+    void TaskAggregation::aggregate(const Nodecl::ForStatement& loop, TL::PragmaCustomStatement task)
+    {
+        TL::ForStatement for_stmt(loop);
+        TL::Symbol induction_var = for_stmt.get_induction_variable();
+        TL::Type induction_var_type = induction_var.get_type().no_ref().get_unqualified_type();
+        Nodecl::NodeclBase lower = for_stmt.get_lower_bound();
+        Nodecl::NodeclBase upper = for_stmt.get_upper_bound();
+        Nodecl::NodeclBase step = for_stmt.get_step();
+
+        int step_value = const_value_cast_to_signed_int(step.get_constant());
+
+        std::string block_lower_name, block_upper_name;
+        {
+            TL::Counter &counter = TL::CounterManager::get_counter("omp-task-aggregation");
+            std::stringstream ss;
+            ss << induction_var.get_name() << "_block_" << (int)counter;
+            block_lower_name = ss.str() + "_lower";
+            block_upper_name = ss.str() + "_upper";
+            counter++;
+        }
+
+        // The induction variable keeps its final value when it outlives the loop
+        Source final_value;
+        if (!for_stmt.induction_variable_in_separate_scope())
+        {
+            final_value
+                << "if (" << as_expression(lower.shallow_copy()) << " <= " << as_expression(upper.shallow_copy()) << ")"
+                <<    as_symbol(induction_var) << " = " << as_expression(lower.shallow_copy())
+                <<        " + ((" << as_expression(upper.shallow_copy()) << " - " << as_expression(lower.shallow_copy()) << ")"
+                <<        " / " << step_value << " + 1) * " << step_value << ";"
+                << "else "
+                <<    as_symbol(induction_var) << " = " << as_expression(lower.shallow_copy()) << ";"
+                ;
+        }
+
+        Nodecl::NodeclBase task_placeholder;
+        Source block_loop;
+        block_loop
+            << "{"
+            << as_type(induction_var_type) << " " << block_lower_name << ";"
+            << "for (" << block_lower_name << " = " << as_expression(lower.shallow_copy()) << "; "
+            <<            block_lower_name << " <= " << as_expression(upper.shallow_copy()) << "; "
+            <<            block_lower_name << " += " << (_block_size * step_value) << ")"
+            << "{"
+            // Written this way so it does not overflow near the upper bound
+            <<    as_type(induction_var_type) << " " << block_upper_name << " = "
+            <<        "(" << as_expression(upper.shallow_copy()) << " - " << block_lower_name
+            <<            " < " << ((_block_size - 1) * step_value) << ")"
+            <<        " ? " << as_expression(upper.shallow_copy())
+            <<        " : " << block_lower_name << " + " << ((_block_size - 1) * step_value) << ";"
+            <<    statement_placeholder(task_placeholder)
+            << "}"
+            << final_value
+            << "}"
+            ;
+
+        Nodecl::NodeclBase block_loop_tree = block_loop.parse_statement(loop);
+
+        TL::Scope task_scope = task_placeholder.retrieve_context();
+        TL::Symbol block_lower = task_scope.get_symbol_from_name(block_lower_name);
+        TL::Symbol block_upper = task_scope.get_symbol_from_name(block_upper_name);
+        ERROR_CONDITION(!block_lower.is_valid() || !block_upper.is_valid(), "Invalid symbol", 0);
+
+        // Each task executes its block of iterations with a private induction variable
+        Nodecl::NodeclBase body_placeholder;
+        Source chunk_loop;
+        chunk_loop
+            << "{"
+            << as_type(induction_var_type) << " " << induction_var.get_name() << ";"
+            << "for (" << induction_var.get_name() << " = " << as_symbol(block_lower) << "; "
+            <<            induction_var.get_name() << " <= " << as_symbol(block_upper) << "; "
+            <<            induction_var.get_name() << " += " << step_value << ")"
+            << "{"
+            <<    statement_placeholder(body_placeholder)
+            << "}"
+            << "}"
+            ;
+
+        Nodecl::NodeclBase chunk_loop_tree = chunk_loop.parse_statement(task_placeholder);
+
+        TL::Symbol private_induction_var =
+            body_placeholder.retrieve_context().get_symbol_from_name(induction_var.get_name());
+        ERROR_CONDITION(!private_induction_var.is_valid(), "Invalid symbol", 0);
+
+        Nodecl::Utils::SimpleSymbolMap symbol_map;
+        symbol_map.add_map(induction_var, private_induction_var);
+
+        Nodecl::NodeclBase new_body = Nodecl::Utils::deep_copy(task.get_statements(),
+                body_placeholder,
+                symbol_map);
+        body_placeholder.replace(new_body);
+
+        // The dependences of the block are the union of the dependences of its iterations
+        TL::ObjectList<Nodecl::NodeclBase> new_clauses;
+        Nodecl::List clauses = task.get_pragma_line().get_clauses().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = clauses.begin(); it != clauses.end(); it++)
+        {
+            TL::PragmaCustomSingleClause clause = it->as<Nodecl::PragmaCustomClause>();
+            std::string clause_name = clause.get_text();
+
+            if (clause_name == "default")
+            {
+                new_clauses.append(clause.shallow_copy());
+                continue;
+            }
+
+            TL::ObjectList<std::string> arguments = clause.get_tokenized_arguments();
+            TL::ObjectList<Nodecl::NodeclBase> new_arguments;
+            for (TL::ObjectList<std::string>::iterator it2 = arguments.begin();
+                    it2 != arguments.end();
+                    it2++)
+            {
+                if (is_dependence_clause(clause_name))
+                {
+                    Nodecl::NodeclBase dep = parse_dependence(*it2, task);
+                    std::string new_dep;
+                    aggregate_dependence(dep, induction_var, block_lower, block_upper, new_dep);
+                    new_arguments.append(Nodecl::PragmaClauseArg::make(new_dep));
+                }
+                else if (*it2 != induction_var.get_name())
+                {
+                    new_arguments.append(Nodecl::PragmaClauseArg::make(*it2));
+                }
+            }
+
+            if (!new_arguments.empty())
+            {
+                new_clauses.append(
+                        Nodecl::PragmaCustomClause::make(
+                            Nodecl::List::make(new_arguments),
+                            clause_name,
+                            clause.get_locus()));
+            }
+        }
+        new_clauses.append(
+                Nodecl::PragmaCustomClause::make(
+                    Nodecl::List::make(
+                        Nodecl::PragmaClauseArg::make(block_lower_name),
+                        Nodecl::PragmaClauseArg::make(block_upper_name)),
+                    "firstprivate",
+                    task.get_locus()));
+
+        Nodecl::NodeclBase new_pragma_line = Nodecl::PragmaCustomLine::make(
+                Nodecl::NodeclBase::null(),
+                Nodecl::List::make(new_clauses),
+                task.get_pragma_line().get_end_clauses().shallow_copy(),
+                task.get_pragma_line().get_text(),
+                task.get_pragma_line().get_locus());
+
+        Nodecl::NodeclBase new_task = Nodecl::PragmaCustomStatement::make(
+                new_pragma_line,
+                Nodecl::List::make(chunk_loop_tree),
+                task.get_text(),
+                task.get_locus());
+
+        task_placeholder.replace(new_task);
+        loop.replace(block_loop_tree);
+    }
+
+    }
+
+    void Base::apply_task_aggregation(Nodecl::NodeclBase translation_unit)
+    {
+        TaskLoopCandidates candidates;
+        candidates.walk(translation_unit);
+
+        TaskAggregation task_aggregation(_task_aggregation_block_size);
+        for (TL::ObjectList<Nodecl::ForStatement>::iterator it = candidates.loops.begin();
+                it != candidates.loops.end();
+                it++)
+        {
+            TL::PragmaCustomStatement task = task_aggregation.get_loop_task(*it);
+            if (task.is_null())
+                continue;
+
+            if (!task_aggregation.can_be_aggregated(*it, task))
+            {
+                info_printf_at(it->get_locus(),
+                        "tasks of this loop have not been aggregated because %s\n",
+                        task_aggregation.get_reason().c_str());
+                continue;
+            }
+
+            info_printf_at(it->get_locus(),
+                    "aggregating the tasks of this loop in blocks of %d iterations\n",
+                    _task_aggregation_block_size);
+
+            task_aggregation.aggregate(*it, task);
+        }
+    }
+
+}}
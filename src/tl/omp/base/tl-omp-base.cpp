@@ -45,6 +45,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <sstream>
 
 namespace TL { namespace OpenMP {
 
@@ -57,7 +58,11 @@ namespace TL { namespace OpenMP {
         : PragmaCustomCompilerPhase(),
         _core(),
         _simd_enabled(false),
-        _omp_report(false)
+        _omp_report(false),
+        _taskloop_runtime_based(false),
+        _taskgraph_runtime_based(false),
+        _native_floating_atomic_add(false),
+        _task_aggregation_block_size(0)
     {
         set_phase_name("OpenMP directive to parallel IR");
         set_phase_description("This phase lowers the semantics of OpenMP into the parallel IR of Mercurium");
@@ -127,6 +132,31 @@ namespace TL { namespace OpenMP {
                 _enable_nonvoid_function_tasks,
                 "0").connect(std::bind(&Core::set_enable_nonvoid_function_tasks_from_str, &this->_core, std::placeholders::_1));
 
+        register_parameter("taskloop_runtime_based",
+                "If set to '1' OpenMP taskloop constructs are not expanded into tasks by the compiler. "
+                "Instead, the runtime splits the iteration space",
+                _taskloop_runtime_based_str,
+                "0").connect(std::bind(&Base::set_taskloop_runtime_based, this, std::placeholders::_1));
+
+        register_parameter("taskgraph_runtime_based",
+                "If set to '1' OpenMP taskgraph constructs are kept so the runtime can record their tasks "
+                "the first time and replay them later. Otherwise their statements are executed as usual",
+                _taskgraph_runtime_based_str,
+                "0").connect(std::bind(&Base::set_taskgraph_runtime_based, this, std::placeholders::_1));
+
+        register_parameter("native_floating_atomic_add",
+                "If set to '1' atomic additions and subtractions of floating types are lowered to "
+                "__atomic_fetch_add and __atomic_add_fetch. The native compiler must support them (e.g. Clang). "
+                "Otherwise they are lowered to a compare and exchange loop",
+                _native_floating_atomic_add_str,
+                "0").connect(std::bind(&Base::set_native_floating_atomic_add, this, std::placeholders::_1));
+
+        register_parameter("task_aggregation_block_size",
+                "If set to a number greater than '1' the tasks created by the iterations of a loop "
+                "are grouped in tasks of that number of iterations",
+                _task_aggregation_block_size_str,
+                "0").connect(std::bind(&Base::set_task_aggregation_block_size, this, std::placeholders::_1));
+
         register_omp();
         register_ompss();
     }
@@ -176,6 +206,11 @@ namespace TL { namespace OpenMP {
                 std::bind((void (Base::*)(TL::PragmaCustomStatement))&Base::critical_handler_pre, this, std::placeholders::_1));
         dispatcher("oss").statement.post["critical"].connect(
                 std::bind((void (Base::*)(TL::PragmaCustomStatement))&Base::critical_handler_post, this, std::placeholders::_1));
+
+        dispatcher("oss").statement.pre["taskgraph"].connect(
+                std::bind((void (Base::*)(TL::PragmaCustomStatement))&Base::taskgraph_handler_pre, this, std::placeholders::_1));
+        dispatcher("oss").statement.post["taskgraph"].connect(
+                std::bind((void (Base::*)(TL::PragmaCustomStatement))&Base::taskgraph_handler_post, this, std::placeholders::_1));
     }
 
     void Base::pre_run(TL::DTO& dto)
@@ -199,6 +234,12 @@ namespace TL { namespace OpenMP {
         Nodecl::NodeclBase translation_unit = *std::static_pointer_cast<Nodecl::NodeclBase>(dto["nodecl"]);
         apply_openmp_high_level_transformations(translation_unit);
 
+        if (_task_aggregation_block_size > 1
+                && _core.in_ompss_mode())
+        {
+            apply_task_aggregation(translation_unit);
+        }
+
         _core.run(dto);
 
         if (diagnostics_get_error_count() != 0)
@@ -322,6 +363,7 @@ namespace TL { namespace OpenMP {
         INVALID_DECLARATION_HANDLER(target_teams_distribute_parallel_for)
         INVALID_DECLARATION_HANDLER(target_teams_distribute_parallel_do)
         INVALID_DECLARATION_HANDLER(taskloop)
+        INVALID_DECLARATION_HANDLER(taskgraph)
 
         INVALID_STATEMENT_HANDLER(declare_simd)
 
@@ -361,6 +403,33 @@ namespace TL { namespace OpenMP {
                 "Assuming false");
     }
 
+    void Base::set_taskloop_runtime_based(const std::string& str)
+    {
+        parse_boolean_option("taskloop_runtime_based", str, _taskloop_runtime_based, "Assuming false.");
+    }
+
+    void Base::set_taskgraph_runtime_based(const std::string& str)
+    {
+        parse_boolean_option("taskgraph_runtime_based", str, _taskgraph_runtime_based, "Assuming false.");
+    }
+
+    void Base::set_native_floating_atomic_add(const std::string& str)
+    {
+        parse_boolean_option("native_floating_atomic_add", str, _native_floating_atomic_add, "Assuming false.");
+    }
+
+    void Base::set_task_aggregation_block_size(const std::string& str)
+    {
+        int block_size = 0;
+        std::stringstream ss(str);
+        if (!(ss >> block_size) || block_size < 0)
+        {
+            std::cerr << "Invalid value '" << str << "' for task_aggregation_block_size. Assuming 0" << std::endl;
+            block_size = 0;
+        }
+        _task_aggregation_block_size = block_size;
+    }
+
     void Base::set_omp_report_parameter(const std::string& str)
     {
         parse_boolean_option("omp_report", str, _omp_report, "Assuming false.");
@@ -383,6 +452,57 @@ namespace TL { namespace OpenMP {
                         directive.get_locus())
         );
 
+        // Reads and writes cannot be told apart from the statement, while
+        // the form of the update (capture, compare) is deduced from it
+        std::string atomic_kind = "update";
+        const char* atomic_kinds[] = { "read", "write", "update", "capture", "compare" };
+        int num_atomic_kinds = 0;
+        for (unsigned int i = 0; i < sizeof(atomic_kinds) / sizeof(atomic_kinds[0]); ++i)
+        {
+            if (pragma_line.get_clause(atomic_kinds[i]).is_defined())
+            {
+                num_atomic_kinds++;
+                if (std::string(atomic_kinds[i]) == "read"
+                        || std::string(atomic_kinds[i]) == "write")
+                    atomic_kind = atomic_kinds[i];
+            }
+        }
+        if ((atomic_kind == "read" || atomic_kind == "write")
+                && num_atomic_kinds > 1)
+        {
+            error_printf_at(directive.get_locus(),
+                    "'%s' clause of an 'atomic' construct cannot appear with other atomic clauses\n",
+                    atomic_kind.c_str());
+        }
+        execution_environment.append(
+                Nodecl::OpenMP::AtomicKind::make(atomic_kind, directive.get_locus()));
+
+        if (_native_floating_atomic_add)
+        {
+            execution_environment.append(
+                    Nodecl::OpenMP::NativeFloatingAtomicAdd::make(directive.get_locus()));
+        }
+
+        // OpenMP allows relaxed atomics when no memory order is specified
+        std::string memory_order = "relaxed";
+        const char* memory_orders[] = { "seq_cst", "acq_rel", "release", "acquire", "relaxed" };
+        int num_memory_orders = 0;
+        for (unsigned int i = 0; i < sizeof(memory_orders) / sizeof(memory_orders[0]); ++i)
+        {
+            if (pragma_line.get_clause(memory_orders[i]).is_defined())
+            {
+                memory_order = memory_orders[i];
+                num_memory_orders++;
+            }
+        }
+        if (num_memory_orders > 1)
+        {
+            error_printf_at(directive.get_locus(),
+                    "at most one memory order clause can appear in an 'atomic' construct\n");
+        }
+        execution_environment.append(
+                Nodecl::OpenMP::MemoryOrder::make(memory_order, directive.get_locus()));
+
         if (emit_omp_report())
         {
             *_omp_report_file
@@ -459,6 +579,23 @@ namespace TL { namespace OpenMP {
             }
         }
 
+        TL::PragmaCustomClause hint_clause = pragma_line.get_clause("hint");
+        if (hint_clause.is_defined())
+        {
+            TL::ObjectList<Nodecl::NodeclBase> expr_list = hint_clause.get_arguments_as_expressions();
+            if (expr_list.size() != 1)
+            {
+                error_printf_at(directive.get_locus(), "'hint' clause requires exactly one expression\n");
+            }
+            else
+            {
+                execution_environment.append(
+                        Nodecl::OpenMP::CriticalHint::make(
+                            expr_list[0],
+                            directive.get_locus()));
+            }
+        }
+
         pragma_line.diagnostic_unused_clauses();
         directive.replace(
                 Nodecl::OpenMP::Critical::make(
@@ -855,6 +992,7 @@ namespace TL { namespace OpenMP {
                 pragma_line, /* ignore_target_info */ false, /* is_inline_task */ false);
 
         handle_label_clause(directive, execution_environment);
+        handle_reduction_strategy_clause(directive, execution_environment);
 
         Nodecl::NodeclBase num_threads;
         PragmaCustomClause clause = pragma_line.get_clause("num_threads");
@@ -1188,6 +1326,7 @@ namespace TL { namespace OpenMP {
                 ds, pragma_line, /* ignore_target_info */ false, /* is_inline_task */ false);
 
         handle_label_clause(directive, execution_environment);
+        handle_reduction_strategy_clause(directive, execution_environment);
 
         if (_core.in_ompss_mode())
         {
@@ -1206,6 +1345,19 @@ namespace TL { namespace OpenMP {
             std::string schedule = arguments[0];
             schedule = strtolower(schedule.c_str());
 
+            // OpenMP 4.5 schedule modifiers: schedule([modifier:]kind[, chunk])
+            std::string schedule_modifier;
+            std::string::size_type colon = schedule.find(':');
+            if (colon != std::string::npos)
+            {
+                schedule_modifier = schedule.substr(0, colon);
+                schedule = schedule.substr(colon + 1);
+
+                schedule_modifier.erase(0, schedule_modifier.find_first_not_of(" \t"));
+                schedule_modifier.erase(schedule_modifier.find_last_not_of(" \t") + 1);
+                schedule.erase(0, schedule.find_first_not_of(" \t"));
+            }
+
             std::string checked_schedule_name = schedule;
 
             // Allow OpenMP schedules be prefixed with 'ompss_', 'omp_' and 'openmp_'
@@ -1264,6 +1416,32 @@ namespace TL { namespace OpenMP {
                         schedule.c_str());
             }
 
+            if (schedule_modifier == "monotonic"
+                    || schedule_modifier == "nonmonotonic")
+            {
+                if (schedule_modifier == "nonmonotonic"
+                        && checked_schedule_name != "dynamic"
+                        && checked_schedule_name != "guided")
+                {
+                    error_printf_at(directive.get_locus(),
+                            "'nonmonotonic' modifier can only be used with 'dynamic' or 'guided' schedules\n");
+                }
+                else
+                {
+                    execution_environment.append(
+                            Nodecl::OpenMP::ScheduleModifier::make(
+                                schedule_modifier,
+                                directive.get_locus()));
+                }
+            }
+            else if (schedule_modifier != ""
+                    && schedule_modifier != "simd")
+            {
+                error_printf_at(directive.get_locus(),
+                        "invalid schedule modifier '%s'\n",
+                        schedule_modifier.c_str());
+            }
+
             if (emit_omp_report())
             {
                 *_omp_report_file
@@ -1414,7 +1592,7 @@ namespace TL { namespace OpenMP {
             {
                 error_printf_at(pragma_line.get_locus(), "cannot define 'grainsize' and 'num_tasks' clauses at the same time\n");
             }
-            else
+            else if (!_taskloop_runtime_based)
             {
                 error_printf_at(pragma_line.get_locus(), "missing a 'grainsize' or a 'num_tasks' clauses\n");
             }
@@ -1458,8 +1636,12 @@ namespace TL { namespace OpenMP {
         }
 
         // grainsize_expr or num_tasks_expr has to be valid, otherwise we skip the taskloop
+        // (unless the runtime decides how the iteration space is split)
         if ((grainsize_expr.is_null() || grainsize_expr.is<Nodecl::ErrExpr>()) &&
-            (num_tasks_expr.is_null() || num_tasks_expr.is<Nodecl::ErrExpr>()))
+            (num_tasks_expr.is_null() || num_tasks_expr.is<Nodecl::ErrExpr>()) &&
+            !(_taskloop_runtime_based
+                && !grainsize_clause.is_defined()
+                && !num_tasks_clause.is_defined()))
             return;
 
         bool taskwait_at_the_end = true;
@@ -1481,7 +1663,42 @@ namespace TL { namespace OpenMP {
 
         pragma_line.diagnostic_unused_clauses();
 
-        taskloop_block_loop(directive, statement, execution_environment, grainsize_expr, num_tasks_expr);
+        if (_taskloop_runtime_based)
+        {
+            TL::ForStatement for_statement(
+                    statement.as<Nodecl::Context>()
+                    .get_in_context()
+                    .as<Nodecl::List>().front()
+                    .as<Nodecl::ForStatement>());
+
+            TL::HLT::LoopNormalize loop_normalize;
+            loop_normalize.set_loop(for_statement);
+
+            loop_normalize.normalize();
+
+            Nodecl::NodeclBase normalized_loop = loop_normalize.get_whole_transformation();
+            ERROR_CONDITION(!normalized_loop.is<Nodecl::ForStatement>(), "Unexpected node\n", 0);
+
+            TL::ForStatement new_for_statement(normalized_loop.as<Nodecl::ForStatement>());
+            TL::Symbol induction_variable = new_for_statement.get_induction_variable();
+            execution_environment.append(
+                    Nodecl::OpenMP::Private::make(
+                        Nodecl::List::make(induction_variable.make_nodecl(/* set_ref_type */ true))));
+
+            if (!grainsize_expr.is_null())
+                execution_environment.append(Nodecl::OpenMP::Grainsize::make(grainsize_expr));
+            else if (!num_tasks_expr.is_null())
+                execution_environment.append(Nodecl::OpenMP::NumTasks::make(num_tasks_expr));
+
+            statement = Nodecl::OpenMP::TaskLoop::make(
+                    execution_environment,
+                    normalized_loop,
+                    directive.get_locus());
+        }
+        else
+        {
+            taskloop_block_loop(directive, statement, execution_environment, grainsize_expr, num_tasks_expr);
+        }
 
         Nodecl::List list;
         list.append(statement);
@@ -1593,6 +1810,96 @@ namespace TL { namespace OpenMP {
         directive.replace(list);
     }
 
+    void Base::taskgraph_handler_pre(TL::PragmaCustomStatement) { }
+    void Base::taskgraph_handler_post(TL::PragmaCustomStatement directive)
+    {
+        TL::PragmaCustomLine pragma_line = directive.get_pragma_line();
+        Nodecl::NodeclBase statements = directive.get_statements();
+
+        if (emit_omp_report())
+        {
+            *_omp_report_file
+                << "\n"
+                << directive.get_locus_str() << ": " << "TASKGRAPH construct\n"
+                << directive.get_locus_str() << ": " << "-------------------\n"
+                ;
+        }
+
+        Nodecl::List execution_environment;
+
+        PragmaCustomClause graph_id = pragma_line.get_clause("graph_id");
+        if (graph_id.is_defined())
+        {
+            TL::ObjectList<Nodecl::NodeclBase> args = graph_id.get_arguments_as_expressions();
+            if (args.size() == 1)
+            {
+                execution_environment.append(
+                        Nodecl::OpenMP::GraphId::make(args[0], directive.get_locus()));
+            }
+            else
+            {
+                error_printf_at(pragma_line.get_locus(),
+                        "Invalid number of expressions in the 'graph_id' clause\n");
+            }
+        }
+
+        PragmaCustomClause graph_reset = pragma_line.get_clause("graph_reset");
+        if (graph_reset.is_defined())
+        {
+            TL::ObjectList<Nodecl::NodeclBase> args = graph_reset.get_arguments_as_expressions();
+            if (args.size() == 1)
+            {
+                execution_environment.append(
+                        Nodecl::OpenMP::GraphReset::make(args[0], directive.get_locus()));
+            }
+            else
+            {
+                error_printf_at(pragma_line.get_locus(),
+                        "Invalid number of expressions in the 'graph_reset' clause\n");
+            }
+        }
+
+        bool nogroup = pragma_line.get_clause("nogroup").is_defined();
+        if (nogroup)
+            execution_environment.append(Nodecl::OpenMP::Nogroup::make(directive.get_locus()));
+
+        if (emit_omp_report())
+        {
+            *_omp_report_file
+                << OpenMP::Report::indent
+                << (_taskgraph_runtime_based
+                        ? "The tasks of this region are recorded once and replayed by the runtime\n"
+                        : "The tasks of this region are created as usual\n")
+                ;
+        }
+
+        pragma_line.diagnostic_unused_clauses();
+
+        Nodecl::List list;
+        if (_taskgraph_runtime_based)
+        {
+            // The runtime encloses the region in a taskgroup unless 'nogroup' is present
+            list.append(
+                    Nodecl::OpenMP::Taskgraph::make(
+                        execution_environment,
+                        statements.shallow_copy(),
+                        directive.get_locus()));
+        }
+        else
+        {
+            list = statements.shallow_copy().as<Nodecl::List>();
+            if (!nogroup)
+            {
+                list.append(
+                        Nodecl::OpenMP::Taskwait::make(
+                            /*environment*/ nodecl_null(),
+                            directive.get_locus()));
+            }
+        }
+
+        directive.replace(list);
+    }
+
     // Since parallel {for,do,sections} are split into two nodes: parallel and
     // then {for,do,section}, we need to make sure the children of the new
     // parallel contains a proper context as its child
@@ -2164,6 +2471,25 @@ namespace TL { namespace OpenMP {
                 ERROR_CONDITION(colon_splited_list_size <= 0 || colon_splited_list_size > 2,
                         "'prefetch' clause has a wrong format", 0);
 
+                // prefetch(auto): distances are computed by the vectorizer
+                if (colon_splited_list_size == 1
+                        && colon_splited_list.front() == "auto")
+                {
+                    environment.append(Nodecl::OpenMP::Prefetch::make(
+                                Nodecl::NodeclBase::null(),
+                                Nodecl::OnTopFlag::make(),
+                                pragma_line.get_locus()));
+                    continue;
+                }
+                // prefetch(none): neither manual nor automatic prefetching
+                else if (colon_splited_list_size == 1
+                        && colon_splited_list.front() == "none")
+                {
+                    environment.append(Nodecl::OpenMP::NoPrefetch::make(
+                                pragma_line.get_locus()));
+                    continue;
+                }
+
                 // On top prefetch strategy by default
                 Nodecl::NodeclBase prefetch_strategy_node = Nodecl::OnTopFlag::make();
 
@@ -4567,6 +4893,40 @@ namespace TL { namespace OpenMP {
         }
     }
 
+    void Base::handle_reduction_strategy_clause(
+            const TL::PragmaCustomStatement& directive,
+            Nodecl::List& execution_environment)
+    {
+        PragmaCustomLine pragma_line = directive.get_pragma_line();
+        PragmaCustomClause strategy_clause = pragma_line.get_clause("reduction_strategy");
+        if (!strategy_clause.is_defined())
+            return;
+
+        TL::ObjectList<std::string> str_list = strategy_clause.get_tokenized_arguments();
+        if (str_list.size() == 1
+                && (str_list[0] == "runtime"
+                    || str_list[0] == "tree"
+                    || str_list[0] == "auto"))
+        {
+            execution_environment.append(
+                    Nodecl::OpenMP::ReductionStrategy::make(
+                        str_list[0],
+                        directive.get_locus()));
+
+            if (emit_omp_report())
+            {
+                *_omp_report_file
+                    << OpenMP::Report::indent
+                    << "Reductions will be combined using the '" << str_list[0] << "' strategy\n";
+            }
+        }
+        else
+        {
+            warn_printf_at(directive.get_locus(),
+                    "ignoring invalid 'reduction_strategy' clause, valid strategies are 'runtime', 'tree' and 'auto'\n");
+        }
+    }
+
 
 } }
 
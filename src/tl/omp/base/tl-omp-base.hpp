@@ -69,6 +69,22 @@ namespace TL
 
                 std::string _disable_task_expr_optim_str;
 
+                std::string _taskloop_runtime_based_str;
+                bool _taskloop_runtime_based;
+                void set_taskloop_runtime_based(const std::string &str);
+
+                std::string _taskgraph_runtime_based_str;
+                bool _taskgraph_runtime_based;
+                void set_taskgraph_runtime_based(const std::string &str);
+
+                std::string _native_floating_atomic_add_str;
+                bool _native_floating_atomic_add;
+                void set_native_floating_atomic_add(const std::string &str);
+
+                std::string _task_aggregation_block_size_str;
+                int _task_aggregation_block_size;
+                void set_task_aggregation_block_size(const std::string &str);
+
                 // Strings used to store the TL::Core phase flags
                 std::string _ompss_mode_str;
                 std::string _copy_deps_str;
@@ -189,6 +205,10 @@ namespace TL
                         const TL::PragmaCustomStatement& directive,
                         Nodecl::List& execution_environment);
 
+                void handle_reduction_strategy_clause(
+                        const TL::PragmaCustomStatement& directive,
+                        Nodecl::List& execution_environment);
+
                 void register_omp();
                 void register_ompss();
 
@@ -196,6 +216,10 @@ namespace TL
                 //! It applies the OpenMP high level transformations, such as the collapse clause
                 void apply_openmp_high_level_transformations(Nodecl::NodeclBase translation_unit);
 
+                //! This function is called before executing the OpenMP::Core phase.
+                //! It groups the tasks created by consecutive iterations of a loop into a single task
+                void apply_task_aggregation(Nodecl::NodeclBase translation_unit);
+
 #ifndef VECTORIZATION_DISABLED
                 void register_simd_function(
                         OpenMP::DataEnvironment& ds,
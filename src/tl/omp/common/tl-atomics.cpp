@@ -26,7 +26,6 @@
 
 #include"tl-atomics.hpp"
 #include"tl-nodecl-utils.hpp"
-#include"tl-counters.hpp"
 
 namespace TL {
 
@@ -229,8 +228,10 @@ namespace TL {
                                     || t.is_floating_type()))
                             return false;
 
+                        // A floating rhs would be truncated before the operation
                         using_builtin =
                             lhs_is_integral
+                            && t.is_integral_type()
                             && (op_kind == NODECL_ADD_ASSIGNMENT                 // x += y
                                     || op_kind == NODECL_MINUS_ASSIGNMENT        // x -= y
                                     || op_kind == NODECL_BITWISE_AND_ASSIGNMENT  // x &= y
@@ -256,230 +257,584 @@ namespace TL {
             return allowed_expression_atomic_c(expr, using_builtin, using_nanos_api);
     }
 
-    Nodecl::NodeclBase compare_and_exchange(Nodecl::NodeclBase expr)
+    AtomicMemoryOrder get_atomic_memory_order(const Nodecl::OpenMP::Atomic& construct)
     {
-        node_t op_kind = expr.get_kind();
-        Source critical_source;
-        Source type, lhs, rhs, op, bytes, proper_int_type, temporary;
+        Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = environment.begin(); it != environment.end(); it++)
+        {
+            if (!it->is<Nodecl::OpenMP::MemoryOrder>())
+                continue;
+
+            std::string memory_order = it->as<Nodecl::OpenMP::MemoryOrder>().get_text();
+            if (memory_order == "relaxed")
+                return ATOMIC_ORDER_RELAXED;
+            else if (memory_order == "acquire")
+                return ATOMIC_ORDER_ACQUIRE;
+            else if (memory_order == "release")
+                return ATOMIC_ORDER_RELEASE;
+            else if (memory_order == "acq_rel")
+                return ATOMIC_ORDER_ACQ_REL;
+            else if (memory_order == "seq_cst")
+                return ATOMIC_ORDER_SEQ_CST;
+            else
+                internal_error("Unexpected memory order '%s'\n", memory_order.c_str());
+        }
 
-        Type expr_type = expr.get_type();
+        return ATOMIC_ORDER_SEQ_CST;
+    }
 
-        if (expr_type.is_any_reference())
+    AtomicKind get_atomic_kind(const Nodecl::OpenMP::Atomic& construct)
+    {
+        Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = environment.begin(); it != environment.end(); it++)
         {
-            expr_type = expr_type.references_to();
+            if (!it->is<Nodecl::OpenMP::AtomicKind>())
+                continue;
+
+            std::string atomic_kind = it->as<Nodecl::OpenMP::AtomicKind>().get_text();
+            if (atomic_kind == "read")
+                return ATOMIC_KIND_READ;
+            else if (atomic_kind == "write")
+                return ATOMIC_KIND_WRITE;
+            else if (atomic_kind == "update")
+                return ATOMIC_KIND_UPDATE;
+            else
+                internal_error("Unexpected atomic kind '%s'\n", atomic_kind.c_str());
         }
 
-        Source atomic_union; // Defined below
+        return ATOMIC_KIND_UPDATE;
+    }
 
-        critical_source
-            << "{"
-            <<   type << " __oldval;"
-            <<   type << " __newval;"
+    namespace
+    {
+        bool has_native_floating_atomic_add(const Nodecl::OpenMP::Atomic& construct)
+        {
+            Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+            for (Nodecl::List::iterator it = environment.begin(); it != environment.end(); it++)
+            {
+                if (it->is<Nodecl::OpenMP::NativeFloatingAtomicAdd>())
+                    return true;
+            }
+            return false;
+        }
+
+        // Atomic loads and failed compare and exchanges cannot have release semantics
+        AtomicMemoryOrder get_load_memory_order(AtomicMemoryOrder memory_order)
+        {
+            if (memory_order == ATOMIC_ORDER_RELEASE)
+                return ATOMIC_ORDER_RELAXED;
+            else if (memory_order == ATOMIC_ORDER_ACQ_REL)
+                return ATOMIC_ORDER_ACQUIRE;
+            return memory_order;
+        }
 
-            <<   temporary
+        // Atomic stores cannot have acquire semantics
+        AtomicMemoryOrder get_store_memory_order(AtomicMemoryOrder memory_order)
+        {
+            if (memory_order == ATOMIC_ORDER_ACQUIRE)
+                return ATOMIC_ORDER_RELAXED;
+            else if (memory_order == ATOMIC_ORDER_ACQ_REL)
+                return ATOMIC_ORDER_RELEASE;
+            return memory_order;
+        }
 
+        TL::Type get_atomic_type(Nodecl::NodeclBase n)
+        {
+            return n.get_type().no_ref().get_unqualified_type();
+        }
 
-            <<   "do {"
-            <<      "__oldval = (" << lhs << ");"
-            <<      "__newval = __oldval " << op << " (" << rhs << ");"
-            <<      "__sync_synchronize();"
-            <<   "} while (!__sync_bool_compare_and_swap_" << bytes << "("
-            <<                 "(" << proper_int_type << "*)&(" << lhs << "),"
-            <<                 "(" << atomic_union << "){__oldval}.__addr,"
-            <<                 "(" << atomic_union << "){__newval}.__addr));"
-            << "}"
-            ;
+        // Sizes for which GCC does not need libatomic
+        bool is_lock_free_size(TL::Type t)
+        {
+            int size = t.get_size();
+            return (size == 1 || size == 2 || size == 4 || size == 8);
+        }
 
-        if (op_kind == NODECL_PREINCREMENT  // ++x
-                || op_kind == NODECL_POSTINCREMENT // x++
-                || op_kind == NODECL_PREDECREMENT // --x
-                || op_kind == NODECL_POSTDECREMENT) // x--
+        bool same_location(Nodecl::NodeclBase n1, Nodecl::NodeclBase n2)
         {
-            lhs << as_expression(expr.as<Nodecl::Preincrement>().get_rhs());
-            rhs << "1";
+            return Nodecl::Utils::structurally_equal_nodecls(n1, n2, /* skip_conversion_nodecls */ true);
+        }
 
-            if (op_kind == NODECL_PREDECREMENT
-                    || op_kind == NODECL_POSTDECREMENT)
+        // Splits an update expression accepted by allowed_expression_atomic_c.
+        // 'rhs' is null for increments and decrements
+        void get_update_operands(Nodecl::NodeclBase expr,
+                Nodecl::NodeclBase& lhs,
+                Nodecl::NodeclBase& rhs,
+                std::string& op,
+                bool& returns_old_value)
+        {
+            node_t op_kind = expr.get_kind();
+            if (op_kind == NODECL_PREINCREMENT  // ++x
+                    || op_kind == NODECL_POSTINCREMENT // x++
+                    || op_kind == NODECL_PREDECREMENT // --x
+                    || op_kind == NODECL_POSTDECREMENT) // x--
             {
-                op << "-";
+                lhs = expr.as<Nodecl::Preincrement>().get_rhs();
+                op = (op_kind == NODECL_PREDECREMENT || op_kind == NODECL_POSTDECREMENT) ? "-" : "+";
+                returns_old_value = (op_kind == NODECL_POSTINCREMENT || op_kind == NODECL_POSTDECREMENT);
             }
             else
             {
-                op << "+";
+                lhs = expr.as<Nodecl::AddAssignment>().get_lhs();
+                rhs = expr.as<Nodecl::AddAssignment>().get_rhs();
+                op = Nodecl::Utils::get_elemental_operator_of_binary_expression(expr);
+                returns_old_value = false;
             }
-
         }
-        else
+
+        std::string get_builtin_name(node_t op_kind, bool returns_old_value)
         {
-            lhs << as_expression(expr.as<Nodecl::AddAssignment>().get_lhs());
-            op << Nodecl::Utils::get_elemental_operator_of_binary_expression(expr);
+            std::string op;
+            switch ((int)op_kind)
+            {
+                case NODECL_PREINCREMENT:
+                case NODECL_POSTINCREMENT:
+                case NODECL_ADD_ASSIGNMENT:
+                    op = "add";
+                    break;
+                case NODECL_PREDECREMENT:
+                case NODECL_POSTDECREMENT:
+                case NODECL_MINUS_ASSIGNMENT:
+                    op = "sub";
+                    break;
+                case NODECL_BITWISE_AND_ASSIGNMENT:
+                    op = "and";
+                    break;
+                case NODECL_BITWISE_OR_ASSIGNMENT:
+                    op = "or";
+                    break;
+                case NODECL_BITWISE_XOR_ASSIGNMENT:
+                    op = "xor";
+                    break;
+                default:
+                    internal_error("Code unreachable", 0);
+            }
 
-            temporary
-                << type << " __temp = " << as_expression(expr.as<Nodecl::AddAssignment>().get_rhs()) << ";";
-            rhs << "__temp";
+            return (returns_old_value ? "__atomic_fetch_" + op : "__atomic_" + op + "_fetch");
         }
 
-        type << as_type(expr_type);
-        bytes << expr_type.get_size();
+        // 'captured' is the (possibly null) variable where the value of the update is stored
+        Nodecl::NodeclBase builtin_update(
+                Nodecl::NodeclBase expr,
+                Nodecl::NodeclBase captured,
+                AtomicMemoryOrder memory_order)
+        {
+            Nodecl::NodeclBase lhs, rhs;
+            std::string op;
+            bool returns_old_value;
+            get_update_operands(expr, lhs, rhs, op, returns_old_value);
+
+            Source value, captured_src;
+            if (rhs.is_null())
+                value << "1";
+            else
+                value << "__tmp";
+
+            if (!captured.is_null())
+                captured_src << as_expression(captured) << " = ";
 
-        if (expr_type.get_size() == 4)
+            Source atomic_source;
+            atomic_source << "{";
+            if (!rhs.is_null())
+            {
+                atomic_source << as_type(get_atomic_type(lhs)) << " __tmp = " << as_expression(rhs) << ";";
+            }
+            atomic_source
+                <<   captured_src << get_builtin_name(expr.get_kind(), returns_old_value)
+                <<      "(&(" << as_expression(lhs) << "), " << value << ", " << (int)memory_order << ");"
+                << "}"
+                ;
+
+            return atomic_source.parse_statement(expr);
+        }
+
+        Nodecl::NodeclBase compare_and_exchange_update(
+                Nodecl::NodeclBase expr,
+                Nodecl::NodeclBase captured,
+                AtomicMemoryOrder memory_order)
         {
-            Type int_type(::get_unsigned_int_type());
-            if (int_type.get_size() == 4)
+            Nodecl::NodeclBase lhs, rhs;
+            std::string op;
+            bool returns_old_value;
+            get_update_operands(expr, lhs, rhs, op, returns_old_value);
+
+            Source type, value, temporary, capture;
+            type << as_type(get_atomic_type(lhs));
+
+            if (rhs.is_null())
             {
-                proper_int_type << "int";
+                value << "1";
             }
             else
             {
-                internal_error("Code unreachable", 0);
+                // Keep the type of the rhs, so the operation is performed as in the original expression
+                temporary << as_type(get_atomic_type(rhs)) << " __temp = " << as_expression(rhs) << ";";
+                value << "__temp";
+            }
+
+            if (!captured.is_null())
+            {
+                capture << as_expression(captured) << " = " << (returns_old_value ? "__oldval" : "__newval") << ";";
             }
+
+            Source atomic_source;
+            atomic_source
+                << "{"
+                <<   temporary
+                <<   type << " __oldval;"
+                <<   type << " __newval;"
+                <<   "__atomic_load(&(" << as_expression(lhs) << "), &__oldval, "
+                <<                (int)get_load_memory_order(memory_order) << ");"
+                <<   "do {"
+                <<      "__newval = __oldval " << op << " (" << value << ");"
+                <<   "} while (!__atomic_compare_exchange(&(" << as_expression(lhs) << "), "
+                <<                 "&__oldval, &__newval, /* weak */ 1, "
+                <<                 (int)memory_order << ", " << (int)get_load_memory_order(memory_order) << "));"
+                <<   capture
+                << "}"
+                ;
+
+            return atomic_source.parse_statement(expr);
         }
-        else if (expr_type.get_size() == 8)
+
+        std::string get_comparison_operator(node_t op_kind)
         {
-            // FIXME - Why are we using a low level op?
-            Type long_type(::get_unsigned_long_int_type());
-            Type long_long_type(::get_unsigned_long_long_int_type());
+            switch (op_kind)
+            {
+                case NODECL_EQUAL:
+                    return "==";
+                case NODECL_LOWER_THAN:
+                    return "<";
+                case NODECL_LOWER_OR_EQUAL_THAN:
+                    return "<=";
+                case NODECL_GREATER_THAN:
+                    return ">";
+                case NODECL_GREATER_OR_EQUAL_THAN:
+                    return ">=";
+                default:
+                    return "";
+            }
+        }
+
+        // Lowers 'if (cond) x = value;'
+        //  - if (x == e) x = d;  is a single strong compare and exchange
+        //  - if (e < x) x = e;   (min/max) is a compare and exchange loop that stops
+        //                        as soon as the condition does not hold
+        Nodecl::NodeclBase lower_atomic_compare(
+                Nodecl::NodeclBase x,
+                Nodecl::NodeclBase cond,
+                Nodecl::NodeclBase value,
+                AtomicMemoryOrder memory_order,
+                Nodecl::NodeclBase ref)
+        {
+            std::string cmp = get_comparison_operator(cond.get_kind());
+            if (cmp.empty())
+                return Nodecl::NodeclBase::null();
 
-            if (long_type.get_size() == 8)
+            Nodecl::NodeclBase cond_lhs = cond.as<Nodecl::Equal>().get_lhs().no_conv();
+            Nodecl::NodeclBase cond_rhs = cond.as<Nodecl::Equal>().get_rhs().no_conv();
+
+            bool x_is_lhs;
+            Nodecl::NodeclBase e;
+            if (same_location(x, cond_lhs))
             {
-                proper_int_type << "long";
+                x_is_lhs = true;
+                e = cond_rhs;
             }
-            else if (long_long_type.get_size() == 8)
+            else if (same_location(x, cond_rhs))
             {
-                proper_int_type << "long long";
+                x_is_lhs = false;
+                e = cond_lhs;
             }
             else
             {
-                internal_error("Code unreachable", 0);
+                return Nodecl::NodeclBase::null();
             }
-        }
 
-        // Atomic union
-        Counter& union_counter = CounterManager::get_counter("nanos-union-atomic");
-        atomic_union << "__nanos_atomic_union_" << (int)union_counter;
-        union_counter++;
-        Source atomic_type_decl;
-        atomic_type_decl << "typedef union { " << type << " __val;" << proper_int_type << " __addr; } " << atomic_union << ";"
-            ;
+            TL::Type type = get_atomic_type(x);
+            if (same_location(x, e)
+                    || !is_lock_free_size(type))
+                return Nodecl::NodeclBase::null();
 
-        Nodecl::NodeclBase n = atomic_type_decl.parse_global(expr);
-        if (!n.is_null())
-        {
-            Nodecl::Utils::prepend_to_enclosing_top_level_location(expr, n);
+            int load_memory_order = get_load_memory_order(memory_order);
+
+            Source atomic_source;
+            if (cmp == "==")
+            {
+                // Compare and exchange compares the representation of the values,
+                // which only behaves like == for integral and pointer types
+                TL::Type e_type = get_atomic_type(e);
+                if (!(type.is_integral_type() || type.is_pointer())
+                        || !(e_type.is_integral_type() || e_type.is_pointer()))
+                    return Nodecl::NodeclBase::null();
+
+                atomic_source
+                    << "{"
+                    <<   as_type(type) << " __expected = " << as_expression(e) << ";"
+                    <<   as_type(type) << " __desired = " << as_expression(value) << ";"
+                    <<   "__atomic_compare_exchange(&(" << as_expression(x) << "), "
+                    <<        "&__expected, &__desired, /* weak */ 0, "
+                    <<        (int)memory_order << ", " << load_memory_order << ");"
+                    << "}"
+                    ;
+            }
+            else
+            {
+                if (!same_location(value, e)
+                        || !(type.is_integral_type() || type.is_floating_type() || type.is_pointer()))
+                    return Nodecl::NodeclBase::null();
+
+                Source condition;
+                if (x_is_lhs)
+                    condition << "__oldval " << cmp << " __temp";
+                else
+                    condition << "__temp " << cmp << " __oldval";
+
+                atomic_source
+                    << "{"
+                    <<   as_type(type) << " __temp = " << as_expression(e) << ";"
+                    <<   as_type(type) << " __oldval;"
+                    <<   "__atomic_load(&(" << as_expression(x) << "), &__oldval, " << load_memory_order << ");"
+                    <<   "while ((" << condition << ")"
+                    <<          "&& !__atomic_compare_exchange(&(" << as_expression(x) << "), "
+                    <<                 "&__oldval, &__temp, /* weak */ 1, "
+                    <<                 (int)memory_order << ", " << load_memory_order << "));"
+                    << "}"
+                    ;
+            }
+
+            return atomic_source.parse_statement(ref);
         }
 
-        return critical_source.parse_statement(expr);
-    }
+        // Types that can be loaded and stored with __atomic_load_n and __atomic_store_n
+        bool is_n_builtin_type(TL::Type t)
+        {
+            return (t.is_integral_type() || t.is_pointer());
+        }
 
-    Nodecl::NodeclBase builtin_atomic_int_op(Nodecl::NodeclBase expr)
-    {
-        node_t op_kind = expr.get_kind();
-        Source critical_source;
-        if (op_kind == NODECL_PREINCREMENT  // ++x
-                || op_kind == NODECL_POSTINCREMENT // x++
-                || op_kind == NODECL_PREDECREMENT // --x
-                || op_kind == NODECL_POSTDECREMENT) // x--
+        // Lowers 'v = x;'
+        Nodecl::NodeclBase lower_atomic_read(
+                Nodecl::NodeclBase v,
+                Nodecl::NodeclBase x,
+                AtomicMemoryOrder memory_order,
+                Nodecl::NodeclBase ref)
         {
-            // FIXME: __sync_add_and_fetch or __sync_fetch_and_add? I think
-            // the former would be better for a dumb compiler
-            std::string intrinsic_function_name;
+            TL::Type type = get_atomic_type(x);
+            if (!x.get_type().is_lvalue_reference()
+                    || same_location(v, x)
+                    || !(is_n_builtin_type(type) || type.is_floating_type())
+                    || !is_lock_free_size(type))
+                return Nodecl::NodeclBase::null();
 
-            switch (op_kind)
+            int load_memory_order = get_load_memory_order(memory_order);
+
+            Source atomic_source;
+            if (is_n_builtin_type(type))
             {
-                case NODECL_PREINCREMENT:
-                case NODECL_POSTINCREMENT:
-                    {
-                        intrinsic_function_name = "__sync_add_and_fetch";
-                        break;
-                    }
-                case NODECL_PREDECREMENT:
-                case NODECL_POSTDECREMENT:
-                    {
-                        intrinsic_function_name = "__sync_sub_and_fetch";
-                        break;
-                    }
-                default:
-                    internal_error("Code unreachable", 0);
+                atomic_source
+                    << as_expression(v) << " = __atomic_load_n(&(" << as_expression(x) << "), " << load_memory_order << ");"
+                    ;
+            }
+            else
+            {
+                atomic_source
+                    << "{"
+                    <<   as_type(type) << " __tmp;"
+                    <<   "__atomic_load(&(" << as_expression(x) << "), &__tmp, " << load_memory_order << ");"
+                    <<   as_expression(v) << " = __tmp;"
+                    << "}"
+                    ;
             }
 
-            Source op_size;
-            op_size << expr.as<Nodecl::Preincrement>().get_rhs().get_type().no_ref().get_size();
+            return atomic_source.parse_statement(ref);
+        }
+
+        // Lowers 'x = expr;'
+        Nodecl::NodeclBase lower_atomic_write(
+                Nodecl::NodeclBase x,
+                Nodecl::NodeclBase expr,
+                AtomicMemoryOrder memory_order,
+                Nodecl::NodeclBase ref)
+        {
+            TL::Type type = get_atomic_type(x);
+            if (!(is_n_builtin_type(type) || type.is_floating_type())
+                    || !is_lock_free_size(type))
+                return Nodecl::NodeclBase::null();
+
+            int store_memory_order = get_store_memory_order(memory_order);
 
-            critical_source << intrinsic_function_name << "_" << op_size << "(&(" << as_expression(expr.as<Nodecl::Preincrement>().get_rhs()) << "), 1);"
+            Source store;
+            if (is_n_builtin_type(type))
+                store << "__atomic_store_n(&(" << as_expression(x) << "), __tmp, " << store_memory_order << ");";
+            else
+                store << "__atomic_store(&(" << as_expression(x) << "), &__tmp, " << store_memory_order << ");";
+
+            // The value is computed before the store, as in the original statement
+            Source atomic_source;
+            atomic_source
+                << "{"
+                <<   as_type(type) << " __tmp = " << as_expression(expr) << ";"
+                <<   store
+                << "}"
                 ;
+
+            return atomic_source.parse_statement(ref);
         }
-        // No need to check the other case as allowed_expression_atomic
-        // already did this for us
-        else
+
+        // Additions and subtractions whose value can be converted to the type of 'lhs'
+        // before the operation without changing the result of the original expression
+        bool is_native_floating_add(Nodecl::NodeclBase expr, Nodecl::NodeclBase lhs, Nodecl::NodeclBase rhs)
         {
-            std::string intrinsic_function_name;
-            switch ((int)op_kind)
+            node_t op_kind = expr.get_kind();
+            if (op_kind == NODECL_MUL_ASSIGNMENT
+                    || op_kind == NODECL_DIV_ASSIGNMENT)
+                return false;
+
+            TL::Type type = get_atomic_type(lhs);
+            if (!type.is_floating_type()
+                    || !is_lock_free_size(type))
+                return false;
+
+            if (rhs.is_null())
+                return true;
+
+            TL::Type rhs_type = get_atomic_type(rhs);
+            return (rhs_type.is_integral_type()
+                    || rhs_type.is_same_type(type));
+        }
+
+        // Returns the only statement of a (possibly compound) statement
+        Nodecl::NodeclBase get_single_statement(Nodecl::NodeclBase n)
+        {
+            while (!n.is_null())
             {
-                case NODECL_ADD_ASSIGNMENT : // x += y
-                    {
-                        intrinsic_function_name = "__sync_add_and_fetch";
-                        break;
-                    }
-                case NODECL_MINUS_ASSIGNMENT : // x -= y
-                    {
-                        intrinsic_function_name = "__sync_sub_and_fetch";
-                        break;
-                    }
-                    // case NODECL_MUL_ASSIGNMENT:  // x *= y
-                    //     {
-                    //         // This one does not seem to exist
-                    //         intrinsic_function_name = "__sync_mul_and_fetch";
-                    //         break;
-                    //     }
-                    // case NODECL_DIV_ASSIGNMENT:  // x *= y
-                    //     {
-                    //         // This one does not seem to exist
-                    //         intrinsic_function_name = "__sync_div_and_fetch";
-                    //         break;
-                    //     }
-                case NODECL_BITWISE_AND_ASSIGNMENT : // x &= y
-                    {
-                        intrinsic_function_name = "__sync_and_and_fetch";
-                        break;
-                    }
-                case NODECL_BITWISE_OR_ASSIGNMENT : // x |= y
-                    {
-                        intrinsic_function_name = "__sync_or_and_fetch";
-                        break;
-                    }
-                case NODECL_BITWISE_XOR_ASSIGNMENT : // x ^= y
-                    {
-                        intrinsic_function_name = "__sync_xor_and_fetch";
-                        break;
-                    }
-                    // case NODECL_SHL_ASSIGNMENT : // x <<= y
-                    //     {
-                    //         // This one does not seem to exist
-                    //         intrinsic_function_name = "__sync_shl_and_fetch";
-                    //         break;
-                    //     }
-                    // case NODECL_SHR_ASSIGNMENT : // x >>= y
-                    //     {
-                    //         // This one does not seem to exist
-                    //         intrinsic_function_name = "__sync_shr_and_fetch";
-                    //         break;
-                    //     }
-                default:
-                    internal_error("Code unreachable", 0);
+                if (n.is<Nodecl::List>())
+                {
+                    Nodecl::List l = n.as<Nodecl::List>();
+                    if (l.size() != 1)
+                        return Nodecl::NodeclBase::null();
+                    n = l[0];
+                }
+                else if (n.is<Nodecl::Context>())
+                {
+                    n = n.as<Nodecl::Context>().get_in_context();
+                }
+                else if (n.is<Nodecl::CompoundStatement>())
+                {
+                    n = n.as<Nodecl::CompoundStatement>().get_statements();
+                }
+                else
+                {
+                    break;
+                }
             }
+            return n;
+        }
+    }
 
-            Source op_size;
-            op_size << expr.as<Nodecl::AddAssignment>().get_rhs().get_type().no_ref().get_size();
+    Nodecl::NodeclBase compare_and_exchange(Nodecl::NodeclBase expr, AtomicMemoryOrder memory_order)
+    {
+        return compare_and_exchange_update(expr, Nodecl::NodeclBase::null(), memory_order);
+    }
 
-            critical_source
-                << "{"
-                << as_type(expr.as<Nodecl::AddAssignment>().get_rhs().get_type()) << "__tmp = "
-                << as_expression(expr.as<Nodecl::AddAssignment>().get_rhs()) << ";"
-                << intrinsic_function_name << "_" << op_size << "(&(" << as_expression(expr.as<Nodecl::AddAssignment>().get_lhs()) << "), __tmp);"
-                << "}"
-                ;
+    Nodecl::NodeclBase builtin_atomic_int_op(Nodecl::NodeclBase expr, AtomicMemoryOrder memory_order)
+    {
+        return builtin_update(expr, Nodecl::NodeclBase::null(), memory_order);
+    }
+
+    Nodecl::NodeclBase lower_atomic_statement(Nodecl::NodeclBase stmt, const Nodecl::OpenMP::Atomic& construct)
+    {
+        if (IS_FORTRAN_LANGUAGE)
+            return Nodecl::NodeclBase::null();
+
+        AtomicMemoryOrder memory_order = get_atomic_memory_order(construct);
+        AtomicKind atomic_kind = get_atomic_kind(construct);
+        if (atomic_kind == ATOMIC_KIND_READ
+                || atomic_kind == ATOMIC_KIND_WRITE)
+        {
+            // v = x;  x = expr;
+            if (!stmt.is<Nodecl::ExpressionStatement>()
+                    || !stmt.as<Nodecl::ExpressionStatement>().get_nest().is<Nodecl::Assignment>())
+                return Nodecl::NodeclBase::null();
+
+            Nodecl::Assignment assig = stmt.as<Nodecl::ExpressionStatement>().get_nest().as<Nodecl::Assignment>();
+            if (atomic_kind == ATOMIC_KIND_READ)
+                return lower_atomic_read(assig.get_lhs(), assig.get_rhs().no_conv(), memory_order, stmt);
+            else
+                return lower_atomic_write(assig.get_lhs(), assig.get_rhs(), memory_order, stmt);
+        }
+
+        if (stmt.is<Nodecl::IfElseStatement>())
+        {
+            // if (x == e) x = d;
+            Nodecl::IfElseStatement if_else = stmt.as<Nodecl::IfElseStatement>();
+            if (!if_else.get_else().is_null())
+                return Nodecl::NodeclBase::null();
+
+            Nodecl::NodeclBase then = get_single_statement(if_else.get_then());
+            if (then.is_null()
+                    || !then.is<Nodecl::ExpressionStatement>()
+                    || !then.as<Nodecl::ExpressionStatement>().get_nest().is<Nodecl::Assignment>())
+                return Nodecl::NodeclBase::null();
+
+            Nodecl::Assignment assig = then.as<Nodecl::ExpressionStatement>().get_nest().as<Nodecl::Assignment>();
+            return lower_atomic_compare(assig.get_lhs(),
+                    if_else.get_condition().no_conv(),
+                    assig.get_rhs().no_conv(),
+                    memory_order,
+                    stmt);
+        }
+
+        if (!stmt.is<Nodecl::ExpressionStatement>())
+            return Nodecl::NodeclBase::null();
+
+        Nodecl::NodeclBase expr = stmt.as<Nodecl::ExpressionStatement>().get_nest();
+        Nodecl::NodeclBase captured;
+        if (expr.is<Nodecl::Assignment>())
+        {
+            Nodecl::NodeclBase lhs = expr.as<Nodecl::Assignment>().get_lhs();
+            Nodecl::NodeclBase rhs = expr.as<Nodecl::Assignment>().get_rhs().no_conv();
+
+            if (rhs.is<Nodecl::ConditionalExpression>())
+            {
+                // x = (x == e) ? d : x;
+                Nodecl::ConditionalExpression cond_expr = rhs.as<Nodecl::ConditionalExpression>();
+                if (!same_location(lhs, cond_expr.get_false().no_conv()))
+                    return Nodecl::NodeclBase::null();
+
+                return lower_atomic_compare(lhs,
+                        cond_expr.get_condition().no_conv(),
+                        cond_expr.get_true().no_conv(),
+                        memory_order,
+                        stmt);
+            }
+
+            // v = x binop= e;  v = x++;
+            captured = lhs;
+            expr = rhs;
         }
 
-        return critical_source.parse_statement(expr);
+        bool using_builtin = false;
+        bool using_nanos_api = false;
+        if (!allowed_expression_atomic_c(expr, using_builtin, using_nanos_api))
+            return Nodecl::NodeclBase::null();
+
+        Nodecl::NodeclBase lhs, rhs;
+        std::string op;
+        bool returns_old_value;
+        get_update_operands(expr, lhs, rhs, op, returns_old_value);
+
+        if (!captured.is_null()
+                && same_location(captured, lhs))
+            return Nodecl::NodeclBase::null();
+
+        if (using_builtin
+                || (has_native_floating_atomic_add(construct)
+                    && is_native_floating_add(expr, lhs, rhs)))
+            return builtin_update(expr, captured, memory_order);
+        else if (is_lock_free_size(get_atomic_type(lhs)))
+            return compare_and_exchange_update(expr, captured, memory_order);
+        else
+            return Nodecl::NodeclBase::null();
     }
 }
@@ -33,11 +33,64 @@
 
 namespace TL {
 
+    //! Memory orders of an atomic operation
+    /*!
+     * Their values are those of the GCC __ATOMIC_* constants, so they
+     * can be emitted directly as arguments of the __atomic builtins
+     */
+    enum AtomicMemoryOrder
+    {
+        ATOMIC_ORDER_RELAXED = 0,
+        ATOMIC_ORDER_ACQUIRE = 2,
+        ATOMIC_ORDER_RELEASE = 3,
+        ATOMIC_ORDER_ACQ_REL = 4,
+        ATOMIC_ORDER_SEQ_CST = 5
+    };
+
+    //! Kinds of atomic constructs
+    /*!
+     * Captures and compares are updates: their form is deduced from the statement
+     */
+    enum AtomicKind
+    {
+        ATOMIC_KIND_UPDATE,
+        ATOMIC_KIND_READ,
+        ATOMIC_KIND_WRITE
+    };
+
+    //! Returns the kind of an atomic construct (updates if it has no AtomicKind node)
+    AtomicKind get_atomic_kind(const Nodecl::OpenMP::Atomic& construct);
+
+    //! Returns the memory order of an atomic construct
+    /*!
+     * Atomic constructs without a MemoryOrder node in their environment
+     * (i.e. those created internally by the compiler) are sequentially consistent
+     */
+    AtomicMemoryOrder get_atomic_memory_order(const Nodecl::OpenMP::Atomic& construct);
+
     bool allowed_expression_atomic(Nodecl::NodeclBase expr, bool &using_builtin, bool &using_nanos_api);
 
-    Nodecl::NodeclBase compare_and_exchange(Nodecl::NodeclBase expr);
+    Nodecl::NodeclBase compare_and_exchange(Nodecl::NodeclBase expr,
+            AtomicMemoryOrder memory_order = ATOMIC_ORDER_SEQ_CST);
+
+    Nodecl::NodeclBase builtin_atomic_int_op(Nodecl::NodeclBase expr,
+            AtomicMemoryOrder memory_order = ATOMIC_ORDER_SEQ_CST);
 
-    Nodecl::NodeclBase builtin_atomic_int_op(Nodecl::NodeclBase expr);
+    //! Lowers a C/C++ statement of \p construct using GCC __atomic builtins
+    /*!
+     * Supported statements are:
+     *  - reads: v = x
+     *  - writes: x = expr
+     *  - updates: x++, x--, ++x, --x and x binop= expr
+     *  - captures: v = x++, v = x--, v = ++x, v = --x and v = x binop= expr
+     *  - compares: if (x == e) x = d;  x = (x == e) ? d : x;
+     *              if (e < x) x = e;   x = (e < x) ? e : x;  (and the other ordering operators)
+     * Additions and subtractions of floating types use __atomic_fetch_add and __atomic_add_fetch
+     * only when the construct has a NativeFloatingAtomicAdd node, and a compare and exchange loop otherwise
+     * Returns a null tree when the statement cannot be lowered using the builtins
+     */
+    Nodecl::NodeclBase lower_atomic_statement(Nodecl::NodeclBase stmt,
+            const Nodecl::OpenMP::Atomic& construct);
 }
 
 #endif // TL_ATOMICS_HPP
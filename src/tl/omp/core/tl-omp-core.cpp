@@ -260,6 +260,7 @@ namespace TL { namespace OpenMP {
         register_directive("oss", "taskwait");
         register_construct("oss", "task");
         register_construct("oss", "critical");
+        register_construct("oss", "taskgraph");
 
         dispatcher("oss").directive.pre["taskwait"].connect(std::bind(&Core::taskwait_handler_pre, this, std::placeholders::_1));
         dispatcher("oss").directive.post["taskwait"].connect(std::bind(&Core::taskwait_handler_post, this, std::placeholders::_1));
@@ -278,6 +279,11 @@ namespace TL { namespace OpenMP {
                 std::bind((void (Core::*)(TL::PragmaCustomStatement))&Core::critical_handler_pre, this, std::placeholders::_1));
         dispatcher("oss").statement.post["critical"].connect(
                 std::bind((void (Core::*)(TL::PragmaCustomStatement))&Core::critical_handler_post, this, std::placeholders::_1));
+
+        dispatcher("oss").statement.pre["taskgraph"].connect(
+                std::bind((void (Core::*)(TL::PragmaCustomStatement))&Core::taskgraph_handler_pre, this, std::placeholders::_1));
+        dispatcher("oss").statement.post["taskgraph"].connect(
+                std::bind((void (Core::*)(TL::PragmaCustomStatement))&Core::taskgraph_handler_post, this, std::placeholders::_1));
     }
 
     void Core::phase_cleanup(DTO& data_flow)
@@ -2596,6 +2602,7 @@ namespace TL { namespace OpenMP {
         INVALID_DECLARATION_HANDLER(atomic)
         INVALID_DECLARATION_HANDLER(critical)
         INVALID_DECLARATION_HANDLER(simd_fortran)
+        INVALID_DECLARATION_HANDLER(taskgraph)
 
         INVALID_STATEMENT_HANDLER(declare_simd)
 
@@ -2621,6 +2628,7 @@ namespace TL { namespace OpenMP {
         EMPTY_HANDLERS_STATEMENT(critical)
         EMPTY_HANDLERS_STATEMENT(master)
         EMPTY_HANDLERS_STATEMENT(simd_fortran)
+        EMPTY_HANDLERS_STATEMENT(taskgraph)
 
         EMPTY_HANDLERS_DECLARATION(simd)
         EMPTY_HANDLERS_DECLARATION(declare_simd)
@@ -52,6 +52,11 @@ void LoweringVisitor::lower_for(const Nodecl::OpenMP::For& construct,
                         "prependix or appendix are not supported");
     }
 
+    // The loop of a combined 'parallel for' has already been started
+    // by GOMP_parallel_loop_* when the team was created
+    bool is_combined_loop = (construct == _combined_worksharing);
+    _combined_worksharing = Nodecl::NodeclBase::null();
+
     TL::ForStatement for_statement(construct.get_loop().as<Nodecl::Context>().
             get_in_context().as<Nodecl::List>().front().as<Nodecl::ForStatement>());
 
@@ -322,54 +327,36 @@ void LoweringVisitor::lower_for(const Nodecl::OpenMP::For& construct,
         lastprivate_code << "}";
     }
 
-    typedef std::map<std::string, std::pair<std::string, std::string> >
-        schedule_map_t;
-
-
-    schedule_map_t valid_schedules;
-    valid_schedules.insert(std::make_pair(
-        "static",
-        std::make_pair("GOMP_loop_static_start", "GOMP_loop_static_next")));
-    valid_schedules.insert(std::make_pair(
-        "dynamic",
-        std::make_pair("GOMP_loop_dynamic_start", "GOMP_loop_dynamic_next")));
-    valid_schedules.insert(std::make_pair(
-        "guided",
-        std::make_pair("GOMP_loop_guided_start", "GOMP_loop_guided_next")));
-    // GOMP maps auto to static
-    valid_schedules.insert(std::make_pair(
-        "auto",
-        std::make_pair("GOMP_loop_static_start", "GOMP_loop_static_next")));
-    valid_schedules.insert(std::make_pair(
-        "runtime",
-        std::make_pair("GOMP_loop_runtime_start", "GOMP_loop_runtime_next")));
-
-    Source loop_start, loop_next;
-    schedule_map_t::iterator schedule_info
-        = valid_schedules.find(schedule.get_text());
-    if (schedule_info == valid_schedules.end())
+    std::string schedule_name = GOMP::get_schedule_entry_point_name(
+            environment,
+            _lowering->has_taskloop_and_nonmonotonic());
+
+    Source loop_start;
+    if (is_combined_loop)
     {
-        error_printf_at(construct.get_locus(),
-                        "'%s' is not a valid OpenMP schedule\n",
-                        schedule.get_text().c_str());
-        schedule_info = valid_schedules.find("static");
+        loop_start << "GOMP_loop_" << schedule_name << "_next(&" << istart << ", &" << iend << ")";
+    }
+    else if (schedule_name == "runtime")
+    {
+        loop_start << "GOMP_loop_runtime_start("
+                   << lower << ", 1 + (" << upper << "), " << step << ", "
+                   << "&" << istart << ", &" << iend << ")";
+    }
+    else
+    {
+        loop_start << "GOMP_loop_" << schedule_name << "_start("
+                   << lower << ", 1 + (" << upper << "), " << step << ", "
+                   << chunk_size << ", &" << istart << ", &" << iend << ")";
     }
-    ERROR_CONDITION(
-        schedule_info == valid_schedules.end(), "Invalid schedule", 0);
-
-    loop_start << schedule_info->second.first;
-    loop_next << schedule_info->second.second;
 
     Source sched_loop;
-    sched_loop << common_initialization << not_done << " = " << loop_start
-               << " (" << lower << ", 1 + (" << upper << "), " << step << ", "
-               << chunk_size << ", &" << istart << ", &" << iend << ");"
+    sched_loop << common_initialization << not_done << " = " << loop_start << ";"
                << "while (" << not_done << ") {"
                << "for (" << as_symbol(private_induction_var) << " = " << istart
                << "; " << as_symbol(private_induction_var) << " < " << iend
                << ";" << as_symbol(private_induction_var) << "+=" << step << ")"
                << "{" << statement_placeholder(loop_body) << "}" << not_done
-               << " = " << loop_next << "(&" << istart << ", &" << iend << ");"
+               << " = GOMP_loop_" << schedule_name << "_next(&" << istart << ", &" << iend << ");"
                << "}" << lastprivate_code
                << statement_placeholder(reduction_code)
                << statement_placeholder(barrier_code);
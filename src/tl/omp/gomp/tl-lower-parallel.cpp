@@ -34,9 +34,85 @@
 
 namespace TL { namespace GOMP {
 
+namespace
+{
+    // Returns the worksharing of a combined construct (e.g. 'parallel for')
+    // or a null tree if the parallel is not a combined construct
+    Nodecl::NodeclBase get_combined_worksharing(Nodecl::NodeclBase n)
+    {
+        while (!n.is_null())
+        {
+            if (n.is<Nodecl::List>())
+            {
+                Nodecl::List l = n.as<Nodecl::List>();
+                if (l.size() != 1)
+                    return Nodecl::NodeclBase::null();
+                n = l.front();
+            }
+            else if (n.is<Nodecl::Context>())
+            {
+                n = n.as<Nodecl::Context>().get_in_context();
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        Nodecl::List environment;
+        if (n.is<Nodecl::OpenMP::For>())
+            environment = n.as<Nodecl::OpenMP::For>().get_environment().as<Nodecl::List>();
+        else if (n.is<Nodecl::OpenMP::Sections>())
+            environment = n.as<Nodecl::OpenMP::Sections>().get_environment().as<Nodecl::List>();
+        else
+            return Nodecl::NodeclBase::null();
+
+        if (environment.find_first<Nodecl::OpenMP::CombinedWithParallel>().is_null())
+            return Nodecl::NodeclBase::null();
+
+        return n;
+    }
+}
+
 void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
 {
     Nodecl::NodeclBase statements = construct.get_statements();
+
+    // The work share of a combined construct is started along with the
+    // team, so its arguments are computed before lowering the worksharing
+    Nodecl::NodeclBase combined_worksharing = get_combined_worksharing(statements);
+    Source combined_arguments;
+    std::string combined_loop_schedule;
+    if (combined_worksharing.is<Nodecl::OpenMP::For>())
+    {
+        Nodecl::OpenMP::For for_construct = combined_worksharing.as<Nodecl::OpenMP::For>();
+        Nodecl::List for_environment = for_construct.get_environment().as<Nodecl::List>();
+
+        TL::ForStatement for_statement(for_construct.get_loop().as<Nodecl::Context>().
+                get_in_context().as<Nodecl::List>().front().as<Nodecl::ForStatement>());
+
+        combined_loop_schedule = GOMP::get_schedule_entry_point_name(
+                for_environment,
+                _lowering->has_taskloop_and_nonmonotonic());
+
+        combined_arguments
+            << as_expression(for_statement.get_lower_bound().shallow_copy()) << ", "
+            << "1 + (" << as_expression(for_statement.get_upper_bound().shallow_copy()) << "), "
+            << as_expression(for_statement.get_step().shallow_copy());
+
+        if (combined_loop_schedule != "runtime")
+        {
+            Nodecl::OpenMP::Schedule schedule = for_environment.find_first<Nodecl::OpenMP::Schedule>();
+            combined_arguments << ", " << as_expression(schedule.get_chunk().shallow_copy());
+        }
+    }
+    else if (combined_worksharing.is<Nodecl::OpenMP::Sections>())
+    {
+        combined_arguments
+            << combined_worksharing.as<Nodecl::OpenMP::Sections>().get_sections().as<Nodecl::List>().size();
+    }
+    _combined_worksharing = combined_worksharing;
+
     walk(statements);
     statements = construct.get_statements(); // Should not be necessary
 
@@ -288,6 +364,12 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
 
     // Spawn threads
     Source num_threads_src;
+    Nodecl::OpenMP::If if_clause = environment.find_first<Nodecl::OpenMP::If>();
+    if (!if_clause.is_null())
+    {
+        // A team of one thread is created when the condition does not hold
+        num_threads_src << "(" << as_expression(if_clause.get_condition().shallow_copy()) << ") ? ";
+    }
     if (num_threads.is_null())
     {
         num_threads_src << "0";
@@ -296,6 +378,10 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
     {
         num_threads_src << as_expression(num_threads.shallow_copy());
     }
+    if (!if_clause.is_null())
+    {
+        num_threads_src << " : 1";
+    }
 
     Source setup_data;
 
@@ -317,14 +403,43 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
             ;
     }
 
+    Source entry_point, entry_point_arguments;
+    if (combined_worksharing.is<Nodecl::OpenMP::For>())
+    {
+        entry_point << "GOMP_parallel_loop_" << combined_loop_schedule;
+        entry_point_arguments << ", " << combined_arguments;
+    }
+    else if (combined_worksharing.is<Nodecl::OpenMP::Sections>())
+    {
+        entry_point << "GOMP_parallel_sections";
+        entry_point_arguments << ", " << combined_arguments;
+    }
+    else
+    {
+        entry_point << "GOMP_parallel";
+    }
+
     Source fork_call;
-    fork_call
-        << setup_data
-        << "GOMP_parallel_start((void(*)(void*))"
-        <<     as_symbol(outline_function) << ", &" << as_symbol(outline_data) << ", " << num_threads_src << ");"
-        << as_symbol(outline_function) << "(&" << as_symbol(outline_data) << ");"
-        << "GOMP_parallel_end();"
-        ;
+    fork_call << setup_data;
+    if (_lowering->has_combined_entry_points())
+    {
+        // The encountering thread joins the team and waits for it inside the runtime
+        fork_call
+            << entry_point << "((void(*)(void*))"
+            <<     as_symbol(outline_function) << ", &" << as_symbol(outline_data) << ", " << num_threads_src
+            <<     entry_point_arguments << ", 0);"
+            ;
+    }
+    else
+    {
+        fork_call
+            << entry_point << "_start((void(*)(void*))"
+            <<     as_symbol(outline_function) << ", &" << as_symbol(outline_data) << ", " << num_threads_src
+            <<     entry_point_arguments << ");"
+            << as_symbol(outline_function) << "(&" << as_symbol(outline_data) << ");"
+            << "GOMP_parallel_end();"
+            ;
+    }
 
     Nodecl::NodeclBase fork_call_tree = fork_call.parse_statement(construct);
 
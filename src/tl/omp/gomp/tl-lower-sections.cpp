@@ -0,0 +1,225 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-lowering-visitor.hpp"
+#include "tl-lowering-utils.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-counters.hpp"
+
+#include "cxx-diagnostic.h"
+
+namespace TL { namespace GOMP {
+
+void LoweringVisitor::visit(const Nodecl::OpenMP::Sections& construct)
+{
+    // The work share of a combined 'parallel sections' has already been
+    // started by GOMP_parallel_sections when the team was created
+    bool is_combined_sections = (construct == _combined_worksharing);
+    _combined_worksharing = Nodecl::NodeclBase::null();
+
+    Nodecl::NodeclBase sections = construct.get_sections();
+    walk(sections);
+    Nodecl::List section_list = construct.get_sections().as<Nodecl::List>();
+
+    Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+
+    if (!environment.find_first<Nodecl::OpenMP::Reduction>().is_null())
+    {
+        fatal_printf_at(construct.get_locus(),
+                        "reductions not yet implemented");
+    }
+
+    TL::ObjectList<TL::Symbol> private_symbols;
+    TL::ObjectList<TL::Symbol> firstprivate_symbols;
+    TL::ObjectList<TL::Symbol> lastprivate_symbols;
+    {
+        TL::ObjectList<TL::Symbol> tmp = GOMP::get_data_sharing_symbols<Nodecl::OpenMP::Private>(environment);
+        private_symbols.insert(tmp);
+
+        tmp = GOMP::get_data_sharing_symbols<Nodecl::OpenMP::Firstprivate>(environment);
+        private_symbols.insert(tmp);
+        firstprivate_symbols.insert(tmp);
+
+        tmp = GOMP::get_data_sharing_symbols<Nodecl::OpenMP::Lastprivate>(environment);
+        private_symbols.insert(tmp);
+        lastprivate_symbols.insert(tmp);
+
+        tmp = GOMP::get_data_sharing_symbols<Nodecl::OpenMP::FirstLastprivate>(environment);
+        private_symbols.insert(tmp);
+        firstprivate_symbols.insert(tmp);
+        lastprivate_symbols.insert(tmp);
+    }
+
+    Nodecl::OpenMP::BarrierAtEnd barrier_at_end = environment.find_first<Nodecl::OpenMP::BarrierAtEnd>();
+
+    Source sections_construct;
+    Nodecl::NodeclBase stmt_placeholder;
+    sections_construct
+        << "{"
+        << statement_placeholder(stmt_placeholder)
+        << "}";
+
+    Nodecl::NodeclBase sections_construct_tree = sections_construct.parse_statement(construct);
+
+    Nodecl::Utils::SimpleSymbolMap symbol_map;
+
+    TL::Scope block_scope = stmt_placeholder.retrieve_context();
+    for (TL::ObjectList<TL::Symbol>::iterator it = private_symbols.begin();
+            it != private_symbols.end();
+            it++)
+    {
+        TL::Symbol new_private_sym = GOMP::new_private_symbol(*it, block_scope);
+
+        symbol_map.add_map(*it, new_private_sym);
+
+        if (firstprivate_symbols.contains(*it))
+        {
+            if (!new_private_sym.get_type().is_array())
+            {
+                new_private_sym.set_value(it->make_nodecl(/* set_ref_type */ true));
+            }
+            else
+            {
+                Source init_array;
+                // FIXME - Use assignment instead
+                init_array
+                    << "__builtin_memcpy(" << as_symbol(new_private_sym) << ","
+                    <<                        as_symbol(*it)
+                    <<                        ", sizeof(" << as_symbol(*it) << "));"
+                    ;
+
+                Nodecl::NodeclBase init_array_tree = init_array.parse_statement(stmt_placeholder);
+                stmt_placeholder.prepend_sibling(init_array_tree);
+            }
+        }
+
+        CXX_LANGUAGE()
+        {
+            stmt_placeholder.prepend_sibling(
+                    Nodecl::CxxDef::make(
+                        /* context */ Nodecl::NodeclBase::null(),
+                        new_private_sym));
+        }
+    }
+
+    // The lexically last section updates the lastprivate variables
+    Source lastprivate_code;
+    for (TL::ObjectList<TL::Symbol>::iterator it = lastprivate_symbols.begin();
+            it != lastprivate_symbols.end();
+            it++)
+    {
+        if (!it->get_type().is_array())
+        {
+            lastprivate_code << as_symbol(*it) << "=" << as_symbol(symbol_map.map(*it)) << ";"
+                ;
+        }
+        else
+        {
+            lastprivate_code
+                << "__builtin_memcpy(" << as_symbol(*it) << "," << as_symbol(symbol_map.map(*it))
+                << "                 , sizeof(" << as_type(it->get_type().no_ref()) << "));"
+                ;
+        }
+    }
+
+    Source current_section;
+    {
+        TL::Counter &private_num = TL::CounterManager::get_counter("gomp-omp-privates");
+        current_section << "section_" << (int)private_num;
+        private_num++;
+    }
+
+    int num_sections = section_list.size();
+    TL::ObjectList<Nodecl::NodeclBase> section_placeholders(num_sections);
+
+    // GOMP numbers the sections from 1. A 0 means that there is no more work
+    Source switch_cases;
+    for (int i = 0; i < num_sections; i++)
+    {
+        switch_cases
+            << "case " << (i + 1) << ":"
+            << "{"
+            <<    statement_placeholder(section_placeholders[i])
+            <<    (i == num_sections - 1 ? lastprivate_code : Source())
+            <<    "break;"
+            << "}"
+            ;
+    }
+
+    Source sections_start, sections_end;
+    if (is_combined_sections)
+    {
+        sections_start << "GOMP_sections_next()";
+    }
+    else
+    {
+        sections_start << "GOMP_sections_start(" << num_sections << ")";
+    }
+
+    if (barrier_at_end.is_null())
+    {
+        sections_end << "GOMP_sections_end_nowait();";
+    }
+    else
+    {
+        sections_end << "GOMP_sections_end();";
+    }
+
+    Source sections_loop;
+    sections_loop
+        << "unsigned int " << current_section << " = " << sections_start << ";"
+        << "while (" << current_section << " != 0)"
+        << "{"
+        <<    "switch (" << current_section << ")"
+        <<    "{"
+        <<       switch_cases
+        <<       "default: __builtin_abort();"
+        <<    "}"
+        <<    current_section << " = GOMP_sections_next();"
+        << "}"
+        << sections_end
+        ;
+
+    Nodecl::NodeclBase sections_loop_tree = sections_loop.parse_statement(stmt_placeholder);
+    stmt_placeholder.prepend_sibling(sections_loop_tree);
+
+    int i = 0;
+    for (Nodecl::List::iterator it = section_list.begin();
+            it != section_list.end();
+            it++, i++)
+    {
+        Nodecl::OpenMP::Section section = it->as<Nodecl::OpenMP::Section>();
+
+        Nodecl::NodeclBase new_statements = Nodecl::Utils::deep_copy(section.get_statements(),
+                section_placeholders[i], symbol_map);
+        section_placeholders[i].replace(new_statements);
+    }
+
+    construct.replace(sections_construct_tree);
+}
+
+} }
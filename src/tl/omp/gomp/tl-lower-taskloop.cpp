@@ -0,0 +1,403 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-counters.hpp"
+#include "tl-lowering-visitor.hpp"
+#include "tl-lowering-utils.hpp"
+#include "tl-symbol-utils.hpp"
+#include "cxx-diagnostic.h"
+
+
+namespace TL { namespace GOMP {
+
+void LoweringVisitor::visit(const Nodecl::OpenMP::TaskLoop& construct)
+{
+    Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+
+    ERROR_CONDITION(!construct.get_loop().is<Nodecl::ForStatement>(), "Unexpected node", 0);
+    TL::ForStatement for_statement(construct.get_loop().as<Nodecl::ForStatement>());
+
+    Nodecl::NodeclBase statements = for_statement.get_statement();
+    walk(statements);
+    statements = for_statement.get_statement(); // Should not be necessary
+
+    if (!_lowering->has_taskloop_and_nonmonotonic())
+    {
+        error_printf_at(construct.get_locus(),
+                "GOMP_taskloop requires a libgomp from GCC 6 or newer (see 'gomp_version')\n");
+        return;
+    }
+
+    if (!environment.find_first<Nodecl::OpenMP::Reduction>().is_null()
+            || !environment.find_first<Nodecl::OpenMP::TaskReduction>().is_null())
+    {
+        fatal_printf_at(construct.get_locus(),
+                        "reductions not yet implemented");
+    }
+
+    TL::Symbol induction_var = for_statement.get_induction_variable();
+    TL::Type induction_var_type = induction_var.get_type().no_ref();
+
+    TL::ObjectList<TL::Symbol> shared_symbols = GOMP::get_data_sharing_symbols<Nodecl::OpenMP::Shared>(environment);
+    TL::ObjectList<TL::Symbol> private_symbols = GOMP::get_data_sharing_symbols<Nodecl::OpenMP::Private>(environment);
+    TL::ObjectList<TL::Symbol> firstprivate_symbols = GOMP::get_data_sharing_symbols<Nodecl::OpenMP::Firstprivate>(environment);
+
+    // The induction variable is always private
+    shared_symbols = shared_symbols.not_find(induction_var);
+    firstprivate_symbols = firstprivate_symbols.not_find(induction_var);
+    private_symbols.insert(induction_var);
+
+    TL::ObjectList<TL::Symbol> all_symbols_passed; // Set of all symbols passed in the outline
+    all_symbols_passed.insert(shared_symbols);
+    all_symbols_passed.insert(firstprivate_symbols);
+
+    // Add the VLA symbols
+    {
+        TL::ObjectList<TL::Symbol> vla_symbols;
+        for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols_passed.begin();
+                it != all_symbols_passed.end();
+                it++)
+        {
+            GOMP::gather_vla_symbols(*it, vla_symbols);
+        }
+
+        // VLA symbols are always firstprivate
+        firstprivate_symbols.insert(vla_symbols);
+
+        // We want all the gathered VLA symbols be the first ones
+        vla_symbols.insert(all_symbols_passed);
+        all_symbols_passed = vla_symbols;
+    }
+
+    // The runtime stores the bounds of each chunk in the first two fields
+    // of the data of the task, so they must come before any other field
+    bool is_unsigned_loop = induction_var_type.is_unsigned_integral()
+        && induction_var_type.get_size() >= TL::Type::get_long_int_type().get_size();
+    TL::Type bounds_type = is_unsigned_loop
+        ? TL::Type::get_unsigned_long_long_int_type()
+        : TL::Type::get_long_int_type();
+
+    TL::Scope current_scope = construct.retrieve_context();
+    TL::Symbol chunk_start = GOMP::new_private_symbol("taskloop_start", bounds_type, SK_VARIABLE, current_scope);
+    TL::Symbol chunk_end = GOMP::new_private_symbol("taskloop_end", bounds_type, SK_VARIABLE, current_scope);
+    {
+        TL::ObjectList<TL::Symbol> tmp;
+        tmp.append(chunk_start);
+        tmp.append(chunk_end);
+        firstprivate_symbols.insert(tmp);
+
+        tmp.insert(all_symbols_passed);
+        all_symbols_passed = tmp;
+    }
+
+    TL::Symbol enclosing_function = Nodecl::Utils::get_enclosing_function(construct);
+    std::string outline_function_name;
+    {
+        TL::Counter &outline_num = TL::CounterManager::get_counter("gomp-omp-outline");
+        std::stringstream ss;
+        ss << "_ol_" << enclosing_function.get_name() << "_" << (int)outline_num;
+        outline_function_name = ss.str();
+        outline_num++;
+    }
+
+    TL::Type outline_struct = GOMP::create_outline_struct_task(
+            all_symbols_passed,
+            firstprivate_symbols,
+            enclosing_function,
+            construct.get_locus());
+
+    CXX_LANGUAGE()
+    {
+        Nodecl::Utils::prepend_to_enclosing_top_level_location(
+                construct,
+                Nodecl::CxxDef::make(
+                    /* context */ Nodecl::NodeclBase::null(),
+                    outline_struct.get_symbol()
+                    )
+                );
+    }
+
+    std::string ol_data_name;
+    {
+        TL::Counter &outline_num = TL::CounterManager::get_counter("gomp-omp-outline-data");
+
+        std::stringstream ss;
+        ss << "ol_data_" << (int)outline_num;
+        ol_data_name = ss.str();
+
+        outline_num++;
+    }
+
+    TL::Symbol outline_data = current_scope.new_symbol(ol_data_name);
+    outline_data.get_internal_symbol()->kind = SK_VARIABLE;
+    outline_data.get_internal_symbol()->type_information = outline_struct.get_internal_type();
+    symbol_entity_specs_set_is_user_declared(outline_data.get_internal_symbol(), 1);
+
+    TL::ObjectList<std::string> parameter_names;
+    TL::ObjectList<TL::Type> parameter_types;
+
+    parameter_names.append(ol_data_name);
+    parameter_types.append(outline_struct.get_pointer_to());
+
+    TL::Symbol outline_function = SymbolUtils::new_function_symbol(
+            enclosing_function,
+            outline_function_name,
+            TL::Type::get_void_type(),
+            parameter_names,
+            parameter_types);
+
+    Nodecl::NodeclBase outline_function_code, outline_function_stmt;
+    SymbolUtils::build_empty_body_for_function(outline_function,
+            outline_function_code,
+            outline_function_stmt);
+
+    Nodecl::Utils::SimpleSymbolMap symbol_map;
+
+    TL::Scope block_scope = outline_function_stmt.retrieve_context();
+
+    TL::Symbol ol_data_in_outline = block_scope.get_symbol_from_name(ol_data_name);
+    ERROR_CONDITION(!ol_data_in_outline.is_valid(), "Invalid symbol", 0);
+
+    for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols_passed.begin();
+            it != all_symbols_passed.end();
+            it++)
+    {
+        TL::Symbol new_shared_sym = block_scope.new_symbol(it->get_name());
+        new_shared_sym.get_internal_symbol()->kind = SK_VARIABLE;
+        new_shared_sym.get_internal_symbol()->type_information = lvalue_ref(
+                it->get_internal_symbol()->type_information);
+        symbol_entity_specs_set_is_user_declared(
+                new_shared_sym.get_internal_symbol(),
+                1);
+
+        Source init_ref_src;
+        if (firstprivate_symbols.contains(*it))
+            init_ref_src << as_symbol(ol_data_in_outline) << "->" << it->get_name();
+        else
+            init_ref_src << "*(" << as_symbol(ol_data_in_outline) << "->" << it->get_name() << ")";
+        Nodecl::NodeclBase init_ref =
+            init_ref_src.parse_expression(block_scope);
+        new_shared_sym.set_value(init_ref);
+
+        symbol_map.add_map(*it, new_shared_sym);
+
+        CXX_LANGUAGE()
+        {
+            outline_function_stmt.prepend_sibling(
+                    Nodecl::CxxDef::make(
+                        /* context */ Nodecl::NodeclBase::null(),
+                        new_shared_sym));
+        }
+    }
+
+    for (TL::ObjectList<TL::Symbol>::iterator it = private_symbols.begin();
+            it != private_symbols.end();
+            it++)
+    {
+        // They are to be found in the struct
+        if (firstprivate_symbols.contains(*it))
+            continue;
+
+        TL::Symbol new_private_sym = GOMP::new_private_symbol(*it, block_scope);
+
+        new_private_sym.get_internal_symbol()->type_information = ::type_deep_copy(
+                new_private_sym.get_internal_symbol()->type_information,
+                outline_function_stmt.retrieve_context().get_decl_context(),
+                symbol_map.get_symbol_map());
+
+        symbol_map.add_map(*it, new_private_sym);
+
+        CXX_LANGUAGE()
+        {
+            outline_function_stmt.prepend_sibling(
+                    Nodecl::CxxDef::make(
+                        /* context */ Nodecl::NodeclBase::null(),
+                        new_private_sym));
+        }
+    }
+
+    // Each task executes the chunk [start, end) of the iteration space
+    TL::Symbol private_induction_var = symbol_map.map(induction_var);
+    Nodecl::NodeclBase outline_step = Nodecl::Utils::deep_copy(for_statement.get_step(),
+            outline_function_stmt,
+            symbol_map);
+
+    Nodecl::NodeclBase loop_body;
+    Source chunk_loop;
+    chunk_loop
+        << "for (" << as_symbol(private_induction_var) << " = " << as_symbol(symbol_map.map(chunk_start)) << "; "
+        <<            as_symbol(private_induction_var) << " < " << as_symbol(symbol_map.map(chunk_end)) << "; "
+        <<            as_symbol(private_induction_var) << " += " << as_expression(outline_step) << ")"
+        << "{"
+        <<    statement_placeholder(loop_body)
+        << "}"
+        ;
+
+    Nodecl::NodeclBase chunk_loop_tree = chunk_loop.parse_statement(outline_function_stmt);
+    outline_function_stmt.prepend_sibling(chunk_loop_tree);
+
+    Nodecl::NodeclBase new_statements = Nodecl::Utils::deep_copy(statements,
+            loop_body,
+            symbol_map);
+    loop_body.replace(new_statements);
+
+    Nodecl::Utils::prepend_to_enclosing_top_level_location(construct, outline_function_code);
+
+    Source setup_data;
+    CXX_LANGUAGE()
+    {
+        setup_data << as_statement(
+                Nodecl::CxxDef::make(
+                    /* context */ Nodecl::NodeclBase::null(),
+                    outline_data))
+            ;
+    }
+
+    for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols_passed.begin();
+            it != all_symbols_passed.end();
+            it++)
+    {
+        // Set by the runtime
+        if (*it == chunk_start || *it == chunk_end)
+            continue;
+
+        if (firstprivate_symbols.contains(*it))
+        {
+            setup_data
+                << as_symbol(outline_data) << "." << it->get_name() << " = " << as_symbol(*it) << ";"
+                ;
+        }
+        else
+        {
+            setup_data
+                << as_symbol(outline_data) << "." << it->get_name() << " = &" << as_symbol(*it) << ";"
+                ;
+        }
+    }
+
+    // Task flags
+    std::string task_flags_name;
+    {
+        TL::Counter &c = TL::CounterManager::get_counter("gomp-omp-task-flags");
+
+        std::stringstream ss;
+        ss << "gomp_task_flags_" << (int)c;
+        task_flags_name = ss.str();
+
+        c++;
+    }
+
+    // The implicit taskgroup is replaced by the taskwait that follows the construct
+    Source set_task_flags;
+    set_task_flags << task_flags_name << " |= GOMP_TASK_NOGROUP;";
+
+    if (is_unsigned_loop)
+    {
+        set_task_flags << task_flags_name << " |= GOMP_TASK_UP;";
+    }
+    if (!environment.find_first<Nodecl::OpenMP::Untied>().is_null())
+    {
+        set_task_flags << task_flags_name << " |= GOMP_TASK_UNTIED;";
+    }
+    Nodecl::OpenMP::Final final_clause = environment.find_first<Nodecl::OpenMP::Final>();
+    if (!final_clause.is_null())
+    {
+        set_task_flags
+            << "if (" << as_expression(final_clause.get_condition().shallow_copy()) << ")"
+            <<    task_flags_name << " |= GOMP_TASK_FINAL;"
+            ;
+    }
+    if (!environment.find_first<Nodecl::OpenMP::Mergeable>().is_null())
+    {
+        set_task_flags << task_flags_name << " |= GOMP_TASK_MERGEABLE;";
+    }
+    Nodecl::OpenMP::If if_clause = environment.find_first<Nodecl::OpenMP::If>();
+    if (if_clause.is_null())
+    {
+        set_task_flags << task_flags_name << " |= GOMP_TASK_IF;";
+    }
+    else
+    {
+        set_task_flags
+            << "if (" << as_expression(if_clause.get_condition().shallow_copy()) << ")"
+            <<    task_flags_name << " |= GOMP_TASK_IF;"
+            ;
+    }
+
+    Source priority;
+    Nodecl::OpenMP::Priority priority_clause = environment.find_first<Nodecl::OpenMP::Priority>();
+    if (priority_clause.is_null())
+    {
+        priority << "0";
+    }
+    else
+    {
+        set_task_flags << task_flags_name << " |= GOMP_TASK_PRIORITY;";
+        priority << as_expression(priority_clause.get_priority().shallow_copy());
+    }
+
+    // When the GRAINSIZE flag is set the num_tasks argument is the grainsize.
+    // A 0 lets the runtime decide
+    Source num_tasks;
+    Nodecl::OpenMP::Grainsize grainsize_clause = environment.find_first<Nodecl::OpenMP::Grainsize>();
+    Nodecl::OpenMP::NumTasks num_tasks_clause = environment.find_first<Nodecl::OpenMP::NumTasks>();
+    if (!grainsize_clause.is_null())
+    {
+        set_task_flags << task_flags_name << " |= GOMP_TASK_GRAINSIZE;";
+        num_tasks << as_expression(grainsize_clause.get_grainsize().shallow_copy());
+    }
+    else if (!num_tasks_clause.is_null())
+    {
+        num_tasks << as_expression(num_tasks_clause.get_num_tasks().shallow_copy());
+    }
+    else
+    {
+        num_tasks << "0";
+    }
+
+    Source taskloop_code;
+    taskloop_code
+        << setup_data
+        << "unsigned int " << task_flags_name << " = 0;"
+        << set_task_flags
+        << (is_unsigned_loop ? "GOMP_taskloop_ull" : "GOMP_taskloop") << "((void(*)(void*))"
+        <<     as_symbol(outline_function) << ", &" << as_symbol(outline_data) << ", "
+        <<     "(void(*)(void*,void*))0, "
+        <<     outline_struct.get_size() << ", " << outline_struct.get_alignment_of() << ", "
+        <<     task_flags_name << ", " << num_tasks << ", " << priority << ", "
+        <<     as_expression(for_statement.get_lower_bound().shallow_copy()) << ", "
+        <<     "1 + (" << as_expression(for_statement.get_upper_bound().shallow_copy()) << "), "
+        <<     as_expression(for_statement.get_step().shallow_copy())
+        << ");"
+        ;
+
+    Nodecl::NodeclBase taskloop_code_tree = taskloop_code.parse_statement(construct);
+
+    construct.replace(taskloop_code_tree);
+}
+
+} }
@@ -33,6 +33,7 @@
 #include "tl-nodecl.hpp"
 #include "tl-nodecl-utils.hpp"
 #include "cxx-cexpr.h"
+#include "cxx-diagnostic.h"
 
 #include <sstream>
 
@@ -258,4 +259,50 @@ TL::Type GOMP::create_outline_struct_task(
     return new_class_symbol.get_user_defined_type();
 }
 
+std::string GOMP::get_schedule_entry_point_name(Nodecl::List environment,
+        bool allow_nonmonotonic)
+{
+    Nodecl::OpenMP::Schedule schedule = environment.find_first<Nodecl::OpenMP::Schedule>();
+    ERROR_CONDITION(schedule.is_null(), "Schedule tree is missing", 0);
+
+    std::string kind = schedule.get_text();
+
+    // Schedules may be prefixed with 'ompss_', 'omp_' and 'openmp_'
+    std::string valid_prefixes[] = { "ompss_", "omp_", "openmp_" };
+    for (unsigned int i = 0; i < sizeof(valid_prefixes) / sizeof(valid_prefixes[0]); i++)
+    {
+        if (kind.substr(0, valid_prefixes[i].size()) == valid_prefixes[i])
+        {
+            kind = kind.substr(valid_prefixes[i].size());
+            break;
+        }
+    }
+
+    // GOMP maps auto to static
+    if (kind == "auto")
+        kind = "static";
+
+    if (kind != "static"
+            && kind != "dynamic"
+            && kind != "guided"
+            && kind != "runtime")
+    {
+        error_printf_at(schedule.get_locus(),
+                "'%s' is not a valid OpenMP schedule\n",
+                schedule.get_text().c_str());
+        kind = "static";
+    }
+
+    Nodecl::OpenMP::ScheduleModifier modifier = environment.find_first<Nodecl::OpenMP::ScheduleModifier>();
+    if (allow_nonmonotonic
+            && !modifier.is_null()
+            && modifier.get_text() == "nonmonotonic"
+            && (kind == "dynamic" || kind == "guided"))
+    {
+        kind = "nonmonotonic_" + kind;
+    }
+
+    return kind;
+}
+
 } // TL
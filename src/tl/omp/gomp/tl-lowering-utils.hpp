@@ -29,6 +29,7 @@
 #define TL_LOWERING_UTILS_HPP
 
 #include "tl-symbol.hpp"
+#include "tl-nodecl.hpp"
 
 namespace TL { namespace GOMP {
 
@@ -52,6 +53,27 @@ namespace TL { namespace GOMP {
             const TL::ObjectList<TL::Symbol>& firstprivate_symbols,
             TL::Symbol enclosing_function,
             const locus_t* locus);
+
+    // Returns the symbols of all the data-sharings of a kind in the environment
+    template <typename DataSharing>
+    TL::ObjectList<TL::Symbol> get_data_sharing_symbols(Nodecl::List environment)
+    {
+        TL::ObjectList<DataSharing> data_sharing_list = environment.find_all<DataSharing>();
+        if (data_sharing_list.empty())
+            return TL::ObjectList<TL::Symbol>();
+
+        return data_sharing_list
+            .template map<Nodecl::NodeclBase>(&DataSharing::get_symbols)
+            .template map<Nodecl::List>(&Nodecl::NodeclBase::as<Nodecl::List>)
+            .template map<TL::ObjectList<Nodecl::NodeclBase> >(&Nodecl::List::to_object_list)
+            .reduction(TL::append_two_lists<Nodecl::NodeclBase>)
+            .template map<TL::Symbol>(&Nodecl::NodeclBase::get_symbol);
+    }
+
+    // Returns the schedule as named by the GOMP loop entry points
+    // (e.g. 'dynamic' or 'nonmonotonic_dynamic')
+    std::string get_schedule_entry_point_name(Nodecl::List environment,
+            bool allow_nonmonotonic);
 } }
 
 #endif // TL_LOWERING_UTILS_HPP
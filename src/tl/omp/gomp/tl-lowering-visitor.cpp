@@ -31,7 +31,7 @@
 namespace TL { namespace GOMP {
 
 LoweringVisitor::LoweringVisitor(Lowering* lowering)
-    : _lowering(lowering)
+    : _lowering(lowering), _combined_worksharing()
 {
 }
 
@@ -44,11 +44,6 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::FlushMemory& construct)
     error_printf_at(construct.get_locus(), " OpenMP FlushMemory construct not yet implemented\n");
 }
 
-void LoweringVisitor::visit(const Nodecl::OpenMP::Sections& construct)
-{
-    error_printf_at(construct.get_locus(), " OpenMP Sections construct not yet implemented\n");
-}
-
 void LoweringVisitor::visit(const Nodecl::OpenMP::Workshare& construct)
 {
     error_printf_at(construct.get_locus(), " OpenMP Workshare construct not yet implemented\n");
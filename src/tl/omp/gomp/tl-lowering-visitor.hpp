@@ -52,6 +52,7 @@ class LoweringVisitor : public Nodecl::ExhaustiveVisitor<void>
         virtual void visit(const Nodecl::OpenMP::Workshare& construct);
         virtual void visit(const Nodecl::OmpSs::TargetDeclaration& construct);
         virtual void visit(const Nodecl::OpenMP::Task& construct);
+        virtual void visit(const Nodecl::OpenMP::TaskLoop& construct);
         virtual void visit(const Nodecl::OmpSs::TaskCall& construct);
         virtual void visit(const Nodecl::OmpSs::TaskExpression& task_expr);
         virtual void visit(const Nodecl::OpenMP::Taskwait& construct);
@@ -64,6 +65,10 @@ class LoweringVisitor : public Nodecl::ExhaustiveVisitor<void>
         Nodecl::NodeclBase emit_barrier(const Nodecl::NodeclBase& construct);
 
         Lowering* _lowering;
+
+        // Worksharing of a combined construct (e.g. 'parallel for') whose
+        // work share is started along with the team of threads
+        Nodecl::NodeclBase _combined_worksharing;
 };
 
 } }
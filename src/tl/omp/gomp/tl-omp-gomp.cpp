@@ -31,7 +31,7 @@
 namespace TL { namespace GOMP {
 
     Lowering::Lowering()
-        : _simd_reductions_knc(false)
+        : _simd_reductions_knc(false), _gomp_version(600)
     {
         set_phase_name("GOMP lowering");
         set_phase_description("This phase lowers from Mercurium parallel IR into calls to the "
@@ -41,6 +41,12 @@ namespace TL { namespace GOMP {
                 "Disables OpenMP transformation",
                 _openmp_dry_run,
                 "0");
+
+        register_parameter("gomp_version",
+                "Version of GCC whose libgomp is targeted (e.g. '4.8', '4.9' or '6'). "
+                "It determines which runtime entry points can be used",
+                _gomp_version_str,
+                "6").connect(std::bind(&Lowering::set_gomp_version, this, std::placeholders::_1));
     }
 
     void Lowering::pre_run(DTO& dto)
@@ -65,6 +71,29 @@ namespace TL { namespace GOMP {
     void Lowering::phase_cleanup(DTO& data_flow)
     {
     }
+
+    void Lowering::set_gomp_version(const std::string& str)
+    {
+        int major = 0, minor = 0;
+        int n = sscanf(str.c_str(), "%d.%d", &major, &minor);
+        if (n < 1 || major <= 0 || minor < 0)
+        {
+            std::cerr << "Invalid value '" << str << "' for gomp_version. Assuming '6'" << std::endl;
+            major = 6;
+            minor = 0;
+        }
+        _gomp_version = major * 100 + minor;
+    }
+
+    bool Lowering::has_combined_entry_points() const
+    {
+        return _gomp_version >= 409;
+    }
+
+    bool Lowering::has_taskloop_and_nonmonotonic() const
+    {
+        return _gomp_version >= 600;
+    }
 } }
 
 
@@ -46,6 +46,11 @@ namespace TL { namespace GOMP {
 
             bool simd_reductions_knc() const;
 
+            //! GOMP_parallel, GOMP_parallel_loop_* and GOMP_parallel_sections (GCC 4.9)
+            bool has_combined_entry_points() const;
+            //! GOMP_loop_nonmonotonic_* and GOMP_taskloop (GCC 6)
+            bool has_taskloop_and_nonmonotonic() const;
+
         private:
             std::string _openmp_dry_run;
 
@@ -56,6 +61,11 @@ namespace TL { namespace GOMP {
             std::string _simd_reductions_knc_str;
             bool _simd_reductions_knc;
             void set_simd_reduction_knc(const std::string &str);
+
+            // Version of libgomp as major * 100 + minor
+            std::string _gomp_version_str;
+            int _gomp_version;
+            void set_gomp_version(const std::string &str);
     };
 
 } }
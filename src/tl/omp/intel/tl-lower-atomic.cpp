@@ -0,0 +1,169 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+#include "tl-atomics.hpp"
+#include "tl-source.hpp"
+#include "tl-lowering-visitor.hpp"
+#include "tl-lowering-utils.hpp"
+#include "cxx-diagnostic.h"
+
+namespace TL { namespace Intel {
+
+    namespace
+    {
+        // Types that the GCC __atomic builtins do not support without
+        // libatomic but have an entry point in the RTL
+        std::string get_kmpc_atomic_type_name(TL::Type t)
+        {
+            t = t.no_ref();
+            if (t.is_long_double())
+                return "float10";
+            else if (t.is_complex())
+            {
+                TL::Type base = t.complex_get_base_type();
+                if (base.is_float())
+                    return "cmplx4";
+                else if (base.is_double())
+                    return "cmplx8";
+                else if (base.is_long_double())
+                    return "cmplx10";
+            }
+            return "";
+        }
+
+        // Lowers 'x op= e' using __kmpc_atomic_<type>_<op>
+        Nodecl::NodeclBase kmpc_atomic_call(Nodecl::NodeclBase stmt, TL::Symbol ident_symbol)
+        {
+            if (!stmt.is<Nodecl::ExpressionStatement>())
+                return Nodecl::NodeclBase::null();
+
+            Nodecl::NodeclBase expr = stmt.as<Nodecl::ExpressionStatement>().get_nest();
+
+            std::string op;
+            switch (expr.get_kind())
+            {
+                case NODECL_ADD_ASSIGNMENT:
+                    op = "add";
+                    break;
+                case NODECL_MINUS_ASSIGNMENT:
+                    op = "sub";
+                    break;
+                case NODECL_MUL_ASSIGNMENT:
+                    op = "mul";
+                    break;
+                case NODECL_DIV_ASSIGNMENT:
+                    op = "div";
+                    break;
+                default:
+                    return Nodecl::NodeclBase::null();
+            }
+
+            Nodecl::NodeclBase lhs = expr.as<Nodecl::AddAssignment>().get_lhs();
+            Nodecl::NodeclBase rhs = expr.as<Nodecl::AddAssignment>().get_rhs();
+
+            std::string type_name = get_kmpc_atomic_type_name(lhs.get_type());
+            if (type_name.empty())
+                return Nodecl::NodeclBase::null();
+
+            Source atomic_call;
+            atomic_call
+                << "__kmpc_atomic_" << type_name << "_" << op << "(&" << as_symbol(ident_symbol)
+                <<        ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+                <<        ", &(" << as_expression(lhs.shallow_copy()) << ")"
+                <<        ", " << as_expression(rhs.shallow_copy()) << ");"
+                ;
+
+            return atomic_call.parse_statement(stmt);
+        }
+
+        Nodecl::NodeclBase critical_atomic(Nodecl::NodeclBase stmt, TL::Symbol ident_symbol)
+        {
+            TL::Symbol lock_symbol = Intel::get_global_lock_symbol(stmt, "atomic");
+
+            Source critical_src;
+            critical_src
+                << "{"
+                <<    "__kmpc_critical(&" << as_symbol(ident_symbol)
+                <<          ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+                <<          ", &" << as_symbol(lock_symbol) << ");"
+                <<    as_statement(stmt.shallow_copy())
+                <<    "__kmpc_end_critical(&" << as_symbol(ident_symbol)
+                <<          ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+                <<          ", &" << as_symbol(lock_symbol) << ");"
+                << "}"
+                ;
+
+            return critical_src.parse_statement(stmt);
+        }
+    }
+
+    void LoweringVisitor::visit(const Nodecl::OpenMP::Atomic& construct)
+    {
+        Nodecl::List statements = construct.get_statements().as<Nodecl::List>();
+
+        walk(statements);
+
+        // Get the new statements
+        statements = construct.get_statements().as<Nodecl::List>();
+        ERROR_CONDITION(!statements[0].is<Nodecl::Context>(), "Invalid node", 0);
+        statements = statements[0].as<Nodecl::Context>().get_in_context().as<Nodecl::List>();
+
+        TL::Symbol ident_symbol;
+
+        Nodecl::List replacements;
+        for (Nodecl::List::iterator it = statements.begin(); it != statements.end(); it++)
+        {
+            Nodecl::NodeclBase stmt(*it);
+            Nodecl::NodeclBase atomic_tree = lower_atomic_statement(stmt, construct);
+            if (!atomic_tree.is_null())
+            {
+                info_printf_at(stmt.get_locus(), "'atomic' directive implemented using GCC atomic builtins\n");
+                replacements.append(atomic_tree);
+                continue;
+            }
+
+            if (!ident_symbol.is_valid())
+                ident_symbol = Intel::new_global_ident_symbol(construct);
+
+            atomic_tree = kmpc_atomic_call(stmt, ident_symbol);
+            if (!atomic_tree.is_null())
+            {
+                info_printf_at(stmt.get_locus(), "'atomic' directive implemented using Intel OpenMP RTL atomic entry points\n");
+            }
+            else
+            {
+                warn_printf_at(stmt.get_locus(),
+                        "'atomic' statement cannot be implemented efficiently: a critical region will be used instead\n");
+                atomic_tree = critical_atomic(stmt, ident_symbol);
+            }
+            replacements.append(atomic_tree);
+        }
+
+        construct.replace(replacements);
+    }
+} }
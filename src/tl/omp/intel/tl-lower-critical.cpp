@@ -0,0 +1,92 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+#include "tl-source.hpp"
+#include "tl-lowering-visitor.hpp"
+#include "tl-lowering-utils.hpp"
+#include "tl-nodecl-utils.hpp"
+
+namespace TL { namespace Intel {
+
+    void LoweringVisitor::visit(const Nodecl::OpenMP::Critical& construct)
+    {
+        Nodecl::NodeclBase statements = construct.get_statements();
+
+        walk(statements);
+
+        statements = construct.get_statements();
+
+        Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+        Nodecl::OpenMP::CriticalName critical_name = environment.find_first<Nodecl::OpenMP::CriticalName>();
+        Nodecl::OpenMP::CriticalHint critical_hint = environment.find_first<Nodecl::OpenMP::CriticalHint>();
+
+        // Unnamed critical constructs share a lock different from the one used by reductions
+        TL::Symbol lock_symbol = Intel::get_global_lock_symbol(construct,
+                critical_name.is_null() ? "unnamed" : "user_" + critical_name.get_text());
+
+        TL::Symbol ident_symbol = Intel::new_global_ident_symbol(construct);
+
+        Source critical_start;
+        if (critical_hint.is_null())
+        {
+            critical_start
+                << "__kmpc_critical(&" << as_symbol(ident_symbol)
+                <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+                <<                  ", &" << as_symbol(lock_symbol) << ");"
+                ;
+        }
+        else
+        {
+            critical_start
+                << "__kmpc_critical_with_hint(&" << as_symbol(ident_symbol)
+                <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+                <<                  ", &" << as_symbol(lock_symbol)
+                <<                  ", " << as_expression(critical_hint.get_hint().shallow_copy()) << ");"
+                ;
+        }
+
+        Nodecl::NodeclBase placeholder;
+        Source transform_code;
+        transform_code
+            << "{"
+            <<    critical_start
+            <<    statement_placeholder(placeholder)
+            <<    "__kmpc_end_critical(&" << as_symbol(ident_symbol)
+            <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+            <<                  ", &" << as_symbol(lock_symbol) << ");"
+            << "}"
+            ;
+
+        Nodecl::NodeclBase n = transform_code.parse_statement(construct);
+
+        Nodecl::NodeclBase copied_statements = Nodecl::Utils::deep_copy(statements, placeholder);
+        placeholder.replace(copied_statements);
+
+        construct.replace(n);
+    }
+} }
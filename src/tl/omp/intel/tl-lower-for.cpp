@@ -451,7 +451,7 @@ void LoweringVisitor::lower_for(const Nodecl::OpenMP::For& construct,
 
         if (callback.is_valid())
         {
-            Source master_combiner;
+            Source master_combiner, tree_master_combiner;
             TL::ObjectList<TL::Symbol> reduction_fields = reduction_pack_symbol.get_type().get_fields();
             TL::ObjectList<TL::Symbol>::iterator it_fields = reduction_fields.begin();
             for (TL::ObjectList<Nodecl::OpenMP::ReductionItem>::iterator it = reduction_items.begin();
@@ -473,6 +473,8 @@ void LoweringVisitor::lower_for(const Nodecl::OpenMP::For& construct,
 
                 master_combiner << as_expression(combiner_expr) << ";"
                     ;
+                tree_master_combiner << as_expression(combiner_expr.shallow_copy()) << ";"
+                    ;
             }
 
             Source reduction_size;
@@ -557,8 +559,8 @@ void LoweringVisitor::lower_for(const Nodecl::OpenMP::For& construct,
                             Nodecl::ObjectInit::make(array_of_data));
             }
 
-            Source reduction_src;
-            reduction_src
+            Source runtime_reduction;
+            runtime_reduction
                 << reduction_extra_pre
                 << "switch (__kmpc_reduce" << nowait << "(&" << as_symbol(ident_symbol)
                 <<               ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
@@ -581,6 +583,76 @@ void LoweringVisitor::lower_for(const Nodecl::OpenMP::For& construct,
                 << "}"
                 ;
 
+            ReductionStrategy strategy = _lowering->get_reduction_strategy(environment);
+
+            Source reduction_src;
+            if (strategy == REDUCTION_RUNTIME)
+            {
+                reduction_src << runtime_reduction;
+            }
+            else
+            {
+                // SIMD combiners do not work on a single reduction pack
+                TL::Symbol tree_callback = callback;
+                if (_lowering->simd_reductions())
+                {
+                    tree_callback = emit_callback_for_reduction_scalar(
+                            reduction_items,
+                            reduction_pack_symbol.get_type(),
+                            construct, enclosing_function);
+                }
+
+                // Unlike in a parallel there is no shared variable to keep
+                // the partials, so they are broadcast to the team
+                TL::Symbol reduction_partials_symbol = Intel::new_private_symbol("red_partials",
+                        TL::Type::get_void_type().get_pointer_to(),
+                        SK_VARIABLE,
+                        block_scope);
+                reduction_partials_symbol.set_value(
+                        const_value_to_nodecl(const_value_get_signed_int(0)));
+
+                // __kmpc_reduce already ends with a barrier but the tree does not
+                Source tree_barrier;
+                if (!barrier_at_end.is_null())
+                {
+                    tree_barrier
+                        << "__kmpc_barrier(&" << as_symbol(ident_symbol)
+                        <<               ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << "));";
+                }
+
+                Source tree_reduction;
+                tree_reduction
+                    << as_statement(Nodecl::ObjectInit::make(reduction_partials_symbol))
+                    << emit_tree_reduction(
+                            reduction_pack_symbol,
+                            reduction_partials_symbol,
+                            tree_callback,
+                            ident_symbol,
+                            tree_master_combiner,
+                            /* partials_are_shared */ false)
+                    << tree_barrier
+                    ;
+
+                if (strategy == REDUCTION_TREE)
+                {
+                    reduction_src << "{" << tree_reduction << "}";
+                }
+                else
+                {
+                    reduction_src
+                        << "if (__kmpc_bound_num_threads(&" << as_symbol(ident_symbol) << ") >= "
+                        <<         _lowering->get_tree_reduction_threshold(reduction_pack_symbol.get_type()) << ")"
+                        << "{"
+                        <<    tree_reduction
+                        << "}"
+                        << "else"
+                        << "{"
+                        <<    runtime_reduction
+                        << "}"
+                        ;
+                }
+            }
+
             Nodecl::NodeclBase reduction_tree = reduction_src.parse_statement(stmt_placeholder);
             reduction_code.prepend_sibling(reduction_tree);
         }
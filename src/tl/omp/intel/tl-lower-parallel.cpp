@@ -178,6 +178,20 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
         all_symbols_passed.insert(reduction_symbols);
     }
 
+    // Shared scratch storage for the partials of a tree reduction
+    TL::Symbol reduction_partials_symbol;
+    if (!reduction_items.empty()
+            && _lowering->get_reduction_strategy(environment) != REDUCTION_RUNTIME)
+    {
+        reduction_partials_symbol = Intel::new_private_symbol("red_partials",
+                TL::Type::get_void_type().get_pointer_to(),
+                SK_VARIABLE,
+                construct.retrieve_context());
+        reduction_partials_symbol.set_value(
+                const_value_to_nodecl(const_value_get_signed_int(0)));
+        all_symbols_passed.append(reduction_partials_symbol);
+    }
+
     TL::Type kmp_int32_type = Source("kmp_int32").parse_c_type_id(construct);
     ERROR_CONDITION(!kmp_int32_type.is_valid(), "Type kmp_int32 not in scope", 0);
 
@@ -398,7 +412,7 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
 
         if (callback.is_valid())
         {
-            Source master_combiner;
+            Source master_combiner, tree_master_combiner;
             TL::ObjectList<TL::Symbol> reduction_fields = reduction_pack_symbol.get_type().get_fields();
             TL::ObjectList<TL::Symbol>::iterator it_fields = reduction_fields.begin();
             for (TL::ObjectList<Nodecl::OpenMP::ReductionItem>::iterator it = reduction_items.begin();
@@ -420,6 +434,8 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
 
                 master_combiner << as_expression(combiner_expr) << ";"
                     ;
+                tree_master_combiner << as_expression(combiner_expr.shallow_copy()) << ";"
+                    ;
             }
 
             Source reduction_size;
@@ -504,8 +520,8 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
                             Nodecl::ObjectInit::make(array_of_data));
             }
 
-            Source reduction_src;
-            reduction_src
+            Source runtime_reduction;
+            runtime_reduction
                 << reduction_extra_pre
                 << "switch (__kmpc_reduce_nowait(&" << as_symbol(ident_symbol)
                 <<               ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
@@ -528,6 +544,51 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
                 << "}"
                 ;
 
+            Source reduction_src;
+            if (_lowering->get_reduction_strategy(environment) == REDUCTION_RUNTIME)
+            {
+                reduction_src << runtime_reduction;
+            }
+            else
+            {
+                // SIMD combiners do not work on a single reduction pack
+                TL::Symbol tree_callback = callback;
+                if (_lowering->simd_reductions())
+                {
+                    tree_callback = emit_callback_for_reduction_scalar(
+                            reduction_items,
+                            reduction_pack_symbol.get_type(),
+                            construct, enclosing_function);
+                }
+
+                Source tree_reduction = emit_tree_reduction(
+                        reduction_pack_symbol,
+                        symbol_map.map(reduction_partials_symbol),
+                        tree_callback,
+                        ident_symbol,
+                        tree_master_combiner,
+                        /* partials_are_shared */ true);
+
+                if (_lowering->get_reduction_strategy(environment) == REDUCTION_TREE)
+                {
+                    reduction_src << "{" << tree_reduction << "}";
+                }
+                else
+                {
+                    reduction_src
+                        << "if (__kmpc_bound_num_threads(&" << as_symbol(ident_symbol) << ") >= "
+                        <<         _lowering->get_tree_reduction_threshold(reduction_pack_symbol.get_type()) << ")"
+                        << "{"
+                        <<    tree_reduction
+                        << "}"
+                        << "else"
+                        << "{"
+                        <<    runtime_reduction
+                        << "}"
+                        ;
+                }
+            }
+
             Nodecl::NodeclBase reduction_tree = reduction_src.parse_statement(outline_function_stmt);
             reduction_code_list.append(reduction_tree);
         }
@@ -608,6 +669,11 @@ void LoweringVisitor::visit(const Nodecl::OpenMP::Parallel& construct)
         ;
     }
 
+    if (reduction_partials_symbol.is_valid())
+    {
+        fork_call << as_statement(Nodecl::ObjectInit::make(reduction_partials_symbol));
+    }
+
     fork_call
         << "__kmpc_fork_call(&" << as_symbol(ident_symbol) << ", "
         <<                           all_symbols_passed.size() << ", (" << as_type(kmp_micro_type) << ")"
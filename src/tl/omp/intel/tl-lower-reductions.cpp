@@ -344,6 +344,84 @@ namespace TL
         return result;
     }
 
+    TL::Source Intel::emit_tree_reduction(
+            TL::Symbol reduction_pack_symbol,
+            TL::Symbol partials_symbol,
+            TL::Symbol callback,
+            TL::Symbol ident_symbol,
+            TL::Source master_combiner,
+            bool partials_are_shared)
+    {
+        // Each partial lives in its own cache line so threads do not share lines while combining
+        const int cache_line_size = 64;
+        TL::Type pack_type = reduction_pack_symbol.get_type().no_ref();
+        int stride = ((pack_type.get_size() + cache_line_size - 1) / cache_line_size) * cache_line_size;
+
+        TL::Counter &private_num = TL::CounterManager::get_counter("intel-omp-privates");
+        Source gtid, tid, nth, slots, step;
+        gtid << "red_gtid_" << (int)private_num;
+        tid << "red_tid_" << (int)private_num;
+        nth << "red_nth_" << (int)private_num;
+        slots << "red_slots_" << (int)private_num;
+        step << "red_step_" << (int)private_num;
+        private_num++;
+
+        Source slot_of_tid, slot_of_partner;
+        slot_of_tid << "(" << as_type(pack_type.get_pointer_to()) << ")"
+            << "(" << slots << " + " << tid << " * " << stride << ")";
+        slot_of_partner << "(" << as_type(pack_type.get_pointer_to()) << ")"
+            << "(" << slots << " + (" << tid << " + " << step << ") * " << stride << ")";
+
+        Source publish_partials;
+        if (partials_are_shared)
+        {
+            publish_partials
+                << "__kmpc_barrier(&" << as_symbol(ident_symbol) << ", " << gtid << ");";
+        }
+        else
+        {
+            publish_partials
+                << "__kmpc_copyprivate(&" << as_symbol(ident_symbol) << ", " << gtid
+                <<                   ", sizeof(void*), &" << as_symbol(partials_symbol)
+                <<                   ", __kmp_copy_pointer, " << tid << " == 0);";
+        }
+
+        Source tree_reduction;
+        tree_reduction
+            << "kmp_int32 " << gtid << " = __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ");"
+            << "kmp_int32 " << tid << " = __kmpc_bound_thread_num(&" << as_symbol(ident_symbol) << ");"
+            << "kmp_int32 " << nth << " = __kmpc_bound_num_threads(&" << as_symbol(ident_symbol) << ");"
+            << "if (" << tid << " == 0)"
+            << "{"
+            <<    as_symbol(partials_symbol) << " = __builtin_malloc(" << nth << " * " << stride
+            <<                                  " + " << (cache_line_size - 1) << ");"
+            << "}"
+            << publish_partials
+            << "char* " << slots << " = (char*)(((uintptr_t)" << as_symbol(partials_symbol)
+            <<                     " + " << (cache_line_size - 1) << ") & ~(uintptr_t)" << (cache_line_size - 1) << ");"
+            << "*" << slot_of_tid << " = " << as_symbol(reduction_pack_symbol) << ";"
+            << "kmp_int32 " << step << ";"
+            // At each step the thread 'tid' combines the partial of 'tid + step'
+            << "for (" << step << " = 1; " << step << " < " << nth << "; " << step << " *= 2)"
+            << "{"
+            <<    "__kmpc_barrier(&" << as_symbol(ident_symbol) << ", " << gtid << ");"
+            <<    "if (" << tid << " % (2 * " << step << ") == 0 && " << tid << " + " << step << " < " << nth << ")"
+            <<    "{"
+            <<       "((void(*)(void*,void*))" << as_symbol(callback) << ")(" << slot_of_tid << ", " << slot_of_partner << ");"
+            <<    "}"
+            << "}"
+            // The other threads are done with the partials after the last barrier
+            << "if (" << tid << " == 0)"
+            << "{"
+            <<    as_symbol(reduction_pack_symbol) << " = *" << slot_of_tid << ";"
+            <<    master_combiner
+            <<    "__builtin_free(" << as_symbol(partials_symbol) << ");"
+            << "}"
+            ;
+
+        return tree_reduction;
+    }
+
     namespace {
 
         struct SIMDizeCombiner : Nodecl::NodeclVisitor<void>
@@ -67,6 +67,20 @@ namespace TL { namespace Intel {
             Nodecl::NodeclBase location,
             TL::Symbol current_function);
 
+    // Combines the per-thread partials stored in 'reduction_pack_symbol' in
+    // log2(nthreads) steps of pairwise combinations through 'callback'.
+    // 'partials_symbol' is a void* used as scratch storage and
+    // 'master_combiner' combines the final result into the original variables.
+    // When 'partials_are_shared' is false 'partials_symbol' is private and the
+    // storage allocated by the first thread is broadcast to the team
+    TL::Source emit_tree_reduction(
+            TL::Symbol reduction_pack_symbol,
+            TL::Symbol partials_symbol,
+            TL::Symbol callback,
+            TL::Symbol ident_symbol,
+            TL::Source master_combiner,
+            bool partials_are_shared);
+
     void update_reduction_uses(Nodecl::NodeclBase node,
             const TL::ObjectList<Nodecl::OpenMP::ReductionItem>& reduction_items,
             TL::Symbol reduction_pack_symbol);
@@ -0,0 +1,599 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-counters.hpp"
+#include "tl-source.hpp"
+#include "tl-lowering-visitor.hpp"
+#include "tl-lowering-utils.hpp"
+#include "tl-symbol-utils.hpp"
+#include "tl-nodecl-utils.hpp"
+
+namespace TL { namespace Intel {
+
+namespace
+{
+    template <typename DataSharing>
+    TL::ObjectList<TL::Symbol> get_data_sharing_symbols(Nodecl::List environment)
+    {
+        TL::ObjectList<TL::Symbol> result;
+
+        TL::ObjectList<DataSharing> data_sharings = environment.find_all<DataSharing>();
+        for (typename TL::ObjectList<DataSharing>::iterator it = data_sharings.begin();
+                it != data_sharings.end();
+                it++)
+        {
+            Nodecl::List symbols = it->get_symbols().template as<Nodecl::List>();
+            for (Nodecl::List::iterator it_sym = symbols.begin();
+                    it_sym != symbols.end();
+                    it_sym++)
+            {
+                result.insert(it_sym->get_symbol());
+            }
+        }
+
+        return result;
+    }
+
+    TL::Symbol declare_task_struct(const std::string& struct_name,
+            Source fields,
+            Nodecl::NodeclBase location)
+    {
+        Source struct_decl;
+        struct_decl << "struct " << struct_name << " {" << fields << "};";
+
+        TL::Scope global_scope = CURRENT_COMPILED_FILE->global_decl_context;
+        Nodecl::NodeclBase decl = struct_decl.parse_declaration(global_scope);
+
+        TL::Symbol result;
+        if (IS_CXX_LANGUAGE)
+        {
+            Nodecl::Utils::prepend_to_enclosing_top_level_location(location, decl);
+            result = global_scope.get_symbol_from_name(struct_name);
+        }
+        else
+        {
+            result = global_scope.get_symbol_from_name("struct " + struct_name);
+        }
+
+        ERROR_CONDITION(!result.is_valid(), "Invalid symbol", 0);
+        ERROR_CONDITION(!result.is_class(), "Should be a class-name", 0);
+
+        return result;
+    }
+
+    // The structs and functions of the task are declared at namespace scope,
+    // where the types declared inside the enclosing function are not visible
+    bool is_local_to_function(TL::Type t)
+    {
+        t = t.no_ref().basic_type();
+        return t.is_named()
+            && t.get_symbol().get_scope().is_block_scope();
+    }
+
+    // Firstprivates that cannot be copied with an assignment into the memory of the task
+    bool needs_copy_construction(TL::Type t)
+    {
+        t = t.no_ref();
+        if (t.is_array())
+            t = t.basic_type();
+        return IS_CXX_LANGUAGE
+            && !::is_trivially_copiable_type(t.get_internal_type());
+    }
+}
+
+void LoweringVisitor::visit(const Nodecl::OpenMP::Task& construct)
+{
+    Nodecl::NodeclBase statements = construct.get_statements();
+    Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+
+    if (!environment.find_first<Nodecl::OpenMP::TaskIsTaskwait>().is_null())
+    {
+        // A taskwait with dependences is represented as an empty task
+        Nodecl::NodeclBase taskwait = Nodecl::OpenMP::Taskwait::make(
+                environment.shallow_copy(),
+                construct.get_locus());
+        construct.replace(taskwait);
+        walk(taskwait);
+        return;
+    }
+
+    walk(statements);
+    statements = construct.get_statements();
+
+    if (IS_FORTRAN_LANGUAGE)
+    {
+        error_printf_at(construct.get_locus(), "OpenMP task construct is not supported in Fortran\n");
+        return;
+    }
+
+    if (!environment.find_first<Nodecl::OpenMP::Reduction>().is_null()
+            || !environment.find_first<Nodecl::OpenMP::TaskReduction>().is_null())
+    {
+        error_printf_at(construct.get_locus(), "reductions in OpenMP task constructs are not supported\n");
+        return;
+    }
+
+    TL::ObjectList<TL::Symbol> shared_symbols =
+        get_data_sharing_symbols<Nodecl::OpenMP::Shared>(environment);
+    TL::ObjectList<TL::Symbol> private_symbols =
+        get_data_sharing_symbols<Nodecl::OpenMP::Private>(environment);
+    TL::ObjectList<TL::Symbol> firstprivate_symbols =
+        get_data_sharing_symbols<Nodecl::OpenMP::Firstprivate>(environment);
+
+    // Shared and firstprivate symbols are passed to the outline, in this order
+    TL::ObjectList<TL::Symbol> all_symbols_passed;
+    all_symbols_passed.insert(shared_symbols);
+    all_symbols_passed.insert(firstprivate_symbols);
+
+    {
+        TL::ObjectList<TL::Symbol> vla_symbols;
+        for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols_passed.begin();
+                it != all_symbols_passed.end();
+                it++)
+        {
+            Intel::gather_vla_symbols(*it, vla_symbols);
+        }
+        for (TL::ObjectList<TL::Symbol>::iterator it = private_symbols.begin();
+                it != private_symbols.end();
+                it++)
+        {
+            Intel::gather_vla_symbols(*it, vla_symbols);
+        }
+
+        if (!vla_symbols.empty())
+        {
+            error_printf_at(construct.get_locus(),
+                    "variable-length arrays in OpenMP task constructs are not supported\n");
+            return;
+        }
+    }
+
+    {
+        TL::ObjectList<TL::Symbol> all_symbols(all_symbols_passed);
+        all_symbols.insert(private_symbols);
+
+        bool has_local_types = false;
+        for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols.begin();
+                it != all_symbols.end();
+                it++)
+        {
+            if (is_local_to_function(it->get_type()))
+            {
+                error_printf_at(construct.get_locus(),
+                        "variable '%s' of an OpenMP task construct has a type declared inside the function, "
+                        "which is not supported\n",
+                        it->get_name().c_str());
+                has_local_types = true;
+            }
+        }
+
+        bool has_nontrivial_arrays = false;
+        for (TL::ObjectList<TL::Symbol>::iterator it = firstprivate_symbols.begin();
+                it != firstprivate_symbols.end();
+                it++)
+        {
+            if (it->get_type().no_ref().is_array()
+                    && needs_copy_construction(it->get_type()))
+            {
+                error_printf_at(construct.get_locus(),
+                        "firstprivate array '%s' of an OpenMP task construct has a type that is not trivially copyable, "
+                        "which is not supported\n",
+                        it->get_name().c_str());
+                has_nontrivial_arrays = true;
+            }
+        }
+
+        if (has_local_types || has_nontrivial_arrays)
+            return;
+    }
+
+    Nodecl::OpenMP::If if_clause = environment.find_first<Nodecl::OpenMP::If>();
+    Nodecl::OpenMP::Final final_clause = environment.find_first<Nodecl::OpenMP::Final>();
+    Nodecl::OpenMP::Priority priority_clause = environment.find_first<Nodecl::OpenMP::Priority>();
+    bool is_untied = !environment.find_first<Nodecl::OpenMP::Untied>().is_null();
+
+    TL::Type kmp_int32_type = Source("kmp_int32").parse_c_type_id(construct);
+    ERROR_CONDITION(!kmp_int32_type.is_valid(), "Type kmp_int32 not in scope", 0);
+
+    TL::Symbol enclosing_function = Nodecl::Utils::get_enclosing_function(construct);
+
+    int task_num;
+    {
+        TL::Counter &outline_num = TL::CounterManager::get_counter("intel-omp-outline");
+        task_num = outline_num;
+        outline_num++;
+    }
+
+    std::string outline_function_name, entry_function_name, destructors_function_name, shareds_struct_name, data_struct_name;
+    {
+        std::stringstream ss;
+        ss << "_task_ol_" << enclosing_function.get_name() << "_" << task_num;
+        outline_function_name = ss.str();
+    }
+    {
+        std::stringstream ss;
+        ss << "_task_entry_" << enclosing_function.get_name() << "_" << task_num;
+        entry_function_name = ss.str();
+    }
+    {
+        std::stringstream ss;
+        ss << "_task_destructors_" << enclosing_function.get_name() << "_" << task_num;
+        destructors_function_name = ss.str();
+    }
+    {
+        std::stringstream ss;
+        ss << "_task_shareds_" << task_num;
+        shareds_struct_name = ss.str();
+    }
+    {
+        std::stringstream ss;
+        ss << "_task_data_" << task_num;
+        data_struct_name = ss.str();
+    }
+
+    // The runtime allocates the kmp_task_t followed by the private data of
+    // the task (firstprivates) and then the pointers to the shared data
+    TL::Scope global_scope = CURRENT_COMPILED_FILE->global_decl_context;
+
+    TL::Symbol shareds_struct;
+    if (!shared_symbols.empty())
+    {
+        Source fields;
+        for (TL::ObjectList<TL::Symbol>::iterator it = shared_symbols.begin();
+                it != shared_symbols.end();
+                it++)
+        {
+            fields << it->get_type().no_ref().get_pointer_to().get_declaration(global_scope, it->get_name())
+                << ";";
+        }
+        shareds_struct = declare_task_struct(shareds_struct_name, fields, construct);
+    }
+
+    TL::Symbol data_struct;
+    {
+        Source fields;
+        fields << "kmp_task_t _task;";
+        for (TL::ObjectList<TL::Symbol>::iterator it = firstprivate_symbols.begin();
+                it != firstprivate_symbols.end();
+                it++)
+        {
+            fields << it->get_type().no_ref().get_unqualified_type().get_declaration(global_scope, it->get_name())
+                << ";";
+        }
+        data_struct = declare_task_struct(data_struct_name, fields, construct);
+    }
+
+    // Outline with the body of the task
+    TL::ObjectList<std::string> parameter_names;
+    TL::ObjectList<TL::Type> parameter_types;
+    for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols_passed.begin();
+            it != all_symbols_passed.end();
+            it++)
+    {
+        parameter_names.append(it->get_name());
+        parameter_types.append(it->get_type().no_ref().get_lvalue_reference_to());
+    }
+
+    TL::Symbol outline_function = SymbolUtils::new_function_symbol(
+            enclosing_function,
+            outline_function_name,
+            TL::Type::get_void_type(),
+            parameter_names,
+            parameter_types);
+
+    Nodecl::NodeclBase outline_function_code, outline_function_stmt;
+    SymbolUtils::build_empty_body_for_function(outline_function,
+            outline_function_code,
+            outline_function_stmt);
+
+    Nodecl::Utils::SimpleSymbolMap symbol_map;
+
+    TL::Scope block_scope = outline_function_stmt.retrieve_context();
+    for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols_passed.begin();
+            it != all_symbols_passed.end();
+            it++)
+    {
+        TL::Symbol parameter = block_scope.get_symbol_from_name(it->get_name());
+        ERROR_CONDITION(!parameter.is_valid(), "Invalid symbol", 0);
+
+        symbol_map.add_map(*it, parameter);
+    }
+
+    for (TL::ObjectList<TL::Symbol>::iterator it = private_symbols.begin();
+            it != private_symbols.end();
+            it++)
+    {
+        TL::Symbol new_private_sym = Intel::new_private_symbol(*it, block_scope);
+        symbol_map.add_map(*it, new_private_sym);
+
+        CXX_LANGUAGE()
+        {
+            outline_function_stmt.prepend_sibling(
+                    Nodecl::CxxDef::make(
+                        /* context */ Nodecl::NodeclBase::null(),
+                        new_private_sym));
+        }
+    }
+
+    Nodecl::NodeclBase task_body = Nodecl::Utils::deep_copy(statements,
+            outline_function_stmt,
+            symbol_map);
+    outline_function_stmt.prepend_sibling(task_body);
+
+    Nodecl::Utils::prepend_to_enclosing_top_level_location(construct, outline_function_code);
+
+    // Entry point called by the runtime. It unpacks the task data
+    TL::ObjectList<std::string> entry_parameter_names;
+    TL::ObjectList<TL::Type> entry_parameter_types;
+    entry_parameter_names.append("_gtid"); entry_parameter_types.append(kmp_int32_type);
+    entry_parameter_names.append("_task"); entry_parameter_types.append(TL::Type::get_void_type().get_pointer_to());
+
+    TL::Symbol entry_function = SymbolUtils::new_function_symbol(
+            enclosing_function,
+            entry_function_name,
+            kmp_int32_type,
+            entry_parameter_names,
+            entry_parameter_types);
+
+    Nodecl::NodeclBase entry_function_code, entry_function_stmt;
+    SymbolUtils::build_empty_body_for_function(entry_function,
+            entry_function_code,
+            entry_function_stmt);
+
+    Source unpack_shareds, outline_arguments;
+    if (shareds_struct.is_valid())
+    {
+        unpack_shareds
+            << as_type(shareds_struct.get_user_defined_type().get_pointer_to()) << " _shareds = "
+            << "(" << as_type(shareds_struct.get_user_defined_type().get_pointer_to()) << ")_data->_task.shareds;"
+            ;
+    }
+    for (TL::ObjectList<TL::Symbol>::iterator it = all_symbols_passed.begin();
+            it != all_symbols_passed.end();
+            it++)
+    {
+        if (it != all_symbols_passed.begin())
+            outline_arguments << ", ";
+
+        if (shared_symbols.contains(*it))
+            outline_arguments << "*(_shareds->" << it->get_name() << ")";
+        else
+            outline_arguments << "_data->" << it->get_name();
+    }
+
+    Source entry_src;
+    entry_src
+        << "{"
+        <<    as_type(data_struct.get_user_defined_type().get_pointer_to()) << " _data = "
+        <<    "(" << as_type(data_struct.get_user_defined_type().get_pointer_to()) << ")_task;"
+        <<    unpack_shareds
+        <<    as_symbol(outline_function) << "(" << outline_arguments << ");"
+        <<    "return 0;"
+        << "}"
+        ;
+    entry_function_stmt.prepend_sibling(entry_src.parse_statement(entry_function_stmt));
+
+    Nodecl::Utils::prepend_to_enclosing_top_level_location(construct, entry_function_code);
+
+    // Firstprivates copy-constructed into the memory of the task are destroyed
+    // by the runtime when the task finishes, calling this function
+    TL::ObjectList<TL::Symbol> destructed_symbols;
+    for (TL::ObjectList<TL::Symbol>::iterator it = firstprivate_symbols.begin();
+            it != firstprivate_symbols.end();
+            it++)
+    {
+        if (needs_copy_construction(it->get_type()))
+            destructed_symbols.append(*it);
+    }
+
+    TL::Symbol destructors_function;
+    if (!destructed_symbols.empty())
+    {
+        destructors_function = SymbolUtils::new_function_symbol(
+                enclosing_function,
+                destructors_function_name,
+                kmp_int32_type,
+                entry_parameter_names,
+                entry_parameter_types);
+
+        Nodecl::NodeclBase destructors_function_code, destructors_function_stmt;
+        SymbolUtils::build_empty_body_for_function(destructors_function,
+                destructors_function_code,
+                destructors_function_stmt);
+
+        Source destructors_src;
+        destructors_src
+            << "{"
+            <<    as_type(data_struct.get_user_defined_type().get_pointer_to()) << " _data = "
+            <<    "(" << as_type(data_struct.get_user_defined_type().get_pointer_to()) << ")_task;"
+            ;
+        for (TL::ObjectList<TL::Symbol>::iterator it = destructed_symbols.begin();
+                it != destructed_symbols.end();
+                it++)
+        {
+            destructors_src << "__kmp_task_destroy(&_data->" << it->get_name() << ");";
+        }
+        destructors_src
+            <<    "return 0;"
+            << "}"
+            ;
+        destructors_function_stmt.prepend_sibling(destructors_src.parse_statement(destructors_function_stmt));
+
+        Nodecl::Utils::prepend_to_enclosing_top_level_location(construct, destructors_function_code);
+    }
+
+    // Creation of the task
+    TL::Symbol ident_symbol = Intel::new_global_ident_symbol(construct);
+
+    Source flags;
+    flags << "(" << (is_untied ? "0" : "1" /* KMP_TASK_TIED */);
+    if (!final_clause.is_null())
+    {
+        flags << " | ((" << as_expression(final_clause.get_condition().shallow_copy()) << ") ? 2 : 0)" /* KMP_TASK_FINAL */;
+    }
+    if (!priority_clause.is_null())
+    {
+        flags << " | 0x20" /* KMP_TASK_PRIORITY */;
+    }
+    if (destructors_function.is_valid())
+    {
+        flags << " | 0x08" /* KMP_TASK_DESTRUCTORS */;
+    }
+    flags << ")";
+
+    Source sizeof_shareds;
+    if (shareds_struct.is_valid())
+        sizeof_shareds << "sizeof(" << as_type(shareds_struct.get_user_defined_type()) << ")";
+    else
+        sizeof_shareds << "0";
+
+    Source fill_task;
+    if (shareds_struct.is_valid())
+    {
+        fill_task
+            << as_type(shareds_struct.get_user_defined_type().get_pointer_to()) << " _shareds = "
+            << "(" << as_type(shareds_struct.get_user_defined_type().get_pointer_to()) << ")_new_task->shareds;"
+            ;
+    }
+    for (TL::ObjectList<TL::Symbol>::iterator it = shared_symbols.begin();
+            it != shared_symbols.end();
+            it++)
+    {
+        fill_task << "_shareds->" << it->get_name() << " = &" << as_symbol(*it) << ";";
+    }
+    for (TL::ObjectList<TL::Symbol>::iterator it = firstprivate_symbols.begin();
+            it != firstprivate_symbols.end();
+            it++)
+    {
+        if (needs_copy_construction(it->get_type()))
+        {
+            // The memory of the task is raw storage: the copy constructor must be called
+            fill_task << "__kmp_task_copy_construct(&_data->" << it->get_name() << ", " << as_symbol(*it) << ");";
+        }
+        else if (!it->get_type().no_ref().is_array())
+        {
+            fill_task << "_data->" << it->get_name() << " = " << as_symbol(*it) << ";";
+        }
+        else
+        {
+            fill_task
+                << "__builtin_memcpy(_data->" << it->get_name() << ", "
+                <<                    as_symbol(*it) << ", sizeof(" << as_symbol(*it) << "));"
+                ;
+        }
+    }
+    if (destructors_function.is_valid())
+    {
+        fill_task
+            << "_new_task->data1.destructors = (kmp_routine_entry_t)" << as_symbol(destructors_function) << ";"
+            ;
+    }
+    if (!priority_clause.is_null())
+    {
+        fill_task
+            << "_new_task->data2.priority = "
+            << as_expression(priority_clause.get_priority().shallow_copy()) << ";"
+            ;
+    }
+
+    Source deps_init, deps_array;
+    int num_deps = Intel::emit_dependences(environment, deps_init, deps_array);
+
+    Source spawn_task, wait_deps;
+    if (num_deps == 0)
+    {
+        spawn_task
+            << "__kmpc_omp_task(&" << as_symbol(ident_symbol)
+            <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+            <<                  ", _new_task);"
+            ;
+    }
+    else
+    {
+        spawn_task
+            << "__kmpc_omp_task_with_deps(&" << as_symbol(ident_symbol)
+            <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+            <<                  ", _new_task, " << num_deps << ", " << deps_array
+            <<                  ", 0, (kmp_depend_info_t*)0);"
+            ;
+        wait_deps
+            << "__kmpc_omp_wait_deps(&" << as_symbol(ident_symbol)
+            <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+            <<                  ", " << num_deps << ", " << deps_array
+            <<                  ", 0, (kmp_depend_info_t*)0);"
+            ;
+    }
+
+    Source task_src;
+    task_src
+        << "{"
+        <<    "kmp_task_t* _new_task = __kmpc_omp_task_alloc(&" << as_symbol(ident_symbol)
+        <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+        <<                  ", " << flags
+        <<                  ", sizeof(" << as_type(data_struct.get_user_defined_type()) << ")"
+        <<                  ", " << sizeof_shareds
+        <<                  ", (kmp_routine_entry_t)" << as_symbol(entry_function) << ");"
+        <<    as_type(data_struct.get_user_defined_type().get_pointer_to()) << " _data = "
+        <<    "(" << as_type(data_struct.get_user_defined_type().get_pointer_to()) << ")_new_task;"
+        <<    fill_task
+        <<    deps_init
+        ;
+
+    if (if_clause.is_null())
+    {
+        task_src << spawn_task;
+    }
+    else
+    {
+        // An undeferred task is executed immediately by the encountering thread
+        // once its dependences are satisfied
+        task_src
+            << "if (" << as_expression(if_clause.get_condition().shallow_copy()) << ")"
+            << "{"
+            <<    spawn_task
+            << "}"
+            << "else"
+            << "{"
+            <<    wait_deps
+            <<    "__kmpc_omp_task_begin_if0(&" << as_symbol(ident_symbol)
+            <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+            <<                  ", _new_task);"
+            <<    as_symbol(entry_function) << "(__kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+            <<                  ", _new_task);"
+            <<    "__kmpc_omp_task_complete_if0(&" << as_symbol(ident_symbol)
+            <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+            <<                  ", _new_task);"
+            << "}"
+            ;
+    }
+    task_src << "}";
+
+    Nodecl::NodeclBase n = task_src.parse_statement(construct);
+    construct.replace(n);
+}
+
+} }
@@ -0,0 +1,110 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-source.hpp"
+#include "tl-lowering-visitor.hpp"
+#include "tl-lowering-utils.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-counters.hpp"
+
+namespace TL { namespace Intel {
+
+    // The runtime returns nonzero the first time a graph is executed. Then the
+    // statements run and their tasks are recorded. In the following executions
+    // the recorded tasks are replayed without resolving their dependences again
+    void LoweringVisitor::visit(const Nodecl::OpenMP::Taskgraph& construct)
+    {
+        Nodecl::NodeclBase statements = construct.get_statements();
+        walk(statements);
+        statements = construct.get_statements();
+
+        Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+        Nodecl::OpenMP::GraphId graph_id = environment.find_first<Nodecl::OpenMP::GraphId>();
+        Nodecl::OpenMP::GraphReset graph_reset = environment.find_first<Nodecl::OpenMP::GraphReset>();
+        Nodecl::OpenMP::Nogroup nogroup = environment.find_first<Nodecl::OpenMP::Nogroup>();
+
+        TL::Symbol ident_symbol = Intel::new_global_ident_symbol(construct);
+
+        // Graphs without 'graph_id' are numbered within the current file, so
+        // regions of different files should use 'graph_id' to avoid clashes
+        int graph_num = -1;
+        if (graph_id.is_null())
+        {
+            TL::Counter &counter = TL::CounterManager::get_counter("intel-omp-taskgraph");
+            graph_num = counter;
+            counter++;
+        }
+
+        // Both runtime calls receive the same arguments, so the clauses are
+        // evaluated only once before the region
+        TL::Counter &private_num = TL::CounterManager::get_counter("intel-omp-privates");
+        Source gtid, flags, id;
+        gtid << "tg_gtid_" << (int)private_num;
+        flags << "tg_flags_" << (int)private_num;
+        id << "tg_id_" << (int)private_num;
+        private_num++;
+
+        Source flags_value;
+        flags_value << (nogroup.is_null() ? "0" : "1" /* KMP_TASKGRAPH_NOWAIT */);
+        if (!graph_reset.is_null())
+        {
+            flags_value
+                << " | ((" << as_expression(graph_reset.get_condition().shallow_copy()) << ") ? 2 : 0)"
+                /* KMP_TASKGRAPH_GRAPH_RESET */;
+        }
+
+        Source id_value;
+        if (!graph_id.is_null())
+            id_value << as_expression(graph_id.get_graph_id().shallow_copy());
+        else
+            id_value << graph_num;
+
+        Source record_args;
+        record_args << "&" << as_symbol(ident_symbol) << ", " << gtid << ", " << flags << ", " << id;
+
+        Nodecl::NodeclBase stmt_placeholder;
+        Source taskgraph_src;
+        taskgraph_src
+            << "{"
+            <<    "kmp_int32 " << gtid << " = __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ");"
+            <<    "kmp_int32 " << flags << " = " << flags_value << ";"
+            <<    "kmp_int32 " << id << " = " << id_value << ";"
+            <<    "if (__kmpc_start_record_task(" << record_args << "))"
+            <<    "{"
+            <<        statement_placeholder(stmt_placeholder)
+            <<    "}"
+            <<    "__kmpc_end_record_task(" << record_args << ");"
+            << "}"
+            ;
+
+        Nodecl::NodeclBase taskgraph_tree = taskgraph_src.parse_statement(construct);
+        Nodecl::NodeclBase copied_statements = Nodecl::Utils::deep_copy(statements, stmt_placeholder);
+        stmt_placeholder.replace(copied_statements);
+
+        construct.replace(taskgraph_tree);
+    }
+} }
@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-source.hpp"
+#include "tl-lowering-visitor.hpp"
+#include "tl-lowering-utils.hpp"
+
+namespace TL { namespace Intel {
+
+    void LoweringVisitor::visit(const Nodecl::OpenMP::Taskwait& construct)
+    {
+        Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+
+        TL::Symbol ident_symbol = Intel::new_global_ident_symbol(construct);
+
+        Source deps_init, deps_array;
+        int num_deps = Intel::emit_dependences(environment, deps_init, deps_array);
+
+        Source taskwait_src;
+        if (num_deps == 0)
+        {
+            taskwait_src
+                << "__kmpc_omp_taskwait(&" << as_symbol(ident_symbol)
+                <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << "));"
+                ;
+        }
+        else
+        {
+            // Only wait for the sibling tasks that the dependences refer to
+            taskwait_src
+                << "{"
+                <<    deps_init
+                <<    "__kmpc_omp_wait_deps(&" << as_symbol(ident_symbol)
+                <<                  ", __kmpc_global_thread_num(&" << as_symbol(ident_symbol) << ")"
+                <<                  ", " << num_deps << ", " << deps_array
+                <<                  ", 0, (kmp_depend_info_t*)0);"
+                << "}"
+                ;
+        }
+
+        Nodecl::NodeclBase n = taskwait_src.parse_statement(construct);
+        construct.replace(n);
+    }
+} }
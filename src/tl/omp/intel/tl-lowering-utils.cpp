@@ -32,6 +32,7 @@
 #include "tl-counters.hpp"
 #include "tl-nodecl.hpp"
 #include "tl-nodecl-utils.hpp"
+#include "tl-datareference.hpp"
 #include "cxx-cexpr.h"
 
 #include <sstream>
@@ -264,4 +265,85 @@ void Intel::gather_vla_symbols(TL::Symbol symbol,
     gather_vla_symbol_type(symbol.get_type(), extra_symbols);
 }
 
+namespace
+{
+    struct DependenceItem
+    {
+        Nodecl::NodeclBase expr;
+        bool is_in;
+        bool is_out;
+
+        DependenceItem(Nodecl::NodeclBase expr_, bool is_in_, bool is_out_)
+            : expr(expr_), is_in(is_in_), is_out(is_out_) { }
+    };
+
+    template <typename DepKind>
+    void gather_dependences(Nodecl::List environment,
+            bool is_in, bool is_out,
+            TL::ObjectList<DependenceItem>& items)
+    {
+        TL::ObjectList<DepKind> deps = environment.find_all<DepKind>();
+        for (typename TL::ObjectList<DepKind>::iterator it = deps.begin();
+                it != deps.end();
+                it++)
+        {
+            Nodecl::List exprs = it->get_exprs().template as<Nodecl::List>();
+            for (Nodecl::List::iterator it_expr = exprs.begin();
+                    it_expr != exprs.end();
+                    it_expr++)
+            {
+                items.append(DependenceItem(*it_expr, is_in, is_out));
+            }
+        }
+    }
+}
+
+int Intel::emit_dependences(Nodecl::List environment,
+        Source& deps_init,
+        Source& deps_array)
+{
+    TL::ObjectList<DependenceItem> items;
+    gather_dependences<Nodecl::OpenMP::DepIn>(environment, /* in */ true, /* out */ false, items);
+    gather_dependences<Nodecl::OpenMP::DepOut>(environment, /* in */ false, /* out */ true, items);
+    gather_dependences<Nodecl::OpenMP::DepInout>(environment, /* in */ true, /* out */ true, items);
+
+    if (items.empty())
+        return 0;
+
+    TL::Counter &deps_num = TL::CounterManager::get_counter("intel-omp-deps");
+    std::stringstream deps_name;
+    deps_name << "_deps_" << (int)deps_num;
+    deps_num++;
+
+    deps_array << deps_name.str();
+    // Zero-initialized so the flags not set below (mtx, set, all...) are cleared
+    deps_init << "kmp_depend_info_t " << deps_name.str() << "[" << items.size() << "] = { 0 };";
+
+    int i = 0;
+    for (TL::ObjectList<DependenceItem>::iterator it = items.begin();
+            it != items.end();
+            it++, i++)
+    {
+        TL::DataReference data_ref(it->expr);
+        if (!data_ref.is_valid())
+        {
+            data_ref.commit_diagnostic();
+            error_printf_at(it->expr.get_locus(), "invalid dependence '%s'\n",
+                    it->expr.prettyprint().c_str());
+            continue;
+        }
+
+        deps_init
+            << deps_name.str() << "[" << i << "].base_addr = (intptr_t)"
+            <<     as_expression(data_ref.get_base_address()) << ";"
+            << deps_name.str() << "[" << i << "].len = "
+            <<     as_expression(data_ref.get_sizeof()) << ";"
+            << deps_name.str() << "[" << i << "].flags.in = " << (it->is_in ? "1" : "0") << ";"
+            << deps_name.str() << "[" << i << "].flags.out = " << (it->is_out ? "1" : "0") << ";"
+            ;
+    }
+
+    return items.size();
+}
+
 } // TL
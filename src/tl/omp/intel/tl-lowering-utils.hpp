@@ -29,6 +29,7 @@
 #define TL_LOWERING_UTILS_HPP
 
 #include "tl-symbol.hpp"
+#include "tl-source.hpp"
 
 namespace TL { namespace Intel {
 
@@ -39,6 +40,16 @@ namespace TL { namespace Intel {
         COMBINER_AVX2,
     };
 
+    enum ReductionStrategy
+    {
+        // Per-thread partials are combined by __kmpc_reduce_nowait
+        REDUCTION_RUNTIME,
+        // Per-thread partials are combined in log2(nthreads) steps
+        REDUCTION_TREE,
+        // Tree reduction only for teams of at least 'tree_reduction_threshold' threads
+        REDUCTION_AUTO,
+    };
+
     TL::Symbol new_global_ident_symbol(Nodecl::NodeclBase location);
     TL::Symbol new_private_symbol(TL::Symbol original_symbol, TL::Scope private_scope);
     TL::Symbol new_private_symbol(const std::string& base_name,
@@ -54,6 +65,13 @@ namespace TL { namespace Intel {
     void gather_vla_symbols(TL::Symbol symbol,
             TL::ObjectList<TL::Symbol>& extra_symbols);
 
+    // Emits in 'deps_init' the declaration and initialization of an array of
+    // kmp_depend_info_t with the dependences found in 'environment'
+    // and returns the number of dependences. 'deps_array' is the name of the array
+    int emit_dependences(Nodecl::List environment,
+            Source& deps_init,
+            Source& deps_array);
+
 } }
 
 #endif // TL_LOWERING_UTILS_HPP
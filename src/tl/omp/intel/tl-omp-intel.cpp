@@ -29,10 +29,13 @@
 #include "tl-lowering-visitor.hpp"
 #include "tl-lowering-utils.hpp"
 
+#include <sstream>
+
 namespace TL { namespace Intel {
 
     Lowering::Lowering()
-        : _simd_reductions(false), _knc_enabled(false), _avx2_enabled(false)
+        : _simd_reductions(false), _knc_enabled(false), _avx2_enabled(false),
+        _reduction_strategy(REDUCTION_RUNTIME), _tree_reduction_threshold(32)
     {
         set_phase_name("Intel OpenMP RTL lowering");
         set_phase_description("This phase lowers from Mercurium parallel IR into real code involving Intel OpenMP RTL");
@@ -56,6 +59,18 @@ namespace TL { namespace Intel {
                 "If set to '1' enables compilation for AVX2 instruction set, otherwise it is disabled",
                 _avx2_enabled_str,
                 "0").connect(std::bind(&Lowering::set_avx2, this, std::placeholders::_1));
+
+        register_parameter("reduction_strategy",
+                "Combines the partial results of reductions using the runtime ('runtime'), "
+                "a tree of pairwise combinations ('tree') or the tree only for large teams ('auto')",
+                _reduction_strategy_str,
+                "runtime").connect(std::bind(&Lowering::set_reduction_strategy, this, std::placeholders::_1));
+
+        register_parameter("tree_reduction_threshold",
+                "Minimum number of threads of a team for which 'auto' reductions are combined with a tree. "
+                "It is scaled down for reductions whose partials span several cache lines",
+                _tree_reduction_threshold_str,
+                "32").connect(std::bind(&Lowering::set_tree_reduction_threshold, this, std::placeholders::_1));
     }
 
     void Lowering::pre_run(DTO& dto)
@@ -95,6 +110,33 @@ namespace TL { namespace Intel {
         parse_boolean_option("avx2_enabled", str, _avx2_enabled, "Invalid avx2_enabled value");
     }
 
+    void Lowering::set_reduction_strategy(const std::string& str)
+    {
+        if (str == "runtime")
+            _reduction_strategy = REDUCTION_RUNTIME;
+        else if (str == "tree")
+            _reduction_strategy = REDUCTION_TREE;
+        else if (str == "auto")
+            _reduction_strategy = REDUCTION_AUTO;
+        else
+        {
+            std::cerr << "Invalid value '" << str << "' for reduction_strategy. Assuming 'runtime'" << std::endl;
+            _reduction_strategy = REDUCTION_RUNTIME;
+        }
+    }
+
+    void Lowering::set_tree_reduction_threshold(const std::string& str)
+    {
+        int threshold = 0;
+        std::stringstream ss(str);
+        if (!(ss >> threshold) || threshold < 1)
+        {
+            std::cerr << "Invalid value '" << str << "' for tree_reduction_threshold. Assuming 32" << std::endl;
+            threshold = 32;
+        }
+        _tree_reduction_threshold = threshold;
+    }
+
     void Lowering::set_instrumentation(const std::string& str)
     {
         parse_boolean_option("instrument", str, _instrumentation_enabled, "Assuming false.");
@@ -128,6 +170,40 @@ namespace TL { namespace Intel {
         return combiner_isa;
     }
 
+    ReductionStrategy Lowering::get_reduction_strategy(Nodecl::List environment) const
+    {
+        // The reduction_strategy clause of the construct overrides the phase option
+        Nodecl::OpenMP::ReductionStrategy strategy =
+            environment.find_first<Nodecl::OpenMP::ReductionStrategy>();
+        if (strategy.is_null())
+            return _reduction_strategy;
+
+        if (strategy.get_text() == "tree")
+            return REDUCTION_TREE;
+        else if (strategy.get_text() == "auto")
+            return REDUCTION_AUTO;
+        else
+            return REDUCTION_RUNTIME;
+    }
+
+    int Lowering::get_tree_reduction_threshold(TL::Type reduction_pack_type) const
+    {
+        // The runtime combines one whole pack per thread while the tree only
+        // does log2(nthreads) steps, so the bigger the pack the sooner the
+        // tree pays off its barriers. Scale down the threshold for each
+        // cache line of the pack
+        const int cache_line_size = 64;
+        int num_lines = (reduction_pack_type.get_size() + cache_line_size - 1) / cache_line_size;
+        if (num_lines < 1)
+            num_lines = 1;
+
+        int threshold = _tree_reduction_threshold / num_lines;
+        if (threshold < 2)
+            threshold = 2;
+
+        return threshold;
+    }
+
     void Lowering::phase_cleanup(DTO& data_flow)
     {
         Intel::cleanup_lock_map();
@@ -48,6 +48,9 @@ namespace TL { namespace Intel {
             bool simd_reductions() const;
             CombinerISA get_combiner_isa() const;
 
+            ReductionStrategy get_reduction_strategy(Nodecl::List environment) const;
+            int get_tree_reduction_threshold(TL::Type reduction_pack_type) const;
+
         private:
             std::string _openmp_dry_run;
 
@@ -66,6 +69,14 @@ namespace TL { namespace Intel {
             std::string _avx2_enabled_str;
             bool _avx2_enabled;
             void set_avx2(const std::string &str);
+
+            std::string _reduction_strategy_str;
+            ReductionStrategy _reduction_strategy;
+            void set_reduction_strategy(const std::string &str);
+
+            std::string _tree_reduction_threshold_str;
+            int _tree_reduction_threshold;
+            void set_tree_reduction_threshold(const std::string &str);
     };
 
 } }
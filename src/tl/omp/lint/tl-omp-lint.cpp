@@ -2085,6 +2085,7 @@ skip_current_var: ;
             
             // 2.- Compute the necessary analyses for reporting correctness logs
             TL::Analysis::AnalysisBase analysis(ompss_mode_enabled);
+            analysis.set_cache(TL::Analysis::AnalysisCache::get_analysis_cache(dto));
             // We compute liveness analysis (that includes PCFG and use-def) because 
             // we need the information computed by TaskConcurrency (last and next synchronization points of a task)
             if (VERBOSE)
@@ -205,45 +205,43 @@ namespace TL { namespace Nanox {
         for (Nodecl::List::iterator it = statements.begin(); it != statements.end(); it++)
         {
             Nodecl::NodeclBase stmt(*it);
-            if (!stmt.is<Nodecl::ExpressionStatement>())
-            {
-                error_printf_at(stmt.get_locus(),
-                        "'atomic' directive requires an expression statement\n");
-            }
-            else
+            Nodecl::NodeclBase atomic_tree;
+
+            if (IS_FORTRAN_LANGUAGE)
             {
-                Nodecl::NodeclBase expr = stmt.as<Nodecl::ExpressionStatement>().get_nest();
-                Nodecl::NodeclBase atomic_tree;
+                if (!stmt.is<Nodecl::ExpressionStatement>())
+                {
+                    error_printf_at(stmt.get_locus(),
+                            "'atomic' directive requires an expression statement\n");
+                    continue;
+                }
 
+                Nodecl::NodeclBase expr = stmt.as<Nodecl::ExpressionStatement>().get_nest();
                 bool using_builtin = false;
                 bool using_nanos_api = false;
-                if (!allowed_expression_atomic(expr, using_builtin, using_nanos_api))
+                if (allowed_expression_atomic(expr, using_builtin, using_nanos_api))
                 {
-                    warn_printf_at(expr.get_locus(), "'atomic' expression cannot be implemented efficiently: a critical region will be used instead\n");
-                    std::string lock_name = "nanos_default_critical_lock";
-                    atomic_tree = emit_critical_region(lock_name, construct, statements);
+                    atomic_tree = nanos_api_call(expr);
+                    info_printf_at(expr.get_locus(), "'atomic' directive implemented using Nanos++ API calls\n");
                 }
-                else
+            }
+            else
+            {
+                atomic_tree = lower_atomic_statement(stmt, construct);
+                if (!atomic_tree.is_null())
                 {
-                    if (using_nanos_api)
-                    {
-                        atomic_tree = nanos_api_call(expr);
-                        info_printf_at(expr.get_locus(), "'atomic' directive implemented using Nanos++ API calls\n");
-                    }
-                    else if (using_builtin)
-                    {
-                        atomic_tree = builtin_atomic_int_op(expr);
-                        info_printf_at(expr.get_locus(), "'atomic' directive implemented using GCC atomic builtins\n");
-                    }
-                    else
-                    {
-                        atomic_tree = compare_and_exchange(expr);
-                        info_printf_at(expr.get_locus(), "'atomic' directive implemented using GCC compare and exchange\n");
-                    }
+                    info_printf_at(stmt.get_locus(), "'atomic' directive implemented using GCC atomic builtins\n");
                 }
+            }
 
-                replacements.append(atomic_tree);
+            if (atomic_tree.is_null())
+            {
+                warn_printf_at(stmt.get_locus(), "'atomic' expression cannot be implemented efficiently: a critical region will be used instead\n");
+                std::string lock_name = "nanos_default_critical_lock";
+                atomic_tree = emit_critical_region(lock_name, construct, statements);
             }
+
+            replacements.append(atomic_tree);
         }
         construct.replace(replacements);
     }
@@ -317,7 +317,24 @@ void process_prefetch_clause(const Nodecl::List &environment,
     ERROR_CONDITION(
         omp_prefetch_list.size() > 1, "Too many OpenMP::Prefetch nodes", 0);
 
-    if (omp_prefetch_list.size() == 1)
+    if (!environment.find_first<Nodecl::OpenMP::NoPrefetch>().is_null())
+    {
+        ERROR_CONDITION(omp_prefetch_list.size() != 0,
+                        "'prefetch(none)' cannot be combined with other "
+                        "'prefetch' clauses",
+                        0);
+
+        prefetch_info.enabled = false;
+        prefetch_info.disabled = true;
+    }
+    else if (omp_prefetch_list.size() == 1
+             && omp_prefetch_list.begin()->get_distances().is_null())
+    {
+        // prefetch(auto)
+        prefetch_info.enabled = true;
+        prefetch_info.automatic = true;
+    }
+    else if (omp_prefetch_list.size() == 1)
     {
         Nodecl::OpenMP::Prefetch &omp_prefetch = *omp_prefetch_list.begin();
 
@@ -0,0 +1,415 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+  --------------------------------------------------------------------*/
+
+#include "tl-omp-simd-dispatch.hpp"
+#include "tl-omp-simd-visitor.hpp"
+
+#include "tl-vectorizer.hpp"
+#include "tl-vector-isa-descriptor.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-source.hpp"
+#include "tl-counters.hpp"
+#include "cxx-cexpr.h"
+
+using namespace TL::Vectorization;
+
+namespace TL
+{
+namespace OpenMP
+{
+namespace
+{
+struct dispatch_isa_t
+{
+    const char *name;
+    VectorInstructionSet isa;
+    // Value of the 'target' attribute of the version. Each of the
+    // comma-separated features is checked with __builtin_cpu_supports
+    const char *target;
+};
+
+// Sorted from the most to the least preferred ISA
+const dispatch_isa_t dispatch_isas[] = {
+    { "avx512", AVX512_ISA, "avx512f,avx512vl,avx512bw,avx512dq" },
+    { "knl", KNL_ISA, "avx512f" },
+    { "avx2", AVX2_ISA, "avx2,fma" },
+    { "sse4.2", SSE4_2_ISA, "sse4.2" },
+};
+
+const int num_dispatch_isas = sizeof(dispatch_isas) / sizeof(*dispatch_isas);
+
+const dispatch_isa_t &get_dispatch_isa(VectorInstructionSet isa)
+{
+    for (int i = 0; i < num_dispatch_isas; i++)
+    {
+        if (dispatch_isas[i].isa == isa)
+            return dispatch_isas[i];
+    }
+
+    internal_error("SIMD: ISA %d cannot be dispatched at runtime", isa);
+}
+
+TL::ObjectList<std::string> split_list(const std::string &str)
+{
+    TL::ObjectList<std::string> result;
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        std::string::size_type first = item.find_first_not_of(" \t");
+        if (first == std::string::npos)
+            continue;
+        std::string::size_type last = item.find_last_not_of(" \t");
+        result.append(item.substr(first, last - first + 1));
+    }
+    return result;
+}
+}
+
+void parse_simd_dispatch_isas(const std::string &str,
+                              TL::ObjectList<VectorInstructionSet> &isas)
+{
+    isas.clear();
+
+    TL::ObjectList<std::string> names = split_list(str);
+    for (TL::ObjectList<std::string>::iterator it = names.begin();
+         it != names.end();
+         it++)
+    {
+        bool found = false;
+        for (int i = 0; i < num_dispatch_isas && !found; i++)
+            found = (*it == dispatch_isas[i].name);
+
+        if (!found)
+        {
+            fatal_error("SIMD: invalid ISA '%s' in simd_dispatch_isas. "
+                        "Valid values are 'avx512', 'knl', 'avx2' and 'sse4.2'\n",
+                        it->c_str());
+        }
+    }
+
+    for (int i = 0; i < num_dispatch_isas; i++)
+    {
+        if (names.contains(std::string(dispatch_isas[i].name)))
+            isas.append(dispatch_isas[i].isa);
+    }
+}
+
+SimdDispatch::SimdDispatch(const TL::ObjectList<VectorInstructionSet> &isas)
+    : _isas(isas)
+{
+}
+
+bool SimdDispatch::is_dispatchable(
+    const Nodecl::FunctionCode &function_code,
+    const TL::ObjectList<Nodecl::NodeclBase> &simd_nodes)
+{
+    TL::Symbol func_sym = function_code.get_symbol();
+    if (func_sym.is_member() || func_sym.is_nested_function())
+        return false;
+
+    // The body of a 'declare simd' function is vectorized as a whole
+    if (function_code.get_parent().is<Nodecl::OpenMP::SimdFunction>())
+        return false;
+
+    TL::Type func_type = func_sym.get_type();
+    if (func_type.is_template_specialized_type()
+        || func_type.is_dependent()
+        || func_type.lacks_prototype())
+        return false;
+
+    bool has_ellipsis = false;
+    func_type.parameters(has_ellipsis);
+    if (has_ellipsis)
+        return false;
+
+    // The dispatcher has to forward all the parameters
+    TL::ObjectList<TL::Symbol> params = func_sym.get_related_symbols();
+    for (TL::ObjectList<TL::Symbol>::iterator it = params.begin();
+         it != params.end();
+         it++)
+    {
+        if (!it->is_valid() || it->get_name().empty())
+            return false;
+    }
+
+    // The vector versions of 'declare simd' functions are only
+    // created for the ISA of the translation unit
+    for (TL::ObjectList<Nodecl::NodeclBase>::const_iterator it
+         = simd_nodes.begin();
+         it != simd_nodes.end();
+         it++)
+    {
+        TL::ObjectList<Nodecl::NodeclBase> calls
+            = Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+                Nodecl::FunctionCall>(*it);
+        for (TL::ObjectList<Nodecl::NodeclBase>::iterator it_call
+             = calls.begin();
+             it_call != calls.end();
+             it_call++)
+        {
+            Nodecl::NodeclBase called
+                = it_call->as<Nodecl::FunctionCall>().get_called();
+            if (called.is<Nodecl::Symbol>()
+                && _simd_functions.contains(called.get_symbol()))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+Nodecl::FunctionCode SimdDispatch::create_version(
+    const Nodecl::FunctionCode &function_code, const std::string &suffix)
+{
+    TL::Symbol func_sym = function_code.get_symbol();
+
+    std::stringstream version_name;
+    TL::Counter &counter = TL::CounterManager::get_counter("simd-dispatch");
+    version_name << "__" << func_sym.get_name() << "_" << (int)counter << "_"
+                 << suffix;
+    counter++;
+
+    TL::Symbol new_func_sym
+        = func_sym.get_scope().new_symbol(version_name.str());
+    new_func_sym.get_internal_symbol()->kind = SK_FUNCTION;
+
+    Nodecl::Utils::SimpleSymbolMap func_sym_map;
+    func_sym_map.add_map(func_sym, new_func_sym);
+
+    Nodecl::FunctionCode version
+        = Nodecl::Utils::deep_copy(function_code, function_code, func_sym_map)
+              .as<Nodecl::FunctionCode>();
+
+    // Recursive calls go through the dispatcher
+    FunctionDeepCopyFixVisitor fix_deep_copy_visitor(func_sym, new_func_sym);
+    fix_deep_copy_visitor.walk(version.get_statements());
+
+    symbol_entity_specs_set_is_static(new_func_sym.get_internal_symbol(), 1);
+    symbol_entity_specs_set_is_extern(new_func_sym.get_internal_symbol(), 0);
+    symbol_entity_specs_set_is_user_declared(
+        new_func_sym.get_internal_symbol(), 1);
+
+    // The versions are defined before the dispatcher
+    function_code.prepend_sibling(version);
+
+    return version;
+}
+
+void SimdDispatch::create_dispatcher(
+    const Nodecl::FunctionCode &function_code,
+    const TL::ObjectList<TL::Symbol> &isa_versions,
+    TL::Symbol scalar_version)
+{
+    TL::Symbol func_sym = function_code.get_symbol();
+
+    Nodecl::NodeclBase body = function_code.get_statements()
+                                  .as<Nodecl::Context>()
+                                  .get_in_context()
+                                  .as<Nodecl::List>()
+                                  .front();
+    TL::Scope scope = body.retrieve_context();
+
+    std::string version_ptr = "__" + func_sym.get_name() + "_version";
+    std::string selected_ptr = "__" + func_sym.get_name() + "_selected";
+
+    Source isa_selection;
+    for (unsigned int i = 0; i < _isas.size(); i++)
+    {
+        Source cpu_supports;
+        TL::ObjectList<std::string> features
+            = split_list(get_dispatch_isa(_isas[i]).target);
+        for (TL::ObjectList<std::string>::iterator it = features.begin();
+             it != features.end();
+             it++)
+        {
+            cpu_supports.append_with_separator(
+                "__builtin_cpu_supports(\"" + *it + "\")", "&&");
+        }
+
+        isa_selection << "if (" << cpu_supports << ") " << selected_ptr
+                      << " = " << isa_versions[i].get_name() << "; else ";
+    }
+    isa_selection << selected_ptr << " = " << scalar_version.get_name() << ";";
+
+    Source call_args;
+    TL::ObjectList<TL::Symbol> params = func_sym.get_related_symbols();
+    for (TL::ObjectList<TL::Symbol>::iterator it = params.begin();
+         it != params.end();
+         it++)
+    {
+        call_args.append_with_separator(it->get_name(), ",");
+    }
+
+    Source call;
+    call << selected_ptr << "(" << call_args << ")";
+
+    // The cached version may be selected by several threads at the same
+    // time. All of them select the same one, so relaxed atomic accesses
+    // (__ATOMIC_RELAXED is 0) are enough to avoid the data race
+    TL::Type version_ptr_type = func_sym.get_type().get_pointer_to();
+
+    Source dispatcher_src;
+    dispatcher_src
+        << "{"
+        <<     "static " << version_ptr_type.get_declaration(
+                                scope, version_ptr) << " = 0;"
+        <<     version_ptr_type.get_declaration(scope, selected_ptr)
+        <<         " = __atomic_load_n(&" << version_ptr << ", 0);"
+        <<     "if (" << selected_ptr << " == 0)"
+        <<     "{"
+        <<         "__builtin_cpu_init();"
+        <<         isa_selection
+        <<         "__atomic_store_n(&" << version_ptr << ", "
+        <<             selected_ptr << ", 0);"
+        <<     "}"
+        ;
+
+    if (func_sym.get_type().returns().is_void())
+        dispatcher_src << call << ";";
+    else
+        dispatcher_src << "return " << call << ";";
+
+    dispatcher_src << "}";
+
+    body.replace(dispatcher_src.parse_statement(body));
+}
+
+void SimdDispatch::run(Nodecl::NodeclBase translation_unit)
+{
+    TL::ObjectList<Nodecl::NodeclBase> simd_functions
+        = Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+            Nodecl::OpenMP::SimdFunction>(translation_unit);
+    for (TL::ObjectList<Nodecl::NodeclBase>::iterator it
+         = simd_functions.begin();
+         it != simd_functions.end();
+         it++)
+    {
+        _simd_functions.append(it->as<Nodecl::OpenMP::SimdFunction>()
+                                   .get_statement()
+                                   .as<Nodecl::FunctionCode>()
+                                   .get_symbol());
+    }
+
+    TL::ObjectList<Nodecl::NodeclBase> function_codes
+        = Nodecl::Utils::nodecl_get_all_nodecls_of_kind<Nodecl::FunctionCode>(
+            translation_unit);
+    for (TL::ObjectList<Nodecl::NodeclBase>::iterator it
+         = function_codes.begin();
+         it != function_codes.end();
+         it++)
+    {
+        Nodecl::FunctionCode function_code = it->as<Nodecl::FunctionCode>();
+
+        TL::ObjectList<Nodecl::NodeclBase> simd_nodes
+            = Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+                Nodecl::OpenMP::Simd>(function_code);
+        simd_nodes.append(Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+                          Nodecl::OpenMP::SimdFor>(function_code));
+
+        if (simd_nodes.empty())
+            continue;
+
+        if (!is_dispatchable(function_code, simd_nodes))
+        {
+            VECTORIZATION_DEBUG()
+            {
+                std::cerr << "SIMD: function '"
+                          << function_code.get_symbol().get_name()
+                          << "' is not dispatched at runtime" << std::endl;
+            }
+            continue;
+        }
+
+        TL::ObjectList<TL::Symbol> isa_versions;
+        for (TL::ObjectList<VectorInstructionSet>::const_iterator it_isa
+             = _isas.begin();
+             it_isa != _isas.end();
+             it_isa++)
+        {
+            Nodecl::FunctionCode version = create_version(
+                function_code, get_vector_isa_description(*it_isa).get_id());
+
+            const char *target = get_dispatch_isa(*it_isa).target;
+            gcc_attribute_t target_attr;
+            target_attr.attribute_name = uniquestr("target");
+            target_attr.expression_list
+                = Nodecl::List::make(
+                      const_value_to_nodecl(const_value_make_string_null_ended(
+                          target, strlen(target))))
+                      .get_internal_nodecl();
+            symbol_entity_specs_add_gcc_attributes(
+                version.get_symbol().get_internal_symbol(), target_attr);
+
+            // The vector lowering uses the backend of this ISA for this function
+            Vectorizer::get_vectorizer().add_isa_specific_function(
+                version.get_symbol(), *it_isa);
+
+            _versions[*it_isa].append(version);
+            isa_versions.append(version.get_symbol());
+        }
+
+        // The scalar version is the original code without the SIMD constructs
+        Nodecl::FunctionCode scalar_version
+            = create_version(function_code, "scalar");
+
+        TL::ObjectList<Nodecl::NodeclBase> scalar_simd_nodes
+            = Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+                Nodecl::OpenMP::Simd>(scalar_version);
+        for (TL::ObjectList<Nodecl::NodeclBase>::iterator it_simd
+             = scalar_simd_nodes.begin();
+             it_simd != scalar_simd_nodes.end();
+             it_simd++)
+        {
+            it_simd->replace(it_simd->as<Nodecl::OpenMP::Simd>()
+                                 .get_statement()
+                                 .shallow_copy());
+        }
+
+        TL::ObjectList<Nodecl::NodeclBase> scalar_simd_for_nodes
+            = Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+                Nodecl::OpenMP::SimdFor>(scalar_version);
+        for (TL::ObjectList<Nodecl::NodeclBase>::iterator it_simd
+             = scalar_simd_for_nodes.begin();
+             it_simd != scalar_simd_for_nodes.end();
+             it_simd++)
+        {
+            it_simd->replace(it_simd->as<Nodecl::OpenMP::SimdFor>()
+                                 .get_openmp_for()
+                                 .shallow_copy());
+        }
+
+        create_dispatcher(function_code, isa_versions, scalar_version.get_symbol());
+    }
+}
+
+const TL::ObjectList<Nodecl::NodeclBase> &SimdDispatch::get_versions(
+    VectorInstructionSet isa)
+{
+    return _versions[isa];
+}
+}
+}
@@ -0,0 +1,81 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#ifndef TL_OMP_SIMD_DISPATCH_HPP
+#define TL_OMP_SIMD_DISPATCH_HPP
+
+#include "tl-vectorization-common.hpp"
+#include "tl-nodecl-base.hpp"
+
+namespace TL
+{
+namespace OpenMP
+{
+// Parses a comma-separated list of ISAs (e.g. "sse4.2,avx2,knl").
+// The result is sorted from the most to the least preferred ISA
+void parse_simd_dispatch_isas(
+    const std::string &str,
+    TL::ObjectList<Vectorization::VectorInstructionSet> &isas);
+
+// Creates a version of every function containing SIMD constructs for each
+// ISA, plus a scalar one. The original function becomes a dispatcher that
+// selects the best version supported by the running CPU on its first call
+class SimdDispatch
+{
+  private:
+    const TL::ObjectList<Vectorization::VectorInstructionSet> _isas;
+    std::map<Vectorization::VectorInstructionSet,
+             TL::ObjectList<Nodecl::NodeclBase> > _versions;
+
+    // Functions with a 'declare simd' version
+    TL::ObjectList<TL::Symbol> _simd_functions;
+
+    bool is_dispatchable(const Nodecl::FunctionCode &function_code,
+                         const TL::ObjectList<Nodecl::NodeclBase> &simd_nodes);
+
+    Nodecl::FunctionCode create_version(
+        const Nodecl::FunctionCode &function_code,
+        const std::string &suffix);
+
+    void create_dispatcher(
+        const Nodecl::FunctionCode &function_code,
+        const TL::ObjectList<TL::Symbol> &isa_versions,
+        TL::Symbol scalar_version);
+
+  public:
+    SimdDispatch(
+        const TL::ObjectList<Vectorization::VectorInstructionSet> &isas);
+
+    void run(Nodecl::NodeclBase translation_unit);
+
+    // Versions to be vectorized for the ISA 'isa'
+    const TL::ObjectList<Nodecl::NodeclBase> &get_versions(
+        Vectorization::VectorInstructionSet isa);
+};
+}
+}
+
+#endif // TL_OMP_SIMD_DISPATCH_HPP
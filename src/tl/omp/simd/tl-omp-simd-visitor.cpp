@@ -48,11 +48,17 @@ SimdProcessingBase::SimdProcessingBase(
     bool svml_enabled,
     bool only_adjacent_accesses,
     bool only_aligned_accesses,
-    bool overlap_in_place)
+    bool overlap_in_place,
+    bool cost_model_enabled,
+    unsigned long long int nontemporal_threshold,
+    bool auto_prefetch_enabled,
+    bool libmvec_enabled,
+    Vectorization::VectorMathAccuracy math_accuracy)
     : _vectorizer(TL::Vectorization::Vectorizer::get_vectorizer()),
       _vector_isa_desc(TL::Vectorization::get_vector_isa_description(vector_isa)),
       _fast_math_enabled(fast_math_enabled),
-      _overlap_in_place(overlap_in_place)
+      _overlap_in_place(overlap_in_place),
+      _auto_prefetch_enabled(auto_prefetch_enabled)
 {
     if (fast_math_enabled)
     {
@@ -69,11 +75,21 @@ SimdProcessingBase::SimdProcessingBase(
         _vectorizer.disable_unaligned_accesses();
     }
 
+    if (cost_model_enabled)
+    {
+        _vectorizer.enable_cost_model();
+    }
+
+    _vectorizer.set_nontemporal_threshold(nontemporal_threshold);
+    _vectorizer.set_math_accuracy(math_accuracy);
+
     switch (vector_isa)
     {
         case SSE4_2_ISA:
             if (svml_enabled)
                 _vectorizer.enable_svml_sse();
+            else if (libmvec_enabled)
+                _vectorizer.enable_libmvec(_vector_isa_desc.get_id());
             break;
 
         case KNC_ISA:
@@ -84,16 +100,39 @@ SimdProcessingBase::SimdProcessingBase(
         case KNL_ISA:
             if (svml_enabled)
                 _vectorizer.enable_svml_knl();
+            else if (libmvec_enabled)
+                _vectorizer.enable_libmvec(_vector_isa_desc.get_id());
             break;
 
         case AVX2_ISA:
             if (svml_enabled)
                 _vectorizer.enable_svml_avx2();
+            else if (libmvec_enabled)
+                _vectorizer.enable_libmvec(_vector_isa_desc.get_id());
+            break;
+
+        case AVX512_ISA:
+            if (svml_enabled)
+                _vectorizer.enable_svml_avx512();
+            else if (libmvec_enabled)
+                _vectorizer.enable_libmvec(_vector_isa_desc.get_id());
+            break;
+
+        case AVX512_256_ISA:
+            if (svml_enabled)
+                _vectorizer.enable_svml_avx512vl();
+            else if (libmvec_enabled)
+                _vectorizer.enable_libmvec(_vector_isa_desc.get_id());
             break;
 
         case NEON_ISA:
             break;
 
+        case SVE_ISA:
+        case SVE_256_ISA:
+        case SVE_128_ISA:
+            break;
+
         case ROMOL_ISA:
             break;
 
@@ -127,13 +166,23 @@ SimdPreregisterVisitor::SimdPreregisterVisitor(
     bool svml_enabled,
     bool only_adjacent_accesses,
     bool only_aligned_accesses,
-    bool overlap_in_place)
+    bool overlap_in_place,
+    bool cost_model_enabled,
+    unsigned long long int nontemporal_threshold,
+    bool auto_prefetch_enabled,
+    bool libmvec_enabled,
+    Vectorization::VectorMathAccuracy math_accuracy)
     : SimdProcessingBase(simd_isa,
                          fast_math_enabled,
                          svml_enabled,
                          only_adjacent_accesses,
                          only_aligned_accesses,
-                         overlap_in_place)
+                         overlap_in_place,
+                         cost_model_enabled,
+                         nontemporal_threshold,
+                         auto_prefetch_enabled,
+                         libmvec_enabled,
+                         math_accuracy)
 {
 }
 
@@ -147,13 +196,23 @@ SimdVisitor::SimdVisitor(Vectorization::VectorInstructionSet simd_isa,
                          bool svml_enabled,
                          bool only_adjacent_accesses,
                          bool only_aligned_accesses,
-                         bool overlap_in_place)
+                         bool overlap_in_place,
+    bool cost_model_enabled,
+    unsigned long long int nontemporal_threshold,
+    bool auto_prefetch_enabled,
+    bool libmvec_enabled,
+    Vectorization::VectorMathAccuracy math_accuracy)
     : SimdProcessingBase(simd_isa,
                          fast_math_enabled,
                          svml_enabled,
                          only_adjacent_accesses,
                          only_aligned_accesses,
-                         overlap_in_place)
+                         overlap_in_place,
+                         cost_model_enabled,
+                         nontemporal_threshold,
+                         auto_prefetch_enabled,
+                         libmvec_enabled,
+                         math_accuracy)
 {
 }
 
@@ -303,6 +362,14 @@ void SimdVisitor::visit(const Nodecl::OpenMP::Simd &simd_input_node)
                                 overlap_symbols,
                                 prefetch_info);
 
+    // Automatic prefetching for loops without a 'prefetch' clause
+    if (_auto_prefetch_enabled && !prefetch_info.enabled
+        && !prefetch_info.disabled)
+    {
+        prefetch_info.enabled = true;
+        prefetch_info.automatic = true;
+    }
+
     // Process loop-specific simd clauses
     unsigned int unroll_factor;
     unsigned int unroll_and_jam_factor;
@@ -346,6 +413,53 @@ void SimdVisitor::visit(const Nodecl::OpenMP::Simd &simd_input_node)
                                            &reductions,
                                            &new_external_vector_symbol_map);
 
+    // Cost model. It is computed on the original loop, which is the one
+    // known by the analysis
+    loop_environment.load_environment(simd_input_node.get_statement());
+
+    // Loads executed speculatively before a data-dependent 'break' must
+    // not fault on the lanes after the exit. Otherwise the loop is kept
+    // scalar
+    bool early_exit_may_fault = _vectorizer.early_exit_may_fault(
+        simd_input_node.get_statement(), loop_environment);
+
+    bool vectorize_loop = !early_exit_may_fault
+                          && _vectorizer.should_vectorize_loop(
+                                 simd_input_node.get_statement(),
+                                 loop_environment);
+
+    // Non-temporal stores. Selected arrays are added to
+    // 'nontemporal_expressions', which is used by the environment
+    if (vectorize_loop)
+        _vectorizer.select_nontemporal_stores(simd_input_node.get_statement(),
+                                              loop_environment,
+                                              nontemporal_expressions);
+
+    // Prefetch distances depend on the cost of the final loop
+    Vectorization::AutoPrefetcher auto_prefetcher(loop_environment);
+    if (prefetch_info.automatic)
+        auto_prefetcher.analyze(simd_input_node.get_statement(),
+                                vectorize_loop);
+    loop_environment.unload_environment();
+
+    if (!vectorize_loop)
+    {
+        if (early_exit_may_fault)
+            info_printf_at(simd_input_node.get_locus(),
+                           "SIMD: speculative loads may fault, "
+                           "keeping the scalar loop\n");
+        else
+            info_printf_at(simd_input_node.get_locus(),
+                           "SIMD: vectorization is not profitable, "
+                           "keeping the scalar loop\n");
+
+        simd_input_node.replace(simd_input_node.get_statement());
+
+        if (prefetch_info.automatic)
+            auto_prefetcher.insert(simd_input_node);
+        return;
+    }
+
     // Add scopes, default masks, etc.
     loop_environment.load_environment(loop_statement);
 
@@ -372,11 +486,19 @@ void SimdVisitor::visit(const Nodecl::OpenMP::Simd &simd_input_node)
     simd_input_node.replace(output_code);
     output_code = simd_input_node.as<Nodecl::CompoundStatement>();
 
+    // Data-dependent 'break'
+    loop_environment._early_exit
+        = _vectorizer.get_early_exit(loop_statement, loop_environment);
+
     // Get epilog information
     bool only_epilog;
     int epilog_iterations = _vectorizer.get_epilog_info(
         loop_statement, loop_environment, only_epilog);
 
+    // The scalar epilog resumes the iteration that has left the main loop
+    if (!loop_environment._early_exit.is_null())
+        epilog_iterations = -1;
+
     // Set initial mask for vectorization
     set_initial_mask(loop_environment, simd_node_main_loop);
 
@@ -423,7 +545,9 @@ void SimdVisitor::visit(const Nodecl::OpenMP::Simd &simd_input_node)
             loop_statement.prepend_sibling(prependix);
         }
 
-        if (prefetch_info.enabled)
+        if (prefetch_info.automatic)
+            auto_prefetcher.insert(loop_statement);
+        else if (prefetch_info.enabled)
             _vectorizer.prefetcher(
                 loop_statement, prefetch_info, loop_environment);
     }
@@ -543,10 +667,13 @@ void SimdVisitor::visit(const Nodecl::OpenMP::Simd &simd_input_node)
         // by the native compiler
         if (net_epilog_node.is<Nodecl::ForStatement>())
         {
+            // After an early exit, the epilog runs up to vec_factor
+            // iterations
             Nodecl::UnknownPragma loop_count_pragma
                 = get_epilogue_loop_count_pragma(
                     epilog_iterations /*aprox iterations*/,
-                    vec_factor);
+                    loop_environment._early_exit.is_null() ? vec_factor
+                                                           : vec_factor + 1);
 
             net_epilog_node.prepend_sibling(loop_count_pragma);
         }
@@ -650,6 +777,14 @@ void SimdVisitor::visit(const Nodecl::OpenMP::SimdFor &simd_input_node)
                              overlap_symbols,
                              prefetch_info);
 
+    // Automatic prefetching for loops without a 'prefetch' clause
+    if (_auto_prefetch_enabled && !prefetch_info.enabled
+        && !prefetch_info.disabled)
+    {
+        prefetch_info.enabled = true;
+        prefetch_info.automatic = true;
+    }
+
     // Process loop-specific simd clauses
     unsigned int unroll_factor;
     unsigned int unroll_and_jam_factor;
@@ -696,6 +831,38 @@ void SimdVisitor::visit(const Nodecl::OpenMP::SimdFor &simd_input_node)
     // Add scopes, default masks, etc.
     for_environment.load_environment(for_statement);
 
+    // Cost model. 'for_statement' has not been copied, so it is known by
+    // the analysis
+    bool vectorize_loop
+        = _vectorizer.should_vectorize_loop(for_statement, for_environment);
+
+    // Non-temporal stores. Selected arrays are added to
+    // 'nontemporal_expressions', which is used by the environment
+    if (vectorize_loop)
+        _vectorizer.select_nontemporal_stores(
+            for_statement, for_environment, nontemporal_expressions);
+
+    // Prefetch distances depend on the cost of the final loop
+    Vectorization::AutoPrefetcher auto_prefetcher(for_environment);
+    if (prefetch_info.automatic)
+        auto_prefetcher.analyze(for_statement, vectorize_loop);
+
+    if (!vectorize_loop)
+    {
+        for_environment.unload_environment();
+
+        info_printf_at(simd_input_node.get_locus(),
+                       "SIMD: vectorization is not profitable, "
+                       "keeping the scalar loop\n");
+
+        // The worksharing is kept
+        simd_input_node.replace(omp_for);
+
+        if (prefetch_info.automatic)
+            auto_prefetcher.insert(for_statement);
+        return;
+    }
+
     // Add epilog before vectorization
     Nodecl::OpenMP::SimdFor simd_node_epilog
         = Nodecl::Utils::deep_copy(simd_node_for, simd_enclosing_node)
@@ -739,8 +906,11 @@ void SimdVisitor::visit(const Nodecl::OpenMP::SimdFor &simd_input_node)
 
         if (prefetch_info.enabled)
         {
-            _vectorizer.prefetcher(
-                for_statement, prefetch_info, for_environment);
+            if (prefetch_info.automatic)
+                auto_prefetcher.insert(for_statement);
+            else
+                _vectorizer.prefetcher(
+                    for_statement, prefetch_info, for_environment);
 
             // Remove 'pragma noprefetch' and add it as a clause
             Nodecl::NodeclBase previous_sibling
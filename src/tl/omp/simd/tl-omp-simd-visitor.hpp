@@ -43,13 +43,19 @@ class SimdProcessingBase
     const TL::Vectorization::VectorIsaDescriptor& _vector_isa_desc;
     bool _fast_math_enabled;
     bool _overlap_in_place;
+    bool _auto_prefetch_enabled;
 
     SimdProcessingBase(Vectorization::VectorInstructionSet simd_isa,
                        bool fast_math_enabled,
                        bool svml_enabled,
                        bool only_adjacent_accesses,
                        bool only_aligned_accesses,
-                       bool overlap_in_place);
+                       bool overlap_in_place,
+                       bool cost_model_enabled,
+                       unsigned long long int nontemporal_threshold,
+                       bool auto_prefetch_enabled,
+                       bool libmvec_enabled,
+                       Vectorization::VectorMathAccuracy math_accuracy);
 };
 
 class SimdVisitor : public Nodecl::ExhaustiveVisitor<void>,
@@ -65,7 +71,12 @@ class SimdVisitor : public Nodecl::ExhaustiveVisitor<void>,
                 bool svml_enabled,
                 bool only_adjacent_accesses,
                 bool only_aligned_accesses,
-                bool overlap_in_place);
+                bool overlap_in_place,
+                bool cost_model_enabled,
+                unsigned long long int nontemporal_threshold,
+                bool auto_prefetch_enabled,
+                bool libmvec_enabled,
+                Vectorization::VectorMathAccuracy math_accuracy);
     ~SimdVisitor();
 
     virtual void visit(const Nodecl::FunctionCode &func_code);
@@ -90,7 +101,12 @@ class SimdPreregisterVisitor : public Nodecl::ExhaustiveVisitor<void>,
                            bool svml_enabled,
                            bool only_adjacent_accesses,
                            bool only_aligned_accesses,
-                           bool overlap_in_place);
+                           bool overlap_in_place,
+                       bool cost_model_enabled,
+                       unsigned long long int nontemporal_threshold,
+                       bool auto_prefetch_enabled,
+                       bool libmvec_enabled,
+                       Vectorization::VectorMathAccuracy math_accuracy);
     ~SimdPreregisterVisitor();
 
     virtual void visit(const Nodecl::OpenMP::SimdFunction &simd_node);
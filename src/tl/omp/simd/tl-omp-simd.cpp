@@ -26,9 +26,13 @@
 
 #include "tl-omp-simd.hpp"
 #include "tl-omp-simd-visitor.hpp"
+#include "tl-omp-simd-dispatch.hpp"
 
 #include "tl-vectorization-common.hpp"
 
+#include <cerrno>
+#include <cstdlib>
+
 using namespace TL::Vectorization;
 
 namespace TL {
@@ -38,15 +42,24 @@ namespace TL {
             : PragmaCustomCompilerPhase(),
             _simd_enabled(false),
             _svml_enabled(false),
+            _libmvec_enabled(false),
+            _math_accuracy(Vectorization::MEDIUM_MATH_ACCURACY),
             _fast_math_enabled(false),
             _avx2_enabled(false),
             _neon_enabled(false),
+            _sve_enabled(false),
+            _sve_vector_length(512),
             _romol_enabled(false),
             _knc_enabled(false),
             _knl_enabled(false),
+            _avx512_enabled(false),
+            _avx512_vector_length(512),
             _only_adjacent_accesses_enabled(false),
             _only_aligned_accesses_enabled(false),
-            _overlap_in_place(false)
+            _overlap_in_place(false),
+            _cost_model_enabled(false),
+            _nontemporal_threshold(0),
+            _auto_prefetch_enabled(false)
         {
             set_phase_name("Vectorize OpenMP SIMD parallel IR");
             set_phase_description("This phase vectorize the OpenMP SIMD parallel IR");
@@ -61,6 +74,16 @@ namespace TL {
                     _svml_enabled_str,
                     "0").connect(std::bind(&Simd::set_svml, this, std::placeholders::_1));
 
+            register_parameter("libmvec_enabled",
+                    "If set to '1' enables glibc libmvec math library, otherwise it is disabled",
+                    _libmvec_enabled_str,
+                    "0").connect(std::bind(&Simd::set_libmvec, this, std::placeholders::_1));
+
+            register_parameter("simd_math_accuracy",
+                    "Accuracy of the vector math library functions: 'high' (~1 ulp), 'medium' (default, ~4 ulp) or 'low'",
+                    _math_accuracy_str,
+                    "medium").connect(std::bind(&Simd::set_math_accuracy, this, std::placeholders::_1));
+
             register_parameter("fast_math_enabled",
                     "If set to '1' enables fast_math operations, otherwise it is disabled",
                     _fast_math_enabled_str,
@@ -75,6 +98,16 @@ namespace TL {
                     _knl_enabled_str,
                     "0").connect(std::bind(&Simd::set_knl, this, std::placeholders::_1));
 
+            register_parameter("avx512_enabled",
+                    "If set to '1' enables compilation for AVX-512 (F, VL, BW and DQ) instruction set, otherwise it is disabled",
+                    _avx512_enabled_str,
+                    "0").connect(std::bind(&Simd::set_avx512, this, std::placeholders::_1));
+
+            register_parameter("avx512_vector_length",
+                    "Vector length in bits used when compiling for AVX-512: '512' (default) or '256'",
+                    _avx512_vector_length_str,
+                    "512").connect(std::bind(&Simd::set_avx512_vector_length, this, std::placeholders::_1));
+
             register_parameter("avx2_enabled",
                     "If set to '1' enables compilation for AVX2 instruction set, otherwise it is disabled",
                     _avx2_enabled_str,
@@ -85,6 +118,17 @@ namespace TL {
                     _neon_enabled_str,
                     "0").connect(std::bind(&Simd::set_neon, this, std::placeholders::_1));
 
+            register_parameter("sve_enabled",
+                    "If set to '1' enables compilation for SVE instruction set, otherwise it is disabled",
+                    _sve_enabled_str,
+                    "0").connect(std::bind(&Simd::set_sve, this, std::placeholders::_1));
+
+            register_parameter("sve_vector_length",
+                    "Fixed vector length in bits of the SVE code: '512' (default), '256' or '128'. "
+                    "The code is not vector-length agnostic and programs abort at startup on another length",
+                    _sve_vector_length_str,
+                    "512").connect(std::bind(&Simd::set_sve_vector_length, this, std::placeholders::_1));
+
             register_parameter("romol_enabled",
                     "If set to '1' enables compilation for RoMoL instruction set, otherwise it is disabled",
                     _romol_enabled_str,
@@ -105,6 +149,29 @@ namespace TL {
                     _overlap_in_place_str,
                     "0").connect(std::bind(&Simd::set_overlap_in_place, this, std::placeholders::_1));
 
+            register_parameter("simd_cost_model",
+                    "If set to '1' keeps loops scalar when the vectorization cost model finds them not profitable and reports its decision for each loop",
+                    _cost_model_enabled_str,
+                    "0").connect(std::bind(&Simd::set_cost_model, this, std::placeholders::_1));
+
+            register_parameter("simd_nontemporal_threshold",
+                    "Minimum size in bytes of the data written to an array by a SIMD loop for its stores to be "
+                    "automatically non-temporal. '0' (default) disables the selection",
+                    _nontemporal_threshold_str,
+                    "0").connect(std::bind(&Simd::set_nontemporal_threshold, this, std::placeholders::_1));
+
+            register_parameter("simd_auto_prefetch",
+                    "If set to '1' adds software prefetches with distances computed from the cost model to SIMD loops "
+                    "without a 'prefetch' clause",
+                    _auto_prefetch_enabled_str,
+                    "0").connect(std::bind(&Simd::set_auto_prefetch, this, std::placeholders::_1));
+
+            register_parameter("simd_dispatch_isas",
+                    "Comma-separated list of ISAs (avx512, knl, avx2, sse4.2). Functions with SIMD constructs are compiled "
+                    "for each of them and the best version supported by the CPU is selected at runtime",
+                    _simd_dispatch_isas_str,
+                    "").connect(std::bind(&Simd::set_simd_dispatch_isas, this, std::placeholders::_1));
+
         }
 
         void Simd::set_simd(const std::string simd_enabled_str)
@@ -117,6 +184,24 @@ namespace TL {
             parse_boolean_option("svml_enabled", svml_enabled_str, _svml_enabled, "Invalid svml_enabled value");
         }
 
+        void Simd::set_libmvec(const std::string libmvec_enabled_str)
+        {
+            parse_boolean_option("libmvec_enabled", libmvec_enabled_str, _libmvec_enabled, "Invalid libmvec_enabled value");
+        }
+
+        void Simd::set_math_accuracy(const std::string math_accuracy_str)
+        {
+            if (math_accuracy_str == "high")
+                _math_accuracy = Vectorization::HIGH_MATH_ACCURACY;
+            else if (math_accuracy_str == "medium")
+                _math_accuracy = Vectorization::MEDIUM_MATH_ACCURACY;
+            else if (math_accuracy_str == "low")
+                _math_accuracy = Vectorization::LOW_MATH_ACCURACY;
+            else
+                fatal_error("Invalid simd_math_accuracy value '%s'. Valid values are 'high', 'medium' and 'low'\n",
+                        math_accuracy_str.c_str());
+        }
+
         void Simd::set_fast_math(const std::string fast_math_enabled_str)
         {
             parse_boolean_option("fast_math_enabled", fast_math_enabled_str, _fast_math_enabled, "Invalid fast_math_enabled value");
@@ -132,6 +217,22 @@ namespace TL {
             parse_boolean_option("knl_enabled", knl_enabled_str, _knl_enabled, "Invalid knl_enabled value");
         }
 
+        void Simd::set_avx512(const std::string avx512_enabled_str)
+        {
+            parse_boolean_option("avx512_enabled", avx512_enabled_str, _avx512_enabled, "Invalid avx512_enabled value");
+        }
+
+        void Simd::set_avx512_vector_length(const std::string avx512_vector_length_str)
+        {
+            if (avx512_vector_length_str == "512")
+                _avx512_vector_length = 512;
+            else if (avx512_vector_length_str == "256")
+                _avx512_vector_length = 256;
+            else
+                fatal_error("Invalid avx512_vector_length value '%s'. Valid values are '512' and '256'\n",
+                        avx512_vector_length_str.c_str());
+        }
+
         void Simd::set_avx2(const std::string avx2_enabled_str)
         {
             parse_boolean_option("avx2_enabled", avx2_enabled_str, _avx2_enabled, "Invalid avx2_enabled value");
@@ -142,6 +243,24 @@ namespace TL {
             parse_boolean_option("neon_enabled", neon_enabled_str, _neon_enabled, "Invalid neon_enabled value");
         }
 
+        void Simd::set_sve(const std::string sve_enabled_str)
+        {
+            parse_boolean_option("sve_enabled", sve_enabled_str, _sve_enabled, "Invalid sve_enabled value");
+        }
+
+        void Simd::set_sve_vector_length(const std::string sve_vector_length_str)
+        {
+            if (sve_vector_length_str == "512")
+                _sve_vector_length = 512;
+            else if (sve_vector_length_str == "256")
+                _sve_vector_length = 256;
+            else if (sve_vector_length_str == "128")
+                _sve_vector_length = 128;
+            else
+                fatal_error("Invalid sve_vector_length value '%s'. Valid values are '512', '256' and '128'\n",
+                        sve_vector_length_str.c_str());
+        }
+
         void Simd::set_romol(const std::string romol_enabled_str)
         {
             parse_boolean_option("romol_enabled", romol_enabled_str, _romol_enabled, "Invalid romol_enabled value");
@@ -173,6 +292,37 @@ namespace TL {
             }
         }
 
+        void Simd::set_cost_model(const std::string cost_model_enabled_str)
+        {
+            parse_boolean_option("simd_cost_model", cost_model_enabled_str,
+                    _cost_model_enabled, "Invalid simd_cost_model value");
+        }
+
+        void Simd::set_nontemporal_threshold(const std::string nontemporal_threshold_str)
+        {
+            const char* str = nontemporal_threshold_str.c_str();
+            char* end = NULL;
+
+            errno = 0;
+            _nontemporal_threshold = strtoull(str, &end, 10);
+
+            if (errno != 0 || end == str || *end != '\0'
+                    || nontemporal_threshold_str[0] == '-')
+                fatal_error("Invalid simd_nontemporal_threshold value '%s'. It must be a size in bytes\n",
+                        str);
+        }
+
+        void Simd::set_auto_prefetch(const std::string auto_prefetch_enabled_str)
+        {
+            parse_boolean_option("simd_auto_prefetch", auto_prefetch_enabled_str,
+                    _auto_prefetch_enabled, "Invalid simd_auto_prefetch value");
+        }
+
+        void Simd::set_simd_dispatch_isas(const std::string simd_dispatch_isas_str)
+        {
+            parse_simd_dispatch_isas(simd_dispatch_isas_str, _simd_dispatch_isas);
+        }
+
         void Simd::pre_run(TL::DTO& dto)
         {
             this->PragmaCustomCompilerPhase::pre_run(dto);
@@ -198,7 +348,12 @@ namespace TL {
                     { _avx2_enabled, "AVX2", AVX2_ISA, },
                     { _knc_enabled,  "KNC",  KNC_ISA, },
                     { _knl_enabled,  "KNL",  KNL_ISA, },
+                    { _avx512_enabled, "AVX-512",
+                        (_avx512_vector_length == 256) ? AVX512_256_ISA : AVX512_ISA },
                     { _neon_enabled, "NEON", NEON_ISA },
+                    { _sve_enabled, "SVE",
+                        (_sve_vector_length == 128) ? SVE_128_ISA :
+                        (_sve_vector_length == 256) ? SVE_256_ISA : SVE_ISA },
                     { _romol_enabled, "RoMoL", ROMOL_ISA },
                 };
 
@@ -228,18 +383,84 @@ namespace TL {
                     fatal_error("SVML cannot be used with NEON\n");
                 }
 
+                if (_svml_enabled && _sve_enabled)
+                {
+                    fatal_error("SVML cannot be used with SVE\n");
+                }
+
                 if (_svml_enabled && _romol_enabled)
                 {
                     fatal_error("SVML cannot be used with RoMoL\n");
                 }
 
+                if (_libmvec_enabled && _svml_enabled)
+                {
+                    fatal_error("libmvec and SVML cannot be used at the same time\n");
+                }
+
+                if (_libmvec_enabled
+                        && (_knc_enabled || _neon_enabled || _sve_enabled || _romol_enabled))
+                {
+                    fatal_error("libmvec can only be used with SSE4.2, AVX2, AVX-512 and KNL\n");
+                }
+
+                if (_libmvec_enabled && _math_accuracy == HIGH_MATH_ACCURACY)
+                {
+                    fatal_error("libmvec does not provide high accuracy functions\n");
+                }
+
+                if (!_simd_dispatch_isas.empty())
+                {
+                    if (simd_isa != SSE4_2_ISA
+                            && simd_isa != AVX2_ISA
+                            && simd_isa != KNL_ISA
+                            && simd_isa != AVX512_ISA)
+                    {
+                        fatal_error("SIMD: runtime dispatch is not supported for the requested SIMD instruction set\n");
+                    }
+
+                    SimdDispatch simd_dispatch(_simd_dispatch_isas);
+                    simd_dispatch.run(translation_unit);
+
+                    for (TL::ObjectList<VectorInstructionSet>::iterator it = _simd_dispatch_isas.begin();
+                            it != _simd_dispatch_isas.end();
+                            it++)
+                    {
+                        SimdVisitor isa_simd_visitor(*it,
+                                _fast_math_enabled,
+                                _svml_enabled,
+                                _only_adjacent_accesses_enabled,
+                                _only_aligned_accesses_enabled,
+                                _overlap_in_place,
+                                _cost_model_enabled,
+                                _nontemporal_threshold,
+                                _auto_prefetch_enabled,
+                                _libmvec_enabled,
+                                _math_accuracy);
+
+                        const TL::ObjectList<Nodecl::NodeclBase>& versions =
+                            simd_dispatch.get_versions(*it);
+                        for (TL::ObjectList<Nodecl::NodeclBase>::const_iterator it_version = versions.begin();
+                                it_version != versions.end();
+                                it_version++)
+                        {
+                            isa_simd_visitor.walk(*it_version);
+                        }
+                    }
+                }
+
                 SimdPreregisterVisitor simd_preregister_visitor(
                     simd_isa,
                     _fast_math_enabled,
                     _svml_enabled,
                     _only_adjacent_accesses_enabled,
                     _only_aligned_accesses_enabled,
-                    _overlap_in_place);
+                    _overlap_in_place,
+                    _cost_model_enabled,
+                    _nontemporal_threshold,
+                    _auto_prefetch_enabled,
+                    _libmvec_enabled,
+                    _math_accuracy);
                 simd_preregister_visitor.walk(translation_unit);
 
                 SimdVisitor simd_visitor(simd_isa,
@@ -247,7 +468,12 @@ namespace TL {
                                          _svml_enabled,
                                          _only_adjacent_accesses_enabled,
                                          _only_aligned_accesses_enabled,
-                                         _overlap_in_place);
+                                         _overlap_in_place,
+                                         _cost_model_enabled,
+                                         _nontemporal_threshold,
+                                         _auto_prefetch_enabled,
+                                         _libmvec_enabled,
+                                         _math_accuracy);
                 simd_visitor.walk(translation_unit);
             }
         }
@@ -28,6 +28,8 @@
 #define TL_OMP_SIMD_HPP
 
 #include "tl-pragmasupport.hpp"
+#include "tl-vectorization-common.hpp"
+#include "tl-vectorizer-math-library.hpp"
 
 namespace TL
 {
@@ -48,39 +50,69 @@ namespace TL
             private:
                 std::string _simd_enabled_str;
                 std::string _svml_enabled_str;
+                std::string _libmvec_enabled_str;
+                std::string _math_accuracy_str;
                 std::string _fast_math_enabled_str;
                 std::string _avx2_enabled_str;
                 std::string _neon_enabled_str;
+                std::string _sve_enabled_str;
+                std::string _sve_vector_length_str;
                 std::string _romol_enabled_str;
                 std::string _knc_enabled_str;
                 std::string _knl_enabled_str;
+                std::string _avx512_enabled_str;
+                std::string _avx512_vector_length_str;
                 std::string _only_adjacent_accesses_str;
                 std::string _only_aligned_accesses_str;
                 std::string _overlap_in_place_str;
+                std::string _cost_model_enabled_str;
+                std::string _nontemporal_threshold_str;
+                std::string _auto_prefetch_enabled_str;
+                std::string _simd_dispatch_isas_str;
 
                 bool _simd_enabled;
                 bool _svml_enabled;
+                bool _libmvec_enabled;
+                Vectorization::VectorMathAccuracy _math_accuracy;
                 bool _fast_math_enabled;
                 bool _avx2_enabled;
                 bool _neon_enabled;
+                bool _sve_enabled;
+                unsigned int _sve_vector_length;
                 bool _romol_enabled;
                 bool _knc_enabled;
                 bool _knl_enabled;
+                bool _avx512_enabled;
+                unsigned int _avx512_vector_length;
                 bool _only_adjacent_accesses_enabled;
                 bool _only_aligned_accesses_enabled;
                 bool _overlap_in_place;
+                bool _cost_model_enabled;
+                unsigned long long int _nontemporal_threshold;
+                bool _auto_prefetch_enabled;
+                TL::ObjectList<Vectorization::VectorInstructionSet> _simd_dispatch_isas;
 
                 void set_simd(const std::string simd_enabled_str);
                 void set_svml(const std::string svml_enabled_str);
+                void set_libmvec(const std::string libmvec_enabled_str);
+                void set_math_accuracy(const std::string math_accuracy_str);
                 void set_fast_math(const std::string fast_math_enabled_str);
                 void set_avx2(const std::string avx2_enabled_str);
                 void set_neon(const std::string neon_enabled_str);
+                void set_sve(const std::string sve_enabled_str);
+                void set_sve_vector_length(const std::string sve_vector_length_str);
                 void set_romol(const std::string romol_enabled_str);
                 void set_knc(const std::string knc_enabled_str);
                 void set_knl(const std::string knl_enabled_str);
+                void set_avx512(const std::string avx512_enabled_str);
+                void set_avx512_vector_length(const std::string avx512_vector_length_str);
                 void set_only_adjcent_accesses(const std::string only_adjacent_accesses_str);
                 void set_only_aligned_accesses(const std::string only_aligned_accesses_str);
                 void set_overlap_in_place(const std::string overlap_in_place_str);
+                void set_cost_model(const std::string cost_model_enabled_str);
+                void set_nontemporal_threshold(const std::string nontemporal_threshold_str);
+                void set_auto_prefetch(const std::string auto_prefetch_enabled_str);
+                void set_simd_dispatch_isas(const std::string simd_dispatch_isas_str);
         };
     }
 }
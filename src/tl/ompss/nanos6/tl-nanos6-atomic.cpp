@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2015-2015 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-nanos6-lower.hpp"
+#include "tl-atomics.hpp"
+#include "cxx-diagnostic.h"
+
+namespace TL { namespace Nanos6 {
+
+    void Lower::visit(const Nodecl::OpenMP::Atomic& node)
+    {
+        walk(node.get_statements());
+
+        Nodecl::List statements = node.get_statements().as<Nodecl::List>();
+        ERROR_CONDITION(!statements[0].is<Nodecl::Context>(), "Invalid node", 0);
+        statements = statements[0].as<Nodecl::Context>().get_in_context().as<Nodecl::List>();
+
+        Nodecl::List atomic_tree;
+        for (Nodecl::List::iterator it = statements.begin(); it != statements.end(); it++)
+        {
+            Nodecl::NodeclBase stmt(*it);
+            Nodecl::NodeclBase atomic_stmt = lower_atomic_statement(stmt, node);
+            if (atomic_stmt.is_null())
+            {
+                warn_printf_at(stmt.get_locus(),
+                        "'atomic' statement cannot be implemented efficiently: a critical region will be used instead\n");
+
+                Nodecl::NodeclBase critical = Nodecl::OpenMP::Critical::make(
+                        /* environment */ Nodecl::NodeclBase::null(),
+                        node.get_statements().shallow_copy(),
+                        node.get_locus());
+                node.replace(critical);
+                walk(node);
+                return;
+            }
+
+            info_printf_at(stmt.get_locus(), "'atomic' directive implemented using GCC atomic builtins\n");
+            atomic_tree.append(atomic_stmt);
+        }
+
+        node.replace(atomic_tree);
+    }
+
+} }
@@ -0,0 +1,364 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2015-2015 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-nanos6-lower.hpp"
+#include "tl-nanos6-interface.hpp"
+
+#include "tl-nodecl-utils.hpp"
+#include "tl-counters.hpp"
+#include "hlt-loop-normalize.hpp"
+
+#include "cxx-cexpr.h"
+#include "cxx-diagnostic.h"
+
+namespace TL { namespace Nanos6 {
+
+    namespace
+    {
+        // Returns the schedule name without the 'ompss_', 'omp_' or 'openmp_' prefixes
+        std::string get_schedule_kind(const Nodecl::OpenMP::Schedule& schedule)
+        {
+            std::string kind = schedule.get_text();
+            const char* prefixes[] = { "ompss_", "omp_", "openmp_" };
+            for (unsigned int i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); ++i)
+            {
+                std::string prefix(prefixes[i]);
+                if (kind.substr(0, prefix.size()) == prefix)
+                    return kind.substr(prefix.size());
+            }
+            return kind;
+        }
+
+        bool is_combined_parallel_for(const Nodecl::OpenMP::Parallel& n)
+        {
+            Nodecl::List stmts = n.get_statements().as<Nodecl::List>();
+            if (stmts.size() != 1 || !stmts.front().is<Nodecl::Context>())
+                return false;
+
+            Nodecl::NodeclBase in_context = stmts.front().as<Nodecl::Context>().get_in_context();
+            if (!in_context.is<Nodecl::List>()
+                    || in_context.as<Nodecl::List>().size() != 1
+                    || !in_context.as<Nodecl::List>().front().is<Nodecl::OpenMP::For>())
+                return false;
+
+            Nodecl::List for_env = in_context.as<Nodecl::List>().front()
+                .as<Nodecl::OpenMP::For>().get_environment().as<Nodecl::List>();
+            return !for_env.find_first<Nodecl::OpenMP::CombinedWithParallel>().is_null();
+        }
+
+        TL::Symbol new_local_variable(TL::Scope sc,
+                const std::string& counter_name,
+                const std::string& prefix,
+                TL::Type type)
+        {
+            TL::Counter &counter = TL::CounterManager::get_counter(counter_name);
+            std::stringstream ss;
+            ss << prefix << (int)counter;
+            counter++;
+
+            TL::Symbol sym = sc.new_symbol(ss.str());
+            sym.get_internal_symbol()->kind = SK_VARIABLE;
+            sym.set_type(type);
+            symbol_entity_specs_set_is_user_declared(sym.get_internal_symbol(), 1);
+            return sym;
+        }
+
+        // The chunk that runs the last iteration of the loop copies the values
+        // of its private copies out through the addresses of the original variables:
+        //
+        //      nanos_lastprivate_ptr_0 = &x;
+        //      nanos_last_iteration_0 = <upper bound of the normalized loop>;
+        //      #pragma task loop private(x) firstprivate(nanos_lastprivate_ptr_0, nanos_last_iteration_0)
+        //      {
+        //          for (...) { ... }
+        //          if (i > nanos_last_iteration_0)
+        //              *nanos_lastprivate_ptr_0 = x;
+        //      }
+        //
+        // After its last chunk the induction variable is one past the upper bound
+        Nodecl::NodeclBase compute_lastprivate_copy_out(
+                const Nodecl::OpenMP::For& construct,
+                const TL::ForStatement& for_stmt,
+                const TL::ObjectList<TL::Symbol>& lastprivate_symbols,
+                Nodecl::List& exec_env)
+        {
+            TL::Scope sc = construct.retrieve_context();
+            const locus_t* locus = construct.get_locus();
+            TL::Symbol ind_var = for_stmt.get_induction_variable();
+
+            Nodecl::List captured_symbols;
+            Nodecl::List copy_out_stmts;
+
+            TL::Symbol last_iteration = new_local_variable(sc,
+                    "nanos6-last-iteration", "nanos_last_iteration_",
+                    ind_var.get_type().no_ref().get_unqualified_type());
+            if (IS_CXX_LANGUAGE)
+                construct.prepend_sibling(Nodecl::CxxDef::make(Nodecl::NodeclBase::null(), last_iteration));
+
+            construct.prepend_sibling(
+                    Nodecl::ExpressionStatement::make(
+                        Nodecl::Assignment::make(
+                            last_iteration.make_nodecl(/* set_ref_type */ true, locus),
+                            for_stmt.get_upper_bound().shallow_copy(),
+                            last_iteration.get_type().get_lvalue_reference_to(),
+                            locus),
+                        locus));
+            captured_symbols.append(last_iteration.make_nodecl(/* set_ref_type */ true, locus));
+
+            for (TL::ObjectList<TL::Symbol>::const_iterator it = lastprivate_symbols.begin();
+                    it != lastprivate_symbols.end();
+                    it++)
+            {
+                TL::Type type = it->get_type().no_ref();
+
+                TL::Symbol ptr = new_local_variable(sc,
+                        "nanos6-lastprivate-ptr", "nanos_lastprivate_ptr_",
+                        type.get_unqualified_type().get_pointer_to());
+                if (IS_CXX_LANGUAGE)
+                    construct.prepend_sibling(Nodecl::CxxDef::make(Nodecl::NodeclBase::null(), ptr));
+
+                construct.prepend_sibling(
+                        Nodecl::ExpressionStatement::make(
+                            Nodecl::Assignment::make(
+                                ptr.make_nodecl(/* set_ref_type */ true, locus),
+                                Nodecl::Reference::make(
+                                    it->make_nodecl(/* set_ref_type */ true, locus),
+                                    type.get_pointer_to(),
+                                    locus),
+                                ptr.get_type().get_lvalue_reference_to(),
+                                locus),
+                            locus));
+                captured_symbols.append(ptr.make_nodecl(/* set_ref_type */ true, locus));
+
+                copy_out_stmts.append(
+                        Nodecl::ExpressionStatement::make(
+                            Nodecl::Assignment::make(
+                                Nodecl::Dereference::make(
+                                    ptr.make_nodecl(/* set_ref_type */ true, locus),
+                                    type.get_lvalue_reference_to(),
+                                    locus),
+                                it->make_nodecl(/* set_ref_type */ true, locus),
+                                type.get_lvalue_reference_to(),
+                                locus),
+                            locus));
+            }
+
+            exec_env.append(Nodecl::OpenMP::Firstprivate::make(captured_symbols, locus));
+
+            return Nodecl::IfElseStatement::make(
+                    Nodecl::GreaterThan::make(
+                        ind_var.make_nodecl(/* set_ref_type */ true, locus),
+                        last_iteration.make_nodecl(/* set_ref_type */ true, locus),
+                        TL::Type::get_bool_type(),
+                        locus),
+                    copy_out_stmts,
+                    /* else */ Nodecl::NodeclBase::null(),
+                    locus);
+        }
+    }
+
+    // Nanos6 has no teams of threads: a worksharing loop is lowered to a single
+    // loop task whose iterations are partitioned by the runtime among all the CPUs,
+    // using the same bounds interface as the taskloop construct
+    void Lower::visit(const Nodecl::OpenMP::For& construct)
+    {
+        std::string feature = "the worksharing 'for' construct";
+        Interface::family_must_be_at_least("nanos6_task_execution_api", 1, feature);
+        Interface::family_must_be_at_least("nanos6_task_info_contents", 1, feature);
+        Interface::family_must_be_at_least("nanos6_instantiation_api",  2, feature);
+
+        Nodecl::NodeclBase loop = construct.get_loop();
+        ERROR_CONDITION(!loop.is<Nodecl::Context>(), "Unexpected node\n", 0);
+        Nodecl::NodeclBase for_stmt = loop.as<Nodecl::Context>().get_in_context().as<Nodecl::List>().front();
+        ERROR_CONDITION(!for_stmt.is<Nodecl::ForStatement>(), "Unexpected node\n", 0);
+
+        walk(for_stmt);
+
+        // The runtime expects the iteration space in the form [lower, upper) with a positive step
+        TL::HLT::LoopNormalize loop_normalize;
+        loop_normalize.set_loop(for_stmt);
+        loop_normalize.normalize();
+
+        Nodecl::NodeclBase normalized_loop = loop_normalize.get_whole_transformation();
+        ERROR_CONDITION(!normalized_loop.is<Nodecl::ForStatement>(), "Unexpected node\n", 0);
+        TL::ForStatement new_for_stmt(normalized_loop.as<Nodecl::ForStatement>());
+
+        // Translate the worksharing environment to the environment of a loop task
+        bool barrier_at_end = false;
+        TL::ObjectList<TL::Symbol> lastprivate_symbols;
+        Nodecl::List exec_env;
+        Nodecl::List env = construct.get_environment().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = env.begin(); it != env.end(); ++it)
+        {
+            if (it->is<Nodecl::OpenMP::Schedule>())
+            {
+                // All chunks are dynamically distributed by the runtime, so the schedules
+                // only differ in their chunk size. A chunk size of 0 lets the runtime decide it
+                Nodecl::OpenMP::Schedule schedule = it->as<Nodecl::OpenMP::Schedule>();
+                std::string kind = get_schedule_kind(schedule);
+                Nodecl::NodeclBase chunksize;
+                if (kind == "runtime" || kind == "auto" || schedule.get_chunk().is_null())
+                    chunksize = const_value_to_nodecl(const_value_get_signed_int(0));
+                else
+                    chunksize = schedule.get_chunk().shallow_copy();
+                exec_env.append(Nodecl::OmpSs::Chunksize::make(chunksize));
+            }
+            else if (it->is<Nodecl::OpenMP::Reduction>())
+            {
+                // Worksharing reductions become task reductions over the reduced variables
+                Nodecl::List reductions = it->as<Nodecl::OpenMP::Reduction>().get_reductions().as<Nodecl::List>();
+                Nodecl::List reduced_exprs;
+                for (Nodecl::List::iterator itr = reductions.begin(); itr != reductions.end(); ++itr)
+                {
+                    TL::Symbol reduced_sym = itr->as<Nodecl::OpenMP::ReductionItem>().get_reduced_symbol().get_symbol();
+                    reduced_exprs.append(reduced_sym.make_nodecl(/* set_ref_type */ true, it->get_locus()));
+                }
+                exec_env.append(Nodecl::OpenMP::TaskReduction::make(reductions.shallow_copy(), it->get_locus()));
+                exec_env.append(Nodecl::OmpSs::DepReduction::make(reduced_exprs, it->get_locus()));
+            }
+            else if (it->is<Nodecl::OpenMP::Lastprivate>()
+                    || it->is<Nodecl::OpenMP::FirstLastprivate>())
+            {
+                // The loop task works on private copies, which the last chunk copies out
+                bool is_firstlastprivate = it->is<Nodecl::OpenMP::FirstLastprivate>();
+                Nodecl::List symbols = is_firstlastprivate
+                    ? it->as<Nodecl::OpenMP::FirstLastprivate>().get_symbols().as<Nodecl::List>()
+                    : it->as<Nodecl::OpenMP::Lastprivate>().get_symbols().as<Nodecl::List>();
+
+                for (Nodecl::List::iterator its = symbols.begin(); its != symbols.end(); ++its)
+                {
+                    TL::Symbol sym = its->get_symbol();
+                    if (IS_FORTRAN_LANGUAGE)
+                    {
+                        error_printf_at(its->get_locus(),
+                                "lastprivate variables of worksharing loops are not supported in Fortran\n");
+                    }
+                    else if (sym.get_type().no_ref().is_array())
+                    {
+                        error_printf_at(its->get_locus(),
+                                "lastprivate array '%s' of a worksharing loop is not supported in Nanos6\n",
+                                sym.get_name().c_str());
+                    }
+                    else if (sym == new_for_stmt.get_induction_variable())
+                    {
+                        error_printf_at(its->get_locus(),
+                                "lastprivate induction variable '%s' of a worksharing loop is not supported in Nanos6\n",
+                                sym.get_name().c_str());
+                    }
+                    else
+                    {
+                        lastprivate_symbols.insert(sym);
+                    }
+                }
+
+                if (is_firstlastprivate)
+                    exec_env.append(Nodecl::OpenMP::Firstprivate::make(symbols.shallow_copy(), it->get_locus()));
+                else
+                    exec_env.append(Nodecl::OpenMP::Private::make(symbols.shallow_copy(), it->get_locus()));
+            }
+            else if (it->is<Nodecl::OpenMP::BarrierAtEnd>())
+            {
+                barrier_at_end = true;
+            }
+            else if (it->is<Nodecl::OpenMP::FlushAtEntry>()
+                    || it->is<Nodecl::OpenMP::FlushAtExit>()
+                    || it->is<Nodecl::OpenMP::CombinedWithParallel>())
+            {
+                // Task creation and taskwait already imply these flushes
+            }
+            else
+            {
+                exec_env.append(it->shallow_copy());
+            }
+        }
+
+        exec_env.append(
+                Nodecl::OpenMP::Private::make(
+                    Nodecl::List::make(
+                        new_for_stmt.get_induction_variable().make_nodecl(/* set_ref_type */ true))));
+        exec_env.append(Nodecl::OpenMP::TaskIsTaskloop::make());
+
+        Nodecl::List task_body = Nodecl::List::make(normalized_loop);
+        if (!lastprivate_symbols.empty())
+            task_body.append(compute_lastprivate_copy_out(construct, new_for_stmt, lastprivate_symbols, exec_env));
+
+        Nodecl::NodeclBase serial_stmts;
+        // If disabled, act normally
+        if (!_phase->_final_clause_transformation_disabled)
+        {
+            std::map<Nodecl::NodeclBase, Nodecl::NodeclBase>::iterator it = _final_stmts_map.find(construct);
+            ERROR_CONDITION(it == _final_stmts_map.end(), "Invalid serial statements", 0);
+            serial_stmts = Nodecl::List::make(it->second);
+        }
+
+        // The barrier at the end of the construct waits for the loop task
+        Nodecl::NodeclBase taskwait;
+        if (barrier_at_end)
+        {
+            taskwait = Nodecl::OpenMP::Taskwait::make(
+                    /* environment */ Nodecl::NodeclBase::null(), construct.get_locus());
+            construct.append_sibling(taskwait);
+        }
+
+        construct.replace(
+                Nodecl::OpenMP::Task::make(exec_env, task_body, construct.get_locus()));
+
+        lower_task(construct.as<Nodecl::OpenMP::Task>(), serial_stmts);
+
+        if (!taskwait.is_null())
+            walk(taskwait);
+    }
+
+    // Only 'parallel for' is supported: the team is replaced by the loop task of the worksharing
+    void Lower::visit(const Nodecl::OpenMP::Parallel& construct)
+    {
+        if (!is_combined_parallel_for(construct))
+        {
+            error_printf_at(construct.get_locus(),
+                    "the 'parallel' construct is only supported in Nanos6 when combined with a loop construct\n");
+            return;
+        }
+
+        if (!construct.get_num_replicas().is_null())
+        {
+            warn_printf_at(construct.get_locus(),
+                    "the 'num_threads' clause is ignored in Nanos6\n");
+        }
+
+        Nodecl::NodeclBase stmts = construct.get_statements();
+        walk(stmts);
+
+        // The parallel construct always implies a barrier at its end
+        Nodecl::List new_stmts = stmts.shallow_copy().as<Nodecl::List>();
+        Nodecl::NodeclBase taskwait = Nodecl::OpenMP::Taskwait::make(
+                /* environment */ Nodecl::NodeclBase::null(), construct.get_locus());
+        new_stmts.append(taskwait);
+        construct.replace(new_stmts);
+
+        walk(taskwait);
+    }
+}}
@@ -48,6 +48,8 @@ namespace TL { namespace Nanos6 {
             void visit(const Nodecl::OpenMP::Task& n);
             void visit(const Nodecl::OmpSs::TaskCall& n);
             void visit(const Nodecl::OpenMP::TaskLoop& n);
+            void visit(const Nodecl::OpenMP::For& n);
+            void visit(const Nodecl::OpenMP::Parallel& n);
 
             void visit(const Nodecl::OpenMP::Taskwait& n);
             void visit(const Nodecl::OpenMP::Critical& n);
@@ -55,7 +57,6 @@ namespace TL { namespace Nanos6 {
 
             // Unsupported
             void visit(const Nodecl::OpenMP::Taskyield &n);
-            void visit(const Nodecl::OpenMP::For &n);
             void visit(const Nodecl::OpenMP::BarrierFull &n);
             void visit(const Nodecl::OpenMP::FlushMemory &n);
             void visit(const Nodecl::OmpSs::Register &n);
@@ -1537,6 +1537,63 @@ namespace TL { namespace Nanos6 {
         array_type.array_get_bounds(lbound, ubound);
         return element_type.get_array_to_with_descriptor(lbound, ubound, sc);
     }
+
+    // A field of the arguments structure that has not been added to the class yet
+    struct ArgsStructureField
+    {
+        std::string name;
+        const locus_t* locus;
+        bool is_allocatable;
+        TL::Type type;
+        // Symbol of the data environment represented by this field, if any
+        TL::Symbol symbol;
+        bool is_captured;
+
+        ArgsStructureField(const std::string& name_,
+                const locus_t* locus_,
+                bool is_allocatable_,
+                TL::Type type_,
+                TL::Symbol symbol_,
+                bool is_captured_)
+            : name(name_), locus(locus_), is_allocatable(is_allocatable_),
+            type(type_), symbol(symbol_), is_captured(is_captured_)
+        { }
+    };
+
+    bool has_greater_alignment(const ArgsStructureField& f1, const ArgsStructureField& f2)
+    {
+        TL::Type t1 = f1.type, t2 = f2.type;
+        return t1.get_alignment_of() > t2.get_alignment_of();
+    }
+
+    bool any_field_is_dependent(const TL::ObjectList<ArgsStructureField>& fields)
+    {
+        for (TL::ObjectList<ArgsStructureField>::const_iterator it = fields.begin();
+                it != fields.end();
+                it++)
+        {
+            if (it->type.is_dependent())
+                return true;
+        }
+        return false;
+    }
+
+    // Size of a structure whose fields are laid out in the order of 'fields'
+    unsigned int compute_structure_size(const TL::ObjectList<ArgsStructureField>& fields)
+    {
+        unsigned int size = 0;
+        unsigned int max_alignment = 1;
+        for (TL::ObjectList<ArgsStructureField>::const_iterator it = fields.begin();
+                it != fields.end();
+                it++)
+        {
+            TL::Type t = it->type;
+            unsigned int alignment = t.get_alignment_of();
+            size = ((size + alignment - 1) / alignment) * alignment + t.get_size();
+            max_alignment = std::max(max_alignment, alignment);
+        }
+        return ((size + max_alignment - 1) / max_alignment) * max_alignment;
+    }
     }
 
     void TaskProperties::create_environment_structure(
@@ -1652,6 +1709,12 @@ namespace TL { namespace Nanos6 {
 
         new_class_symbol.get_internal_symbol()->type_information = new_class_type;
 
+        // In C/C++ the fields are added once all of them are known, so they can
+        // be sorted by decreasing alignment to minimize the padding between them.
+        // In Fortran the type of a field may refer to the previous fields
+        bool delay_fields = !IS_FORTRAN_LANGUAGE;
+        TL::ObjectList<ArgsStructureField> delayed_fields;
+
         // It maps each captured symbol with its respective symbol in the arguments structure
         Nodecl::Utils::SimpleSymbolMap captured_symbols_map;
         for (TL::ObjectList<TL::Symbol>::iterator it = captured_value.begin();
@@ -1702,6 +1765,19 @@ namespace TL { namespace Nanos6 {
                 requires_initialization = true;
             }
 
+            if (delay_fields)
+            {
+                delayed_fields.append(
+                        ArgsStructureField(
+                            it->get_name(),
+                            it->get_locus(),
+                            is_allocatable,
+                            type_of_field,
+                            *it,
+                            /* is_captured */ true));
+                continue;
+            }
+
             TL::Symbol field = add_field_to_class(
                     new_class_symbol,
                     class_scope,
@@ -1755,6 +1831,19 @@ namespace TL { namespace Nanos6 {
                 }
             }
 
+            if (delay_fields)
+            {
+                delayed_fields.append(
+                        ArgsStructureField(
+                            it->get_name(),
+                            it->get_locus(),
+                            /* is_allocatable */ false,
+                            type_of_field,
+                            *it,
+                            /* is_captured */ false));
+                continue;
+            }
+
             TL::Symbol field = add_field_to_class(
                     new_class_symbol,
                     class_scope,
@@ -1780,31 +1869,101 @@ namespace TL { namespace Nanos6 {
                 else
                     type_of_field = type_of_field.get_pointer_to();
 
-                TL::Symbol field = add_field_to_class(
-                        new_class_symbol,
-                        class_scope,
-                        curr_red_item.symbol.get_name(),
-                        curr_red_item.symbol.get_locus(),
-                        /* is_allocatable */ false,
-                        type_of_field);
-
-                field_map[curr_red_item.symbol] = field;
+                if (delay_fields)
+                {
+                    delayed_fields.append(
+                            ArgsStructureField(
+                                curr_red_item.symbol.get_name(),
+                                curr_red_item.symbol.get_locus(),
+                                /* is_allocatable */ false,
+                                type_of_field,
+                                curr_red_item.symbol,
+                                /* is_captured */ false));
+                }
+                else
+                {
+                    TL::Symbol field = add_field_to_class(
+                            new_class_symbol,
+                            class_scope,
+                            curr_red_item.symbol.get_name(),
+                            curr_red_item.symbol.get_locus(),
+                            /* is_allocatable */ false,
+                            type_of_field);
+
+                    field_map[curr_red_item.symbol] = field;
+                }
             }
 
             // Second, we add the local variable
             {
                 TL::Type type_of_field = curr_red_item.reduction_type;
+
+                // Note that we do not explicitly map this field to the original list item!
+                if (delay_fields)
+                {
+                    delayed_fields.append(
+                            ArgsStructureField(
+                                curr_red_item.symbol.get_name() + "_local_red",
+                                curr_red_item.symbol.get_locus(),
+                                /* is_allocatable */ false,
+                                type_of_field,
+                                TL::Symbol(),
+                                /* is_captured */ false));
+                }
+                else
+                {
+                    add_field_to_class(
+                            new_class_symbol,
+                            class_scope,
+                            curr_red_item.symbol.get_name() + "_local_red",
+                            curr_red_item.symbol.get_locus(),
+                            /* is_allocatable */ false,
+                            type_of_field);
+                }
+            }
+
+        }
+
+        if (delay_fields)
+        {
+            bool is_dependent_layout = any_field_is_dependent(delayed_fields);
+
+            unsigned int size_in_declaration_order = 0;
+            if (!is_dependent_layout)
+            {
+                size_in_declaration_order = compute_structure_size(delayed_fields);
+                std::stable_sort(delayed_fields.begin(), delayed_fields.end(), has_greater_alignment);
+            }
+
+            for (TL::ObjectList<ArgsStructureField>::iterator it = delayed_fields.begin();
+                    it != delayed_fields.end();
+                    it++)
+            {
                 TL::Symbol field = add_field_to_class(
                         new_class_symbol,
                         class_scope,
-                        curr_red_item.symbol.get_name() + "_local_red",
-                        curr_red_item.symbol.get_locus(),
-                        /* is_allocatable */ false,
-                        type_of_field);
+                        it->name,
+                        it->locus,
+                        it->is_allocatable,
+                        it->type);
 
-                // Note that we do not explicitly map this field to the original list item!
+                if (it->symbol.is_valid())
+                    field_map[it->symbol] = field;
+
+                if (it->is_captured)
+                    captured_symbols_map.add_map(it->symbol, field);
             }
 
+            if (phase->args_layout_report_enabled()
+                    && !is_dependent_layout)
+            {
+                info_printf_at(locus_of_task_creation,
+                        "arguments structure '%s' has %d fields and takes %u bytes (%u bytes in declaration order)\n",
+                        ss.str().c_str(),
+                        (int)delayed_fields.size(),
+                        compute_structure_size(delayed_fields),
+                        size_in_declaration_order);
+            }
         }
 
         nodecl_t nodecl_output = nodecl_null();
@@ -3178,6 +3337,226 @@ namespace TL { namespace Nanos6 {
     }
 
 
+    namespace
+    {
+        const decl_context_t* decl_context_map_id(const decl_context_t* d)
+        {
+            return d;
+        }
+
+        bool uses_any_symbol(Nodecl::NodeclBase n, const TL::ObjectList<TL::Symbol>& syms)
+        {
+            TL::ObjectList<TL::Symbol> used = Nodecl::Utils::get_all_symbols(n);
+            for (TL::ObjectList<TL::Symbol>::const_iterator it = syms.begin(); it != syms.end(); it++)
+            {
+                if (used.contains(*it))
+                    return true;
+            }
+            return false;
+        }
+
+        // States whether 'n' is 'i', 'i + c', 'c + i' or 'i - c', where 'c' does not use 'i'
+        bool is_unit_stride_subscript(Nodecl::NodeclBase n, TL::Symbol iterator)
+        {
+            n = n.no_conv();
+            TL::ObjectList<TL::Symbol> iterator_list(1, iterator);
+            if (n.is<Nodecl::Symbol>())
+                return n.get_symbol() == iterator;
+            else if (n.is<Nodecl::ParenthesizedExpression>())
+                return is_unit_stride_subscript(
+                        n.as<Nodecl::ParenthesizedExpression>().get_nest(), iterator);
+            else if (n.is<Nodecl::Add>())
+            {
+                Nodecl::NodeclBase lhs = n.as<Nodecl::Add>().get_lhs();
+                Nodecl::NodeclBase rhs = n.as<Nodecl::Add>().get_rhs();
+                if (uses_any_symbol(rhs, iterator_list))
+                    std::swap(lhs, rhs);
+                return !uses_any_symbol(rhs, iterator_list)
+                    && is_unit_stride_subscript(lhs, iterator);
+            }
+            else if (n.is<Nodecl::Minus>())
+            {
+                return !uses_any_symbol(n.as<Nodecl::Minus>().get_rhs(), iterator_list)
+                    && is_unit_stride_subscript(n.as<Nodecl::Minus>().get_lhs(), iterator);
+            }
+            return false;
+        }
+
+        struct ReplaceIterator : public Nodecl::ExhaustiveVisitor<void>
+        {
+            TL::Symbol _iterator;
+            Nodecl::NodeclBase _value;
+
+            ReplaceIterator(TL::Symbol iterator, Nodecl::NodeclBase value)
+                : _iterator(iterator), _value(value) { }
+
+            virtual void visit(const Nodecl::Symbol& n)
+            {
+                if (n.get_symbol() == _iterator)
+                    n.replace(Nodecl::ParenthesizedExpression::make(
+                                _value.shallow_copy(), _value.get_type()));
+            }
+        };
+
+        std::string replace_iterator(Nodecl::NodeclBase n, TL::Symbol iterator, Nodecl::NodeclBase value)
+        {
+            Nodecl::NodeclBase copy = n.shallow_copy();
+            ReplaceIterator replace(iterator, value);
+            replace.walk(copy);
+            return copy.prettyprint();
+        }
+
+        // Writes in 'region' the array section that covers all the elements
+        // referenced by 'n' when the iterators take all the values of their ranges
+        bool compute_coalesced_region(
+                Nodecl::NodeclBase n,
+                const TL::ObjectList<TL::DataReference::MultiRefIterator>& iterators,
+                const TL::ObjectList<TL::Symbol>& iterator_syms,
+                TL::ObjectList<TL::Symbol>& used_iterators,
+                std::string& region)
+        {
+            if (!uses_any_symbol(n, iterator_syms))
+            {
+                region = n.prettyprint();
+                return true;
+            }
+
+            n = n.no_conv();
+            if (!n.is<Nodecl::ArraySubscript>())
+                return false;
+
+            Nodecl::ArraySubscript array_subscript = n.as<Nodecl::ArraySubscript>();
+
+            // Subscripting through a pointer does not yield a region
+            Nodecl::NodeclBase subscripted = array_subscript.get_subscripted();
+            if (subscripted.no_conv().is<Nodecl::ArraySubscript>()
+                    && !subscripted.get_type().no_ref().is_array())
+                return false;
+
+            if (!compute_coalesced_region(subscripted, iterators, iterator_syms, used_iterators, region))
+                return false;
+
+            Nodecl::List subscripts = array_subscript.get_subscripts().as<Nodecl::List>();
+            for (Nodecl::List::iterator it = subscripts.begin(); it != subscripts.end(); it++)
+            {
+                if (!uses_any_symbol(*it, iterator_syms))
+                {
+                    region += "[" + it->prettyprint() + "]";
+                    continue;
+                }
+
+                if (it->is<Nodecl::Range>())
+                    return false;
+
+                // Exactly one iterator, not used in any other subscript
+                TL::ObjectList<TL::DataReference::MultiRefIterator>::const_iterator current = iterators.end();
+                for (TL::ObjectList<TL::DataReference::MultiRefIterator>::const_iterator it2 = iterators.begin();
+                        it2 != iterators.end();
+                        it2++)
+                {
+                    if (!uses_any_symbol(*it, TL::ObjectList<TL::Symbol>(1, it2->first)))
+                        continue;
+                    if (current != iterators.end())
+                        return false;
+                    current = it2;
+                }
+                if (used_iterators.contains(current->first)
+                        || !is_unit_stride_subscript(*it, current->first))
+                    return false;
+                used_iterators.append(current->first);
+
+                Nodecl::Range range = current->second.as<Nodecl::Range>();
+                region += "[" + replace_iterator(*it, current->first, range.get_lower())
+                    + " : " + replace_iterator(*it, current->first, range.get_upper()) + "]";
+            }
+            return true;
+        }
+
+        // Multidependences whose iterators walk consecutive elements of each
+        // dimension are equivalent to a single (multidimensional) region.
+        // 'nonempty_condition' is null when all the ranges are known to be non-empty
+        bool coalesce_multidependence_c(
+                TL::DataReference& data_ref,
+                int max_dimensions,
+                // Out
+                Nodecl::NodeclBase& region,
+                Nodecl::NodeclBase& nonempty_condition)
+        {
+            TL::ObjectList<TL::DataReference::MultiRefIterator> iterators = data_ref.multireferences();
+            TL::ObjectList<TL::Symbol> iterator_syms;
+            for (TL::ObjectList<TL::DataReference::MultiRefIterator>::iterator it = iterators.begin();
+                    it != iterators.end();
+                    it++)
+            {
+                iterator_syms.append(it->first);
+            }
+
+            nonempty_condition = Nodecl::NodeclBase::null();
+            for (TL::ObjectList<TL::DataReference::MultiRefIterator>::iterator it = iterators.begin();
+                    it != iterators.end();
+                    it++)
+            {
+                if (!it->second.is<Nodecl::Range>())
+                    return false;
+
+                Nodecl::Range range = it->second.as<Nodecl::Range>();
+                Nodecl::NodeclBase lower = range.get_lower();
+                Nodecl::NodeclBase upper = range.get_upper();
+                Nodecl::NodeclBase stride = range.get_stride();
+                if (!stride.is_constant()
+                        || !const_value_is_one(stride.get_constant())
+                        || uses_any_symbol(lower, iterator_syms)
+                        || uses_any_symbol(upper, iterator_syms))
+                    return false;
+
+                if (lower.is_constant() && upper.is_constant())
+                {
+                    if (const_value_is_nonzero(
+                                const_value_gt(lower.get_constant(), upper.get_constant())))
+                        return false;
+                    continue;
+                }
+
+                Nodecl::NodeclBase current_condition = Nodecl::LowerOrEqualThan::make(
+                        lower.shallow_copy(),
+                        upper.shallow_copy(),
+                        TL::Type::get_bool_type());
+                if (nonempty_condition.is_null())
+                    nonempty_condition = current_condition;
+                else
+                    nonempty_condition = Nodecl::LogicalAnd::make(
+                            nonempty_condition,
+                            current_condition,
+                            TL::Type::get_bool_type());
+            }
+
+            Nodecl::NodeclBase base_exp = data_ref;
+            while (base_exp.is<Nodecl::MultiExpression>())
+                base_exp = base_exp.as<Nodecl::MultiExpression>().get_base();
+
+            std::string region_str;
+            TL::ObjectList<TL::Symbol> used_iterators;
+            if (!compute_coalesced_region(base_exp, iterators, iterator_syms, used_iterators, region_str))
+                return false;
+
+            Source src;
+            src << region_str;
+            region = src.parse_generic(data_ref,
+                    /* ParseFlags */ Source::DEFAULT,
+                    "@OMPSS-DEPENDENCY-EXPR@",
+                    Source::c_cxx_check_expression_adapter,
+                    decl_context_map_id);
+
+            TL::DataReference region_data_ref = region;
+            if (!region_data_ref.is_valid())
+                return false;
+
+            TL::Type region_type = region_data_ref.get_data_type();
+            return !region_type.is_array()
+                || region_type.get_num_dimensions() <= max_dimensions;
+        }
+    }
+
     void TaskProperties::register_multidependence_c(
             TL::DataReference& data_ref,
             TL::Symbol handler,
@@ -3361,6 +3740,21 @@ namespace TL { namespace Nanos6 {
                     it++)
             {
                 TL::DataReference data_ref = *it;
+
+                // Registering a single region is much cheaper than
+                // registering each element of the multidependence
+                Nodecl::NodeclBase coalesced_region, nonempty_condition;
+                if (data_ref.is_multireference()
+                        && &dep_set->dep_list != &dep_reduction
+                        && coalesce_multidependence_c(
+                            data_ref,
+                            phase->get_deps_max_dimensions(),
+                            coalesced_region,
+                            nonempty_condition))
+                {
+                    data_ref = coalesced_region;
+                }
+
                 TL::Type data_type = data_ref.get_data_type();
 
                 TL::Symbol register_fun;
@@ -3394,6 +3788,19 @@ namespace TL { namespace Nanos6 {
                             register_fun,
                             /* local_syms */ TL::ObjectList<TL::Symbol>(),
                             register_statements);
+
+                    // A coalesced multidependence with an empty range registers nothing
+                    if (!nonempty_condition.is_null())
+                    {
+                        register_statements = Nodecl::List::make(
+                                Nodecl::IfElseStatement::make(
+                                    rewrite_expression_using_args(
+                                        arg,
+                                        nonempty_condition,
+                                        /* local_syms */ TL::ObjectList<TL::Symbol>()),
+                                    register_statements,
+                                    /* else */ Nodecl::NodeclBase::null()));
+                    }
                 }
                 else
                 {
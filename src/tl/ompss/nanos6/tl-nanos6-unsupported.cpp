@@ -48,21 +48,11 @@ void Lower::visit(const Nodecl::OpenMP::Taskyield &n)
     unsupported(n);
 }
 
-void Lower::visit(const Nodecl::OpenMP::For &n)
-{
-    unsupported(n);
-}
-
 void Lower::visit(const Nodecl::OpenMP::BarrierFull &n)
 {
     unsupported(n);
 }
 
-void Lower::visit(const Nodecl::OpenMP::Atomic &n)
-{
-    unsupported(n);
-}
-
 void Lower::visit(const Nodecl::OpenMP::FlushMemory &n)
 {
     unsupported(n);
@@ -43,7 +43,8 @@
 namespace TL { namespace Nanos6 {
 
     LoweringPhase::LoweringPhase()
-        : _final_clause_transformation_disabled(false)
+        : _final_clause_transformation_disabled(false),
+        _args_layout_report_enabled(false)
     {
         set_phase_name("Nanos 6 lowering");
         set_phase_description("This phase lowers from Mercurium parallel IR "
@@ -54,6 +55,11 @@ namespace TL { namespace Nanos6 {
                 _final_clause_transformation_str,
                 "0").connect(std::bind(&LoweringPhase::set_disable_final_clause_transformation, this, std::placeholders::_1));
 
+        register_parameter("args_layout_report",
+                "Reports the size of the arguments structure of each task",
+                _args_layout_report_str,
+                "0").connect(std::bind(&LoweringPhase::set_args_layout_report, this, std::placeholders::_1));
+
         // std::cerr << "Initializing Nanos 6 lowering phase" << std::endl;
     }
 
@@ -147,6 +153,16 @@ namespace TL { namespace Nanos6 {
         parse_boolean_option("disable_final_clause_transformation", str, _final_clause_transformation_disabled, "Assuming false.");
     }
 
+    void LoweringPhase::set_args_layout_report(const std::string& str)
+    {
+        parse_boolean_option("args_layout_report", str, _args_layout_report_enabled, "Assuming false.");
+    }
+
+    bool LoweringPhase::args_layout_report_enabled() const
+    {
+        return _args_layout_report_enabled;
+    }
+
     unsigned int LoweringPhase::get_deps_max_dimensions() const
     {
         return _constants.deps_max_dimensions;
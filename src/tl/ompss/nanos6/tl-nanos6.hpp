@@ -58,6 +58,8 @@ namespace TL { namespace Nanos6 {
 
             unsigned int get_deps_max_dimensions() const;
 
+            bool args_layout_report_enabled() const;
+
         private:
             void fortran_preprocess_api(DTO& dto);
             void fortran_fixup_api();
@@ -68,6 +70,10 @@ namespace TL { namespace Nanos6 {
             bool _final_clause_transformation_disabled;
             void set_disable_final_clause_transformation(const std::string& str);
 
+            std::string _args_layout_report_str;
+            bool _args_layout_report_enabled;
+            void set_args_layout_report(const std::string& str);
+
 
             Nodecl::List _extra_c_code;
             
@@ -825,6 +825,8 @@ namespace Nodecl
 
     void Utils::remove_from_enclosing_list(Nodecl::NodeclBase n)
     {
+        Utils::mark_enclosing_function_code_as_modified(n);
+
         Nodecl::NodeclBase parent = n.get_parent();
 
         if (!parent.is<Nodecl::List>())
@@ -859,6 +861,29 @@ namespace Nodecl
         return result;
     }
 
+    namespace
+    {
+        typedef std::map<TL::Symbol, unsigned int> modification_stamps_t;
+        modification_stamps_t _function_code_modification_stamps;
+    }
+
+    void Utils::mark_enclosing_function_code_as_modified(Nodecl::NodeclBase n)
+    {
+        Nodecl::NodeclBase function_code = Utils::get_enclosing_nodecl_of_kind<Nodecl::FunctionCode>(n);
+        if (function_code.is_null())
+            return;
+
+        _function_code_modification_stamps[function_code.get_symbol()]++;
+    }
+
+    unsigned int Utils::get_function_code_modification_stamp(TL::Symbol function)
+    {
+        modification_stamps_t::iterator it = _function_code_modification_stamps.find(function);
+        if (it == _function_code_modification_stamps.end())
+            return 0;
+        return it->second;
+    }
+
     Nodecl::NodeclBase Utils::get_enclosing_list(Nodecl::NodeclBase n)
     {
         while (!n.is_null() && !n.is<Nodecl::List>())
@@ -955,6 +980,8 @@ namespace Nodecl
     {
         ERROR_CONDITION(src.is_null(), "Invalid node", 0);
 
+        Utils::mark_enclosing_function_code_as_modified(dest);
+
         if (CURRENT_CONFIGURATION->line_markers)
         {
             update_locus(src.get_internal_nodecl(), dest.get_locus());
@@ -1036,6 +1063,8 @@ namespace Nodecl
 
     void Utils::append_items_after(Nodecl::NodeclBase n, Nodecl::NodeclBase items)
     {
+        Utils::mark_enclosing_function_code_as_modified(n);
+
         if (!Utils::is_in_list(n))
         {
             n = Utils::get_enclosing_node_in_list(n);
@@ -1140,6 +1169,8 @@ namespace Nodecl
 
     void Utils::prepend_items_before(Nodecl::NodeclBase n, Nodecl::NodeclBase items)
     {
+        Utils::mark_enclosing_function_code_as_modified(n);
+
         if (!Utils::is_in_list(n))
         {
             n = Utils::get_enclosing_node_in_list(n);
@@ -128,6 +128,15 @@ namespace Utils {
             const Nodecl::NodeclBase& items);
 
     TL::Symbol get_enclosing_function(Nodecl::NodeclBase n);
+
+    //! Records that the code of the function enclosing n (if any) has been modified
+    //! replace, append_items_after, prepend_items_before and remove_from_enclosing_list
+    //! already call this function
+    //! Other modifications of the tree are detected by the analysis cache on its own
+    void mark_enclosing_function_code_as_modified(Nodecl::NodeclBase n);
+    //! Returns a counter increased every time the code of function is recorded as modified
+    unsigned int get_function_code_modification_stamp(TL::Symbol function);
+
     //! Returns the first list node that encloses n
     Nodecl::NodeclBase get_enclosing_list(Nodecl::NodeclBase n);
     //! Returns the first node enclosing n whose parent is a list
@@ -213,6 +213,15 @@ namespace TL
             else
                 return best_func->get_version();
         }
+
+        bool FunctionVersioning::has_version(TL::Symbol func_name,
+                const std::string& device,
+                const unsigned int vec_factor,
+                const bool masked) const
+        {
+            return find_best_function(func_name, device, vec_factor, masked)
+                != _versions.end();
+        }
     };
 }
 
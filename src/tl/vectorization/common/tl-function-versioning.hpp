@@ -92,6 +92,10 @@ namespace TL
                         const std::string& device,
                         const unsigned int vec_factor,
                         const bool masked) const;
+                bool has_version(TL::Symbol func_name,
+                        const std::string& device,
+                        const unsigned int vec_factor,
+                        const bool masked) const;
         };
 
         extern FunctionVersioning vec_func_versioning;
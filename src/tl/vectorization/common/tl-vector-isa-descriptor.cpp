@@ -33,11 +33,17 @@ namespace Vectorization
 VectorIsaDescriptor::VectorIsaDescriptor(const std::string& id,
                                            unsigned int vector_length,
                                            unsigned int mask_size_elements,
-                                           MaskingSupport masking_supported)
+                                           MaskingSupport masking_supported,
+                                           ShuffleSupport shuffles_supported,
+                                           SpeculativeLoadSupport first_faulting_loads_supported,
+                                           const VectorCostTable& cost_table)
     : _id(id),
       _vector_length(vector_length),
       _mask_size_elements(mask_size_elements),
-      _masking_supported(masking_supported)
+      _masking_supported(masking_supported),
+      _shuffles_supported(shuffles_supported),
+      _first_faulting_loads_supported(first_faulting_loads_supported),
+      _cost_table(cost_table)
 {
 }
 
@@ -56,17 +62,36 @@ bool VectorIsaDescriptor::support_masking() const
     }
 }
 
+bool VectorIsaDescriptor::support_shuffles() const
+{
+    return _shuffles_supported == SUPPORT_SHUFFLES;
+}
+
+bool VectorIsaDescriptor::support_first_faulting_loads() const
+{
+    return _first_faulting_loads_supported == SUPPORT_FIRST_FAULTING_LOADS;
+}
+
 unsigned int VectorIsaDescriptor::get_mask_max_elements() const
 {
     return _mask_size_elements;
 }
 
+const VectorCostTable& VectorIsaDescriptor::get_cost_table() const
+{
+    return _cost_table;
+}
+
 SimdIsa::SimdIsa(const std::string &id,
                  unsigned int vector_length,
                  unsigned int mask_size_elements,
-                 MaskingSupport masking_supported)
-    : VectorIsaDescriptor(
-          id, vector_length, mask_size_elements, masking_supported)
+                 MaskingSupport masking_supported,
+                 ShuffleSupport shuffles_supported,
+                 SpeculativeLoadSupport first_faulting_loads_supported,
+                 const VectorCostTable& cost_table)
+    : VectorIsaDescriptor(id, vector_length, mask_size_elements,
+            masking_supported, shuffles_supported,
+            first_faulting_loads_supported, cost_table)
 {
 }
 
@@ -104,8 +129,13 @@ unsigned int SimdIsa::get_memory_alignment_in_bytes() const
 VectorIsa::VectorIsa(const std::string &id,
                      unsigned int vector_length,
                      unsigned int mask_size_elements,
-                     MaskingSupport masking_supported)
-    : VectorIsaDescriptor(id, vector_length, mask_size_elements, masking_supported)
+                     MaskingSupport masking_supported,
+                     ShuffleSupport shuffles_supported,
+                     SpeculativeLoadSupport first_faulting_loads_supported,
+                     const VectorCostTable& cost_table)
+    : VectorIsaDescriptor(id, vector_length, mask_size_elements,
+            masking_supported, shuffles_supported,
+            first_faulting_loads_supported, cost_table)
 {
 }
 
@@ -127,13 +157,76 @@ unsigned int VectorIsa::get_memory_alignment_in_bytes() const
 }
 
 namespace {
-    // id, vector length, mask size in elements, masking support
-    SimdIsa sse42("smp", 16, 0, DONT_SUPPORT_MASKING);
-    SimdIsa avx2("avx2", 32, 0, DONT_SUPPORT_MASKING);
-    SimdIsa knc("knc", 64, 16, SUPPORT_MASKING);
-    SimdIsa knl("knl", 64, 16, SUPPORT_MASKING);
-    SimdIsa neon("neon", 16, 0, DONT_SUPPORT_MASKING);
-    VectorIsa romol("romol", 64, 64, SUPPORT_MASKING); // vector length in elements
+    // scalar op, scalar div, scalar load, scalar store,
+    // vector op, vector div, vector load, vector store, unaligned penalty,
+    // gather element, scatter element, masked op, shuffle,
+    // loop overhead, epilog setup, cache line, memory latency
+    const VectorCostTable sse42_costs =
+        { 1, 14, 1, 1, 1, 14, 1, 1, 1, 3, 3, 2, 1, 2, 6,
+          64, 250 };
+    // Scatters and masked stores are emulated
+    const VectorCostTable avx2_costs =
+        { 1, 14, 1, 1, 1, 10, 1, 1, 1, 1, 3, 1, 1, 2, 6,
+          64, 250 };
+    // In-order core. Unaligned accesses need unpack/pack pairs
+    const VectorCostTable knc_costs =
+        { 2, 30, 1, 1, 1, 20, 1, 1, 2, 2, 2, 0, 2, 2, 4,
+          64, 300 };
+    const VectorCostTable avx512_costs =
+        { 1, 14, 1, 1, 1, 16, 1, 1, 1, 1, 2, 0, 1, 2, 4,
+          64, 250 };
+    const VectorCostTable avx512vl_costs =
+        { 1, 14, 1, 1, 1, 10, 1, 1, 1, 1, 2, 0, 1, 2, 4,
+          64, 250 };
+    // Prefetches are not lowered
+    const VectorCostTable neon_costs =
+        { 1, 14, 1, 1, 1, 14, 1, 1, 1, 3, 3, 2, 1, 2, 6,
+          0, 0 };
+    // Predicated operations and first-faulting loads are native
+    const VectorCostTable sve_costs =
+        { 1, 14, 1, 1, 1, 16, 1, 1, 0, 2, 2, 0, 2, 2, 2,
+          64, 250 };
+    // Long vectors processed by 8 lanes. No software prefetching
+    const VectorCostTable romol_costs =
+        { 1, 14, 1, 1, 8, 64, 8, 8, 0, 1, 1, 0, 8, 2, 0,
+          0, 0 };
+
+    // id, vector length, mask size in elements, masking support,
+    // shuffle support, first-faulting load support, costs
+    SimdIsa sse42("smp", 16, 0, DONT_SUPPORT_MASKING,
+            SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, sse42_costs);
+    SimdIsa avx2("avx2", 32, 0, DONT_SUPPORT_MASKING,
+            SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, avx2_costs);
+    SimdIsa knc("knc", 64, 16, SUPPORT_MASKING,
+            DONT_SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, knc_costs);
+    SimdIsa knl("knl", 64, 16, SUPPORT_MASKING,
+            SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, avx512_costs);
+    SimdIsa avx512("avx512", 64, 16, SUPPORT_MASKING,
+            SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, avx512_costs);
+    SimdIsa avx512vl("avx512vl", 32, 8, SUPPORT_MASKING,
+            SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, avx512vl_costs);
+    SimdIsa neon("neon", 16, 0, DONT_SUPPORT_MASKING,
+            SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, neon_costs);
+    // The vector length of SVE is fixed at compile time (-msve-vector-bits)
+    SimdIsa sve("sve", 64, 16, SUPPORT_MASKING,
+            DONT_SUPPORT_SHUFFLES,
+            SUPPORT_FIRST_FAULTING_LOADS, sve_costs);
+    SimdIsa sve256("sve256", 32, 8, SUPPORT_MASKING,
+            DONT_SUPPORT_SHUFFLES,
+            SUPPORT_FIRST_FAULTING_LOADS, sve_costs);
+    SimdIsa sve128("sve128", 16, 4, SUPPORT_MASKING,
+            DONT_SUPPORT_SHUFFLES,
+            SUPPORT_FIRST_FAULTING_LOADS, sve_costs);
+    VectorIsa romol("romol", 64, 64, SUPPORT_MASKING,
+            DONT_SUPPORT_SHUFFLES,
+            DONT_SUPPORT_FIRST_FAULTING_LOADS, romol_costs); // vector length in elements
 }
 
 
@@ -149,8 +242,18 @@ VectorIsaDescriptor &get_vector_isa_description(const VectorInstructionSet isa)
             return knc;
         case KNL_ISA:
             return knl;
+        case AVX512_ISA:
+            return avx512;
+        case AVX512_256_ISA:
+            return avx512vl;
         case NEON_ISA:
             return neon;
+        case SVE_ISA:
+            return sve;
+        case SVE_256_ISA:
+            return sve256;
+        case SVE_128_ISA:
+            return sve128;
         case ROMOL_ISA:
             return romol;
         default:
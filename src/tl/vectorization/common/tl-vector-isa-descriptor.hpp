@@ -41,6 +41,47 @@ enum MaskingSupport
     DONT_SUPPORT_MASKING,
 };
 
+// Arbitrary cross-lane permutations of one or more vector registers
+enum ShuffleSupport
+{
+    SUPPORT_SHUFFLES,
+    DONT_SUPPORT_SHUFFLES,
+};
+
+// Loads that do not fault on the lanes after the first one.
+// Used for the loads executed speculatively before an early exit
+enum SpeculativeLoadSupport
+{
+    SUPPORT_FIRST_FAULTING_LOADS,
+    DONT_SUPPORT_FIRST_FAULTING_LOADS,
+};
+
+// Approximate reciprocal throughputs (in cycles) used by the
+// vectorization cost model. Vector costs are per ISA instruction,
+// gather/scatter costs are per element. The cache line size (in bytes)
+// and the memory latency (in cycles) drive automatic prefetching;
+// a zero latency means that the backend does not lower prefetches
+struct VectorCostTable
+{
+    unsigned int scalar_op;
+    unsigned int scalar_div;
+    unsigned int scalar_load;
+    unsigned int scalar_store;
+    unsigned int vector_op;
+    unsigned int vector_div;
+    unsigned int vector_load;
+    unsigned int vector_store;
+    unsigned int unaligned_penalty;
+    unsigned int gather_element;
+    unsigned int scatter_element;
+    unsigned int masked_op;
+    unsigned int shuffle;
+    unsigned int loop_overhead;
+    unsigned int epilog_setup;
+    unsigned int cache_line;
+    unsigned int memory_latency;
+};
+
 class VectorIsaDescriptor
 {
   protected:
@@ -51,16 +92,25 @@ class VectorIsaDescriptor
     const unsigned int _vector_length;
     const unsigned int _mask_size_elements;
     const MaskingSupport _masking_supported;
+    const ShuffleSupport _shuffles_supported;
+    const SpeculativeLoadSupport _first_faulting_loads_supported;
+    const VectorCostTable _cost_table;
 
     VectorIsaDescriptor(const std::string &id,
                          unsigned int vector_length,
                          unsigned int mask_size_elements,
-                         MaskingSupport masking_supported);
+                         MaskingSupport masking_supported,
+                         ShuffleSupport shuffles_supported,
+            SpeculativeLoadSupport first_faulting_loads_supported,
+                         const VectorCostTable& cost_table);
 
   public:
     const std::string& get_id() const;
     bool support_masking() const;
+    bool support_shuffles() const;
+    bool support_first_faulting_loads() const;
     unsigned int get_mask_max_elements() const;
+    const VectorCostTable& get_cost_table() const;
 
     virtual unsigned int get_vec_factor_from_type(
         const TL::Type target_type) const = 0;
@@ -76,7 +126,10 @@ class SimdIsa : public VectorIsaDescriptor
     SimdIsa(const std::string& id,
             unsigned int vector_length,
             unsigned int mask_size_elements,
-            MaskingSupport masking_supported);
+            MaskingSupport masking_supported,
+            ShuffleSupport shuffles_supported,
+            SpeculativeLoadSupport first_faulting_loads_supported,
+            const VectorCostTable& cost_table);
 
     unsigned int get_vec_factor_from_type(const TL::Type target_type) const;
     unsigned int get_vec_factor_for_type(const TL::Type target_type,
@@ -91,7 +144,10 @@ class VectorIsa : public VectorIsaDescriptor
     VectorIsa(const std::string& id,
               unsigned int vector_length,
               unsigned int mask_size_elements,
-              MaskingSupport masking_supported);
+              MaskingSupport masking_supported,
+              ShuffleSupport shuffles_supported,
+            SpeculativeLoadSupport first_faulting_loads_supported,
+              const VectorCostTable& cost_table);
 
     unsigned int get_vec_factor_from_type(const TL::Type target_type) const;
     unsigned int get_vec_factor_for_type(const TL::Type target_type,
@@ -553,6 +553,69 @@ namespace Vectorization
         return translate_output(return_nodecl);
     }
 
+    bool VectorizationAnalysisInterface::get_range_trip_count(
+            const Nodecl::NodeclBase& loop,
+            long long int& trip_count)
+    {
+        if (!loop.is<Nodecl::ForStatement>())
+            return false;
+
+        Nodecl::ForStatement loop_copy =
+            translate_input(loop).as<Nodecl::ForStatement>();
+
+        TL::ForStatementHelper<TL::NoNewNodePolicy> tl_for(loop_copy);
+        if (!tl_for.is_omp_valid_loop() ||
+                !tl_for.get_step().is_constant())
+            return false;
+
+        long long int step = const_value_cast_to_8(
+                tl_for.get_step().get_constant());
+        if (step == 0)
+            return false;
+
+        // The IV takes all the values of the loop in the first statement
+        // of the body
+        Nodecl::NodeclBase first_stmt =
+            Nodecl::Utils::skip_contexts_and_lists(loop_copy.get_statement());
+        while (first_stmt.is<Nodecl::CompoundStatement>())
+        {
+            first_stmt = Nodecl::Utils::skip_contexts_and_lists(
+                    first_stmt.as<Nodecl::CompoundStatement>().get_statements());
+        }
+
+        if (first_stmt.is<Nodecl::ExpressionStatement>())
+            first_stmt = first_stmt.as<Nodecl::ExpressionStatement>().get_nest();
+        if (first_stmt.is_null())
+            return false;
+
+        Analysis::ExtensibleGraph* pcfg = retrieve_pcfg_from_func(loop_copy);
+        Analysis::Node* stmt_node = pcfg->find_nodecl_pointer(first_stmt);
+        if (stmt_node == NULL || stmt_node->is_graph_node())
+            return false;
+
+        Nodecl::NodeclBase range = stmt_node->get_range(
+                Nodecl::Symbol::make(tl_for.get_induction_variable()));
+        if (range.is_null() || !range.is<Nodecl::Range>())
+            return false;
+
+        Nodecl::NodeclBase lb = range.as<Nodecl::Range>().get_lower();
+        Nodecl::NodeclBase ub = range.as<Nodecl::Range>().get_upper();
+
+        if (!lb.is_constant() || !ub.is_constant() ||
+                lb.is<Nodecl::Analysis::MinusInfinity>() ||
+                ub.is<Nodecl::Analysis::PlusInfinity>())
+            return false;
+
+        long long int distance = const_value_cast_to_8(ub.get_constant()) -
+            const_value_cast_to_8(lb.get_constant());
+        if (distance < 0)
+            return false;
+
+        trip_count = distance / (step > 0 ? step : -step) + 1;
+
+        return true;
+    }
+
     /*
     Nodecl::NodeclBase
         VectorizationAnalysisInterface::get_induction_variable_increment(
@@ -134,6 +134,12 @@ namespace Vectorization
             Nodecl::NodeclBase get_induction_variable_lower_bound(
                     const Nodecl::NodeclBase& scope,
                     const Nodecl::NodeclBase& n);
+            // Returns true if the range of the induction variable of
+            // 'loop' computed by range analysis bounds its iterations.
+            // 'trip_count' is then the maximum number of iterations
+            bool get_range_trip_count(
+                    const Nodecl::NodeclBase& loop,
+                    long long int& trip_count);
 //            DEPRECATED Nodecl::NodeclBase get_induction_variable_increment(
 //                    const Nodecl::NodeclBase& scope,
 //                    const Nodecl::NodeclBase& n );
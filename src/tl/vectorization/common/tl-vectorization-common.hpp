@@ -57,7 +57,12 @@ namespace TL
             AVX2_ISA,
             KNC_ISA,
             KNL_ISA,
+            AVX512_ISA,
+            AVX512_256_ISA, // AVX-512 restricted to 256-bit vectors
             NEON_ISA,
+            SVE_ISA,
+            SVE_256_ISA, // SVE with a 256-bit vector length
+            SVE_128_ISA, // SVE with a 128-bit vector length
             ROMOL_ISA,
         };
     }
@@ -44,8 +44,13 @@ typedef struct prefetch_info
     int distances[2];
     bool enabled;
     bool in_place;
+    // Distances and prefetched accesses are computed by AutoPrefetcher
+    bool automatic;
+    // prefetch(none)
+    bool disabled;
 
-    prefetch_info() : enabled(false), in_place(false)
+    prefetch_info()
+        : enabled(false), in_place(false), automatic(false), disabled(false)
     {
     }
 } prefetch_info_t;
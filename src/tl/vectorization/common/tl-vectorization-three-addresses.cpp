@@ -77,6 +77,7 @@ namespace Vectorization
                 n.is<Nodecl::VectorConversion>() ||
                 n.is<Nodecl::VectorConditionalExpression>() ||
                 n.is<Nodecl::VectorAlignRight>() ||
+                n.is<Nodecl::VectorShuffle>() ||
                 n.is<Nodecl::VectorMaskNot>() ||
                 n.is<Nodecl::VectorMaskAnd>() ||
                 n.is<Nodecl::VectorMaskOr>() ||
@@ -311,6 +312,19 @@ namespace Vectorization
     {
         visit_vector_ternary(n);
     }
+    void VectorizationThreeAddresses::visit(const Nodecl::VectorShuffle& n)
+    {
+        Nodecl::List sources = n.get_sources().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = sources.begin(); it != sources.end(); it++)
+        {
+            walk(*it);
+
+            if (needs_decomposition(*it))
+            {
+                decomp(*it);
+            }
+        }
+    }
     void VectorizationThreeAddresses::visit(const Nodecl::VectorLoad& n)
     {
         visit_vector_unary(n);
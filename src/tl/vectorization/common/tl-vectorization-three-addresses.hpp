@@ -64,6 +64,7 @@ namespace Vectorization
             void visit(const Nodecl::VectorSincos& n);
             void visit(const Nodecl::VectorFunctionCall& n);
             void visit(const Nodecl::VectorAlignRight& n);
+            void visit(const Nodecl::VectorShuffle& n);
             void visit(const Nodecl::VectorLoad& n);
             void visit(const Nodecl::VectorGather& n);
             void visit(const Nodecl::VectorStore& n);
@@ -94,6 +94,7 @@ namespace Utils
             case NODECL_VECTOR_REDUCTION_MUL :
             case NODECL_VECTOR_RSQRT :
             case NODECL_VECTOR_SCATTER :
+            case NODECL_VECTOR_SHUFFLE :
             case NODECL_VECTOR_SINCOS :
             case NODECL_VECTOR_SQRT :
             case NODECL_VECTOR_STORE :
@@ -599,6 +600,28 @@ namespace Utils
         internal_error("Invalid Vector Memory Access\n", 0);
     }
 
+    Nodecl::NodeclBase get_store_fence_point(const Nodecl::NodeclBase& n)
+    {
+        Nodecl::NodeclBase statement;
+        Nodecl::NodeclBase current = n.get_parent();
+
+        while (!current.is_null() && !current.is<Nodecl::FunctionCode>())
+        {
+            if (current.is<Nodecl::ForStatement>()
+                    || current.is<Nodecl::WhileStatement>()
+                    || current.is<Nodecl::DoStatement>())
+                return current;
+
+            if (statement.is_null()
+                    && current.is<Nodecl::ExpressionStatement>())
+                statement = current;
+
+            current = current.get_parent();
+        }
+
+        return statement;
+    }
+
     TL::Symbol get_subscripted_symbol(const Nodecl::NodeclBase& subscripted)
     {
         Nodecl::NodeclBase no_conv = subscripted.no_conv();
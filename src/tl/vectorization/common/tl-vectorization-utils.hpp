@@ -183,6 +183,12 @@ namespace TL
             Nodecl::NodeclBase get_vector_load_subscript(
                     const Nodecl::VectorLoad& vector_load);
 
+            // Statement after which non-temporal stores in 'n' have to
+            // be fenced: the innermost enclosing loop or, if none, the
+            // enclosing expression statement
+            Nodecl::NodeclBase get_store_fence_point(
+                    const Nodecl::NodeclBase& n);
+
             objlist_nodecl_t get_nodecls_not_contained_in(
                     const objlist_nodecl_t& contained_list,
                     const objlist_nodecl_t& container_list);
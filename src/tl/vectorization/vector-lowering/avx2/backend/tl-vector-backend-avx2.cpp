@@ -25,6 +25,7 @@
   --------------------------------------------------------------------*/
 
 #include "tl-vector-backend-avx2.hpp"
+#include "tl-vectorization-prefetcher-common.hpp"
 
 #include "tl-vectorization-utils.hpp"
 #include "tl-source.hpp"
@@ -104,13 +105,6 @@ TL::Symbol get_m256i_symbol()
 
 namespace Vectorization
 {
-    namespace {
-        TL::Type avx2_comparison_type()
-        {
-            return TL::Type::get_int_type().get_vector_of_elements(8);
-        }
-    }
-
     AVX2VectorLowering::AVX2VectorLowering()
         : _vectorizer(TL::Vectorization::Vectorizer::get_vectorizer()),
         _vector_length(AVX2_VECTOR_BYTE_SIZE)
@@ -118,6 +112,29 @@ namespace Vectorization
         std::cerr << "--- AVX2 backend phase ---" << std::endl;
     }
 
+    void AVX2VectorLowering::visit(const Nodecl::FunctionCode& node)
+    {
+        walk(node.get_statements());
+
+        // Non-temporal stores are weakly-ordered
+        for (std::set<Nodecl::NodeclBase>::iterator it =
+                _store_fence_points.begin();
+                it != _store_fence_points.end();
+                it++)
+        {
+            TL::Source fence_src;
+            fence_src << "_mm_sfence()";
+
+            Nodecl::NodeclBase fence =
+                fence_src.parse_expression(it->retrieve_context());
+
+            it->append_sibling(Nodecl::ExpressionStatement::make(
+                        fence, it->get_locus()));
+        }
+
+        _store_fence_points.clear();
+    }
+
     std::string AVX2VectorLowering::get_casting_intrinsic(const TL::Type& type_from,
             const TL::Type& type_to,
             const locus_t* locus)
@@ -139,6 +156,21 @@ namespace Vectorization
                 }
             }
         }
+        else if (type_from.is_double())
+        {
+            if(!type_to.is_double())
+            {
+                if (type_to.is_float())
+                {
+                    result << AVX2_INTRIN_PREFIX << "_castpd_ps";
+                }
+                else if (type_to.is_signed_int() || type_to.is_unsigned_int())
+                {
+                    result << AVX2_INTRIN_PREFIX << "_castpd_si" <<
+                        AVX2_VECTOR_BIT_SIZE;
+                }
+            }
+        }
         else if (type_from.is_signed_int() || type_from.is_unsigned_int())
         {
             if ((!type_to.is_signed_int()) && (!type_to.is_unsigned_int()))
@@ -202,6 +234,21 @@ namespace Vectorization
                 "AVX2 Backend: Vector masks are not supported in AVX2 (node=%s).", \
                 ast_print_node_type((node).get_kind()))
 
+    // AVX2 has no mask registers. Masks are emulated with vectors of 32-bit
+    // or 64-bit lanes (all ones or all zeros), as wide as the elements they
+    // guard, and most operations are computed for all the lanes: only
+    // assignments, loads, stores and gathers honour the mask
+    void AVX2VectorLowering::check_emulated_mask(const Nodecl::NodeclBase& node,
+            const TL::Type& type)
+    {
+        if (type.get_size() != 4 && type.get_size() != 8)
+        {
+            fatal_printf_at(node.get_locus(),
+                    "AVX2 Lowering: Node %s at %s is masked but its elements are neither 4 nor 8 bytes long.",
+                    ast_print_node_type(node.get_kind()),
+                    locus_to_str(node.get_locus()));
+        }
+    }
 
     void AVX2VectorLowering::common_binary_op_lowering(const Nodecl::NodeclBase& node,
             const std::string& intrin_op_name)
@@ -211,10 +258,6 @@ namespace Vectorization
         const Nodecl::NodeclBase lhs = binary_node.get_lhs();
         const Nodecl::NodeclBase rhs = binary_node.get_rhs();
         const Nodecl::NodeclBase mask = binary_node.get_mask();
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = binary_node.get_type().basic_type();
 
@@ -268,8 +311,26 @@ namespace Vectorization
         walk(lhs);
         walk(rhs);
 
-        args << cast_operand << as_expression(lhs) << ", " << cast_operand
-             << as_expression(rhs);
+        TL::Source rhs_expression;
+        if (!mask.is_null() && type.is_integral_type()
+                && (intrin_op_name == "div" || intrin_op_name == "rem"))
+        {
+            // Inactive lanes divide by 1 so they cannot trap
+            check_emulated_mask(node, type);
+            walk(mask);
+
+            rhs_expression << AVX2_INTRIN_PREFIX << "_blendv_epi8("
+                << AVX2_INTRIN_PREFIX
+                << (type.get_size() == 8 ? "_set1_epi64x(1), " : "_set1_epi32(1), ")
+                << cast_operand << as_expression(rhs) << ", "
+                << as_expression(mask) << ")";
+        }
+        else
+        {
+            rhs_expression << cast_operand << as_expression(rhs);
+        }
+
+        args << cast_operand << as_expression(lhs) << ", " << rhs_expression;
 
         Nodecl::NodeclBase function_call =
             intrin_src.parse_expression(node.retrieve_context());
@@ -283,12 +344,6 @@ namespace Vectorization
         const Nodecl::VectorRsqrt& unary_node = node.as<Nodecl::VectorRsqrt>();
 
         const Nodecl::NodeclBase rhs = unary_node.get_rhs();
-        const Nodecl::NodeclBase mask = unary_node.get_mask();
-
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = unary_node.get_type().basic_type();
 
@@ -347,12 +402,6 @@ namespace Vectorization
 
         const Nodecl::NodeclBase lhs = binary_node.get_lhs();
         const Nodecl::NodeclBase rhs = binary_node.get_rhs();
-        const Nodecl::NodeclBase mask = binary_node.get_mask();
-
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = binary_node.get_type().basic_type();
 
@@ -452,12 +501,6 @@ namespace Vectorization
         const Nodecl::NodeclBase first_op = node.get_first_op();
         const Nodecl::NodeclBase second_op = node.get_second_op();
         const Nodecl::NodeclBase third_op = node.get_third_op();
-        const Nodecl::NodeclBase mask = node.get_mask();
-
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = node.get_type().basic_type();
 
@@ -536,6 +579,12 @@ namespace Vectorization
             cmp_flavor << ", " << AVX2Comparison::LT_OS;
             turn = false;
         }
+        else if (type.is_double())
+        {
+            intrin_name << "_pd";
+            cmp_flavor << ", " << AVX2Comparison::LT_OS;
+            turn = false;
+        }
         else if (type.is_signed_int() ||
                 type.is_unsigned_int())
         {
@@ -598,6 +647,12 @@ namespace Vectorization
             cmp_flavor << ", " << AVX2Comparison::LE_OS;
             turn = false;
         }
+        else if (type.is_double())
+        {
+            cmp_intrin_suffix << "_pd";
+            cmp_flavor << ", " << AVX2Comparison::LE_OS;
+            turn = false;
+        }
         else if (type.is_signed_int() ||
                 type.is_unsigned_int())
         {
@@ -669,6 +724,11 @@ namespace Vectorization
             intrin_name << "_ps";
             cmp_flavor << ", " << AVX2Comparison::GT_OS;
         }
+        else if (type.is_double())
+        {
+            intrin_name << "_pd";
+            cmp_flavor << ", " << AVX2Comparison::GT_OS;
+        }
         else if (type.is_signed_int() ||
                 type.is_unsigned_int())
         {
@@ -717,6 +777,12 @@ namespace Vectorization
             cmp_flavor << ", " << AVX2Comparison::GE_OS;
             turn = false;
         }
+        else if (type.is_double())
+        {
+            cmp_intrin_suffix << "_pd";
+            cmp_flavor << ", " << AVX2Comparison::GE_OS;
+            turn = false;
+        }
         else if (type.is_signed_int() ||
                 type.is_unsigned_int())
         {
@@ -788,6 +854,11 @@ namespace Vectorization
             intrin_name << "_ps";
             cmp_flavor << ", " << AVX2Comparison::EQ_OQ;
         }
+        else if (type.is_double())
+        {
+            intrin_name << "_pd";
+            cmp_flavor << ", " << AVX2Comparison::EQ_OQ;
+        }
         else if (type.is_signed_int() ||
                 type.is_unsigned_int())
         {
@@ -836,6 +907,12 @@ namespace Vectorization
             cmp_flavor << ", " << AVX2Comparison::NEQ_UQ;
             turn = false;
         }
+        else if (type.is_double())
+        {
+            cmp_intrin_suffix << "_pd";
+            cmp_flavor << ", " << AVX2Comparison::NEQ_UQ;
+            turn = false;
+        }
         else if (type.is_signed_int() ||
                 type.is_unsigned_int())
         {
@@ -911,12 +988,6 @@ namespace Vectorization
     {
         const Nodecl::NodeclBase lhs = node.get_lhs();
         const Nodecl::NodeclBase rhs = node.get_rhs();
-        const Nodecl::NodeclBase mask = node.get_mask();
-
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = node.get_type().basic_type();
 
@@ -983,12 +1054,6 @@ namespace Vectorization
     {
         const Nodecl::NodeclBase lhs = node.get_lhs();
         const Nodecl::NodeclBase rhs = node.get_rhs();
-        const Nodecl::NodeclBase mask = node.get_mask();
-
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = node.get_type().basic_type();
 
@@ -1057,12 +1122,6 @@ namespace Vectorization
     {
         const Nodecl::NodeclBase lhs = node.get_lhs();
         const Nodecl::NodeclBase rhs = node.get_rhs();
-        const Nodecl::NodeclBase mask = node.get_mask();
-
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = node.get_type().basic_type();
 
@@ -1158,12 +1217,6 @@ namespace Vectorization
         const Nodecl::NodeclBase left_vector = node.get_left_vector();
         const Nodecl::NodeclBase right_vector = node.get_right_vector();
         const Nodecl::NodeclBase num_elements = node.get_num_elements();
-        const Nodecl::NodeclBase mask = node.get_mask();
-
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
 
         TL::Type type = node.get_type().basic_type();
 
@@ -1207,6 +1260,91 @@ namespace Vectorization
         node.replace(function_call);
     }
 
+    // Each source is permuted with vpermps and the lanes taken from it are
+    // blended into the result. 64-bit elements are moved as pairs of 32-bit
+    // lanes
+    void AVX2VectorLowering::visit(const Nodecl::VectorShuffle& node)
+    {
+        const Nodecl::List sources = node.get_sources().as<Nodecl::List>();
+        const Nodecl::List indexes = node.get_indexes().as<Nodecl::List>();
+
+        TL::Type type = node.get_type().basic_type();
+        TL::Type float_type = TL::Type::get_float_type();
+
+        const int num_elements = indexes.size();
+        const int lanes_per_element = type.get_size() / 4;
+
+        walk(sources);
+
+        std::string result;
+        int source_number = 0;
+        for (Nodecl::List::const_iterator source = sources.begin();
+                source != sources.end();
+                source++, source_number++)
+        {
+            std::stringstream permutation_indexes;
+            unsigned int blend_mask = 0;
+
+            int lane = 0;
+            for (Nodecl::List::const_iterator index = indexes.begin();
+                    index != indexes.end();
+                    index++)
+            {
+                const int element = const_value_cast_to_signed_int(
+                        index->get_constant());
+
+                for (int i = 0; i < lanes_per_element; i++, lane++)
+                {
+                    int lane_index = 0;
+                    if (element / num_elements == source_number)
+                    {
+                        lane_index = (element % num_elements) * lanes_per_element + i;
+                        blend_mask |= 1 << lane;
+                    }
+
+                    permutation_indexes << (lane == 0 ? "" : ", ") << lane_index;
+                }
+            }
+
+            // Nothing is taken from this source
+            if (blend_mask == 0)
+                continue;
+
+            std::stringstream permutation;
+            permutation << AVX2_INTRIN_PREFIX << "_permutevar8x32_ps("
+                << get_casting_intrinsic(type, float_type, node.get_locus())
+                << "(" << as_expression(*source) << "), "
+                << AVX2_INTRIN_PREFIX << "_setr_epi32(" << permutation_indexes.str() << "))"
+                ;
+
+            if (result.empty())
+            {
+                result = permutation.str();
+            }
+            else
+            {
+                std::stringstream blend;
+                blend << AVX2_INTRIN_PREFIX << "_blend_ps("
+                    << result << ", "
+                    << permutation.str() << ", "
+                    << blend_mask << ")"
+                    ;
+
+                result = blend.str();
+            }
+        }
+
+        TL::Source intrin_src;
+        intrin_src << get_casting_intrinsic(float_type, type, node.get_locus())
+            << "(" << result << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(function_call);
+    }
+
     void AVX2VectorLowering::visit(const Nodecl::VectorNeg& node)
     {
         Nodecl::NodeclBase rhs = node.get_rhs();
@@ -1581,12 +1719,79 @@ namespace Vectorization
             ;
 
         walk(lhs);
+        walk(rhs);
 
-        //            if (mask.is_null())
+        if (mask.is_null())
         {
-            walk(rhs);
             args << as_expression(rhs);
         }
+        else
+        {
+            // Inactive lanes keep the old value of the destination
+            check_emulated_mask(node, type);
+            walk(mask);
+
+            intrin_name << AVX2_INTRIN_PREFIX << "_blendv_";
+
+            if (type.is_float())
+                intrin_name << "ps";
+            else if (type.is_double())
+                intrin_name << "pd";
+            else if (type.is_integral_type())
+                intrin_name << "epi8";
+
+            args << as_expression(lhs)
+                << ", "
+                << as_expression(rhs)
+                << ", "
+                << get_casting_intrinsic(TL::Type::get_int_type(), type, node.get_locus())
+                << "(" << as_expression(mask) << ")"
+                ;
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(function_call);
+    }
+
+    void AVX2VectorLowering::visit(const Nodecl::VectorPrefetch& node)
+    {
+        Nodecl::NodeclBase address = node.get_address();
+        PrefetchKind kind = (PrefetchKind) const_value_cast_to_signed_int(
+                node.get_prefetch_kind().as<Nodecl::IntegerLiteral>().get_constant());
+
+        TL::Source intrin_src, prefetch_hint;
+
+        switch(kind)
+        {
+            case PrefetchKind::L1_READ :
+                prefetch_hint << "_MM_HINT_T0";
+                break;
+            case PrefetchKind::L2_READ :
+                prefetch_hint << "_MM_HINT_T1";
+                break;
+            case PrefetchKind::L1_WRITE:
+                prefetch_hint << "_MM_HINT_ET0";
+                break;
+            case PrefetchKind::L2_WRITE:
+                prefetch_hint << "_MM_HINT_ET1";
+                break;
+            default:
+                internal_error("AVX2 Backend: Node %s at %s has a wrong prefetch kind.",
+                        ast_print_node_type(node.get_kind()),
+                        locus_to_str(node.get_locus()));
+        }
+
+        walk(address);
+
+        intrin_src << "_mm_prefetch("
+            << "(const char *)"
+            << as_expression(address)
+            << ", "
+            << prefetch_hint
+            << ")"
+            ;
 
         Nodecl::NodeclBase function_call =
             intrin_src.parse_expression(node.retrieve_context());
@@ -1601,12 +1806,74 @@ namespace Vectorization
         bool aligned = !flags.find_first<Nodecl::AlignedFlag>().
             is_null();
 
-        if (aligned)
+        if (!node.get_mask().is_null())
+            visit_masked_vector_load(node);
+        else if (aligned)
             visit_aligned_vector_load(node);
         else
             visit_unaligned_vector_load(node);
     }
 
+    void AVX2VectorLowering::visit_masked_vector_load(const Nodecl::VectorLoad& node)
+    {
+        Nodecl::NodeclBase rhs = node.get_rhs();
+        Nodecl::NodeclBase mask = node.get_mask();
+
+        TL::Type type = node.get_type().basic_type();
+
+        TL::Source intrin_src, intrin_type_suffix, casting_args;
+
+        // maskload does not fault on inactive lanes and sets them to zero
+        intrin_src << AVX2_INTRIN_PREFIX << "_maskload_"
+            << intrin_type_suffix
+            << "("
+            << casting_args
+            << as_expression(rhs)
+            << ", "
+            << as_expression(mask)
+            << ")"
+            ;
+
+        check_emulated_mask(node, type);
+
+        if (type.is_float())
+        {
+            intrin_type_suffix << "ps";
+            casting_args << get_casting_to_scalar_pointer(type);
+        }
+        else if (type.is_double())
+        {
+            intrin_type_suffix << "pd";
+            casting_args << get_casting_to_scalar_pointer(type);
+        }
+        else if (type.is_integral_type() && type.get_size() == 8)
+        {
+            intrin_type_suffix << "epi64";
+            casting_args << get_casting_to_scalar_pointer(
+                    TL::Type::get_long_long_int_type());
+        }
+        else if (type.is_integral_type())
+        {
+            intrin_type_suffix << "epi32";
+            casting_args << get_casting_to_scalar_pointer(TL::Type::get_int_type());
+        }
+        else
+        {
+            fatal_printf_at(node.get_locus(),
+                    "AVX2 Lowering: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(node.get_kind()),
+                    locus_to_str(node.get_locus()));
+        }
+
+        walk(rhs);
+        walk(mask);
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(function_call);
+    }
+
     void AVX2VectorLowering::visit_aligned_vector_load(const Nodecl::VectorLoad& node)
     {
         Nodecl::NodeclBase rhs = node.get_rhs();
@@ -1743,13 +2010,86 @@ namespace Vectorization
 
         bool aligned = !flags.find_first<Nodecl::AlignedFlag>().
             is_null();
+        bool stream = !flags.find_first<Nodecl::NontemporalFlag>().
+            is_null();
 
-        if (aligned)
+        // Stream stores have neither masked nor unaligned forms.
+        // Emit a regular store instead
+        if (!node.get_mask().is_null())
+            visit_masked_vector_store(node);
+        else if (aligned && stream)
+            visit_aligned_vector_stream_store(node);
+        else if (aligned)
             visit_aligned_vector_store(node);
         else
             visit_unaligned_vector_store(node);
     }
 
+    void AVX2VectorLowering::visit_masked_vector_store(const Nodecl::VectorStore& node)
+    {
+        Nodecl::NodeclBase lhs = node.get_lhs();
+        Nodecl::NodeclBase rhs = node.get_rhs();
+        Nodecl::NodeclBase mask = node.get_mask();
+
+        TL::Type type = node.get_lhs().get_type().basic_type();
+
+        TL::Source intrin_src, intrin_type_suffix, casting_args;
+
+        // Unlike a blend followed by a full store, maskstore does not write
+        // the inactive lanes, so it is safe even if other threads write them
+        intrin_src << AVX2_INTRIN_PREFIX << "_maskstore_"
+            << intrin_type_suffix
+            << "("
+            << casting_args
+            << as_expression(lhs)
+            << ", "
+            << as_expression(mask)
+            << ", "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        check_emulated_mask(node, type);
+
+        if (type.is_float())
+        {
+            intrin_type_suffix << "ps";
+            casting_args << get_casting_to_scalar_pointer(type);
+        }
+        else if (type.is_double())
+        {
+            intrin_type_suffix << "pd";
+            casting_args << get_casting_to_scalar_pointer(type);
+        }
+        else if (type.is_integral_type() && type.get_size() == 8)
+        {
+            intrin_type_suffix << "epi64";
+            casting_args << get_casting_to_scalar_pointer(
+                    TL::Type::get_long_long_int_type());
+        }
+        else if (type.is_integral_type())
+        {
+            intrin_type_suffix << "epi32";
+            casting_args << get_casting_to_scalar_pointer(TL::Type::get_int_type());
+        }
+        else
+        {
+            fatal_printf_at(node.get_locus(),
+                    "AVX2 Lowering: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(node.get_kind()),
+                    locus_to_str(node.get_locus()));
+        }
+
+        walk(lhs);
+        walk(rhs);
+        walk(mask);
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(function_call);
+    }
+
     void AVX2VectorLowering::visit_aligned_vector_store(
             const Nodecl::VectorStore& node)
     {
@@ -1824,6 +2164,65 @@ namespace Vectorization
         node.replace(function_call);
     }
 
+    void AVX2VectorLowering::visit_aligned_vector_stream_store(
+            const Nodecl::VectorStore& node)
+    {
+        Nodecl::NodeclBase lhs = node.get_lhs();
+        Nodecl::NodeclBase rhs = node.get_rhs();
+
+        TL::Type type = node.get_lhs().get_type().basic_type();
+
+        TL::Source intrin_src, intrin_type_suffix, casting_args;
+
+        intrin_src << AVX2_INTRIN_PREFIX << "_stream_"
+            << intrin_type_suffix
+            << "(("
+            << casting_args
+            << as_expression(lhs)
+            << "), "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        if (type.is_float())
+        {
+            intrin_type_suffix << "ps";
+            casting_args << get_casting_to_scalar_pointer(type);
+        }
+        else if (type.is_double())
+        {
+            intrin_type_suffix << "pd";
+            casting_args << get_casting_to_scalar_pointer(type);
+        }
+        else if (type.is_integral_type())
+        {
+            intrin_type_suffix << "si256";
+            casting_args << get_casting_to_scalar_pointer(
+                    TL::Type::get_long_long_int_type().get_vector_of_bytes(
+                        AVX2_VECTOR_BYTE_SIZE));
+        }
+        else
+        {
+            fatal_printf_at(node.get_locus(),
+                    "AVX2 Lowering: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(node.get_kind()),
+                    locus_to_str(node.get_locus()));
+        }
+
+        Nodecl::NodeclBase fence_point =
+            TL::Vectorization::Utils::get_store_fence_point(node);
+        if (!fence_point.is_null())
+            _store_fence_points.insert(fence_point);
+
+        walk(lhs);
+        walk(rhs);
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(function_call);
+    }
+
     void AVX2VectorLowering::visit_unaligned_vector_store(
             const Nodecl::VectorStore& node)
     {
@@ -1899,16 +2298,11 @@ namespace Vectorization
         const Nodecl::NodeclBase strides = node.get_strides();
         const Nodecl::NodeclBase mask = node.get_mask();
 
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
-
         TL::Type type = node.get_type().basic_type();
         TL::Type index_type = strides.get_type().basic_type();
 
         TL::Source intrin_src, intrin_name, intrin_op_name, intrin_type_suffix,
-            mask_prefix, args, mask_args;
+            mask_prefix, args, mask_args, casting_args, mask_param;
 
         intrin_src << intrin_name
             << "("
@@ -1932,7 +2326,8 @@ namespace Vectorization
         }
         else if (type.is_signed_int() || type.is_unsigned_int())
         {
-            intrin_type_suffix << "si" << AVX2_VECTOR_BIT_SIZE;
+            intrin_type_suffix << "epi32";
+            casting_args << get_casting_to_scalar_pointer(TL::Type::get_int_type());
         }
         else
         {
@@ -1950,14 +2345,28 @@ namespace Vectorization
                     locus_to_str(node.get_locus()));
         }
 
+        if (!mask.is_null())
+        {
+            // Inactive lanes are not loaded and are set to zero
+            walk(mask);
+
+            mask_prefix << "_mask";
+            mask_args << AVX2_INTRIN_PREFIX << "_setzero_"
+                << (type.is_float() ? "ps" : "si256") << "(), ";
+            mask_param << get_casting_intrinsic(TL::Type::get_int_type(), type, node.get_locus())
+                << "(" << as_expression(mask) << "), ";
+        }
+
         walk(base);
         walk(strides);
 
         args << mask_args
+            << casting_args
             << as_expression(base)
             << ", "
             << as_expression(strides)
             << ", "
+            << mask_param
             << type.get_size()
             ;
 
@@ -1977,30 +2386,18 @@ namespace Vectorization
         Nodecl::FunctionCall function_call =
             node.get_function_call().as<Nodecl::FunctionCall>();
 
-        const Nodecl::NodeclBase mask = node.get_mask();
         TL::Type vector_type = node.get_type();
         TL::Type scalar_type = vector_type.basic_type();
         Nodecl::List arguments = function_call.get_arguments().as<Nodecl::List>();
 
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
-
         walk(arguments);
         node.replace(function_call);
     }
 
     void AVX2VectorLowering::visit(const Nodecl::VectorFabs& node)
     {
-        const Nodecl::NodeclBase mask = node.get_mask();
         const Nodecl::NodeclBase argument = node.get_argument();
 
-        if (!mask.is_null())
-        {
-            UNSUPPORTED_MASK(node);
-        }
-
         TL::Type type = node.get_type().basic_type();
 
         TL::Source intrin_src, mask_prefix, mask_args;
@@ -2468,7 +2865,7 @@ namespace Vectorization
                 Nodecl::Assignment::make(
                     node.get_lhs(),
                     node.get_rhs(),
-                    avx2_comparison_type().get_lvalue_reference_to()));
+                    node.get_lhs().get_type().no_ref().get_lvalue_reference_to()));
     }
 
     void AVX2VectorLowering::visit(const Nodecl::VectorMaskNot& node)
@@ -2496,34 +2893,165 @@ namespace Vectorization
         UNSUPPORTED_MASK(node);
     }
 
+    void AVX2VectorLowering::common_mask_op_lowering(const Nodecl::NodeclBase& node,
+            const std::string& intrin_op_name,
+            const bool swap_operands)
+    {
+        const Nodecl::VectorMaskAnd& binary_node = node.as<Nodecl::VectorMaskAnd>();
+
+        Nodecl::NodeclBase first_op = binary_node.get_lhs();
+        Nodecl::NodeclBase second_op = binary_node.get_rhs();
+
+        if (swap_operands)
+            std::swap(first_op, second_op);
+
+        TL::Source intrin_src;
+
+        walk(first_op);
+        walk(second_op);
+
+        intrin_src << AVX2_INTRIN_PREFIX << "_" << intrin_op_name
+            << "_si" << AVX2_VECTOR_BIT_SIZE
+            << "("
+            << as_expression(first_op)
+            << ", "
+            << as_expression(second_op)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(function_call);
+    }
+
     void AVX2VectorLowering::visit(const Nodecl::VectorMaskAnd& node)
     {
-        UNSUPPORTED_MASK(node);
+        common_mask_op_lowering(node, "and");
     }
 
     void AVX2VectorLowering::visit(const Nodecl::VectorMaskOr& node)
     {
-        UNSUPPORTED_MASK(node);
+        common_mask_op_lowering(node, "or");
     }
 
     void AVX2VectorLowering::visit(const Nodecl::VectorMaskAnd1Not& node)
     {
-        UNSUPPORTED_MASK(node);
+        // ~lhs & rhs
+        common_mask_op_lowering(node, "andnot");
     }
 
     void AVX2VectorLowering::visit(const Nodecl::VectorMaskAnd2Not& node)
     {
-        UNSUPPORTED_MASK(node);
+        // lhs & ~rhs
+        common_mask_op_lowering(node, "andnot", /* swap_operands */ true);
     }
 
     void AVX2VectorLowering::visit(const Nodecl::VectorMaskXor& node)
     {
-        UNSUPPORTED_MASK(node);
+        common_mask_op_lowering(node, "xor");
     }
 
     void AVX2VectorLowering::visit(const Nodecl::MaskLiteral& node)
     {
-        UNSUPPORTED_MASK(node);
+        // The legalization has typed the literal with the lanes it guards
+        const unsigned int num_lanes = node.get_type().no_ref().vector_num_elements();
+        const uint64_t mask_bits = const_value_cast_to_8(node.get_constant());
+
+        TL::Source intrin_src, lanes;
+
+        intrin_src << AVX2_INTRIN_PREFIX
+            << (num_lanes == 4 ? "_set_epi64x(" : "_set_epi32(")
+            << lanes
+            << ")"
+            ;
+
+        // _mm256_set_epi32 and _mm256_set_epi64x take the last lane first
+        for (int i = num_lanes - 1; i >= 0; i--)
+        {
+            lanes.append_with_separator(((mask_bits >> i) & 1) ? "-1" : "0", ",");
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(function_call);
+    }
+
+    // 'mask != value' and 'mask == value' check whether lanes are active
+    // (e.g., before executing a masked block). The lanes are compressed to
+    // a bit mask so they are compared as the masks of AVX-512 and KNC
+    void AVX2VectorLowering::mask_comparison_lowering(const Nodecl::NodeclBase& node,
+            const std::string& op)
+    {
+        const Nodecl::Different& binary_node = node.as<Nodecl::Different>();
+
+        const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+        const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+
+        TL::Source intrin_src, lhs_bits, rhs_bits;
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << "(" << lhs_bits << " " << op << " " << rhs_bits << ")";
+
+        // One bit per lane: 64-bit lanes are compressed as doubles,
+        // so mask literals and bit masks agree
+        if (lhs.get_type().no_ref().is_vector())
+        {
+            const std::string suffix =
+                lhs.get_type().no_ref().basic_type().get_size() == 8 ? "pd" : "ps";
+            lhs_bits << AVX2_INTRIN_PREFIX << "_movemask_" << suffix << "("
+                << AVX2_INTRIN_PREFIX << "_castsi256_" << suffix << "("
+                << as_expression(lhs) << "))";
+        }
+        else
+            lhs_bits << as_expression(lhs);
+
+        if (rhs.get_type().no_ref().is_vector())
+        {
+            const std::string suffix =
+                rhs.get_type().no_ref().basic_type().get_size() == 8 ? "pd" : "ps";
+            rhs_bits << AVX2_INTRIN_PREFIX << "_movemask_" << suffix << "("
+                << AVX2_INTRIN_PREFIX << "_castsi256_" << suffix << "("
+                << as_expression(rhs) << "))";
+        }
+        else
+            rhs_bits << as_expression(rhs);
+
+        Nodecl::NodeclBase comparison =
+            intrin_src.parse_expression(node.retrieve_context());
+
+        node.replace(comparison);
+    }
+
+    void AVX2VectorLowering::visit(const Nodecl::Different& node)
+    {
+        if (node.get_lhs().get_type().no_ref().is_vector()
+                || node.get_rhs().get_type().no_ref().is_vector())
+        {
+            mask_comparison_lowering(node, "!=");
+        }
+        else
+        {
+            walk(node.get_lhs());
+            walk(node.get_rhs());
+        }
+    }
+
+    void AVX2VectorLowering::visit(const Nodecl::Equal& node)
+    {
+        if (node.get_lhs().get_type().no_ref().is_vector()
+                || node.get_rhs().get_type().no_ref().is_vector())
+        {
+            mask_comparison_lowering(node, "==");
+        }
+        else
+        {
+            walk(node.get_lhs());
+            walk(node.get_rhs());
+        }
     }
 
 }
@@ -31,6 +31,7 @@
 #include "tl-nodecl-base.hpp"
 #include "tl-nodecl-visitor.hpp"
 #include <list>
+#include <set>
 
 namespace TL
 {
@@ -71,12 +72,23 @@ namespace TL
                 const unsigned int _vector_length;
                 std::list<Nodecl::NodeclBase> _old_m512;
 
+                // Statements followed by a store fence
+                std::set<Nodecl::NodeclBase> _store_fence_points;
+
                 void common_binary_op_lowering(const Nodecl::NodeclBase& node,
                         const std::string& intrin_op_name);
                 void common_unary_op_lowering(const Nodecl::NodeclBase& node,
                         const std::string& intrin_op_name);
                 void bitwise_binary_op_lowering(const Nodecl::NodeclBase& node,
                         const std::string& intrin_op_name);
+                void common_mask_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& intrin_op_name,
+                        const bool swap_operands = false);
+                void mask_comparison_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& op);
+
+                void check_emulated_mask(const Nodecl::NodeclBase& node,
+                        const TL::Type& type);
 
                 std::string get_casting_intrinsic(const TL::Type& type_from,
                         const TL::Type& type_to,
@@ -85,8 +97,11 @@ namespace TL
 
                 void visit_aligned_vector_load(const Nodecl::VectorLoad& node);
                 void visit_unaligned_vector_load(const Nodecl::VectorLoad& node);
+                void visit_masked_vector_load(const Nodecl::VectorLoad& node);
                 void visit_aligned_vector_store(const Nodecl::VectorStore& node);
+                void visit_aligned_vector_stream_store(const Nodecl::VectorStore& node);
                 void visit_unaligned_vector_store(const Nodecl::VectorStore& node);
+                void visit_masked_vector_store(const Nodecl::VectorStore& node);
 
                 void visit_reduction_add_4bytes_elements(const Nodecl::VectorReductionAdd& node);
                 void visit_reduction_add_8bytes_elements(const Nodecl::VectorReductionAdd& node);
@@ -96,6 +111,7 @@ namespace TL
 
                 AVX2VectorLowering();
 
+                virtual void visit(const Nodecl::FunctionCode& node);
                 virtual void visit(const Nodecl::ObjectInit& node);
 
                 virtual void visit(const Nodecl::VectorAdd& node);
@@ -125,6 +141,7 @@ namespace TL
                 virtual void visit(const Nodecl::VectorArithmeticShr& node);
                 virtual void visit(const Nodecl::VectorBitwiseShr& node);
                 virtual void visit(const Nodecl::VectorAlignRight& node);
+                virtual void visit(const Nodecl::VectorShuffle& node);
 
                 virtual void visit(const Nodecl::VectorConversion& node);
                 virtual void visit(const Nodecl::VectorCast& node);
@@ -132,6 +149,7 @@ namespace TL
                 virtual void visit(const Nodecl::VectorPromotion& node);
                 virtual void visit(const Nodecl::VectorLiteral& node);
                 virtual void visit(const Nodecl::VectorAssignment& node);
+                virtual void visit(const Nodecl::VectorPrefetch& node);
                 virtual void visit(const Nodecl::VectorLoad& node);
                 virtual void visit(const Nodecl::VectorStore& node);
                 virtual void visit(const Nodecl::VectorGather& node);
@@ -156,6 +174,9 @@ namespace TL
                 virtual void visit(const Nodecl::VectorMaskXor& node);
 
                 virtual void visit(const Nodecl::MaskLiteral& node);
+
+                virtual void visit(const Nodecl::Different& node);
+                virtual void visit(const Nodecl::Equal& node);
         };
     }
 }
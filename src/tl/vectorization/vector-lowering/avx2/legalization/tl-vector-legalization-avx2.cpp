@@ -38,16 +38,24 @@ namespace TL
     namespace Vectorization
     {
         namespace {
-            TL::Type avx2_comparison_type()
+            // Masks have one all-ones or all-zeros lane per element. 4-lane
+            // masks guard doubles (or 64-bit integers) so their lanes are
+            // 64 bits long
+            TL::Type avx2_comparison_type(const TL::Type& mask_type)
             {
-                return TL::Type::get_int_type().get_vector_of_elements(8);
+                if (mask_type.get_mask_num_elements() == NUM_8B_ELEMENTS)
+                    return TL::Type::get_long_long_int_type().get_vector_of_elements(
+                            NUM_8B_ELEMENTS);
+
+                return TL::Type::get_int_type().get_vector_of_elements(
+                        NUM_4B_ELEMENTS);
             }
 
             void fix_mask_symbol(TL::Symbol sym)
             {
                 if (sym.get_type().is_mask())
                 {
-                    sym.set_type(avx2_comparison_type());
+                    sym.set_type(avx2_comparison_type(sym.get_type()));
                 }
             }
 
@@ -55,10 +63,11 @@ namespace TL
             {
                 // There is no mask type in SSE, __m128i is used instead
                 if (node.get_type().is_mask())
-                    node.set_type(avx2_comparison_type());
+                    node.set_type(avx2_comparison_type(node.get_type()));
                 else if (node.get_type().is_lvalue_reference()
                         && node.get_type().no_ref().is_mask())
-                    node.set_type(avx2_comparison_type().get_lvalue_reference_to());
+                    node.set_type(avx2_comparison_type(
+                                node.get_type().no_ref()).get_lvalue_reference_to());
             }
         }
 
@@ -233,6 +242,11 @@ namespace TL
 
         UNARY_MASK_OPS(VectorMaskNot)
 
+        void AVX2VectorLegalization::visit(const Nodecl::MaskLiteral& n)
+        {
+            fix_comparison_type(n);
+        }
+
         void AVX2VectorLegalization::visit(
             const Nodecl::VectorMaskConversion &node)
         {
@@ -64,6 +64,7 @@ namespace TL
 
                 virtual void visit(const Nodecl::VectorMaskNot& n);
                 virtual void visit(const Nodecl::VectorMaskConversion& n);
+                virtual void visit(const Nodecl::MaskLiteral& n);
         };
 
         class AVX2StrideVisitorConv : public Nodecl::NodeclVisitor<void>
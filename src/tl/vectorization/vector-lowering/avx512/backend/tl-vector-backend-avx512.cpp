@@ -0,0 +1,1999 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+  --------------------------------------------------------------------*/
+
+#include "tl-vector-backend-avx512.hpp"
+
+#include "tl-vectorization-prefetcher-common.hpp"
+#include "tl-vectorization-utils.hpp"
+#include "tl-source.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-optimizations.hpp"
+#include "cxx-cexpr.h"
+
+#include <sstream>
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    AVX512VectorBackend::AVX512VectorBackend(unsigned int vector_length)
+        : _vector_length(vector_length)
+    {
+        std::cerr << "--- AVX-512 backend phase ---" << std::endl;
+    }
+
+    std::string AVX512VectorBackend::get_intrin_prefix(const TL::Type& vector_type,
+            const Nodecl::NodeclBase& n)
+    {
+        const unsigned int vector_size = vector_type.no_ref().get_size();
+
+        if (vector_size > _vector_length)
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has a vector of %d bytes, "\
+                    "which is wider than the target vector length (%d bytes).",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    vector_size, _vector_length);
+        }
+
+        switch (vector_size)
+        {
+            case 16:
+                return "_mm";
+            case 32:
+                return "_mm256";
+            case 64:
+                return "_mm512";
+            default:
+                internal_error("AVX-512 Backend: Node %s at %s has an unsupported vector length: %d bytes.",
+                        ast_print_node_type(n.get_kind()),
+                        locus_to_str(n.get_locus()),
+                        vector_size);
+        }
+
+        return "";
+    }
+
+    std::string AVX512VectorBackend::get_type_suffix(const TL::Type& type,
+            const Nodecl::NodeclBase& n)
+    {
+        if (type.is_float())
+            return "ps";
+        else if (type.is_double())
+            return "pd";
+
+        return get_integer_suffix(type, n);
+    }
+
+    std::string AVX512VectorBackend::get_integer_suffix(const TL::Type& type,
+            const Nodecl::NodeclBase& n)
+    {
+        std::stringstream result;
+
+        if (type.is_float())
+        {
+            result << "epi32";
+        }
+        else if (type.is_double())
+        {
+            result << "epi64";
+        }
+        else if (type.is_integral_type()
+                && (type.get_size() == 1 || type.get_size() == 2
+                    || type.get_size() == 4 || type.get_size() == 8))
+        {
+            result << "epi" << type.get_size() * 8;
+        }
+        else
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type: %s.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    type.get_simple_declaration(n.retrieve_context(), "").c_str());
+        }
+
+        return result.str();
+    }
+
+    std::string AVX512VectorBackend::get_casting_intrinsic(const TL::Type& type_from,
+            const TL::Type& type_to,
+            const TL::Type& vector_type,
+            const Nodecl::NodeclBase& n)
+    {
+        std::stringstream result, from, to;
+        const unsigned int vector_bit_size = vector_type.no_ref().get_size() * 8;
+
+        if (type_from.is_float())
+            from << "ps";
+        else if (type_from.is_double())
+            from << "pd";
+        else if (type_from.is_integral_type())
+            from << "si" << vector_bit_size;
+        else
+            fatal_error("AVX-512 Backend: casting intrinsic not supported");
+
+        if (type_to.is_float())
+            to << "ps";
+        else if (type_to.is_double())
+            to << "pd";
+        else if (type_to.is_integral_type())
+            to << "si" << vector_bit_size;
+        else
+            fatal_error("AVX-512 Backend: casting intrinsic not supported");
+
+        // No intrinsic is needed between vectors of the same register class
+        if (from.str() != to.str())
+        {
+            result << get_intrin_prefix(vector_type, n)
+                << "_cast" << from.str() << "_" << to.str();
+        }
+
+        return result.str();
+    }
+
+    std::string AVX512VectorBackend::get_setzero_intrinsic(const TL::Type& vector_type,
+            const Nodecl::NodeclBase& n)
+    {
+        std::stringstream result;
+        const TL::Type type = vector_type.no_ref().basic_type();
+
+        result << get_intrin_prefix(vector_type, n) << "_setzero_";
+
+        if (type.is_float())
+            result << "ps";
+        else if (type.is_double())
+            result << "pd";
+        else
+            result << "si" << vector_type.no_ref().get_size() * 8;
+
+        result << "()";
+
+        return result.str();
+    }
+
+    std::string AVX512VectorBackend::get_casting_to_pointer(const TL::Type& type_to)
+    {
+        std::stringstream result;
+
+        result << "("
+            << print_type_str(
+                    type_to.get_pointer_to().get_internal_type(),
+                    CURRENT_COMPILED_FILE->global_decl_context)
+            << ")";
+
+        return result.str();
+    }
+
+    TL::Type AVX512VectorBackend::get_integer_vector_type(const TL::Type& vector_type)
+    {
+        const TL::Type type = vector_type.no_ref().basic_type();
+        const unsigned int vector_size = vector_type.no_ref().get_size();
+
+        if (type.is_float())
+            return TL::Type::get_int_type().get_vector_of_bytes(vector_size);
+        else if (type.is_double())
+            return TL::Type::get_long_long_int_type().get_vector_of_bytes(vector_size);
+
+        return vector_type.no_ref();
+    }
+
+    std::string AVX512VectorBackend::get_mask_op_intrinsic(const TL::Type& mask_type,
+            const std::string& intrin_op_name)
+    {
+        std::stringstream result;
+        const int mask_num_elements = mask_type.no_ref().get_mask_num_elements();
+
+        // 16-bit mask operations are the only ones in AVX-512F
+        if (mask_num_elements == 16)
+            result << "_mm512_" << intrin_op_name;
+        else if (mask_num_elements <= 8)
+            result << "_" << intrin_op_name << "_mask8";
+        else
+            result << "_" << intrin_op_name << "_mask" << mask_num_elements;
+
+        return result.str();
+    }
+
+    // Masked operations merge into the old value of the assignment they belong to.
+    // If there is no old value, masked lanes are zeroed (maskz) instead
+    void AVX512VectorBackend::process_mask_component(const Nodecl::NodeclBase& mask,
+            TL::Source& mask_prefix, TL::Source& mask_args, const TL::Type& vector_type,
+            AVX512ConfigMaskProcessing conf)
+    {
+        if(mask.is_null())
+            return;
+
+        walk(mask);
+
+        if((conf & AVX512ConfigMaskProcessing::ONLY_MASK) ==
+                AVX512ConfigMaskProcessing::ONLY_MASK)
+        {
+            mask_prefix << "_mask";
+            mask_args << as_expression(mask);
+        }
+        else if (!_old_m512.empty())
+        {
+            mask_prefix << "_mask";
+            mask_args << "("
+                << print_type_str(
+                        vector_type.no_ref().get_internal_type(),
+                        mask.retrieve_context().get_decl_context())
+                << ")"
+                << as_expression(_old_m512.back())
+                << ", "
+                << as_expression(mask);
+
+            if ((conf & AVX512ConfigMaskProcessing::KEEP_OLD) !=
+                    AVX512ConfigMaskProcessing::KEEP_OLD)
+            { // DEFAULT
+                _old_m512.pop_back();
+            }
+        }
+        else
+        {
+            mask_prefix << "_maskz";
+            mask_args << as_expression(mask);
+        }
+
+        if((conf & AVX512ConfigMaskProcessing::NO_FINAL_COMMA) !=
+                AVX512ConfigMaskProcessing::NO_FINAL_COMMA)
+        {
+            mask_args << ", ";
+        }
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::FunctionCode& n)
+    {
+        bool contains_vector_nodes = TL::Vectorization::Utils::contains_vector_nodes(n);
+
+        if (contains_vector_nodes)
+        {
+            // Initialize analisys
+            TL::Optimizations::canonicalize_and_fold(
+                    n, /*_fast_math_enabled*/ false);
+
+            walk(n.get_statements());
+
+            // Non-temporal stores are weakly-ordered
+            for (std::set<Nodecl::NodeclBase>::iterator it =
+                    _store_fence_points.begin();
+                    it != _store_fence_points.end();
+                    it++)
+            {
+                TL::Source fence_src;
+                fence_src << "_mm_sfence()";
+
+                Nodecl::NodeclBase fence =
+                    fence_src.parse_expression(it->retrieve_context());
+
+                it->append_sibling(Nodecl::ExpressionStatement::make(
+                            fence, it->get_locus()));
+            }
+
+            _store_fence_points.clear();
+        }
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::ObjectInit& n)
+    {
+        if(n.has_symbol())
+        {
+            TL::Symbol sym = n.get_symbol();
+
+            // Vectorizing initialization
+            Nodecl::NodeclBase init = sym.get_value();
+            if(!init.is_null())
+            {
+                walk(init);
+            }
+        }
+    }
+
+    void AVX512VectorBackend::common_binary_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorAdd& binary_node = n.as<Nodecl::VectorAdd>();
+
+        const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+        const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+        const Nodecl::NodeclBase mask = binary_node.get_mask();
+
+        TL::Type vector_type = binary_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_"
+            << intrin_op_name
+            << "_"
+            << get_type_suffix(type, n)
+            ;
+
+        walk(lhs);
+        walk(rhs);
+
+        args << mask_args
+            << as_expression(lhs)
+            << ", "
+            << as_expression(rhs)
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::common_unary_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorRsqrt& unary_node = n.as<Nodecl::VectorRsqrt>();
+
+        const Nodecl::NodeclBase rhs = unary_node.get_rhs();
+        const Nodecl::NodeclBase mask = unary_node.get_mask();
+
+        TL::Type vector_type = unary_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        if (!type.is_floating_type())
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type: %s.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    type.get_simple_declaration(n.retrieve_context(), "").c_str());
+        }
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_"
+            << intrin_op_name
+            << "_"
+            << get_type_suffix(type, n)
+            ;
+
+        walk(rhs);
+
+        args << mask_args
+            << as_expression(rhs)
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorAdd& n)
+    {
+        common_binary_op_lowering(n, "add");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMinus& n)
+    {
+        common_binary_op_lowering(n, "sub");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMul& n)
+    {
+        TL::Type type = n.get_type().basic_type();
+
+        if (type.is_integral_type())
+        {
+            if (type.get_size() == 1)
+            {
+                internal_error("AVX-512 Backend: Node %s at %s has an unsupported type: 8-bit "\
+                        "multiplication is not available.",
+                        ast_print_node_type(n.get_kind()),
+                        locus_to_str(n.get_locus()));
+            }
+
+            common_binary_op_lowering(n, "mullo");
+        }
+        else
+            common_binary_op_lowering(n, "mul");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorDiv& n)
+    {
+        common_binary_op_lowering(n, "div");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorRcp& n)
+    {
+        common_unary_op_lowering(n, "rcp14");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMod& n)
+    {
+        common_binary_op_lowering(n, "rem");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorSqrt& n)
+    {
+        common_unary_op_lowering(n, "sqrt");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorRsqrt& n)
+    {
+        common_unary_op_lowering(n, "rsqrt14");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorFmadd& n)
+    {
+        const Nodecl::NodeclBase first_op = n.get_first_op();
+        const Nodecl::NodeclBase second_op = n.get_second_op();
+        const Nodecl::NodeclBase third_op = n.get_third_op();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        if (!type.is_floating_type())
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        // Masked lanes keep the value of the first operand
+        process_mask_component(mask, mask_prefix, mask_args, vector_type,
+                AVX512ConfigMaskProcessing::ONLY_MASK);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_fmadd_"
+            << get_type_suffix(type, n)
+            ;
+
+        walk(first_op);
+        walk(second_op);
+        walk(third_op);
+
+        args << as_expression(first_op)
+            << ", "
+            << mask_args
+            << as_expression(second_op)
+            << ", "
+            << as_expression(third_op)
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorNeg& n)
+    {
+        const Nodecl::NodeclBase rhs = n.get_rhs();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+        std::string prefix = get_intrin_prefix(vector_type, n);
+        std::string suffix = get_type_suffix(type, n);
+
+        walk(rhs);
+
+        if (type.is_floating_type())
+        {
+            // Flip the sign bit
+            intrin_name << prefix << mask_prefix << "_xor_" << suffix;
+
+            args << mask_args
+                << as_expression(rhs)
+                << ", "
+                << prefix << "_set1_" << suffix << "(" << (type.is_float() ? "-0.0f" : "-0.0") << ")"
+                ;
+        }
+        else if (type.is_integral_type())
+        {
+            intrin_name << prefix << mask_prefix << "_sub_" << suffix;
+
+            args << mask_args
+                << get_setzero_intrinsic(vector_type, n)
+                << ", "
+                << as_expression(rhs)
+                ;
+        }
+        else
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::common_comparison_op_lowering(
+            const Nodecl::NodeclBase& n,
+            const std::string& float_cmp_flavor,
+            const std::string& int_cmp_flavor)
+    {
+        Nodecl::VectorLowerThan cmp_node = n.as<Nodecl::VectorLowerThan>();
+
+        const Nodecl::NodeclBase lhs = cmp_node.get_lhs();
+        const Nodecl::NodeclBase rhs = cmp_node.get_rhs();
+        const Nodecl::NodeclBase mask = cmp_node.get_mask();
+
+        const TL::Type vector_type = lhs.get_type().no_ref();
+        const TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, intrin_type_suffix,
+            mask_prefix, args, mask_args, cmp_flavor;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type,
+                AVX512ConfigMaskProcessing::ONLY_MASK);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_cmp_"
+            << intrin_type_suffix
+            << "_mask"
+            ;
+
+        if (type.is_floating_type())
+        {
+            intrin_type_suffix << get_type_suffix(type, n);
+            cmp_flavor << float_cmp_flavor;
+        }
+        else if (type.is_unsigned_integral())
+        {
+            intrin_type_suffix << "epu" << type.get_size() * 8;
+            cmp_flavor << int_cmp_flavor;
+        }
+        else if (type.is_integral_type())
+        {
+            intrin_type_suffix << get_integer_suffix(type, n);
+            cmp_flavor << int_cmp_flavor;
+        }
+        else
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        walk(lhs);
+        walk(rhs);
+
+        args << mask_args
+            << as_expression(lhs)
+            << ", "
+            << as_expression(rhs)
+            << ", "
+            << cmp_flavor;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(cmp_node.retrieve_context());
+
+        cmp_node.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorLowerThan& n)
+    {
+        common_comparison_op_lowering(n, "_CMP_LT_OS", "_MM_CMPINT_LT");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorLowerOrEqualThan& n)
+    {
+        common_comparison_op_lowering(n, "_CMP_LE_OS", "_MM_CMPINT_LE");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorGreaterThan& n)
+    {
+        common_comparison_op_lowering(n, "_CMP_GT_OS", "_MM_CMPINT_NLE");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorGreaterOrEqualThan& n)
+    {
+        common_comparison_op_lowering(n, "_CMP_GE_OS", "_MM_CMPINT_NLT");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorEqual& n)
+    {
+        common_comparison_op_lowering(n, "_CMP_EQ_OQ", "_MM_CMPINT_EQ");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorDifferent& n)
+    {
+        common_comparison_op_lowering(n, "_CMP_NEQ_UQ", "_MM_CMPINT_NE");
+    }
+
+    // Bitwise operations work on the integer view of the vector.
+    // Only 32/64-bit elements have masked forms. 8/16-bit elements
+    // blend the unmasked result with a masked move (BW)
+    void AVX512VectorBackend::bitwise_binary_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorBitwiseAnd& binary_node = n.as<Nodecl::VectorBitwiseAnd>();
+
+        const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+        const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+        const Nodecl::NodeclBase mask = binary_node.get_mask();
+
+        TL::Type vector_type = binary_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+        TL::Type int_vector_type = get_integer_vector_type(vector_type);
+        TL::Type int_type = int_vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        std::string prefix = get_intrin_prefix(vector_type, n);
+        std::string to_int = get_casting_intrinsic(type, int_type, vector_type, n);
+
+        process_mask_component(mask, mask_prefix, mask_args, int_vector_type);
+
+        walk(lhs);
+        walk(rhs);
+
+        if (mask.is_null() || int_type.get_size() < 4)
+        {
+            intrin_name << prefix << "_" << intrin_op_name
+                << "_si" << vector_type.get_size() * 8;
+        }
+        else
+        {
+            intrin_name << prefix << mask_prefix << "_" << intrin_op_name
+                << "_" << get_integer_suffix(int_type, n);
+
+            args << mask_args;
+        }
+
+        args << to_int << "(" << as_expression(lhs) << ")"
+            << ", "
+            << to_int << "(" << as_expression(rhs) << ")"
+            ;
+
+        if (!mask.is_null() && int_type.get_size() < 4)
+        {
+            intrin_src << prefix << mask_prefix << "_mov_"
+                << get_integer_suffix(int_type, n)
+                << "(" << mask_args << intrin_name << "(" << args << "))";
+        }
+        else
+        {
+            intrin_src << get_casting_intrinsic(int_type, type, vector_type, n)
+                << "(" << intrin_name << "(" << args << "))";
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorBitwiseAnd& n)
+    {
+        bitwise_binary_op_lowering(n, "and");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorBitwiseOr& n)
+    {
+        bitwise_binary_op_lowering(n, "or");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorBitwiseXor& n)
+    {
+        bitwise_binary_op_lowering(n, "xor");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorBitwiseNot& n)
+    {
+        const Nodecl::NodeclBase rhs = n.get_rhs();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, not_src, mask_prefix, mask_args;
+
+        if (!type.is_integral_type())
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        std::string prefix = get_intrin_prefix(vector_type, n);
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+        walk(rhs);
+
+        // 0x55 is the truth table of ~C
+        not_src << prefix << "_ternarylogic_epi32("
+            << as_expression(rhs) << ", "
+            << as_expression(rhs) << ", "
+            << as_expression(rhs) << ", 0x55)"
+            ;
+
+        if (mask.is_null())
+        {
+            intrin_src << not_src;
+        }
+        else
+        {
+            intrin_src << prefix << mask_prefix << "_mov_"
+                << get_integer_suffix(type, n)
+                << "(" << mask_args << not_src << ")";
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::common_shift_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorBitwiseShl& shift_node = n.as<Nodecl::VectorBitwiseShl>();
+
+        const Nodecl::NodeclBase lhs = shift_node.get_lhs();
+        const Nodecl::NodeclBase rhs = shift_node.get_rhs();
+        const Nodecl::NodeclBase mask = shift_node.get_mask();
+
+        TL::Type vector_type = shift_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, intrin_op_suffix,
+            mask_prefix, args, mask_args, rhs_expression;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        if (!type.is_integral_type() || type.get_size() == 1)
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_"
+            << intrin_op_name
+            << intrin_op_suffix
+            << "_"
+            << get_integer_suffix(type, n)
+            ;
+
+        walk(lhs);
+
+        // Shift by immediate when all the lanes are shifted by the same amount
+        Nodecl::NodeclBase rhs_without_conversions = Nodecl::Utils::advance_conversions(rhs);
+        if (rhs_without_conversions.is<Nodecl::VectorPromotion>())
+        {
+            intrin_op_suffix << "i";
+            rhs_expression << as_expression(rhs_without_conversions.as<Nodecl::VectorPromotion>().get_rhs());
+        }
+        else
+        {
+            intrin_op_suffix << "v";
+            walk(rhs);
+            rhs_expression << as_expression(rhs);
+        }
+
+        args << mask_args
+            << "(" << as_expression(lhs) << ")"
+            << ", "
+            << "(" << rhs_expression << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorBitwiseShl& n)
+    {
+        common_shift_op_lowering(n, "sll");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorArithmeticShr& n)
+    {
+        common_shift_op_lowering(n, "sra");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorBitwiseShr& n)
+    {
+        common_shift_op_lowering(n, "srl");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorLogicalOr& n)
+    {
+        fatal_error("AVX-512 Backend %s: 'logical or' operation (i.e., operator '||') is not "\
+                "supported in AVX-512. Try using 'bitwise or' operations (i.e., operator '|') instead if possible.",
+                locus_to_str(n.get_locus()));
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorAlignRight& n)
+    {
+        const Nodecl::NodeclBase left_vector = n.get_left_vector();
+        const Nodecl::NodeclBase right_vector = n.get_right_vector();
+        const Nodecl::NodeclBase num_elements = n.get_num_elements();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+        TL::Type int_vector_type = get_integer_vector_type(vector_type);
+        TL::Type int_type = int_vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        if (type.get_size() != 4 && type.get_size() != 8)
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        std::string to_int = get_casting_intrinsic(type, int_type, vector_type, n);
+
+        intrin_src << get_casting_intrinsic(int_type, type, vector_type, n)
+            << "("
+            << intrin_name
+            << "("
+            << args
+            << "))"
+            ;
+
+        process_mask_component(mask, mask_prefix, mask_args, int_vector_type);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_alignr_"
+            << get_integer_suffix(int_type, n)
+            ;
+
+        walk(left_vector);
+        walk(right_vector);
+        walk(num_elements);
+
+        args << mask_args
+            << to_int << "(" << as_expression(left_vector) << ")"
+            << ", "
+            << to_int << "(" << as_expression(right_vector) << ")"
+            << ", "
+            << as_expression(num_elements)
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    // vpermps/vpermpd/vpermd/vpermq with the lanes of each further source
+    // merged under a write mask
+    void AVX512VectorBackend::visit(const Nodecl::VectorShuffle& n)
+    {
+        const Nodecl::List sources = n.get_sources().as<Nodecl::List>();
+        const Nodecl::List indexes = n.get_indexes().as<Nodecl::List>();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        // There are no 128-bit cross-lane permutations
+        if ((type.get_size() != 4 && type.get_size() != 8)
+                || vector_type.get_size() < 32)
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        const int num_elements = indexes.size();
+        const std::string prefix = get_intrin_prefix(vector_type, n);
+        const std::string suffix = get_type_suffix(type, n);
+
+        walk(sources);
+
+        std::string result;
+        int source_number = 0;
+        for (Nodecl::List::const_iterator source = sources.begin();
+                source != sources.end();
+                source++, source_number++)
+        {
+            // 64-bit indexes are written as pairs of 32-bit values
+            std::stringstream permutation_indexes;
+            unsigned int mask = 0;
+
+            int lane = 0;
+            for (Nodecl::List::const_iterator index = indexes.begin();
+                    index != indexes.end();
+                    index++, lane++)
+            {
+                const int element = const_value_cast_to_signed_int(
+                        index->get_constant());
+
+                int lane_index = 0;
+                if (element / num_elements == source_number)
+                {
+                    lane_index = element % num_elements;
+                    mask |= 1 << lane;
+                }
+
+                permutation_indexes << (lane == 0 ? "" : ", ") << lane_index;
+                if (type.get_size() == 8)
+                    permutation_indexes << ", 0";
+            }
+
+            // Nothing is taken from this source
+            if (mask == 0)
+                continue;
+
+            std::stringstream permutation;
+            if (result.empty())
+            {
+                permutation << prefix << "_permutexvar_" << suffix << "(";
+            }
+            else
+            {
+                // Lanes taken from this source overwrite the previous result
+                permutation << prefix << "_mask_permutexvar_" << suffix << "("
+                    << result << ", " << mask << ", ";
+            }
+
+            permutation << prefix << "_setr_epi32(" << permutation_indexes.str() << "), "
+                << as_expression(*source) << ")"
+                ;
+
+            result = permutation.str();
+        }
+
+        TL::Source intrin_src;
+        intrin_src << result;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorConversion& n)
+    {
+        const Nodecl::NodeclBase nest = n.get_nest();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        const TL::Type& src_vector_type = nest.get_type().get_unqualified_type().no_ref();
+        const TL::Type& dst_vector_type = n.get_type().get_unqualified_type().no_ref();
+        const TL::Type& src_type = src_vector_type.basic_type().get_unqualified_type();
+        const TL::Type& dst_type = dst_vector_type.basic_type().get_unqualified_type();
+        const int src_type_size = src_type.get_size();
+        const int dst_type_size = dst_type.get_size();
+
+        ERROR_CONDITION(src_vector_type.is_same_type(dst_vector_type),
+                "VectorConversion between same vector types: %s",
+                print_type_str(dst_vector_type.get_internal_type(),
+                    n.retrieve_context().get_decl_context()));
+
+        const unsigned int src_num_elements = src_vector_type.vector_num_elements();
+        const unsigned int dst_num_elements = dst_vector_type.vector_num_elements();
+
+        walk(nest);
+
+        // Signed <-> unsigned of the same size
+        if (src_type.is_integral_type() && dst_type.is_integral_type()
+                && (src_type_size == dst_type_size))
+        {
+            n.replace(nest);
+            return;
+        }
+
+        TL::Source intrin_src, intrin_name, intrin_op_name,
+            mask_prefix, args, mask_args;
+        std::stringstream src_name, dst_name;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        process_mask_component(mask, mask_prefix, mask_args, dst_vector_type);
+
+        // The intrinsic is named after the widest vector
+        intrin_name << get_intrin_prefix(
+                (src_vector_type.get_size() > dst_vector_type.get_size()) ?
+                src_vector_type : dst_vector_type, n)
+            << mask_prefix
+            << "_"
+            << intrin_op_name
+            ;
+
+        if (src_type.is_floating_type())
+            src_name << get_type_suffix(src_type, n);
+        // Narrowing integer conversions truncate, so they do not depend on the sign
+        else if (src_type.is_unsigned_integral()
+                && !(dst_type.is_integral_type() && dst_type_size < src_type_size))
+            src_name << "epu" << src_type_size * 8;
+        else if (src_type.is_integral_type())
+            src_name << get_integer_suffix(src_type, n);
+
+        if (dst_type.is_floating_type())
+            dst_name << get_type_suffix(dst_type, n);
+        // Only conversions from floating point to unsigned are sign-aware
+        else if (dst_type.is_unsigned_integral() && src_type.is_floating_type())
+            dst_name << "epu" << dst_type_size * 8;
+        else if (dst_type.is_integral_type())
+            dst_name << get_integer_suffix(dst_type, n);
+
+        // 8/16-bit integers only convert to integers
+        if (src_name.str().empty() || dst_name.str().empty()
+                || (src_type.is_integral_type() && src_type_size < 4 && !dst_type.is_integral_type())
+                || (dst_type.is_integral_type() && dst_type_size < 4 && !src_type.is_integral_type()))
+        {
+            internal_error("AVX-512 Backend: Conversion from '%s%d' to '%s%d' at '%s' is not supported yet: %s\n",
+                    src_type.get_simple_declaration(n.retrieve_context(), "").c_str(),
+                    src_num_elements,
+                    dst_type.get_simple_declaration(n.retrieve_context(), "").c_str(),
+                    dst_num_elements,
+                    locus_to_str(n.get_locus()),
+                    nest.prettyprint().c_str());
+        }
+
+        // C/C++ requires truncated conversion
+        if (src_type.is_floating_type() && dst_type.is_integral_type())
+            intrin_op_name << "cvtt";
+        else
+            intrin_op_name << "cvt";
+
+        intrin_op_name << src_name.str() << "_" << dst_name.str();
+
+        args << mask_args
+            << as_expression(nest)
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorCast& n)
+    {
+        const Nodecl::NodeclBase rhs = n.get_rhs();
+
+        const TL::Type& dst_vector_type = n.get_type().get_unqualified_type().no_ref();
+        const TL::Type& dst_type = dst_vector_type.basic_type().get_unqualified_type();
+        const TL::Type& src_type = rhs.get_type().basic_type().get_unqualified_type();
+
+        TL::Source intrin_src;
+
+        walk(rhs);
+
+        intrin_src
+            << get_casting_intrinsic(src_type, dst_type, dst_vector_type, n)
+            << "("
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorPromotion& n)
+    {
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src;
+
+        intrin_src << get_intrin_prefix(vector_type, n)
+            << "_set1_"
+            << get_type_suffix(type, n);
+
+        // 128/256-bit 64-bit integer broadcasts keep their SSE2/AVX names
+        if (type.is_integral_type() && type.get_size() == 8
+                && vector_type.get_size() < 64)
+            intrin_src << "x";
+
+        walk(n.get_rhs());
+
+        intrin_src << "(";
+        intrin_src << as_expression(n.get_rhs());
+        intrin_src << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorLiteral& n)
+    {
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type scalar_type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, undefined_value, values;
+
+        intrin_src << intrin_name
+            << "("
+            << values
+            << ")"
+            ;
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << "_set_"
+            << get_type_suffix(scalar_type, n);
+
+        if (scalar_type.is_integral_type() && scalar_type.get_size() == 8
+                && vector_type.get_size() < 64)
+            intrin_name << "x";
+
+        if (scalar_type.is_float())
+            undefined_value << "0.0f";
+        else if (scalar_type.is_double())
+            undefined_value << "0.0";
+        else
+            undefined_value << "0";
+
+        Nodecl::List scalar_values =
+            n.get_scalar_values().as<Nodecl::List>();
+
+        unsigned int num_undefined_values =
+            vector_type.get_size()/scalar_type.get_size() - vector_type.vector_num_elements();
+
+        for (unsigned int i=0; i<num_undefined_values; i++)
+        {
+            values.append_with_separator(undefined_value, ",");
+        }
+
+        for (Nodecl::List::const_iterator it = scalar_values.begin();
+                it != scalar_values.end();
+                it++)
+        {
+            walk((*it));
+            values.append_with_separator(as_expression(*it), ",");
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorConditionalExpression& n)
+    {
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        Nodecl::NodeclBase true_node = n.get_true();
+        Nodecl::NodeclBase false_node = n.get_false();
+        Nodecl::NodeclBase condition_node = n.get_condition();
+
+        TL::Source intrin_src;
+
+        intrin_src << get_intrin_prefix(vector_type, n)
+            << "_mask_blend_"
+            << get_type_suffix(type, n);
+
+        walk(false_node);
+        walk(true_node);
+        walk(condition_node);
+
+        intrin_src << "("
+            << as_expression(condition_node)
+            << ", "
+            << as_expression(false_node) // False first!
+            << ", "
+            << as_expression(true_node)
+            << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorAssignment& n)
+    {
+        Nodecl::NodeclBase lhs = n.get_lhs();
+        Nodecl::NodeclBase rhs = n.get_rhs();
+        Nodecl::NodeclBase mask = n.get_mask();
+        bool lhs_has_been_defined = !n.get_has_been_defined().is_null();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        intrin_src << as_expression(lhs)
+            << " = "
+            << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        walk(lhs);
+
+        if (mask.is_null() || !lhs_has_been_defined)
+        {
+            walk(rhs);
+            args << as_expression(rhs);
+        }
+        else
+        {
+            // LHS has old_value of rhs
+            _old_m512.push_back(lhs);
+
+            // Visit RHS with lhs as old
+            walk(rhs);
+
+            // Nodes that needs implicit mask move
+            if (!_old_m512.empty())
+            {
+                if (lhs != _old_m512.back())
+                {
+                    internal_error("AVX-512 Backend: Different old value and lhs "\
+                            "in assignment with mask mov. LHS node '%s'. Old '%s'. At %s",
+                            lhs.prettyprint().c_str(),
+                            _old_m512.back().prettyprint().c_str(),
+                            locus_to_str(n.get_locus()));
+                }
+
+                process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+                intrin_name << get_intrin_prefix(vector_type, n)
+                    << mask_prefix
+                    << "_mov_"
+                    << get_type_suffix(type, n)
+                    ;
+
+                args << mask_args << as_expression(rhs);
+            }
+            else
+            {
+                args << as_expression(rhs);
+            }
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorPrefetch& n)
+    {
+        Nodecl::NodeclBase address = n.get_address();
+        PrefetchKind kind = (PrefetchKind) const_value_cast_to_signed_int(
+                n.get_prefetch_kind().as<Nodecl::IntegerLiteral>().get_constant());
+
+        TL::Source intrin_src, prefetch_hint;
+
+        switch(kind)
+        {
+            case PrefetchKind::L1_READ :
+                prefetch_hint << "_MM_HINT_T0";
+                break;
+            case PrefetchKind::L2_READ :
+                prefetch_hint << "_MM_HINT_T1";
+                break;
+            case PrefetchKind::L1_WRITE:
+                prefetch_hint << "_MM_HINT_ET0";
+                break;
+            case PrefetchKind::L2_WRITE:
+                prefetch_hint << "_MM_HINT_ET1";
+                break;
+            default:
+                internal_error("AVX-512 Backend: Node %s at %s has a wrong prefetch kind.",
+                        ast_print_node_type(n.get_kind()),
+                        locus_to_str(n.get_locus()));
+        }
+
+        walk(address);
+
+        intrin_src << "_mm_prefetch("
+            << "(const char *)"
+            << as_expression(address)
+            << ", "
+            << prefetch_hint
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorLoad& n)
+    {
+        Nodecl::NodeclBase rhs = n.get_rhs();
+        Nodecl::NodeclBase mask = n.get_mask();
+        Nodecl::List flags = n.get_flags().as<Nodecl::List>();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        bool aligned = !flags.find_first<Nodecl::AlignedFlag>().is_null();
+
+        TL::Source intrin_src, intrin_name, intrin_type_suffix,
+            mask_prefix, args, mask_args, casting_args;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_load"
+            ;
+
+        if (type.is_floating_type())
+        {
+            if (!aligned)
+                intrin_name << "u";
+
+            intrin_type_suffix << get_type_suffix(type, n);
+        }
+        else if (type.is_integral_type())
+        {
+            // Masked 8/16-bit loads only exist unaligned
+            if (!aligned || (!mask.is_null() && type.get_size() < 4))
+                intrin_name << "u";
+
+            if (mask.is_null())
+            {
+                intrin_type_suffix << "si" << vector_type.get_size() * 8;
+                casting_args << get_casting_to_pointer(vector_type);
+            }
+            else
+            {
+                intrin_type_suffix << get_integer_suffix(type, n);
+                casting_args << get_casting_to_pointer(TL::Type::get_void_type());
+            }
+        }
+        else
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        intrin_name << "_" << intrin_type_suffix;
+
+        walk(rhs);
+
+        args << mask_args
+            << casting_args
+            << "("
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorStore& n)
+    {
+        Nodecl::NodeclBase lhs = n.get_lhs();
+        Nodecl::NodeclBase rhs = n.get_rhs();
+        Nodecl::NodeclBase mask = n.get_mask();
+        Nodecl::List flags = n.get_flags().as<Nodecl::List>();
+
+        TL::Type vector_type = rhs.get_type().no_ref();
+        TL::Type type = n.get_lhs().get_type().basic_type();
+
+        bool aligned = !flags.find_first<Nodecl::AlignedFlag>().
+            is_null();
+        bool stream = !flags.find_first<Nodecl::NontemporalFlag>().
+            is_null();
+
+        TL::Source intrin_src, intrin_name, intrin_type_suffix,
+            mask_prefix, args, mask_args, casting_args;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type,
+                AVX512ConfigMaskProcessing::ONLY_MASK);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            ;
+
+        // Stream stores have neither masked nor unaligned forms.
+        // Emit a regular store instead
+        if (stream && aligned && mask.is_null())
+        {
+            intrin_name << "_stream";
+
+            Nodecl::NodeclBase fence_point =
+                TL::Vectorization::Utils::get_store_fence_point(n);
+            if (!fence_point.is_null())
+                _store_fence_points.insert(fence_point);
+        }
+        else if (aligned && !(!mask.is_null() && type.get_size() < 4))
+            intrin_name << "_store";
+        else
+            intrin_name << "_storeu";
+
+        if (type.is_floating_type())
+        {
+            intrin_type_suffix << get_type_suffix(type, n);
+        }
+        else if (type.is_integral_type())
+        {
+            if (mask.is_null())
+            {
+                intrin_type_suffix << "si" << vector_type.get_size() * 8;
+                casting_args << get_casting_to_pointer(vector_type);
+            }
+            else
+            {
+                intrin_type_suffix << get_integer_suffix(type, n);
+                casting_args << get_casting_to_pointer(TL::Type::get_void_type());
+            }
+        }
+        else
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        intrin_name << "_" << intrin_type_suffix;
+
+        walk(lhs);
+        walk(rhs);
+
+        args << casting_args
+            << "("
+            << as_expression(lhs)
+            << "), "
+            << mask_args
+            << as_expression(rhs)
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorGather& n)
+    {
+        const Nodecl::NodeclBase base = n.get_base();
+        const Nodecl::NodeclBase strides = n.get_strides();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+        TL::Type index_type = strides.get_type().basic_type();
+
+        TL::Source intrin_src, intrin_name, args, old_value, scalar_pointer;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        if (type.get_size() != 4 && type.get_size() != 8)
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported source type: %s",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    type.get_simple_declaration(n.retrieve_context(), "").c_str());
+        }
+
+        if ((!index_type.is_signed_int()) && (!index_type.is_unsigned_int()))
+        {
+            internal_error("AVX-512 Backend: Node %s (%s) at %s has an unsupported index type: %s",
+                    base.prettyprint().c_str(),
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    index_type.get_simple_declaration(n.retrieve_context(), "").c_str());
+        }
+
+        std::string prefix = get_intrin_prefix(vector_type, n);
+        std::string suffix = get_type_suffix(type, n);
+
+        // Masked gathers have no zeroing form. Masked lanes take the old value
+        if (!mask.is_null())
+        {
+            if (_old_m512.empty())
+            {
+                old_value << get_setzero_intrinsic(vector_type, n);
+            }
+            else
+            {
+                old_value << "("
+                    << print_type_str(vector_type.get_internal_type(),
+                            n.retrieve_context().get_decl_context())
+                    << ")"
+                    << as_expression(_old_m512.back());
+
+                _old_m512.pop_back();
+            }
+
+            walk(mask);
+        }
+
+        walk(base);
+        walk(strides);
+
+        if (vector_type.get_size() == 64)
+        {
+            if (mask.is_null())
+            {
+                intrin_name << prefix << "_i32gather_" << suffix;
+            }
+            else
+            {
+                intrin_name << prefix << "_mask_i32gather_" << suffix;
+                args << old_value << ", " << as_expression(mask) << ", ";
+            }
+
+            args << as_expression(strides)
+                << ", "
+                << as_expression(base)
+                ;
+        }
+        else if (mask.is_null())
+        {
+            // 128/256-bit unmasked gathers are the AVX2 ones
+            if (type.is_float())
+                scalar_pointer << get_casting_to_pointer(TL::Type::get_float_type());
+            else if (type.is_double())
+                scalar_pointer << get_casting_to_pointer(TL::Type::get_double_type());
+            else if (type.get_size() == 4)
+                scalar_pointer << get_casting_to_pointer(TL::Type::get_int_type());
+            else
+                scalar_pointer << get_casting_to_pointer(TL::Type::get_long_long_int_type());
+
+            intrin_name << prefix << "_i32gather_" << suffix;
+
+            args << scalar_pointer << "(" << as_expression(base) << ")"
+                << ", "
+                << as_expression(strides)
+                ;
+        }
+        else
+        {
+            intrin_name << prefix << "_mmask_i32gather_" << suffix;
+
+            args << old_value
+                << ", "
+                << as_expression(mask)
+                << ", "
+                << as_expression(strides)
+                << ", "
+                << as_expression(base)
+                ;
+        }
+
+        args << ", " << type.get_size();
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorScatter& n)
+    {
+        const Nodecl::NodeclBase base = n.get_base();
+        const Nodecl::NodeclBase strides = n.get_strides();
+        const Nodecl::NodeclBase source = n.get_source();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = source.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+        TL::Type index_type = strides.get_type().basic_type();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, args, mask_args;
+
+        intrin_src << intrin_name
+            << "("
+            << args
+            << ")"
+            ;
+
+        if ((!index_type.is_signed_int()) && (!index_type.is_unsigned_int()))
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported index type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        if (type.get_size() != 4 && type.get_size() != 8)
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported source type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type,
+                AVX512ConfigMaskProcessing::ONLY_MASK);
+
+        intrin_name << get_intrin_prefix(vector_type, n)
+            << mask_prefix
+            << "_i32scatter_"
+            << get_type_suffix(type, n)
+            ;
+
+        walk(base);
+        walk(strides);
+        walk(source);
+
+        args << get_casting_to_pointer(TL::Type::get_void_type())
+            << "(" << as_expression(base) << ")"
+            << ", "
+            << mask_args
+            << as_expression(strides)
+            << ", "
+            << as_expression(source)
+            << ", "
+            << type.get_size()
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorFunctionCall& n)
+    {
+        Nodecl::FunctionCall function_call =
+            n.get_function_call().as<Nodecl::FunctionCall>();
+
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        // Masked vector functions receive the mask as an argument.
+        // Masked lanes are merged with the old value by the enclosing assignment
+        if (!mask.is_null())
+            walk(mask);
+
+        walk(function_call.get_arguments());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorFabs& n)
+    {
+        const Nodecl::NodeclBase mask = n.get_mask();
+        const Nodecl::NodeclBase argument = n.get_argument();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, mask_prefix, mask_args;
+
+        if (!type.is_floating_type())
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        std::string prefix = get_intrin_prefix(vector_type, n);
+        std::string suffix = get_type_suffix(type, n);
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type);
+
+        walk(argument);
+
+        // Clear the sign bit
+        intrin_src << prefix << mask_prefix << "_andnot_" << suffix << "("
+            << mask_args
+            << prefix << "_set1_" << suffix << "(" << (type.is_float() ? "-0.0f" : "-0.0") << "), "
+            << as_expression(argument)
+            << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::ParenthesizedExpression& n)
+    {
+        walk(n.get_nest());
+
+        Nodecl::NodeclBase new_n(n.shallow_copy());
+        new_n.set_type(n.get_nest().get_type());
+        n.replace(new_n);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorReductionAdd& n)
+    {
+        const Nodecl::NodeclBase vector_src = n.get_vector_src();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type type = n.get_type().no_ref();
+        TL::Type vector_type = vector_src.get_type().no_ref();
+
+        TL::Source intrin_src, intrin_name, mask_prefix, mask_args, src;
+
+        if (type.is_integral_type() && type.get_size() < 4)
+        {
+            internal_error("AVX-512 Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        process_mask_component(mask, mask_prefix, mask_args, vector_type,
+                AVX512ConfigMaskProcessing::ONLY_MASK);
+
+        // Reductions only exist for 512-bit vectors.
+        // Narrower vectors are zero-extended
+        intrin_name << "_mm512"
+            << mask_prefix
+            << "_reduce_add_"
+            << get_type_suffix(type, n)
+            ;
+
+        walk(vector_src);
+
+        if (vector_type.get_size() == 64)
+        {
+            src << as_expression(vector_src);
+        }
+        else
+        {
+            std::string from = type.is_float() ? "ps" : type.is_double() ? "pd" : "si";
+
+            src << "_mm512_zext" << from << vector_type.get_size() * 8
+                << "_" << from << "512"
+                << "(" << as_expression(vector_src) << ")";
+        }
+
+        intrin_src
+            << intrin_name
+            << "("
+            << mask_args
+            << src
+            << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorReductionMinus& n)
+    {
+        // OpenMP defines reduction(-:a) in the same way as reduction(+:a)
+        visit(n.as<Nodecl::VectorReductionAdd>());
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskAssignment& n)
+    {
+        TL::Source intrin_src, mask_cast;
+
+        TL::Type rhs_type = n.get_rhs().get_type();
+
+        if(rhs_type.is_integral_type())
+            mask_cast << "(" << n.get_lhs().get_type().no_ref().
+                get_simple_declaration(n.retrieve_context(), "") << ")";
+
+        walk(n.get_lhs());
+        walk(n.get_rhs());
+
+        intrin_src << as_expression(n.get_lhs())
+            << " = "
+            << "("
+            << mask_cast
+            << "("
+            << as_expression(n.get_rhs())
+            << "))"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskConversion& n)
+    {
+        walk(n.get_nest());
+
+        n.get_nest().set_type(n.get_type());
+
+        n.replace(n.get_nest());
+    }
+
+    void AVX512VectorBackend::common_mask_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name,
+            const bool swap_operands)
+    {
+        const Nodecl::VectorMaskAnd& binary_node = n.as<Nodecl::VectorMaskAnd>();
+
+        const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+        const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+
+        TL::Source intrin_src;
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << get_mask_op_intrinsic(n.get_type(), intrin_op_name)
+            << "("
+            << as_expression(swap_operands ? rhs : lhs)
+            << ", "
+            << as_expression(swap_operands ? lhs : rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskNot& n)
+    {
+        TL::Source intrin_src;
+
+        walk(n.get_rhs());
+
+        intrin_src << get_mask_op_intrinsic(n.get_type(), "knot")
+            << "("
+            << as_expression(n.get_rhs())
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskAnd& n)
+    {
+        common_mask_op_lowering(n, "kand");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskOr& n)
+    {
+        common_mask_op_lowering(n, "kor");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskAnd1Not& n)
+    {
+        // kandn computes (~lhs) & rhs
+        common_mask_op_lowering(n, "kandn");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskAnd2Not& n)
+    {
+        common_mask_op_lowering(n, "kandn", /* swap_operands */ true);
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::VectorMaskXor& n)
+    {
+        common_mask_op_lowering(n, "kxor");
+    }
+
+    void AVX512VectorBackend::visit(const Nodecl::MaskLiteral& n)
+    {
+        const int mask_num_elements = n.get_type().no_ref().get_mask_num_elements();
+        TL::Type int_mask_type;
+
+        if (mask_num_elements <= 8)
+            int_mask_type = TL::Type::get_unsigned_char_type();
+        else if (mask_num_elements == 16)
+            int_mask_type = TL::Type::get_unsigned_short_int_type();
+        else if (mask_num_elements == 32)
+            int_mask_type = TL::Type::get_unsigned_int_type();
+        else
+            int_mask_type = TL::Type::get_unsigned_long_long_int_type();
+
+        Nodecl::IntegerLiteral int_mask =
+            Nodecl::IntegerLiteral::make(
+                    int_mask_type,
+                    n.get_constant());
+
+        n.replace(int_mask);
+    }
+
+    Nodecl::NodeclVisitor<void>::Ret AVX512VectorBackend::unhandled_node(const Nodecl::NodeclBase& n)
+    {
+        internal_error("AVX-512 Backend: Unknown node %s at %s.",
+                ast_print_node_type(n.get_kind()),
+                locus_to_str(n.get_locus()));
+
+        return Ret();
+    }
+}
+}
@@ -0,0 +1,193 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#ifndef AVX512_VECTOR_BACKEND_HPP
+#define AVX512_VECTOR_BACKEND_HPP
+
+#include "tl-vectorizer.hpp"
+#include "tl-nodecl-base.hpp"
+#include "tl-nodecl-visitor.hpp"
+
+#include <list>
+#include <set>
+
+namespace TL
+{
+    namespace Vectorization
+    {
+        class AVX512ConfigMaskProcessing
+        {
+            public:
+                enum config_mask_processing_t
+                {
+                    MASK_DEFAULT = 0x0,
+                    ONLY_MASK = 0x1,        // Output string does not contain old_value
+                    KEEP_OLD = 0x2,         // Pop the current old_value in the stack
+                    NO_FINAL_COMMA = 0x8,   // Do not write a final ',' in the string 'mask_params'
+                } config_mask_processing;
+
+                AVX512ConfigMaskProcessing(int a)
+                {
+                    config_mask_processing = config_mask_processing_t(a);
+                }
+
+                config_mask_processing_t operator |(config_mask_processing_t b)
+                {
+                    return config_mask_processing_t(((int)this->config_mask_processing) | ((int)b));
+                }
+
+                config_mask_processing_t operator &(config_mask_processing_t b)
+                {
+                    return config_mask_processing_t(((int)this->config_mask_processing) & ((int)b));
+                }
+        };
+
+        // Lowers Vector IR to AVX-512F/VL/BW/DQ intrinsics (Skylake-SP and later).
+        // The width of each intrinsic is taken from the vector type of the node,
+        // so 512-bit code may still use 128/256-bit (VL) forms for narrower vectors
+        // and the whole function can be lowered to 256-bit vectors
+        class AVX512VectorBackend : public Nodecl::ExhaustiveVisitor<void>
+        {
+            private:
+                const unsigned int _vector_length;
+                std::list<Nodecl::NodeclBase> _old_m512;
+
+                // Statements followed by a store fence
+                std::set<Nodecl::NodeclBase> _store_fence_points;
+
+                void common_binary_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& intrin_op_name);
+                void common_unary_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& intrin_op_name);
+                void bitwise_binary_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& intrin_op_name);
+                void common_shift_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& intrin_op_name);
+                void common_comparison_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& float_cmp_flavor,
+                        const std::string& int_cmp_flavor);
+                void common_mask_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& intrin_op_name,
+                        const bool swap_operands = false);
+
+                std::string get_intrin_prefix(const TL::Type& vector_type,
+                        const Nodecl::NodeclBase& node);
+                std::string get_type_suffix(const TL::Type& type,
+                        const Nodecl::NodeclBase& node);
+                std::string get_integer_suffix(const TL::Type& type,
+                        const Nodecl::NodeclBase& node);
+                std::string get_casting_intrinsic(const TL::Type& type_from,
+                        const TL::Type& type_to,
+                        const TL::Type& vector_type,
+                        const Nodecl::NodeclBase& node);
+                std::string get_setzero_intrinsic(const TL::Type& vector_type,
+                        const Nodecl::NodeclBase& node);
+                std::string get_casting_to_pointer(const TL::Type& type_to);
+                std::string get_mask_op_intrinsic(const TL::Type& mask_type,
+                        const std::string& intrin_op_name);
+                TL::Type get_integer_vector_type(const TL::Type& vector_type);
+
+                void process_mask_component(const Nodecl::NodeclBase& mask,
+                        TL::Source& mask_prefix, TL::Source& mask_params,
+                        const TL::Type& vector_type,
+                        AVX512ConfigMaskProcessing conf = AVX512ConfigMaskProcessing::MASK_DEFAULT);
+
+            public:
+
+                AVX512VectorBackend(unsigned int vector_length);
+
+                virtual void visit(const Nodecl::FunctionCode& n);
+                virtual void visit(const Nodecl::ObjectInit& n);
+
+                virtual void visit(const Nodecl::VectorAdd& n);
+                virtual void visit(const Nodecl::VectorMinus& n);
+                virtual void visit(const Nodecl::VectorMul& n);
+                virtual void visit(const Nodecl::VectorDiv& n);
+                virtual void visit(const Nodecl::VectorRcp& n);
+                virtual void visit(const Nodecl::VectorMod& n);
+                virtual void visit(const Nodecl::VectorSqrt& n);
+                virtual void visit(const Nodecl::VectorRsqrt& n);
+
+                virtual void visit(const Nodecl::VectorFmadd& n);
+
+                virtual void visit(const Nodecl::VectorNeg& n);
+
+                virtual void visit(const Nodecl::VectorLowerThan& n);
+                virtual void visit(const Nodecl::VectorLowerOrEqualThan& n);
+                virtual void visit(const Nodecl::VectorGreaterThan& n);
+                virtual void visit(const Nodecl::VectorGreaterOrEqualThan& n);
+                virtual void visit(const Nodecl::VectorEqual& n);
+                virtual void visit(const Nodecl::VectorDifferent& n);
+
+                virtual void visit(const Nodecl::VectorBitwiseAnd& n);
+                virtual void visit(const Nodecl::VectorBitwiseOr& n);
+                virtual void visit(const Nodecl::VectorBitwiseXor& n);
+                virtual void visit(const Nodecl::VectorBitwiseNot& n);
+                virtual void visit(const Nodecl::VectorLogicalOr& n);
+                virtual void visit(const Nodecl::VectorBitwiseShl& n);
+                virtual void visit(const Nodecl::VectorArithmeticShr& n);
+                virtual void visit(const Nodecl::VectorBitwiseShr& n);
+                virtual void visit(const Nodecl::VectorAlignRight& n);
+                virtual void visit(const Nodecl::VectorShuffle& n);
+
+                virtual void visit(const Nodecl::VectorConversion& n);
+                virtual void visit(const Nodecl::VectorCast& n);
+                virtual void visit(const Nodecl::VectorConditionalExpression& n);
+                virtual void visit(const Nodecl::VectorPromotion& n);
+                virtual void visit(const Nodecl::VectorLiteral& n);
+                virtual void visit(const Nodecl::VectorAssignment& n);
+                virtual void visit(const Nodecl::VectorPrefetch& n);
+                virtual void visit(const Nodecl::VectorLoad& n);
+                virtual void visit(const Nodecl::VectorStore& n);
+                virtual void visit(const Nodecl::VectorGather& n);
+                virtual void visit(const Nodecl::VectorScatter& n);
+
+                virtual void visit(const Nodecl::VectorFunctionCall& n);
+                virtual void visit(const Nodecl::VectorFabs& n);
+
+                virtual void visit(const Nodecl::ParenthesizedExpression& n);
+
+                virtual void visit(const Nodecl::VectorReductionAdd& n);
+                virtual void visit(const Nodecl::VectorReductionMinus& n);
+
+                virtual void visit(const Nodecl::VectorMaskAssignment& n);
+                virtual void visit(const Nodecl::VectorMaskConversion& n);
+                virtual void visit(const Nodecl::VectorMaskOr& n);
+                virtual void visit(const Nodecl::VectorMaskAnd& n);
+                virtual void visit(const Nodecl::VectorMaskNot& n);
+                virtual void visit(const Nodecl::VectorMaskAnd1Not& n);
+                virtual void visit(const Nodecl::VectorMaskAnd2Not& n);
+                virtual void visit(const Nodecl::VectorMaskXor& n);
+
+                virtual void visit(const Nodecl::MaskLiteral& n);
+
+                virtual Nodecl::ExhaustiveVisitor<void>::Ret unhandled_node(
+                        const Nodecl::NodeclBase& n);
+        };
+    }
+}
+
+#endif // AVX512_VECTOR_BACKEND_HPP
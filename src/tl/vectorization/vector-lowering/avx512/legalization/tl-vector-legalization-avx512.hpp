@@ -0,0 +1,50 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#ifndef AVX512_VECTOR_LEGALIZATION_HPP
+#define AVX512_VECTOR_LEGALIZATION_HPP
+
+#include "tl-vector-legalization-knc.hpp"
+
+namespace TL
+{
+    namespace Vectorization
+    {
+        class AVX512VectorLegalization : public KNCVectorLegalization
+        {
+            public:
+
+                AVX512VectorLegalization(bool prefer_gather_scatter,
+                        bool prefer_mask_gather_scatter);
+
+                // AVX-512 converts between vectors of different
+                // lengths natively, so they are not widened as in KNC
+                virtual void visit(const Nodecl::VectorConversion& n);
+        };
+    }
+}
+
+#endif // AVX512_VECTOR_LEGALIZATION_HPP
@@ -312,5 +312,92 @@ namespace Vectorization
                 visit_common_vector_store(n, false /*aligned*/);
         }
     }
+
+    // vpermps/vpermpd/vpermd with the lanes of each further source merged
+    // under a write mask
+    void KNLVectorBackend::visit(const Nodecl::VectorShuffle& n)
+    {
+        const Nodecl::List sources = n.get_sources().as<Nodecl::List>();
+        const Nodecl::List indexes = n.get_indexes().as<Nodecl::List>();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        if (type.get_size() != 4 && type.get_size() != 8)
+        {
+            internal_error("KNL Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        const int num_elements = indexes.size();
+        const std::string prefix = KNL_INTRIN_PREFIX;
+        const std::string suffix = type.is_float() ? "ps"
+            : (type.is_double() ? "pd"
+                : (type.get_size() == 8 ? "epi64" : "epi32"));
+
+        walk(sources);
+
+        std::string result;
+        int source_number = 0;
+        for (Nodecl::List::const_iterator source = sources.begin();
+                source != sources.end();
+                source++, source_number++)
+        {
+            // 64-bit indexes are written as pairs of 32-bit values
+            std::stringstream permutation_indexes;
+            unsigned int mask = 0;
+
+            int lane = 0;
+            for (Nodecl::List::const_iterator index = indexes.begin();
+                    index != indexes.end();
+                    index++, lane++)
+            {
+                const int element = const_value_cast_to_signed_int(
+                        index->get_constant());
+
+                int lane_index = 0;
+                if (element / num_elements == source_number)
+                {
+                    lane_index = element % num_elements;
+                    mask |= 1 << lane;
+                }
+
+                permutation_indexes << (lane == 0 ? "" : ", ") << lane_index;
+                if (type.get_size() == 8)
+                    permutation_indexes << ", 0";
+            }
+
+            // Nothing is taken from this source
+            if (mask == 0)
+                continue;
+
+            std::stringstream permutation;
+            if (result.empty())
+            {
+                permutation << prefix << "_permutexvar_" << suffix << "(";
+            }
+            else
+            {
+                // Lanes taken from this source overwrite the previous result
+                permutation << prefix << "_mask_permutexvar_" << suffix << "("
+                    << result << ", " << mask << ", ";
+            }
+
+            permutation << prefix << "_setr_epi32(" << permutation_indexes.str() << "), "
+                << as_expression(*source) << ")"
+                ;
+
+            result = permutation.str();
+        }
+
+        TL::Source intrin_src;
+        intrin_src << result;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
 }
 }
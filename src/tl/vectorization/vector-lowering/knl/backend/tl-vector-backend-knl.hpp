@@ -47,6 +47,7 @@ namespace Vectorization
 
             virtual void visit(const Nodecl::VectorLoad& n);
             virtual void visit(const Nodecl::VectorStore& n);
+            virtual void visit(const Nodecl::VectorShuffle& n);
     };
 }
 }
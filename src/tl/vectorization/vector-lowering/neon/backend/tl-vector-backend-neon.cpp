@@ -254,6 +254,65 @@ namespace TL
         {
         }
 
+        // Lanes are moved one by one, starting from the first source
+        void NeonVectorBackend::visit(const Nodecl::VectorShuffle& n)
+        {
+            walk(n.get_sources());
+
+            TL::Type t = n.get_type();
+            ERROR_CONDITION(!t.is_vector(), "Invalid type", 0);
+            TL::Type element = t.vector_element();
+            ERROR_CONDITION(!element.is_float(), "Not implemented: %s", print_declarator(element.get_internal_type()));
+
+            TL::Symbol get_lane_fun = TL::Scope::get_global_scope().get_symbol_from_name("vgetq_lane_f32");
+            ERROR_CONDITION(!get_lane_fun.is_valid(), "Symbol not found", 0);
+            TL::Symbol set_lane_fun = TL::Scope::get_global_scope().get_symbol_from_name("vsetq_lane_f32");
+            ERROR_CONDITION(!set_lane_fun.is_valid(), "Symbol not found", 0);
+
+            const Nodecl::List sources = n.get_sources().as<Nodecl::List>();
+            const Nodecl::List indexes = n.get_indexes().as<Nodecl::List>();
+            const int num_elements = indexes.size();
+
+            Nodecl::NodeclBase result = sources.front().shallow_copy();
+
+            int lane = 0;
+            for (Nodecl::List::const_iterator index = indexes.begin();
+                    index != indexes.end();
+                    index++, lane++)
+            {
+                const int source_element = const_value_cast_to_signed_int(
+                        index->get_constant());
+
+                // Already in place
+                if (source_element == lane)
+                    continue;
+
+                Nodecl::NodeclBase get_lane = Nodecl::FunctionCall::make(
+                        get_lane_fun.make_nodecl(/* set_ref_type */ true),
+                        Nodecl::List::make(
+                            sources.at(source_element / num_elements).shallow_copy(),
+                            const_value_to_nodecl(const_value_get_signed_int(
+                                    source_element % num_elements))),
+                        /* alternate-name */ Nodecl::NodeclBase::null(),
+                        /* function-form */ Nodecl::NodeclBase::null(),
+                        element,
+                        n.get_locus());
+
+                result = Nodecl::FunctionCall::make(
+                        set_lane_fun.make_nodecl(/* set_ref_type */ true),
+                        Nodecl::List::make(
+                            get_lane,
+                            result,
+                            const_value_to_nodecl(const_value_get_signed_int(lane))),
+                        /* alternate-name */ Nodecl::NodeclBase::null(),
+                        /* function-form */ Nodecl::NodeclBase::null(),
+                        n.get_type(),
+                        n.get_locus());
+            }
+
+            n.replace(result);
+        }
+
         void NeonVectorBackend::visit(const Nodecl::VectorSqrt& n)
         {
         }
@@ -81,6 +81,7 @@ namespace TL
                 virtual void visit(const Nodecl::VectorRcp& n);
                 virtual void visit(const Nodecl::VectorRsqrt& n);
                 virtual void visit(const Nodecl::VectorScatter& n);
+                virtual void visit(const Nodecl::VectorShuffle& n);
                 virtual void visit(const Nodecl::VectorSqrt& n);
                 virtual void visit(const Nodecl::VectorStore& n);
                 // virtual void visit(const Nodecl::VectorSincos& n);
@@ -25,9 +25,12 @@
   --------------------------------------------------------------------*/
 
 #include "tl-vector-backend-sse.hpp"
+#include "tl-vectorization-prefetcher-common.hpp"
+#include "tl-vectorization-utils.hpp"
 #include "tl-nodecl-utils.hpp"
 #include "tl-source.hpp"
 
+#include "cxx-cexpr.h"
 #include "cxx-diagnostic.h"
 
 #define SSE_VECTOR_BIT_SIZE 128
@@ -44,6 +47,29 @@ namespace TL
             std::cerr << "--- SSE backend phase ---" << std::endl;
         }
 
+        void SSEVectorBackend::visit(const Nodecl::FunctionCode& node)
+        {
+            walk(node.get_statements());
+
+            // Non-temporal stores are weakly-ordered
+            for (std::set<Nodecl::NodeclBase>::iterator it =
+                    _store_fence_points.begin();
+                    it != _store_fence_points.end();
+                    it++)
+            {
+                TL::Source fence_src;
+                fence_src << "_mm_sfence()";
+
+                Nodecl::NodeclBase fence =
+                    fence_src.parse_expression(it->retrieve_context());
+
+                it->append_sibling(Nodecl::ExpressionStatement::make(
+                            fence, it->get_locus()));
+            }
+
+            _store_fence_points.clear();
+        }
+
         std::string SSEVectorBackend::get_casting_intrinsic(const TL::Type& type_from,
                 const TL::Type& type_to,
                 const locus_t* locus)
@@ -58,16 +84,32 @@ namespace TL
                     {
                         result << SSE_INTRIN_PREFIX << "_castps_pd";
                     }
-                    else if (type_to.is_signed_int() || type_to.is_unsigned_int())
+                    else if (type_to.is_integral_type())
                     {
                         result << SSE_INTRIN_PREFIX << "_castps_si" << 
                             SSE_VECTOR_BIT_SIZE;
                     }
                 }
             }
-            else if (type_from.is_signed_int() || type_from.is_unsigned_int())
+            else if (type_from.is_double())
             {
-                if ((!type_to.is_signed_int()) && (!type_to.is_unsigned_int()))
+                if(!type_to.is_double())
+                {
+                    if (type_to.is_float())
+                    {
+                        result << SSE_INTRIN_PREFIX << "_castpd_ps";
+                    }
+                    else if (type_to.is_integral_type())
+                    {
+                        result << SSE_INTRIN_PREFIX << "_castpd_si" <<
+                            SSE_VECTOR_BIT_SIZE;
+                    }
+                }
+            }
+            // Integer vectors are __m128i regardless of their element size
+            else if (type_from.is_integral_type())
+            {
+                if (!type_to.is_integral_type())
                 {
                     if (type_to.is_float())
                     {
@@ -351,6 +393,11 @@ namespace TL
                 casting << "(" << as_type(TL::Type::get_int_type().get_vector_of_elements(4)) << ")";
                 intrin_src << "_ps"; 
             } 
+            else if (type.is_double()) 
+            { 
+                casting << "(" << as_type(node.get_type()) << ")";
+                intrin_src << "_pd"; 
+            } 
             else if (type.is_signed_int() ||
                     type.is_unsigned_int()) 
             { 
@@ -405,6 +452,11 @@ namespace TL
                 casting << "(" << as_type(TL::Type::get_int_type().get_vector_of_elements(4)) << ")";
                 intrin_src << "_ps"; 
             } 
+            else if (type.is_double()) 
+            { 
+                casting << "(" << as_type(node.get_type()) << ")";
+                intrin_src << "_pd"; 
+            } 
             else if (type.is_signed_int() ||
                     type.is_unsigned_int()) 
             { 
@@ -459,6 +511,11 @@ namespace TL
                 casting << "(" << as_type(TL::Type::get_int_type().get_vector_of_elements(4)) << ")";
                 intrin_src << "_ps"; 
             } 
+            else if (type.is_double()) 
+            { 
+                casting << "(" << as_type(node.get_type()) << ")";
+                intrin_src << "_pd"; 
+            } 
             else if (type.is_signed_int() ||
                     type.is_unsigned_int()) 
             { 
@@ -513,6 +570,11 @@ namespace TL
                 casting << "(" << as_type(TL::Type::get_int_type().get_vector_of_elements(4)) << ")";
                 intrin_src << "_ps"; 
             } 
+            else if (type.is_double()) 
+            { 
+                casting << "(" << as_type(node.get_type()) << ")";
+                intrin_src << "_pd"; 
+            } 
             else if (type.is_signed_int() ||
                     type.is_unsigned_int()) 
             { 
@@ -567,6 +629,11 @@ namespace TL
                 casting << "(" << as_type(TL::Type::get_int_type().get_vector_of_elements(4)) << ")";
                 intrin_src << "_ps"; 
             } 
+            else if (type.is_double()) 
+            { 
+                casting << "(" << as_type(node.get_type()) << ")";
+                intrin_src << "_pd"; 
+            } 
             else if (type.is_signed_int() ||
                     type.is_unsigned_int()) 
             { 
@@ -614,7 +681,7 @@ namespace TL
 
             // Intrinsic name
             intrin_src
-                << "(" << as_type(TL::Type::get_int_type().get_vector_of_elements(4)) << ")"
+                << "(" << as_type(node.get_type()) << ")"
                 << "_mm_andnot_ps("
                 << casting << "_mm_cmpeq";
 
@@ -623,6 +690,11 @@ namespace TL
             { 
                 intrin_src << "_ps"; 
             } 
+            else if (type.is_double()) 
+            { 
+                casting << "(" << as_type(TL::Type::get_float_type().get_vector_of_elements(4)) << ")";
+                intrin_src << "_pd"; 
+            } 
             else if (type.is_signed_int() ||
                     type.is_unsigned_int()) 
             { 
@@ -858,6 +930,90 @@ namespace TL
             node.replace(function_call);
         }
 
+        // Each source is permuted with pshufb (SSSE3). Bytes not taken from
+        // that source are zeroed so the partial results can be or-ed
+        void SSEVectorBackend::visit(const Nodecl::VectorShuffle& node)
+        {
+            const Nodecl::List sources = node.get_sources().as<Nodecl::List>();
+            const Nodecl::List indexes = node.get_indexes().as<Nodecl::List>();
+
+            TL::Type type = node.get_type().basic_type();
+            TL::Type int_type = TL::Type::get_int_type();
+
+            const int num_elements = indexes.size();
+            const int element_size = type.get_size();
+
+            walk(sources);
+
+            std::string result;
+            int source_number = 0;
+            for (Nodecl::List::const_iterator source = sources.begin();
+                    source != sources.end();
+                    source++, source_number++)
+            {
+                std::stringstream shuffle_indexes;
+                bool is_used = false;
+
+                int byte = 0;
+                for (Nodecl::List::const_iterator index = indexes.begin();
+                        index != indexes.end();
+                        index++)
+                {
+                    const int element = const_value_cast_to_signed_int(
+                            index->get_constant());
+
+                    for (int i = 0; i < element_size; i++, byte++)
+                    {
+                        // Index with the highest bit set writes a zero
+                        int byte_index = -128;
+                        if (element / num_elements == source_number)
+                        {
+                            byte_index = (element % num_elements) * element_size + i;
+                            is_used = true;
+                        }
+
+                        shuffle_indexes << (byte == 0 ? "" : ", ") << byte_index;
+                    }
+                }
+
+                // Nothing is taken from this source
+                if (!is_used)
+                    continue;
+
+                std::stringstream permutation;
+                permutation << SSE_INTRIN_PREFIX << "_shuffle_epi8("
+                    << get_casting_intrinsic(type, int_type, node.get_locus())
+                    << "(" << as_expression(*source) << "), "
+                    << SSE_INTRIN_PREFIX << "_setr_epi8(" << shuffle_indexes.str() << "))"
+                    ;
+
+                if (result.empty())
+                {
+                    result = permutation.str();
+                }
+                else
+                {
+                    std::stringstream merge;
+                    merge << SSE_INTRIN_PREFIX << "_or_si" << SSE_VECTOR_BIT_SIZE << "("
+                        << result << ", "
+                        << permutation.str() << ")"
+                        ;
+
+                    result = merge.str();
+                }
+            }
+
+            TL::Source intrin_src;
+            intrin_src << get_casting_intrinsic(int_type, type, node.get_locus())
+                << "(" << result << ")"
+                ;
+
+            Nodecl::NodeclBase function_call =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(function_call);
+        }
+
         void SSEVectorBackend::visit(const Nodecl::VectorLogicalOr& node) 
         { 
             fatal_printf_at(node.get_locus(),
@@ -1255,6 +1411,8 @@ namespace TL
 
         void SSEVectorBackend::visit(const Nodecl::VectorAssignment& node) 
         {
+            TL::Type type = node.get_type().basic_type();
+
             TL::Source intrin_src;
 
             walk(node.get_lhs());
@@ -1262,7 +1420,34 @@ namespace TL
 
             intrin_src << as_expression(node.get_lhs());
             intrin_src << " = ";
-            intrin_src << as_expression(node.get_rhs());
+
+            if (node.get_mask().is_null())
+            {
+                intrin_src << as_expression(node.get_rhs());
+            }
+            else
+            {
+                // Inactive lanes keep the old value of the destination
+                check_emulated_mask(node, type);
+                walk(node.get_mask());
+
+                intrin_src << "_mm_blendv";
+
+                if (type.is_float())
+                    intrin_src << "_ps";
+                else if (type.is_double())
+                    intrin_src << "_pd";
+                else
+                    intrin_src << "_epi8";
+
+                intrin_src << "(";
+                intrin_src << as_expression(node.get_lhs());
+                intrin_src << ", ";
+                intrin_src << as_expression(node.get_rhs());
+                intrin_src << ", ";
+                intrin_src << get_casting_intrinsic(TL::Type::get_int_type(), type, node.get_locus());
+                intrin_src << "(" << as_expression(node.get_mask()) << "))";
+            }
 
             Nodecl::NodeclBase function_call =
                 intrin_src.parse_expression(node.retrieve_context());
@@ -1270,6 +1455,48 @@ namespace TL
             node.replace(function_call);
         }                                                 
 
+        void SSEVectorBackend::visit(const Nodecl::VectorPrefetch& node)
+        {
+            Nodecl::NodeclBase address = node.get_address();
+            PrefetchKind kind = (PrefetchKind) const_value_cast_to_signed_int(
+                    node.get_prefetch_kind().as<Nodecl::IntegerLiteral>().get_constant());
+
+            TL::Source intrin_src, prefetch_hint;
+
+            // PREFETCHW is not available in SSE4.2 processors.
+            // Writes are prefetched as reads
+            switch(kind)
+            {
+                case PrefetchKind::L1_READ :
+                case PrefetchKind::L1_WRITE:
+                    prefetch_hint << "_MM_HINT_T0";
+                    break;
+                case PrefetchKind::L2_READ :
+                case PrefetchKind::L2_WRITE:
+                    prefetch_hint << "_MM_HINT_T1";
+                    break;
+                default:
+                    internal_error("SSE Backend: Node %s at %s has a wrong prefetch kind.",
+                            ast_print_node_type(node.get_kind()),
+                            locus_to_str(node.get_locus()));
+            }
+
+            walk(address);
+
+            intrin_src << "_mm_prefetch("
+                << "(const char *)"
+                << as_expression(address)
+                << ", "
+                << prefetch_hint
+                << ")"
+                ;
+
+            Nodecl::NodeclBase function_call =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(function_call);
+        }
+
         void SSEVectorBackend::visit(const Nodecl::VectorLoad& node) 
         { 
             Nodecl::List flags = node.get_flags().as<Nodecl::List>();
@@ -1277,12 +1504,82 @@ namespace TL
             bool aligned = !flags.find_first<Nodecl::AlignedFlag>().
                 is_null();
 
-            if (aligned)
+            if (!node.get_mask().is_null())
+                visit_masked_vector_load(node);
+            else if (aligned)
                 visit_aligned_vector_load(node);
             else
                 visit_unaligned_vector_load(node);
         }
 
+        // SSE has no masked loads. A full load could fault on the inactive
+        // lanes (e.g., past the end of an array guarded by an 'if'), so only
+        // the active lanes are loaded, one by one, and the rest are zero
+        void SSEVectorBackend::visit_masked_vector_load(
+                const Nodecl::VectorLoad& node) 
+        {
+            TL::Type type = node.get_type().basic_type();
+            const Nodecl::NodeclBase mask = node.get_mask();
+            const unsigned int num_lanes = SSE_VECTOR_BYTE_SIZE / type.get_size();
+
+            TL::Source intrin_src, lanes;
+            std::string extract;
+            bool reversed = false;
+
+            check_emulated_mask(node, type);
+
+            if (type.is_float()) 
+            { 
+                intrin_src << "_mm_setr_ps";
+                extract = "_mm_extract_epi32";
+            } 
+            else if (type.is_double()) 
+            { 
+                intrin_src << "_mm_setr_pd";
+                extract = "_mm_extract_epi64";
+            } 
+            else if (type.is_signed_int() || type.is_unsigned_int()) 
+            { 
+                intrin_src << "_mm_setr_epi32";
+                extract = "_mm_extract_epi32";
+            } 
+            else if (type.is_signed_long_long_int() || type.is_unsigned_long_long_int()) 
+            { 
+                // There is no _mm_setr_epi64x
+                intrin_src << "_mm_set_epi64x";
+                extract = "_mm_extract_epi64";
+                reversed = true;
+            } 
+            else
+            {
+                fatal_printf_at(node.get_locus(),
+                        "SSE Backend: Node %s at %s has an unsupported type.", 
+                        ast_print_node_type(node.get_kind()),
+                        locus_to_str(node.get_locus()));
+            }
+
+            walk(node.get_rhs());
+            walk(mask);
+
+            intrin_src << "(" << lanes << ")";
+
+            for (unsigned int j = 0; j < num_lanes; j++)
+            {
+                const unsigned int i = reversed ? num_lanes - 1 - j : j;
+
+                TL::Source lane;
+                lane << extract << "(" << as_expression(mask) << ", " << i << ") == 0 ? 0 : "
+                    << "(" << as_expression(node.get_rhs()) << ")[" << i << "]";
+
+                lanes.append_with_separator(lane, ",");
+            }
+
+            Nodecl::NodeclBase function_call =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(function_call);
+        }
+
         void SSEVectorBackend::visit_aligned_vector_load(
                 const Nodecl::VectorLoad& node) 
         {
@@ -1383,13 +1680,50 @@ namespace TL
 
             bool aligned = !flags.find_first<Nodecl::AlignedFlag>().
                 is_null();
+            bool stream = !flags.find_first<Nodecl::NontemporalFlag>().
+                is_null();
 
-            if (aligned)
+            // Stream stores have neither masked nor unaligned forms.
+            // Emit a regular store instead
+            if (!node.get_mask().is_null())
+                visit_masked_vector_store(node);
+            else if (aligned && stream)
+                visit_aligned_vector_stream_store(node);
+            else if (aligned)
                 visit_aligned_vector_store(node);
             else
                 visit_unaligned_vector_store(node);
         }
 
+        void SSEVectorBackend::visit_masked_vector_store(
+                const Nodecl::VectorStore& node) 
+        {
+            TL::Type type = node.get_lhs().get_type().basic_type();
+
+            TL::Source intrin_src;
+
+            check_emulated_mask(node, type);
+
+            walk(node.get_lhs());
+            walk(node.get_rhs());
+            walk(node.get_mask());
+
+            // maskmoveu only writes the bytes of the active lanes
+            intrin_src << "_mm_maskmoveu_si128(";
+            intrin_src << get_casting_intrinsic(type, TL::Type::get_int_type(), node.get_locus());
+            intrin_src << "(" << as_expression(node.get_rhs()) << ")";
+            intrin_src << ", ";
+            intrin_src << as_expression(node.get_mask());
+            intrin_src << ", (char *)";
+            intrin_src << as_expression(node.get_lhs());
+            intrin_src << ")"; 
+
+            Nodecl::NodeclBase function_call =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(function_call);
+        }
+
         void SSEVectorBackend::visit_aligned_vector_store(
                 const Nodecl::VectorStore& node) 
         {
@@ -1439,6 +1773,60 @@ namespace TL
             node.replace(function_call);
         }
 
+        void SSEVectorBackend::visit_aligned_vector_stream_store(
+                const Nodecl::VectorStore& node) 
+        {
+            TL::Type type = node.get_lhs().get_type().basic_type();
+
+            TL::Source intrin_src;
+
+            // Intrinsic name
+            intrin_src << "_mm_stream";
+
+            // Postfix
+            if (type.is_float()) 
+            { 
+                intrin_src << "_ps("; 
+            } 
+            else if (type.is_double()) 
+            { 
+                intrin_src << "_pd("; 
+            } 
+            else if (type.is_integral_type()) 
+            { 
+                intrin_src << "_si128((";
+                intrin_src << print_type_str(
+                        TL::Type::get_long_long_int_type().get_vector_of_bytes(16).get_pointer_to().get_internal_type(),
+                        node.retrieve_context().get_decl_context());
+                intrin_src << ")";
+            } 
+            else
+            {
+                fatal_printf_at(node.get_locus(),
+                        "SSE Backend: Node %s at %s has an unsupported type.", 
+                        ast_print_node_type(node.get_kind()),
+                        locus_to_str(node.get_locus()));
+            }
+
+            Nodecl::NodeclBase fence_point =
+                TL::Vectorization::Utils::get_store_fence_point(node);
+            if (!fence_point.is_null())
+                _store_fence_points.insert(fence_point);
+
+            walk(node.get_lhs());
+            walk(node.get_rhs());
+
+            intrin_src << as_expression(node.get_lhs());
+            intrin_src << ", ";
+            intrin_src << as_expression(node.get_rhs());
+            intrin_src << ")"; 
+
+            Nodecl::NodeclBase function_call =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(function_call);
+        }
+
         void SSEVectorBackend::visit_unaligned_vector_store(
                 const Nodecl::VectorStore& node) 
         { 
@@ -1549,25 +1937,27 @@ namespace TL
             walk(node.get_base());
             walk(node.get_strides());
 
-            intrin_src << "("; 
-
-            unsigned int i = 0;
-
-            intrin_src << as_expression(node.get_base());
-            intrin_src << "[";
-
-            intrin_src << extract;
-            intrin_src << "(";
-            intrin_src << as_expression(node.get_strides());
-            intrin_src << ", " << i << ")";
-
-            intrin_src << "]";
+            const Nodecl::NodeclBase mask = node.get_mask();
+            if (!mask.is_null())
+            {
+                check_emulated_mask(node, type);
+                walk(mask);
+            }
 
-            i++;
+            intrin_src << "("; 
 
-            for (; i < type.get_size(); i++)
+            for (unsigned int i = 0; i < type.get_size(); i++)
             {
-                intrin_src << ", ";
+                if (i > 0)
+                    intrin_src << ", ";
+
+                // Inactive lanes are not loaded
+                if (!mask.is_null())
+                {
+                    intrin_src << "_mm_extract_epi32(";
+                    intrin_src << as_expression(mask);
+                    intrin_src << ", " << i << ") == 0 ? 0 : ";
+                }
 
                 intrin_src << as_expression(node.get_base());
                 intrin_src << "[";
@@ -1594,6 +1984,12 @@ namespace TL
             TL::Type type = node.get_source().get_type().basic_type();
             TL::Type index_type = node.get_strides().get_type().basic_type();
 
+            if (!node.get_mask().is_null())
+                fatal_printf_at(node.get_locus(),
+                        "SSE Backend: Node %s at %s has an unsupported mask", 
+                        ast_print_node_type(node.get_kind()),
+                        locus_to_str(node.get_locus()));
+
             TL::Source intrin_src;
             std::string extract_index;
             std::string extract_source;
@@ -1828,13 +2224,6 @@ namespace TL
             visit(node.as<Nodecl::VectorReductionAdd>());
         }
 
-        namespace {
-            TL::Type sse_comparison_type()
-            {
-                return TL::Type::get_int_type().get_vector_of_elements(4);
-            }
-        }
-
         void SSEVectorBackend::visit(const Nodecl::VectorMaskAssignment& node)
         {
             walk(node.get_lhs());
@@ -1845,7 +2234,7 @@ namespace TL
                     Nodecl::Assignment::make(
                         node.get_lhs(),
                         node.get_rhs(),
-                        sse_comparison_type().get_lvalue_reference_to()));
+                        node.get_lhs().get_type().no_ref().get_lvalue_reference_to()));
         }
 
         void SSEVectorBackend::visit(const Nodecl::VectorMaskNot& node)
@@ -1873,6 +2262,49 @@ namespace TL
                 "SSE Backend: Vector masks are not supported in SSE (node=%s).", \
                 ast_print_node_type((node).get_kind()))
 
+        // SSE has no mask registers. Masks are emulated with vectors of 32-bit
+        // or 64-bit lanes (all ones or all zeros), as wide as the elements they
+        // guard, and most operations are computed for all the lanes: only
+        // assignments, loads, stores and gathers honour the mask
+        void SSEVectorBackend::check_emulated_mask(const Nodecl::NodeclBase& node,
+                const TL::Type& type)
+        {
+            if (type.get_size() != 4 && type.get_size() != 8)
+                fatal_printf_at(node.get_locus(),
+                        "SSE Backend: Node %s at %s is masked but its elements are neither 4 nor 8 bytes long",
+                        ast_print_node_type(node.get_kind()),
+                        locus_to_str(node.get_locus()));
+        }
+
+        void SSEVectorBackend::common_mask_op_lowering(const Nodecl::NodeclBase& node,
+                const std::string& intrin_op_name,
+                const bool swap_operands)
+        {
+            const Nodecl::VectorMaskAnd& binary_node = node.as<Nodecl::VectorMaskAnd>();
+
+            Nodecl::NodeclBase first_op = binary_node.get_lhs();
+            Nodecl::NodeclBase second_op = binary_node.get_rhs();
+
+            if (swap_operands)
+                std::swap(first_op, second_op);
+
+            TL::Source intrin_src;
+
+            walk(first_op);
+            walk(second_op);
+
+            intrin_src << "_mm_" << intrin_op_name << "_si128(";
+            intrin_src << as_expression(first_op);
+            intrin_src << ", ";
+            intrin_src << as_expression(second_op);
+            intrin_src << ")";
+
+            Nodecl::NodeclBase function_call =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(function_call);
+        }
+
         void SSEVectorBackend::visit(const Nodecl::VectorMaskConversion& node)
         {
             UNSUPPORTED_MASK(node);
@@ -1880,32 +2312,125 @@ namespace TL
 
         void SSEVectorBackend::visit(const Nodecl::VectorMaskAnd& node)
         {
-            UNSUPPORTED_MASK(node);
+            common_mask_op_lowering(node, "and");
         }
 
         void SSEVectorBackend::visit(const Nodecl::VectorMaskOr& node)
         {
-            UNSUPPORTED_MASK(node);
+            common_mask_op_lowering(node, "or");
         }
 
         void SSEVectorBackend::visit(const Nodecl::VectorMaskAnd1Not& node)
         {
-            UNSUPPORTED_MASK(node);
+            // ~lhs & rhs
+            common_mask_op_lowering(node, "andnot");
         }
 
         void SSEVectorBackend::visit(const Nodecl::VectorMaskAnd2Not& node)
         {
-            UNSUPPORTED_MASK(node);
+            // lhs & ~rhs
+            common_mask_op_lowering(node, "andnot", /* swap_operands */ true);
         }
 
         void SSEVectorBackend::visit(const Nodecl::VectorMaskXor& node)
         {
-            UNSUPPORTED_MASK(node);
+            common_mask_op_lowering(node, "xor");
         }
 
         void SSEVectorBackend::visit(const Nodecl::MaskLiteral& node)
         {
-            UNSUPPORTED_MASK(node);
+            // The legalization has typed the literal with the lanes it guards
+            const unsigned int num_lanes = node.get_type().no_ref().vector_num_elements();
+            const uint64_t mask_bits = const_value_cast_to_8(node.get_constant());
+
+            TL::Source intrin_src, lanes;
+
+            intrin_src << (num_lanes == 2 ? "_mm_set_epi64x(" : "_mm_set_epi32(")
+                << lanes << ")";
+
+            // _mm_set_epi32 and _mm_set_epi64x take the last lane first
+            for (int i = num_lanes - 1; i >= 0; i--)
+            {
+                lanes.append_with_separator(((mask_bits >> i) & 1) ? "-1" : "0", ",");
+            }
+
+            Nodecl::NodeclBase function_call =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(function_call);
+        }
+
+        // 'mask != value' and 'mask == value' are lowered comparing
+        // the bit mask made of the sign bits of the lanes
+        void SSEVectorBackend::mask_comparison_lowering(const Nodecl::NodeclBase& node,
+                const std::string& op)
+        {
+            const Nodecl::Different& binary_node = node.as<Nodecl::Different>();
+
+            const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+            const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+
+            TL::Source intrin_src, lhs_bits, rhs_bits;
+
+            walk(lhs);
+            walk(rhs);
+
+            intrin_src << "(" << lhs_bits << " " << op << " " << rhs_bits << ")";
+
+            // One bit per lane: 64-bit lanes are compressed as doubles,
+            // so mask literals and bit masks agree
+            if (lhs.get_type().no_ref().is_vector())
+            {
+                const std::string suffix =
+                    lhs.get_type().no_ref().basic_type().get_size() == 8 ? "pd" : "ps";
+                lhs_bits << "_mm_movemask_" << suffix << "(_mm_castsi128_" << suffix
+                    << "(" << as_expression(lhs) << "))";
+            }
+            else
+                lhs_bits << as_expression(lhs);
+
+            if (rhs.get_type().no_ref().is_vector())
+            {
+                const std::string suffix =
+                    rhs.get_type().no_ref().basic_type().get_size() == 8 ? "pd" : "ps";
+                rhs_bits << "_mm_movemask_" << suffix << "(_mm_castsi128_" << suffix
+                    << "(" << as_expression(rhs) << "))";
+            }
+            else
+                rhs_bits << as_expression(rhs);
+
+            Nodecl::NodeclBase comparison =
+                intrin_src.parse_expression(node.retrieve_context());
+
+            node.replace(comparison);
+        }
+
+        void SSEVectorBackend::visit(const Nodecl::Different& node)
+        {
+            if (node.get_lhs().get_type().no_ref().is_vector()
+                    || node.get_rhs().get_type().no_ref().is_vector())
+            {
+                mask_comparison_lowering(node, "!=");
+            }
+            else
+            {
+                walk(node.get_lhs());
+                walk(node.get_rhs());
+            }
+        }
+
+        void SSEVectorBackend::visit(const Nodecl::Equal& node)
+        {
+            if (node.get_lhs().get_type().no_ref().is_vector()
+                    || node.get_rhs().get_type().no_ref().is_vector())
+            {
+                mask_comparison_lowering(node, "==");
+            }
+            else
+            {
+                walk(node.get_lhs());
+                walk(node.get_rhs());
+            }
         }
 
         void SSEVectorBackend::visit(const Nodecl::VectorSqrt& node)
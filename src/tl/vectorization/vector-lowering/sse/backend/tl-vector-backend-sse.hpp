@@ -30,6 +30,8 @@
 #include "tl-nodecl-base.hpp"
 #include "tl-nodecl-visitor.hpp"
 
+#include <set>
+
 namespace TL
 {
     namespace Vectorization
@@ -37,6 +39,9 @@ namespace TL
         class SSEVectorBackend : public Nodecl::ExhaustiveVisitor<void>
         {
             private:
+                // Statements followed by a store fence
+                std::set<Nodecl::NodeclBase> _store_fence_points;
+
                 std::string get_casting_intrinsic(const TL::Type& type_from,
                         const TL::Type& type_to,
                         const locus_t* locus);
@@ -45,15 +50,30 @@ namespace TL
                         const Nodecl::VectorLoad& node);
                 void visit_unaligned_vector_load(
                         const Nodecl::VectorLoad& node);
+                void visit_masked_vector_load(
+                        const Nodecl::VectorLoad& node);
                 void visit_aligned_vector_store(
                         const Nodecl::VectorStore& node);
+                void visit_aligned_vector_stream_store(
+                        const Nodecl::VectorStore& node);
                 void visit_unaligned_vector_store(
                         const Nodecl::VectorStore& node);
+                void visit_masked_vector_store(
+                        const Nodecl::VectorStore& node);
+
+                void check_emulated_mask(const Nodecl::NodeclBase& node,
+                        const TL::Type& type);
+                void common_mask_op_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& intrin_op_name,
+                        const bool swap_operands = false);
+                void mask_comparison_lowering(const Nodecl::NodeclBase& node,
+                        const std::string& op);
 
             public:
 
                 SSEVectorBackend();
 
+                virtual void visit(const Nodecl::FunctionCode& node);
                 virtual void visit(const Nodecl::ObjectInit& node);
                 
                 virtual void visit(const Nodecl::VectorAdd& node);
@@ -73,6 +93,7 @@ namespace TL
                 virtual void visit(const Nodecl::VectorBitwiseOr& node);
                 virtual void visit(const Nodecl::VectorBitwiseXor& node);
                 virtual void visit(const Nodecl::VectorAlignRight& node);
+                virtual void visit(const Nodecl::VectorShuffle& node);
                 virtual void visit(const Nodecl::VectorLogicalOr& node);
 
 
@@ -81,6 +102,7 @@ namespace TL
                 virtual void visit(const Nodecl::VectorPromotion& node);
                 virtual void visit(const Nodecl::VectorLiteral& node);
                 virtual void visit(const Nodecl::VectorAssignment& node);
+                virtual void visit(const Nodecl::VectorPrefetch& node);
                 virtual void visit(const Nodecl::VectorLoad& node);
                 virtual void visit(const Nodecl::VectorStore& node);
                 virtual void visit(const Nodecl::VectorGather& node);
@@ -104,6 +126,9 @@ namespace TL
                 virtual void visit(const Nodecl::VectorMaskXor& node);
                 virtual void visit(const Nodecl::MaskLiteral& node);
 
+                virtual void visit(const Nodecl::Different& node);
+                virtual void visit(const Nodecl::Equal& node);
+
                 virtual void visit(const Nodecl::VectorSqrt& node);
 
                 virtual void visit(const Nodecl::VectorRcp& node);
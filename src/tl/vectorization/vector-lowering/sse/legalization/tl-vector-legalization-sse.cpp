@@ -34,8 +34,14 @@ namespace TL
     namespace Vectorization
     {
         namespace {
-            TL::Type sse_comparison_type()
+            // Masks have one all-ones or all-zeros lane per element. 2-lane
+            // masks guard doubles (or 64-bit integers) so their lanes are
+            // 64 bits long
+            TL::Type sse_comparison_type(const TL::Type& mask_type)
             {
+                if (mask_type.get_mask_num_elements() == 2)
+                    return TL::Type::get_long_long_int_type().get_vector_of_elements(2);
+
                 return TL::Type::get_int_type().get_vector_of_elements(4);
             }
 
@@ -43,7 +49,7 @@ namespace TL
             {
                 if (sym.get_type().is_mask())
                 {
-                    sym.set_type(sse_comparison_type());
+                    sym.set_type(sse_comparison_type(sym.get_type()));
                 }
             }
 
@@ -51,10 +57,11 @@ namespace TL
             {
                 // There is no mask type in SSE, __m128i is used instead
                 if (node.get_type().is_mask())
-                    node.set_type(sse_comparison_type());
+                    node.set_type(sse_comparison_type(node.get_type()));
                 else if (node.get_type().is_lvalue_reference()
                         && node.get_type().no_ref().is_mask())
-                    node.set_type(sse_comparison_type().get_lvalue_reference_to());
+                    node.set_type(sse_comparison_type(
+                                node.get_type().no_ref()).get_lvalue_reference_to());
             }
         }
 
@@ -114,6 +121,11 @@ namespace TL
         
         UNARY_MASK_OPS(VectorMaskNot)
 
+        void SSEVectorLegalization::visit(const Nodecl::MaskLiteral& n)
+        {
+            fix_comparison_type(n);
+        }
+
         void SSEVectorLegalization::visit(
             const Nodecl::VectorMaskConversion &node)
         {
@@ -59,6 +59,7 @@ namespace TL
 
                 virtual void visit(const Nodecl::VectorMaskNot& n);
                 virtual void visit(const Nodecl::VectorMaskConversion& n);
+                virtual void visit(const Nodecl::MaskLiteral& n);
         };
     }
 }
@@ -0,0 +1,1966 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+  --------------------------------------------------------------------*/
+
+#include "tl-vector-backend-sve.hpp"
+
+#include "tl-vectorization-prefetcher-common.hpp"
+#include "tl-vectorization-utils.hpp"
+#include "tl-source.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-optimizations.hpp"
+#include "cxx-cexpr.h"
+
+#include <sstream>
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    SVEVectorBackend::SVEVectorBackend(unsigned int vector_length)
+        : _vector_length(vector_length)
+    {
+        std::cerr << "--- SVE backend phase ---" << std::endl;
+    }
+
+    // GCC and Clang declare the SVE intrinsics through a pragma in arm_sve.h,
+    // so they are not visible to the frontend. They are declared on demand
+    // (and never printed) with the type of the node they lower
+    std::string SVEVectorBackend::get_intrinsic(const std::string& name,
+            const TL::Type& return_type)
+    {
+        TL::Scope global_scope = TL::Scope::get_global_scope();
+        TL::Symbol sym = global_scope.get_symbol_from_name(name);
+
+        if (!sym.is_valid())
+        {
+            sym = global_scope.new_symbol(name);
+
+            scope_entry_t* entry = sym.get_internal_symbol();
+            entry->kind = SK_FUNCTION;
+            entry->type_information = return_type.no_ref().get_unqualified_type()
+                .get_function_returning(TL::ObjectList<TL::Type>(),
+                        /* has_ellipsis */ true)
+                .get_internal_type();
+            entry->do_not_print = 1;
+            symbol_entity_specs_set_is_builtin(entry, 1);
+        }
+
+        return name;
+    }
+
+    std::string SVEVectorBackend::get_type_suffix(const TL::Type& type,
+            const Nodecl::NodeclBase& n)
+    {
+        if (type.is_float())
+            return "f32";
+        else if (type.is_double())
+            return "f64";
+
+        return get_integer_suffix(type, n);
+    }
+
+    std::string SVEVectorBackend::get_integer_suffix(const TL::Type& type,
+            const Nodecl::NodeclBase& n)
+    {
+        std::stringstream result;
+
+        if (type.is_integral_type()
+                && (type.get_size() == 1 || type.get_size() == 2
+                    || type.get_size() == 4 || type.get_size() == 8))
+        {
+            result << (type.is_signed_integral() ? "s" : "u")
+                << type.get_size() * 8;
+        }
+        else
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type: %s.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    type.get_simple_declaration(n.retrieve_context(), "").c_str());
+        }
+
+        return result.str();
+    }
+
+    std::string SVEVectorBackend::get_casting_to_pointer(const TL::Type& type_to)
+    {
+        std::stringstream result;
+
+        result << "("
+            << print_type_str(
+                    type_to.get_pointer_to().get_internal_type(),
+                    CURRENT_COMPILED_FILE->global_decl_context)
+            << ")";
+
+        return result.str();
+    }
+
+    std::string SVEVectorBackend::get_predicate_suffix(unsigned int element_size)
+    {
+        std::stringstream result;
+
+        result << "b" << element_size * 8;
+
+        return result.str();
+    }
+
+    TL::Type SVEVectorBackend::get_predicate_type(unsigned int element_size)
+    {
+        return TL::Type::get_mask_type(_vector_length / element_size);
+    }
+
+    std::string SVEVectorBackend::get_ptrue(unsigned int element_size)
+    {
+        return get_intrinsic("svptrue_" + get_predicate_suffix(element_size),
+                get_predicate_type(element_size)) + "()";
+    }
+
+    TL::Type SVEVectorBackend::get_integer_type(unsigned int size, bool is_signed)
+    {
+        switch (size)
+        {
+            case 1:
+                return is_signed ? TL::Type(::get_signed_char_type())
+                    : TL::Type::get_unsigned_char_type();
+            case 2:
+                return is_signed ? TL::Type::get_short_int_type()
+                    : TL::Type::get_unsigned_short_int_type();
+            case 4:
+                return is_signed ? TL::Type::get_int_type()
+                    : TL::Type::get_unsigned_int_type();
+            case 8:
+                return is_signed ? TL::Type::get_long_long_int_type()
+                    : TL::Type::get_unsigned_long_long_int_type();
+            default:
+                internal_error("SVE Backend: Unsupported integer size: %d bytes.", size);
+        }
+
+        return TL::Type();
+    }
+
+    // SVE vector types are distinct types, so even signed <-> unsigned
+    // needs a reinterpretation
+    std::string SVEVectorBackend::get_reinterpret(const std::string& src,
+            const TL::Type& type_from,
+            const TL::Type& type_to,
+            const TL::Type& vector_type,
+            const Nodecl::NodeclBase& n)
+    {
+        const std::string from = get_type_suffix(type_from, n);
+        const std::string to = get_type_suffix(type_to, n);
+
+        if (from == to)
+            return src;
+
+        return get_intrinsic("svreinterpret_" + to + "_" + from,
+                type_to.get_vector_of_bytes(vector_type.no_ref().get_size()))
+            + "(" + src + ")";
+    }
+
+    // Widening unpacks the low half of the register (sign or zero extended).
+    // Narrowing keeps the even (low) halves of the elements
+    std::string SVEVectorBackend::resize_integer_vector(const std::string& src,
+            const TL::Type& type_from,
+            const TL::Type& type_to,
+            const Nodecl::NodeclBase& n)
+    {
+        const bool is_signed = type_from.is_signed_integral();
+        std::string result = src;
+
+        for (unsigned int size = type_from.get_size();
+                size < type_to.get_size();
+                size *= 2)
+        {
+            TL::Type wider_type = get_integer_type(size * 2, is_signed);
+
+            result = get_intrinsic("svunpklo_" + get_integer_suffix(wider_type, n),
+                    wider_type.get_vector_of_bytes(_vector_length))
+                + "(" + result + ")";
+        }
+
+        for (unsigned int size = type_from.get_size();
+                size > type_to.get_size();
+                size /= 2)
+        {
+            TL::Type type = get_integer_type(size, is_signed);
+            TL::Type narrower_type = get_integer_type(size / 2, is_signed);
+            const std::string suffix = get_integer_suffix(narrower_type, n);
+
+            result = get_intrinsic("svuzp1_" + suffix,
+                    narrower_type.get_vector_of_bytes(_vector_length))
+                + "("
+                + get_reinterpret(result, type, narrower_type,
+                        narrower_type.get_vector_of_bytes(_vector_length), n)
+                + ", "
+                + get_intrinsic("svdup_n_" + suffix,
+                        narrower_type.get_vector_of_bytes(_vector_length))
+                + "(0))";
+        }
+
+        return result;
+    }
+
+    // Operations take the mask as governing predicate. Without a mask,
+    // all the lanes of the vector are active. Vectors narrower than
+    // the target vector length only activate their own lanes
+    void SVEVectorBackend::process_mask_component(const Nodecl::NodeclBase& mask,
+            TL::Source& predicate, const TL::Type& vector_type,
+            const Nodecl::NodeclBase& n)
+    {
+        const unsigned int vector_size = vector_type.no_ref().get_size();
+        const unsigned int element_size = vector_type.no_ref().basic_type().get_size();
+
+        if (vector_size > _vector_length)
+        {
+            internal_error("SVE Backend: Node %s at %s has a vector of %d bytes, "\
+                    "which is wider than the target vector length (%d bytes).",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    vector_size, _vector_length);
+        }
+
+        if (!mask.is_null())
+        {
+            const unsigned int mask_element_size = _vector_length
+                / mask.get_type().no_ref().get_mask_num_elements();
+
+            // Predicates have one bit per byte of the register and
+            // the active bit of each lane depends on its element size
+            if (mask_element_size != element_size)
+            {
+                internal_error("SVE Backend: Node %s at %s has %d-bit elements but a mask "\
+                        "for %d-bit elements. Loops mixing element sizes are not supported.",
+                        ast_print_node_type(n.get_kind()),
+                        locus_to_str(n.get_locus()),
+                        element_size * 8, mask_element_size * 8);
+            }
+
+            walk(mask);
+            predicate << as_expression(mask);
+        }
+        else if (vector_size < _vector_length)
+        {
+            predicate << get_intrinsic("svwhilelt_" + get_predicate_suffix(element_size) + "_s32",
+                    get_predicate_type(element_size))
+                << "(0, " << vector_type.no_ref().vector_num_elements() << ")";
+        }
+        else
+        {
+            predicate << get_ptrue(element_size);
+        }
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::FunctionCode& n)
+    {
+        bool contains_vector_nodes = TL::Vectorization::Utils::contains_vector_nodes(n);
+
+        if (contains_vector_nodes)
+        {
+            // Initialize analisys
+            TL::Optimizations::canonicalize_and_fold(
+                    n, /*_fast_math_enabled*/ false);
+
+            walk(n.get_statements());
+
+            emit_vector_length_check(n);
+        }
+    }
+
+    // Code is generated for the fixed vector length of -msve-vector-bits.
+    // Running on a machine with a different one would silently compute the
+    // wrong lanes, so translation units with SVE code check it once at
+    // program startup, from a constructor
+    void SVEVectorBackend::emit_vector_length_check(
+            const Nodecl::FunctionCode& n)
+    {
+        const std::string check_name = "__mcc_sve_check_vector_length";
+        if (TL::Scope::get_global_scope().get_symbol_from_name(check_name).is_valid())
+            return;
+
+        const std::string svcntb = get_intrinsic("svcntb",
+                TL::Type::get_unsigned_long_int_type());
+
+        TL::Source check_src;
+
+        check_src
+            << "static void " << check_name << "(void)"
+            << "{"
+            <<     "if (" << svcntb << "() != " << _vector_length << ")"
+            <<     "{"
+            <<         "__builtin_printf(\"SVE: code compiled for a %d-bit vector length "
+            <<             "is running with a %d-bit vector length\\n\", "
+            <<             _vector_length * 8 << ", (int)(" << svcntb << "() * 8));"
+            <<         "__builtin_abort();"
+            <<     "}"
+            << "}"
+            ;
+
+        Nodecl::NodeclBase check_function = check_src.parse_global(n);
+
+        TL::Symbol check_sym = TL::Scope::get_global_scope().get_symbol_from_name(check_name);
+        ERROR_CONDITION(!check_sym.is_valid(), "Symbol %s not found", check_name.c_str());
+
+        gcc_attribute_t constructor_attr;
+        constructor_attr.attribute_name = uniquestr("constructor");
+        constructor_attr.expression_list = nodecl_null();
+        symbol_entity_specs_add_gcc_attributes(
+                check_sym.get_internal_symbol(), constructor_attr);
+
+        Nodecl::Utils::prepend_to_enclosing_top_level_location(n, check_function);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::ObjectInit& n)
+    {
+        if(n.has_symbol())
+        {
+            TL::Symbol sym = n.get_symbol();
+
+            // Vectorizing initialization
+            Nodecl::NodeclBase init = sym.get_value();
+            if(!init.is_null())
+            {
+                walk(init);
+            }
+        }
+    }
+
+    // First-faulting loads only load the lanes before the first one that
+    // would fault and clear the FFR from it onwards. Loops with mask checks
+    // after them set the FFR at the beginning of every iteration
+    void SVEVectorBackend::visit(const Nodecl::ForStatement& n)
+    {
+        LoopInfo loop_info;
+        loop_info.has_speculative_loads = false;
+        loop_info.checks_ffr = false;
+
+        _loops.push_back(loop_info);
+
+        walk(n.get_loop_header());
+        walk(n.get_statement());
+
+        loop_info = _loops.back();
+        _loops.pop_back();
+
+        if (loop_info.checks_ffr)
+        {
+            TL::Source setffr_src;
+
+            setffr_src << get_intrinsic("svsetffr", TL::Type::get_void_type())
+                << "()";
+
+            Nodecl::NodeclBase setffr =
+                setffr_src.parse_expression(n.retrieve_context());
+
+            Nodecl::Utils::prepend_items_in_nested_compound_statement(
+                    n.get_statement(),
+                    Nodecl::ExpressionStatement::make(setffr, n.get_locus()));
+        }
+        else if (loop_info.has_speculative_loads && !_loops.empty())
+        {
+            _loops.back().has_speculative_loads = true;
+        }
+    }
+
+    // 'mask != 0' is 'any lane is active' and 'mask == all ones' is
+    // 'no lane is inactive'. After first-faulting loads, a lane that
+    // has not been loaded also makes the check take the exit path,
+    // so the scalar epilog redoes the iteration
+    void SVEVectorBackend::common_mask_check_lowering(const Nodecl::NodeclBase& n,
+            const bool is_different)
+    {
+        const Nodecl::Different& check_node = n.as<Nodecl::Different>();
+
+        const Nodecl::NodeclBase lhs = check_node.get_lhs();
+        const Nodecl::NodeclBase rhs = check_node.get_rhs();
+
+        const TL::Type mask_type = lhs.get_type().no_ref();
+        const unsigned int element_size = _vector_length / mask_type.get_mask_num_elements();
+
+        if (!rhs.is_constant())
+        {
+            internal_error("SVE Backend: Node %s at %s compares a mask with a non-constant value.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        const bool check_all = !const_value_is_zero(rhs.get_constant());
+        const std::string ptrue = get_ptrue(element_size);
+        const std::string ptest_any = get_intrinsic("svptest_any",
+                TL::Type::get_bool_type());
+        const std::string pnot = get_intrinsic("svnot_b_z", mask_type);
+
+        TL::Source intrin_src, test_src;
+
+        walk(lhs);
+
+        if (check_all)
+            test_src << pnot << "(" << ptrue << ", " << as_expression(lhs) << ")";
+        else
+            test_src << as_expression(lhs);
+
+        intrin_src << (is_different ? "(" : "!(")
+            << ptest_any << "(" << ptrue << ", " << test_src << ")";
+
+        if (!_loops.empty() && _loops.back().has_speculative_loads)
+        {
+            intrin_src << " || "
+                << ptest_any << "(" << ptrue << ", "
+                << pnot << "(" << ptrue << ", "
+                << get_intrinsic("svrdffr", mask_type) << "()))";
+
+            _loops.back().checks_ffr = true;
+        }
+
+        intrin_src << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::Different& n)
+    {
+        if (n.get_lhs().get_type().no_ref().is_mask())
+        {
+            common_mask_check_lowering(n, /* is_different */ true);
+        }
+        else
+        {
+            walk(n.get_lhs());
+            walk(n.get_rhs());
+        }
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::Equal& n)
+    {
+        if (n.get_lhs().get_type().no_ref().is_mask())
+        {
+            common_mask_check_lowering(n, /* is_different */ false);
+        }
+        else
+        {
+            walk(n.get_lhs());
+            walk(n.get_rhs());
+        }
+    }
+
+    void SVEVectorBackend::common_binary_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorAdd& binary_node = n.as<Nodecl::VectorAdd>();
+
+        const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+        const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+        const Nodecl::NodeclBase mask = binary_node.get_mask();
+
+        TL::Type vector_type = binary_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        // Masked lanes are merged by the enclosing assignment,
+        // so they can take any value (_x forms)
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << get_intrinsic("sv" + intrin_op_name + "_" + get_type_suffix(type, n) + "_x",
+                vector_type)
+            << "("
+            << predicate
+            << ", "
+            << as_expression(lhs)
+            << ", "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::common_unary_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorRsqrt& unary_node = n.as<Nodecl::VectorRsqrt>();
+
+        const Nodecl::NodeclBase rhs = unary_node.get_rhs();
+        const Nodecl::NodeclBase mask = unary_node.get_mask();
+
+        TL::Type vector_type = unary_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(rhs);
+
+        intrin_src << get_intrinsic("sv" + intrin_op_name + "_" + get_type_suffix(type, n) + "_x",
+                vector_type)
+            << "("
+            << predicate
+            << ", "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorAdd& n)
+    {
+        common_binary_op_lowering(n, "add");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMinus& n)
+    {
+        common_binary_op_lowering(n, "sub");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMul& n)
+    {
+        common_binary_op_lowering(n, "mul");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorDiv& n)
+    {
+        TL::Type type = n.get_type().basic_type();
+
+        if (type.is_integral_type() && type.get_size() < 4)
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type: 8/16-bit "\
+                    "division is not available.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        common_binary_op_lowering(n, "div");
+    }
+
+    // There is no accurate reciprocal estimate. Divide instead
+    void SVEVectorBackend::visit(const Nodecl::VectorRcp& n)
+    {
+        const Nodecl::NodeclBase rhs = n.get_rhs();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        if (!type.is_floating_type())
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        const std::string suffix = get_type_suffix(type, n);
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(rhs);
+
+        intrin_src << get_intrinsic("svdiv_" + suffix + "_x", vector_type)
+            << "("
+            << predicate
+            << ", "
+            << get_intrinsic("svdup_n_" + suffix, vector_type)
+            << "(" << (type.is_float() ? "1.0f" : "1.0") << "), "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    // a % b = a - (a / b) * b. Operands are already in three-address form,
+    // so repeating 'a' does not repeat any computation
+    void SVEVectorBackend::visit(const Nodecl::VectorMod& n)
+    {
+        const Nodecl::NodeclBase lhs = n.get_lhs();
+        const Nodecl::NodeclBase rhs = n.get_rhs();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        if (!type.is_integral_type() || type.get_size() < 4)
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        const std::string suffix = get_type_suffix(type, n);
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << get_intrinsic("svmls_" + suffix + "_x", vector_type)
+            << "("
+            << predicate
+            << ", "
+            << as_expression(lhs)
+            << ", "
+            << get_intrinsic("svdiv_" + suffix + "_x", vector_type)
+            << "(" << predicate << ", " << as_expression(lhs) << ", " << as_expression(rhs) << ")"
+            << ", "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorSqrt& n)
+    {
+        common_unary_op_lowering(n, "sqrt");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorRsqrt& n)
+    {
+        const Nodecl::NodeclBase rhs = n.get_rhs();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        if (!type.is_floating_type())
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        const std::string suffix = get_type_suffix(type, n);
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(rhs);
+
+        intrin_src << get_intrinsic("svdiv_" + suffix + "_x", vector_type)
+            << "("
+            << predicate
+            << ", "
+            << get_intrinsic("svdup_n_" + suffix, vector_type)
+            << "(" << (type.is_float() ? "1.0f" : "1.0") << "), "
+            << get_intrinsic("svsqrt_" + suffix + "_x", vector_type)
+            << "(" << predicate << ", " << as_expression(rhs) << ")"
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorFmadd& n)
+    {
+        const Nodecl::NodeclBase first_op = n.get_first_op();
+        const Nodecl::NodeclBase second_op = n.get_second_op();
+        const Nodecl::NodeclBase third_op = n.get_third_op();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        if (!type.is_floating_type())
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(first_op);
+        walk(second_op);
+        walk(third_op);
+
+        // svmad computes first * second + third
+        intrin_src << get_intrinsic("svmad_" + get_type_suffix(type, n) + "_x", vector_type)
+            << "("
+            << predicate
+            << ", "
+            << as_expression(first_op)
+            << ", "
+            << as_expression(second_op)
+            << ", "
+            << as_expression(third_op)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorNeg& n)
+    {
+        TL::Type type = n.get_type().basic_type();
+
+        if (type.is_unsigned_integral())
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        common_unary_op_lowering(n, "neg");
+    }
+
+    // i + {0, 1, ..., VF-1} < n is the predicate of the lanes
+    // that have not reached n yet, i.e. svwhilelt(i, n)
+    bool SVEVectorBackend::lower_while_comparison(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorLowerThan& cmp_node = n.as<Nodecl::VectorLowerThan>();
+
+        const Nodecl::NodeclBase lhs = cmp_node.get_lhs();
+        const Nodecl::NodeclBase rhs = cmp_node.get_rhs();
+        const Nodecl::NodeclBase mask = cmp_node.get_mask();
+
+        const TL::Type vector_type = lhs.get_type().no_ref();
+        const TL::Type type = vector_type.basic_type();
+
+        if (!lhs.is<Nodecl::VectorAdd>()
+                || !rhs.is<Nodecl::VectorPromotion>()
+                || !type.is_integral_type()
+                || (type.get_size() != 4 && type.get_size() != 8)
+                || vector_type.get_size() != _vector_length)
+            return false;
+
+        const Nodecl::VectorAdd& add = lhs.as<Nodecl::VectorAdd>();
+        Nodecl::NodeclBase base = add.get_lhs();
+        Nodecl::NodeclBase offsets = add.get_rhs();
+
+        if (!add.get_mask().is_null())
+            return false;
+
+        if (base.is<Nodecl::VectorLiteral>())
+            std::swap(base, offsets);
+
+        if (!base.is<Nodecl::VectorPromotion>()
+                || !offsets.is<Nodecl::VectorLiteral>())
+            return false;
+
+        Nodecl::List offset_values = offsets.as<Nodecl::VectorLiteral>().
+            get_scalar_values().as<Nodecl::List>();
+
+        int offset = 0;
+        for (Nodecl::List::const_iterator it = offset_values.begin();
+                it != offset_values.end();
+                it++, offset++)
+        {
+            if (!it->is_constant()
+                    || const_value_cast_to_signed_int(it->get_constant()) != offset)
+                return false;
+        }
+
+        const Nodecl::NodeclBase first = base.as<Nodecl::VectorPromotion>().get_rhs();
+        const Nodecl::NodeclBase last = rhs.as<Nodecl::VectorPromotion>().get_rhs();
+        const TL::Type mask_type = n.get_type().no_ref();
+
+        TL::Source intrin_src, while_src;
+
+        walk(first);
+        walk(last);
+
+        while_src << get_intrinsic("sv" + intrin_op_name + "_"
+                    + get_predicate_suffix(type.get_size()) + "_"
+                    + get_integer_suffix(type, n),
+                    mask_type)
+            << "("
+            << as_expression(first)
+            << ", "
+            << as_expression(last)
+            << ")"
+            ;
+
+        if (mask.is_null())
+        {
+            intrin_src << while_src;
+        }
+        else
+        {
+            walk(mask);
+
+            intrin_src << get_intrinsic("svand_b_z", mask_type)
+                << "("
+                << as_expression(mask)
+                << ", "
+                << while_src
+                << ", "
+                << while_src
+                << ")"
+                ;
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+
+        return true;
+    }
+
+    void SVEVectorBackend::common_comparison_op_lowering(
+            const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        Nodecl::VectorLowerThan cmp_node = n.as<Nodecl::VectorLowerThan>();
+
+        const Nodecl::NodeclBase lhs = cmp_node.get_lhs();
+        const Nodecl::NodeclBase rhs = cmp_node.get_rhs();
+        const Nodecl::NodeclBase mask = cmp_node.get_mask();
+
+        const TL::Type vector_type = lhs.get_type().no_ref();
+        const TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        // Inactive lanes are false in the resulting predicate
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << get_intrinsic("sv" + intrin_op_name + "_" + get_type_suffix(type, n),
+                n.get_type())
+            << "("
+            << predicate
+            << ", "
+            << as_expression(lhs)
+            << ", "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(cmp_node.retrieve_context());
+
+        cmp_node.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorLowerThan& n)
+    {
+        if (!lower_while_comparison(n, "whilelt"))
+            common_comparison_op_lowering(n, "cmplt");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorLowerOrEqualThan& n)
+    {
+        if (!lower_while_comparison(n, "whilele"))
+            common_comparison_op_lowering(n, "cmple");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorGreaterThan& n)
+    {
+        common_comparison_op_lowering(n, "cmpgt");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorGreaterOrEqualThan& n)
+    {
+        common_comparison_op_lowering(n, "cmpge");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorEqual& n)
+    {
+        common_comparison_op_lowering(n, "cmpeq");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorDifferent& n)
+    {
+        common_comparison_op_lowering(n, "cmpne");
+    }
+
+    // Bitwise operations only exist for integer elements.
+    // Floating point vectors are reinterpreted
+    void SVEVectorBackend::bitwise_binary_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name)
+    {
+        const Nodecl::VectorBitwiseAnd& binary_node = n.as<Nodecl::VectorBitwiseAnd>();
+
+        const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+        const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+        const Nodecl::NodeclBase mask = binary_node.get_mask();
+
+        TL::Type vector_type = binary_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+        TL::Type int_type = type.is_integral_type() ? type
+            : get_integer_type(type.get_size(), /* is_signed */ false);
+        TL::Type int_vector_type = int_type.get_vector_of_bytes(vector_type.get_size());
+
+        TL::Source intrin_src, predicate, op_src;
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(lhs);
+        walk(rhs);
+
+        op_src << get_intrinsic("sv" + intrin_op_name + "_" + get_integer_suffix(int_type, n) + "_x",
+                int_vector_type)
+            << "("
+            << predicate
+            << ", "
+            << get_reinterpret(as_expression(lhs), type, int_type, vector_type, n)
+            << ", "
+            << get_reinterpret(as_expression(rhs), type, int_type, vector_type, n)
+            << ")"
+            ;
+
+        intrin_src << get_reinterpret(op_src.get_source(), int_type, type, vector_type, n);
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorBitwiseAnd& n)
+    {
+        bitwise_binary_op_lowering(n, "and");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorBitwiseOr& n)
+    {
+        bitwise_binary_op_lowering(n, "orr");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorBitwiseXor& n)
+    {
+        bitwise_binary_op_lowering(n, "eor");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorBitwiseNot& n)
+    {
+        TL::Type type = n.get_type().basic_type();
+
+        if (!type.is_integral_type())
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        common_unary_op_lowering(n, "not");
+    }
+
+    // Shift amounts are unsigned vectors. Shifts by the same amount in all
+    // the lanes use the scalar (_n) forms. Arithmetic shifts only exist
+    // for signed elements and logical right shifts for unsigned ones
+    void SVEVectorBackend::common_shift_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name,
+            const bool is_signed_shift)
+    {
+        const Nodecl::VectorBitwiseShl& shift_node = n.as<Nodecl::VectorBitwiseShl>();
+
+        const Nodecl::NodeclBase lhs = shift_node.get_lhs();
+        const Nodecl::NodeclBase rhs = shift_node.get_rhs();
+        const Nodecl::NodeclBase mask = shift_node.get_mask();
+
+        TL::Type vector_type = shift_node.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate, op_src, rhs_expression;
+        std::string intrin_name = "sv" + intrin_op_name + "_";
+
+        if (!type.is_integral_type())
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        TL::Type op_type = get_integer_type(type.get_size(), is_signed_shift);
+        TL::Type amount_type = get_integer_type(type.get_size(), /* is_signed */ false);
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(lhs);
+
+        Nodecl::NodeclBase rhs_without_conversions = Nodecl::Utils::advance_conversions(rhs);
+        if (rhs_without_conversions.is<Nodecl::VectorPromotion>())
+        {
+            intrin_name += "n_";
+            rhs_expression << as_expression(rhs_without_conversions.as<Nodecl::VectorPromotion>().get_rhs());
+        }
+        else
+        {
+            TL::Type rhs_type = rhs.get_type().basic_type();
+
+            walk(rhs);
+            rhs_expression << get_reinterpret(as_expression(rhs), rhs_type, amount_type,
+                    vector_type, n);
+        }
+
+        intrin_name += get_integer_suffix(op_type, n) + "_x";
+
+        op_src << get_intrinsic(intrin_name, op_type.get_vector_of_bytes(vector_type.get_size()))
+            << "("
+            << predicate
+            << ", "
+            << get_reinterpret(as_expression(lhs), type, op_type, vector_type, n)
+            << ", "
+            << rhs_expression
+            << ")"
+            ;
+
+        intrin_src << get_reinterpret(op_src.get_source(), op_type, type, vector_type, n);
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorBitwiseShl& n)
+    {
+        common_shift_op_lowering(n, "lsl", n.get_type().basic_type().is_signed_integral());
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorArithmeticShr& n)
+    {
+        common_shift_op_lowering(n, "asr", /* is_signed_shift */ true);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorBitwiseShr& n)
+    {
+        common_shift_op_lowering(n, "lsr", /* is_signed_shift */ false);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorLogicalOr& n)
+    {
+        fatal_error("SVE Backend %s: 'logical or' operation (i.e., operator '||') is not "\
+                "supported in SVE. Try using 'bitwise or' operations (i.e., operator '|') instead if possible.",
+                locus_to_str(n.get_locus()));
+    }
+
+    // svext takes the elements from the first operand onwards
+    // followed by the ones of the second operand
+    void SVEVectorBackend::visit(const Nodecl::VectorAlignRight& n)
+    {
+        const Nodecl::NodeclBase left_vector = n.get_left_vector();
+        const Nodecl::NodeclBase right_vector = n.get_right_vector();
+        const Nodecl::NodeclBase num_elements = n.get_num_elements();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src;
+
+        if (vector_type.get_size() != _vector_length)
+        {
+            internal_error("SVE Backend: Node %s at %s has a vector narrower than the target "\
+                    "vector length.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        walk(left_vector);
+        walk(right_vector);
+        walk(num_elements);
+
+        intrin_src << get_intrinsic("svext_" + get_type_suffix(type, n), vector_type)
+            << "("
+            << as_expression(right_vector)
+            << ", "
+            << as_expression(left_vector)
+            << ", "
+            << as_expression(num_elements)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    // The SVE ISA descriptor does not support shuffles,
+    // so the vectorizer never emits them
+    void SVEVectorBackend::visit(const Nodecl::VectorShuffle& n)
+    {
+        internal_error("SVE Backend: Node %s at %s is not supported.",
+                ast_print_node_type(n.get_kind()),
+                locus_to_str(n.get_locus()));
+    }
+
+    // Integer <-> floating point conversions are done between elements
+    // of the same size. Integers are resized before (or after) them.
+    // Floating point conversions work on the low half of each wider element,
+    // so the narrower vector is interleaved with zeros before them
+    // and the result is compacted after them
+    void SVEVectorBackend::visit(const Nodecl::VectorConversion& n)
+    {
+        const Nodecl::NodeclBase nest = n.get_nest();
+
+        const TL::Type& src_vector_type = nest.get_type().get_unqualified_type().no_ref();
+        const TL::Type& dst_vector_type = n.get_type().get_unqualified_type().no_ref();
+        const TL::Type& src_type = src_vector_type.basic_type().get_unqualified_type();
+        const TL::Type& dst_type = dst_vector_type.basic_type().get_unqualified_type();
+        const unsigned int src_type_size = src_type.get_size();
+        const unsigned int dst_type_size = dst_type.get_size();
+
+        ERROR_CONDITION(src_vector_type.is_same_type(dst_vector_type),
+                "VectorConversion between same vector types: %s",
+                print_type_str(dst_vector_type.get_internal_type(),
+                    n.retrieve_context().get_decl_context()));
+
+        if (dst_vector_type.get_size() > _vector_length)
+        {
+            internal_error("SVE Backend: Node %s at %s has a vector of %d bytes, "\
+                    "which is wider than the target vector length (%d bytes).",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    dst_vector_type.get_size(), _vector_length);
+        }
+
+        walk(nest);
+
+        std::string result = as_expression(nest);
+        TL::Type current_type = src_type;
+
+        if (src_type.is_integral_type() && dst_type.is_integral_type())
+        {
+            result = resize_integer_vector(result, src_type, dst_type, n);
+            current_type = get_integer_type(dst_type_size, src_type.is_signed_integral());
+        }
+        else if (src_type.is_integral_type() && dst_type.is_floating_type())
+        {
+            TL::Type int_type = get_integer_type(dst_type_size, src_type.is_signed_integral());
+
+            result = get_intrinsic("svcvt_" + get_type_suffix(dst_type, n)
+                        + "_" + get_integer_suffix(int_type, n) + "_x",
+                    dst_type.get_vector_of_bytes(_vector_length))
+                + "(" + get_ptrue(dst_type_size) + ", "
+                + resize_integer_vector(result, src_type, int_type, n)
+                + ")";
+            current_type = dst_type;
+        }
+        else if (src_type.is_floating_type() && dst_type.is_integral_type())
+        {
+            TL::Type int_type = get_integer_type(src_type_size, dst_type.is_signed_integral());
+
+            result = get_intrinsic("svcvt_" + get_integer_suffix(int_type, n)
+                        + "_" + get_type_suffix(src_type, n) + "_x",
+                    int_type.get_vector_of_bytes(_vector_length))
+                + "(" + get_ptrue(src_type_size) + ", " + result + ")";
+            result = resize_integer_vector(result, int_type, dst_type, n);
+            current_type = get_integer_type(dst_type_size, dst_type.is_signed_integral());
+        }
+        else if (src_type.is_float() && dst_type.is_double())
+        {
+            result = get_intrinsic("svcvt_f64_f32_x", dst_type.get_vector_of_bytes(_vector_length))
+                + "(" + get_ptrue(dst_type_size) + ", "
+                + get_intrinsic("svzip1_f32", src_type.get_vector_of_bytes(_vector_length))
+                + "(" + result + ", "
+                + get_intrinsic("svdup_n_f32", src_type.get_vector_of_bytes(_vector_length))
+                + "(0.0f)))";
+            current_type = dst_type;
+        }
+        else if (src_type.is_double() && dst_type.is_float())
+        {
+            result = get_intrinsic("svuzp1_f32", dst_type.get_vector_of_bytes(_vector_length))
+                + "("
+                + get_intrinsic("svcvt_f32_f64_x", dst_type.get_vector_of_bytes(_vector_length))
+                + "(" + get_ptrue(src_type_size) + ", " + result + "), "
+                + get_intrinsic("svdup_n_f32", dst_type.get_vector_of_bytes(_vector_length))
+                + "(0.0f))";
+            current_type = dst_type;
+        }
+        else
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported conversion: %s -> %s.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    print_type_str(src_vector_type.get_internal_type(),
+                        n.retrieve_context().get_decl_context()),
+                    print_type_str(dst_vector_type.get_internal_type(),
+                        n.retrieve_context().get_decl_context()));
+        }
+
+        TL::Source intrin_src;
+        intrin_src << get_reinterpret(result, current_type, dst_type, dst_vector_type, n);
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorCast& n)
+    {
+        const Nodecl::NodeclBase rhs = n.get_rhs();
+
+        const TL::Type& dst_vector_type = n.get_type().get_unqualified_type().no_ref();
+        const TL::Type& dst_type = dst_vector_type.basic_type().get_unqualified_type();
+        const TL::Type& src_type = rhs.get_type().basic_type().get_unqualified_type();
+
+        TL::Source intrin_src;
+
+        walk(rhs);
+
+        intrin_src << get_reinterpret(as_expression(rhs), src_type, dst_type,
+                dst_vector_type, n);
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorPromotion& n)
+    {
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src;
+
+        walk(n.get_rhs());
+
+        intrin_src << get_intrinsic("svdup_n_" + get_type_suffix(type, n), vector_type)
+            << "("
+            << as_expression(n.get_rhs())
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    // Constant integer sequences become svindex(base, step).
+    // Any other literal is loaded from a compound literal
+    void SVEVectorBackend::visit(const Nodecl::VectorLiteral& n)
+    {
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type scalar_type = vector_type.basic_type();
+
+        TL::Source intrin_src, values, predicate;
+
+        Nodecl::List scalar_values =
+            n.get_scalar_values().as<Nodecl::List>();
+
+        const std::string suffix = get_type_suffix(scalar_type, n);
+
+        bool is_sequence = scalar_type.is_integral_type()
+            && scalar_values.size() > 1;
+        long long int base = 0, step = 0;
+
+        int i = 0;
+        for (Nodecl::List::const_iterator it = scalar_values.begin();
+                it != scalar_values.end() && is_sequence;
+                it++, i++)
+        {
+            if (!it->is_constant())
+            {
+                is_sequence = false;
+                break;
+            }
+
+            long long int value = (long long int)const_value_cast_to_8(it->get_constant());
+
+            if (i == 0)
+                base = value;
+            else if (i == 1)
+                step = value - base;
+            else if (value != base + i * step)
+                is_sequence = false;
+        }
+
+        if (is_sequence)
+        {
+            intrin_src << get_intrinsic("svindex_" + suffix, vector_type)
+                << "(" << base << ", " << step << ")";
+        }
+        else
+        {
+            for (Nodecl::List::const_iterator it = scalar_values.begin();
+                    it != scalar_values.end();
+                    it++)
+            {
+                walk((*it));
+                values.append_with_separator(as_expression(*it), ",");
+            }
+
+            process_mask_component(Nodecl::NodeclBase::null(), predicate, vector_type, n);
+
+            intrin_src << get_intrinsic("svld1_" + suffix, vector_type)
+                << "("
+                << predicate
+                << ", "
+                << "(" << print_type_str(scalar_type.get_internal_type(),
+                        n.retrieve_context().get_decl_context())
+                << "[]){" << values << "}"
+                << ")"
+                ;
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorConditionalExpression& n)
+    {
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        Nodecl::NodeclBase true_node = n.get_true();
+        Nodecl::NodeclBase false_node = n.get_false();
+        Nodecl::NodeclBase condition_node = n.get_condition();
+
+        TL::Source intrin_src;
+
+        walk(false_node);
+        walk(true_node);
+        walk(condition_node);
+
+        intrin_src << get_intrinsic("svsel_" + get_type_suffix(type, n), vector_type)
+            << "("
+            << as_expression(condition_node)
+            << ", "
+            << as_expression(true_node)
+            << ", "
+            << as_expression(false_node)
+            << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    // Masked lanes keep the old value of the LHS
+    void SVEVectorBackend::visit(const Nodecl::VectorAssignment& n)
+    {
+        Nodecl::NodeclBase lhs = n.get_lhs();
+        Nodecl::NodeclBase rhs = n.get_rhs();
+        Nodecl::NodeclBase mask = n.get_mask();
+        bool lhs_has_been_defined = !n.get_has_been_defined().is_null();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << as_expression(lhs)
+            << " = "
+            ;
+
+        if (mask.is_null() || !lhs_has_been_defined)
+        {
+            intrin_src << as_expression(rhs);
+        }
+        else
+        {
+            process_mask_component(mask, predicate, vector_type, n);
+
+            intrin_src << get_intrinsic("svsel_" + get_type_suffix(type, n), vector_type)
+                << "("
+                << predicate
+                << ", "
+                << as_expression(rhs)
+                << ", "
+                << as_expression(lhs)
+                << ")"
+                ;
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorPrefetch& n)
+    {
+        Nodecl::NodeclBase address = n.get_address();
+        PrefetchKind kind = (PrefetchKind) const_value_cast_to_signed_int(
+                n.get_prefetch_kind().as<Nodecl::IntegerLiteral>().get_constant());
+
+        TL::Source intrin_src, prefetch_op;
+
+        // Values of enum svprfop
+        switch (kind)
+        {
+            case PrefetchKind::L1_READ:
+                prefetch_op << "0"; // SV_PLDL1KEEP
+                break;
+            case PrefetchKind::L2_READ:
+                prefetch_op << "2"; // SV_PLDL2KEEP
+                break;
+            case PrefetchKind::L1_WRITE:
+                prefetch_op << "8"; // SV_PSTL1KEEP
+                break;
+            case PrefetchKind::L2_WRITE:
+                prefetch_op << "10"; // SV_PSTL2KEEP
+                break;
+            default:
+                internal_error("SVE Backend: Node %s at %s has a wrong prefetch kind.",
+                        ast_print_node_type(n.get_kind()),
+                        locus_to_str(n.get_locus()));
+        }
+
+        walk(address);
+
+        intrin_src << get_intrinsic("svprfb", TL::Type::get_void_type())
+            << "("
+            << get_ptrue(1)
+            << ", "
+            << "(const void *)"
+            << as_expression(address)
+            << ", "
+            << prefetch_op
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    // Speculative loads (before an early exit) are first-faulting,
+    // so reading past the end of the data does not trap
+    void SVEVectorBackend::visit(const Nodecl::VectorLoad& n)
+    {
+        Nodecl::NodeclBase rhs = n.get_rhs();
+        Nodecl::NodeclBase mask = n.get_mask();
+        Nodecl::List flags = n.get_flags().as<Nodecl::List>();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        bool speculative = !flags.find_first<Nodecl::SpeculativeFlag>().is_null();
+
+        TL::Source intrin_src, predicate;
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(rhs);
+
+        intrin_src << get_intrinsic((speculative ? "svldff1_" : "svld1_")
+                    + get_type_suffix(type, n),
+                vector_type)
+            << "("
+            << predicate
+            << ", "
+            << get_casting_to_pointer(type)
+            << "("
+            << as_expression(rhs)
+            << "))"
+            ;
+
+        if (speculative && !_loops.empty())
+            _loops.back().has_speculative_loads = true;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorStore& n)
+    {
+        Nodecl::NodeclBase lhs = n.get_lhs();
+        Nodecl::NodeclBase rhs = n.get_rhs();
+        Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = rhs.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << get_intrinsic("svst1_" + get_type_suffix(type, n),
+                TL::Type::get_void_type())
+            << "("
+            << predicate
+            << ", "
+            << get_casting_to_pointer(type)
+            << "("
+            << as_expression(lhs)
+            << "), "
+            << as_expression(rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    // 32-bit indexes are extended for 64-bit elements.
+    // Masked lanes are zeroed and merged by the enclosing assignment
+    void SVEVectorBackend::visit(const Nodecl::VectorGather& n)
+    {
+        const Nodecl::NodeclBase base = n.get_base();
+        const Nodecl::NodeclBase strides = n.get_strides();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+        TL::Type index_type = strides.get_type().basic_type();
+
+        TL::Source intrin_src, predicate, indexes;
+
+        if (type.get_size() != 4 && type.get_size() != 8)
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported source type: %s",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    type.get_simple_declaration(n.retrieve_context(), "").c_str());
+        }
+
+        if ((!index_type.is_signed_int()) && (!index_type.is_unsigned_int()))
+        {
+            internal_error("SVE Backend: Node %s (%s) at %s has an unsupported index type: %s",
+                    base.prettyprint().c_str(),
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    index_type.get_simple_declaration(n.retrieve_context(), "").c_str());
+        }
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(base);
+        walk(strides);
+
+        TL::Type element_index_type = get_integer_type(type.get_size(),
+                index_type.is_signed_int());
+        const std::string index_suffix = get_integer_suffix(element_index_type, n);
+
+        indexes << resize_integer_vector(as_expression(strides), index_type,
+                element_index_type, n);
+
+        intrin_src << get_intrinsic("svld1_gather_" + index_suffix + "index_"
+                    + get_type_suffix(type, n),
+                vector_type)
+            << "("
+            << predicate
+            << ", "
+            << get_casting_to_pointer(type)
+            << "(" << as_expression(base) << ")"
+            << ", "
+            << indexes
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorScatter& n)
+    {
+        const Nodecl::NodeclBase base = n.get_base();
+        const Nodecl::NodeclBase strides = n.get_strides();
+        const Nodecl::NodeclBase source = n.get_source();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type vector_type = source.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+        TL::Type index_type = strides.get_type().basic_type();
+
+        TL::Source intrin_src, predicate, indexes;
+
+        if ((!index_type.is_signed_int()) && (!index_type.is_unsigned_int()))
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported index type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        if (type.get_size() != 4 && type.get_size() != 8)
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported source type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(base);
+        walk(strides);
+        walk(source);
+
+        TL::Type element_index_type = get_integer_type(type.get_size(),
+                index_type.is_signed_int());
+        const std::string index_suffix = get_integer_suffix(element_index_type, n);
+
+        indexes << resize_integer_vector(as_expression(strides), index_type,
+                element_index_type, n);
+
+        intrin_src << get_intrinsic("svst1_scatter_" + index_suffix + "index_"
+                    + get_type_suffix(type, n),
+                TL::Type::get_void_type())
+            << "("
+            << predicate
+            << ", "
+            << get_casting_to_pointer(type)
+            << "(" << as_expression(base) << ")"
+            << ", "
+            << indexes
+            << ", "
+            << as_expression(source)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorFunctionCall& n)
+    {
+        Nodecl::FunctionCall function_call =
+            n.get_function_call().as<Nodecl::FunctionCall>();
+
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        // Masked lanes are merged with the old value by the enclosing assignment
+        if (!mask.is_null())
+            walk(mask);
+
+        walk(function_call.get_arguments());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorFabs& n)
+    {
+        const Nodecl::NodeclBase mask = n.get_mask();
+        const Nodecl::NodeclBase argument = n.get_argument();
+
+        TL::Type vector_type = n.get_type().no_ref();
+        TL::Type type = vector_type.basic_type();
+
+        TL::Source intrin_src, predicate;
+
+        if (!type.is_floating_type())
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported type.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()));
+        }
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(argument);
+
+        intrin_src << get_intrinsic("svabs_" + get_type_suffix(type, n) + "_x", vector_type)
+            << "("
+            << predicate
+            << ", "
+            << as_expression(argument)
+            << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::ParenthesizedExpression& n)
+    {
+        walk(n.get_nest());
+
+        Nodecl::NodeclBase new_n(n.shallow_copy());
+        new_n.set_type(n.get_nest().get_type());
+        n.replace(new_n);
+    }
+
+    // Masked lanes do not take part in the reduction
+    void SVEVectorBackend::visit(const Nodecl::VectorReductionAdd& n)
+    {
+        const Nodecl::NodeclBase vector_src = n.get_vector_src();
+        const Nodecl::NodeclBase mask = n.get_mask();
+
+        TL::Type type = n.get_type().no_ref();
+        TL::Type vector_type = vector_src.get_type().no_ref();
+
+        TL::Source intrin_src, predicate;
+
+        process_mask_component(mask, predicate, vector_type, n);
+
+        walk(vector_src);
+
+        intrin_src << get_intrinsic("svaddv_" + get_type_suffix(vector_type.basic_type(), n),
+                type)
+            << "("
+            << predicate
+            << ", "
+            << as_expression(vector_src)
+            << ")";
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorReductionMinus& n)
+    {
+        // OpenMP defines reduction(-:a) in the same way as reduction(+:a)
+        visit(n.as<Nodecl::VectorReductionAdd>());
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskAssignment& n)
+    {
+        TL::Source intrin_src;
+
+        walk(n.get_lhs());
+        walk(n.get_rhs());
+
+        intrin_src << as_expression(n.get_lhs())
+            << " = "
+            << as_expression(n.get_rhs())
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskConversion& n)
+    {
+        walk(n.get_nest());
+
+        n.get_nest().set_type(n.get_type());
+
+        n.replace(n.get_nest());
+    }
+
+    // Predicate operations are governed by an all-true predicate
+    // of the element size of the mask, so the bits between lanes stay clear
+    void SVEVectorBackend::common_mask_op_lowering(const Nodecl::NodeclBase& n,
+            const std::string& intrin_op_name,
+            const bool swap_operands)
+    {
+        const Nodecl::VectorMaskAnd& binary_node = n.as<Nodecl::VectorMaskAnd>();
+
+        const Nodecl::NodeclBase lhs = binary_node.get_lhs();
+        const Nodecl::NodeclBase rhs = binary_node.get_rhs();
+
+        const TL::Type mask_type = n.get_type().no_ref();
+
+        TL::Source intrin_src;
+
+        walk(lhs);
+        walk(rhs);
+
+        intrin_src << get_intrinsic("sv" + intrin_op_name + "_b_z", mask_type)
+            << "("
+            << get_ptrue(_vector_length / mask_type.get_mask_num_elements())
+            << ", "
+            << as_expression(swap_operands ? rhs : lhs)
+            << ", "
+            << as_expression(swap_operands ? lhs : rhs)
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskNot& n)
+    {
+        const TL::Type mask_type = n.get_type().no_ref();
+
+        TL::Source intrin_src;
+
+        walk(n.get_rhs());
+
+        intrin_src << get_intrinsic("svnot_b_z", mask_type)
+            << "("
+            << get_ptrue(_vector_length / mask_type.get_mask_num_elements())
+            << ", "
+            << as_expression(n.get_rhs())
+            << ")"
+            ;
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskAnd& n)
+    {
+        common_mask_op_lowering(n, "and");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskOr& n)
+    {
+        common_mask_op_lowering(n, "orr");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskAnd1Not& n)
+    {
+        // svbic computes first & (~second)
+        common_mask_op_lowering(n, "bic", /* swap_operands */ true);
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskAnd2Not& n)
+    {
+        common_mask_op_lowering(n, "bic");
+    }
+
+    void SVEVectorBackend::visit(const Nodecl::VectorMaskXor& n)
+    {
+        common_mask_op_lowering(n, "eor");
+    }
+
+    // The lowest lanes are the most common mask literals (epilogs).
+    // Any other one is built comparing a vector of 0/1 values
+    void SVEVectorBackend::visit(const Nodecl::MaskLiteral& n)
+    {
+        const TL::Type mask_type = n.get_type().no_ref();
+        const unsigned int mask_num_elements = mask_type.get_mask_num_elements();
+        const unsigned int element_size = _vector_length / mask_num_elements;
+
+        if (element_size != 1 && element_size != 2
+                && element_size != 4 && element_size != 8)
+        {
+            internal_error("SVE Backend: Node %s at %s has an unsupported number of elements: %d.",
+                    ast_print_node_type(n.get_kind()),
+                    locus_to_str(n.get_locus()),
+                    mask_num_elements);
+        }
+
+        const uint64_t all_ones = (mask_num_elements >= 64) ? ~(uint64_t)0
+            : (((uint64_t)1 << mask_num_elements) - 1);
+        const uint64_t value = const_value_cast_to_8(n.get_constant()) & all_ones;
+
+        unsigned int num_low_lanes = 0;
+        while (num_low_lanes < mask_num_elements
+                && (value & ((uint64_t)1 << num_low_lanes)))
+            num_low_lanes++;
+
+        TL::Source intrin_src;
+
+        if (value == all_ones)
+        {
+            intrin_src << get_ptrue(element_size);
+        }
+        else if (value == 0)
+        {
+            intrin_src << get_intrinsic("svpfalse_b", mask_type) << "()";
+        }
+        else if (value == (((uint64_t)1 << num_low_lanes) - 1))
+        {
+            intrin_src << get_intrinsic("svwhilelt_" + get_predicate_suffix(element_size) + "_s32",
+                    mask_type)
+                << "(0, " << num_low_lanes << ")";
+        }
+        else
+        {
+            TL::Type lane_type = get_integer_type(element_size, /* is_signed */ false);
+            TL::Type lane_vector_type = lane_type.get_vector_of_bytes(_vector_length);
+            const std::string suffix = get_integer_suffix(lane_type, n);
+            const std::string ptrue = get_ptrue(element_size);
+
+            TL::Source lanes;
+            for (unsigned int i = 0; i < mask_num_elements; i++)
+            {
+                lanes.append_with_separator(
+                        (value & ((uint64_t)1 << i)) ? "1" : "0", ",");
+            }
+
+            intrin_src << get_intrinsic("svcmpne_n_" + suffix, mask_type)
+                << "("
+                << ptrue
+                << ", "
+                << get_intrinsic("svld1_" + suffix, lane_vector_type)
+                << "("
+                << ptrue
+                << ", "
+                << "(" << print_type_str(lane_type.get_internal_type(),
+                        n.retrieve_context().get_decl_context())
+                << "[]){" << lanes << "}"
+                << "), 0)"
+                ;
+        }
+
+        Nodecl::NodeclBase function_call =
+            intrin_src.parse_expression(n.retrieve_context());
+
+        n.replace(function_call);
+    }
+
+    Nodecl::NodeclVisitor<void>::Ret SVEVectorBackend::unhandled_node(const Nodecl::NodeclBase& n)
+    {
+        internal_error("SVE Backend: Unknown node %s at %s.",
+                ast_print_node_type(n.get_kind()),
+                locus_to_str(n.get_locus()));
+
+        return Ret();
+    }
+}
+}
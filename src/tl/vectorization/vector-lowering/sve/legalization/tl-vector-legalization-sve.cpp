@@ -0,0 +1,61 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+  --------------------------------------------------------------------*/
+
+#include "tl-vector-legalization-sve.hpp"
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    SVEVectorLegalization::SVEVectorLegalization(bool prefer_gather_scatter,
+            bool prefer_mask_gather_scatter)
+        : KNCVectorLegalization(prefer_gather_scatter, prefer_mask_gather_scatter)
+    {
+        std::cerr << "--- SVE legalization phase ---" << std::endl;
+    }
+
+    void SVEVectorLegalization::visit(const Nodecl::VectorConversion& n)
+    {
+        walk(n.get_nest());
+
+        const TL::Type& src_vector_type = n.get_nest().get_type().get_unqualified_type().no_ref();
+        const TL::Type& dst_vector_type = n.get_type().get_unqualified_type().no_ref();
+        const TL::Type& src_type = src_vector_type.basic_type().get_unqualified_type();
+
+        // If mask type, conversion is not needed
+        if (dst_vector_type.is_mask() && src_type.is_integral_type())
+        {
+            n.replace(n.get_nest());
+        }
+        // If both types are the same, remove conversion
+        else if (dst_vector_type.is_same_type(src_vector_type))
+        {
+            n.replace(n.get_nest());
+        }
+    }
+}
+}
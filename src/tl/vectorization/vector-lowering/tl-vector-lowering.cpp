@@ -31,10 +31,14 @@
 #include "tl-vector-backend-knc.hpp"
 #include "tl-vector-legalization-knl.hpp"
 #include "tl-vector-backend-knl.hpp"
+#include "tl-vector-legalization-avx512.hpp"
+#include "tl-vector-backend-avx512.hpp"
 #include "tl-vector-legalization-avx2.hpp"
 #include "tl-vector-backend-avx2.hpp"
 #include "tl-vector-legalization-neon.hpp"
 #include "tl-vector-backend-neon.hpp"
+#include "tl-vector-legalization-sve.hpp"
+#include "tl-vector-backend-sve.hpp"
 #include "tl-vector-legalization-romol.hpp"
 #include "tl-vector-backend-romol.hpp"
 #include "tl-vector-romol-regalloc.hpp"
@@ -47,9 +51,13 @@ namespace TL
     {
         VectorLoweringPhase::VectorLoweringPhase()
             : _knl_enabled(false),
+            _avx512_enabled(false),
+            _avx512_vector_length(512),
             _knc_enabled(false),
             _avx2_enabled(false),
             _neon_enabled(false),
+            _sve_enabled(false),
+            _sve_vector_length(512),
             _romol_enabled(false),
             _prefer_gather_scatter(false),
             _prefer_mask_gather_scatter(false),
@@ -57,13 +65,23 @@ namespace TL
         {
             set_phase_name("Vector Lowering Phase");
             set_phase_description("This phase lowers Vector IR to builtin calls. "
-                    "By default targets SSE but AVX, AVX2, KNC, KNL, NEON and RoMoL are implemented as well");
+                    "By default targets SSE but AVX, AVX2, AVX-512, KNC, KNL, NEON, SVE and RoMoL are implemented as well");
 
             register_parameter("knl_enabled",
                     "If set to '1' enables compilation for KNC architecture, otherwise it is disabled",
                     _knl_enabled_str,
                     "0").connect(std::bind(&VectorLoweringPhase::set_knl, this, std::placeholders::_1));
 
+            register_parameter("avx512_enabled",
+                    "If set to '1' enables compilation for AVX-512 (F, VL, BW and DQ) architecture, otherwise it is disabled",
+                    _avx512_enabled_str,
+                    "0").connect(std::bind(&VectorLoweringPhase::set_avx512, this, std::placeholders::_1));
+
+            register_parameter("avx512_vector_length",
+                    "Vector length in bits used when compiling for AVX-512: '512' (default) or '256'",
+                    _avx512_vector_length_str,
+                    "512").connect(std::bind(&VectorLoweringPhase::set_avx512_vector_length, this, std::placeholders::_1));
+
             register_parameter("mic_enabled",
                     "If set to '1' enables compilation for KNC architecture, otherwise it is disabled",
                     _knc_enabled_str,
@@ -79,6 +97,16 @@ namespace TL
                     _neon_enabled_str,
                     "0").connect(std::bind(&VectorLoweringPhase::set_neon, this, std::placeholders::_1));
 
+            register_parameter("sve_enabled",
+                    "If set to '1' enables compilation for SVE architecture, otherwise it is disabled",
+                    _sve_enabled_str,
+                    "0").connect(std::bind(&VectorLoweringPhase::set_sve, this, std::placeholders::_1));
+
+            register_parameter("sve_vector_length",
+                    "Vector length in bits assumed when compiling for SVE: '512' (default), '256' or '128'",
+                    _sve_vector_length_str,
+                    "512").connect(std::bind(&VectorLoweringPhase::set_sve_vector_length, this, std::placeholders::_1));
+
             register_parameter("romol_enabled",
                     "If set to '1' enables compilation for RoMoL architecture, otherwise it is disabled",
                     _romol_enabled_str,
@@ -105,6 +133,22 @@ namespace TL
             parse_boolean_option("knl_enabled", knl_enabled_str, _knl_enabled, "Invalid value for knl_enabled");
         }
 
+        void VectorLoweringPhase::set_avx512(const std::string& avx512_enabled_str)
+        {
+            parse_boolean_option("avx512_enabled", avx512_enabled_str, _avx512_enabled, "Invalid value for avx512_enabled");
+        }
+
+        void VectorLoweringPhase::set_avx512_vector_length(const std::string& avx512_vector_length_str)
+        {
+            if (avx512_vector_length_str == "512")
+                _avx512_vector_length = 512;
+            else if (avx512_vector_length_str == "256")
+                _avx512_vector_length = 256;
+            else
+                fatal_error("Invalid value for avx512_vector_length '%s'. Valid values are '512' and '256'\n",
+                        avx512_vector_length_str.c_str());
+        }
+
         void VectorLoweringPhase::set_knc(const std::string& knc_enabled_str)
         {
             parse_boolean_option("knc_enabled", knc_enabled_str, _knc_enabled, "Invalid value for knc_enabled");
@@ -120,6 +164,24 @@ namespace TL
             parse_boolean_option("neon_enabled", neon_enabled_str, _neon_enabled, "Invalid value for neon_enabled");
         }
 
+        void VectorLoweringPhase::set_sve(const std::string& sve_enabled_str)
+        {
+            parse_boolean_option("sve_enabled", sve_enabled_str, _sve_enabled, "Invalid value for sve_enabled");
+        }
+
+        void VectorLoweringPhase::set_sve_vector_length(const std::string& sve_vector_length_str)
+        {
+            if (sve_vector_length_str == "512")
+                _sve_vector_length = 512;
+            else if (sve_vector_length_str == "256")
+                _sve_vector_length = 256;
+            else if (sve_vector_length_str == "128")
+                _sve_vector_length = 128;
+            else
+                fatal_error("Invalid value for sve_vector_length '%s'. Valid values are '512', '256' and '128'\n",
+                        sve_vector_length_str.c_str());
+        }
+
         void VectorLoweringPhase::set_romol(const std::string& romol_enabled_str)
         {
             parse_boolean_option("romol_enabled", romol_enabled_str, _romol_enabled, "Invalid value for romol_enabled");
@@ -163,7 +225,9 @@ namespace TL
                 { _avx2_enabled, "AVX2" },
                 { _knc_enabled, "KNC" },
                 { _knl_enabled, "KNL" },
+                { _avx512_enabled, "AVX-512" },
                 { _neon_enabled, "NEON" },
+                { _sve_enabled, "SVE" },
                 { _romol_enabled, "RoMoL" },
             };
 
@@ -183,73 +247,142 @@ namespace TL
                 }
             }
 
-            if(_avx2_enabled)
+            VectorInstructionSet isa = SSE4_2_ISA;
+            if (_avx2_enabled)
+                isa = AVX2_ISA;
+            else if (_knc_enabled)
+                isa = KNC_ISA;
+            else if (_knl_enabled)
+                isa = KNL_ISA;
+            else if (_avx512_enabled)
+                isa = (_avx512_vector_length == 256) ? AVX512_256_ISA : AVX512_ISA;
+            else if (_neon_enabled)
+                isa = NEON_ISA;
+            else if (_sve_enabled)
+                isa = (_sve_vector_length == 128) ? SVE_128_ISA :
+                    (_sve_vector_length == 256) ? SVE_256_ISA : SVE_ISA;
+            else if (_romol_enabled)
+                isa = ROMOL_ISA;
+
+            // Functions compiled for a different ISA (e.g. runtime dispatch
+            // versions) are lowered first with their own backend
+            const std::map<TL::Symbol, VectorInstructionSet>& isa_specific_functions =
+                Vectorizer::get_vectorizer().get_isa_specific_functions();
+            for (std::map<TL::Symbol, VectorInstructionSet>::const_iterator it = isa_specific_functions.begin();
+                    it != isa_specific_functions.end();
+                    it++)
+            {
+                Nodecl::NodeclBase function_code = it->first.get_function_code();
+                if (function_code.is_null())
+                    continue;
+
+                lower_vector_code(function_code, it->second);
+            }
+
+            lower_vector_code(translation_unit, isa);
+        }
+
+        void VectorLoweringPhase::lower_vector_code(Nodecl::NodeclBase n,
+                VectorInstructionSet isa)
+        {
+            if (isa == AVX2_ISA)
             {
                 // AVX2 Legalization phase
                 AVX2VectorLegalization avx2_vector_legalization;
-                avx2_vector_legalization.walk(translation_unit);
+                avx2_vector_legalization.walk(n);
 
                 VectorizationThreeAddresses three_addresses_visitor;
-                three_addresses_visitor.walk(translation_unit);
+                three_addresses_visitor.walk(n);
 
                 // AVX2 Lowering to intrinsics
                 AVX2VectorLowering avx2_vector_lowering;
-                avx2_vector_lowering.walk(translation_unit);
+                avx2_vector_lowering.walk(n);
             }
-            else if (_knc_enabled)
+            else if (isa == KNC_ISA)
             {
                 // KNC Legalization phase
                 KNCVectorLegalization knc_vector_legalization(
                         _prefer_gather_scatter, _prefer_mask_gather_scatter);
-                knc_vector_legalization.walk(translation_unit);
+                knc_vector_legalization.walk(n);
 
                 VectorizationThreeAddresses three_addresses_visitor;
-                three_addresses_visitor.walk(translation_unit);
+                three_addresses_visitor.walk(n);
 
                 // Lowering to intrinsics
                 KNCVectorBackend knc_vector_backend;
-                knc_vector_backend.walk(translation_unit);
+                knc_vector_backend.walk(n);
             }
-            else if (_knl_enabled)
+            else if (isa == KNL_ISA)
             {
                 // KNL Legalization phase
                 KNLVectorLegalization knl_vector_legalization(
                         _prefer_gather_scatter, _prefer_mask_gather_scatter);
-                knl_vector_legalization.walk(translation_unit);
+                knl_vector_legalization.walk(n);
 
                 VectorizationThreeAddresses three_addresses_visitor;
-                three_addresses_visitor.walk(translation_unit);
+                three_addresses_visitor.walk(n);
 
                 // Lowering to intrinsics
                 KNLVectorBackend knl_vector_backend;
-                knl_vector_backend.walk(translation_unit);
+                knl_vector_backend.walk(n);
             }
-            else if (_neon_enabled)
+            else if (isa == AVX512_ISA || isa == AVX512_256_ISA)
+            {
+                // AVX-512 Legalization phase
+                AVX512VectorLegalization avx512_vector_legalization(
+                        _prefer_gather_scatter, _prefer_mask_gather_scatter);
+                avx512_vector_legalization.walk(n);
+
+                VectorizationThreeAddresses three_addresses_visitor;
+                three_addresses_visitor.walk(n);
+
+                // Lowering to intrinsics
+                AVX512VectorBackend avx512_vector_backend(
+                        (isa == AVX512_256_ISA) ? 32 : 64);
+                avx512_vector_backend.walk(n);
+            }
+            else if (isa == NEON_ISA)
             {
                 // NEON legalization
                 NeonVectorLegalization neon_vector_legalization;
-                neon_vector_legalization.walk(translation_unit);
+                neon_vector_legalization.walk(n);
 
                 VectorizationThreeAddresses three_addresses_visitor;
-                three_addresses_visitor.walk(translation_unit);
+                three_addresses_visitor.walk(n);
 
                 // Lower to NEON intrinsics
                 NeonVectorBackend neon_vector_backend;
-                neon_vector_backend.walk(translation_unit);
+                neon_vector_backend.walk(n);
             }
-            else if (_romol_enabled)
+            else if (isa == SVE_ISA || isa == SVE_256_ISA || isa == SVE_128_ISA)
+            {
+                // SVE legalization
+                SVEVectorLegalization sve_vector_legalization(
+                        _prefer_gather_scatter, _prefer_mask_gather_scatter);
+                sve_vector_legalization.walk(n);
+
+                VectorizationThreeAddresses three_addresses_visitor;
+                three_addresses_visitor.walk(n);
+
+                // Lower to SVE (ACLE) intrinsics
+                SVEVectorBackend sve_vector_backend(
+                        (isa == SVE_128_ISA) ? 16 :
+                        (isa == SVE_256_ISA) ? 32 : 64);
+                sve_vector_backend.walk(n);
+            }
+            else if (isa == ROMOL_ISA)
             {
                 RomolVectorLegalization romol_vector_legalization;
-                romol_vector_legalization.walk(translation_unit);
+                romol_vector_legalization.walk(n);
 
                 VectorizationThreeAddresses three_addresses_visitor;
-                three_addresses_visitor.walk(translation_unit);
+                three_addresses_visitor.walk(n);
 
                 RomolVectorRegAlloc romol_vector_ra;
-                romol_vector_ra.walk(translation_unit);
+                romol_vector_ra.walk(n);
 
                 RomolVectorBackend romol_vector_backend;
-                romol_vector_backend.walk(translation_unit);
+                romol_vector_backend.walk(n);
 
                 if (_valib_sim_header)
                 {
@@ -262,13 +395,13 @@ namespace TL
             else
             {
                 SSEVectorLegalization sse_vector_legalization;
-                sse_vector_legalization.walk(translation_unit);
+                sse_vector_legalization.walk(n);
 
                 VectorizationThreeAddresses three_addresses_visitor;
-                three_addresses_visitor.walk(translation_unit);
+                three_addresses_visitor.walk(n);
 
                 SSEVectorBackend sse_vector_backend;
-                sse_vector_backend.walk(translation_unit);
+                sse_vector_backend.walk(n);
             }
         }
 
@@ -28,6 +28,7 @@
 #define VECTOR_LOWERING_PHASE_HPP
 
 #include "tl-compilerphase.hpp"
+#include "tl-vectorization-common.hpp"
 
 namespace TL
 {
@@ -37,18 +38,26 @@ namespace TL
         {
             private:
                 bool _knl_enabled;
+                bool _avx512_enabled;
+                unsigned int _avx512_vector_length;
                 bool _knc_enabled;
                 bool _avx2_enabled;
                 bool _neon_enabled;
+                bool _sve_enabled;
+                unsigned int _sve_vector_length;
                 bool _romol_enabled;
                 bool _prefer_gather_scatter;
                 bool _prefer_mask_gather_scatter;
                 bool _valib_sim_header;
 
                 std::string _knl_enabled_str;
+                std::string _avx512_enabled_str;
+                std::string _avx512_vector_length_str;
                 std::string _knc_enabled_str;
                 std::string _avx2_enabled_str;
                 std::string _neon_enabled_str;
+                std::string _sve_enabled_str;
+                std::string _sve_vector_length_str;
                 std::string _romol_enabled_str;
                 std::string _intel_compiler_profile_str;
                 std::string _prefer_gather_scatter_str;
@@ -56,9 +65,13 @@ namespace TL
                 std::string _valib_sim_header_str;
 
                 void set_knl(const std::string& knl_enabled_str);
+                void set_avx512(const std::string& avx512_enabled_str);
+                void set_avx512_vector_length(const std::string& avx512_vector_length_str);
                 void set_knc(const std::string& knc_enabled_str);
                 void set_avx2(const std::string& avx2_enabled_str);
                 void set_neon(const std::string& neon_enabled_str);
+                void set_sve(const std::string& sve_enabled_str);
+                void set_sve_vector_length(const std::string& sve_vector_length_str);
                 void set_romol(const std::string& romol_enabled_str);
                 void set_intel_compiler_profile(
                         const std::string& intel_compiler_profile_str);
@@ -68,6 +81,9 @@ namespace TL
                         const std::string& prefer_mask_gather_scatter_str);
                 void set_valib_sim_header(const std::string& str);
 
+                void lower_vector_code(Nodecl::NodeclBase n,
+                        VectorInstructionSet isa);
+
             public:
                 VectorLoweringPhase();
                 virtual void run(TL::DTO& dto);
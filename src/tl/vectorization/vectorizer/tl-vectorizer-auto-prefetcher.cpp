@@ -0,0 +1,603 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-vectorizer-auto-prefetcher.hpp"
+
+#include "tl-vectorizer.hpp"
+#include "tl-vectorizer-cost-model.hpp"
+#include "tl-vectorization-utils.hpp"
+#include "tl-vectorization-prefetcher-common.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-optimizations.hpp"
+
+#include "cxx-cexpr.h"
+
+#include <cstdlib>
+
+namespace TL
+{
+namespace Vectorization
+{
+    AutoPrefetcher::AutoPrefetcher(const VectorizerEnvironment& environment)
+        : _environment(environment),
+        _costs(environment._vec_isa_desc.get_cost_table()),
+        _max_distance(64), _valid_loop(false), _iv_step(0),
+        _increasing_loop(true), _vec_factor(1), _vectorized(false),
+        _iteration_cost(0), _distance(0)
+    {
+    }
+
+    void AutoPrefetcher::analyze(const Nodecl::NodeclBase& loop_statement,
+            const bool vectorized)
+    {
+        _valid_loop = false;
+        _direct_accesses.clear();
+        _indirect_accesses.clear();
+
+        // The backend does not lower prefetches
+        if (_costs.memory_latency == 0 || _costs.cache_line == 0)
+            return;
+
+        if (!loop_statement.is<Nodecl::ForStatement>())
+            return;
+
+        TL::ForStatementHelper<TL::NoNewNodePolicy> tl_for(
+                loop_statement.as<Nodecl::ForStatement>());
+
+        if (!tl_for.is_omp_valid_loop() || !tl_for.get_step().is_constant())
+            return;
+
+        _loop = loop_statement;
+        _iv = tl_for.get_induction_variable();
+        _iv_step = const_value_cast_to_8(tl_for.get_step().get_constant());
+        _increasing_loop = tl_for.is_strictly_increasing_loop();
+        _closed_ub = tl_for.get_upper_bound().shallow_copy();
+        _vec_factor = _environment._vec_factor;
+        _vectorized = vectorized;
+
+        if (_iv_step == 0)
+            return;
+
+        _valid_loop = true;
+
+        walk(loop_statement.as<Nodecl::ForStatement>().get_statement());
+
+        // Cycles of an iteration of the final loop
+        VectorizerCostModel cost_model(_environment);
+        cost_model.is_profitable(loop_statement);
+
+        _iteration_cost = (_vectorized ? cost_model.get_vector_cost()
+                : cost_model.get_scalar_cost()) + _costs.loop_overhead;
+
+        _distance = (_costs.memory_latency + _iteration_cost - 1)
+            / _iteration_cost;
+
+        if (_distance < 1)
+            _distance = 1;
+        else if (_distance > _max_distance)
+            _distance = _max_distance;
+
+        VECTORIZATION_DEBUG()
+        {
+            std::cerr << "AutoPrefetcher: " << _direct_accesses.size()
+                << " direct and " << _indirect_accesses.size()
+                << " indirect accesses, " << _iteration_cost
+                << " cycles per iteration, distance " << _distance
+                << std::endl;
+        }
+    }
+
+    // The symbols of 'n' (but the IV) must be visible before the body of
+    // the loop and keep their value during the whole loop
+    bool AutoPrefetcher::has_invariant_symbols(const Nodecl::NodeclBase& n,
+            bool& contains_iv)
+    {
+        contains_iv = false;
+
+        if (!Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+                Nodecl::FunctionCall>(n).empty())
+            return false;
+
+        objlist_nodecl_t symbols = Nodecl::Utils::
+            nodecl_get_all_nodecls_of_kind<Nodecl::Symbol>(n);
+
+        for (objlist_nodecl_t::const_iterator it = symbols.begin();
+                it != symbols.end();
+                it++)
+        {
+            TL::Symbol sym = it->get_symbol();
+
+            if (sym == _iv)
+            {
+                contains_iv = true;
+                continue;
+            }
+
+            if (Utils::is_declared_in_inner_scope(_loop, sym))
+                return false;
+
+            if (!Vectorizer::_vectorizer_analysis->is_uniform(
+                        _environment._analysis_simd_scope, *it, *it))
+                return false;
+        }
+
+        return true;
+    }
+
+    // a[i], a[2*i+k]...
+    bool AutoPrefetcher::get_direct_stride(const Nodecl::ArraySubscript& n,
+            long long int& stride)
+    {
+        Nodecl::List subscripts = n.get_subscripts().as<Nodecl::List>();
+
+        if (subscripts.size() != 1)
+            return false;
+
+        Nodecl::NodeclBase subscript = subscripts.front().no_conv();
+        bool contains_iv;
+
+        if (!has_invariant_symbols(n.get_subscripted(), contains_iv)
+                || contains_iv)
+            return false;
+
+        if (!Nodecl::Utils::nodecl_get_all_nodecls_of_kind<
+                Nodecl::ArraySubscript>(subscript).empty())
+            return false;
+
+        if (!has_invariant_symbols(subscript, contains_iv) || !contains_iv)
+            return false;
+
+        if (!Vectorizer::_vectorizer_analysis->is_linear(
+                    _environment._analysis_simd_scope, subscript))
+            return false;
+
+        Nodecl::NodeclBase step = Vectorizer::_vectorizer_analysis->
+            get_linear_step(_environment._analysis_simd_scope, subscript);
+
+        if (step.is_null() || !step.is_constant())
+            return false;
+
+        stride = const_value_cast_to_8(step.get_constant());
+
+        return stride != 0;
+    }
+
+    void AutoPrefetcher::add_direct_access(const Nodecl::ArraySubscript& n,
+            const long long int stride,
+            const unsigned int distance_factor,
+            const bool is_store)
+    {
+        Nodecl::NodeclBase subscripted = n.get_subscripted();
+        Nodecl::NodeclBase subscript =
+            n.get_subscripts().as<Nodecl::List>().front();
+        const unsigned long long int element_size =
+            n.get_type().no_ref().get_size();
+
+        if (element_size == 0)
+            return;
+
+        // Non-temporal stores bypass the cache
+        if (is_store && subscripted.no_conv().is<Nodecl::Symbol>()
+                && _environment._nontemporal_exprs_map.find(
+                    Utils::get_subscripted_symbol(subscripted))
+                != _environment._nontemporal_exprs_map.end())
+            return;
+
+        for (std::vector<PrefetchAccess>::iterator it =
+                _direct_accesses.begin();
+                it != _direct_accesses.end();
+                it++)
+        {
+            Nodecl::ArraySubscript group_access =
+                it->_access.as<Nodecl::ArraySubscript>();
+
+            if (it->_stride != stride
+                    || group_access.get_type().no_ref().get_size()
+                    != element_size
+                    || !Nodecl::Utils::structurally_equal_nodecls(
+                        group_access.get_subscripted(), subscripted,
+                        true /* skip conv */))
+                continue;
+
+            Nodecl::NodeclBase elements = Nodecl::Minus::make(
+                    subscript.shallow_copy(),
+                    group_access.get_subscripts().as<Nodecl::List>().
+                    front().shallow_copy(),
+                    subscript.get_type().no_ref());
+
+            TL::Optimizations::canonicalize_and_fold(elements,
+                    false /*fast math*/);
+
+            if (!elements.is_constant())
+                continue;
+
+            long long int offset = const_value_cast_to_8(
+                    elements.get_constant());
+
+            if ((unsigned long long int) std::llabs(offset) * element_size
+                    >= _costs.cache_line)
+                continue;
+
+            // Both accesses are in the same cache line. Only the one
+            // that goes ahead is prefetched
+            if ((stride > 0 && offset > 0) || (stride < 0 && offset < 0))
+                it->_access = n.shallow_copy();
+
+            it->_is_store = it->_is_store || is_store;
+            if (distance_factor > it->_distance_factor)
+                it->_distance_factor = distance_factor;
+
+            return;
+        }
+
+        PrefetchAccess access;
+        access._access = n.shallow_copy();
+        access._stride = stride;
+        access._distance_factor = distance_factor;
+        access._is_store = is_store;
+
+        _direct_accesses.push_back(access);
+    }
+
+    void AutoPrefetcher::add_access(const Nodecl::ArraySubscript& n,
+            const bool is_store)
+    {
+        long long int stride;
+
+        if (get_direct_stride(n, stride))
+        {
+            add_direct_access(n, stride, 1, is_store);
+            return;
+        }
+
+        // a[f(idx[i])]
+        Nodecl::List subscripts = n.get_subscripts().as<Nodecl::List>();
+
+        if (subscripts.size() != 1 || n.get_type().no_ref().get_size() == 0)
+            return;
+
+        Nodecl::NodeclBase subscript = subscripts.front().no_conv();
+        objlist_nodecl_t indexes = Nodecl::Utils::
+            nodecl_get_all_nodecls_of_kind<Nodecl::ArraySubscript>(subscript);
+
+        if (indexes.size() != 1)
+            return;
+
+        Nodecl::ArraySubscript index =
+            indexes.front().as<Nodecl::ArraySubscript>();
+        long long int index_stride;
+        bool contains_iv;
+
+        if (!get_direct_stride(index, index_stride)
+                || !has_invariant_symbols(n.get_subscripted(), contains_iv)
+                || contains_iv
+                || !has_invariant_symbols(subscript, contains_iv))
+            return;
+
+        // The index has to be in the cache before it is used to compute
+        // the prefetched address
+        add_direct_access(index, index_stride, 2, false /* is store */);
+
+        for (std::vector<PrefetchAccess>::iterator it =
+                _indirect_accesses.begin();
+                it != _indirect_accesses.end();
+                it++)
+        {
+            if (Nodecl::Utils::structurally_equal_nodecls(
+                        it->_access, n, true /* skip conv */))
+            {
+                it->_is_store = it->_is_store || is_store;
+                return;
+            }
+        }
+
+        PrefetchAccess access;
+        access._access = n.shallow_copy();
+        access._stride = 0;
+        access._distance_factor = 1;
+        access._is_store = is_store;
+
+        _indirect_accesses.push_back(access);
+    }
+
+    void AutoPrefetcher::add_lhs_access(const Nodecl::NodeclBase& lhs)
+    {
+        Nodecl::NodeclBase lhs_no_conv = lhs.no_conv();
+
+        if (lhs_no_conv.is<Nodecl::ArraySubscript>())
+        {
+            Nodecl::ArraySubscript array =
+                lhs_no_conv.as<Nodecl::ArraySubscript>();
+
+            add_access(array, true /* is store */);
+            walk(array.get_subscripts());
+        }
+        else
+        {
+            walk(lhs);
+        }
+    }
+
+    Nodecl::NodeclBase AutoPrefetcher::get_iv_nodecl()
+    {
+        return _iv.make_nodecl(true /* ref type */, _loop.get_locus());
+    }
+
+    // iv + offset
+    Nodecl::NodeclBase AutoPrefetcher::get_shifted_iv(
+            const long long int offset)
+    {
+        TL::Type iv_type = _iv.get_type().no_ref();
+
+        return Nodecl::Add::make(get_iv_nodecl(),
+                const_value_to_nodecl(const_value_get_signed_int(offset)),
+                iv_type);
+    }
+
+    // Indexes of indirect accesses are read from memory, so the IV cannot
+    // go beyond the last iteration: (iv + offset <= ub) ? iv + offset : iv
+    Nodecl::NodeclBase AutoPrefetcher::get_clamped_iv(
+            const long long int offset)
+    {
+        TL::Type iv_type = _iv.get_type().no_ref();
+        Nodecl::NodeclBase condition;
+
+        if (_increasing_loop)
+            condition = Nodecl::LowerOrEqualThan::make(get_shifted_iv(offset),
+                    _closed_ub.shallow_copy(),
+                    TL::Type::get_bool_type());
+        else
+            condition = Nodecl::GreaterOrEqualThan::make(
+                    get_shifted_iv(offset),
+                    _closed_ub.shallow_copy(),
+                    TL::Type::get_bool_type());
+
+        return Nodecl::ConditionalExpression::make(condition,
+                get_shifted_iv(offset),
+                get_iv_nodecl(),
+                iv_type);
+    }
+
+    Nodecl::NodeclBase AutoPrefetcher::get_prefetch(
+            const Nodecl::NodeclBase& access,
+            const Nodecl::NodeclBase& new_iv,
+            const long long int element_offset,
+            const bool is_store)
+    {
+        Nodecl::NodeclBase prefetched_access = access.shallow_copy();
+
+        Nodecl::Utils::nodecl_replace_nodecl_by_structure(
+                prefetched_access, get_iv_nodecl(), new_iv);
+
+        TL::Type pointer_type = access.get_type().no_ref().get_pointer_to();
+        Nodecl::NodeclBase address = Nodecl::Reference::make(
+                prefetched_access, pointer_type);
+
+        if (element_offset != 0)
+            address = Nodecl::Add::make(address,
+                    const_value_to_nodecl(
+                        const_value_get_signed_int(element_offset)),
+                    pointer_type);
+
+        VECTORIZATION_DEBUG()
+        {
+            std::cerr << "AutoPrefetcher: prefetching "
+                << address.prettyprint()
+                << (is_store ? " as WRITE" : " as READ") << std::endl;
+        }
+
+        return Nodecl::ExpressionStatement::make(
+                Nodecl::VectorPrefetch::make(
+                    address,
+                    const_value_to_nodecl(const_value_get_signed_int(
+                            is_store ? L1_WRITE : L1_READ)),
+                    pointer_type));
+    }
+
+    void AutoPrefetcher::insert(const Nodecl::NodeclBase& loop_statement)
+    {
+        if (!_valid_loop
+                || (_direct_accesses.empty() && _indirect_accesses.empty()))
+            return;
+
+        ERROR_CONDITION(!loop_statement.is<Nodecl::ForStatement>(),
+                "AutoPrefetcher: %s is not a ForStatement",
+                ast_print_node_type(loop_statement.get_kind()));
+
+        const unsigned int lanes = _vectorized ? _vec_factor : 1;
+        // IV increment in an iteration of the final loop
+        const long long int loop_step = _iv_step * lanes;
+        const unsigned long long int cache_line = _costs.cache_line;
+
+        Nodecl::List prefetch_code;
+        // Prefetches issued once every N iterations
+        std::map<unsigned int, Nodecl::List> periodic_prefetches;
+
+        for (std::vector<PrefetchAccess>::const_iterator it =
+                _direct_accesses.begin();
+                it != _direct_accesses.end();
+                it++)
+        {
+            const unsigned long long int element_size =
+                it->_access.get_type().no_ref().get_size();
+            // Bytes between the elements of two consecutive scalar
+            // iterations
+            const unsigned long long int iteration_bytes =
+                std::llabs(it->_stride) * element_size;
+            const long long int offset =
+                _distance * it->_distance_factor * loop_step;
+
+            // Each element in a different cache line
+            if (iteration_bytes >= cache_line)
+            {
+                for (unsigned int i = 0; i < lanes; i++)
+                    prefetch_code.append(get_prefetch(it->_access,
+                                get_shifted_iv(offset + i * _iv_step),
+                                0, it->_is_store));
+            }
+            // One or more cache lines per iteration
+            else if (iteration_bytes * lanes >= cache_line)
+            {
+                const unsigned int lines =
+                    (iteration_bytes * lanes) / cache_line;
+                const long long int line_elements =
+                    (it->_stride > 0 ? 1 : -1)
+                    * (long long int) (cache_line / element_size);
+
+                for (unsigned int i = 0; i < lines; i++)
+                    prefetch_code.append(get_prefetch(it->_access,
+                                get_shifted_iv(offset),
+                                i * line_elements, it->_is_store));
+            }
+            // Several iterations in the same cache line
+            else
+            {
+                unsigned int period = 1;
+                while (period * 2 * iteration_bytes * lanes <= cache_line)
+                    period *= 2;
+
+                periodic_prefetches[period].append(get_prefetch(
+                            it->_access, get_shifted_iv(offset),
+                            0, it->_is_store));
+            }
+        }
+
+        for (std::vector<PrefetchAccess>::const_iterator it =
+                _indirect_accesses.begin();
+                it != _indirect_accesses.end();
+                it++)
+        {
+            const long long int offset = _distance * loop_step;
+
+            // Each lane may access a different cache line
+            for (unsigned int i = 0; i < lanes; i++)
+                prefetch_code.append(get_prefetch(it->_access,
+                            get_clamped_iv(offset + i * _iv_step),
+                            0, it->_is_store));
+        }
+
+        // if (((iv / loop_step) & (period - 1)) == 0)
+        TL::Type iv_type = _iv.get_type().no_ref();
+
+        for (std::map<unsigned int, Nodecl::List>::const_iterator it =
+                periodic_prefetches.begin();
+                it != periodic_prefetches.end();
+                it++)
+        {
+            Nodecl::NodeclBase iteration = get_iv_nodecl();
+
+            if (std::llabs(loop_step) != 1)
+                iteration = Nodecl::Div::make(iteration,
+                        const_value_to_nodecl(const_value_get_signed_int(
+                                std::llabs(loop_step))),
+                        iv_type);
+
+            Nodecl::NodeclBase condition = Nodecl::Equal::make(
+                    Nodecl::BitwiseAnd::make(iteration,
+                        const_value_to_nodecl(const_value_get_signed_int(
+                                it->first - 1)),
+                        iv_type),
+                    const_value_to_nodecl(const_value_get_signed_int(0)),
+                    TL::Type::get_bool_type());
+
+            prefetch_code.append(Nodecl::IfElseStatement::make(
+                        condition,
+                        Nodecl::List::make(Nodecl::CompoundStatement::make(
+                                it->second, Nodecl::NodeclBase::null())),
+                        Nodecl::NodeclBase::null()));
+        }
+
+        Nodecl::Utils::prepend_items_in_nested_compound_statement(
+                loop_statement, prefetch_code);
+
+        // Avoid the prefetches of the native compiler
+        loop_statement.prepend_sibling(
+                Nodecl::UnknownPragma::make("noprefetch"));
+
+        info_printf_at(loop_statement.get_locus(),
+                "SIMD: %d memory stream(s) prefetched %d iteration(s) "
+                "ahead (%llu cycles per iteration)\n",
+                (int) (_direct_accesses.size() + _indirect_accesses.size()),
+                _distance,
+                _iteration_cost);
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::ObjectInit& n)
+    {
+        TL::Symbol sym = n.get_symbol();
+        Nodecl::NodeclBase init = sym.get_value();
+
+        if (!init.is_null())
+            walk(init);
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::ForStatement& n)
+    {
+        // Accesses of inner loops are not prefetched
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::WhileStatement& n)
+    {
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::ArraySubscript& n)
+    {
+        add_access(n, false /* is store */);
+        walk(n.get_subscripts());
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::Assignment& n)
+    {
+        add_lhs_access(n.get_lhs());
+        walk(n.get_rhs());
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::AddAssignment& n)
+    {
+        add_lhs_access(n.get_lhs());
+        walk(n.get_rhs());
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::MinusAssignment& n)
+    {
+        add_lhs_access(n.get_lhs());
+        walk(n.get_rhs());
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::MulAssignment& n)
+    {
+        add_lhs_access(n.get_lhs());
+        walk(n.get_rhs());
+    }
+
+    void AutoPrefetcher::visit(const Nodecl::DivAssignment& n)
+    {
+        add_lhs_access(n.get_lhs());
+        walk(n.get_rhs());
+    }
+}
+}
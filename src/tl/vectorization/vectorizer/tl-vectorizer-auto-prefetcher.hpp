@@ -0,0 +1,127 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#ifndef TL_VECTORIZER_AUTO_PREFETCHER_HPP
+#define TL_VECTORIZER_AUTO_PREFETCHER_HPP
+
+#include "tl-nodecl-visitor.hpp"
+#include "tl-vectorizer-environment.hpp"
+
+#include <map>
+#include <vector>
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    // Software prefetching without user-provided distances. The accesses
+    // of the scalar loop are classified by their stride (a[i], a[2*i+k])
+    // or as indirect (a[idx[i]]) and the prefetch distance (in iterations
+    // of the final loop) is the memory latency of the ISA divided by the
+    // cost of an iteration estimated by the cost model
+    class AutoPrefetcher : public Nodecl::ExhaustiveVisitor<void>
+    {
+        private:
+            struct PrefetchAccess
+            {
+                // Leading scalar access of the group
+                Nodecl::NodeclBase _access;
+                // Elements per scalar iteration (0 for indirect accesses)
+                long long int _stride;
+                // Indexes of indirect accesses are prefetched further
+                unsigned int _distance_factor;
+                bool _is_store;
+            };
+
+            const VectorizerEnvironment& _environment;
+            const VectorCostTable& _costs;
+
+            const unsigned int _max_distance;
+
+            bool _valid_loop;
+            Nodecl::NodeclBase _loop;
+            TL::Symbol _iv;
+            long long int _iv_step;
+            bool _increasing_loop;
+            Nodecl::NodeclBase _closed_ub;
+            unsigned int _vec_factor;
+            bool _vectorized;
+            unsigned long long int _iteration_cost;
+            unsigned int _distance;
+
+            std::vector<PrefetchAccess> _direct_accesses;
+            std::vector<PrefetchAccess> _indirect_accesses;
+
+            bool has_invariant_symbols(const Nodecl::NodeclBase& n,
+                    bool& contains_iv);
+            bool get_direct_stride(const Nodecl::ArraySubscript& n,
+                    long long int& stride);
+            void add_direct_access(const Nodecl::ArraySubscript& n,
+                    const long long int stride,
+                    const unsigned int distance_factor,
+                    const bool is_store);
+            void add_access(const Nodecl::ArraySubscript& n,
+                    const bool is_store);
+            void add_lhs_access(const Nodecl::NodeclBase& lhs);
+
+            Nodecl::NodeclBase get_iv_nodecl();
+            Nodecl::NodeclBase get_shifted_iv(const long long int offset);
+            Nodecl::NodeclBase get_clamped_iv(const long long int offset);
+            Nodecl::NodeclBase get_prefetch(
+                    const Nodecl::NodeclBase& access,
+                    const Nodecl::NodeclBase& new_iv,
+                    const long long int element_offset,
+                    const bool is_store);
+
+        public:
+            AutoPrefetcher(const VectorizerEnvironment& environment);
+
+            // Collects the accesses of the scalar loop and computes the
+            // prefetch distance for its vectorized (or scalar) version.
+            // The environment must be loaded with 'loop_statement'
+            void analyze(const Nodecl::NodeclBase& loop_statement,
+                    const bool vectorized);
+
+            // Inserts the prefetches at the beginning of the final loop
+            void insert(const Nodecl::NodeclBase& loop_statement);
+
+            virtual void visit(const Nodecl::ObjectInit& n);
+            virtual void visit(const Nodecl::ForStatement& n);
+            virtual void visit(const Nodecl::WhileStatement& n);
+            virtual void visit(const Nodecl::ArraySubscript& n);
+
+            virtual void visit(const Nodecl::Assignment& n);
+            virtual void visit(const Nodecl::AddAssignment& n);
+            virtual void visit(const Nodecl::MinusAssignment& n);
+            virtual void visit(const Nodecl::MulAssignment& n);
+            virtual void visit(const Nodecl::DivAssignment& n);
+    };
+}
+}
+
+#endif //TL_VECTORIZER_AUTO_PREFETCHER_HPP
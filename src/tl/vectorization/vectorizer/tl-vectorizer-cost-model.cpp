@@ -0,0 +1,641 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#include "tl-vectorizer-cost-model.hpp"
+
+#include "tl-vectorizer.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-optimizations.hpp"
+
+#include "cxx-cexpr.h"
+
+namespace TL
+{
+namespace Vectorization
+{
+namespace
+{
+    bool is_arithmetic_type(const TL::Type& t)
+    {
+        return t.is_integral_type() || t.is_floating_type();
+    }
+}
+
+    VectorizerCostModel::VectorizerCostModel(
+            const VectorizerEnvironment& environment)
+        : _environment(environment),
+        _costs(environment._vec_isa_desc.get_cost_table()),
+        _function_call_cost(20), _default_trip_count(128),
+        _weight(1), _masked_level(0),
+        _scalar_cost(0), _vector_cost(0),
+        _trip_count(0), _trip_count_known(false), _trip_count_bounded(false),
+        _total_scalar_cost(0), _total_vector_cost(0),
+        _vloads(0), _vstores(0), _unaligned_accesses(0),
+        _gathers(0), _scatters(0), _promotions(0), _masked_ops(0)
+    {
+    }
+
+    bool VectorizerCostModel::is_profitable(
+            const Nodecl::NodeclBase& loop_statement)
+    {
+        const unsigned int vec_factor = _environment._vec_factor;
+
+        if (loop_statement.is<Nodecl::ForStatement>())
+            walk(loop_statement.as<Nodecl::ForStatement>().get_statement());
+        else if (loop_statement.is<Nodecl::WhileStatement>())
+            walk(loop_statement.as<Nodecl::WhileStatement>().get_statement());
+        else if (loop_statement.is<Nodecl::DoStatement>())
+            walk(loop_statement.as<Nodecl::DoStatement>().get_statement());
+        else
+            fatal_error("VectorizerCostModel: Neither a for, a while nor a do");
+
+        _trip_count = estimate_trip_count(loop_statement,
+                _trip_count_known, _trip_count_bounded);
+
+        const unsigned long long int scalar_iteration =
+            _scalar_cost + _costs.loop_overhead;
+        const unsigned long long int vector_iteration =
+            _vector_cost + _costs.loop_overhead;
+
+        unsigned long long int vector_iterations = _trip_count / vec_factor;
+        unsigned long long int epilog_iterations = _trip_count % vec_factor;
+
+        // Unknown trip count: on average, half a vector of remaining
+        // iterations. A bound shorter than a vector is the whole epilog
+        if (!_trip_count_known && _trip_count >= vec_factor)
+            epilog_iterations = vec_factor / 2;
+
+        _total_scalar_cost = _trip_count * scalar_iteration;
+        _total_vector_cost = vector_iterations * vector_iteration;
+
+        // Masked epilogs run a single vector iteration
+        if (epilog_iterations > 0)
+        {
+            if (_environment._vec_isa_desc.support_masking())
+                _total_vector_cost += vector_iteration;
+            else
+                _total_vector_cost += epilog_iterations * scalar_iteration;
+
+            _total_vector_cost += _costs.epilog_setup;
+        }
+
+        // Horizontal reductions after the loop
+        if (_environment._reduction_list != NULL)
+        {
+            unsigned int reduction_steps = 0;
+            for (unsigned int i = vec_factor; i > 1; i /= 2)
+                reduction_steps++;
+
+            _total_vector_cost += _environment._reduction_list->size() *
+                reduction_steps * (_costs.shuffle + _costs.vector_op);
+        }
+
+        return _total_vector_cost < _total_scalar_cost;
+    }
+
+    bool VectorizerCostModel::get_constant_trip_count(
+            const Nodecl::NodeclBase& loop, long long int& trip_count)
+    {
+        if (loop.is<Nodecl::ForStatement>())
+        {
+            TL::ForStatementHelper<TL::NoNewNodePolicy> tl_for(
+                    loop.as<Nodecl::ForStatement>());
+
+            if (tl_for.is_omp_valid_loop() &&
+                    tl_for.get_step().is_constant())
+            {
+                Nodecl::NodeclBase lb = tl_for.get_lower_bound();
+                Nodecl::NodeclBase closed_ub = tl_for.get_upper_bound();
+                long long int step = const_value_cast_to_8(
+                        tl_for.get_step().get_constant());
+
+                // The distance between the bounds of the IV may be constant
+                // even if the bounds are not (i.e., for (i=k; i<k+16; i++))
+                Nodecl::NodeclBase distance = Nodecl::Minus::make(
+                        closed_ub.shallow_copy(),
+                        lb.shallow_copy(),
+                        closed_ub.get_type());
+
+                TL::Optimizations::canonicalize_and_fold(distance,
+                        false /*fast math*/);
+
+                if (step != 0 && distance.is_constant())
+                {
+                    long long int its = const_value_cast_to_8(
+                            distance.get_constant()) / step + 1;
+
+                    trip_count = (its > 0) ? its : 0;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    long long int VectorizerCostModel::estimate_trip_count(
+            const Nodecl::NodeclBase& loop, bool& known, bool& bounded)
+    {
+        long long int trip_count;
+        known = get_constant_trip_count(loop, trip_count);
+        bounded = false;
+
+        if (known)
+            return trip_count;
+
+        // Range analysis may bound the IV although the bounds of the loop
+        // do not fold (i.e., for (i=0; i<n; i++) after if (n > 8) n = 8;)
+        if (Vectorizer::_vectorizer_analysis != NULL)
+            bounded = Vectorizer::_vectorizer_analysis->get_range_trip_count(
+                    loop, trip_count);
+
+        return bounded ? trip_count : _default_trip_count;
+    }
+
+    unsigned int VectorizerCostModel::get_isa_instructions(
+            const TL::Type& type)
+    {
+        TL::Type scalar_type = type.no_ref();
+
+        if (!is_arithmetic_type(scalar_type))
+            return 1;
+
+        // i.e., doubles with a vec_factor computed for floats need
+        // two ISA instructions
+        unsigned int isa_vec_factor = _environment._vec_isa_desc.
+            get_vec_factor_from_type(scalar_type);
+
+        if (isa_vec_factor == 0 || isa_vec_factor >= _environment._vec_factor)
+            return 1;
+
+        return (_environment._vec_factor + isa_vec_factor - 1) / isa_vec_factor;
+    }
+
+    void VectorizerCostModel::add_cost(
+            const unsigned long long int scalar_cost,
+            const unsigned long long int vector_cost)
+    {
+        _scalar_cost += _weight * scalar_cost;
+        _vector_cost += _weight * vector_cost;
+    }
+
+    void VectorizerCostModel::operation(const Nodecl::NodeclBase& n,
+            const bool is_div)
+    {
+        unsigned int isa_instructions = get_isa_instructions(n.get_type());
+
+        unsigned long long int vector_cost = isa_instructions *
+            (is_div ? _costs.vector_div : _costs.vector_op);
+
+        if (_masked_level > 0)
+        {
+            vector_cost += isa_instructions * _costs.masked_op;
+            _masked_ops++;
+        }
+
+        add_cost(is_div ? _costs.scalar_div : _costs.scalar_op, vector_cost);
+
+        Nodecl::NodeclBase::Children children = n.children();
+        for (Nodecl::NodeclBase::Children::iterator it = children.begin();
+                it != children.end();
+                it++)
+        {
+            walk(*it);
+        }
+    }
+
+    void VectorizerCostModel::memory_access(const Nodecl::NodeclBase& n,
+            const bool is_store)
+    {
+        const unsigned int vec_factor = _environment._vec_factor;
+        unsigned int isa_instructions = get_isa_instructions(n.get_type());
+
+        const unsigned long long int scalar_cost =
+            is_store ? _costs.scalar_store : _costs.scalar_load;
+
+        // Vector promotion (stores to uniform addresses are not vectorized)
+        if (!is_store && Vectorizer::_vectorizer_analysis->is_uniform(
+                    _environment._analysis_simd_scope, n, n))
+        {
+            _promotions++;
+            add_cost(scalar_cost, _costs.scalar_load + _costs.shuffle);
+        }
+        // Vector load/store
+        else if (Vectorizer::_vectorizer_analysis->is_adjacent_access(
+                    _environment._analysis_simd_scope, n))
+        {
+            unsigned long long int vector_cost = isa_instructions *
+                (is_store ? _costs.vector_store : _costs.vector_load);
+
+            int alignment_output;
+            if (!Vectorizer::_vectorizer_analysis->is_simd_aligned_access(
+                        _environment._analysis_simd_scope,
+                        n,
+                        _environment._aligned_symbols_map,
+                        _environment._suitable_exprs_list,
+                        _environment._vec_factor,
+                        _environment._vec_isa_desc.get_memory_alignment_in_bytes(),
+                        alignment_output))
+            {
+                _unaligned_accesses++;
+                vector_cost += isa_instructions * _costs.unaligned_penalty;
+            }
+
+            if (is_store)
+            {
+                _vstores++;
+
+                if (_masked_level > 0)
+                {
+                    _masked_ops++;
+                    vector_cost += isa_instructions * _costs.masked_op;
+                }
+            }
+            else
+            {
+                _vloads++;
+            }
+
+            add_cost(scalar_cost, vector_cost);
+        }
+        // Gather/scatter
+        else
+        {
+            if (is_store)
+            {
+                _scatters++;
+                add_cost(scalar_cost, vec_factor * _costs.scatter_element);
+            }
+            else
+            {
+                _gathers++;
+                add_cost(scalar_cost, vec_factor * _costs.gather_element);
+            }
+
+            // Indexes are computed in vector registers
+            walk(n.as<Nodecl::ArraySubscript>().get_subscripts());
+        }
+    }
+
+    void VectorizerCostModel::compound_assignment(
+            const Nodecl::NodeclBase& n, const bool is_div)
+    {
+        Nodecl::NodeclBase lhs = n.children()[0].no_conv();
+        Nodecl::NodeclBase rhs = n.children()[1];
+
+        if (lhs.is<Nodecl::ArraySubscript>())
+        {
+            memory_access(lhs, false /*load*/);
+            memory_access(lhs, true /*store*/);
+        }
+
+        unsigned int isa_instructions = get_isa_instructions(n.get_type());
+        add_cost(is_div ? _costs.scalar_div : _costs.scalar_op,
+                isa_instructions *
+                (is_div ? _costs.vector_div : _costs.vector_op));
+
+        walk(rhs);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::ObjectInit& n)
+    {
+        Nodecl::NodeclBase init = n.get_symbol().get_value();
+
+        if (!init.is_null())
+            walk(init);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::ForStatement& n)
+    {
+        bool known, bounded;
+        long long int its = estimate_trip_count(n, known, bounded);
+
+        unsigned long long int old_weight = _weight;
+        _weight *= (its > 0) ? its : 1;
+
+        walk(n.get_statement());
+
+        _weight = old_weight;
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::WhileStatement& n)
+    {
+        unsigned long long int old_weight = _weight;
+        _weight *= _default_trip_count;
+
+        walk(n.get_condition());
+        walk(n.get_statement());
+
+        _weight = old_weight;
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::IfElseStatement& n)
+    {
+        walk(n.get_condition());
+
+        // The scalar code executes one of the branches (plus the branch
+        // itself) while the vector code executes both under a mask
+        unsigned long long int scalar_cost_before = _scalar_cost;
+
+        _masked_level++;
+        walk(n.get_then());
+        walk(n.get_else());
+        _masked_level--;
+
+        _scalar_cost = scalar_cost_before +
+            (_scalar_cost - scalar_cost_before) / 2;
+
+        unsigned long long int mask_ops = n.get_else().is_null() ? 0 : 1;
+        add_cost(_costs.scalar_op, mask_ops * _costs.vector_op);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::ConditionalExpression& n)
+    {
+        // Blend of both values
+        unsigned int isa_instructions = get_isa_instructions(n.get_type());
+        add_cost(_costs.scalar_op,
+                isa_instructions * (_costs.vector_op + _costs.masked_op));
+
+        walk(n.get_condition());
+        walk(n.get_true());
+        walk(n.get_false());
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::FunctionCall& n)
+    {
+        // Assume a vector version of the function exists (SVML or
+        // declare simd)
+        unsigned int isa_instructions = get_isa_instructions(n.get_type());
+        add_cost(_function_call_cost, isa_instructions * _function_call_cost);
+
+        walk(n.get_arguments());
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Assignment& n)
+    {
+        Nodecl::NodeclBase lhs = n.get_lhs().no_conv();
+
+        if (lhs.is<Nodecl::ArraySubscript>())
+        {
+            memory_access(lhs, true /*store*/);
+        }
+        else if (_masked_level > 0 &&
+                !_environment._vec_isa_desc.support_masking())
+        {
+            // Blend with the previous value
+            _masked_ops++;
+            add_cost(0, get_isa_instructions(n.get_type()) *
+                    _costs.masked_op);
+        }
+
+        walk(n.get_rhs());
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::AddAssignment& n)
+    {
+        compound_assignment(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::MinusAssignment& n)
+    {
+        compound_assignment(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::MulAssignment& n)
+    {
+        compound_assignment(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::DivAssignment& n)
+    {
+        compound_assignment(n, true);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::ArraySubscript& n)
+    {
+        memory_access(n, false /*load*/);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Add& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Minus& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Mul& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Div& n)
+    {
+        operation(n, true);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Mod& n)
+    {
+        operation(n, true);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Neg& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::BitwiseAnd& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::BitwiseOr& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::BitwiseXor& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::BitwiseNot& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::BitwiseShl& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::BitwiseShr& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::ArithmeticShr& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::LogicalAnd& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::LogicalOr& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::LogicalNot& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::LowerThan& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::LowerOrEqualThan& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::GreaterThan& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::GreaterOrEqualThan& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Equal& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Different& n)
+    {
+        operation(n, false);
+    }
+
+    void VectorizerCostModel::visit(const Nodecl::Conversion& n)
+    {
+        TL::Type dst_type = n.get_type().no_ref();
+        TL::Type src_type = n.get_nest().get_type().no_ref();
+
+        // Only conversions between arithmetic types of different
+        // size/kind generate code
+        if (is_arithmetic_type(dst_type) && is_arithmetic_type(src_type) &&
+                (dst_type.is_floating_type() != src_type.is_floating_type() ||
+                 dst_type.get_size() != src_type.get_size()))
+        {
+            operation(n, false);
+        }
+        else
+        {
+            walk(n.get_nest());
+        }
+    }
+
+    long long int VectorizerCostModel::get_trip_count() const
+    {
+        return _trip_count;
+    }
+
+    bool VectorizerCostModel::is_trip_count_known() const
+    {
+        return _trip_count_known;
+    }
+
+    bool VectorizerCostModel::is_trip_count_bounded() const
+    {
+        return _trip_count_bounded;
+    }
+
+    unsigned long long int VectorizerCostModel::get_scalar_cost() const
+    {
+        return _scalar_cost;
+    }
+
+    unsigned long long int VectorizerCostModel::get_vector_cost() const
+    {
+        return _vector_cost;
+    }
+
+    unsigned long long int VectorizerCostModel::get_total_scalar_cost() const
+    {
+        return _total_scalar_cost;
+    }
+
+    unsigned long long int VectorizerCostModel::get_total_vector_cost() const
+    {
+        return _total_vector_cost;
+    }
+
+    unsigned int VectorizerCostModel::get_vloads() const
+    {
+        return _vloads;
+    }
+
+    unsigned int VectorizerCostModel::get_vstores() const
+    {
+        return _vstores;
+    }
+
+    unsigned int VectorizerCostModel::get_unaligned_accesses() const
+    {
+        return _unaligned_accesses;
+    }
+
+    unsigned int VectorizerCostModel::get_gathers() const
+    {
+        return _gathers;
+    }
+
+    unsigned int VectorizerCostModel::get_scatters() const
+    {
+        return _scatters;
+    }
+
+    unsigned int VectorizerCostModel::get_promotions() const
+    {
+        return _promotions;
+    }
+
+    unsigned int VectorizerCostModel::get_masked_ops() const
+    {
+        return _masked_ops;
+    }
+}
+}
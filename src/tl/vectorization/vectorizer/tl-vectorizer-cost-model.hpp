@@ -0,0 +1,154 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#ifndef TL_VECTORIZER_COST_MODEL_HPP
+#define TL_VECTORIZER_COST_MODEL_HPP
+
+#include "tl-nodecl-visitor.hpp"
+#include "tl-vectorizer-environment.hpp"
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    // Estimates the cost of a loop before its vectorization using the
+    // cost table of the target ISA. Scalar costs are per scalar iteration
+    // and vector costs are per vector iteration (vec_factor scalar
+    // iterations)
+    class VectorizerCostModel : public Nodecl::ExhaustiveVisitor<void>
+    {
+        private:
+            const VectorizerEnvironment& _environment;
+            const VectorCostTable& _costs;
+
+            const unsigned int _function_call_cost;
+            const long long int _default_trip_count;
+
+            // Iterations of the inner loops enclosing the current node
+            unsigned long long int _weight;
+            unsigned int _masked_level;
+
+            unsigned long long int _scalar_cost;
+            unsigned long long int _vector_cost;
+
+            long long int _trip_count;
+            bool _trip_count_known;
+            bool _trip_count_bounded;
+            unsigned long long int _total_scalar_cost;
+            unsigned long long int _total_vector_cost;
+
+            unsigned int _vloads;
+            unsigned int _vstores;
+            unsigned int _unaligned_accesses;
+            unsigned int _gathers;
+            unsigned int _scatters;
+            unsigned int _promotions;
+            unsigned int _masked_ops;
+
+            unsigned int get_isa_instructions(const TL::Type& type);
+            long long int estimate_trip_count(const Nodecl::NodeclBase& loop,
+                    bool& known, bool& bounded);
+
+            void add_cost(const unsigned long long int scalar_cost,
+                    const unsigned long long int vector_cost);
+            void operation(const Nodecl::NodeclBase& n, const bool is_div);
+            void memory_access(const Nodecl::NodeclBase& n,
+                    const bool is_store);
+            void compound_assignment(const Nodecl::NodeclBase& n,
+                    const bool is_div);
+
+        public:
+            VectorizerCostModel(const VectorizerEnvironment& environment);
+
+            // Returns true if the vector version of the loop is expected
+            // to be faster than the scalar one
+            bool is_profitable(const Nodecl::NodeclBase& loop_statement);
+
+            // Returns true if the trip count of 'loop' is a compile-time
+            // constant
+            static bool get_constant_trip_count(
+                    const Nodecl::NodeclBase& loop,
+                    long long int& trip_count);
+
+            long long int get_trip_count() const;
+            bool is_trip_count_known() const;
+            bool is_trip_count_bounded() const;
+            unsigned long long int get_scalar_cost() const;
+            unsigned long long int get_vector_cost() const;
+            unsigned long long int get_total_scalar_cost() const;
+            unsigned long long int get_total_vector_cost() const;
+
+            unsigned int get_vloads() const;
+            unsigned int get_vstores() const;
+            unsigned int get_unaligned_accesses() const;
+            unsigned int get_gathers() const;
+            unsigned int get_scatters() const;
+            unsigned int get_promotions() const;
+            unsigned int get_masked_ops() const;
+
+            virtual void visit(const Nodecl::ObjectInit& n);
+            virtual void visit(const Nodecl::ForStatement& n);
+            virtual void visit(const Nodecl::WhileStatement& n);
+            virtual void visit(const Nodecl::IfElseStatement& n);
+            virtual void visit(const Nodecl::ConditionalExpression& n);
+            virtual void visit(const Nodecl::FunctionCall& n);
+
+            virtual void visit(const Nodecl::Assignment& n);
+            virtual void visit(const Nodecl::AddAssignment& n);
+            virtual void visit(const Nodecl::MinusAssignment& n);
+            virtual void visit(const Nodecl::MulAssignment& n);
+            virtual void visit(const Nodecl::DivAssignment& n);
+            virtual void visit(const Nodecl::ArraySubscript& n);
+
+            virtual void visit(const Nodecl::Add& n);
+            virtual void visit(const Nodecl::Minus& n);
+            virtual void visit(const Nodecl::Mul& n);
+            virtual void visit(const Nodecl::Div& n);
+            virtual void visit(const Nodecl::Mod& n);
+            virtual void visit(const Nodecl::Neg& n);
+            virtual void visit(const Nodecl::BitwiseAnd& n);
+            virtual void visit(const Nodecl::BitwiseOr& n);
+            virtual void visit(const Nodecl::BitwiseXor& n);
+            virtual void visit(const Nodecl::BitwiseNot& n);
+            virtual void visit(const Nodecl::BitwiseShl& n);
+            virtual void visit(const Nodecl::BitwiseShr& n);
+            virtual void visit(const Nodecl::ArithmeticShr& n);
+            virtual void visit(const Nodecl::LogicalAnd& n);
+            virtual void visit(const Nodecl::LogicalOr& n);
+            virtual void visit(const Nodecl::LogicalNot& n);
+            virtual void visit(const Nodecl::LowerThan& n);
+            virtual void visit(const Nodecl::LowerOrEqualThan& n);
+            virtual void visit(const Nodecl::GreaterThan& n);
+            virtual void visit(const Nodecl::GreaterOrEqualThan& n);
+            virtual void visit(const Nodecl::Equal& n);
+            virtual void visit(const Nodecl::Different& n);
+            virtual void visit(const Nodecl::Conversion& n);
+    };
+}
+}
+
+#endif //TL_VECTORIZER_COST_MODEL_HPP
@@ -56,7 +56,8 @@ VectorizerEnvironment::VectorizerEnvironment(
       _nontemporal_exprs_map(nontemporal_exprs_list),
       _overlap_symbols_map(overlap_symbols_map),
       _reduction_list(reduction_list),
-      _new_external_vector_symbol_map(new_external_vector_symbol_map)
+      _new_external_vector_symbol_map(new_external_vector_symbol_map),
+      _speculative_loads(false)
 {
     _inside_inner_masked_bb.push_back(false);
     _mask_check_bb_cost.push_back(0);
@@ -36,6 +36,19 @@ namespace TL
 {
 namespace Vectorization
 {
+    // Strided access served by the contiguous registers of its group.
+    // Loads read the wide registers of the group, stores write the
+    // field register selected by _field
+    struct InterleavedAccess
+    {
+        objlist_tlsym_t _registers;
+        unsigned int _stride;
+        unsigned int _field;
+        bool _is_store;
+    };
+
+    typedef std::map<Nodecl::NodeclBase, InterleavedAccess> map_nodecl_interleaved_t;
+
     class VectorizerEnvironment
     {
         public:
@@ -60,6 +73,9 @@ namespace Vectorization
             std::list<unsigned int> _mask_check_bb_cost;    // Costs of BB for early exist heuristic
 
             TL::Symbol _function_return;                    // Return symbol when return statement are present in masked code
+            Nodecl::NodeclBase _early_exit;                 // 'if (cond) break;' leaving the SIMD loop with a non-uniform cond
+            bool _speculative_loads;                        // Vectorizing code before the early exit with first-faulting loads
+            map_nodecl_interleaved_t _interleaved_accesses; // Strided accesses replaced by contiguous accesses + shuffles
 
             // FIXME - find a better place for this sort of things
             typedef std::pair<TL::Type, TL::Type> VectorizedClass;
@@ -0,0 +1,908 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2013 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#include "tl-vectorizer-interleaved-accesses.hpp"
+
+#include "tl-vectorizer.hpp"
+#include "tl-vectorization-utils.hpp"
+#include "tl-vectorization-analysis-interface.hpp"
+
+#include "tl-nodecl-utils.hpp"
+#include "tl-nodecl-visitor.hpp"
+#include "tl-expression-reduction.hpp"
+#include "cxx-cexpr.h"
+
+#include <algorithm>
+#include <climits>
+#include <set>
+
+
+namespace TL
+{
+namespace Vectorization
+{
+namespace
+{
+    const int MIN_INTERLEAVED_STRIDE = 2;
+    const int MAX_INTERLEAVED_STRIDE = 8;
+
+    // Memory access found in a run of statements. Accesses to an unknown
+    // object (invalid _base) may alias any other access
+    struct RunAccess
+    {
+        Nodecl::NodeclBase _node;
+        TL::Symbol _base;
+        unsigned int _stmt;
+        bool _is_store;
+        bool _is_candidate;
+
+        // Only for candidates
+        Nodecl::NodeclBase _key;        // 'a' of 'a[2*i]', 'p[i]' of 'p[i].x'
+        Nodecl::NodeclBase _subscript;  // Null for class member accesses
+        TL::Type _type;
+        int _stride;
+        int _field;
+
+        RunAccess(const Nodecl::NodeclBase& node, const TL::Symbol& base,
+                const unsigned int stmt, const bool is_store)
+            : _node(node), _base(base), _stmt(stmt), _is_store(is_store),
+            _is_candidate(false), _stride(0), _field(0)
+        {
+        }
+    };
+
+    typedef std::vector<std::pair<TL::Symbol, unsigned int> > written_symbols_t;
+
+    Nodecl::List get_body_statements(Nodecl::NodeclBase n)
+    {
+        while (!n.is_null())
+        {
+            if (n.is<Nodecl::List>())
+            {
+                Nodecl::List list = n.as<Nodecl::List>();
+
+                if (list.size() == 1
+                        && (list.front().is<Nodecl::Context>()
+                            || list.front().is<Nodecl::CompoundStatement>()))
+                    n = list.front();
+                else
+                    return list;
+            }
+            else if (n.is<Nodecl::Context>())
+                n = n.as<Nodecl::Context>().get_in_context();
+            else if (n.is<Nodecl::CompoundStatement>())
+                n = n.as<Nodecl::CompoundStatement>().get_statements();
+            else
+                break;
+        }
+
+        return Nodecl::List();
+    }
+
+    // Objects that cannot be accessed through any other base symbol:
+    // arrays (not array parameters, which are pointers) and 'restrict'
+    // pointers
+    bool is_unaliased_base(const TL::Symbol& base)
+    {
+        TL::Type type = base.get_type().no_ref();
+
+        if (type.is_array())
+            return !base.is_parameter_of_a_function();
+
+        return type.is_pointer() && type.is_restrict();
+    }
+
+    // Accesses through an unknown base may overlap any other access
+    bool bases_may_overlap(const TL::Symbol& base1, const TL::Symbol& base2)
+    {
+        if (!base1.is_valid() || !base2.is_valid() || base1 == base2)
+            return true;
+
+        return !is_unaliased_base(base1) || !is_unaliased_base(base2);
+    }
+
+    bool has_memory_accesses(const Nodecl::NodeclBase& n)
+    {
+        return Nodecl::Utils::nodecl_contains_nodecl_of_kind<Nodecl::ArraySubscript>(n)
+            || Nodecl::Utils::nodecl_contains_nodecl_of_kind<Nodecl::ClassMemberAccess>(n)
+            || Nodecl::Utils::nodecl_contains_nodecl_of_kind<Nodecl::Dereference>(n)
+            || Nodecl::Utils::nodecl_contains_nodecl_of_kind<Nodecl::FunctionCall>(n);
+    }
+
+    // a - b, if it folds to a constant
+    bool get_constant_difference(const Nodecl::NodeclBase& a,
+            const Nodecl::NodeclBase& b,
+            int& difference)
+    {
+        Nodecl::Minus minus = Nodecl::Minus::make(
+                a.shallow_copy(),
+                b.shallow_copy(),
+                a.get_type().no_ref());
+
+        TL::Optimizations::UnitaryReductor unitary_reductor;
+        unitary_reductor.reduce(minus);
+
+        if (!minus.is_constant())
+            return false;
+
+        difference = const_value_cast_to_signed_int(minus.get_constant());
+        return true;
+    }
+
+    // Elements advanced by 'subscript' in one iteration of the SIMD loop
+    bool get_constant_stride(const Nodecl::NodeclBase& scope,
+            const Nodecl::NodeclBase& subscript,
+            int& stride)
+    {
+        const objlist_nodecl_t linear_vars =
+            Vectorizer::_vectorizer_analysis->get_linear_nodecls(scope);
+
+        // Only linear and uniform symbols can take part in the subscript
+        const TL::ObjectList<Nodecl::Symbol> symbols =
+            Nodecl::Utils::get_all_symbols_occurrences(subscript);
+        for (TL::ObjectList<Nodecl::Symbol>::const_iterator it = symbols.begin();
+                it != symbols.end();
+                it++)
+        {
+            if (!Nodecl::Utils::list_contains_nodecl_by_structure(
+                        linear_vars, *it)
+                    && !Vectorizer::_vectorizer_analysis->is_uniform(
+                        scope, *it, *it))
+                return false;
+        }
+
+        // subscript(lv + step) - subscript(lv)
+        Nodecl::NodeclBase next_subscript = subscript.shallow_copy();
+        for (objlist_nodecl_t::const_iterator lv = linear_vars.begin();
+                lv != linear_vars.end();
+                lv++)
+        {
+            if (!Nodecl::Utils::nodecl_contains_nodecl_by_structure(
+                        subscript, *lv))
+                continue;
+
+            Nodecl::NodeclBase step =
+                Vectorizer::_vectorizer_analysis->get_linear_step(scope, *lv);
+
+            if (!step.is_constant())
+                return false;
+
+            Nodecl::Utils::nodecl_replace_nodecl_by_structure(
+                    next_subscript, *lv,
+                    Nodecl::Add::make(lv->shallow_copy(),
+                        step.shallow_copy(),
+                        lv->get_type().no_ref()));
+        }
+
+        return get_constant_difference(next_subscript, subscript, stride);
+    }
+
+    class RunAccessCollector : public Nodecl::ExhaustiveVisitor<void>
+    {
+        private:
+            const VectorizerEnvironment& _environment;
+            std::vector<RunAccess>& _accesses;
+            written_symbols_t& _written_symbols;
+            unsigned int _stmt;
+            int _conditional_level;
+
+            bool is_valid_element_type(const TL::Type& type)
+            {
+                // Shuffles are generated for whole native vectors only
+                return (type.is_float() || type.is_double()
+                        || type.is_signed_int() || type.is_unsigned_int())
+                    && (_environment._vec_isa_desc.get_vec_factor_from_type(type)
+                            == _environment._vec_factor);
+            }
+
+            bool is_stride_in_range(const int stride)
+            {
+                return stride >= MIN_INTERLEAVED_STRIDE
+                    && stride <= MAX_INTERLEAVED_STRIDE;
+            }
+
+            TL::Symbol get_base_symbol(const Nodecl::ArraySubscript& n)
+            {
+                Nodecl::NodeclBase subscripted = n.get_subscripted().no_conv();
+
+                if (subscripted.is<Nodecl::Symbol>())
+                    return subscripted.get_symbol();
+
+                return TL::Symbol();
+            }
+
+            // a[S*i + c]
+            void analyze_array_access(const Nodecl::ArraySubscript& n,
+                    RunAccess& access)
+            {
+                Nodecl::List subscripts = n.get_subscripts().as<Nodecl::List>();
+                TL::Type type = n.get_type().no_ref().get_unqualified_type();
+                int stride;
+
+                if (!access._base.is_valid()
+                        || subscripts.size() != 1
+                        || has_memory_accesses(subscripts.front())
+                        || !is_valid_element_type(type)
+                        || !get_constant_stride(_environment._analysis_simd_scope,
+                            subscripts.front(), stride)
+                        || !is_stride_in_range(stride))
+                    return;
+
+                access._is_candidate = true;
+                access._key = n.get_subscripted().no_conv();
+                access._subscript = subscripts.front();
+                access._type = type;
+                access._stride = stride;
+            }
+
+            // p[i].m, where sizeof(*p) is a multiple of sizeof(m)
+            void analyze_member_access(const Nodecl::ClassMemberAccess& n,
+                    RunAccess& access)
+            {
+                Nodecl::ArraySubscript class_object =
+                    n.get_lhs().no_conv().as<Nodecl::ArraySubscript>();
+                Nodecl::List subscripts =
+                    class_object.get_subscripts().as<Nodecl::List>();
+                Nodecl::NodeclBase member = n.get_member();
+                TL::Type type = n.get_type().no_ref().get_unqualified_type();
+                int index_stride;
+
+                if (!access._base.is_valid()
+                        || !member.is<Nodecl::Symbol>()
+                        || subscripts.size() != 1
+                        || has_memory_accesses(subscripts.front())
+                        || !is_valid_element_type(type)
+                        || !get_constant_stride(_environment._analysis_simd_scope,
+                            subscripts.front(), index_stride)
+                        || index_stride != 1)
+                    return;
+
+                int access_size = type.get_size();
+                int class_size = class_object.get_type().no_ref().get_size();
+                int member_offset = member.get_symbol().get_offset();
+
+                if (class_size % access_size != 0
+                        || member_offset % access_size != 0
+                        || !is_stride_in_range(class_size / access_size))
+                    return;
+
+                access._is_candidate = true;
+                access._key = class_object;
+                access._type = type;
+                access._stride = class_size / access_size;
+                access._field = member_offset / access_size;
+            }
+
+            void add_unknown_access(const bool is_store)
+            {
+                _accesses.push_back(RunAccess(Nodecl::NodeclBase::null(),
+                            TL::Symbol(), _stmt, is_store));
+            }
+
+            void add_access(const Nodecl::NodeclBase& node,
+                    const bool is_store,
+                    const bool is_update)
+            {
+                Nodecl::NodeclBase n = node.no_conv();
+
+                if (n.is<Nodecl::Symbol>())
+                {
+                    if (is_store)
+                        _written_symbols.push_back(
+                                std::make_pair(n.get_symbol(), _stmt));
+                }
+                else if (n.is<Nodecl::ArraySubscript>())
+                {
+                    Nodecl::ArraySubscript array = n.as<Nodecl::ArraySubscript>();
+                    RunAccess access(n, get_base_symbol(array), _stmt, is_store);
+
+                    if (!is_update && _conditional_level == 0)
+                        analyze_array_access(array, access);
+
+                    _accesses.push_back(access);
+                    if (is_update)
+                        _accesses.push_back(RunAccess(n, access._base, _stmt, false));
+
+                    if (!access._base.is_valid())
+                        walk(array.get_subscripted());
+                    walk(array.get_subscripts());
+                }
+                else if (n.is<Nodecl::ClassMemberAccess>()
+                        && n.as<Nodecl::ClassMemberAccess>().get_lhs().no_conv().
+                        is<Nodecl::ArraySubscript>())
+                {
+                    Nodecl::ClassMemberAccess cma = n.as<Nodecl::ClassMemberAccess>();
+                    Nodecl::ArraySubscript class_object = cma.get_lhs().no_conv().
+                        as<Nodecl::ArraySubscript>();
+                    RunAccess access(n, get_base_symbol(class_object), _stmt, is_store);
+
+                    if (!is_update && _conditional_level == 0)
+                        analyze_member_access(cma, access);
+
+                    _accesses.push_back(access);
+                    if (is_update)
+                        _accesses.push_back(RunAccess(n, access._base, _stmt, false));
+
+                    walk(class_object.get_subscripts());
+                }
+                else if (n.is<Nodecl::ClassMemberAccess>()
+                        && n.as<Nodecl::ClassMemberAccess>().get_lhs().no_conv().
+                        is<Nodecl::Symbol>())
+                {
+                    // s.x
+                    if (is_store)
+                        _written_symbols.push_back(std::make_pair(
+                                    n.as<Nodecl::ClassMemberAccess>().get_lhs().
+                                    no_conv().get_symbol(), _stmt));
+                }
+                else
+                {
+                    add_unknown_access(is_store);
+                    if (is_update)
+                        add_unknown_access(false);
+
+                    Nodecl::NodeclBase::Children children = n.children();
+                    for (Nodecl::NodeclBase::Children::iterator it = children.begin();
+                            it != children.end();
+                            it++)
+                    {
+                        walk(*it);
+                    }
+                }
+            }
+
+            void visit_update(const Nodecl::NodeclBase& lhs,
+                    const Nodecl::NodeclBase& rhs)
+            {
+                add_access(lhs, true /* store */, true /* update */);
+                walk(rhs);
+            }
+
+            void visit_short_circuit(const Nodecl::NodeclBase& lhs,
+                    const Nodecl::NodeclBase& rhs)
+            {
+                walk(lhs);
+
+                _conditional_level++;
+                walk(rhs);
+                _conditional_level--;
+            }
+
+        public:
+            RunAccessCollector(const VectorizerEnvironment& environment,
+                    std::vector<RunAccess>& accesses,
+                    written_symbols_t& written_symbols)
+                : _environment(environment), _accesses(accesses),
+                _written_symbols(written_symbols), _stmt(0),
+                _conditional_level(0)
+            {
+            }
+
+            void set_statement(const unsigned int stmt)
+            {
+                _stmt = stmt;
+            }
+
+            void visit(const Nodecl::Assignment& n)
+            {
+                add_access(n.get_lhs(), true /* store */, false /* update */);
+                walk(n.get_rhs());
+            }
+
+            void visit(const Nodecl::AddAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::MinusAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::MulAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::DivAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::ModAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::BitwiseAndAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::BitwiseOrAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::BitwiseXorAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::BitwiseShlAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::BitwiseShrAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::ArithmeticShrAssignment& n) { visit_update(n.get_lhs(), n.get_rhs()); }
+            void visit(const Nodecl::Preincrement& n) { visit_update(n.get_rhs(), Nodecl::NodeclBase::null()); }
+            void visit(const Nodecl::Postincrement& n) { visit_update(n.get_rhs(), Nodecl::NodeclBase::null()); }
+            void visit(const Nodecl::Predecrement& n) { visit_update(n.get_rhs(), Nodecl::NodeclBase::null()); }
+            void visit(const Nodecl::Postdecrement& n) { visit_update(n.get_rhs(), Nodecl::NodeclBase::null()); }
+
+            void visit(const Nodecl::ArraySubscript& n)
+            {
+                add_access(n, false /* store */, false /* update */);
+            }
+
+            void visit(const Nodecl::ClassMemberAccess& n)
+            {
+                add_access(n, false /* store */, false /* update */);
+            }
+
+            void visit(const Nodecl::Dereference& n)
+            {
+                add_unknown_access(false /* store */);
+                walk(n.get_rhs());
+            }
+
+            // Taking an address or calling a function may write any object
+            void visit(const Nodecl::Reference& n)
+            {
+                add_unknown_access(true /* store */);
+                walk(n.get_rhs());
+            }
+
+            void visit(const Nodecl::FunctionCall& n)
+            {
+                add_unknown_access(true /* store */);
+                walk(n.get_arguments());
+            }
+
+            // Accesses that are not always executed cannot be grouped
+            void visit(const Nodecl::ConditionalExpression& n)
+            {
+                walk(n.get_condition());
+
+                _conditional_level++;
+                walk(n.get_true());
+                walk(n.get_false());
+                _conditional_level--;
+            }
+
+            void visit(const Nodecl::LogicalAnd& n)
+            {
+                visit_short_circuit(n.get_lhs(), n.get_rhs());
+            }
+
+            void visit(const Nodecl::LogicalOr& n)
+            {
+                visit_short_circuit(n.get_lhs(), n.get_rhs());
+            }
+    };
+}
+
+    VectorizerInterleavedAccesses::VectorizerInterleavedAccesses(
+            VectorizerEnvironment& environment)
+        : _environment(environment)
+    {
+    }
+
+    void VectorizerInterleavedAccesses::plan(
+            const Nodecl::ForStatement& for_statement)
+    {
+        // Wide accesses are not masked
+        if (!_environment._vec_isa_desc.support_shuffles()
+                || _environment._mask_list.empty()
+                || !Utils::is_all_one_mask(_environment._mask_list.back()))
+            return;
+
+        // Groups are built from runs of straight-line statements
+        // of the body of the loop
+        Nodecl::List stmts = get_body_statements(for_statement.get_statement());
+
+        objlist_nodecl_t run;
+        for (Nodecl::List::iterator it = stmts.begin();
+                it != stmts.end();
+                it++)
+        {
+            if (it->is<Nodecl::ExpressionStatement>()
+                    || it->is<Nodecl::ObjectInit>())
+            {
+                run.append(*it);
+            }
+            else if (!it->is<Nodecl::CxxDef>()
+                    && !it->is<Nodecl::CxxDecl>())
+            {
+                plan_run(run);
+                run.clear();
+            }
+        }
+
+        plan_run(run);
+    }
+
+    void VectorizerInterleavedAccesses::plan_run(const objlist_nodecl_t& run)
+    {
+        if (run.empty())
+            return;
+
+        std::vector<RunAccess> accesses;
+        written_symbols_t written_symbols;
+        RunAccessCollector collector(_environment, accesses, written_symbols);
+
+        for (unsigned int i = 0; i < run.size(); i++)
+        {
+            collector.set_statement(i);
+
+            if (run[i].is<Nodecl::ExpressionStatement>())
+            {
+                collector.walk(run[i].as<Nodecl::ExpressionStatement>().get_nest());
+            }
+            else
+            {
+                TL::Symbol sym = run[i].get_symbol();
+
+                if (!sym.get_value().is_null())
+                    collector.walk(sym.get_value());
+
+                written_symbols.push_back(std::make_pair(sym, i));
+            }
+        }
+
+        // Group candidates that access the same object with the same stride.
+        // The field of an array access is its offset from the first member
+        std::vector<std::vector<unsigned int> > candidate_groups;
+        for (unsigned int i = 0; i < accesses.size(); i++)
+        {
+            RunAccess& access = accesses[i];
+
+            if (!access._is_candidate)
+                continue;
+
+            bool grouped = false;
+            for (std::vector<std::vector<unsigned int> >::iterator
+                    group_it = candidate_groups.begin();
+                    group_it != candidate_groups.end() && !grouped;
+                    group_it++)
+            {
+                const RunAccess& first = accesses[group_it->front()];
+
+                if (first._is_store != access._is_store
+                        || first._subscript.is_null() != access._subscript.is_null()
+                        || first._stride != access._stride
+                        || !first._type.is_same_type(access._type)
+                        || !Nodecl::Utils::structurally_equal_nodecls(
+                            first._key, access._key, true /* skip conversions */))
+                    continue;
+
+                if (!access._subscript.is_null()
+                        && !get_constant_difference(access._subscript,
+                            first._subscript, access._field))
+                    continue;
+
+                group_it->push_back(i);
+                grouped = true;
+            }
+
+            if (!grouped)
+                candidate_groups.push_back(std::vector<unsigned int>(1, i));
+        }
+
+        for (std::vector<std::vector<unsigned int> >::iterator
+                group_it = candidate_groups.begin();
+                group_it != candidate_groups.end();
+                group_it++)
+        {
+            const std::vector<unsigned int>& members = *group_it;
+            const RunAccess& first = accesses[members.front()];
+            const int stride = first._stride;
+            const bool is_array = !first._subscript.is_null();
+
+            int min_field = INT_MAX, max_field = INT_MIN;
+            unsigned int first_stmt = UINT_MAX, last_stmt = 0;
+            std::set<int> fields;
+            TL::ObjectList<TL::Symbol> address_symbols =
+                Nodecl::Utils::get_all_symbols(first._key);
+
+            for (std::vector<unsigned int>::const_iterator it = members.begin();
+                    it != members.end();
+                    it++)
+            {
+                const RunAccess& member = accesses[*it];
+
+                fields.insert(member._field);
+                min_field = std::min(min_field, member._field);
+                max_field = std::max(max_field, member._field);
+                first_stmt = std::min(first_stmt, member._stmt);
+                last_stmt = std::max(last_stmt, member._stmt);
+
+                if (is_array)
+                    address_symbols.insert(
+                            Nodecl::Utils::get_all_symbols(member._subscript));
+            }
+
+            // Array groups must cover whole elements so the wide accesses
+            // do not go beyond the last element accessed by the scalar code
+            if (is_array && max_field - min_field != stride - 1)
+                continue;
+
+            // Stores write every field exactly once. Loads must use enough
+            // fields to pay off the shuffles
+            if (first._is_store)
+            {
+                if (fields.size() != (unsigned int) stride
+                        || members.size() != (unsigned int) stride)
+                    continue;
+            }
+            else if (fields.size() < (unsigned int) std::max(
+                        MIN_INTERLEAVED_STRIDE, (stride + 1) / 2))
+            {
+                continue;
+            }
+
+            // Wide loads are moved before the first member and wide stores
+            // after the last one, so no access that may overlap the group
+            // can lie between them. Otherwise the members are left as
+            // gathers/scatters
+            bool conflict = false;
+            for (unsigned int i = 0; i < accesses.size() && !conflict; i++)
+            {
+                const RunAccess& access = accesses[i];
+
+                if (std::find(members.begin(), members.end(), i) != members.end()
+                        || !bases_may_overlap(access._base, first._base))
+                    continue;
+
+                if (first._is_store)
+                {
+                    conflict = (access._is_store
+                            && access._stmt >= first_stmt && access._stmt <= last_stmt)
+                        || (!access._is_store
+                            && access._stmt > first_stmt && access._stmt <= last_stmt);
+                }
+                else
+                {
+                    conflict = access._is_store
+                        && access._stmt >= first_stmt && access._stmt < last_stmt;
+                }
+            }
+
+            // The address of the members cannot change between them
+            for (written_symbols_t::const_iterator it = written_symbols.begin();
+                    it != written_symbols.end() && !conflict;
+                    it++)
+            {
+                conflict = it->second >= first_stmt && it->second <= last_stmt
+                    && address_symbols.contains(it->first);
+            }
+
+            if (conflict)
+                continue;
+
+            InterleavedGroup group;
+            group._element_type = first._type;
+            group._stride = stride;
+            group._is_store = first._is_store;
+            group._first_stmt = run[first_stmt];
+            group._last_stmt = run[last_stmt];
+
+            TL::Type pointer_type = first._type.get_pointer_to();
+            if (is_array)
+            {
+                for (std::vector<unsigned int>::const_iterator it = members.begin();
+                        it != members.end();
+                        it++)
+                {
+                    if (accesses[*it]._field == min_field)
+                    {
+                        group._start = Nodecl::Reference::make(
+                                accesses[*it]._node.shallow_copy(),
+                                pointer_type,
+                                accesses[*it]._node.get_locus());
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                // (T *) &p[i]
+                group._start = Nodecl::Conversion::make(
+                        Nodecl::Reference::make(
+                            first._key.shallow_copy(),
+                            first._key.get_type().no_ref().get_pointer_to(),
+                            first._key.get_locus()),
+                        pointer_type,
+                        first._key.get_locus());
+                group._start.set_text("C");
+            }
+
+            TL::Scope scope = group._first_stmt.retrieve_context();
+            TL::Type vector_type = Utils::get_qualified_vector_to(
+                    first._type, _environment._vec_factor);
+
+            for (int i = 0; i < stride; i++)
+            {
+                TL::Symbol reg = scope.new_symbol("__interleaved_"
+                        + Utils::get_var_counter());
+                reg.get_internal_symbol()->kind = SK_VARIABLE;
+                symbol_entity_specs_set_is_user_declared(
+                        reg.get_internal_symbol(), 1);
+                reg.set_type(vector_type);
+
+                group._registers.append(reg);
+            }
+
+            for (std::vector<unsigned int>::const_iterator it = members.begin();
+                    it != members.end();
+                    it++)
+            {
+                InterleavedAccess interleaved_access;
+                interleaved_access._registers = group._registers;
+                interleaved_access._stride = stride;
+                interleaved_access._field = is_array ?
+                    accesses[*it]._field - min_field : accesses[*it]._field;
+                interleaved_access._is_store = first._is_store;
+
+                _environment._interleaved_accesses[accesses[*it]._node] =
+                    interleaved_access;
+            }
+
+            VECTORIZATION_DEBUG()
+            {
+                fprintf(stderr, "VECTORIZER: Interleaved %s group of %d fields "\
+                        "(%d accesses) at '%s'\n",
+                        first._is_store ? "store" : "load",
+                        stride, (int) members.size(),
+                        group._start.prettyprint().c_str());
+            }
+
+            _groups.push_back(group);
+        }
+    }
+
+    void VectorizerInterleavedAccesses::finalize()
+    {
+        const unsigned int vec_factor = _environment._vec_factor;
+
+        for (std::list<InterleavedGroup>::iterator group_it = _groups.begin();
+                group_it != _groups.end();
+                group_it++)
+        {
+            const InterleavedGroup& group = *group_it;
+            const locus_t* locus = group._first_stmt.get_locus();
+
+            TL::Type vector_type = Utils::get_qualified_vector_to(
+                    group._element_type, vec_factor);
+            TL::Type pointer_type = group._element_type.get_pointer_to();
+
+            if (IS_CXX_LANGUAGE)
+            {
+                for (objlist_tlsym_t::const_iterator it = group._registers.begin();
+                        it != group._registers.end();
+                        it++)
+                {
+                    group._first_stmt.prepend_sibling(
+                            Nodecl::CxxDef::make(
+                                /* context of def */ Nodecl::NodeclBase::null(),
+                                *it,
+                                locus));
+                }
+            }
+
+            objlist_nodecl_t wide_stmts;
+            for (unsigned int j = 0; j < group._stride; j++)
+            {
+                Nodecl::NodeclBase address = group._start.shallow_copy();
+                if (j > 0)
+                {
+                    address = Nodecl::Add::make(address,
+                            const_value_to_nodecl(const_value_get_signed_int(
+                                    j * vec_factor)),
+                            pointer_type,
+                            locus);
+                }
+
+                Nodecl::List offset_list = Utils::get_vector_offset_list(
+                        j * vec_factor, 1, vec_factor);
+                Nodecl::VectorLiteral strides = Nodecl::VectorLiteral::make(
+                        offset_list,
+                        Utils::get_null_mask(),
+                        Utils::get_qualified_vector_to(
+                            TL::Type::get_int_type(), vec_factor),
+                        locus);
+                strides.set_constant(offset_list.get_constant());
+
+                if (group._is_store)
+                {
+                    // Element e of the wide register is lane e/S of field e%S
+                    Nodecl::List sources;
+                    for (objlist_tlsym_t::const_iterator it = group._registers.begin();
+                            it != group._registers.end();
+                            it++)
+                    {
+                        sources.append(it->make_nodecl(true, locus));
+                    }
+
+                    Nodecl::List indexes;
+                    for (unsigned int l = 0; l < vec_factor; l++)
+                    {
+                        unsigned int e = j * vec_factor + l;
+                        indexes.append(const_value_to_nodecl(
+                                    const_value_get_signed_int(
+                                        (e % group._stride) * vec_factor
+                                        + e / group._stride)));
+                    }
+
+                    Nodecl::VectorShuffle shuffle = Nodecl::VectorShuffle::make(
+                            sources, indexes, vector_type, locus);
+
+                    Nodecl::List store_flags;
+                    store_flags.append(Nodecl::VectorScatter::make(
+                                group._start.shallow_copy(),
+                                strides,
+                                shuffle.shallow_copy(),
+                                Utils::get_null_mask(),
+                                vector_type,
+                                locus));
+
+                    wide_stmts.append(Nodecl::ExpressionStatement::make(
+                                Nodecl::VectorStore::make(
+                                    address,
+                                    shuffle,
+                                    Utils::get_null_mask(),
+                                    store_flags,
+                                    vector_type,
+                                    locus)));
+                }
+                else
+                {
+                    Nodecl::List load_flags;
+                    load_flags.append(Nodecl::VectorGather::make(
+                                group._start.shallow_copy(),
+                                strides,
+                                Utils::get_null_mask(),
+                                vector_type,
+                                locus));
+
+                    wide_stmts.append(Nodecl::ExpressionStatement::make(
+                                Nodecl::VectorAssignment::make(
+                                    group._registers[j].make_nodecl(true, locus),
+                                    Nodecl::VectorLoad::make(
+                                        address,
+                                        Utils::get_null_mask(),
+                                        load_flags,
+                                        vector_type,
+                                        locus),
+                                    Utils::get_null_mask(),
+                                    Nodecl::NodeclBase::null(), // HasBeenDefinedFlag
+                                    vector_type,
+                                    locus)));
+                }
+            }
+
+            // Wide loads go before the first member of the group
+            // and wide stores after the last one
+            if (group._is_store)
+            {
+                for (objlist_nodecl_t::reverse_iterator it = wide_stmts.rbegin();
+                        it != wide_stmts.rend();
+                        it++)
+                {
+                    group._last_stmt.append_sibling(*it);
+                }
+            }
+            else
+            {
+                for (objlist_nodecl_t::iterator it = wide_stmts.begin();
+                        it != wide_stmts.end();
+                        it++)
+                {
+                    group._first_stmt.prepend_sibling(*it);
+                }
+            }
+        }
+
+        _groups.clear();
+        _environment._interleaved_accesses.clear();
+    }
+}
+}
@@ -0,0 +1,77 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2013 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#ifndef TL_VECTORIZER_INTERLEAVED_ACCESSES_HPP
+#define TL_VECTORIZER_INTERLEAVED_ACCESSES_HPP
+
+#include "tl-vectorizer-environment.hpp"
+#include "tl-nodecl.hpp"
+
+#include <list>
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    // Groups strided accesses with a common base and a constant stride
+    // (2 to 8 elements), such as 'p[i].x, p[i].y, p[i].z' or 'a[2*i], a[2*i+1]',
+    // so they are vectorized as contiguous vector loads/stores plus shuffles
+    // instead of gathers/scatters. Accesses left out of a group still
+    // become gathers/scatters.
+    class VectorizerInterleavedAccesses
+    {
+        private:
+            struct InterleavedGroup
+            {
+                Nodecl::NodeclBase _start;      // Address of the first element of the group
+                TL::Type _element_type;
+                unsigned int _stride;
+                bool _is_store;
+                Nodecl::NodeclBase _first_stmt; // Wide loads are emitted before it
+                Nodecl::NodeclBase _last_stmt;  // Wide stores are emitted after it
+                objlist_tlsym_t _registers;
+            };
+
+            VectorizerEnvironment& _environment;
+            std::list<InterleavedGroup> _groups;
+
+            void plan_run(const objlist_nodecl_t& run);
+
+        public:
+            VectorizerInterleavedAccesses(VectorizerEnvironment& environment);
+
+            // Fills the interleaved accesses of the environment. It must be
+            // called before the body of the loop is vectorized
+            void plan(const Nodecl::ForStatement& for_statement);
+            // Emits the wide loads/stores of each group once the body of
+            // the loop has been vectorized
+            void finalize();
+    };
+}
+}
+
+#endif // TL_VECTORIZER_INTERLEAVED_ACCESSES_HPP
@@ -29,13 +29,299 @@
 #include "tl-vectorization-utils.hpp"
 #include "tl-vectorizer.hpp"
 #include "tl-optimizations.hpp"
+#include "tl-nodecl-utils.hpp"
+#include "tl-nodecl-visitor.hpp"
 
 #include "cxx-cexpr.h"
+#include "cxx-diagnostic.h"
 
 namespace TL
 {
 namespace Vectorization
 {
+    namespace
+    {
+        // Breaks that leave the loop. Breaks of inner loops and switches
+        // are skipped
+        void get_loop_breaks(const Nodecl::NodeclBase& n,
+                objlist_nodecl_t& loop_breaks)
+        {
+            if (n.is_null())
+                return;
+
+            if (n.is<Nodecl::BreakStatement>())
+            {
+                loop_breaks.append(n);
+                return;
+            }
+
+            if (n.is<Nodecl::ForStatement>()
+                    || n.is<Nodecl::WhileStatement>()
+                    || n.is<Nodecl::DoStatement>()
+                    || n.is<Nodecl::SwitchStatement>())
+                return;
+
+            Nodecl::NodeclBase::Children children = n.children();
+            for (Nodecl::NodeclBase::Children::iterator it = children.begin();
+                    it != children.end();
+                    it++)
+            {
+                get_loop_breaks(*it, loop_breaks);
+            }
+        }
+
+        Nodecl::NodeclBase get_last_statement(Nodecl::NodeclBase n)
+        {
+            while (!n.is_null())
+            {
+                if (n.is<Nodecl::List>())
+                {
+                    Nodecl::List list = n.as<Nodecl::List>();
+                    if (list.empty())
+                        return Nodecl::NodeclBase::null();
+
+                    n = list.back();
+                }
+                else if (n.is<Nodecl::Context>())
+                    n = n.as<Nodecl::Context>().get_in_context();
+                else if (n.is<Nodecl::CompoundStatement>())
+                    n = n.as<Nodecl::CompoundStatement>().get_statements();
+                else
+                    break;
+            }
+
+            return n;
+        }
+
+        // 'if (cond) { ...; break; }' without else
+        Nodecl::NodeclBase get_exit_if(const Nodecl::NodeclBase& loop_break)
+        {
+            Nodecl::NodeclBase parent = loop_break.get_parent();
+            while (parent.is<Nodecl::List>()
+                    || parent.is<Nodecl::Context>()
+                    || parent.is<Nodecl::CompoundStatement>())
+                parent = parent.get_parent();
+
+            if (!parent.is<Nodecl::IfElseStatement>())
+                return Nodecl::NodeclBase::null();
+
+            Nodecl::IfElseStatement if_stmt =
+                parent.as<Nodecl::IfElseStatement>();
+
+            if (!if_stmt.get_else().is_null()
+                    || get_last_statement(if_stmt.get_then()) != loop_break)
+                return Nodecl::NodeclBase::null();
+
+            return if_stmt;
+        }
+
+        // Checks the code executed speculatively by the lanes that follow
+        // the early exit. It must not write anything visible outside the
+        // iteration. Loads are reported when they could touch a page that
+        // the scalar loop never reads, unless they become first-faulting
+        // loads
+        class VectorizerSpeculationChecker :
+            public Nodecl::ExhaustiveVisitor<void>
+        {
+            private:
+                const VectorizerEnvironment& _environment;
+                const objlist_tlsym_t _local_symbols;
+                bool _may_fault;
+
+                void visit_write(const Nodecl::NodeclBase& n,
+                        const Nodecl::NodeclBase& lhs)
+                {
+                    if (!lhs.is<Nodecl::Symbol>()
+                            || !_local_symbols.contains(lhs.get_symbol()))
+                    {
+                        fatal_printf_at(n.get_locus(),
+                                "SIMD: '%s' modifies '%s' before the early "
+                                "exit of the loop. Unsupported\n",
+                                n.prettyprint().c_str(),
+                                lhs.prettyprint().c_str());
+                    }
+                }
+
+            public:
+                VectorizerSpeculationChecker(
+                        const VectorizerEnvironment& environment,
+                        const Nodecl::NodeclBase& loop_body)
+                    : _environment(environment),
+                    _local_symbols(Nodecl::Utils::get_local_symbols(loop_body)),
+                    _may_fault(false)
+                {
+                }
+
+                bool may_fault() const
+                {
+                    return _may_fault;
+                }
+
+                void visit(const Nodecl::FunctionCall& n)
+                {
+                    fatal_printf_at(n.get_locus(),
+                            "SIMD: function call '%s' before the early exit "
+                            "of the loop. Unsupported\n",
+                            n.prettyprint().c_str());
+                }
+
+                void visit(const Nodecl::ArraySubscript& n)
+                {
+                    walk(n.get_subscripted());
+                    walk(n.get_subscripts());
+
+                    if (Vectorizer::_vectorizer_analysis->is_uniform(
+                                _environment._analysis_simd_scope, n, n))
+                        return;
+
+                    // Faults on the speculative lanes are suppressed
+                    if (_environment._vec_isa_desc.support_first_faulting_loads()
+                            && Vectorizer::_vectorizer_analysis->is_adjacent_access(
+                                _environment._analysis_simd_scope, n))
+                        return;
+
+                    // An aligned vector load never crosses a page boundary
+                    // and its first lane is always read by the scalar loop
+                    int alignment_output;
+                    if (Vectorizer::_vectorizer_analysis->is_adjacent_access(
+                                _environment._analysis_simd_scope, n)
+                            && Vectorizer::_vectorizer_analysis->
+                            is_simd_aligned_access(
+                                _environment._analysis_simd_scope,
+                                n,
+                                _environment._aligned_symbols_map,
+                                _environment._suitable_exprs_list,
+                                _environment._vec_factor,
+                                _environment._vec_isa_desc.get_memory_alignment_in_bytes(),
+                                alignment_output))
+                        return;
+
+                    // It could read a page that the scalar loop never
+                    // touches
+                    info_printf_at(n.get_locus(),
+                            "SIMD: speculative load '%s' is not aligned and "
+                            "may fault after the early exit of the loop\n",
+                            n.prettyprint().c_str());
+                    _may_fault = true;
+                }
+
+                void visit(const Nodecl::Assignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::AddAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::MinusAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::MulAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::DivAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::ModAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::BitwiseAndAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::BitwiseOrAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::BitwiseXorAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::BitwiseShlAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::BitwiseShrAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::ArithmeticShrAssignment& n)
+                {
+                    visit_write(n, n.get_lhs());
+                    walk(n.get_rhs());
+                }
+                void visit(const Nodecl::Preincrement& n)
+                {
+                    visit_write(n, n.get_rhs());
+                }
+                void visit(const Nodecl::Postincrement& n)
+                {
+                    visit_write(n, n.get_rhs());
+                }
+                void visit(const Nodecl::Predecrement& n)
+                {
+                    visit_write(n, n.get_rhs());
+                }
+                void visit(const Nodecl::Postdecrement& n)
+                {
+                    visit_write(n, n.get_rhs());
+                }
+        };
+
+        // Checks the statements executed before 'exit_if'.
+        // Returns true when 'exit_if' has been reached
+        bool check_speculative_statements(const Nodecl::NodeclBase& n,
+                const Nodecl::NodeclBase& exit_if,
+                VectorizerSpeculationChecker& checker)
+        {
+            if (n == exit_if)
+                return true;
+
+            if (n.is<Nodecl::List>())
+            {
+                Nodecl::List list = n.as<Nodecl::List>();
+                for (Nodecl::List::iterator it = list.begin();
+                        it != list.end();
+                        it++)
+                {
+                    if (check_speculative_statements(*it, exit_if, checker))
+                        return true;
+                }
+                return false;
+            }
+            else if (n.is<Nodecl::Context>())
+            {
+                return check_speculative_statements(
+                        n.as<Nodecl::Context>().get_in_context(),
+                        exit_if, checker);
+            }
+            else if (n.is<Nodecl::CompoundStatement>())
+            {
+                return check_speculative_statements(
+                        n.as<Nodecl::CompoundStatement>().get_statements(),
+                        exit_if, checker);
+            }
+
+            checker.walk(n);
+            return false;
+        }
+    }
+
     VectorizerLoopInfo::VectorizerLoopInfo(
             const Nodecl::NodeclBase& loop_stmt,
             const VectorizerEnvironment& environment)
@@ -53,12 +339,27 @@ namespace Vectorization
             _condition = loop_stmt.as<Nodecl::WhileStatement>().
                 get_condition();
         }
+        else if (loop_stmt.is<Nodecl::DoStatement>())
+        {
+            _condition = loop_stmt.as<Nodecl::DoStatement>().
+                get_condition();
+        }
         else
         {
-            fatal_error("VectorizerLoopInfo: Neither a for nor a while");
+            fatal_error("VectorizerLoopInfo: Neither a for, a while nor a do");
         }
     }
 
+    Nodecl::NodeclBase VectorizerLoopInfo::get_loop_body()
+    {
+        if (_loop.is<Nodecl::ForStatement>())
+            return _loop.as<Nodecl::ForStatement>().get_statement();
+        else if (_loop.is<Nodecl::WhileStatement>())
+            return _loop.as<Nodecl::WhileStatement>().get_statement();
+        else
+            return _loop.as<Nodecl::DoStatement>().get_statement();
+    }
+
     bool VectorizerLoopInfo::ivs_values_are_uniform_in_simd_scope()
     {
         bool ivs_values_uniform = true;
@@ -306,6 +607,97 @@ namespace Vectorization
         return remain_its;
     }
 
+    Nodecl::NodeclBase VectorizerLoopInfo::get_early_exit()
+    {
+        bool speculation_may_fault;
+        return get_early_exit(speculation_may_fault);
+    }
+
+    // Loads before the early exit that could fault on the lanes after it
+    // keep the loop scalar
+    bool VectorizerLoopInfo::early_exit_may_fault()
+    {
+        bool speculation_may_fault;
+        get_early_exit(speculation_may_fault);
+
+        return speculation_may_fault;
+    }
+
+    // The main loop leaves the vector iteration that triggers the exit
+    // and the scalar epilog re-executes it, so the epilog runs the
+    // remaining iterations from there. The speculative statements
+    // cannot write non-local symbols, so the induction variables of while
+    // and do loops still hold the base of that vector iteration
+    Nodecl::NodeclBase VectorizerLoopInfo::get_early_exit(
+            bool& speculation_may_fault)
+    {
+        Nodecl::NodeclBase early_exit;
+        speculation_may_fault = false;
+
+        Nodecl::NodeclBase loop_body = get_loop_body();
+
+        objlist_nodecl_t loop_breaks;
+        get_loop_breaks(loop_body, loop_breaks);
+
+        for(objlist_nodecl_t::const_iterator it = loop_breaks.begin();
+                it != loop_breaks.end();
+                it ++)
+        {
+            Nodecl::NodeclBase exit_if = get_exit_if(*it);
+            if (exit_if.is_null())
+                continue;
+
+            // Uniform breaks do not need an early exit
+            Nodecl::NodeclBase exit_cond =
+                exit_if.as<Nodecl::IfElseStatement>().get_condition();
+            if (exit_cond.is_constant() ||
+                    Vectorizer::_vectorizer_analysis->is_uniform(
+                        _environment._analysis_simd_scope, exit_cond, exit_cond))
+                continue;
+
+            if (!early_exit.is_null())
+            {
+                fatal_printf_at(it->get_locus(),
+                        "SIMD: loops with more than one early exit "
+                        "are not supported\n");
+            }
+
+            early_exit = exit_if;
+        }
+
+        if (early_exit.is_null())
+            return early_exit;
+
+        // The exit condition must be evaluated in every iteration
+        for (Nodecl::NodeclBase parent = early_exit.get_parent();
+                parent != _loop;
+                parent = parent.get_parent())
+        {
+            if (!(parent.is<Nodecl::List>()
+                    || parent.is<Nodecl::Context>()
+                    || parent.is<Nodecl::CompoundStatement>()))
+            {
+                fatal_printf_at(early_exit.get_locus(),
+                        "SIMD: early exits in conditional code "
+                        "are not supported\n");
+            }
+        }
+
+        VectorizerSpeculationChecker checker(_environment, loop_body);
+        check_speculative_statements(loop_body, early_exit, checker);
+        checker.walk(early_exit.as<Nodecl::IfElseStatement>().get_condition());
+        speculation_may_fault = checker.may_fault();
+
+        VECTORIZATION_DEBUG()
+        {
+            fprintf(stderr, "VECTORIZER: Early exit '%s'\n\n",
+                    early_exit.as<Nodecl::IfElseStatement>().get_condition().
+                    prettyprint().c_str());
+        }
+
+        return early_exit;
+    }
+
 /*
     DEPRECATED bool VectorizerLoopInfo::ivs_lb_depend_on_simd_iv()
     {
@@ -44,6 +44,9 @@ namespace Vectorization
             const objlist_nodecl_t _ivs;
             Nodecl::NodeclBase _condition;
 
+            Nodecl::NodeclBase get_loop_body();
+            Nodecl::NodeclBase get_early_exit(bool& speculation_may_fault);
+
         public:
             VectorizerLoopInfo(const Nodecl::NodeclBase& n,
                     const VectorizerEnvironment& environment);
@@ -57,6 +60,8 @@ namespace Vectorization
             bool condition_is_uniform_in_simd_scope();
 
             int get_epilog_info(bool& only_epilog);
+            Nodecl::NodeclBase get_early_exit();
+            bool early_exit_may_fault();
     };
 }
 }
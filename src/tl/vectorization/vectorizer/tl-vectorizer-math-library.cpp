@@ -0,0 +1,227 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-vectorizer-math-library.hpp"
+
+#include "tl-vectorizer.hpp"
+#include "tl-source.hpp"
+
+#include <list>
+#include <sstream>
+#include <vector>
+
+namespace TL
+{
+namespace Vectorization
+{
+    namespace
+    {
+        struct math_function_t
+        {
+            const char* name;
+            unsigned int num_arguments;
+        };
+
+        // Double precision names. Single precision ones have an 'f' suffix
+        const math_function_t math_functions[] =
+        {
+            { "sin", 1 },
+            { "cos", 1 },
+            { "exp", 1 },
+            { "log", 1 },
+            { "pow", 2 },
+            { NULL, 0 }
+        };
+
+        struct math_isa_t
+        {
+            const char* device;
+            unsigned int vector_length;
+            const char* float_vector_type;
+            const char* double_vector_type;
+            // NULL if the ISA has no mask registers
+            const char* float_mask_type;
+            const char* double_mask_type;
+            // ISA letter of the x86_64 vector function ABI.
+            // 0 if libmvec does not support the ISA
+            char libmvec_isa;
+        };
+
+        const math_isa_t math_isas[] =
+        {
+            { "smp",      16, "__m128", "__m128d", NULL, NULL, 'b' },
+            { "avx2",     32, "__m256", "__m256d", NULL, NULL, 'd' },
+            // 256-bit AVX-512 uses the AVX2 variants
+            { "avx512vl", 32, "__m256", "__m256d", NULL, NULL, 'd' },
+            { "knc",      64, "__m512", "__m512d", "__mmask16", "__mmask8", 0 },
+            { "knl",      64, "__m512", "__m512d", "__mmask16", "__mmask8", 'e' },
+            { "avx512",   64, "__m512", "__m512d", "__mmask16", "__mmask8", 'e' },
+            { NULL, 0, NULL, NULL, NULL, NULL, 0 }
+        };
+
+        const math_isa_t* get_math_isa(const std::string& device)
+        {
+            for (int i = 0; math_isas[i].device != NULL; i++)
+            {
+                if (device == math_isas[i].device)
+                    return &math_isas[i];
+            }
+
+            return NULL;
+        }
+    }
+
+    VectorizerMathLibrary::VectorizerMathLibrary(
+            const VectorMathLibrary library,
+            const VectorMathAccuracy accuracy)
+        : _library(library), _accuracy(accuracy)
+    {
+    }
+
+    std::string VectorizerMathLibrary::get_vector_function_name(
+            const std::string& scalar_function,
+            const unsigned int num_arguments,
+            const char libmvec_isa,
+            const unsigned int vec_factor,
+            const bool masked) const
+    {
+        std::stringstream name;
+
+        if (_library == LIBMVEC_MATH_LIBRARY)
+        {
+            ERROR_CONDITION(masked, "libmvec does not provide masked variants", 0);
+
+            // libmvec only provides ~4-ulp variants. They are also used
+            // when a lower accuracy is requested
+            name << "_ZGV" << libmvec_isa << "N" << vec_factor
+                << std::string(num_arguments, 'v')
+                << "_" << scalar_function;
+        }
+        else
+        {
+            name << "__svml_" << scalar_function << vec_factor;
+
+            if (_accuracy == HIGH_MATH_ACCURACY)
+                name << "_ha";
+            else if (_accuracy == LOW_MATH_ACCURACY)
+                name << "_ep";
+
+            if (masked)
+                name << "_mask";
+        }
+
+        return name.str();
+    }
+
+    void VectorizerMathLibrary::register_functions(const std::string& device)
+    {
+        const math_isa_t* isa = get_math_isa(device);
+
+        if (isa == NULL
+                || (_library == LIBMVEC_MATH_LIBRARY && isa->libmvec_isa == 0))
+            return;
+
+        VECTORIZATION_DEBUG()
+        {
+            fprintf(stderr, "VECTORIZER: Registering %s math functions for '%s'\n",
+                    _library == SVML_MATH_LIBRARY ? "SVML" : "libmvec",
+                    device.c_str());
+        }
+
+        TL::Scope global_scope = TL::Scope::get_global_scope();
+
+        for (int is_double = 0; is_double < 2; is_double++)
+        {
+            // Each element type is registered with the vector factor
+            // that fills one vector register
+            const unsigned int vec_factor =
+                isa->vector_length / (is_double ? 8 : 4);
+            const std::string vector_type =
+                is_double ? isa->double_vector_type : isa->float_vector_type;
+            const char* mask_type =
+                is_double ? isa->double_mask_type : isa->float_mask_type;
+            const int num_variants =
+                (_library == SVML_MATH_LIBRARY && mask_type != NULL) ? 2 : 1;
+
+            TL::Source declarations;
+            // register_functions_info only keeps pointers to the names
+            std::list<std::string> names;
+            std::vector<register_functions_info> functions;
+
+            for (int i = 0; math_functions[i].name != NULL; i++)
+            {
+                const std::string scalar_function =
+                    std::string(math_functions[i].name) + (is_double ? "" : "f");
+
+                // Skip functions not declared in the translation unit
+                if (!global_scope.get_symbol_from_name(scalar_function).is_valid())
+                    continue;
+
+                names.push_back(scalar_function);
+                const char* scalar_name = names.back().c_str();
+
+                for (int masked = 0; masked < num_variants; masked++)
+                {
+                    names.push_back(get_vector_function_name(scalar_function,
+                                math_functions[i].num_arguments,
+                                isa->libmvec_isa,
+                                vec_factor,
+                                masked));
+
+                    declarations << vector_type << " " << names.back() << "(";
+                    if (masked)
+                        declarations << vector_type << ", " << mask_type << ", ";
+                    for (unsigned int j = 0; j < math_functions[i].num_arguments; j++)
+                    {
+                        if (j > 0)
+                            declarations << ", ";
+                        declarations << vector_type;
+                    }
+                    declarations << ");\n";
+
+                    register_functions_info info = { scalar_name,
+                        names.back().c_str(),
+                        is_double ? TL::Type::get_double_type() : TL::Type::get_float_type(),
+                        (bool)masked };
+                    functions.push_back(info);
+                }
+            }
+
+            if (functions.empty())
+                continue;
+
+            register_functions_info last = { NULL, NULL, TL::Type::get_void_type(), false };
+            functions.push_back(last);
+
+            declarations.parse_global(global_scope);
+
+            Vectorizer::get_vectorizer().register_svml_functions(&functions[0],
+                    device, vec_factor, global_scope, isa->float_vector_type);
+        }
+    }
+}
+}
@@ -0,0 +1,85 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#ifndef TL_VECTORIZER_MATH_LIBRARY_HPP
+#define TL_VECTORIZER_MATH_LIBRARY_HPP
+
+#include <string>
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    enum VectorMathLibrary
+    {
+        SVML_MATH_LIBRARY,
+        LIBMVEC_MATH_LIBRARY
+    };
+
+    // Maximum error of the vector variants: high (~1 ulp), medium
+    // (~4 ulp) and low (about half of the mantissa bits are correct)
+    enum VectorMathAccuracy
+    {
+        HIGH_MATH_ACCURACY,
+        MEDIUM_MATH_ACCURACY,
+        LOW_MATH_ACCURACY
+    };
+
+    // Binds the scalar math functions (sin, cos, exp, log, pow and their
+    // float counterparts) to the vector variants provided by a vector
+    // math library. Names follow the conventions of each library:
+    //   SVML:    __svml_<function><VF>[_ha|_ep][_mask]
+    //   libmvec: _ZGV<isa>N<VF><one 'v' per argument>_<function>
+    // Masked variants take (src, mask, arguments...) and are only
+    // provided by SVML on ISAs with mask registers
+    class VectorizerMathLibrary
+    {
+        private:
+            const VectorMathLibrary _library;
+            const VectorMathAccuracy _accuracy;
+
+            std::string get_vector_function_name(
+                    const std::string& scalar_function,
+                    const unsigned int num_arguments,
+                    const char libmvec_isa,
+                    const unsigned int vec_factor,
+                    const bool masked) const;
+
+        public:
+            VectorizerMathLibrary(const VectorMathLibrary library,
+                    const VectorMathAccuracy accuracy);
+
+            // Declares the vector variants available for 'device' and
+            // registers them as vector versions of the scalar functions
+            // declared in the translation unit
+            void register_functions(const std::string& device);
+    };
+}
+}
+
+#endif //TL_VECTORIZER_MATH_LIBRARY_HPP
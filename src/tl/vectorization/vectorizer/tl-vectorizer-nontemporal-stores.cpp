@@ -0,0 +1,205 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#include "tl-vectorizer-nontemporal-stores.hpp"
+
+#include "tl-vectorizer.hpp"
+#include "tl-vectorizer-cost-model.hpp"
+
+#include "cxx-cexpr.h"
+
+namespace TL
+{
+namespace Vectorization
+{
+    VectorizerNontemporalStores::VectorizerNontemporalStores(
+            const VectorizerEnvironment& environment,
+            const unsigned long long int threshold)
+        : _environment(environment), _threshold(threshold),
+        _nesting_level(0), _trip_count(0), _trip_count_known(false)
+    {
+    }
+
+    void VectorizerNontemporalStores::select(
+            const Nodecl::NodeclBase& loop_statement,
+            map_tlsym_objlist_t& nontemporal_exprs)
+    {
+        _trip_count_known = VectorizerCostModel::get_constant_trip_count(
+                loop_statement, _trip_count);
+
+        if (loop_statement.is<Nodecl::ForStatement>())
+            walk(loop_statement.as<Nodecl::ForStatement>().get_statement());
+        else if (loop_statement.is<Nodecl::WhileStatement>())
+            walk(loop_statement.as<Nodecl::WhileStatement>().get_statement());
+        else
+            return;
+
+        for (std::map<TL::Symbol, unsigned int>::const_iterator it =
+                _candidate_stores.begin();
+                it != _candidate_stores.end();
+                it++)
+        {
+            const TL::Symbol& sym = it->first;
+
+            // Any other access to the array (a load, a conditional or
+            // non-adjacent store...) would bring it back to the cache
+            if (_rejected_symbols.find(sym) != _rejected_symbols.end()
+                    || _symbol_uses[sym] > 0)
+                continue;
+
+            if (nontemporal_exprs.find(sym) != nontemporal_exprs.end())
+                continue;
+
+            nontemporal_exprs.insert(std::make_pair(sym, objlist_nodecl_t()));
+
+            info_printf_at(loop_statement.get_locus(),
+                    "SIMD: stores to '%s' will be non-temporal\n",
+                    sym.get_name().c_str());
+        }
+    }
+
+    unsigned long long int VectorizerNontemporalStores::get_footprint(
+            const Nodecl::NodeclBase& store,
+            const TL::Symbol& symbol)
+    {
+        unsigned long long int element_size =
+            store.get_type().no_ref().get_size();
+
+        if (_trip_count_known)
+            return _trip_count * element_size;
+
+        // Unknown trip count: the size of the array, if known
+        TL::Type array_type = symbol.get_type().no_ref();
+        if (array_type.is_array()
+                && array_type.array_has_size()
+                && array_type.array_get_size().is_constant())
+        {
+            return const_value_cast_to_8(
+                    array_type.array_get_size().get_constant())
+                * array_type.array_element().get_size();
+        }
+
+        return 0;
+    }
+
+    bool VectorizerNontemporalStores::is_candidate_store(
+            const Nodecl::NodeclBase& store,
+            const TL::Symbol& symbol)
+    {
+        if (_nesting_level > 0)
+            return false;
+
+        if (!Vectorizer::_vectorizer_analysis->is_adjacent_access(
+                    _environment._analysis_simd_scope, store))
+            return false;
+
+        if (get_footprint(store, symbol) < _threshold)
+            return false;
+
+        // Streaming stores require aligned addresses. Unaligned ones
+        // would be lowered as regular stores
+        int alignment_output;
+        if (!Vectorizer::_vectorizer_analysis->is_simd_aligned_access(
+                    _environment._analysis_simd_scope,
+                    store,
+                    _environment._aligned_symbols_map,
+                    _environment._suitable_exprs_list,
+                    _environment._vec_factor,
+                    _environment._vec_isa_desc.get_memory_alignment_in_bytes(),
+                    alignment_output))
+        {
+            info_printf_at(store.get_locus(),
+                    "SIMD: stores to '%s' are not non-temporal because "
+                    "they might be unaligned (see the aligned clause)\n",
+                    symbol.get_name().c_str());
+
+            return false;
+        }
+
+        return true;
+    }
+
+    void VectorizerNontemporalStores::visit(const Nodecl::ForStatement& n)
+    {
+        _nesting_level++;
+        walk(n.get_loop_header());
+        walk(n.get_statement());
+        _nesting_level--;
+    }
+
+    void VectorizerNontemporalStores::visit(const Nodecl::WhileStatement& n)
+    {
+        _nesting_level++;
+        walk(n.get_condition());
+        walk(n.get_statement());
+        _nesting_level--;
+    }
+
+    void VectorizerNontemporalStores::visit(const Nodecl::IfElseStatement& n)
+    {
+        walk(n.get_condition());
+
+        _nesting_level++;
+        walk(n.get_then());
+        walk(n.get_else());
+        _nesting_level--;
+    }
+
+    void VectorizerNontemporalStores::visit(const Nodecl::Assignment& n)
+    {
+        Nodecl::NodeclBase lhs = n.get_lhs().no_conv();
+
+        if (lhs.is<Nodecl::ArraySubscript>())
+        {
+            Nodecl::ArraySubscript array = lhs.as<Nodecl::ArraySubscript>();
+            Nodecl::NodeclBase subscripted = array.get_subscripted().no_conv();
+
+            if (subscripted.is<Nodecl::Symbol>())
+            {
+                TL::Symbol sym = subscripted.as<Nodecl::Symbol>().get_symbol();
+
+                if (is_candidate_store(lhs, sym))
+                    _candidate_stores[sym]++;
+                else
+                    _rejected_symbols.insert(sym);
+
+                // The subscripted symbol is not a use of the array
+                walk(array.get_subscripts());
+                walk(n.get_rhs());
+                return;
+            }
+        }
+
+        walk(n.get_lhs());
+        walk(n.get_rhs());
+    }
+
+    void VectorizerNontemporalStores::visit(const Nodecl::Symbol& n)
+    {
+        _symbol_uses[n.get_symbol()]++;
+    }
+}
+}
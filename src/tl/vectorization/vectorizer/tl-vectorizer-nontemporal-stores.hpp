@@ -0,0 +1,86 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+#ifndef TL_VECTORIZER_NONTEMPORAL_STORES_HPP
+#define TL_VECTORIZER_NONTEMPORAL_STORES_HPP
+
+#include "tl-nodecl-visitor.hpp"
+#include "tl-vectorizer-environment.hpp"
+
+#include <map>
+#include <set>
+
+
+namespace TL
+{
+namespace Vectorization
+{
+    // Selects the arrays of a loop whose stores can be non-temporal:
+    // every iteration writes them with an aligned adjacent store, they
+    // are not read in the loop and the data written by the whole loop
+    // does not fit in the cache (footprint >= threshold)
+    class VectorizerNontemporalStores : public Nodecl::ExhaustiveVisitor<void>
+    {
+        private:
+            const VectorizerEnvironment& _environment;
+            const unsigned long long int _threshold;
+
+            // Conditional code and inner loops
+            unsigned int _nesting_level;
+
+            long long int _trip_count;
+            bool _trip_count_known;
+
+            std::map<TL::Symbol, unsigned int> _candidate_stores;
+            std::map<TL::Symbol, unsigned int> _symbol_uses;
+            std::set<TL::Symbol> _rejected_symbols;
+
+            unsigned long long int get_footprint(
+                    const Nodecl::NodeclBase& store,
+                    const TL::Symbol& symbol);
+            bool is_candidate_store(const Nodecl::NodeclBase& store,
+                    const TL::Symbol& symbol);
+
+        public:
+            VectorizerNontemporalStores(
+                    const VectorizerEnvironment& environment,
+                    const unsigned long long int threshold);
+
+            // Adds the selected symbols to 'nontemporal_exprs' (without
+            // flags). Symbols already in the map are kept untouched
+            void select(const Nodecl::NodeclBase& loop_statement,
+                    map_tlsym_objlist_t& nontemporal_exprs);
+
+            virtual void visit(const Nodecl::ForStatement& n);
+            virtual void visit(const Nodecl::WhileStatement& n);
+            virtual void visit(const Nodecl::IfElseStatement& n);
+            virtual void visit(const Nodecl::Assignment& n);
+            virtual void visit(const Nodecl::Symbol& n);
+    };
+}
+}
+
+#endif //TL_VECTORIZER_NONTEMPORAL_STORES_HPP
@@ -51,6 +51,7 @@ void VectorizerReport::reset_report()
 
     _vgathers = 0;
     _vscatters = 0;
+    _vshuffles = 0;
 
     _vpromotions = 0;
 }
@@ -84,11 +85,53 @@ void VectorizerReport::print_report(const Nodecl::NodeclBase& n)
     info_printf_at(n.get_locus(),
             "Scatters: %d\n",
             _vscatters);
+    info_printf_at(n.get_locus(),
+            "Shuffles: %d\n",
+            _vshuffles);
     info_printf_at(n.get_locus(),
             "Vector promotions: %d\n",
             _vpromotions);
 }
 
+void VectorizerReport::print_cost_report(const Nodecl::NodeclBase& n,
+        const VectorizerEnvironment& environment,
+        const VectorizerCostModel& cost_model,
+        const bool profitable)
+{
+    info_printf_at(n.get_locus(),
+            "Cost model (%s, vector factor %d): vectorization is %s\n",
+            environment._vec_isa_desc.get_id().c_str(),
+            environment._vec_factor,
+            profitable ? "profitable" : "not profitable");
+    info_printf_at(n.get_locus(),
+            "    - Trip count: %lld%s\n",
+            cost_model.get_trip_count(),
+            cost_model.is_trip_count_known() ? "" :
+            cost_model.is_trip_count_bounded() ? " (at most, from range analysis)" :
+            " (unknown, assumed)");
+    info_printf_at(n.get_locus(),
+            "    - Scalar iteration cost: %llu\n",
+            cost_model.get_scalar_cost());
+    info_printf_at(n.get_locus(),
+            "    - Vector iteration cost: %llu\n",
+            cost_model.get_vector_cost());
+    info_printf_at(n.get_locus(),
+            "    - Estimated loop cost: %llu (scalar) vs %llu (vector)\n",
+            cost_model.get_total_scalar_cost(),
+            cost_model.get_total_vector_cost());
+    info_printf_at(n.get_locus(),
+            "    - Loads: %d, Stores: %d, Unaligned: %d\n",
+            cost_model.get_vloads(),
+            cost_model.get_vstores(),
+            cost_model.get_unaligned_accesses());
+    info_printf_at(n.get_locus(),
+            "    - Gathers: %d, Scatters: %d, Promotions: %d, Masked: %d\n",
+            cost_model.get_gathers(),
+            cost_model.get_scatters(),
+            cost_model.get_promotions(),
+            cost_model.get_masked_ops());
+}
+
 void VectorizerReport::visit(const Nodecl::ObjectInit& n)
 {
     TL::Symbol sym = n.get_symbol();
@@ -158,6 +201,13 @@ void VectorizerReport::visit(const Nodecl::VectorScatter& n)
     walk(n.get_mask());
 }
 
+void VectorizerReport::visit(const Nodecl::VectorShuffle& n)
+{
+    _vshuffles++;
+
+    walk(n.get_sources());
+}
+
 
 void VectorizerReport::visit(const Nodecl::VectorPromotion& n)
 {
@@ -29,6 +29,7 @@
 
 #include "tl-nodecl-visitor.hpp"
 #include "tl-nodecl-base.hpp"
+#include "tl-vectorizer-cost-model.hpp"
 
 
 namespace TL
@@ -48,6 +49,7 @@ namespace Vectorization
 
             int _vgathers;
             int _vscatters;
+            int _vshuffles;
 
             int _vpromotions;
 
@@ -56,6 +58,10 @@ namespace Vectorization
 
             void reset_report();
             void print_report(const Nodecl::NodeclBase& n);
+            void print_cost_report(const Nodecl::NodeclBase& n,
+                    const VectorizerEnvironment& environment,
+                    const VectorizerCostModel& cost_model,
+                    const bool profitable);
             void visit(const Nodecl::ObjectInit& n);
 
             void visit(const Nodecl::VectorLoad& n);
@@ -63,6 +69,7 @@ namespace Vectorization
 
             void visit(const Nodecl::VectorGather& n);
             void visit(const Nodecl::VectorScatter& n);
+            void visit(const Nodecl::VectorShuffle& n);
 
             void visit(const Nodecl::VectorPromotion& n);
     };
@@ -126,6 +126,49 @@ namespace TL
                         }
                     }
                 }
+                else if ((_environment._vec_isa_desc.get_id().compare("avx512") == 0)
+                        || (_environment._vec_isa_desc.get_id().compare("avx512vl") == 0))
+                {
+                    if((red_name.compare("+") == 0) ||
+                            (red_name.compare("-") == 0))
+                    {
+                        if(reduction_type.is_signed_int()
+                                || reduction_type.is_signed_long_long_int())
+                        {
+                            return true;
+                        }
+                        else if(reduction_type.is_float())
+                        {
+                            return true;
+                        }
+                        else if (reduction_type.is_double())
+                        {
+                            return true;
+                        }
+                    }
+                }
+                else if ((_environment._vec_isa_desc.get_id().compare("sve") == 0)
+                        || (_environment._vec_isa_desc.get_id().compare("sve256") == 0)
+                        || (_environment._vec_isa_desc.get_id().compare("sve128") == 0))
+                {
+                    if((red_name.compare("+") == 0) ||
+                            (red_name.compare("-") == 0))
+                    {
+                        if(reduction_type.is_signed_int()
+                                || reduction_type.is_signed_long_long_int())
+                        {
+                            return true;
+                        }
+                        else if(reduction_type.is_float())
+                        {
+                            return true;
+                        }
+                        else if (reduction_type.is_double())
+                        {
+                            return true;
+                        }
+                    }
+                }
                 else if (_environment._vec_isa_desc.get_id().compare("romol")
                          == 0)
                 {
@@ -597,6 +597,92 @@ namespace Vectorization
         n.replace(vector_cond);
     }
 
+    // Lane l of field k is element (S * l + k) of the S contiguous registers
+    // loaded by the group
+    bool VectorizerVisitorExpression::vectorize_interleaved_read(
+            const Nodecl::NodeclBase& n)
+    {
+        map_nodecl_interleaved_t::const_iterator it =
+            _environment._interleaved_accesses.find(n);
+
+        if (it == _environment._interleaved_accesses.end()
+                || it->second._is_store)
+            return false;
+
+        const InterleavedAccess& interleaved_access = it->second;
+
+        VECTORIZATION_DEBUG()
+        {
+            fprintf(stderr, "VECTORIZER: Interleaved load (field %d of %d) '%s'\n",
+                    interleaved_access._field, interleaved_access._stride,
+                    n.prettyprint().c_str());
+        }
+
+        Nodecl::List sources;
+        for (objlist_tlsym_t::const_iterator reg = interleaved_access._registers.begin();
+                reg != interleaved_access._registers.end();
+                reg++)
+        {
+            sources.append(reg->make_nodecl(true, n.get_locus()));
+        }
+
+        Nodecl::List indexes;
+        for (unsigned int l = 0; l < _environment._vec_factor; l++)
+        {
+            indexes.append(const_value_to_nodecl(const_value_get_signed_int(
+                            interleaved_access._stride * l
+                            + interleaved_access._field)));
+        }
+
+        n.replace(Nodecl::VectorShuffle::make(
+                    sources,
+                    indexes,
+                    Utils::get_qualified_vector_to(n.get_type().no_ref(),
+                        _environment._vec_factor),
+                    n.get_locus()));
+
+        return true;
+    }
+
+    // The value is kept in the register of its field. The group is stored
+    // once all the fields have been computed
+    bool VectorizerVisitorExpression::vectorize_interleaved_write(
+            const Nodecl::Assignment& n)
+    {
+        Nodecl::NodeclBase lhs = n.get_lhs().no_conv();
+        Nodecl::NodeclBase rhs = n.get_rhs();
+
+        map_nodecl_interleaved_t::const_iterator it =
+            _environment._interleaved_accesses.find(lhs);
+
+        if (it == _environment._interleaved_accesses.end()
+                || !it->second._is_store)
+            return false;
+
+        const InterleavedAccess& interleaved_access = it->second;
+
+        VECTORIZATION_DEBUG()
+        {
+            fprintf(stderr, "VECTORIZER: Interleaved store (field %d of %d) '%s'\n",
+                    interleaved_access._field, interleaved_access._stride,
+                    lhs.prettyprint().c_str());
+        }
+
+        walk(rhs);
+
+        n.replace(Nodecl::VectorAssignment::make(
+                    interleaved_access._registers[interleaved_access._field].
+                        make_nodecl(true, n.get_locus()),
+                    n.get_rhs().shallow_copy(),
+                    Utils::get_proper_mask(_environment._mask_list.back()),
+                    Nodecl::NodeclBase::null(), // HasBeenDefinedFlag
+                    Utils::get_qualified_vector_to(n.get_type().no_ref(),
+                        _environment._vec_factor),
+                    n.get_locus()));
+
+        return true;
+    }
+
     Nodecl::NodeclBase VectorizerVisitorExpression::get_memory_vector_read(const Nodecl::NodeclBase& n)
     {
         Nodecl::NodeclBase mask = Utils::get_proper_mask(
@@ -761,6 +847,16 @@ namespace Vectorization
                 }
             }
 
+            if (_environment._speculative_loads)
+            {
+                load_flags.append(Nodecl::SpeculativeFlag::make());
+
+                VECTORIZATION_DEBUG()
+                {
+                    fprintf(stderr, " (speculative)");
+                }
+            }
+
             VECTORIZATION_DEBUG()
             {
                 fprintf(stderr, "\n");
@@ -1049,18 +1145,11 @@ namespace Vectorization
 
                 Nodecl::List nontemporal_flags = Nodecl::List::make(nontemporal_it->second);
 
-                for (auto tflag : nontemporal_flags)
-                {
-                    std::cerr << "--> " << tflag.prettyprint() << std::endl;
-                }
-                
                 bool relaxed = !nontemporal_flags.find_first<Nodecl::RelaxedFlag>().is_null();
                 bool evict = !nontemporal_flags.find_first<Nodecl::EvictFlag>().is_null();
                 
                 if (relaxed) 
                 {
-                    fprintf(stderr, "RELAXED\n");
-
                     VECTORIZATION_DEBUG()
                     {
                         fprintf(stderr, " (relaxed)");
@@ -1114,6 +1203,9 @@ namespace Vectorization
 
     void VectorizerVisitorExpression::visit(const Nodecl::Assignment& n)
     {
+        if (vectorize_interleaved_write(n))
+            return;
+
         TL::Type assignment_type = n.get_type().no_ref();
         Nodecl::NodeclBase lhs = n.get_lhs();
         Nodecl::NodeclBase rhs = n.get_rhs();
@@ -1531,6 +1623,9 @@ namespace Vectorization
 
     void VectorizerVisitorExpression::visit(const Nodecl::ArraySubscript& n)
     {
+        if (vectorize_interleaved_read(n))
+            return;
+
         Nodecl::NodeclBase mask = Utils::get_proper_mask(
                 _environment._mask_list.back());
 
@@ -1693,12 +1788,44 @@ namespace Vectorization
         // Get list of params;
         TL::Type function_target_type = call_type.no_ref();
 
+        // ISAs without masking support emulate masks: the unmasked version
+        // is called and the inactive lanes are discarded afterwards
+        bool masked_call = !mask.is_null()
+            && _environment._vec_isa_desc.support_masking();
+
+        // Vector math libraries do not always provide masked variants
+        // (libmvec never does). Their unmasked variants have no side
+        // effects, so they are called on all the lanes and the inactive
+        // ones are merged by the enclosing assignment
+        if (masked_call
+                && !vec_func_versioning.has_version(func_name,
+                    _environment._vec_isa_desc.get_id(),
+                    _environment._vec_factor,
+                    /* masked */ true)
+                && vec_func_versioning.has_version(func_name,
+                    _environment._vec_isa_desc.get_id(),
+                    _environment._vec_factor,
+                    /* masked */ false))
+        {
+            const Nodecl::NodeclBase unmasked_version =
+                vec_func_versioning.get_best_version(func_name,
+                        _environment._vec_isa_desc.get_id(),
+                        _environment._vec_factor,
+                        /* masked */ false);
+
+            if (std::find(vec_math_library_funcs.begin(),
+                        vec_math_library_funcs.end(),
+                        unmasked_version.get_symbol())
+                    != vec_math_library_funcs.end())
+                masked_call = false;
+        }
+
         // Get the best vector version of the function available
         Nodecl::NodeclBase best_version = vec_func_versioning.get_best_version(
             func_name,
             _environment._vec_isa_desc.get_id(),
             _environment._vec_factor,
-            !mask.is_null());
+            masked_call);
 
         bool is_svml = false;
         if (!best_version.is_null())
@@ -1928,16 +2055,31 @@ namespace Vectorization
 
                 Nodecl::List arguments = n.get_arguments().as<Nodecl::List>();
 
-                if (!mask.is_null())
+                if (masked_call)
                 {
-                    arguments.append(mask.shallow_copy());
                     if (is_svml)
                     {
                         VECTORIZATION_DEBUG()
                         {
                             std::cerr << "SPECIAL CASE FOR SVML"  << new_called.prettyprint() << std::endl;
                         }
-                        arguments.append(arguments[0].shallow_copy());
+
+                        // SVML masked variants: (src, mask, arguments...)
+                        // Inactive lanes take the value of the first argument
+                        Nodecl::List svml_arguments;
+                        svml_arguments.append(arguments[0].shallow_copy());
+                        svml_arguments.append(mask.shallow_copy());
+                        for (Nodecl::List::iterator it = arguments.begin();
+                                it != arguments.end();
+                                it++)
+                        {
+                            svml_arguments.append(it->shallow_copy());
+                        }
+                        arguments = svml_arguments;
+                    }
+                    else
+                    {
+                        arguments.append(mask.shallow_copy());
                     }
                 }
 
@@ -2149,6 +2291,9 @@ namespace Vectorization
 
     void VectorizerVisitorExpression::visit(const Nodecl::ClassMemberAccess& n)
     {
+        if (vectorize_interleaved_read(n))
+            return;
+
         Nodecl::NodeclBase n_original = n.shallow_copy();
         Nodecl::NodeclBase class_object = n.get_lhs();
         Nodecl::NodeclBase member = n.get_member();
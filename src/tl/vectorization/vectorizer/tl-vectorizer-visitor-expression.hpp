@@ -54,6 +54,8 @@ namespace TL
                         const Nodecl::NodeclBase& mask,
                         const TL::Type type);
                 void vectorize_regular_class_member_access(const Nodecl::ClassMemberAccess &n);
+                bool vectorize_interleaved_read(const Nodecl::NodeclBase& n);
+                bool vectorize_interleaved_write(const Nodecl::Assignment& n);
 
             public:
                 VectorizerVisitorExpression(
@@ -33,6 +33,7 @@
 #include "tl-vectorizer-visitor-local-symbol.hpp"
 #include "tl-vectorizer-visitor-statement.hpp"
 #include "tl-vectorizer-visitor-expression.hpp"
+#include "tl-vectorizer-interleaved-accesses.hpp"
 
 #include "cxx-cexpr.h"
 #include "tl-nodecl-utils.hpp"
@@ -49,6 +50,10 @@ namespace Vectorization
 
     void VectorizerVisitorLoop::visit(const Nodecl::ForStatement& for_statement)
     {
+        // Group strided accesses before the loop is modified
+        VectorizerInterleavedAccesses interleaved_accesses(_environment);
+        interleaved_accesses.plan(for_statement);
+
         // Vectorize Local Symbols
         VectorizerVisitorLocalSymbol visitor_local_symbol(_environment);
         visitor_local_symbol.walk(for_statement);
@@ -57,9 +62,19 @@ namespace Vectorization
         VectorizerVisitorLoopHeader visitor_loop_header(_environment);
         visitor_loop_header.walk(for_statement.get_loop_header().as<Nodecl::LoopControl>());
 
+        // Loads before the early exit may read past the exiting lane.
+        // They become first-faulting loads if the ISA has them
+        _environment._speculative_loads = !_environment._early_exit.is_null()
+            && _environment._vec_isa_desc.support_first_faulting_loads();
+
         // LOOP BODY
         VectorizerVisitorStatement visitor_stmt(_environment);
         visitor_stmt.walk(for_statement.get_statement());
+
+        _environment._speculative_loads = false;
+
+        // Emit the contiguous loads and stores of the groups
+        interleaved_accesses.finalize();
     }
 
     void VectorizerVisitorLoop::visit(const Nodecl::WhileStatement& while_statement)
@@ -72,9 +87,34 @@ namespace Vectorization
         VectorizerVisitorLoopCond visitor_loop_cond(_environment);
         visitor_loop_cond.walk(while_statement.get_condition());
 
+        _environment._speculative_loads = !_environment._early_exit.is_null()
+            && _environment._vec_isa_desc.support_first_faulting_loads();
+
         // LOOP BODY
         VectorizerVisitorStatement visitor_stmt(_environment);
         visitor_stmt.walk(while_statement.get_statement());
+
+        _environment._speculative_loads = false;
+    }
+
+    void VectorizerVisitorLoop::visit(const Nodecl::DoStatement& do_statement)
+    {
+        // Vectorize Local Symbols
+        VectorizerVisitorLocalSymbol visitor_local_symbol(_environment);
+        visitor_local_symbol.walk(do_statement);
+
+        _environment._speculative_loads = !_environment._early_exit.is_null()
+            && _environment._vec_isa_desc.support_first_faulting_loads();
+
+        // LOOP BODY
+        VectorizerVisitorStatement visitor_stmt(_environment);
+        visitor_stmt.walk(do_statement.get_statement());
+
+        _environment._speculative_loads = false;
+
+        // Vectorize Loop Condition
+        VectorizerVisitorLoopCond visitor_loop_cond(_environment);
+        visitor_loop_cond.walk(do_statement.get_condition());
     }
 
 
@@ -354,7 +394,10 @@ namespace Vectorization
             const Nodecl::NodeclBase& loop_statement,
             Nodecl::NodeclBase& net_epilog_node)
     {
-        if (_environment._vec_isa_desc.support_masking()) // Vector epilog
+        // Early exits need a scalar epilog that finds the exiting
+        // iteration
+        if (_environment._vec_isa_desc.support_masking()
+                && _environment._early_exit.is_null()) // Vector epilog
         {
             Nodecl::NodeclBase loop_cond_copy;
 
@@ -732,6 +775,18 @@ namespace Vectorization
             const Nodecl::NodeclBase& loop_statement,
             Nodecl::NodeclBase& net_epilog_node)
     {
+        // While and do loops have no init: the scalar epilog continues
+        // from the state left by the main loop
+        if (!loop_statement.is<Nodecl::ForStatement>())
+        {
+            ERROR_CONDITION(_is_parallel_loop || _only_epilog,
+                    "Vectorizer: Epilog of a parallel or epilog-only %s is not supported",
+                    ast_print_node_type(loop_statement.get_kind()));
+
+            net_epilog_node = loop_statement;
+            return;
+        }
+
         // Set new IV init
         Nodecl::NodeclBase new_iv_init;
         Nodecl::NodeclBase iv;
@@ -46,6 +46,7 @@ namespace Vectorization
 
             virtual void visit(const Nodecl::ForStatement& for_statement);
             virtual void visit(const Nodecl::WhileStatement& while_statement);
+            virtual void visit(const Nodecl::DoStatement& do_statement);
  
             Nodecl::NodeclVisitor<void>::Ret unhandled_node(const Nodecl::NodeclBase& n);
     };
@@ -165,7 +165,7 @@ namespace Vectorization
             epilog_condition.replace(epilog_new_condition);
 
             //
-            // Main loop condition: while((mask == 0xFFFF) != 0) do
+            // Main loop condition: while((mask == all lanes) != 0) do
             //
             Nodecl::NodeclBase main_loop_precondition = 
                 Vectorizer::_vectorizer_analysis->
@@ -179,19 +179,42 @@ namespace Vectorization
             // Vectorize loop precondition
             visitor_expression.walk(main_loop_precondition);
 
+            // Lanes disabled in the enclosing code (i.e., the masked
+            // epilog of the SIMD loop or an 'if') never enter the loop:
+            // mask = prev_mask & cond
+            Nodecl::NodeclBase prev_mask = _environment._mask_list.back();
+            Nodecl::NodeclBase main_loop_precondition_mask =
+                main_loop_precondition;
+
+            if (!Utils::is_all_one_mask(prev_mask))
+            {
+                main_loop_precondition_mask = Nodecl::VectorMaskAnd::make(
+                        prev_mask.shallow_copy(),
+                        main_loop_precondition,
+                        mask_condition_symbol.get_type().no_ref(),
+                        n.get_locus());
+            }
+
             // Loop precondition statement
             Nodecl::ExpressionStatement main_loop_precond_stmt =
                 Nodecl::ExpressionStatement::make(
                         Nodecl::VectorMaskAssignment::make(
                             mask_condition_symbol.shallow_copy(),
-                            main_loop_precondition,
+                            main_loop_precondition_mask,
                             mask_condition_symbol.get_type()));
 
-            // New loop condition expression
+            // New loop condition expression. All the lanes are active
+            // when the mask has its _vec_factor bits set
+            const unsigned int vec_factor = _environment._vec_factor;
+            const cvalue_uint_t all_lanes_mask = (vec_factor >= 64) ?
+                ~(cvalue_uint_t)0 : (((cvalue_uint_t)1 << vec_factor) - 1);
+
             Nodecl::Equal new_main_loop_condition =
                 Nodecl::Equal::make(
                         mask_condition_symbol.shallow_copy(),
-                        const_value_to_nodecl(const_value_get_unsigned_int(0xFFFF)),
+                        const_value_to_nodecl((vec_factor > 32) ?
+                            const_value_get_unsigned_long_long_int(all_lanes_mask) :
+                            const_value_get_unsigned_int(all_lanes_mask)),
                         Type::get_bool_type());
 
             main_loop_control.get_cond().replace(new_main_loop_condition);
@@ -237,12 +260,21 @@ namespace Vectorization
             // Vectorize loop precondition
             visitor_expression.walk(epilog_loop_postcondition);
 
+            // Lanes that have left the loop never come back, even if
+            // the condition becomes true again (comparisons are not
+            // masked on every ISA): mask = mask & cond
+            Nodecl::VectorMaskAnd epilog_loop_postcondition_mask =
+                Nodecl::VectorMaskAnd::make(
+                        mask_condition_symbol.shallow_copy(),
+                        epilog_loop_postcondition,
+                        mask_condition_symbol.get_type().no_ref(),
+                        n.get_locus());
 
             // Loop postcondition statement
             Nodecl::VectorMaskAssignment epilog_loop_postcond_assig =
                 Nodecl::VectorMaskAssignment::make(
                         mask_condition_symbol.shallow_copy(),
-                        epilog_loop_postcondition,
+                        epilog_loop_postcondition_mask,
                         mask_condition_symbol.get_type());
 
             Nodecl::NodeclBase epilog_old_next_copy =
@@ -335,6 +367,12 @@ namespace Vectorization
     {
         Nodecl::NodeclBase condition = n.get_condition();
 
+        if (n == _environment._early_exit)
+        {
+            visit_early_exit(n);
+            return;
+        }
+
         // Non-constant comparison. Vectorize them with masks
         if(!(condition.is_constant() ||
                 Vectorizer::_vectorizer_analysis->is_uniform(
@@ -629,6 +667,67 @@ namespace Vectorization
         }
     }
 
+    // if (cond) { ...; break; } -> if (cond_mask != 0) break;
+    // Then statements are executed by the scalar epilog, which
+    // resumes the vector iteration that has left the loop
+    void VectorizerVisitorStatement::visit_early_exit(
+            const Nodecl::IfElseStatement& n)
+    {
+        Nodecl::NodeclBase condition = n.get_condition();
+        Nodecl::NodeclBase prev_mask = _environment._mask_list.back();
+        Nodecl::List list;
+
+        VectorizerVisitorExpression visitor_expression(_environment);
+        visitor_expression.walk(condition);
+
+        // Loads after the exit are not speculative
+        _environment._speculative_loads = false;
+
+        Nodecl::NodeclBase exit_mask_symbol =
+            Utils::get_new_mask_symbol(_environment._analysis_simd_scope,
+                    _environment._vec_factor,
+                    true /*ref_type*/);
+
+        // Mask value
+        Nodecl::NodeclBase exit_mask_value;
+        if (Utils::is_all_one_mask(prev_mask)) // mask = exit_cond
+        {
+            exit_mask_value = condition.shallow_copy();
+        }
+        else // mask = prev_mask & exit_cond
+        {
+            exit_mask_value = Nodecl::VectorMaskAnd::make(
+                    prev_mask.shallow_copy(),
+                    condition.shallow_copy(),
+                    prev_mask.get_type().no_ref(),
+                    n.get_locus());
+        }
+
+        CXX_LANGUAGE()
+        {
+            list.append(
+                    Nodecl::CxxDef::make(
+                        Nodecl::NodeclBase::null(),
+                        exit_mask_symbol.get_symbol(),
+                        exit_mask_symbol.get_locus()));
+        }
+        list.append(Nodecl::ExpressionStatement::make(
+                    Nodecl::VectorMaskAssignment::make(
+                        exit_mask_symbol.shallow_copy(),
+                        exit_mask_value,
+                        exit_mask_symbol.get_type(),
+                        n.get_locus())));
+
+        list.append(Utils::get_if_mask_is_not_zero_nodecl(
+                    exit_mask_symbol.shallow_copy(),
+                    Nodecl::List::make(Nodecl::BreakStatement::make(
+                            Nodecl::NodeclBase::null(),
+                            n.get_locus()))));
+
+        n.replace(Nodecl::CompoundStatement::make(list,
+                    Nodecl::NodeclBase::null(), n.get_locus()));
+    }
+
     void VectorizerVisitorStatement::visit(const Nodecl::ExpressionStatement& n)
     {
         VectorizerVisitorExpression visitor_expression(_environment);
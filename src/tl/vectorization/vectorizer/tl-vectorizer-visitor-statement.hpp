@@ -39,6 +39,8 @@ namespace TL
             private:
                 VectorizerEnvironment& _environment;
 
+                void visit_early_exit(const Nodecl::IfElseStatement& n);
+
             public:
                 VectorizerVisitorStatement(
                         VectorizerEnvironment& environment);
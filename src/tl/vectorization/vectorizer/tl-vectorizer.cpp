@@ -36,6 +36,8 @@
 #include "tl-vectorizer-vector-reduction.hpp"
 #include "tl-vectorization-utils.hpp"
 #include "tl-vectorizer-report.hpp"
+#include "tl-vectorizer-cost-model.hpp"
+#include "tl-vectorizer-nontemporal-stores.hpp"
 
 #include "tl-optimizations.hpp"
 
@@ -51,6 +53,8 @@ namespace Vectorization
     VectorizationAnalysisInterface *Vectorizer::_vectorizer_analysis = 0;
     bool Vectorizer::_gathers_scatters_disabled(false);
     bool Vectorizer::_unaligned_accesses_disabled(false);
+    bool Vectorizer::_cost_model_enabled(false);
+    unsigned long long int Vectorizer::_nontemporal_threshold(0);
     TL::Symbol Vectorizer::_analysis_func;
 
 
@@ -89,9 +93,15 @@ namespace Vectorization
             if (_vectorizer_analysis != NULL)
                 delete _vectorizer_analysis;
 
+            // The cost model bounds trip counts with the ranges of the IVs
+            TL::Analysis::WhichAnalysis analysis_mask =
+                TL::Analysis::WhichAnalysis::INDUCTION_VARS_ANALYSIS;
+            if (_cost_model_enabled)
+                analysis_mask = analysis_mask |
+                    TL::Analysis::WhichAnalysis::RANGE_ANALYSIS;
+
             _vectorizer_analysis = new VectorizationAnalysisInterface(
-                    enclosing_function,
-                    TL::Analysis::WhichAnalysis::INDUCTION_VARS_ANALYSIS);
+                    enclosing_function, analysis_mask);
         }
         else
         {
@@ -108,7 +118,8 @@ namespace Vectorization
 
     Vectorizer::Vectorizer() :
         _svml_sse_enabled(false), _svml_avx2_enabled(false), _svml_knc_enabled(false),
-        _fast_math_enabled(false)
+        _svml_knl_enabled(false), _svml_avx512_enabled(false), _svml_avx512vl_enabled(false),
+        _fast_math_enabled(false), _math_accuracy(MEDIUM_MATH_ACCURACY)
     {
     }
 
@@ -166,6 +177,17 @@ namespace Vectorization
             VectorizerVisitorLoop visitor_for(environment);
             visitor_for.walk(loop_statement.as<Nodecl::ForStatement>());
         }
+        else if (loop_statement.is<Nodecl::DoStatement>())
+        {
+            VECTORIZATION_DEBUG()
+            {
+                fprintf(stderr, "VECTORIZER: ----- Vectorizing main DoStatement -----\n");
+                fprintf(stderr, "Vectorization factor: %d\n", environment._vec_factor);
+            }
+
+            VectorizerVisitorLoop visitor_do(environment);
+            visitor_do.walk(loop_statement.as<Nodecl::DoStatement>());
+        }
 
         // Applying strenth reduction
         TL::Optimizations::canonicalize_and_fold(
@@ -305,9 +327,11 @@ namespace Vectorization
             bool only_epilog,
             bool is_parallel_loop)
     {
-        // Clean up vector epilog
-        if (environment._vec_isa_desc.support_masking()
-                || epilog_iterations == 1)
+        // Clean up vector epilog. After an early exit the epilog
+        // can run up to vec_factor iterations
+        if ((environment._vec_isa_desc.support_masking()
+                    || epilog_iterations == 1)
+                && environment._early_exit.is_null())
         {
             VECTORIZATION_DEBUG()
             {
@@ -345,6 +369,63 @@ namespace Vectorization
         return loop_info.get_epilog_info(only_epilog);
     }
 
+    Nodecl::NodeclBase Vectorizer::get_early_exit(
+            const Nodecl::NodeclBase& loop_statement,
+            VectorizerEnvironment& environment)
+    {
+        VectorizerLoopInfo loop_info(loop_statement, environment);
+
+        return loop_info.get_early_exit();
+    }
+
+    bool Vectorizer::early_exit_may_fault(
+            const Nodecl::NodeclBase& loop_statement,
+            VectorizerEnvironment& environment)
+    {
+        VectorizerLoopInfo loop_info(loop_statement, environment);
+
+        return loop_info.early_exit_may_fault();
+    }
+
+    bool Vectorizer::should_vectorize_loop(
+            const Nodecl::NodeclBase& loop_statement,
+            const VectorizerEnvironment& environment)
+    {
+        bool verbose = false;
+        VECTORIZATION_DEBUG()
+        {
+            verbose = true;
+        }
+
+        // Without the cost model, the decision is only reported in
+        // verbose mode
+        if (!_cost_model_enabled && !verbose)
+            return true;
+
+        VectorizerCostModel cost_model(environment);
+        bool profitable = cost_model.is_profitable(loop_statement);
+
+        VectorizerReport report;
+        report.print_cost_report(loop_statement, environment,
+                cost_model, profitable);
+
+        return profitable || !_cost_model_enabled;
+    }
+
+    void Vectorizer::select_nontemporal_stores(
+            const Nodecl::NodeclBase& loop_statement,
+            const VectorizerEnvironment& environment,
+            map_tlsym_objlist_t& nontemporal_exprs)
+    {
+        // Disabled
+        if (_nontemporal_threshold == 0)
+            return;
+
+        VectorizerNontemporalStores nontemporal_stores(environment,
+                _nontemporal_threshold);
+        nontemporal_stores.select(loop_statement, nontemporal_exprs);
+    }
+
     void Vectorizer::vectorize_reduction(const TL::Symbol& scalar_symbol,
             TL::Symbol& vector_symbol,
             const Nodecl::NodeclBase& initializer,
@@ -440,18 +521,10 @@ namespace Vectorization
             // SVML SSE
             TL::Source svml_sse_vector_math;
 
-            svml_sse_vector_math << "__m128 _mm_exp_ps(__m128);\n"
-                << "__m128 _mm_sqrt_ps(__m128);\n"
-                << "__m128 _mm_log_ps(__m128);\n"
-                << "__m128 _mm_sin_ps(__m128);\n"
-                << "__m128 _mm_cos_ps(__m128);\n"
+            svml_sse_vector_math << "__m128 _mm_sqrt_ps(__m128);\n"
                 << "__m128 _mm_sincos_ps(__m128*, __m128);\n"
                 << "__m128 _mm_floor_ps(__m128);\n"
-                << "__m128d _mm_exp_pd(__m128d);\n"
                 << "__m128d _mm_sqrt_pd(__m128d);\n"
-                << "__m128d _mm_log_pd(__m128d);\n"
-                << "__m128d _mm_sin_pd(__m128d);\n"
-                << "__m128d _mm_cos_pd(__m128d);\n"
                 << "__m128d _mm_sincos_pd(__m128d*, __m128d);\n"
                 << "__m128d _mm_floor_pd(__m128d);\n"
                 ;
@@ -460,25 +533,30 @@ namespace Vectorization
             TL::Scope global_scope = TL::Scope::get_global_scope();
             svml_sse_vector_math.parse_global(global_scope);
 
-            register_functions_info sse_functions[] =
+            register_functions_info sse_float_functions[] =
             {
-                { "expf", "_mm_exp_ps"  ,   TL::Type::get_float_type(), false },
                 { "sqrtf", "_mm_sqrt_ps",   TL::Type::get_float_type(), false },
-                { "logf", "_mm_log_ps"  ,   TL::Type::get_float_type(), false },
-                { "sinf", "_mm_sin_ps"  ,   TL::Type::get_float_type(), false },
                 // {"sincosf", "_mm_sincos_ps" , TL::Type::get_float_type(), false },
                 { "floorf", "_mm_floor_ps", TL::Type::get_float_type(), false },
-                { "exp", "_mm_exp_pd"     , TL::Type::get_double_type(), false },
+                /* last item */
+                { NULL, NULL, TL::Type::get_void_type(), false }
+            };
+
+            register_functions_info sse_double_functions[] =
+            {
                 { "sqrt", "_mm_sqrt_pd"   , TL::Type::get_double_type(), false },
-                { "log", "_mm_log_pd"     , TL::Type::get_double_type(), false },
-                { "sin", "_mm_sin_pd"     , TL::Type::get_double_type(), false },
                 // { "sincos", "_mm_sincos_pd", TL::Type::get_double_type(), false },
                 {"floor", "_mm_floor_pd"  , TL::Type::get_double_type(), false },
                 /* last item */
                 { NULL, NULL, TL::Type::get_void_type(), false }
             };
 
-            register_svml_functions(sse_functions, "smp", 4, global_scope, "__m128");
+            register_svml_functions(sse_float_functions, "smp", 4, global_scope, "__m128");
+            register_svml_functions(sse_double_functions, "smp", 2, global_scope, "__m128");
+
+            // sin, cos, exp, log and pow
+            VectorizerMathLibrary(SVML_MATH_LIBRARY, _math_accuracy).
+                register_functions("smp");
         }
     }
 
@@ -492,51 +570,49 @@ namespace Vectorization
         if (!_svml_avx2_enabled)
         {
             _svml_avx2_enabled = true;
+            enable_svml_common_avx2("avx2");
+        }
+    }
 
-            // SVML AVX2
-            TL::Source svml_avx2_vector_math;
-
-            svml_avx2_vector_math << "__m256 _mm256_exp_ps(__m256);\n"
-                << "__m256 _mm256_sqrt_ps(__m256);\n"
-                << "__m256 _mm256_log_ps(__m256);\n"
-                << "__m256 _mm256_sin_ps(__m256);\n"
-                << "__m256 _mm256_cos_ps(__m256);\n"
-                << "__m256 _mm256_sincos_ps(__m256*, __m256);\n"
-                << "__m256 _mm256_floor_ps(__m256);\n"
-                << "__m256d _mm256_exp_pd(__m256d);\n"
-                << "__m256d _mm256_sqrt_pd(__m256d);\n"
-                << "__m256d _mm256_log_pd(__m256d);\n"
-                << "__m256d _mm256_sin_pd(__m256d);\n"
-                << "__m256d _mm256_cos_pd(__m256d);\n"
-                << "__m256d _mm256_sincos_pd(__m256d*, __m256d);\n"
-                << "__m256d _mm256_floor_pd(__m256d);\n"
-                ;
+    void Vectorizer::enable_svml_common_avx2(std::string device)
+    {
+        // SVML AVX2
+        TL::Source svml_avx2_vector_math;
+
+        svml_avx2_vector_math << "__m256 _mm256_sqrt_ps(__m256);\n"
+            << "__m256 _mm256_sincos_ps(__m256*, __m256);\n"
+            << "__m256 _mm256_floor_ps(__m256);\n"
+            << "__m256d _mm256_sqrt_pd(__m256d);\n"
+            << "__m256d _mm256_sincos_pd(__m256d*, __m256d);\n"
+            << "__m256d _mm256_floor_pd(__m256d);\n"
+            ;
 
-            // Parse SVML declarations
-            TL::Scope global_scope = TL::Scope::get_global_scope();
-            svml_avx2_vector_math.parse_global(global_scope);
+        // Parse SVML declarations
+        TL::Scope global_scope = TL::Scope::get_global_scope();
+        svml_avx2_vector_math.parse_global(global_scope);
 
-            register_functions_info avx2_functions[] =
-            {
-                { "expf",    "_mm256_exp_ps",    TL::Type::get_float_type(), false }, 
-                { "sqrtf",   "_mm256_sqrt_ps",   TL::Type::get_float_type(), false }, 
-                { "logf",    "_mm256_log_ps",    TL::Type::get_float_type(), false }, 
-                { "sinf",    "_mm256_sin_ps",    TL::Type::get_float_type(), false }, 
-                { "cosf",    "_mm256_cos_ps",    TL::Type::get_float_type(), false }, 
-                //{ "sincosf", "_mm256_sincos_ps", TL::Type::get_float_type(), false },
-                { "floorf",  "_mm256_floor_ps",  TL::Type::get_float_type(), false },
-                { "exp",     "_mm256_exp_pd",    TL::Type::get_double_type(), false },  
-                { "sqrt",    "_mm256_sqrt_pd",   TL::Type::get_double_type(), false }, 
-                { "log",     "_mm256_log_pd",    TL::Type::get_double_type(), false }, 
-                { "sin",     "_mm256_sin_pd",    TL::Type::get_double_type(), false }, 
-                { "cos",     "_mm256_cos_pd",    TL::Type::get_double_type(), false }, 
-                //{ "sincos",  "_mm256_sincos_pd", TL::Type::get_double_type(), false }, 
-                { "floor",   "_mm256_floor_pd",  TL::Type::get_double_type(), false },
-                { NULL, NULL, TL::Type::get_void_type(), false }
-            };
+        register_functions_info avx2_float_functions[] =
+        {
+            { "sqrtf",   "_mm256_sqrt_ps",   TL::Type::get_float_type(), false }, 
+            //{ "sincosf", "_mm256_sincos_ps", TL::Type::get_float_type(), false },
+            { "floorf",  "_mm256_floor_ps",  TL::Type::get_float_type(), false },
+            { NULL, NULL, TL::Type::get_void_type(), false }
+        };
 
-            register_svml_functions(avx2_functions, "avx2", 8, global_scope, "__m256");
-        }
+        register_functions_info avx2_double_functions[] =
+        {
+            { "sqrt",    "_mm256_sqrt_pd",   TL::Type::get_double_type(), false }, 
+            //{ "sincos",  "_mm256_sincos_pd", TL::Type::get_double_type(), false }, 
+            { "floor",   "_mm256_floor_pd",  TL::Type::get_double_type(), false },
+            { NULL, NULL, TL::Type::get_void_type(), false }
+        };
+
+        register_svml_functions(avx2_float_functions, device, 8, global_scope, "__m256");
+        register_svml_functions(avx2_double_functions, device, 4, global_scope, "__m256");
+
+        // sin, cos, exp, log and pow
+        VectorizerMathLibrary(SVML_MATH_LIBRARY, _math_accuracy).
+            register_functions(device);
     }
 
     void Vectorizer::enable_svml_common_avx512(std::string device)
@@ -545,35 +621,19 @@ namespace Vectorization
         TL::Source svml_avx512_vector_math;
 
         // No mask
-        svml_avx512_vector_math << "__m512 _mm512_exp_ps(__m512);\n"
-            << "__m512 _mm512_sqrt_ps(__m512);\n"
-            << "__m512 _mm512_log_ps(__m512);\n"
-            << "__m512 _mm512_sin_ps(__m512);\n"
-            << "__m512 _mm512_cos_ps(__m512);\n"
+        svml_avx512_vector_math << "__m512 _mm512_sqrt_ps(__m512);\n"
             //<< "__m512 _mm512_sincos_ps(__m512*, __m512);\n"
             << "__m512 _mm512_floor_ps(__m512);\n"
-            << "__m512d _mm512_exp_pd(__m512d);\n"
             << "__m512d _mm512_sqrt_pd(__m512d);\n"
-            << "__m512d _mm512_log_pd(__m512d);\n"
-            << "__m512d _mm512_sin_pd(__m512d);\n"
-            << "__m512d _mm512_cos_pd(__m512d);\n"
             //<< "__m512d _mm512_sincos_pd(__m512d*, __m512d);\n"
             << "__m512d _mm512_floor_pd(__m512d);\n"
             ;
 
         // Mask
-        svml_avx512_vector_math << "__m512 _mm512_mask_exp_ps(__m512, __mmask16, __m512);\n"
-            << "__m512 _mm512_mask_sqrt_ps(__m512, __mmask16, __m512);\n"
-            << "__m512 _mm512_mask_log_ps(__m512, __mmask16, __m512);\n"
-            << "__m512 _mm512_mask_sin_ps(__m512, __mmask16, __m512);\n"
-            << "__m512 _mm512_mask_cos_ps(__m512, __mmask16, __m512);\n"
+        svml_avx512_vector_math << "__m512 _mm512_mask_sqrt_ps(__m512, __mmask16, __m512);\n"
             //<< "__m512 _mm512_mask_sincos_ps(__m512*, __m512, __m512, __mmask16, __m512);\n"
             << "__m512 _mm512_mask_floor_ps(__m512, __mmask16, __m512);\n"
-            << "__m512d _mm512_mask_exp_pd(__m512d, __mmask8, __m512d);\n"
             << "__m512d _mm512_mask_sqrt_pd(__m512d, __mmask8, __m512d);\n"
-            << "__m512d _mm512_mask_log_pd(__m512d, __mmask8, __m512d);\n"
-            << "__m512d _mm512_mask_sin_pd(__m512d, __mmask8, __m512d);\n"
-            << "__m512d _mm512_mask_cos_pd(__m512d, __mmask8, __m512d);\n"
             //<< "__m512d _mm512_mask_sincos_pd(__m512d*, __m512d, __m512d, __mmask8, __m512d);\n"
             << "__m512d _mm512_mask_floor_pd(__m512d, __mmask8, __m512d);\n"
             ;
@@ -582,46 +642,42 @@ namespace Vectorization
         TL::Scope global_scope = TL::Scope::get_global_scope();
         svml_avx512_vector_math.parse_global(global_scope);
 
-        register_functions_info avx512_functions[] =
+        register_functions_info avx512_float_functions[] =
         {
-            { "expf", "_mm512_exp_ps", TL::Type::get_float_type(), false },
             { "sqrtf", "_mm512_sqrt_ps", TL::Type::get_float_type(), false },
-            { "logf", "_mm512_log_ps", TL::Type::get_float_type(), false },
-            { "sinf", "_mm512_sin_ps", TL::Type::get_float_type(), false },
-            { "cosf", "_mm512_cos_ps", TL::Type::get_float_type(), false },
             // It seems it doesn't exist in MIC
             //{ "sincosf", "_mm512_sincos_ps", TL::Type::get_void_type(), false },
-            { "floor", "_mm512_floor_pd", TL::Type::get_double_type(), false },
-            { "exp", "_mm512_exp_pd", TL::Type::get_double_type(), false },
-            { "sqrt", "_mm512_sqrt_pd", TL::Type::get_double_type(), false },
-            { "log", "_mm512_log_pd", TL::Type::get_double_type(), false },
-            { "sin", "_mm512_sin_pd", TL::Type::get_double_type(), false },
-            { "cos", "_mm512_cos_pd", TL::Type::get_double_type(), false },
-            //It seems it doesn't exist in MIC
-            //{ "sincos", "_mm512_sincos_pd", TL::Type::get_void_type(), false },
-            { "floor", "_mm512_floor_pd", TL::Type::get_double_type(), false },
+            { "floorf", "_mm512_floor_ps", TL::Type::get_float_type(), false },
 
             // Add SVML math masked function as vector version of the scalar one
-            { "expf", "_mm512_mask_exp_ps", TL::Type::get_float_type(), true },
             { "sqrtf", "_mm512_mask_sqrt_ps", TL::Type::get_float_type(), true },
-            { "logf", "_mm512_mask_log_ps", TL::Type::get_float_type(), true },
-            { "sinf", "_mm512_mask_sin_ps", TL::Type::get_float_type(), true },
-            { "cosf", "_mm512_mask_cos_ps", TL::Type::get_float_type(), true },
             // It seems it doesn't exist in MIC
             //{ "sincosf", "_mm512_mask_sincos_ps", TL::Type::get_float_type(), true },
             { "floorf", "_mm512_mask_floor_ps", TL::Type::get_float_type(), true },
-            { "exp", "_mm512_mask_exp_pd", TL::Type::get_double_type(), true },
+            { NULL, NULL, TL::Type::get_void_type(), false }
+        };
+
+        register_functions_info avx512_double_functions[] =
+        {
+            { "sqrt", "_mm512_sqrt_pd", TL::Type::get_double_type(), false },
+            //It seems it doesn't exist in MIC
+            //{ "sincos", "_mm512_sincos_pd", TL::Type::get_void_type(), false },
+            { "floor", "_mm512_floor_pd", TL::Type::get_double_type(), false },
+
+            // Add SVML math masked function as vector version of the scalar one
             { "sqrt", "_mm512_mask_sqrt_pd", TL::Type::get_double_type(), true },
-            { "log", "_mm512_mask_log_pd", TL::Type::get_double_type(), true },
-            { "sin", "_mm512_mask_sin_pd", TL::Type::get_double_type(), true },
-            { "cos", "_mm512_mask_cos_pd", TL::Type::get_double_type(), true },
             // It seems it doesn't exist in MIC
             //{ "sincos", "_mm512_mask_sincos_pd", TL::Type::get_double_type(), true },
             { "floor", "_mm512_mask_floor_pd", TL::Type::get_double_type(), true }, 
             { NULL, NULL, TL::Type::get_void_type(), false }
         };
 
-        register_svml_functions(avx512_functions, device, 16, global_scope, "__m512");
+        register_svml_functions(avx512_float_functions, device, 16, global_scope, "__m512");
+        register_svml_functions(avx512_double_functions, device, 8, global_scope, "__m512");
+
+        // sin, cos, exp, log and pow
+        VectorizerMathLibrary(SVML_MATH_LIBRARY, _math_accuracy).
+            register_functions(device);
     }
 
     void Vectorizer::enable_svml_knc()
@@ -652,6 +708,54 @@ namespace Vectorization
         }
     }
 
+    void Vectorizer::enable_svml_avx512()
+    {
+        VECTORIZATION_DEBUG()
+        {
+            fprintf(stderr, "Enabling SVML AVX-512\n");
+        }
+
+        if (!_svml_avx512_enabled)
+        {
+            _svml_avx512_enabled = true;
+            enable_svml_common_avx512("avx512");
+        }
+    }
+
+    void Vectorizer::enable_svml_avx512vl()
+    {
+        VECTORIZATION_DEBUG()
+        {
+            fprintf(stderr, "Enabling SVML AVX-512 (256-bit)\n");
+        }
+
+        // 256-bit vectors use the AVX2 entry points
+        if (!_svml_avx512vl_enabled)
+        {
+            _svml_avx512vl_enabled = true;
+            enable_svml_common_avx2("avx512vl");
+        }
+    }
+
+    void Vectorizer::enable_libmvec(const std::string& device)
+    {
+        VECTORIZATION_DEBUG()
+        {
+            fprintf(stderr, "Enabling libmvec for '%s'\n", device.c_str());
+        }
+
+        if (_libmvec_devices.insert(device).second)
+        {
+            VectorizerMathLibrary(LIBMVEC_MATH_LIBRARY, _math_accuracy).
+                register_functions(device);
+        }
+    }
+
+    void Vectorizer::set_math_accuracy(const VectorMathAccuracy accuracy)
+    {
+        _math_accuracy = accuracy;
+    }
+
     void Vectorizer::enable_fast_math()
     {
         _fast_math_enabled = true;
@@ -666,5 +770,28 @@ namespace Vectorization
     {
         _unaligned_accesses_disabled = true;
     }
+
+    void Vectorizer::enable_cost_model()
+    {
+        _cost_model_enabled = true;
+    }
+
+    void Vectorizer::set_nontemporal_threshold(
+            const unsigned long long int threshold)
+    {
+        _nontemporal_threshold = threshold;
+    }
+
+    void Vectorizer::add_isa_specific_function(const TL::Symbol& function,
+            VectorInstructionSet isa)
+    {
+        _isa_specific_functions[function] = isa;
+    }
+
+    const std::map<TL::Symbol, VectorInstructionSet>&
+        Vectorizer::get_isa_specific_functions() const
+    {
+        return _isa_specific_functions;
+    }
 }
 }
@@ -29,11 +29,15 @@
 
 #include <string>
 #include <list>
+#include <map>
+#include <set>
 
 #include "tl-nodecl-base.hpp"
 
 #include "tl-vectorization-analysis-interface.hpp"
 #include "tl-vectorizer-prefetcher.hpp"
+#include "tl-vectorizer-auto-prefetcher.hpp"
+#include "tl-vectorizer-math-library.hpp"
 #include "tl-vectorization-common.hpp"
 
 #include "tl-function-versioning.hpp"
@@ -60,14 +64,25 @@ namespace TL
                 static Vectorizer* _vectorizer;
                 static bool _gathers_scatters_disabled;
                 static bool _unaligned_accesses_disabled;
+                static bool _cost_model_enabled;
+                static unsigned long long int _nontemporal_threshold;
                 static TL::Symbol _analysis_func;
 
                 bool _svml_sse_enabled;
                 bool _svml_avx2_enabled;
                 bool _svml_knc_enabled;
                 bool _svml_knl_enabled;
+                bool _svml_avx512_enabled;
+                bool _svml_avx512vl_enabled;
                 bool _fast_math_enabled;
+                VectorMathAccuracy _math_accuracy;
+                std::set<std::string> _libmvec_devices;
+
+                // Functions compiled for an ISA other than the one of the
+                // translation unit (see SIMD runtime dispatch)
+                std::map<TL::Symbol, VectorInstructionSet> _isa_specific_functions;
                 
+                void enable_svml_common_avx2(std::string device);
                 void enable_svml_common_avx512(std::string device);
 
                 Vectorizer();
@@ -118,6 +133,19 @@ namespace TL
                 int get_epilog_info(const Nodecl::NodeclBase& loop_statement,
                         VectorizerEnvironment& environment,
                         bool& only_epilog);
+                Nodecl::NodeclBase get_early_exit(
+                        const Nodecl::NodeclBase& loop_statement,
+                        VectorizerEnvironment& environment);
+                bool early_exit_may_fault(
+                        const Nodecl::NodeclBase& loop_statement,
+                        VectorizerEnvironment& environment);
+                bool should_vectorize_loop(
+                        const Nodecl::NodeclBase& loop_statement,
+                        const VectorizerEnvironment& environment);
+                void select_nontemporal_stores(
+                        const Nodecl::NodeclBase& loop_statement,
+                        const VectorizerEnvironment& environment,
+                        map_tlsym_objlist_t& nontemporal_exprs);
 
                 bool is_supported_reduction(bool is_builtin,
                         const std::string& reduction_name,
@@ -142,9 +170,21 @@ namespace TL
                 void enable_svml_avx2();
                 void enable_svml_knc();
                 void enable_svml_knl();
+                void enable_svml_avx512();
+                void enable_svml_avx512vl();
+                void enable_libmvec(const std::string& device);
+                void set_math_accuracy(const VectorMathAccuracy accuracy);
                 void enable_fast_math();
                 void disable_gathers_scatters();
                 void disable_unaligned_accesses();
+                void enable_cost_model();
+                void set_nontemporal_threshold(
+                        const unsigned long long int threshold);
+
+                void add_isa_specific_function(const TL::Symbol& function,
+                        VectorInstructionSet isa);
+                const std::map<TL::Symbol, VectorInstructionSet>&
+                    get_isa_specific_functions() const;
         };
    }
 }
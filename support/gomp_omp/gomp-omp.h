@@ -33,10 +33,17 @@ extern bool GOMP_loop_ordered_guided_start (long, long, long, long,
 					    long *, long *);
 extern bool GOMP_loop_ordered_runtime_start (long, long, long, long *, long *);
 
+extern bool GOMP_loop_nonmonotonic_dynamic_start (long, long, long, long,
+						 long *, long *);
+extern bool GOMP_loop_nonmonotonic_guided_start (long, long, long, long,
+						long *, long *);
+
 extern bool GOMP_loop_static_next (long *, long *);
 extern bool GOMP_loop_dynamic_next (long *, long *);
 extern bool GOMP_loop_guided_next (long *, long *);
 extern bool GOMP_loop_runtime_next (long *, long *);
+extern bool GOMP_loop_nonmonotonic_dynamic_next (long *, long *);
+extern bool GOMP_loop_nonmonotonic_guided_next (long *, long *);
 
 extern bool GOMP_loop_ordered_static_next (long *, long *);
 extern bool GOMP_loop_ordered_dynamic_next (long *, long *);
@@ -63,6 +70,12 @@ extern void GOMP_parallel_loop_guided (void (*)(void *), void *,
 extern void GOMP_parallel_loop_runtime (void (*)(void *), void *,
 					unsigned, long, long, long,
 					unsigned);
+extern void GOMP_parallel_loop_nonmonotonic_dynamic (void (*)(void *), void *,
+						     unsigned, long, long,
+						     long, long, unsigned);
+extern void GOMP_parallel_loop_nonmonotonic_guided (void (*)(void *), void *,
+						    unsigned, long, long,
+						    long, long, unsigned);
 
 extern void GOMP_loop_end (void);
 extern void GOMP_loop_end_nowait (void);
@@ -157,10 +170,23 @@ enum GOMP_task_flags
     GOMP_TASK_FINAL = 2,
     GOMP_TASK_MERGEABLE = 4,
     GOMP_TASK_DEPEND = 8,
+    GOMP_TASK_PRIORITY = 16,
+    GOMP_TASK_UP = 256,
+    GOMP_TASK_GRAINSIZE = 512,
+    GOMP_TASK_IF = 1024,
+    GOMP_TASK_NOGROUP = 2048,
 };
 
 extern void GOMP_task (void (*) (void *), void *, void (*) (void *, void *),
 		       long, long, bool, unsigned, void **);
+extern void GOMP_taskloop (void (*) (void *), void *,
+			   void (*) (void *, void *), long, long, unsigned,
+			   unsigned long, int, long, long, long);
+extern void GOMP_taskloop_ull (void (*) (void *), void *,
+			       void (*) (void *, void *), long, long,
+			       unsigned, unsigned long, int,
+			       unsigned long long, unsigned long long,
+			       unsigned long long);
 extern void GOMP_taskwait (void);
 extern void GOMP_taskyield (void);
 extern void GOMP_taskgroup_start (void);
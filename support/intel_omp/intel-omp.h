@@ -157,6 +157,7 @@ void __kmpc_ordered (ident_t *loc, kmp_int32 gtid);
 void __kmpc_end_ordered (ident_t *loc, kmp_int32 gtid);
 void __kmpc_critical (ident_t *loc, kmp_int32 global_tid, kmp_critical_name *crit);
 void __kmpc_end_critical (ident_t *loc, kmp_int32 global_tid, kmp_critical_name *crit);
+void __kmpc_critical_with_hint (ident_t *loc, kmp_int32 global_tid, kmp_critical_name *crit, uint32_t hint);
 kmp_int32 __kmpc_single (ident_t *loc, kmp_int32 global_tid);
 void __kmpc_end_single (ident_t *loc, kmp_int32 global_tid);
 void __kmpc_for_static_fini (ident_t *loc, kmp_int32 global_tid);
@@ -197,6 +198,82 @@ kmp_int32 __kmpc_reduce (ident_t *loc, kmp_int32 global_tid, kmp_int32 num_vars,
 #endif
 void __kmpc_end_reduce (ident_t *loc, kmp_int32 global_tid, kmp_critical_name *lck);
 
+/* Tasking */
+
+typedef kmp_int32 (* kmp_routine_entry_t)(kmp_int32, void *);
+
+typedef union kmp_cmplrdata {
+    kmp_int32 priority;
+    kmp_routine_entry_t destructors;
+} kmp_cmplrdata_t;
+
+typedef struct kmp_task {
+    void *shareds;
+    kmp_routine_entry_t routine;
+    kmp_int32 part_id;
+    kmp_cmplrdata_t data1;
+    kmp_cmplrdata_t data2;
+} kmp_task_t;
+
+enum {
+    KMP_TASK_TIED = 0x01,
+    KMP_TASK_FINAL = 0x02,
+    KMP_TASK_MERGED_IF0 = 0x04,
+    KMP_TASK_DESTRUCTORS = 0x08,
+    KMP_TASK_PROXY = 0x10,
+    KMP_TASK_PRIORITY = 0x20,
+};
+
+/* Same layout as in libomp: 'flag' allows setting all the flags at once */
+typedef struct kmp_depend_info {
+    intptr_t base_addr;
+    size_t len;
+    union {
+        unsigned char flag;
+        struct {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            unsigned all:1;
+            unsigned unused:3;
+            unsigned set:1;
+            unsigned mtx:1;
+            unsigned out:1;
+            unsigned in:1;
+#else
+            unsigned in:1;
+            unsigned out:1;
+            unsigned mtx:1;
+            unsigned set:1;
+            unsigned unused:3;
+            unsigned all:1;
+#endif
+        } flags;
+    };
+} kmp_depend_info_t;
+
+kmp_task_t* __kmpc_omp_task_alloc(ident_t *loc_ref, kmp_int32 gtid, kmp_int32 flags,
+        size_t sizeof_kmp_task_t, size_t sizeof_shareds, kmp_routine_entry_t task_entry);
+kmp_int32 __kmpc_omp_task(ident_t *loc_ref, kmp_int32 gtid, kmp_task_t *new_task);
+kmp_int32 __kmpc_omp_task_with_deps(ident_t *loc_ref, kmp_int32 gtid, kmp_task_t *new_task,
+        kmp_int32 ndeps, kmp_depend_info_t *dep_list,
+        kmp_int32 ndeps_noalias, kmp_depend_info_t *noalias_dep_list);
+void __kmpc_omp_wait_deps(ident_t *loc_ref, kmp_int32 gtid,
+        kmp_int32 ndeps, kmp_depend_info_t *dep_list,
+        kmp_int32 ndeps_noalias, kmp_depend_info_t *noalias_dep_list);
+void __kmpc_omp_task_begin_if0(ident_t *loc_ref, kmp_int32 gtid, kmp_task_t *task);
+void __kmpc_omp_task_complete_if0(ident_t *loc_ref, kmp_int32 gtid, kmp_task_t *task);
+kmp_int32 __kmpc_omp_taskwait(ident_t *loc_ref, kmp_int32 gtid);
+kmp_int32 __kmpc_omp_taskyield(ident_t *loc_ref, kmp_int32 gtid, int end_part);
+
+/* Taskgraph record and replay */
+
+enum {
+    KMP_TASKGRAPH_NOWAIT = 0x01,
+    KMP_TASKGRAPH_GRAPH_RESET = 0x02,
+};
+
+kmp_int32 __kmpc_start_record_task(ident_t *loc_ref, kmp_int32 gtid, kmp_int32 input_flags, kmp_int32 tdg_id);
+void __kmpc_end_record_task(ident_t *loc_ref, kmp_int32 gtid, kmp_int32 input_flags, kmp_int32 tdg_id);
+
 /* Threadprivate data support */
 
 typedef void *(* kmpc_ctor )(void *);
@@ -211,8 +288,32 @@ void __kmpc_threadprivate_register (ident_t *loc, void *data, kmpc_ctor ctor, km
 void * __kmpc_threadprivate_cached (ident_t *loc, kmp_int32 global_tid, void *data, size_t size, void ***cache);
 void __kmpc_threadprivate_register_vec (ident_t *loc, void *data, kmpc_ctor_vec ctor, kmpc_cctor_vec cctor, kmpc_dtor_vec dtor, size_t vector_length);
 
+/* Copy function of __kmpc_copyprivate used to broadcast a pointer to the team */
+static inline void __kmp_copy_pointer(void *dest, void *src)
+{
+    *(void **)dest = *(void **)src;
+}
+
 #ifdef __cplusplus
 }
 #endif
 
+#ifdef __cplusplus
+#include <new>
+
+/* Copy construction and destruction of the C++ firstprivates of a task,
+   which live in the memory allocated by __kmpc_omp_task_alloc */
+template <typename T>
+inline void __kmp_task_copy_construct(T* dest, const T& src)
+{
+    new (dest) T(src);
+}
+
+template <typename T>
+inline void __kmp_task_destroy(T* p)
+{
+    p->~T();
+}
+#endif
+
 #endif // INTEL_OMP_H
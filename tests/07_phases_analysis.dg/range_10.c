@@ -0,0 +1,63 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator=config/mercurium-analysis
+test_nolink=yes
+test_CFLAGS=--variable=range_solver:sparse
+</testinfo>
+*/
+
+// Same code as range_01.c, solved with the sparse interval solver
+int foo(int q)
+{
+    int t = q;
+    int i, j;
+    int a = 5;
+    int c;
+
+    #pragma analysis_check assert range(a:5:5:0)
+    if (t < 10)
+        c = a;
+    else
+        c = a - 1;
+
+    #pragma analysis_check assert range(c:4:5:0)
+    for (i = 0; i < 4; ++i)
+        #pragma analysis_check assert range(i:0:3:0)
+        a = 10;
+
+    // The bound is unknown, so widening reaches infinity
+    for (j = 0; j < q; ++j)
+        #pragma analysis_check assert range(j:0:long_max:0)
+        a = a + 1;
+
+    #pragma analysis_check assert range(i:4:4:0)
+    return a;
+}
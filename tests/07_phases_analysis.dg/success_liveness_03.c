@@ -0,0 +1,57 @@
+/*--------------------------------------------------------------------
+ * (C) Copyright 2006-2012 Barcelona Supercomputing Center
+ *                         Centro Nacional de Supercomputacion
+ * 
+ * This file is part of Mercurium C/C++ source-to-source compiler.
+ * 
+ * See AUTHORS file in the top level directory for information
+ * regarding developers and contributors.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * Mercurium C/C++ source-to-source compiler is distributed in the hope
+ * that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mercurium C/C++ source-to-source compiler; if
+ * not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ * Cambridge, MA 02139, USA.
+ - *-------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator=config/mercurium-analysis
+test_nolink=yes
+</testinfo>
+*/
+
+// Liveness information must be propagated through the back edges of every loop in the nest
+int foo(int n, int m)
+{
+    int i, j, k;
+    int s = 0, t = 0, unused;
+
+    for (i = 0; i < n; ++i)
+    {
+        for (j = 0; j < n; ++j)
+        {
+            for (k = 0; k < n; ++k)
+            {
+                #pragma analysis_check assert live_in(i, j, k, n, m, s, t) live_out(i, j, k, n, m, s, t) dead(unused)
+                s += k * m;
+            }
+            t += s;
+        }
+        unused = t;
+    }
+
+    return s + t;
+}
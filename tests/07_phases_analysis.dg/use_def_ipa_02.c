@@ -28,7 +28,7 @@
 
 /*
  <testinfo>
- test_generator=config/mercurium-analysis
+ test_generator=(config/mercurium-analysis config/mercurium-analysis-threads)
  test_nolink=yes
  </testinfo>
  */
@@ -0,0 +1,66 @@
+/*--------------------------------------------------------------------
+ * (C) Copyright 2006-2012 Barcelona Supercomputing Center
+ *                        Centro Nacional de Supercomputacion
+ * 
+ * This file is part of Mercurium C/C++ source-to-source compiler.
+ * 
+ * See AUTHORS file in the top level directory for information
+ * regarding developers and contributors.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * Mercurium C/C++ source-to-source compiler is distributed in the hope
+ * that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mercurium C/C++ source-to-source compiler; if
+ * not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ * Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+ <testinfo>
+ test_generator=(config/mercurium-analysis config/mercurium-analysis-threads)
+ test_nolink=yes
+ </testinfo>
+*/
+
+// Mutually recursive functions are analyzed in the same call graph component
+int odd(int n, int* r);
+
+int even(int n, int* r)
+{
+    if (n == 0)
+    {
+        #pragma analysis_check assert upper_exposed(r) defined(*r)
+        *r = 1;
+        return 1;
+    }
+    return odd(n - 1, r);
+}
+
+int odd(int n, int* r)
+{
+    if (n == 0)
+    {
+        #pragma analysis_check assert upper_exposed(r) defined(*r)
+        *r = 0;
+        return 0;
+    }
+    return even(n - 1, r);
+}
+
+int main(int argc, char** argv)
+{
+    int res;
+    even(argc, &res);
+    return res;
+}
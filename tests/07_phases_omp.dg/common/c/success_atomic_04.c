@@ -0,0 +1,89 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator=config/mercurium-omp
+</testinfo>
+*/
+
+#include <stdlib.h>
+#include <math.h>
+
+#define N 100
+
+int main(int argc, char *argv[])
+{
+    int i, x = 0, v = 0, m = 0, c = 0;
+    unsigned char h = 0;
+    double d = 0.0;
+
+#pragma omp parallel for
+    for (i = 0; i < N; i++)
+    {
+#pragma omp atomic
+        x++;
+#pragma omp atomic update relaxed
+        h += 2;
+#pragma omp atomic seq_cst
+        d += 0.5;
+#pragma omp atomic compare
+        if (i > m) { m = i; }
+#pragma omp atomic compare acq_rel
+        if (c == 0) { c = 1; }
+    }
+
+    if (x != N
+            || h != (unsigned char)(2 * N)
+            || fabs(d - N * 0.5) > 1e-9
+            || m != N - 1
+            || c != 1)
+        abort();
+
+#pragma omp atomic capture release
+    v = x++;
+    if (v != N || x != N + 1)
+        abort();
+
+#pragma omp atomic capture acquire
+    v = x += 2;
+    if (v != N + 3 || x != N + 3)
+        abort();
+
+#pragma omp atomic capture
+    v = --x;
+    if (v != N + 2 || x != N + 2)
+        abort();
+
+#pragma omp atomic compare
+    x = (x == N + 2) ? 0 : x;
+    if (x != 0)
+        abort();
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+/*
+<testinfo>
+test_generator=config/mercurium-omp
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+#define N 100
+
+int main(int argc, char *argv[])
+{
+    int i, x = 0, seen = 0;
+    double d = 0.0, e = 0.0;
+    int a[2] = { 0, 1 };
+    int *p = &a[0], *q = 0;
+
+#pragma omp parallel for
+    for (i = 0; i < N; i++)
+    {
+        int v;
+#pragma omp atomic write relaxed
+        x = i + 1;
+#pragma omp atomic read acquire
+        v = x;
+        if (v < 1 || v > N)
+        {
+#pragma omp atomic
+            seen++;
+        }
+#pragma omp atomic write release
+        d = 2.5;
+    }
+
+    if (seen != 0 || x < 1 || x > N || d != 2.5)
+        abort();
+
+#pragma omp atomic read seq_cst
+    e = d;
+    if (e != 2.5)
+        abort();
+
+#pragma omp atomic write acq_rel
+    p = &a[1];
+#pragma omp atomic read
+    q = p;
+    if (q != &a[1] || *q != 1)
+        abort();
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+
+/*
+<testinfo>
+test_generator="config/mercurium-gomp-omp run"
+</testinfo>
+*/
+
+#include <assert.h>
+
+#define N 1000
+
+int v[N];
+
+static void check_and_reset(void)
+{
+    int i;
+    for (i = 0; i < N; i++)
+    {
+        // Every iteration runs exactly once
+        assert(v[i] == 1);
+        v[i] = 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    // Combined constructs: GOMP_parallel or GOMP_parallel_loop_<kind>
+    #pragma omp parallel for
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(static)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(static, 7)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(dynamic, 3)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(guided, 5)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(runtime)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(auto)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(nonmonotonic: dynamic, 3)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(nonmonotonic: guided)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(monotonic: dynamic)
+    for (i = N - 1; i >= 0; i -= 2)
+        v[i]++;
+    for (i = 0; i < N; i++)
+        v[i] += (i % 2 == 0);
+    check_and_reset();
+
+    // Non-combined constructs: GOMP_loop_<kind>_start inside the team
+    #pragma omp parallel
+    {
+        int j;
+
+        #pragma omp for schedule(static)
+        for (j = 0; j < N; j++)
+            v[j]++;
+
+        #pragma omp single
+        check_and_reset();
+
+        #pragma omp for schedule(dynamic, 4)
+        for (j = 0; j < N; j++)
+            v[j]++;
+
+        #pragma omp single
+        check_and_reset();
+
+        #pragma omp for schedule(guided)
+        for (j = 0; j < N; j++)
+            v[j]++;
+
+        #pragma omp single
+        check_and_reset();
+
+        #pragma omp for schedule(runtime)
+        for (j = 0; j < N; j++)
+            v[j]++;
+
+        #pragma omp single
+        check_and_reset();
+
+        #pragma omp for schedule(nonmonotonic: dynamic)
+        for (j = 0; j < N; j++)
+            v[j]++;
+
+        #pragma omp single
+        check_and_reset();
+
+        #pragma omp for schedule(dynamic) nowait
+        for (j = 0; j < N; j++)
+            v[j]++;
+    }
+    check_and_reset();
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+
+/*
+<testinfo>
+test_generator="config/mercurium-gomp-omp run"
+test_CFLAGS="--variable=gomp_version:4.8"
+</testinfo>
+*/
+
+// Before libgomp 4.9 there are no combined entry points: the team is
+// created with GOMP_parallel_<construct>_start and finished with
+// GOMP_parallel_end, and nonmonotonic schedules become monotonic
+
+#include <assert.h>
+
+#define N 1000
+
+int v[N];
+
+static void check_and_reset(void)
+{
+    int i;
+    for (i = 0; i < N; i++)
+    {
+        assert(v[i] == 1);
+        v[i] = 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic, 2)
+        for (i = 0; i < N; i++)
+            v[i]++;
+    }
+    check_and_reset();
+
+    #pragma omp parallel for schedule(static, 7)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(dynamic, 3)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(guided)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(runtime)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    #pragma omp parallel for schedule(nonmonotonic: dynamic, 3)
+    for (i = 0; i < N; i++)
+        v[i]++;
+    check_and_reset();
+
+    int a = 0, b = 0;
+    #pragma omp parallel sections
+    {
+        #pragma omp section
+        a++;
+        #pragma omp section
+        b++;
+    }
+    assert(a == 1 && b == 1);
+
+    return 0;
+}
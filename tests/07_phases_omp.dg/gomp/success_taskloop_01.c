@@ -0,0 +1,79 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+
+/*
+<testinfo>
+test_generator="config/mercurium-gomp-omp run"
+</testinfo>
+*/
+
+#include <assert.h>
+
+#define N 1000
+
+int v[N];
+
+int main(int argc, char *argv[])
+{
+    int i;
+    unsigned long long u;
+
+    #pragma omp parallel
+    #pragma omp single
+    {
+        // GOMP_taskloop, with the implicit taskgroup
+        #pragma omp taskloop
+        for (i = 0; i < N; i++)
+            v[i]++;
+
+        for (i = 0; i < N; i++)
+            assert(v[i] == 1);
+
+        #pragma omp taskloop grainsize(10)
+        for (i = 0; i < N; i++)
+            v[i]++;
+
+        #pragma omp taskloop num_tasks(7)
+        for (i = N - 1; i >= 0; i--)
+            v[i]++;
+
+        for (i = 0; i < N; i++)
+            assert(v[i] == 3);
+
+        // GOMP_taskloop_ull
+        #pragma omp taskloop grainsize(16)
+        for (u = 0; u < N; u += 2)
+            v[u]++;
+
+        for (i = 0; i < N; i++)
+            assert(v[i] == 3 + (i % 2 == 0));
+    }
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator="config/mercurium-intel-omp run"
+</testinfo>
+*/
+
+#include <assert.h>
+
+#define N 1000
+
+int main(int argc, char *argv[])
+{
+    int i;
+    int s = 0;
+    double d = 1.0;
+
+    // Tree combination in a worksharing with a barrier at the end
+    #pragma omp parallel
+    {
+        #pragma omp for reduction(+:s) reduction(*:d) reduction_strategy(tree)
+        for (i = 0; i < N; i++)
+        {
+            s += i;
+            if (i < 10)
+                d *= 2.0;
+        }
+
+        // The barrier at the end of the for makes the result visible
+        assert(s == (N * (N - 1)) / 2);
+        assert(d == 1024.0);
+    }
+
+    // Same without the barrier at the end
+    s = 0;
+    #pragma omp parallel
+    {
+        #pragma omp for reduction(+:s) reduction_strategy(tree) nowait
+        for (i = 0; i < N; i++)
+        {
+            s += i;
+        }
+    }
+    assert(s == (N * (N - 1)) / 2);
+
+    // Combined construct, 'auto' chooses between the tree and the runtime
+    s = 0;
+    #pragma omp parallel for reduction(+:s) reduction_strategy(auto)
+    for (i = 0; i < N; i++)
+    {
+        s += i;
+    }
+    assert(s == (N * (N - 1)) / 2);
+
+    // Tree combination of a parallel
+    int num_threads = 0;
+    s = 0;
+    #pragma omp parallel reduction(+:s) reduction_strategy(tree)
+    {
+        #pragma omp atomic
+        num_threads++;
+
+        s += 1;
+    }
+    assert(s == num_threads);
+
+    return 0;
+}
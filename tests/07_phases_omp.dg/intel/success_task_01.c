@@ -0,0 +1,151 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+
+/*
+<testinfo>
+test_generator="config/mercurium-intel-omp run"
+</testinfo>
+*/
+
+#include <assert.h>
+#include <omp.h>
+
+#define N 100
+
+int main(int argc, char *argv[])
+{
+    int i;
+    int x = 0, y = 0;
+    int v[N];
+
+    #pragma omp parallel shared(x, y, v)
+    #pragma omp single
+    {
+        // Dependences order the tasks (__kmpc_omp_task_with_deps)
+        for (i = 0; i < N; i++)
+        {
+            #pragma omp task depend(inout: x) firstprivate(i) shared(x, v)
+            {
+                v[i] = x;
+                x++;
+            }
+        }
+        #pragma omp taskwait
+        assert(x == N);
+        for (i = 0; i < N; i++)
+            assert(v[i] == i);
+
+        // An undeferred task waits for its dependences (__kmpc_omp_wait_deps)
+        // and runs in the encountering thread (begin_if0/complete_if0)
+        int seen = -1;
+        #pragma omp task depend(out: y) shared(y)
+        {
+            y = 42;
+        }
+        #pragma omp task depend(in: y) if(0) shared(y, seen)
+        {
+            seen = y;
+        }
+        assert(seen == 42);
+
+        // Undeferred task without dependences
+        int local = 0;
+        #pragma omp task if(x < 0) shared(local)
+        {
+            local = 1;
+        }
+        assert(local == 1);
+
+        // Taskwait with dependences only waits for the tasks writing 'x'
+        x = 0;
+        #pragma omp task depend(out: x) shared(x)
+        {
+            x = 7;
+        }
+        #pragma omp taskwait depend(in: x)
+        assert(x == 7);
+
+        // Final tasks run their descendants as included tasks
+        int in_final = 0, child_in_final = 0;
+        #pragma omp task final(x == 7) shared(in_final, child_in_final)
+        {
+            in_final = omp_in_final();
+
+            #pragma omp task shared(child_in_final)
+            {
+                child_in_final = omp_in_final();
+            }
+            #pragma omp taskwait
+        }
+        #pragma omp taskwait
+        assert(in_final);
+        assert(child_in_final);
+
+        // A false final expression does not set the flag
+        in_final = 1;
+        #pragma omp task final(x != 7) shared(in_final)
+        {
+            in_final = omp_in_final();
+        }
+        #pragma omp taskwait
+        assert(!in_final);
+
+        // Priorities and untied tasks
+        int sum = 0;
+        for (i = 0; i < N; i++)
+        {
+            #pragma omp task priority(i % 4) untied firstprivate(i) shared(sum)
+            {
+                #pragma omp atomic
+                sum += i;
+            }
+        }
+        #pragma omp taskwait
+        assert(sum == (N * (N - 1)) / 2);
+    }
+
+    // Named critical with a hint (__kmpc_critical_with_hint)
+    int count = 0, num_threads = 0;
+    #pragma omp parallel shared(count, num_threads)
+    {
+        int j;
+
+        #pragma omp atomic
+        num_threads++;
+
+        for (j = 0; j < N; j++)
+        {
+            #pragma omp critical(counter) hint(omp_lock_hint_contended)
+            count++;
+        }
+    }
+    assert(count == N * num_threads);
+
+    return 0;
+}
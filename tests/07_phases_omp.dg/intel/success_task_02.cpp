@@ -0,0 +1,121 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+
+/*
+<testinfo>
+test_generator="config/mercurium-intel-omp run"
+</testinfo>
+*/
+
+#include <assert.h>
+
+// Counts the live objects: firstprivate copies must be copy-constructed
+// into the task and destroyed by the runtime when the task finishes
+struct Counted
+{
+    static int live;
+    static int copies;
+
+    int value;
+
+    Counted(int v) : value(v)
+    {
+        #pragma omp atomic
+        live++;
+    }
+
+    Counted(const Counted& c) : value(c.value)
+    {
+        #pragma omp atomic
+        live++;
+        #pragma omp atomic
+        copies++;
+    }
+
+    ~Counted()
+    {
+        #pragma omp atomic
+        live--;
+    }
+};
+
+int Counted::live = 0;
+int Counted::copies = 0;
+
+#define N 50
+
+int main(int argc, char *argv[])
+{
+    int sum = 0;
+
+    #pragma omp parallel shared(sum)
+    #pragma omp single
+    {
+        Counted c(3);
+
+        for (int i = 0; i < N; i++)
+        {
+            #pragma omp task firstprivate(c) shared(sum)
+            {
+                #pragma omp atomic
+                sum += c.value;
+            }
+        }
+        #pragma omp taskwait
+
+        assert(sum == 3 * N);
+        assert(Counted::copies >= N);
+        // Only 'c' is still alive
+        assert(Counted::live == 1);
+
+        // The undeferred path destroys its copy as well
+        int seen = 0;
+        #pragma omp task firstprivate(c) shared(seen) if(0)
+        {
+            seen = c.value;
+        }
+        assert(seen == 3);
+        assert(Counted::live == 1);
+
+        // The copy is taken when the task is created
+        c.value = 4;
+        #pragma omp task firstprivate(c) shared(seen)
+        {
+            seen = c.value;
+        }
+        c.value = 5;
+        #pragma omp taskwait
+        assert(seen == 4);
+        assert(Counted::live == 1);
+    }
+
+    assert(Counted::live == 0);
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator="config/mercurium-intel-omp run"
+test_CFLAGS="--taskgraph-runtime"
+</testinfo>
+*/
+
+#include <assert.h>
+
+#define N 100
+#define STEPS 4
+
+int num_graph_id_evaluations = 0;
+
+int get_graph_id(void)
+{
+    num_graph_id_evaluations++;
+    return 7;
+}
+
+int main(int argc, char *argv[])
+{
+    int v[N];
+    int i, step;
+
+    for (i = 0; i < N; i++)
+        v[i] = 0;
+
+    #pragma omp parallel private(i, step)
+    #pragma omp single
+    for (step = 0; step < STEPS; step++)
+    {
+        // Recorded in the first step and replayed in the following ones
+        #pragma omp taskgraph graph_id(get_graph_id())
+        {
+            for (i = 0; i < N; i++)
+            {
+                #pragma omp task shared(v) firstprivate(i) depend(inout: v[i])
+                v[i]++;
+            }
+        }
+
+        for (i = 0; i < N; i++)
+            assert(v[i] == step + 1);
+
+        // The graph is recorded again after a reset
+        #pragma omp taskgraph graph_reset(step == 2)
+        {
+            #pragma omp task shared(v)
+            v[0]--;
+        }
+        assert(v[0] == step);
+        v[0]++;
+    }
+
+    // The clauses are evaluated once for both runtime calls
+    assert(num_graph_id_evaluations == STEPS);
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2013 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd-avx2
+</testinfo>
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define VECTOR_SIZE 32
+
+void __attribute__((noinline)) clamp(float *x, float *y, float lower, float upper, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        if (x[j] < lower)
+            y[j] = lower;
+        else if (x[j] > upper)
+            y[j] = upper;
+        else
+            y[j] = x[j];
+    }
+}
+
+void __attribute__((noinline)) clamp_double(double *x, double *y, double lower, double upper, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        if (x[j] < lower)
+            y[j] = lower;
+        else if (x[j] > upper)
+            y[j] = upper;
+        else
+            y[j] = x[j];
+    }
+}
+
+void __attribute__((noinline)) select_positive(int *x, int *y, int *z, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        int tmp = 0;
+        if (y[j] > 0)
+            tmp = x[j] + y[j];
+        z[j] = tmp;
+    }
+}
+
+int main (int argc, char * argv[])
+{
+    const int N = 64;
+
+    float *x, *y;
+    double *dx, *dy;
+    int *a, *b, *c;
+
+    posix_memalign((void **)&x, VECTOR_SIZE, N*sizeof(float));
+    posix_memalign((void **)&y, VECTOR_SIZE, N*sizeof(float));
+    posix_memalign((void **)&dx, VECTOR_SIZE, N*sizeof(double));
+    posix_memalign((void **)&dy, VECTOR_SIZE, N*sizeof(double));
+    posix_memalign((void **)&a, VECTOR_SIZE, N*sizeof(int));
+    posix_memalign((void **)&b, VECTOR_SIZE, N*sizeof(int));
+    posix_memalign((void **)&c, VECTOR_SIZE, N*sizeof(int));
+
+    int i;
+
+    for (i=0; i<N; i++)
+    {
+        x[i] = i - N/2;
+        y[i] = 0.0f;
+        dx[i] = i - N/2;
+        dy[i] = 0.0;
+        a[i] = 3*i;
+        b[i] = (i % 3) - 1;
+        c[i] = -1;
+    }
+
+    clamp(x, y, -8.0f, 8.0f, N);
+    clamp_double(dx, dy, -8.0, 8.0, N);
+    select_positive(a, b, c, N);
+
+    for (i=0; i<N; i++)
+    {
+        float expected = x[i] < -8.0f ? -8.0f : (x[i] > 8.0f ? 8.0f : x[i]);
+        if (y[i] != expected)
+        {
+            printf("Error in clamp: y[%d] = %f != %f\n", i, y[i], expected);
+            return 1;
+        }
+
+        double dexpected = dx[i] < -8.0 ? -8.0 : (dx[i] > 8.0 ? 8.0 : dx[i]);
+        if (dy[i] != dexpected)
+        {
+            printf("Error in clamp_double: dy[%d] = %f != %f\n", i, dy[i], dexpected);
+            return 1;
+        }
+
+        int expected_sum = (b[i] > 0) ? a[i] + b[i] : 0;
+        if (c[i] != expected_sum)
+        {
+            printf("Error in select_positive: c[%d] = %d != %d\n", i, c[i], expected_sum);
+            return 1;
+        }
+    }
+
+    printf("SUCCESS\n");
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+test_CFLAGS="--avx512"
+test_nolink=yes
+</testinfo>
+*/
+
+void __attribute__((noinline)) saxpy(float *x, float *y, float *z, float a, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        z[j] = a * x[j] + y[j];
+    }
+}
+
+void __attribute__((noinline)) clamp(int *x, int lower, int upper, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        if (x[j] < lower)
+            x[j] = lower;
+        else if (x[j] > upper)
+            x[j] = upper;
+    }
+}
+
+double __attribute__((noinline)) sum(double *x, int N)
+{
+    int j;
+    double result = 0.0;
+#pragma omp simd reduction(+:result)
+    for (j=0; j<N; j++)
+    {
+        result += x[j];
+    }
+    return result;
+}
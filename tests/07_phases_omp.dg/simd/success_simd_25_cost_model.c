@@ -0,0 +1,91 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+test_CFLAGS="--simd-cost-model"
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+// Short trip count dominated by gathers: kept scalar
+void __attribute__((noinline)) short_gather(float *x, int *idx, float *y)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<3; j++)
+    {
+        y[j] = x[idx[j]];
+    }
+}
+
+// Adjacent accesses: vectorized
+void __attribute__((noinline)) saxpy(float *x, float *y, float *z, float a, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        z[j] = a * x[j] + y[j];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const int N = 1003;
+    int i;
+
+    float *x = (float *)malloc(N * sizeof(float));
+    float *y = (float *)malloc(N * sizeof(float));
+    float *z = (float *)malloc(N * sizeof(float));
+    int idx[3] = { 7, 2, 5 };
+
+    for (i=0; i<N; i++)
+    {
+        x[i] = i;
+        y[i] = 2 * i;
+    }
+
+    short_gather(x, idx, z);
+
+    for (i=0; i<3; i++)
+    {
+        if (z[i] != x[idx[i]])
+            abort();
+    }
+
+    saxpy(x, y, z, 2.0f, N);
+
+    for (i=0; i<N; i++)
+    {
+        if (z[i] != (2.0f * x[i] + y[i]))
+            abort();
+    }
+
+    return 0;
+}
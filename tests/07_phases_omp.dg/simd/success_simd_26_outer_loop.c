@@ -0,0 +1,111 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+#define M 8
+
+// Short inner loop with a uniform trip count
+void __attribute__((noinline)) stencil(float *x, float *w, float *y, int N)
+{
+    int i, k;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        float acc = 0.0f;
+        for (k=0; k<3; k++)
+        {
+            acc += w[k] * x[i+k];
+        }
+        y[i] = acc;
+    }
+}
+
+// Inner loop with a different trip count on each lane
+void __attribute__((noinline)) row_sum(float *a, int *len, float *y, int N)
+{
+    int i, k;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        float sum = 0.0f;
+        for (k=0; k<len[i]; k++)
+        {
+            sum += a[i*M + k];
+        }
+        y[i] = sum;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const int N = 103;
+    int i, k;
+
+    float *x = (float *)malloc((N + 2) * sizeof(float));
+    float *a = (float *)malloc(N * M * sizeof(float));
+    float *y = (float *)malloc(N * sizeof(float));
+    int *len = (int *)malloc(N * sizeof(int));
+    float w[3] = { 1.0f, 2.0f, 1.0f };
+
+    for (i=0; i<N+2; i++)
+        x[i] = i;
+
+    for (i=0; i<N; i++)
+    {
+        len[i] = (i * 5) % (M + 1);
+        for (k=0; k<M; k++)
+            a[i*M + k] = i + k;
+    }
+
+    stencil(x, w, y, N);
+
+    for (i=0; i<N; i++)
+    {
+        if (y[i] != (x[i] + 2.0f * x[i+1] + x[i+2]))
+            abort();
+    }
+
+    row_sum(a, len, y, N);
+
+    for (i=0; i<N; i++)
+    {
+        float sum = 0.0f;
+        for (k=0; k<len[i]; k++)
+            sum += a[i*M + k];
+
+        if (y[i] != sum)
+            abort();
+    }
+
+    return 0;
+}
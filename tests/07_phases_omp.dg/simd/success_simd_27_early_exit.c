@@ -0,0 +1,129 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+// Search loop: the first matching element is the result
+int __attribute__((noinline)) find(float *a, float key, int N)
+{
+    int i, pos = -1;
+#pragma omp simd aligned(a:64)
+    for (i=0; i<N; i++)
+    {
+        if (a[i] == key)
+        {
+            pos = i;
+            break;
+        }
+    }
+    return pos;
+}
+
+// Without 'aligned' the loads before the exit could fault after it,
+// so this loop is kept scalar
+int __attribute__((noinline)) find_unaligned(float *a, float key, int N)
+{
+    int i, pos = -1;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        if (a[i] == key)
+        {
+            pos = i;
+            break;
+        }
+    }
+    return pos;
+}
+
+// strlen-like scan with an unconditional store after the exit
+int __attribute__((noinline)) copy_until_zero(int *src, int *dst, int N)
+{
+    int i;
+#pragma omp simd aligned(src, dst:64)
+    for (i=0; i<N; i++)
+    {
+        int value = src[i];
+        if (value == 0)
+            break;
+
+        dst[i] = value + 1;
+    }
+    return i;
+}
+
+int main(int argc, char *argv[])
+{
+    const int N = 1003;
+    int i, j;
+
+    float __attribute__((aligned(64))) a[N];
+    int __attribute__((aligned(64))) src[N];
+    int __attribute__((aligned(64))) dst[N];
+
+    for (i=0; i<N; i++)
+    {
+        a[i] = i % 100;
+        src[i] = i + 1;
+        dst[i] = -1;
+    }
+
+    if (find(a, 37.0f, N) != 37) abort();
+    if (find(a, 99.0f, N) != 99) abort();
+    if (find(a, 0.0f, N) != 0) abort();
+    if (find(a, 150.0f, N) != -1) abort();
+
+    if (find_unaligned(a + 1, 38.0f, N - 1) != 37) abort();
+    if (find_unaligned(a + 1, 150.0f, N - 1) != -1) abort();
+
+    if (copy_until_zero(src, dst, N) != N) abort();
+
+    for (j=0; j<N; j+=37)
+    {
+        src[j] = 0;
+
+        for (i=0; i<N; i++)
+            dst[i] = -1;
+
+        if (copy_until_zero(src, dst, N) != j) abort();
+
+        for (i=0; i<j; i++)
+        {
+            if (dst[i] != i + 2) abort();
+        }
+        if (dst[j] != -1) abort();
+
+        src[j] = j + 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+typedef struct
+{
+    float x;
+    float y;
+    float z;
+} point_t;
+
+// Array of structures: loads and stores of stride 3
+void __attribute__((noinline)) scale(point_t *p, float f, int N)
+{
+    int i;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        float x = p[i].x;
+        float y = p[i].y;
+        float z = p[i].z;
+
+        p[i].x = x * f;
+        p[i].y = y * f + z;
+        p[i].z = z * f - x;
+    }
+}
+
+// Complex numbers stored as (re, im) pairs
+void __attribute__((noinline)) cmul(float *c, float *a, float *b, int N)
+{
+    int i;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        float re = a[2*i] * b[2*i] - a[2*i+1] * b[2*i+1];
+        float im = a[2*i] * b[2*i+1] + a[2*i+1] * b[2*i];
+
+        c[2*i] = re;
+        c[2*i+1] = im;
+    }
+}
+
+// 'b' may alias 'a': the store between the loads of 'a' keeps them
+// as gathers
+void __attribute__((noinline)) forward(float *a, float *b, float *c, int N)
+{
+    int i;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        float x = a[2*i];
+        b[2*i+1] = x;
+        float y = a[2*i+1];
+        c[i] = x + y;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const int N = 1003;
+    int i;
+
+    point_t p[N];
+    float __attribute__((aligned(64))) a[2*N];
+    float __attribute__((aligned(64))) b[2*N];
+    float __attribute__((aligned(64))) c[2*N];
+    float __attribute__((aligned(64))) d[2*N];
+
+    for (i=0; i<N; i++)
+    {
+        p[i].x = i;
+        p[i].y = i + 1;
+        p[i].z = i + 2;
+
+        a[2*i] = i % 10;
+        a[2*i+1] = 1;
+        b[2*i] = 2;
+        b[2*i+1] = i % 5;
+
+        d[2*i] = i;
+        d[2*i+1] = -1;
+    }
+
+    scale(p, 2.0f, N);
+    cmul(c, a, b, N);
+
+    for (i=0; i<N; i++)
+    {
+        if (p[i].x != 2.0f * i) abort();
+        if (p[i].y != 2.0f * (i + 1) + (i + 2)) abort();
+        if (p[i].z != 2.0f * (i + 2) - i) abort();
+
+        if (c[2*i] != (i % 10) * 2.0f - (float)(i % 5)) abort();
+        if (c[2*i+1] != (i % 10) * (float)(i % 5) + 2.0f) abort();
+    }
+
+    forward(d, d, c, N);
+
+    for (i=0; i<N; i++)
+    {
+        if (d[2*i+1] != i) abort();
+        if (c[i] != 2.0f * i) abort();
+    }
+
+    return 0;
+}
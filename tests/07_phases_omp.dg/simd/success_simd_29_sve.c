@@ -0,0 +1,124 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd-sve
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+// Unknown trip count: the epilog is a single predicated (whilelt) iteration
+void __attribute__((noinline)) saxpy(float *x, float *y, float *z, float a, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        z[j] = a * x[j] + y[j];
+    }
+}
+
+void __attribute__((noinline)) clamp(int *x, int lower, int upper, int N)
+{
+    int j;
+#pragma omp simd
+    for (j=0; j<N; j++)
+    {
+        if (x[j] < lower)
+            x[j] = lower;
+        else if (x[j] > upper)
+            x[j] = upper;
+    }
+}
+
+double __attribute__((noinline)) sum(double *x, int N)
+{
+    int j;
+    double result = 0.0;
+#pragma omp simd reduction(+:result)
+    for (j=0; j<N; j++)
+    {
+        result += x[j];
+    }
+    return result;
+}
+
+// Loads before the exit are first-faulting
+int __attribute__((noinline)) find(float *a, float key, int N)
+{
+    int i, pos = -1;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        if (a[i] == key)
+        {
+            pos = i;
+            break;
+        }
+    }
+    return pos;
+}
+
+int main(int argc, char *argv[])
+{
+    const int N = 259;
+    float *x = (float *)malloc(N * sizeof(float));
+    float *y = (float *)malloc(N * sizeof(float));
+    float *z = (float *)malloc(N * sizeof(float));
+    int *v = (int *)malloc(N * sizeof(int));
+    double *d = (double *)malloc(N * sizeof(double));
+    int i;
+
+    for (i=0; i<N; i++)
+    {
+        x[i] = i;
+        y[i] = 2 * i;
+        v[i] = (i % 20) - 10;
+        d[i] = 1.0;
+    }
+
+    saxpy(x, y, z, 3.0f, N);
+    clamp(v, -5, 5, N);
+
+    for (i=0; i<N; i++)
+    {
+        if (z[i] != 5.0f * i) abort();
+        if (v[i] < -5 || v[i] > 5) abort();
+        if (v[i] != (((i % 20) - 10) < -5 ? -5 :
+                    ((i % 20) - 10) > 5 ? 5 : (i % 20) - 10)) abort();
+    }
+
+    if (sum(d, N) != N) abort();
+
+    // The key in the vector body, in the epilog and missing
+    if (find(x, 100.0f, N) != 100) abort();
+    if (find(x, 258.0f, N) != 258) abort();
+    if (find(x, -1.0f, N) != -1) abort();
+
+    return 0;
+}
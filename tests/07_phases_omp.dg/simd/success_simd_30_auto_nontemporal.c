@@ -0,0 +1,112 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+test_CFLAGS="--simd-auto-nontemporal"
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+#define N (1 << 20)
+
+float a[N] __attribute__((aligned(64)));
+float b[N] __attribute__((aligned(64)));
+float c[N] __attribute__((aligned(64)));
+
+// 'a' is only written: non-temporal stores
+void __attribute__((noinline)) init(float s)
+{
+    int i;
+#pragma omp simd aligned(a:64)
+    for (i=0; i<N; i++)
+    {
+        a[i] = s * i;
+    }
+}
+
+// 'c' is only written: non-temporal stores
+void __attribute__((noinline)) triad(float s)
+{
+    int i;
+#pragma omp simd aligned(a, b, c:64)
+    for (i=0; i<N; i++)
+    {
+        c[i] = a[i] + s * b[i];
+    }
+}
+
+// 'b' is also read: regular stores
+void __attribute__((noinline)) scale(float s)
+{
+    int i;
+#pragma omp simd aligned(b:64)
+    for (i=0; i<N; i++)
+    {
+        b[i] = s * b[i];
+    }
+}
+
+// Small footprint: regular stores
+void __attribute__((noinline)) init_small(float s)
+{
+    int i;
+#pragma omp simd aligned(c:64)
+    for (i=0; i<64; i++)
+    {
+        c[i] = s;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    for (i=0; i<N; i++)
+        b[i] = 1.0f;
+
+    init(2.0f);
+    scale(3.0f);
+    triad(0.5f);
+
+    for (i=0; i<N; i++)
+    {
+        if (c[i] != (2.0f * i + 1.5f))
+            abort();
+    }
+
+    init_small(5.0f);
+
+    for (i=0; i<64; i++)
+    {
+        if (c[i] != 5.0f)
+            abort();
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+test_CFLAGS="--simd-auto-prefetch"
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+#define N 4096
+
+float a[N] __attribute__((aligned(64)));
+float b[16*N] __attribute__((aligned(64)));
+float c[N] __attribute__((aligned(64)));
+int idx[N] __attribute__((aligned(64)));
+
+// Unit stride: one prefetch per cache line
+void __attribute__((noinline)) add(void)
+{
+    int i;
+#pragma omp simd aligned(a, c:64)
+    for (i=0; i<N; i++)
+    {
+        a[i] = a[i] + c[i];
+    }
+}
+
+// Each element of 'b' in a different cache line
+void __attribute__((noinline)) strided(void)
+{
+    int i;
+#pragma omp simd
+    for (i=0; i<N; i++)
+    {
+        c[i] = b[16*i];
+    }
+}
+
+// Indirect accesses: 'idx' is prefetched further than 'a'
+void __attribute__((noinline)) indirect(void)
+{
+    int i;
+#pragma omp simd prefetch(auto)
+    for (i=0; i<N; i++)
+    {
+        c[i] = a[idx[i]];
+    }
+}
+
+void __attribute__((noinline)) no_prefetch(void)
+{
+    int i;
+#pragma omp simd prefetch(none)
+    for (i=0; i<N; i++)
+    {
+        c[i] = c[i] * 2.0f;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    for (i=0; i<16*N; i++)
+        b[i] = i;
+
+    for (i=0; i<N; i++)
+    {
+        a[i] = i;
+        c[i] = 1.0f;
+        idx[i] = (i * 7) % N;
+    }
+
+    add();
+
+    for (i=0; i<N; i++)
+    {
+        if (a[i] != (i + 1.0f))
+            abort();
+    }
+
+    strided();
+
+    for (i=0; i<N; i++)
+    {
+        if (c[i] != (16.0f * i))
+            abort();
+    }
+
+    indirect();
+
+    for (i=0; i<N; i++)
+    {
+        if (c[i] != (((i * 7) % N) + 1.0f))
+            abort();
+    }
+
+    no_prefetch();
+
+    for (i=0; i<N; i++)
+    {
+        if (c[i] != ((((i * 7) % N) + 1.0f) * 2.0f))
+            abort();
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-serial-simd
+test_CFLAGS="--libmvec"
+</testinfo>
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define N 256
+
+float x[N] __attribute__((aligned(64)));
+float y[N] __attribute__((aligned(64)));
+float z[N] __attribute__((aligned(64)));
+double xd[N] __attribute__((aligned(64)));
+double yd[N] __attribute__((aligned(64)));
+
+void __attribute__((noinline)) test_float(void)
+{
+    int i;
+#pragma omp simd aligned(x, y, z:64)
+    for (i=0; i<N; i++)
+    {
+        z[i] = sinf(x[i]) + cosf(x[i]) + expf(x[i]) + logf(y[i]) + powf(y[i], x[i]);
+    }
+}
+
+// Masked calls use the unmasked variants
+void __attribute__((noinline)) test_float_masked(void)
+{
+    int i;
+#pragma omp simd aligned(x, y, z:64)
+    for (i=0; i<N; i++)
+    {
+        if (x[i] > 0.5f)
+            z[i] = expf(x[i]);
+        else
+            z[i] = logf(y[i]);
+    }
+}
+
+void __attribute__((noinline)) test_double(void)
+{
+    int i;
+#pragma omp simd aligned(xd, yd:64)
+    for (i=0; i<N; i++)
+    {
+        yd[i] = sin(xd[i]) + exp(xd[i]) + pow(xd[i], 2.5);
+    }
+}
+
+#define ERROR 0.01
+void check(float result, float expected, int i)
+{
+    if (fabsf(result - expected) > ERROR * fabsf(expected) + ERROR)
+    {
+        printf("ERROR: [%d] %f != %f\n", i, result, expected);
+        abort();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+
+    for (i=0; i<N; i++)
+    {
+        x[i] = (i * 0.9f) / (i + 1);
+        y[i] = 1.0f + i * 0.01f;
+        xd[i] = x[i];
+    }
+
+    test_float();
+
+    for (i=0; i<N; i++)
+        check(z[i], sinf(x[i]) + cosf(x[i]) + expf(x[i]) + logf(y[i]) + powf(y[i], x[i]), i);
+
+    test_float_masked();
+
+    for (i=0; i<N; i++)
+        check(z[i], x[i] > 0.5f ? expf(x[i]) : logf(y[i]), i);
+
+    test_double();
+
+    for (i=0; i<N; i++)
+        check(yd[i], sin(xd[i]) + exp(xd[i]) + pow(xd[i], 2.5), i);
+
+    printf("SUCCESS\n");
+
+    return 0;
+}
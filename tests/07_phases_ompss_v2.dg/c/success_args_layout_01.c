@@ -0,0 +1,24 @@
+/*
+<testinfo>
+test_generator="config/mercurium-ompss-v2"
+test_nolink=yes
+test_CFLAGS="--variable=args_layout_report:1"
+</testinfo>
+*/
+
+void f(char c1, double d, char c2, int *p, short s, int n)
+{
+    int vla[n];
+    // The fields of the arguments structure are sorted by decreasing alignment
+    #pragma oss task firstprivate(c1, d, c2, s, vla) shared(p)
+    {
+        p[0] = c1 + c2 + s + d + vla[0];
+    }
+
+    int x = 0;
+    #pragma oss task reduction(+: x) firstprivate(c1, d)
+    {
+        x += c1 + d;
+    }
+    #pragma oss taskwait
+}
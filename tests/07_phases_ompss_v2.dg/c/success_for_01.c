@@ -0,0 +1,39 @@
+/*
+<testinfo>
+test_generator="config/mercurium-ompss-v2 openmp-compatibility"
+test_nolink=yes
+</testinfo>
+*/
+
+void f(int *v, int n)
+{
+    int i, sum = 0;
+
+    #pragma omp for schedule(dynamic, 16) reduction(+:sum)
+    for (i = 0; i < n; i++)
+    {
+        sum += v[i];
+    }
+
+    #pragma omp for nowait
+    for (i = n - 1; i >= 0; i -= 2)
+    {
+        v[i] = sum;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (i = 0; i < n; i++)
+    {
+        v[i]++;
+    }
+
+    int last, first = 0;
+    #pragma omp for lastprivate(last) firstprivate(first) lastprivate(first)
+    for (i = 0; i < n; i++)
+    {
+        last = v[i];
+        first += v[i];
+    }
+
+    #pragma omp taskwait
+}
@@ -0,0 +1,52 @@
+/*
+<testinfo>
+test_generator="config/mercurium-ompss-v2 openmp-compatibility"
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+#define N 1000
+
+int v[N];
+
+int main(int argc, char *argv[])
+{
+    int i, last = -1, sum = 0;
+    double x = 0.0;
+
+    for (i = 0; i < N; i++)
+        v[i] = i;
+
+    // Only the chunk running the last iteration copies its values out
+    #pragma omp for schedule(dynamic, 7) lastprivate(last, x)
+    for (i = 0; i < N; i++)
+    {
+        last = v[i];
+        x = 2.0 * v[i];
+    }
+
+    if (last != N - 1) abort();
+    if (x != 2.0 * (N - 1)) abort();
+
+    // Strided loop: the last iteration is not the upper bound
+    #pragma omp parallel for schedule(static, 3) firstprivate(sum) lastprivate(sum)
+    for (i = N - 1; i >= 0; i -= 4)
+    {
+        sum = 10 + v[i];
+    }
+
+    if (sum != 10 + 3) abort();
+
+    // An empty loop keeps the original values
+    last = -1;
+    #pragma omp for lastprivate(last)
+    for (i = 0; i < 0; i++)
+    {
+        last = i;
+    }
+
+    if (last != -1) abort();
+
+    return 0;
+}
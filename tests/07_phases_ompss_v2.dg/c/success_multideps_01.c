@@ -0,0 +1,37 @@
+/*
+<testinfo>
+test_generator="config/mercurium-ompss-v2"
+test_nolink=yes
+</testinfo>
+*/
+
+void f(int *v, int (*m)[64], int *idx, int n)
+{
+    // Registered as v[0 : n - 1]
+    #pragma oss task out({ v[i], i = 0;n })
+    {
+        for (int i = 0; i < n; i++)
+            v[i] = i;
+    }
+
+    // Registered as m[1 : n][0 : 63]
+    #pragma oss task in({ m[i + 1][j], i = 0;n, j = 0;64 }) inout(v[0])
+    {
+        v[0] = m[1][0];
+    }
+
+    // Registered element by element
+    #pragma oss task inout({ v[idx[i]], i = 0;n })
+    {
+        for (int i = 0; i < n; i++)
+            v[idx[i]]++;
+    }
+
+    #pragma oss task inout({ v[2 * i], i = 0;n })
+    {
+        for (int i = 0; i < n; i++)
+            v[2 * i]++;
+    }
+
+    #pragma oss taskwait
+}
@@ -0,0 +1,59 @@
+/*
+<testinfo>
+test_generator="config/mercurium-ompss-v2"
+test_CFLAGS="--variable=task_aggregation_block_size:8"
+test_nolink=yes
+</testinfo>
+*/
+
+void f(int *v, int *w, int **p, int n)
+{
+    int i;
+    int acc = 0;
+
+    #pragma oss task for
+    for (i = 0; i < n; i++)
+    {
+        v[i] = 0;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        #pragma oss task in(v[i]) out(w[i + 1]) firstprivate(i)
+        {
+            w[i + 1] = v[i] * 2;
+        }
+    }
+
+    for (int j = 1; j < n; j += 2)
+    {
+        #pragma oss task inout(v[j - 1]) shared(w)
+        v[j - 1] += w[j];
+    }
+
+    // Not aggregated: the dependence does not grow with the induction variable
+    for (i = 0; i < n; i++)
+    {
+        #pragma oss task inout(v[n - i - 1])
+        v[n - i - 1]++;
+    }
+
+    // Not aggregated: the iterations of a block would share 'acc'
+    for (i = 0; i < n; i++)
+    {
+        #pragma oss task out(v[i])
+        {
+            acc += i;
+            v[i] = acc;
+        }
+    }
+
+    // Not aggregated: 'p[i]' is a pointer so 'p[lo:hi][0]' is not a section
+    for (i = 0; i < n; i++)
+    {
+        #pragma oss task inout(p[i][0])
+        p[i][0]++;
+    }
+
+    #pragma oss taskwait
+}